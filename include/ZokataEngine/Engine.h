@@ -5,7 +5,12 @@
 #include <string>
 #include <vector>
 
+#include "ZokataEngine/systems/animation/AnimationSystem.h"
+#include "ZokataEngine/systems/asset/AssetManager.h"
+#include "ZokataEngine/systems/render/VisibilitySystem.h"
 #include "ZokataEngine/systems/scene/SceneManager.h"
+#include "ZokataEngine/systems/terrain/TerrainSystem.h"
+#include "ZokataEngine/systems/texture/MaterialTextureSystem.h"
 
 namespace ZKT
 {
@@ -25,8 +30,14 @@ public:
 
 private:
     std::filesystem::path scenes_root_;
+    AssetManager assets_;  // declared before the scenes so their handles are released first
     SceneManager scene_manager_;
+    AnimationSystem animation_;
+    VisibilitySystem visibility_;
+    TerrainSystem terrain_;
+    MaterialTextureSystem material_textures_;
 
+    void Update(float delta_seconds);
     void DrawSceneHierarchyGui();
     void DrawEntityNodeGui(Entity& entity);
 };
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ZokataEngine/systems/animation/AnimationPose.h"
+#include "ZokataEngine/systems/animation/Skeleton.h"
+#include "ZokataMath/Quaternion.h"
+#include "ZokataMath/Vector.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+struct TranslationKey
+{
+    float time = 0.0F;
+    MATH::Vec3f value {0.0F, 0.0F, 0.0F};
+};
+
+struct RotationKey
+{
+    float time = 0.0F;
+    MATH::Quaternion value {};
+};
+
+struct ScaleKey
+{
+    float time = 0.0F;
+    MATH::Vec3f value {1.0F, 1.0F, 1.0F};
+};
+
+/**
+ * @brief Source keys of one joint; empty channels keep the skeleton's bind transform.
+ */
+struct JointTrack
+{
+    std::vector<TranslationKey> translations;
+    std::vector<RotationKey> rotations;
+    std::vector<ScaleKey> scales;
+};
+
+/**
+ * @brief Uncompressed clip as authored or imported; tracks are indexed by skeleton joint.
+ */
+struct RawAnimationClip
+{
+    std::string name;
+    float duration = 0.0F;  // seconds
+    std::vector<JointTrack> tracks;
+};
+
+struct ClipCompressionSettings
+{
+    float sample_rate = 30.0F;             // frames per second of the resampled clip
+    float translation_tolerance = 1e-4F;   // max per-axis deviation, in model units
+    float rotation_tolerance = 1e-3F;      // max angular deviation, in radians
+    float scale_tolerance = 1e-4F;         // max per-axis deviation
+};
+
+/**
+ * @brief Scratch memory for AnimationClip::Sample; keep one per animator or per thread.
+ */
+struct ClipSampleScratch
+{
+    LocalPose next;
+    std::vector<float> weights;  // translation, rotation and scale weights, PaddedCount() each
+};
+
+/**
+ * @brief Compressed, immutable animation clip.
+ *
+ * Tracks are resampled at a fixed rate, quantized, and reduced to the keys that linear
+ * interpolation cannot reproduce within tolerance. Rotations are stored as 48-bit smallest-
+ * three quaternions; translations and scales as 16 bits per axis over the track's range.
+ * Sampling decodes the two keys around the time for every joint, then interpolates all
+ * joints at once with InterpolatePoses.
+ */
+class AnimationClip
+{
+public:
+    static AnimationClip Compress(
+        const RawAnimationClip& raw, const Skeleton& skeleton, const ClipCompressionSettings& settings = {});
+
+    const std::string& Name() const;
+    float Duration() const;
+    uint32_t JointCount() const;
+    size_t KeyCount() const;
+    /**
+     * @brief Bytes of compressed track data.
+     */
+    size_t ByteSize() const;
+    /**
+     * @brief Bytes the resampled clip would take as float keys on every frame.
+     */
+    size_t UncompressedByteSize() const;
+
+    /**
+     * @brief Writes the local pose at time (clamped to the clip) into pose.
+     */
+    void Sample(float time, LocalPose& pose, ClipSampleScratch& scratch) const;
+
+private:
+    enum TrackKind : uint32_t
+    {
+        kTranslation,
+        kRotation,
+        kScale,
+        kTrackKinds
+    };
+
+    struct Track
+    {
+        uint32_t first_key = 0;
+        uint32_t key_count = 0;
+        MATH::Vec3f offset {0.0F, 0.0F, 0.0F};  // dequantize: offset + q / 65535 * extent
+        MATH::Vec3f extent {0.0F, 0.0F, 0.0F};
+    };
+
+    std::string name_;
+    float duration_ = 0.0F;
+    float sample_rate_ = 30.0F;
+    uint32_t frame_count_ = 0;
+    uint32_t joint_count_ = 0;
+    std::vector<Track> tracks_;     // joint * kTrackKinds + kind
+    std::vector<uint16_t> frames_;  // frame index of every key
+    std::vector<uint16_t> values_;  // three quantized components per key
+
+    void DecodeKey(TrackKind kind, const Track& track, uint32_t key, float* out) const;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ZokataEngine/systems/animation/Skeleton.h"
+#include "ZokataMath/Matrix.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+enum class PoseChannel : uint32_t
+{
+    TranslationX,
+    TranslationY,
+    TranslationZ,
+    RotationX,
+    RotationY,
+    RotationZ,
+    RotationW,
+    ScaleX,
+    ScaleY,
+    ScaleZ,
+    Count
+};
+
+/**
+ * @brief Joint-local transforms in structure-of-arrays layout.
+ *
+ * Each channel is a contiguous float array padded to a multiple of four joints, so blending
+ * and matrix construction process four joints per SIMD instruction. Padding joints hold the
+ * identity transform.
+ */
+class LocalPose
+{
+public:
+    static constexpr uint32_t kLaneWidth = 4;
+
+    void Resize(uint32_t joint_count);
+    void SetBindPose(const Skeleton& skeleton);
+
+    uint32_t JointCount() const;
+    /**
+     * @brief Joint count rounded up to kLaneWidth; the length of every channel.
+     */
+    uint32_t PaddedCount() const;
+
+    float* Channel(PoseChannel channel);
+    const float* Channel(PoseChannel channel) const;
+
+    void SetJoint(uint32_t joint, const JointTransform& transform);
+    JointTransform GetJoint(uint32_t joint) const;
+
+private:
+    uint32_t joint_count_ = 0;
+    uint32_t padded_count_ = 0;
+    std::vector<float> data_;  // PoseChannel::Count channels of padded_count_ floats
+};
+
+/**
+ * @brief out = lerp(a, b, weight) per joint; rotations use normalized lerp on the short arc.
+ *
+ * out may alias a or b. All poses must have the same joint count.
+ */
+void BlendPoses(const LocalPose& a, const LocalPose& b, float weight, LocalPose& out);
+
+/**
+ * @brief Like BlendPoses with separate per-joint weights for translation, rotation and scale.
+ *
+ * Each weight span holds PaddedCount() values; used to interpolate between sampled keys.
+ */
+void InterpolatePoses(
+    const LocalPose& a,
+    const LocalPose& b,
+    std::span<const float> translation_weights,
+    std::span<const float> rotation_weights,
+    std::span<const float> scale_weights,
+    LocalPose& out);
+
+/**
+ * @brief Builds joint-to-model matrices: local TRS matrices four joints at a time, then one
+ *        parents-first pass of matrix products.
+ */
+void ComputeModelMatrices(const Skeleton& skeleton, const LocalPose& pose, std::span<MATH::Mat4f> model);
+
+/**
+ * @brief skinning[i] = model[i] * inverse_bind[i], the palette vertex skinning consumes.
+ */
+void ComputeSkinningMatrices(
+    const Skeleton& skeleton, std::span<const MATH::Mat4f> model, std::span<MATH::Mat4f> skinning);
+}  // namespace ENGINE
+}  // namespace ZKT
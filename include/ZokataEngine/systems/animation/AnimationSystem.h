@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class AnimatorComponent;
+class JobSystem;
+class Scene;
+
+struct AnimationStats
+{
+    uint32_t animators = 0;
+    uint32_t joints = 0;
+    float cpu_ms = 0.0F;
+};
+
+/**
+ * @brief Evaluates every enabled AnimatorComponent of a scene on the job system.
+ *
+ * Run after the scene update (which advances clip time) and before visibility, so the
+ * skinning palettes are ready when draws are extracted.
+ */
+class AnimationSystem
+{
+public:
+    explicit AnimationSystem(JobSystem& jobs);
+
+    void Update(Scene& scene);
+
+    const AnimationStats& Stats() const;
+
+    /**
+     * @brief ImGui panel with animator counts and evaluation time.
+     */
+    void DrawDebugGui();
+
+private:
+    JobSystem& jobs_;
+    std::vector<AnimatorComponent*> animators_;
+    AnimationStats stats_ {};
+};
+}  // namespace ENGINE
+}  // namespace ZKT
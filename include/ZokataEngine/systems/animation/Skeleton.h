@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ZokataMath/Matrix.h"
+#include "ZokataMath/Quaternion.h"
+#include "ZokataMath/Vector.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Joint transform relative to its parent.
+ */
+struct JointTransform
+{
+    MATH::Vec3f translation {0.0F, 0.0F, 0.0F};
+    MATH::Quaternion rotation {};
+    MATH::Vec3f scale {1.0F, 1.0F, 1.0F};
+};
+
+struct Joint
+{
+    std::string name;
+    int32_t parent = -1;            // index of the parent joint, -1 for roots
+    JointTransform bind {};         // rest pose relative to the parent
+    MATH::Mat4f inverse_bind {};    // mesh space -> joint space at bind time
+};
+
+/**
+ * @brief Immutable joint hierarchy shared by every animator that uses it.
+ *
+ * Joints are stored parents-first, so model-space matrices can be computed in one forward
+ * pass over the array.
+ */
+class Skeleton
+{
+public:
+    /**
+     * @brief Takes joints in any order where each parent precedes its children; throws otherwise.
+     */
+    explicit Skeleton(std::vector<Joint> joints);
+
+    uint32_t JointCount() const;
+    const Joint& GetJoint(uint32_t index) const;
+    const std::vector<Joint>& Joints() const;
+    const std::vector<int32_t>& Parents() const;
+
+    /**
+     * @brief Index of the joint called name, or -1.
+     */
+    int32_t FindJoint(std::string_view name) const;
+
+private:
+    std::vector<Joint> joints_;
+    std::vector<int32_t> parents_;  // copy of Joint::parent, packed for the hierarchy pass
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class AssetManager;
+class JobSystem;
+struct AssetRecord;
+
+enum class AssetState : uint32_t
+{
+    Loading,
+    Ready,
+    Failed
+};
+
+/**
+ * @brief Memory an asset accounts against the manager's budgets.
+ */
+struct AssetSize
+{
+    size_t cpu_bytes = 0;
+    size_t gpu_bytes = 0;  // what the renderer allocates once the asset is uploaded
+};
+
+/**
+ * @brief Limits for unreferenced assets; assets in use are never evicted, even over budget.
+ */
+struct AssetBudget
+{
+    size_t cpu_bytes = size_t {512} << 20;
+    size_t gpu_bytes = size_t {1} << 30;
+};
+
+struct AssetManagerStats
+{
+    size_t assets = 0;    // records alive, loaded or not
+    size_t loading = 0;
+    size_t unused = 0;    // ready but unreferenced, evictable in LRU order
+    size_t cpu_bytes = 0;
+    size_t gpu_bytes = 0;
+    size_t hits = 0;      // Load calls served by an existing record
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t reloads = 0;   // hot reloads applied
+};
+
+/**
+ * @brief Untyped reference to an asset; keeps it from being evicted while alive.
+ *
+ * Handles are cheap to copy. They must not outlive the AssetManager that issued them.
+ */
+class AssetHandleBase
+{
+public:
+    AssetHandleBase() = default;
+    ~AssetHandleBase();
+
+    AssetHandleBase(const AssetHandleBase& other);
+    AssetHandleBase& operator=(const AssetHandleBase& other);
+    AssetHandleBase(AssetHandleBase&& other) noexcept;
+    AssetHandleBase& operator=(AssetHandleBase&& other) noexcept;
+
+    bool Valid() const;
+    AssetState State() const;
+    bool IsReady() const;
+    bool IsFailed() const;
+    /**
+     * @brief The reference the asset was loaded from ("path#sub_asset").
+     */
+    const std::string& Reference() const;
+    /**
+     * @brief Why loading failed; empty unless IsFailed().
+     */
+    const std::string& Error() const;
+    /**
+     * @brief Bumped each time a hot reload replaces the asset's data; Get() then returns the
+     *        new data.
+     */
+    uint32_t Version() const;
+
+    /**
+     * @brief Blocks until the asset finished loading or failed; for tools, never for frames.
+     */
+    void Wait() const;
+    /**
+     * @brief Runs callback from AssetManager::Update once the asset is ready or failed.
+     */
+    void OnLoaded(std::function<void()> callback) const;
+
+    void Reset();
+
+protected:
+    AssetHandleBase(AssetManager* manager, AssetRecord* record);
+
+    std::shared_ptr<const void> Data() const;
+
+private:
+    AssetManager* manager_ = nullptr;
+    AssetRecord* record_ = nullptr;
+};
+
+/**
+ * @brief Typed asset reference; Get() returns null until the asset is ready.
+ */
+template <typename T>
+class AssetHandle : public AssetHandleBase
+{
+public:
+    AssetHandle() = default;
+
+    std::shared_ptr<const T> Get() const
+    {
+        return std::static_pointer_cast<const T>(Data());
+    }
+
+private:
+    friend class AssetManager;
+
+    AssetHandle(AssetManager* manager, AssetRecord* record)
+        : AssetHandleBase(manager, record)
+    {
+    }
+};
+
+/**
+ * @brief Maps asset references to typed, reference-counted handles and loads them on workers.
+ *
+ * Each (type, reference) pair is loaded at most once; later requests share the record.
+ * Loaders run on the job system, so Load never blocks the caller. Completion callbacks and
+ * eviction run on the thread that calls Update, once per frame. Assets whose last handle was
+ * released stay cached and are evicted least recently used first while either budget is
+ * exceeded.
+ *
+ * Reload() re-runs the loader for assets read from a changed file. The old data stays in use
+ * until the new data is ready; Update swaps it in and bumps the handles' Version().
+ *
+ * Loaders for MeshAsset (glTF/GLB "path#mesh" references, merged and given a LOD chain) and
+ * TextureAsset (cooked .ktx2 files) are registered by default.
+ */
+class AssetManager
+{
+public:
+    explicit AssetManager(JobSystem& jobs, AssetBudget budget = {});
+    ~AssetManager();
+
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    /**
+     * @brief Installs the loader for T; load runs on a worker and throws on failure.
+     */
+    template <typename T>
+    void RegisterLoader(
+        std::function<std::shared_ptr<const T>(const std::string& reference)> load,
+        std::function<AssetSize(const T&)> measure)
+    {
+        RegisterErasedLoader(
+            std::type_index(typeid(T)),
+            [load = std::move(load), measure = std::move(measure)](const std::string& reference) {
+                std::shared_ptr<const T> asset = load(reference);
+                const AssetSize size = measure(*asset);
+                return LoadedAsset{std::move(asset), size};
+            });
+    }
+
+    /**
+     * @brief Returns the handle for reference, starting an asynchronous load on first use.
+     */
+    template <typename T>
+    AssetHandle<T> Load(std::string_view reference)
+    {
+        return AssetHandle<T>(this, Acquire(std::type_index(typeid(T)), reference));
+    }
+
+    /**
+     * @brief Reloads every asset whose reference names file in the background; unused ones are
+     *        dropped instead. Returns how many assets referenced the file.
+     */
+    size_t Reload(const std::filesystem::path& file);
+
+    /**
+     * @brief Dispatches completion callbacks, applies finished reloads and evicts unused assets
+     *        over budget. Reloads replace data only here, so read handles on this thread.
+     */
+    void Update();
+
+    void SetBudget(const AssetBudget& budget);
+    const AssetBudget& Budget() const;
+    AssetManagerStats Stats() const;
+
+    /**
+     * @brief Displays residency and budget usage.
+     */
+    void DrawDebugGui() const;
+
+private:
+    friend class AssetHandleBase;
+
+    struct LoadedAsset
+    {
+        std::shared_ptr<const void> data;
+        AssetSize size;
+    };
+    using ErasedLoader = std::function<LoadedAsset(const std::string& reference)>;
+
+    JobSystem& jobs_;
+    AssetBudget budget_;
+    mutable std::mutex mutex_;
+    std::condition_variable loaded_;
+    std::unordered_map<std::type_index, ErasedLoader> loaders_;
+    std::unordered_map<std::string, std::unique_ptr<AssetRecord>> records_;  // keyed by type + reference
+    std::list<AssetRecord*> unused_;  // unreferenced ready assets, least recently used first
+    std::vector<std::function<void()>> callbacks_;
+    std::vector<AssetRecord*> reloaded_;  // reloads waiting for Update to swap their data in
+    size_t in_flight_ = 0;
+    size_t cpu_bytes_ = 0;
+    size_t gpu_bytes_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    size_t evictions_ = 0;
+    size_t reloads_ = 0;
+
+    void RegisterErasedLoader(std::type_index type, ErasedLoader loader);
+    AssetRecord* Acquire(std::type_index type, std::string_view reference);
+    void RunLoad(AssetRecord* record, const ErasedLoader& loader);
+    void RunReload(AssetRecord* record, const ErasedLoader& loader);
+    void ApplyReloads();
+    void Retain(AssetRecord* record);
+    void RetainLocked(AssetRecord* record);
+    void Release(AssetRecord* record);
+    void AddCallback(AssetRecord* record, std::function<void()> callback);
+    void Wait(const AssetRecord* record);
+    void EvictToBudget();
+};
+}  // namespace ENGINE
+}  // namespace ZKT
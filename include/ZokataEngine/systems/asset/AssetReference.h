@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief A file path plus an optional sub-asset, written "path#SubAsset" in scene files.
+ */
+struct AssetReference
+{
+    std::filesystem::path path;
+    std::string sub_asset;  // empty when the reference names the whole file
+};
+
+/**
+ * @brief Splits "path#SubAsset" at the last '#'.
+ */
+AssetReference ParseAssetReference(std::string_view reference);
+}  // namespace ENGINE
+}  // namespace ZKT
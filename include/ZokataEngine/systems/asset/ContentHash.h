@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief 64-bit XXH64 of bytes; fast enough to hash whole source trees on every cook.
+ */
+uint64_t HashBytes(std::span<const uint8_t> bytes, uint64_t seed = 0);
+
+/**
+ * @brief Hashes a file's contents through a memory mapping; throws when it cannot be read.
+ */
+uint64_t HashFileContents(const std::filesystem::path& path);
+
+/**
+ * @brief Accumulates values into one key; every value is length-prefixed so that
+ *        ("ab", "c") and ("a", "bc") hash differently.
+ */
+class ContentHasher
+{
+public:
+    ContentHasher& Add(std::string_view text);
+    ContentHasher& Add(uint64_t value);
+
+    uint64_t Finish() const;
+
+private:
+    std::string buffer_;
+};
+
+/**
+ * @brief Lower-case hex digits of hash, as used for cache file names.
+ */
+std::string HashToHex(uint64_t hash);
+}  // namespace ENGINE
+}  // namespace ZKT
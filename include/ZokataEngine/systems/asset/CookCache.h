@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief On-disk cache of cooked outputs keyed by the content hash of their inputs.
+ *
+ * A cook key combines the cooker version and settings with the content hash of every source
+ * an output was built from (a scene, the mesh files it references, their buffers). Outputs
+ * remember their sources, so a changed mesh invalidates exactly the scenes that use it, and
+ * reverting a change finds the earlier result in the cache instead of cooking again.
+ *
+ * Content hashes are memoized by file size and write time in the manifest, so unchanged
+ * sources are only stat'ed. All methods are thread-safe; cook independent outputs in parallel.
+ */
+class CookCache
+{
+public:
+    /**
+     * @brief Opens (or creates) the cache in directory and reads its manifest.
+     */
+    explicit CookCache(std::filesystem::path directory);
+
+    const std::filesystem::path& Directory() const;
+
+    /**
+     * @brief Content hash of a source file; rehashes only when its size or write time changed.
+     */
+    uint64_t SourceHash(const std::filesystem::path& source);
+    /**
+     * @brief Cook key for seed (cooker version and settings) plus the content of sources.
+     */
+    uint64_t ComputeKey(uint64_t seed, std::span<const std::filesystem::path> sources);
+
+    /**
+     * @brief Sources and key recorded by the last Record() for output, if any.
+     */
+    std::optional<std::vector<std::filesystem::path>> RecordedSources(const std::filesystem::path& output) const;
+    std::optional<uint64_t> RecordedKey(const std::filesystem::path& output) const;
+
+    /**
+     * @brief Copies the cached result for key to output and records its sources; false when
+     *        the cache has none.
+     */
+    bool Restore(uint64_t key, const std::filesystem::path& output, std::span<const std::filesystem::path> sources);
+    /**
+     * @brief Stores output under key and records the sources it was cooked from.
+     */
+    void Store(uint64_t key, const std::filesystem::path& output, std::span<const std::filesystem::path> sources);
+
+    /**
+     * @brief Writes the manifest; call once after a cook run.
+     */
+    void Save() const;
+
+private:
+    struct SourceEntry
+    {
+        uint64_t size = 0;
+        int64_t write_time = 0;
+        uint64_t hash = 0;
+    };
+    struct OutputEntry
+    {
+        uint64_t key = 0;
+        std::vector<std::filesystem::path> sources;
+    };
+
+    std::filesystem::path directory_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, SourceEntry> sources_;  // keyed by absolute generic path
+    std::unordered_map<std::string, OutputEntry> outputs_;
+
+    std::filesystem::path EntryPath(uint64_t key) const;
+    void Load();
+};
+}  // namespace ENGINE
+}  // namespace ZKT
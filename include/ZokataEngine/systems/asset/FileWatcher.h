@@ -0,0 +1,43 @@
+#pragma once
+
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Reports files that were rewritten in watched directories, without blocking.
+ *
+ * Backed by inotify on Linux. Only completed writes count (close after write, or a rename
+ * into the directory, which is how most editors save), so a file is never reported half
+ * written. On other platforms Valid() is false and Poll() reports nothing.
+ */
+class FileWatcher
+{
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool Valid() const;
+
+    /**
+     * @brief Watches the files directly inside directory; watching it again is a no-op.
+     */
+    void WatchDirectory(const std::filesystem::path& directory);
+    /**
+     * @brief Files changed since the last poll, each reported once, in the order first seen.
+     */
+    std::vector<std::filesystem::path> Poll();
+
+private:
+    int fd_ = -1;
+    std::unordered_map<int, std::filesystem::path> directories_;  // watch descriptor -> directory
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ZokataEngine/systems/asset/Json.h"
+#include "ZokataEngine/systems/asset/MappedFile.h"
+#include "ZokataEngine/systems/mesh/MeshOptimizer.h"
+#include "ZokataRenderer/graphics/renderer/PackedMesh.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class JobSystem;
+
+struct GltfImportSettings
+{
+    bool optimize = true;  // weld and cache/fetch-order each primitive (OptimizeMesh) before packing
+    MeshOptimizeSettings optimization {};
+    bool pack = false;  // also encode each primitive into packed_format on its worker
+    VertexFormat packed_format = VertexFormat::Packed20;
+};
+
+struct ImportedPrimitive
+{
+    MeshGeometry geometry;
+    PackedMesh packed;      // filled when GltfImportSettings::pack is set
+    int32_t material = -1;  // glTF material index, -1 when unassigned
+    MeshOptimizeReport optimization;  // filled when GltfImportSettings::optimize is set
+};
+
+struct ImportedMesh
+{
+    std::string name;
+    std::vector<ImportedPrimitive> primitives;
+    MeshOptimizeReport optimization;  // the primitives' reports combined
+};
+
+/**
+ * @brief A glTF 2.0 asset (.glb, or .gltf with external .bin buffers) opened for import.
+ *
+ * The file and its buffers are memory-mapped and stay mapped for the importer's lifetime.
+ * Accessors are decoded straight from the mapping into MeshGeometry, one job per primitive,
+ * so import time is dominated by reading pages rather than parsing. Only the JSON chunk is
+ * parsed up front. Each primitive is optimized (OptimizeMesh) on its job before it is packed
+ * or merged, so every consumer gets cache- and fetch-ordered geometry.
+ *
+ * Meshes are imported in their own space; node transforms, skins and morph targets are not
+ * applied. Point and line primitives are skipped, strips and fans become triangle lists.
+ * Sparse accessors and data: URIs are rejected.
+ */
+class GltfImporter
+{
+public:
+    /**
+     * @brief Maps and validates path; throws std::runtime_error on malformed files.
+     */
+    explicit GltfImporter(const std::filesystem::path& path);
+
+    const std::filesystem::path& Path() const;
+    /**
+     * @brief Every file the import reads: the glTF/GLB itself, then its external buffers.
+     */
+    std::vector<std::filesystem::path> SourceFiles() const;
+    uint32_t MeshCount() const;
+    const std::string& MeshName(uint32_t mesh) const;
+    uint32_t PrimitiveCount(uint32_t mesh) const;
+    /**
+     * @brief Resolves a sub-asset name: a mesh name, a mesh index, or empty for mesh 0.
+     *        Returns -1 when nothing matches.
+     */
+    int32_t FindMesh(std::string_view sub_asset) const;
+
+    /**
+     * @brief Decodes one primitive; safe to call from several threads at once.
+     */
+    ImportedPrimitive DecodePrimitive(uint32_t mesh, uint32_t primitive, const GltfImportSettings& settings = {}) const;
+    /**
+     * @brief Decodes the given meshes with one job per primitive.
+     */
+    std::vector<ImportedMesh> ImportMeshes(
+        std::span<const uint32_t> meshes, JobSystem& jobs, const GltfImportSettings& settings = {}) const;
+
+private:
+    struct AccessorView
+    {
+        const uint8_t* data = nullptr;
+        size_t count = 0;
+        size_t stride = 0;
+        uint32_t component_type = 0;
+        uint32_t components = 0;
+        bool normalized = false;
+    };
+
+    MappedFile file_;
+    std::vector<MappedFile> external_buffers_;
+    std::vector<std::span<const uint8_t>> buffers_;
+    JsonValue json_;
+
+    void ParseGlb();
+    void ResolveBuffers(std::span<const uint8_t> glb_binary);
+    AccessorView Accessor(int64_t index) const;
+};
+
+/**
+ * @brief Concatenates a mesh's primitives into one geometry, as MeshComponent draws one.
+ */
+MeshGeometry MergePrimitives(const ImportedMesh& mesh);
+}  // namespace ENGINE
+}  // namespace ZKT
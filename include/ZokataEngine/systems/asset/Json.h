@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Immutable JSON document tree, enough for asset metadata such as glTF.
+ *
+ * Lookups mirror YAML::Node: a missing key or index yields a null value that converts to
+ * false, so optional fields read as `if (const auto& v = node["key"])`.
+ */
+class JsonValue
+{
+public:
+    enum class Type : uint8_t
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    JsonValue() = default;
+
+    /**
+     * @brief Parses a complete document; throws std::runtime_error with the byte offset.
+     */
+    static JsonValue Parse(std::string_view text);
+
+    Type GetType() const;
+    bool IsNull() const;
+    bool IsNumber() const;
+    bool IsString() const;
+    bool IsArray() const;
+    bool IsObject() const;
+    explicit operator bool() const;
+
+    bool AsBool(bool fallback = false) const;
+    double AsNumber(double fallback = 0.0) const;
+    int64_t AsInt(int64_t fallback = 0) const;
+    /**
+     * @brief The string, or an empty string for other types.
+     */
+    const std::string& AsString() const;
+
+    /**
+     * @brief Element count of an array or member count of an object.
+     */
+    size_t Size() const;
+    const JsonValue& operator[](size_t index) const;
+    const JsonValue& operator[](std::string_view key) const;
+    const std::vector<JsonValue>& Items() const;
+    const std::vector<std::pair<std::string, JsonValue>>& Members() const;
+
+private:
+    friend class JsonParser;
+
+    Type type_ = Type::Null;
+    bool bool_ = false;
+    double number_ = 0.0;
+    std::string string_;
+    std::vector<JsonValue> items_;
+    std::vector<std::pair<std::string, JsonValue>> members_;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
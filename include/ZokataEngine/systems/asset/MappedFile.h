@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Importers read straight from the mapping, so file contents reach decoders without an
+ * intermediate copy and pages are loaded on first touch. Move-only; unmaps on destruction.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    /**
+     * @brief Maps path; throws std::runtime_error when it cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::filesystem::path& Path() const;
+    std::span<const uint8_t> Bytes() const;
+    size_t Size() const;
+    bool Empty() const;
+
+private:
+    std::filesystem::path path_;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* mapping_ = nullptr;  // HANDLE of the file mapping object
+#endif
+
+    void Unmap();
+};
+}  // namespace ENGINE
+}  // namespace ZKT
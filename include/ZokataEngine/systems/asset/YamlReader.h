@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Receives a YAML document as a stream of events instead of a node tree.
+ *
+ * Inside a map, scalars alternate between key and value. Empty values (`key:` with nothing
+ * after it) arrive as empty scalars. Scalar views are only valid during the call.
+ */
+class YamlHandler
+{
+public:
+    virtual ~YamlHandler() = default;
+
+    virtual void OnScalar(std::string_view value) = 0;
+    virtual void OnMapStart() = 0;
+    virtual void OnMapEnd() = 0;
+    virtual void OnSequenceStart() = 0;
+    virtual void OnSequenceEnd() = 0;
+};
+
+/**
+ * @brief Streams text to handler in a single pass, without allocating per node.
+ *
+ * Reads the YAML that scene files are written in: block and flow maps and sequences,
+ * single-line plain and quoted scalars, and comments. Returns false as soon as it meets
+ * anything else (anchors, aliases, tags, block or multi-line scalars, several documents) or
+ * malformed text. The handler may have received events by then and has to be discarded;
+ * ReadYamlWithYamlCpp reads the same text either way.
+ */
+bool ReadYaml(std::string_view text, YamlHandler& handler);
+
+/**
+ * @brief Parses text with yaml-cpp and replays the tree to handler. Understands all of YAML,
+ *        at a fraction of ReadYaml's speed; map entries with non-scalar keys are skipped.
+ *        Throws std::runtime_error on malformed text.
+ */
+void ReadYamlWithYamlCpp(std::string_view text, YamlHandler& handler);
+
+/**
+ * @brief Locale-independent conversions of whole scalars; false leaves value untouched.
+ *        Floats accept a leading '+' and the YAML spellings .inf, -.inf and .nan.
+ */
+bool ParseYamlFloat(std::string_view text, float& value);
+bool ParseYamlInt(std::string_view text, int64_t& value);
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Fixed-size worker pool for fire-and-forget tasks and blocking parallel loops.
+ *
+ * ParallelFor lets the calling thread take part in its own loop (and only that loop), so it
+ * is safe to call from a worker task without deadlocking the pool.
+ */
+class JobSystem
+{
+public:
+    /**
+     * @brief Starts worker threads; 0 picks hardware_concurrency() - 1 (at least one).
+     */
+    explicit JobSystem(uint32_t worker_count = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief Process-wide pool shared by engine systems.
+     */
+    static JobSystem& Default();
+
+    uint32_t WorkerCount() const;
+
+    /**
+     * @brief Queues a task and returns a future for its result.
+     */
+    template <typename Fn>
+    auto Submit(Fn&& fn) -> std::future<std::invoke_result_t<std::decay_t<Fn>>>
+    {
+        using Result = std::invoke_result_t<std::decay_t<Fn>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+        std::future<Result> future = task->get_future();
+        Enqueue([task]() { (*task)(); });
+        return future;
+    }
+
+    /**
+     * @brief Splits [0, count) into chunks of at least grain items and runs fn(begin, end)
+     *        on workers and the calling thread; returns when every chunk finished. If fn
+     *        throws, the chunks not yet started are skipped and the first exception is
+     *        rethrown here once no thread is still inside fn.
+     */
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> queue_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+
+    void Enqueue(std::function<void()> task);
+    void WorkerLoop();
+};
+}  // namespace ENGINE
+}  // namespace ZKT
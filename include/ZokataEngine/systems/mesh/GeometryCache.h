@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "ZokataEngine/systems/scene/components/Primitives/MeshPrimitives.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Shared, immutable geometry; the same object may back any number of components.
+ */
+using GeometryHandle = std::shared_ptr<const MeshGeometry>;
+
+struct GeometryCacheStats
+{
+    size_t entries = 0;  // keys currently mapped to live geometry
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t bytes = 0;    // CPU bytes of live cached vertices and indices
+};
+
+/**
+ * @brief Content-addressed store of immutable geometry keyed by asset id or primitive parameters.
+ *
+ * The cache only holds weak references: geometry lives as long as some handle uses it, so
+ * memory follows the set of unique meshes in use rather than the instance count. Lookups are
+ * thread-safe; builders run outside the lock and the first finished result wins a race.
+ */
+class GeometryCache
+{
+public:
+    /**
+     * @brief Process-wide cache shared by components and loaders.
+     */
+    static GeometryCache& Default();
+
+    /**
+     * @brief Returns the live geometry for key, or null.
+     */
+    GeometryHandle Find(std::string_view key);
+    /**
+     * @brief Returns the geometry for key, calling build only when none is live.
+     */
+    GeometryHandle GetOrCreate(std::string_view key, const std::function<MeshGeometry()>& build);
+    /**
+     * @brief Publishes geometry under key, replacing the mapping (existing handles are untouched).
+     */
+    GeometryHandle Insert(std::string_view key, MeshGeometry geometry);
+
+    GeometryHandle Cube(const CubeParams& params = {});
+    GeometryHandle Sphere(const SphereParams& params = {});
+
+    static std::string CubeKey(const CubeParams& params);
+    static std::string SphereKey(const SphereParams& params);
+
+    /**
+     * @brief Drops keys whose geometry is no longer referenced; returns how many.
+     */
+    size_t Prune();
+    GeometryCacheStats Stats();
+
+private:
+    struct StringHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::weak_ptr<const MeshGeometry>, StringHash, std::equal_to<>> entries_;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ZokataEngine/systems/mesh/GeometryCache.h"
+#include "ZokataRenderer/graphics/renderer/MeshletCulling.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief One coarser detail level and its geometric error relative to level 0.
+ */
+struct MeshLod
+{
+    GeometryHandle geometry;
+    float error = 0.0F;  // object-space max deviation from the full-detail surface
+};
+
+using MeshletsHandle = std::shared_ptr<const std::vector<GpuMeshlet>>;
+
+/**
+ * @brief An imported mesh: full-detail geometry and the LOD chain built for it.
+ *
+ * Meshes large enough to be worth culling per cluster also carry meshlets; their geometry's
+ * indices are then stored in meshlet order.
+ */
+struct MeshAsset
+{
+    GeometryHandle geometry;
+    std::vector<MeshLod> lods;  // levels 1..n, as MeshComponent::SetLods takes them
+    MeshletsHandle meshlets;    // null for small meshes
+};
+}  // namespace ENGINE
+}  // namespace ZKT
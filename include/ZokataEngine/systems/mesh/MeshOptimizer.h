@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Largest per-component difference at which two vertices are treated as one.
+ */
+struct WeldSettings
+{
+    float position = 1e-5F;
+    float normal = 1e-3F;
+    float uv = 1e-5F;
+    float tangent = 1e-3F;
+};
+
+/**
+ * @brief Post-transform cache efficiency of an index buffer under a FIFO cache model.
+ */
+struct VertexCacheStats
+{
+    float acmr = 0.0F;  // vertex shader invocations per triangle (0.5 is the limit for large grids)
+    float atvr = 0.0F;  // vertex shader invocations per referenced vertex (1.0 is ideal)
+};
+
+struct MeshOptimizeSettings
+{
+    bool weld = true;
+    WeldSettings tolerance {};
+    uint32_t cache_size = 16;  // simulated post-transform cache entries
+};
+
+struct MeshOptimizeReport
+{
+    size_t triangles = 0;
+    size_t vertices_before = 0;
+    size_t vertices_after = 0;
+    VertexCacheStats before {};
+    VertexCacheStats after {};
+};
+
+/**
+ * @brief Simulates a FIFO post-transform cache over the triangle list.
+ */
+VertexCacheStats AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertex_count, uint32_t cache_size = 16);
+
+/**
+ * @brief Merges vertices whose attributes all match within tolerance; the result is indexed.
+ *
+ * Candidates are found through a spatial hash on position, so the cost is linear in the
+ * vertex count. Returns the number of vertices removed.
+ */
+size_t WeldVertices(MeshGeometry& geometry, const WeldSettings& tolerance = {});
+
+/**
+ * @brief Reorders triangles for post-transform cache hits (Tipsify, Sander et al. 2007).
+ *
+ * Linear time; the triangle set and winding are unchanged.
+ */
+void OptimizeVertexCache(std::span<uint32_t> indices, size_t vertex_count, uint32_t cache_size = 16);
+
+/**
+ * @brief Renumbers vertices in first-use order so fetches walk the vertex buffer forward.
+ *
+ * Vertices no triangle references are dropped.
+ */
+void OptimizeVertexFetch(MeshGeometry& geometry);
+
+/**
+ * @brief Import/cook-time pass: weld, cache-order the triangles, then fetch-order the vertices.
+ */
+MeshOptimizeReport OptimizeMesh(MeshGeometry& geometry, const MeshOptimizeSettings& settings = {});
+
+/**
+ * @brief Sums the reports of meshes drawn together (e.g. a mesh's primitives); ACMR is
+ *        weighted by triangles and ATVR by referenced vertices, as if analyzed in one pass.
+ */
+MeshOptimizeReport CombineReports(std::span<const MeshOptimizeReport> reports);
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ZokataEngine/systems/scene/components/MeshComponent.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class JobSystem;
+
+struct SimplifyOptions
+{
+    size_t target_triangles = 0;  // stop once the triangle count reaches this
+    float max_error = 1.0F;       // stop before a collapse exceeds this fraction of the mesh radius
+    bool lock_border = false;     // keep open borders fixed (e.g. tiles that must stay stitched)
+};
+
+struct SimplifyResult
+{
+    MeshGeometry geometry;
+    float error = 0.0F;  // object-space deviation introduced, usable as MeshLod::error
+};
+
+/**
+ * @brief Reduces a mesh with quadric-error edge collapses.
+ *
+ * Collapses move a vertex onto a neighbour (half-edge collapse), so every surviving vertex keeps
+ * its original normal, UV and tangent. Vertices that share a position but not attributes form
+ * seams; seam and border vertices may only slide along their seam or border, and vertices on
+ * more complex junctions are locked. Collapses that would flip a triangle are rejected.
+ */
+SimplifyResult SimplifyMesh(const MeshGeometry& geometry, const SimplifyOptions& options);
+
+struct LodChainSettings
+{
+    uint32_t max_levels = 4;      // coarser levels to generate after level 0
+    float triangle_ratio = 0.5F;  // each level targets this fraction of the previous level
+    size_t min_triangles = 32;    // no level goes below this
+    float max_error = 0.25F;      // per-level error cap, as a fraction of the mesh radius
+    bool lock_border = false;
+};
+
+/**
+ * @brief Generates coarser levels for geometry with non-decreasing errors.
+ *
+ * Each level is simplified from the previous one and its error accumulates the errors of every
+ * step, so it bounds the deviation from level 0. Generation stops early once a step no longer
+ * removes a meaningful share of triangles.
+ */
+std::vector<MeshLod> BuildLodChain(const MeshGeometry& geometry, const LodChainSettings& settings);
+
+/**
+ * @brief Replaces the LOD chain of every mesh, building chains in parallel.
+ */
+void BuildLodChains(std::span<MeshComponent* const> meshes, const LodChainSettings& settings, JobSystem& jobs);
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ZokataMath/Vector.h"
+#include "ZokataRenderer/graphics/renderer/MeshletCulling.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+struct MeshletSettings
+{
+    uint32_t max_vertices = 64;    // at most 255 (local indices are 8-bit)
+    uint32_t max_triangles = 124;  // at most 512
+    float cone_weight = 0.25F;     // 0 packs purely by vertex reuse, higher favours tighter normal cones
+};
+
+/**
+ * @brief One cluster: a range of unique vertices plus triangles indexing into that range.
+ */
+struct Meshlet
+{
+    uint32_t vertex_offset = 0;    // into MeshletMesh::vertices
+    uint32_t triangle_offset = 0;  // in triangles, into MeshletMesh::triangles (3 bytes each)
+    uint32_t vertex_count = 0;
+    uint32_t triangle_count = 0;
+
+    MATH::Vec3f center {0.0F, 0.0F, 0.0F};
+    float radius = 0.0F;
+    MATH::Vec3f cone_apex {0.0F, 0.0F, 0.0F};
+    MATH::Vec3f cone_axis {0.0F, 0.0F, 0.0F};
+    float cone_cutoff = 1.0F;  // sin of the cone half angle; 1 disables backface culling
+};
+
+struct MeshletMesh
+{
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> vertices;  // global vertex index per meshlet-local vertex
+    std::vector<uint8_t> triangles;  // meshlet-local vertex indices, three per triangle
+
+    /**
+     * @brief Flattened global index buffer in meshlet order; meshlet i starts at triangle_offset * 3.
+     */
+    std::vector<uint32_t> DrawIndices() const;
+    /**
+     * @brief GPU records for MeshletCulling, given where DrawIndices() and the vertices were placed.
+     */
+    std::vector<GpuMeshlet> GpuMeshlets(uint32_t first_index, int32_t vertex_offset) const;
+};
+
+/**
+ * @brief Splits geometry into meshlets with bounding spheres and normal cones.
+ *
+ * Triangles are visited in Morton order of their centroids. Each meshlet grows greedily through
+ * triangles that share its vertices, preferring ones that add the fewest new vertices and whose
+ * normals agree with the cluster. A meshlet ends when it is full or has no nearby triangles left.
+ */
+MeshletMesh BuildMeshlets(const MeshGeometry& geometry, const MeshletSettings& settings = {});
+}  // namespace ENGINE
+}  // namespace ZKT
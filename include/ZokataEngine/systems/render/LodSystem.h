@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ZokataMath/Bounds.h"
+#include "ZokataMath/Matrix.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class MeshComponent;
+struct RenderView;
+
+struct LodSettings
+{
+    bool enabled = true;
+    float error_threshold_pixels = 1.0F;  // coarsest level whose projected error stays below this
+    float hysteresis = 0.25F;             // dead band around the threshold, as a fraction of it
+    float bias = 0.0F;                    // log2 scale on the threshold; +1 doubles the tolerated error
+    float viewport_height = 1080.0F;      // pixels covered by the view's vertical extent
+
+    bool adaptive_bias = false;   // raises bias while frames exceed the budget
+    float frame_budget_ms = 16.6F;
+    float max_bias = 3.0F;
+    float bias_rate = 2.0F;  // bias units per second
+};
+
+struct LodStats
+{
+    static constexpr uint32_t kMaxTrackedLevels = 8;  // deeper levels count into the last bucket
+
+    uint32_t objects = 0;
+    uint32_t switches = 0;
+    uint32_t per_level[kMaxTrackedLevels] {};
+    uint64_t full_triangles = 0;      // triangles had every object drawn at level 0
+    uint64_t selected_triangles = 0;  // triangles of the selected levels
+};
+
+/**
+ * @brief Picks a detail level per object from its projected screen-space error.
+ *
+ * A level's object-space error is scaled by the model's largest axis scale and projected at
+ * the distance of the nearest point of the object's bounding sphere. The coarsest level whose
+ * error stays below the pixel threshold wins. Switching coarser needs the error to fall below
+ * threshold * (1 - hysteresis) and switching finer needs it to exceed threshold * (1 + hysteresis),
+ * so objects that sit on a boundary do not flip every frame.
+ */
+class LodSystem
+{
+public:
+    /**
+     * @brief Starts a frame for the given main view and resets stats.
+     */
+    void Begin(const RenderView& view);
+    /**
+     * @brief Selects, stores and returns the level for one mesh (updates its hysteresis state).
+     */
+    uint32_t Select(MeshComponent& mesh, const MATH::Aabb& world_bounds, const MATH::Mat4f& model);
+
+    /**
+     * @brief Adjusts the adaptive bias from the last frame time.
+     */
+    void UpdateBudget(float delta_seconds);
+    /**
+     * @brief Bias used this frame: the manual bias plus the adaptive term.
+     */
+    float EffectiveBias() const;
+
+    LodSettings& Settings();
+    const LodStats& Stats() const;
+    void DrawDebugGui();
+
+private:
+    LodSettings settings_ {};
+    LodStats stats_ {};
+    float adaptive_bias_ = 0.0F;
+    float smoothed_frame_ms_ = 0.0F;
+
+    MATH::Vec3f view_origin_ {0.0F, 0.0F, 0.0F};
+    bool perspective_ = true;
+    float projection_scale_ = 1.0F;  // projection[1][1]
+    float threshold_ = 1.0F;         // error threshold with bias applied
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ZokataMath/Bounds.h"
+#include "ZokataMath/Matrix.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class JobSystem;
+
+/**
+ * @brief Low-resolution software depth buffer for CPU occlusion culling.
+ *
+ * Occluder triangles are transformed and near-clipped into screen space, then rasterized
+ * in parallel horizontal bands with 4-wide SIMD coverage masks. After rasterization a
+ * per-tile (8x4 pixels) max-depth level is built; bounds are tested against that level,
+ * so a box is reported hidden only if every tile it touches is fully closer than it.
+ */
+class OcclusionBuffer
+{
+public:
+    static constexpr uint32_t kTileWidth = 8;
+    static constexpr uint32_t kTileHeight = 4;
+
+    explicit OcclusionBuffer(uint32_t width = 256, uint32_t height = 128);
+
+    /**
+     * @brief Resizes the buffer; dimensions are rounded up to whole tiles.
+     */
+    void Resize(uint32_t width, uint32_t height);
+    /**
+     * @brief Starts a new frame: clears depth and drops queued occluder triangles.
+     */
+    void Begin(const MATH::Mat4f& view_projection);
+    /**
+     * @brief Transforms and clips an occluder mesh into the triangle queue.
+     */
+    void AddOccluder(const MeshGeometry& geometry, const MATH::Mat4f& model);
+    /**
+     * @brief Rasterizes queued triangles on the job system and builds the tile max level.
+     */
+    void Rasterize(JobSystem& jobs);
+    /**
+     * @brief Conservative visibility test of a world-space box against the buffer.
+     */
+    bool IsVisible(const MATH::Aabb& world_bounds) const;
+
+    void SetBackfaceCulling(bool enabled);
+
+    uint32_t Width() const;
+    uint32_t Height() const;
+    uint32_t TilesX() const;
+    uint32_t TilesY() const;
+    uint32_t TriangleCount() const;
+    /**
+     * @brief Row-major per-pixel depth (NDC z/w, cleared to +max).
+     */
+    std::span<const float> Depth() const;
+    /**
+     * @brief Row-major per-tile max depth used by IsVisible.
+     */
+    std::span<const float> TileMaxDepth() const;
+
+private:
+    struct ScreenTriangle
+    {
+        float x[3];
+        float y[3];
+        float z[3];
+    };
+
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint32_t tiles_x_ = 0;
+    uint32_t tiles_y_ = 0;
+    bool cull_backfaces_ = false;
+    MATH::Mat4f view_projection_ {};
+
+    std::vector<float> depth_;
+    std::vector<float> tile_max_;
+    std::vector<ScreenTriangle> triangles_;
+
+    void EmitTriangle(const MATH::Vec4f& a, const MATH::Vec4f& b, const MATH::Vec4f& c);
+    void RasterizeBand(uint32_t tile_row_begin, uint32_t tile_row_end);
+    void RasterizeTriangle(const ScreenTriangle& tri, uint32_t y_begin, uint32_t y_end);
+    void BuildTileMax(uint32_t tile_row_begin, uint32_t tile_row_end);
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ZokataMath/Bounds.h"
+#include "ZokataMath/Matrix.h"
+#include "ZokataMath/Vector.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class CameraComponent;
+
+enum class RenderViewKind
+{
+    Camera,
+    ShadowCascade,
+    ReflectionProbe
+};
+
+/**
+ * @brief One point of view the visibility pass culls for (camera, shadow cascade, probe face).
+ */
+struct RenderView
+{
+    static constexpr uint32_t kMaxViews = 32;  // one bit per view in the culling masks
+
+    RenderViewKind kind = RenderViewKind::Camera;
+    uint32_t index = 0;  // cascade or cube face index within its group
+    MATH::Vec3f origin {0.0F, 0.0F, 0.0F};
+    MATH::Mat4f view {};
+    MATH::Mat4f projection {};
+    MATH::Mat4f view_projection {};
+    MATH::Frustum frustum {};
+
+    static RenderView FromMatrices(RenderViewKind kind,
+                                   const MATH::Mat4f& view,
+                                   const MATH::Mat4f& projection,
+                                   const MATH::Vec3f& origin,
+                                   uint32_t index = 0);
+    static RenderView FromCamera(const CameraComponent& camera);
+};
+
+const char* RenderViewKindName(RenderViewKind kind);
+
+struct ShadowCascadeSettings
+{
+    uint32_t cascade_count = 4;
+    float max_distance = 100.0F;  // cascades cover [camera near, min(far, max_distance)]
+    float split_lambda = 0.75F;   // 0 = uniform splits, 1 = logarithmic splits
+    float caster_margin = 50.0F;  // extra depth towards the light for off-screen casters
+};
+
+/**
+ * @brief Appends orthographic views covering slices of the camera frustum for a directional light.
+ *
+ * Each cascade fits a bounding sphere around its frustum slice, so its extent is stable
+ * under camera rotation.
+ */
+void AppendShadowCascadeViews(const CameraComponent& camera,
+                              const MATH::Vec3f& light_direction,
+                              const ShadowCascadeSettings& settings,
+                              std::vector<RenderView>& views);
+
+/**
+ * @brief Appends the six 90-degree cube face views of a reflection probe.
+ */
+void AppendReflectionProbeViews(const MATH::Vec3f& position,
+                                float near_plane,
+                                float far_plane,
+                                std::vector<RenderView>& views);
+}  // namespace ENGINE
+}  // namespace ZKT
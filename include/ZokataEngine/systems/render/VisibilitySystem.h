@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ZokataEngine/systems/render/LodSystem.h"
+#include "ZokataEngine/systems/render/OcclusionBuffer.h"
+#include "ZokataEngine/systems/render/RenderView.h"
+#include "ZokataEngine/systems/spatial/SceneSpatialIndex.h"
+#include "ZokataMath/Bounds.h"
+#include "ZokataRenderer/graphics/renderer/DrawList.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class CameraComponent;
+class Entity;
+class JobSystem;
+class MeshComponent;
+class Scene;
+
+struct VisibilitySettings
+{
+    bool frustum_culling = true;
+    bool occlusion_culling = true;
+    bool occluder_backface_culling = false;
+    uint32_t occlusion_width = 256;
+    uint32_t occlusion_height = 128;
+    bool instancing = true;     // batch draws sharing geometry and material; off gives one batch per draw
+    bool shadow_views = false;  // adds directional shadow cascades to the camera's views
+    MATH::Vec3f sun_direction {-0.4F, -1.0F, -0.3F};
+    ShadowCascadeSettings cascades {};
+};
+
+/**
+ * @brief A renderable that lives outside the scene's spatial index, e.g. a terrain chunk.
+ *
+ * External draws are frustum-tested per view and drawn at level 0; they skip occlusion
+ * culling and the LOD system, since their owner already picks their detail.
+ */
+struct ExternalDraw
+{
+    const Renderable* renderable = nullptr;
+    MATH::Mat4f model {};
+    MATH::Aabb world_bounds {};
+};
+
+/**
+ * @brief Per-frame visibility: frustum culling -> occlusion culling -> draw extraction.
+ *
+ * All views (camera, shadow cascades, probe faces) are culled in one walk of the scene's
+ * spatial index, which tags every candidate with a bitmask of the views that see it.
+ * Meshes flagged as occluders are rasterized into the OcclusionBuffer from view 0 only and
+ * the remaining candidates are tested against it in parallel. Each candidate's model matrix
+ * and detail level (chosen for view 0) are computed once and shared by every view's DrawList.
+ * Finally each view's draws are bucketed by (geometry, material) into instanced batches.
+ */
+class VisibilitySystem
+{
+public:
+    explicit VisibilitySystem(JobSystem& jobs);
+
+    /**
+     * @brief Runs every stage for camera, plus its shadow cascades when enabled in settings.
+     */
+    void Run(Scene& scene, const CameraComponent& camera);
+    /**
+     * @brief Runs every stage for up to RenderView::kMaxViews views; view 0 is the main view.
+     */
+    void Run(Scene& scene, std::span<const RenderView> views);
+    /**
+     * @brief Clears the draw lists (e.g. when there is no active camera).
+     */
+    void Reset();
+    /**
+     * @brief Draws added to the next Run; the span must stay valid until Run returns.
+     */
+    void SetExternalDraws(std::span<const ExternalDraw> draws);
+
+    /**
+     * @brief Draw list of one view from the last Run; view 0 is the main view.
+     */
+    const DrawList& Draws(size_t view = 0) const;
+    size_t ViewCount() const;
+    const RenderView& View(size_t view) const;
+    VisibilitySettings& Settings();
+    const OcclusionBuffer& Occlusion() const;
+    LodSystem& Lod();
+
+    /**
+     * @brief ImGui panel with culling stats and a view of the occlusion buffer.
+     */
+    void DrawDebugGui();
+
+private:
+    struct Candidate
+    {
+        Entity* entity = nullptr;
+        MeshComponent* mesh = nullptr;
+        MATH::Aabb world_bounds {};
+        uint32_t view_mask = 0;  // bit i set when view i draws this candidate
+        bool occluded = false;   // rejected from view 0 by the occlusion buffer
+    };
+
+    struct BatchKey
+    {
+        const MeshGeometry* geometry = nullptr;
+        uint64_t material = 0;
+        uint32_t item = 0;  // index into DrawList::items
+    };
+
+    JobSystem& jobs_;
+    VisibilitySettings settings_ {};
+    OcclusionBuffer occlusion_;
+    LodSystem lod_;
+    std::vector<RenderView> camera_views_;
+    std::vector<RenderView> views_;
+    std::vector<DrawList> draws_;
+
+    std::vector<MATH::Frustum> frustums_;
+    std::vector<SpatialViewHit> frustum_hits_;
+    std::vector<Candidate> candidates_;
+    std::span<const ExternalDraw> external_draws_;
+    std::vector<std::vector<BatchKey>> batch_keys_;  // per view
+    bool show_tile_max_ = false;
+
+    void CollectCandidates(Scene& scene);
+    void CullOccluded(const MATH::Mat4f& view_projection);
+    void ExtractDraws();
+    void ExtractExternalDraws();
+    void BuildBatches(DrawList& draws, std::vector<BatchKey>& keys) const;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "ZokataEngine/systems/scene/Scene.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Binary layout of cooked scenes (.zkscene), written by zokata-cook.
+ *
+ * A 32-byte header is followed by a table of sections. Each section is a 16-byte aligned
+ * array of fixed-size records at an absolute file offset, so a mapped file is used in place:
+ * entities and transforms are read directly, and vertex and index arrays are bulk-copied
+ * into geometry. Strings are (offset, length) views into the string section. The version
+ * must change whenever any record below changes.
+ *
+ * Every component the default SceneComponentRegistry knows has a cooked form: Transform in
+ * the entity record, MeshRenderer as mesh and material records, Camera as a CameraRecord.
+ */
+namespace COOKED
+{
+constexpr char kMagic[4] = {'Z', 'K', 'S', 'C'};
+constexpr uint32_t kVersion = 5;
+constexpr uint64_t kAlignment = 16;
+
+enum class SectionType : uint32_t
+{
+    Strings,         // char
+    Entities,        // EntityRecord, parents before children
+    ComponentNames,  // String, referenced by EntityRecord::first_component
+    Meshes,          // MeshRecord
+    Vertices,        // MeshVertex
+    Indices,         // uint32_t
+    Sources,         // SourceRecord
+    Lods,            // LodRecord, referenced by MeshRecord::first_lod
+    Materials,       // MaterialRecord, referenced by EntityRecord::material
+    Cameras,         // CameraRecord, referenced by EntityRecord::camera
+    Count
+};
+
+struct String
+{
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+struct Header
+{
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint64_t file_size = 0;
+    uint32_t section_count = 0;
+    String scene_name {};
+    uint32_t reserved = 0;
+};
+
+struct Section
+{
+    SectionType type = SectionType::Count;
+    uint32_t element_size = 0;
+    uint64_t offset = 0;
+    uint64_t count = 0;
+    uint64_t reserved = 0;
+};
+
+struct EntityRecord
+{
+    int64_t id = -1;
+    String name {};
+    int32_t parent = -1;  // index into the entity section, -1 for roots
+    uint32_t first_component = 0;
+    uint32_t component_count = 0;
+    int32_t mesh = -1;  // index into the mesh section, -1 without a MeshComponent
+    String mesh_asset {};
+    String material_asset {};
+    float position[3] = {};
+    float rotation[4] = {};  // w, x, y, z
+    float scale[3] = {};
+    int32_t material = -1;  // index into the material section, -1 for the default material
+    int32_t camera = -1;    // index into the camera section, -1 without a CameraComponent
+};
+
+struct MeshRecord
+{
+    uint64_t first_vertex = 0;
+    uint64_t vertex_count = 0;
+    uint64_t first_index = 0;
+    uint64_t index_count = 0;
+    uint32_t first_lod = 0;
+    uint32_t lod_count = 0;  // coarser levels of this mesh; 0 for the levels themselves
+    uint64_t reserved = 0;
+};
+
+/**
+ * @brief One coarser level of a mesh, finest first; its geometry is another MeshRecord.
+ */
+struct LodRecord
+{
+    uint32_t mesh = 0;  // index into the mesh section
+    float error = 0.0F;  // MeshLod::error
+    uint32_t reserved[2] = {};
+};
+
+/**
+ * @brief A MaterialDescriptor; texture references are the resolved paths SceneLoader set.
+ */
+struct MaterialRecord
+{
+    String shader {};
+    String textures[static_cast<size_t>(TextureSlot::Count)] {};
+};
+
+/**
+ * @brief A CameraComponent's settings; view and projection are derived again on load.
+ */
+struct CameraRecord
+{
+    uint32_t projection = 0;  // ProjectionType
+    float vertical_fov_degrees = 0.0F;
+    float aspect_ratio = 0.0F;
+    float near_plane = 0.0F;
+    float far_plane = 0.0F;
+    float ortho_height = 0.0F;
+    float exposure = 0.0F;
+    uint32_t reserved = 0;
+    float clear_color[4] = {};  // rgba
+};
+
+/**
+ * @brief A file the scene was cooked from; the cooked scene is stale once any changes.
+ */
+struct SourceRecord
+{
+    String path {};
+    uint64_t size = 0;
+    int64_t write_time = 0;  // std::filesystem::file_time_type ticks
+    uint64_t content_hash = 0;  // HashFileContents at cook time
+};
+
+static_assert(sizeof(Header) == 32);
+static_assert(sizeof(Section) == 32);
+static_assert(sizeof(EntityRecord) % kAlignment == 0);
+static_assert(sizeof(MeshRecord) % kAlignment == 0);
+static_assert(sizeof(SourceRecord) % kAlignment == 0);
+static_assert(sizeof(LodRecord) % kAlignment == 0);
+static_assert(sizeof(MaterialRecord) % kAlignment == 0);
+static_assert(sizeof(CameraRecord) % kAlignment == 0);
+}  // namespace COOKED
+
+/**
+ * @brief Where the cooked counterpart of a scene file lives (next to it, as .zkscene).
+ */
+std::filesystem::path CookedScenePath(const std::filesystem::path& scene_path);
+
+/**
+ * @brief Serializes scene's runtime entities, transforms, cameras, mesh geometry and LOD
+ *        chains; meshes shared between entities are written once. Writes atomically through a
+ *        temporary file. Throws when an entity uses a registered component that has no cooked
+ *        form, so such scenes keep loading from their source.
+ */
+void CookScene(
+    const Scene& scene, std::span<const std::filesystem::path> sources, const std::filesystem::path& out_path);
+
+/**
+ * @brief True when path is a cooked scene of the current version whose sources all still
+ *        match what was cooked. A source with the recorded size and modification time is
+ *        trusted as is; one whose time changed (a checkout, a restored cache entry) is hashed.
+ */
+bool IsCookedSceneCurrent(const std::filesystem::path& path);
+
+/**
+ * @brief Source files recorded in a cooked scene; empty when it cannot be read.
+ */
+std::vector<std::filesystem::path> CookedSceneSources(const std::filesystem::path& path);
+
+/**
+ * @brief Maps a cooked scene and builds its entities; throws std::runtime_error when the
+ *        file is malformed or from another version.
+ */
+std::unique_ptr<Scene> LoadCookedScene(const std::filesystem::path& path);
+}  // namespace ENGINE
+}  // namespace ZKT
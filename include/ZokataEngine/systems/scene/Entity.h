@@ -35,6 +35,7 @@ public:
      * @brief Human-readable name of the entity.
      */
     const std::string& Name() const;
+    void SetName(std::string name);
 
     /**
      * @brief Returns the parent entity (nullptr if root).
@@ -82,11 +83,22 @@ public:
      */
     void AddComponent(std::unique_ptr<Component> comp);
 
+    /**
+     * @brief Detaches a component and hands it back; the Transform cannot be removed.
+     * @return nullptr when comp is not attached here or is the Transform.
+     */
+    std::unique_ptr<Component> RemoveComponent(Component& comp);
+
     /**
      * @brief Adds a child entity, rewiring its parent pointer.
      * @return Raw pointer to the inserted child.
      */
     Entity* AddChild(std::unique_ptr<Entity> child);
+    /**
+     * @brief Detaches a direct child and hands it back with its parent pointer cleared.
+     * @return nullptr when child is not a direct child of this entity.
+     */
+    std::unique_ptr<Entity> RemoveChild(Entity& child);
 
     template <typename T>
     T* GetComponent()
@@ -243,6 +255,7 @@ public:
 
     // Lifecycle for this entity only (no children) driven by SceneManager/Scene.
     void OnEnableSelf();
+    void OnDisableSelf();
     void StartSelf();
     void UpdateSelf(float delta_seconds);
     void FixedUpdateSelf(float fixed_seconds);
@@ -3,10 +3,12 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "ZokataEngine/systems/scene/Entity.h"
+#include "ZokataEngine/systems/spatial/SceneSpatialIndex.h"
 
 namespace ZKT
 {
@@ -15,11 +17,13 @@ namespace ENGINE
 struct SceneComponentSummary
 {
     std::string name;
+    uint64_t source_hash = 0;  // hash of the component's scene data; 0 when unknown
 };
 
 struct SceneEntity
 {
     int64_t id {-1};
+    int64_t parent_id {-1};
     std::string name;
     std::vector<SceneComponentSummary> components;
 };
@@ -44,6 +48,10 @@ public:
      * @brief Adds a parsed/static entity entry.
      */
     void AddEntity(SceneEntity entity);
+    /**
+     * @brief Replaces the parsed/static view, e.g. after a hot reload applied a new version.
+     */
+    void SetEntities(std::vector<SceneEntity> entities);
 
     // Runtime entity management.
     /**
@@ -51,11 +59,21 @@ public:
      */
     Entity& CreateRuntimeEntity(int64_t id, const std::string& name = "", Entity* parent = nullptr);
     /**
-     * @brief Adds a root-level runtime entity already created by caller.
+     * @brief Adds a root-level runtime entity already created by caller, registering its
+     *        whole subtree in preorder.
      */
     void AddRoot(std::unique_ptr<Entity> entity);
     const std::vector<std::unique_ptr<Entity>>& RuntimeRoots() const;
     const std::vector<Entity*>& AllRuntimeEntities() const;
+    /**
+     * @brief Moves entity, with its subtree, under parent (nullptr for a root).
+     */
+    void ReparentEntity(Entity& entity, Entity* parent);
+    /**
+     * @brief Destroys entities and their subtrees; listing an entity with its ancestor is fine.
+     *        Components are not disabled first; a running scene's caller does that.
+     */
+    void DestroyEntities(std::span<Entity* const> entities);
 
     // Lifecycle orchestration (pre-order traversal).
     /**
@@ -75,16 +93,30 @@ public:
      */
     void FixedUpdate(float fixed_seconds);
 
+    /**
+     * @brief Propagates dirty local transforms to world space and refreshes the spatial index.
+     */
+    void UpdateTransforms();
+    /**
+     * @brief Spatial index over all runtime entities (raycast/overlap/nearest queries).
+     */
+    SceneSpatialIndex& Spatial();
+    const SceneSpatialIndex& Spatial() const;
+
 private:
     std::string name_;
     std::vector<SceneEntity> entities_;
 
     std::vector<std::unique_ptr<Entity>> roots_;
     std::vector<Entity*> all_entities_;
+    SceneSpatialIndex spatial_;
+    std::vector<Entity*> changed_transforms_;
 
     void RegisterEntity(Entity& entity);
+    std::unique_ptr<Entity> DetachEntity(Entity& entity);
     void ForEachEntityPreorder(const std::function<void(Entity&)>& fn);
     static void TraversePreorder(Entity& entity, const std::function<void(Entity&)>& fn);
+    void PropagateTransform(Entity& entity, const TransformComponent* parent, bool parent_changed);
 };
 }  // namespace ENGINE
 }  // namespace ZKT
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class Entity;
+
+/**
+ * @brief One node of a component's fields as written in a scene file, stored flat in preorder.
+ *
+ * Keys and scalars are offsets into the owning string pool; a node's subtree ends at end.
+ */
+struct SceneFieldNode
+{
+    enum class Kind : uint8_t
+    {
+        Scalar,
+        Map,
+        Sequence
+    };
+
+    Kind kind = Kind::Scalar;
+    uint32_t key_offset = 0;
+    uint32_t key_size = 0;
+    uint32_t value_offset = 0;
+    uint32_t value_size = 0;
+    uint32_t end = 0;  // index one past the last node of this subtree
+};
+
+/**
+ * @brief Read-only view of a component's fields.
+ *
+ * Lookups mirror YAML::Node: a missing key yields an empty view that converts to false, and
+ * the As* conversions return the fallback for missing or malformed values.
+ */
+class SceneFields
+{
+public:
+    SceneFields() = default;
+    SceneFields(const SceneFieldNode* nodes, const char* strings, uint32_t index);
+
+    explicit operator bool() const;
+    bool IsScalar() const;
+    bool IsMap() const;
+    bool IsSequence() const;
+
+    /**
+     * @brief Value of key in a map.
+     */
+    SceneFields operator[](std::string_view key) const;
+    /**
+     * @brief Element count of a sequence or entry count of a map.
+     */
+    size_t Size() const;
+    /**
+     * @brief Calls fn(key, value) for every map entry, or fn("", item) for sequence items.
+     */
+    void ForEach(const std::function<void(std::string_view, const SceneFields&)>& fn) const;
+
+    /**
+     * @brief The scalar's text; empty for collections and missing values.
+     */
+    std::string_view Scalar() const;
+    float AsFloat(float fallback = 0.0F) const;
+    int64_t AsInt(int64_t fallback = 0) const;
+    std::string AsString(std::string_view fallback = {}) const;
+
+private:
+    const SceneFieldNode* nodes_ = nullptr;
+    const char* strings_ = nullptr;
+    uint32_t index_ = 0;
+};
+
+/**
+ * @brief A MeshRenderer waiting for its mesh; the loader resolves these after all entities
+ *        are built, so every referenced file is imported once.
+ */
+struct SceneMeshRequest
+{
+    Entity* entity = nullptr;
+    std::string mesh;      // key in scene.assets.meshes, or a direct "file#Mesh" reference
+    std::string material;  // key in scene.assets.materials, or a direct reference
+};
+
+/**
+ * @brief Per-batch output of deserializers that has to be finished by the loader.
+ */
+struct SceneLoadContext
+{
+    std::vector<SceneMeshRequest> meshes;
+};
+
+/**
+ * @brief How one component type named in scene files is read and hot-reloaded.
+ */
+struct SceneComponentType
+{
+    std::string name;
+    /**
+     * @brief Adds or configures the component on a freshly built entity. Runs on job system
+     *        workers, one batch of entities per call; must only touch entity and context.
+     */
+    std::function<void(Entity& entity, const SceneFields& fields, SceneLoadContext& context)> deserialize;
+    /**
+     * @brief Hot reload: brings live's component in line with fresh, a newly loaded version of
+     *        the same entity; fresh is null when the component was removed from the file.
+     *        running tells whether lifecycle hooks have to be called.
+     */
+    std::function<void(Entity& live, Entity* fresh, bool running)> apply;
+};
+
+/**
+ * @brief Component types known to the scene loader, keyed by interned name.
+ *
+ * The loader resolves each component name once while parsing and keeps only the small id, so
+ * building entities never compares strings. Register custom types before loading scenes;
+ * lookups are not synchronized with registration.
+ */
+class SceneComponentRegistry
+{
+public:
+    static constexpr uint32_t kUnknown = UINT32_MAX;
+
+    /**
+     * @brief Registry with the engine's components: Transform, Camera and MeshRenderer.
+     */
+    static SceneComponentRegistry& Default();
+
+    /**
+     * @brief Adds type, or replaces the one registered under the same name; returns its id.
+     */
+    uint32_t Register(SceneComponentType type);
+    /**
+     * @brief Id of the type registered under name, or kUnknown.
+     */
+    uint32_t Find(std::string_view name) const;
+    const SceneComponentType& Type(uint32_t id) const;
+
+private:
+    struct NameHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const
+        {
+            return std::hash<std::string_view> {}(name);
+        }
+    };
+
+    std::vector<SceneComponentType> types_;
+    std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> ids_;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
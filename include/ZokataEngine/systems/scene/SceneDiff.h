@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "ZokataEngine/systems/scene/Scene.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+struct SceneDiffOptions
+{
+    bool running = false;              // live has been started: run component lifecycle hooks
+    bool reapply_components = false;   // treat every component as changed (e.g. an asset changed)
+};
+
+struct SceneDiffStats
+{
+    uint32_t added = 0;
+    uint32_t removed = 0;
+    uint32_t changed = 0;     // entities renamed, moved or with changed components
+    uint32_t components = 0;  // components added, replaced or removed
+};
+
+/**
+ * @brief Brings live in line with fresh, a newly loaded version of the same scene file.
+ *
+ * Entities are matched by id between the two parsed views (Scene::Entities()). Only entities
+ * that were added, removed, renamed or reparented, or whose components' source hashes differ,
+ * are touched; everything else keeps its runtime state. Changed components are applied through
+ * the apply hooks of SceneComponentRegistry::Default(), which may move them out of fresh, so
+ * fresh must be discarded afterwards. Types without a hook are only recorded in the parsed view.
+ *
+ * Returns nullopt without changing anything when either view lacks unique, non-negative ids;
+ * the whole scene has to be replaced then.
+ */
+std::optional<SceneDiffStats> ApplySceneDiff(Scene& live, Scene& fresh, const SceneDiffOptions& options = {});
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -1,26 +1,132 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
-#include <yaml-cpp/yaml.h>
-
+#include "ZokataEngine/systems/asset/AssetManager.h"
+#include "ZokataEngine/systems/mesh/MeshOptimizer.h"
 #include "ZokataEngine/systems/scene/Scene.h"
+#include "ZokataEngine/systems/scene/SceneComponentRegistry.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
 
 namespace ZKT
 {
 namespace ENGINE
 {
+class MeshComponent;
+struct TextureAsset;
+
+struct SceneLoaderStats
+{
+    uint32_t entities = 0;
+    uint32_t roots = 0;
+    uint32_t batches = 0;      // groups of root subtrees built in parallel
+    bool streamed = false;     // read by ReadYaml; false when the file needed yaml-cpp
+    float parse_ms = 0.0F;
+    float build_ms = 0.0F;     // entities and components, on the job system
+    float attach_ms = 0.0F;    // registering entities with the scene
+};
+
+/**
+ * @brief What import-time optimization did to one mesh a LoadFromFile imported.
+ */
+struct SceneMeshReport
+{
+    std::filesystem::path file;
+    std::string mesh;  // glTF mesh name
+    MeshOptimizeReport optimization;
+};
+
+/**
+ * @brief Builds a Scene from a YAML scene file.
+ *
+ * The file is streamed through ReadYaml into compact per-entity records without a document
+ * tree; components are resolved against SceneComponentRegistry::Default() by name once while
+ * parsing. Consecutive root subtrees are grouped into batches that are built into entities on
+ * the job system, then attached in file order.
+ *
+ * An entry of scene.assets.materials is an inline material: a map with an optional shader and
+ * one cooked .ktx2 texture per slot (albedo, normal, metallic_roughness, occlusion, emissive),
+ * resolved like mesh paths. A string entry would name a material file, which has no format
+ * yet; it is logged and its meshes keep the default material.
+ */
 class SceneLoader
 {
 public:
+    SceneLoader() = default;
+    /**
+     * @brief Requests meshes and material textures from assets instead of importing meshes
+     *        before LoadFromFile returns; entities draw once their mesh finished loading.
+     */
+    explicit SceneLoader(AssetManager* assets);
+
     /**
      * @brief Loads a scene from a YAML file and builds entities/components.
      */
     std::unique_ptr<Scene> LoadFromFile(const std::filesystem::path& path);
+    /**
+     * @brief Files the last LoadFromFile read: the scene itself, then every imported mesh file
+     *        and its external buffers.
+     */
+    const std::vector<std::filesystem::path>& Dependencies() const;
+    /**
+     * @brief Counts and timings of the last LoadFromFile.
+     */
+    const SceneLoaderStats& Stats() const;
+    /**
+     * @brief One report per mesh the last LoadFromFile imported itself; empty when meshes were
+     *        requested from an AssetManager.
+     */
+    const std::vector<SceneMeshReport>& MeshReports() const;
 
 private:
-    void ParseEntities(const YAML::Node& entities_node, Scene& scene, Entity* parent = nullptr);
+    /**
+     * @brief An inline material and, with an AssetManager, handles to its textures.
+     */
+    struct MaterialDefinition
+    {
+        MaterialDescriptor descriptor;
+        std::vector<AssetHandle<TextureAsset>> textures;
+    };
+
+    /**
+     * @brief scene.assets tables: names used by components -> asset references or materials.
+     */
+    struct AssetTables
+    {
+        std::unordered_map<std::string, std::string> meshes;
+        std::unordered_map<std::string, std::string> materials;
+        std::unordered_map<std::string, MaterialDefinition> definitions;  // inline materials
+    };
+
+    AssetManager* assets_ = nullptr;
+    std::vector<SceneMeshRequest> pending_meshes_;
+    std::vector<std::filesystem::path> dependencies_;
+    std::vector<SceneMeshReport> mesh_reports_;
+    SceneLoaderStats stats_ {};
+
+    /**
+     * @brief Imports every referenced mesh once, decoding primitives on the job system, and
+     *        attaches MeshComponents to the waiting entities with a LOD chain per mesh.
+     */
+    void LoadMeshes(const AssetTables& tables, const std::filesystem::path& scene_path, Scene& scene);
+    /**
+     * @brief Hands every referenced mesh to the AssetManager and attaches pending handles.
+     */
+    void RequestMeshes(const AssetTables& tables, const std::filesystem::path& scene_path);
+    /**
+     * @brief Resolves inline materials' texture paths and, with an AssetManager, requests their
+     *        TextureAssets; warns about material file references.
+     */
+    void ResolveMaterials(AssetTables& tables, const std::filesystem::path& scene_path);
+    /**
+     * @brief Names a mesh's material and, for an inline one, sets its descriptor and textures.
+     */
+    static void BindMaterial(MeshComponent& mesh, const AssetTables& tables, const std::string& name);
 };
 }  // namespace ENGINE
 }  // namespace ZKT
@@ -11,10 +11,15 @@ namespace ZKT
 {
 namespace ENGINE
 {
+class AssetManager;
+class FileWatcher;
+
 struct SceneMetadata
 {
     std::string name;
     std::filesystem::path file_path;
+    Scene* scene = nullptr;                            // null when loading failed
+    std::vector<std::filesystem::path> dependencies;  // files whose edits reload the scene
 };
 
 // SceneManager supervises one or many loaded scenes.
@@ -24,7 +29,8 @@ struct SceneMetadata
 class SceneManager
 {
 public:
-    SceneManager() = default;
+    SceneManager();
+    ~SceneManager();
 
     /**
      * @brief Creates and registers a new empty scene.
@@ -69,18 +75,59 @@ public:
     // Discover and load .yaml/.yml scenes from a folder (searches default if empty).
     /**
      * @brief Discovers scene files and loads them into managed scenes.
+     *
+     * Files load concurrently on the job system, one scene per task, and are registered in
+     * sorted path order, so the first scene file by name becomes the active scene.
      * @param scenes_root Optional folder hint; auto-discovers if empty.
      */
     void DiscoverAndLoadScenes(const std::filesystem::path& scenes_root = {});
+    /**
+     * @brief Scenes loaded from YAML afterwards request their meshes from assets asynchronously.
+     */
+    void SetAssetManager(AssetManager* assets);
+    /**
+     * @brief Searches hint and its parents for the scenes folder.
+     */
+    static std::filesystem::path FindScenesRoot(const std::filesystem::path& hint);
+
+    /**
+     * @brief Starts watching the scenes folder and every file the loaded scenes depend on.
+     */
+    void EnableHotReload();
+    /**
+     * @brief Applies scene and asset edits seen since the last call without blocking; call
+     *        once per frame before the scenes update.
+     *
+     * An edited scene file is re-parsed and only its changed entities and components are
+     * applied (see ApplySceneDiff). An edited asset is reloaded through the AssetManager;
+     * scenes that use it without a handle (cooked geometry) re-apply their components instead.
+     */
+    void PollHotReload();
+    /**
+     * @brief Re-parses a loaded scene's file and applies only what changed.
+     */
+    void ReloadScene(const std::filesystem::path& scene_path);
 
 private:
     std::vector<std::unique_ptr<Scene>> scenes_;
     Scene* active_scene_ = nullptr;
     std::vector<SceneMetadata> scenes_metadata_;
     std::filesystem::path scenes_root_;
+    AssetManager* assets_ = nullptr;
+    std::unique_ptr<FileWatcher> watcher_;  // set while hot reload is enabled
 
-    void LoadSceneFromFile(const std::filesystem::path& scene_path);
-    static std::filesystem::path FindScenesRoot(const std::filesystem::path& hint);
+    struct LoadedSceneFile;
+
+    /**
+     * @brief Reads a scene file, preferring its cooked form; touches no manager state, so
+     *        several files can load concurrently.
+     */
+    static LoadedSceneFile LoadSceneFile(const std::filesystem::path& scene_path, AssetManager* assets);
+    void LoadSceneFromFile(SceneMetadata& metadata);
+    void RegisterLoadedScene(SceneMetadata& metadata, LoadedSceneFile loaded);
+    void ReloadScene(SceneMetadata& metadata, bool reapply_components);
+    void ReplaceScene(SceneMetadata& metadata, std::unique_ptr<Scene> scene);
+    void WatchDependencies(const SceneMetadata& metadata);
 };
 }  // namespace ENGINE
 }  // namespace ZKT
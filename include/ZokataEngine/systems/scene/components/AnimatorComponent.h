@@ -0,0 +1,82 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "ZokataEngine/systems/animation/AnimationClip.h"
+#include "ZokataEngine/systems/animation/AnimationPose.h"
+#include "ZokataEngine/systems/animation/Skeleton.h"
+#include "ZokataEngine/systems/scene/Component.h"
+#include "ZokataMath/Matrix.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Plays animation clips on a skeleton and caches the resulting matrix palettes.
+ *
+ * Update only advances clip time and cross-fades; sampling, blending and matrix
+ * computation happen in Evaluate, which AnimationSystem runs for all animators in parallel.
+ */
+class AnimatorComponent : public Component
+{
+public:
+    AnimatorComponent() = default;
+
+    void OnEnable() override;
+    void OnDisable() override;
+    void Start() override;
+    void Update(float delta_seconds) override;
+    void FixedUpdate(float fixed_seconds) override;
+
+    void SetSkeleton(std::shared_ptr<const Skeleton> skeleton);
+    const std::shared_ptr<const Skeleton>& GetSkeleton() const;
+
+    /**
+     * @brief Starts clip, cross-fading from the current one over fade_seconds.
+     */
+    void Play(std::shared_ptr<const AnimationClip> clip, float fade_seconds = 0.0F, bool loop = true);
+    void Stop();
+    bool IsPlaying() const;
+
+    float Speed() const;
+    void SetSpeed(float speed);
+
+    /**
+     * @brief Samples the active clips and rebuilds the matrix palettes; safe to run on a worker
+     *        thread as long as no other thread touches this animator.
+     */
+    void Evaluate();
+
+    const LocalPose& Pose() const;
+    std::span<const MATH::Mat4f> ModelMatrices() const;
+    std::span<const MATH::Mat4f> SkinningMatrices() const;
+
+private:
+    struct Layer
+    {
+        std::shared_ptr<const AnimationClip> clip;
+        float time = 0.0F;
+        bool loop = true;
+    };
+
+    void Advance(Layer& layer, float delta_seconds) const;
+    void ResizeBuffers();
+
+    std::shared_ptr<const Skeleton> skeleton_;
+    Layer current_ {};
+    Layer previous_ {};
+    float fade_duration_ = 0.0F;
+    float fade_elapsed_ = 0.0F;
+    float speed_ = 1.0F;
+
+    LocalPose pose_;
+    LocalPose fade_pose_;
+    ClipSampleScratch scratch_;
+    std::vector<MATH::Mat4f> model_;
+    std::vector<MATH::Mat4f> skinning_;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -1,24 +1,36 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
+#include "ZokataEngine/systems/asset/AssetManager.h"
+#include "ZokataEngine/systems/mesh/GeometryCache.h"
+#include "ZokataEngine/systems/mesh/MeshAsset.h"
 #include "ZokataEngine/systems/scene/Component.h"
 #include "ZokataEngine/systems/scene/components/Primitives/MeshPrimitives.h"
+#include "ZokataMath/Bounds.h"
 #include "ZokataRenderer/graphics/renderer/Renderable.h"
 
 namespace ZKT
 {
 namespace ENGINE
 {
+struct TextureAsset;
+
 // Scene-level mesh component: holds CPU mesh/material data, no Vulkan specifics.
 /**
  * @brief Mesh component exposing geometry/material to the renderer without API details.
+ *
+ * Geometry is held through a shared handle, so components built from the same asset or
+ * primitive parameters reference one copy. GeometryMutable() copies on write when the
+ * geometry is shared or came from the cache.
  */
 class MeshComponent : public Component, public Renderable
 {
 public:
     MeshComponent() = default;
     explicit MeshComponent(MeshGeometry geometry);
+    explicit MeshComponent(GeometryHandle geometry);
     MeshComponent(MeshGeometry geometry, MaterialDescriptor material);
 
     void OnEnable() override;
@@ -35,16 +47,32 @@ public:
      * @brief Returns immutable material descriptor.
      */
     const MaterialDescriptor& Material() const override;
+    /**
+     * @brief Cached HashMaterial of the material (recomputed after it changes).
+     */
+    uint64_t MaterialKey() const override;
+    uint32_t LodCount() const override;
+    const MeshGeometry& LodGeometry(uint32_t lod) const override;
+    const std::vector<GpuMeshlet>* Meshlets() const override;
     bool IsVisible() const override;
     bool NeedsUpload() const override;
     void MarkUploaded() override;
 
     /**
-     * @brief Replace geometry/material and mark for upload.
+     * @brief Replace geometry/material and mark for upload; new geometry drops the LOD chain.
      */
     void SetGeometry(MeshGeometry geometry);
+    /**
+     * @brief Shares existing geometry (e.g. from GeometryCache); null clears it.
+     */
+    void SetGeometry(GeometryHandle geometry);
     void SetMaterial(MaterialDescriptor material);
 
+    /**
+     * @brief Handle to the current geometry, for sharing it with other components.
+     */
+    const GeometryHandle& SharedGeometry() const;
+
     /**
      * @brief Mutable accessors that mark the component dirty.
      */
@@ -54,27 +82,102 @@ public:
     void SetVisible(bool visible);
 
     /**
-     * @brief Optional asset identifiers for deferred asset resolution.
+     * @brief Marks this mesh as an occluder rasterized into the CPU occlusion buffer.
+     */
+    void SetOccluder(bool occluder);
+    bool IsOccluder() const;
+
+    /**
+     * @brief Appends a coarser detail level; errors must not decrease along the chain.
+     */
+    void AddLod(MeshGeometry geometry, float error);
+    void AddLod(GeometryHandle geometry, float error);
+    /**
+     * @brief Replaces the whole chain (levels 1..n); chains may be shared between components.
+     */
+    void SetLods(std::vector<MeshLod> lods);
+    void ClearLods();
+    /**
+     * @brief Object-space geometric error of a level (0 for level 0).
+     */
+    float LodError(uint32_t lod) const;
+
+    /**
+     * @brief Meshlets of the current geometry, whose indices must already be in meshlet order
+     *        (MeshletMesh::DrawIndices); new or mutated geometry drops them.
+     */
+    void SetMeshlets(MeshletsHandle meshlets);
+
+    /**
+     * @brief Level picked by the LOD system last frame; kept for hysteresis.
+     */
+    uint32_t SelectedLod() const;
+    void SetSelectedLod(uint32_t lod);
+
+    /**
+     * @brief Object-space bounds of the geometry (cached until geometry changes).
+     */
+    const MATH::Aabb& LocalBounds() const;
+
+    /**
+     * @brief Geometry, LOD chain and meshlets to take from an asset once it finished loading; until then
+     *        the current geometry (usually none) is drawn. Update() picks it up without blocking.
+     */
+    void SetMeshAsset(AssetHandle<ENGINE::MeshAsset> asset);
+    const AssetHandle<ENGINE::MeshAsset>& MeshAsset() const;
+    /**
+     * @brief True while a mesh asset is set but its geometry has not been picked up yet.
+     */
+    bool IsMeshAssetPending() const;
+
+    /**
+     * @brief Asset identifiers as written in the scene, kept for cooking and tooling.
      */
     const std::string& MeshAssetId() const;
     void SetMeshAssetId(std::string id);
 
+    /**
+     * @brief Material name or reference as written in the scene; only a name. SceneLoader
+     *        applies the material itself through SetMaterial and SetTextureAssets.
+     */
     const std::string& MaterialAssetId() const;
     void SetMaterialAssetId(std::string id);
 
     /**
-     * @brief Convenience helpers to build common primitive geometry.
+     * @brief Texture assets the material's slots name, held so they stay loaded while the
+     *        component lives; MaterialTextureSystem streams them once the mesh is drawn.
+     */
+    void SetTextureAssets(std::vector<AssetHandle<TextureAsset>> textures);
+    const std::vector<AssetHandle<TextureAsset>>& TextureAssets() const;
+
+    /**
+     * @brief Convenience helpers for common primitives, shared through GeometryCache::Default().
      */
     void SetPrimitiveCube(const CubeParams& params = {});
     void SetPrimitiveSphere(const SphereParams& params = {});
 
 private:
-    MeshGeometry geometry_;
+    GeometryHandle geometry_;
+    bool owns_geometry_ = false;  // geometry_ was created here and never handed to the cache
     MaterialDescriptor material_;
+    std::vector<MeshLod> lods_;  // levels 1..n
+    MeshletsHandle meshlets_;
+    uint32_t selected_lod_ = 0;
     bool visible_ = true;
+    bool occluder_ = false;
     bool dirty_ = true;
+    mutable MATH::Aabb local_bounds_ {};
+    mutable bool bounds_dirty_ = true;
+    mutable uint64_t material_key_ = 0;
+    mutable bool material_key_dirty_ = true;
     std::string mesh_asset_id_;
     std::string material_asset_id_;
+    std::vector<AssetHandle<TextureAsset>> texture_assets_;
+    AssetHandle<ENGINE::MeshAsset> mesh_asset_;
+    bool mesh_asset_pending_ = false;
+    uint32_t mesh_asset_version_ = 0;  // asset version the current geometry came from
+
+    void ResolveMeshAsset();
 };
 }  // namespace ENGINE
 }  // namespace ZKT
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 #include "ZokataMath/Vector.h"
 #include "ZokataRenderer/graphics/renderer/Renderable.h"
@@ -9,6 +11,8 @@ namespace ZKT
 {
 namespace ENGINE
 {
+class JobSystem;
+
 /**
  * @brief Parameters for a cube (box) mesh.
  */
@@ -27,6 +31,29 @@ struct SphereParams
     uint32_t latitude_segments = 16;
 };
 
+/**
+ * @brief Parameters for a flat grid in the XZ plane, centred on the origin and facing +Y.
+ */
+struct GridParams
+{
+    MATH::Vec2f size {1.0F, 1.0F};  // extent along X and Z
+    uint32_t x_segments = 1;
+    uint32_t z_segments = 1;
+};
+
+/**
+ * @brief Exact element counts a generator writes.
+ */
+struct MeshSize
+{
+    size_t vertices = 0;
+    size_t indices = 0;
+};
+
+MeshSize CubeSize(const CubeParams& params = {});
+MeshSize SphereSize(const SphereParams& params = {});
+MeshSize GridSize(const GridParams& params = {});
+
 /**
  * @brief Builds a cube mesh with positions, normals, uvs, tangents, and indices.
  */
@@ -36,5 +63,21 @@ MeshGeometry MakeCube(const CubeParams& params = {});
  * @brief Builds a UV sphere mesh with positions, normals, uvs, tangents, and indices.
  */
 MeshGeometry MakeSphere(const SphereParams& params = {});
+
+/**
+ * @brief Builds a grid mesh with positions, normals, uvs, tangents, and indices.
+ */
+MeshGeometry MakeGrid(const GridParams& params = {});
+
+// Direct writers: fill caller memory (e.g. a mapped staging buffer) without intermediate
+// allocations. The spans must hold at least the counts reported by the matching *Size call.
+// Make* returns exactly what these write: sphere and grid vertices are in row order and their
+// triangles in narrow column strips, which keeps a 16-entry post-transform cache warm without
+// an OptimizeMesh pass. With a job system, sphere and grid rows are written in parallel bands.
+void WriteCube(const CubeParams& params, std::span<MeshVertex> vertices, std::span<uint32_t> indices);
+void WriteSphere(
+    const SphereParams& params, std::span<MeshVertex> vertices, std::span<uint32_t> indices, JobSystem* jobs = nullptr);
+void WriteGrid(
+    const GridParams& params, std::span<MeshVertex> vertices, std::span<uint32_t> indices, JobSystem* jobs = nullptr);
 }  // namespace ENGINE
 }  // namespace ZKT
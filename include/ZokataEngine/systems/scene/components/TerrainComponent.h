@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+
+#include "ZokataEngine/systems/scene/Component.h"
+#include "ZokataEngine/systems/terrain/Heightfield.h"
+#include "ZokataEngine/systems/terrain/TerrainTree.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Heightfield terrain centered on the owning entity.
+ *
+ * The component only holds the source data and settings; TerrainSystem streams and selects
+ * its chunks every frame. Terrain follows the entity's world position but ignores its
+ * rotation and scale: size and height_scale in the settings set the world extent.
+ */
+class TerrainComponent : public Component
+{
+public:
+    TerrainComponent() = default;
+    explicit TerrainComponent(std::shared_ptr<const Heightfield> heightfield, TerrainSettings settings = {});
+
+    void OnEnable() override;
+    void OnDisable() override;
+    void Start() override;
+    void Update(float delta_seconds) override;
+    void FixedUpdate(float fixed_seconds) override;
+
+    /**
+     * @brief Replaces the heightfield; resident chunks are rebuilt on the next update.
+     */
+    void SetHeightfield(std::shared_ptr<const Heightfield> heightfield);
+    const std::shared_ptr<const Heightfield>& GetHeightfield() const;
+
+    const TerrainSettings& Settings() const;
+    /**
+     * @brief Changing any setting rebuilds the terrain from its root chunk.
+     */
+    TerrainSettings& SettingsMutable();
+
+    const MaterialDescriptor& Material() const;
+    void SetMaterial(MaterialDescriptor material);
+
+    TerrainTree& Tree();
+    const TerrainTree& Tree() const;
+
+private:
+    std::shared_ptr<const Heightfield> heightfield_;
+    TerrainSettings settings_ {};
+    MaterialDescriptor material_ {};
+    TerrainTree tree_;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -94,9 +94,17 @@ public:
      * @brief Recomputes world transforms from the local transform and optional parent.
      */
     void UpdateWorld(const TransformComponent* parent);
+    /**
+     * @brief Whether the local transform changed since the last UpdateWorld.
+     */
+    bool IsDirty() const;
+    /**
+     * @brief Makes the next transform pass report this entity as changed, e.g. so the spatial
+     *        index picks up new mesh bounds.
+     */
+    void MarkDirty();
 
 private:
-    void MarkDirty();
 
     MATH::Vec3f position_ {0.0F, 0.0F, 0.0F};
     MATH::Vec3f scale_ {1.0F, 1.0F, 1.0F};
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "ZokataMath/Bounds.h"
+#include "ZokataMath/Vector.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Incremental bounding volume hierarchy over fat AABBs.
+ *
+ * Leaves store a fattened box so small movements do not touch the tree; internal nodes
+ * are rebalanced with AVL-style rotations on insert/remove. Proxies are stable indices.
+ */
+class DynamicAabbTree
+{
+public:
+    static constexpr int32_t kNullNode = -1;
+
+    /**
+     * @brief Creates a tree.
+     * @param fat_margin Padding added around each leaf box.
+     * @param displacement_multiplier How far ahead of the motion the fat box is stretched.
+     */
+    explicit DynamicAabbTree(float fat_margin = 0.1F, float displacement_multiplier = 2.0F);
+
+    /**
+     * @brief Inserts a leaf and returns its proxy id.
+     */
+    int32_t CreateProxy(const MATH::Aabb& box, uint64_t user_data);
+    /**
+     * @brief Removes a leaf previously returned by CreateProxy.
+     */
+    void DestroyProxy(int32_t proxy);
+    /**
+     * @brief Updates a leaf after its tight box changed.
+     * @param displacement Movement since the last update, used to predict the fat box.
+     * @return True if the leaf was reinserted (tight box escaped its fat box).
+     */
+    bool MoveProxy(int32_t proxy, const MATH::Aabb& box, const MATH::Vec3f& displacement = {});
+
+    uint64_t UserData(int32_t proxy) const;
+    void SetUserData(int32_t proxy, uint64_t user_data);
+    const MATH::Aabb& FatAabb(int32_t proxy) const;
+
+    void Clear();
+    int32_t ProxyCount() const;
+    int32_t Height() const;
+    /**
+     * @brief Root box, or an empty box when the tree has no leaves.
+     */
+    MATH::Aabb Bounds() const;
+
+    /**
+     * @brief Visits every leaf whose fat box overlaps the query box.
+     * @param fn bool(int32_t proxy); return false to stop the query.
+     */
+    template <typename Fn>
+    void QueryOverlap(const MATH::Aabb& box, Fn&& fn) const
+    {
+        Traverse([&box](const MATH::Aabb& node_box) { return node_box.Overlaps(box); }, fn);
+    }
+
+    /**
+     * @brief Visits every leaf whose fat box overlaps the query sphere.
+     */
+    template <typename Fn>
+    void QueryOverlap(const MATH::Sphere& sphere, Fn&& fn) const
+    {
+        Traverse([&sphere](const MATH::Aabb& node_box) { return node_box.Overlaps(sphere); }, fn);
+    }
+
+    /**
+     * @brief Visits every leaf whose fat box intersects the frustum.
+     */
+    template <typename Fn>
+    void QueryOverlap(const MATH::Frustum& frustum, Fn&& fn) const
+    {
+        Traverse([&frustum](const MATH::Aabb& node_box) { return frustum.Intersects(node_box); }, fn);
+    }
+
+    /**
+     * @brief Tests leaves against up to 32 frustums in a single traversal.
+     *
+     * Each stack entry carries the views still undecided for its subtree and the views that
+     * fully contain it; contained views skip plane tests below that node.
+     * @param fn bool(int32_t proxy, uint32_t view_mask) with one bit per visible frustum;
+     *           return false to stop the query.
+     */
+    template <typename Fn>
+    void QueryFrustums(std::span<const MATH::Frustum> frustums, uint32_t view_mask, Fn&& fn) const
+    {
+        if (root_ == kNullNode || frustums.empty())
+        {
+            return;
+        }
+        if (frustums.size() < 32)
+        {
+            view_mask &= (1U << frustums.size()) - 1U;
+        }
+
+        TraversalStack<ViewEntry> stack;
+        stack.push_back(ViewEntry{root_, view_mask, 0});
+        while (!stack.empty())
+        {
+            ViewEntry entry = stack.back();
+            stack.pop_back();
+            const Node& node = nodes_[entry.id];
+
+            for (uint32_t pending = entry.testing; pending != 0; pending &= pending - 1)
+            {
+                const auto view = static_cast<uint32_t>(std::countr_zero(pending));
+                const uint32_t bit = 1U << view;
+                const MATH::Containment containment = frustums[view].Classify(node.box);
+                if (containment == MATH::Containment::Outside)
+                {
+                    entry.testing &= ~bit;
+                }
+                else if (containment == MATH::Containment::Inside)
+                {
+                    entry.testing &= ~bit;
+                    entry.inside |= bit;
+                }
+            }
+
+            const uint32_t visible = entry.testing | entry.inside;
+            if (visible == 0)
+            {
+                continue;
+            }
+            if (node.IsLeaf())
+            {
+                if (!fn(entry.id, visible))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                stack.push_back(ViewEntry{node.child_a, entry.testing, entry.inside});
+                stack.push_back(ViewEntry{node.child_b, entry.testing, entry.inside});
+            }
+        }
+    }
+
+    /**
+     * @brief Casts a ray against leaf fat boxes in front-to-back order.
+     * @param fn float(int32_t proxy, const MATH::Ray& ray, float max_t) returning the new clip
+     *           distance: a value < 0 terminates, max_t continues unclipped, smaller clips.
+     */
+    template <typename Fn>
+    void Raycast(const MATH::Ray& ray, float max_t, Fn&& fn) const
+    {
+        if (root_ == kNullNode)
+        {
+            return;
+        }
+
+        const MATH::Vec3f inv_dir = MATH::SafeReciprocal(ray.direction);
+        TraversalStack<> stack;
+        stack.push_back(root_);
+
+        while (!stack.empty())
+        {
+            const int32_t id = stack.back();
+            stack.pop_back();
+            const Node& node = nodes_[id];
+
+            float t_enter = 0.0F;
+            if (!node.box.IntersectRay(ray.origin, inv_dir, max_t, t_enter))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                const float clipped = fn(id, ray, max_t);
+                if (clipped < 0.0F)
+                {
+                    return;
+                }
+                max_t = std::min(max_t, clipped);
+                continue;
+            }
+
+            // Push the farther child first so the nearer one is visited next.
+            float t_a = 0.0F;
+            float t_b = 0.0F;
+            const bool hit_a = nodes_[node.child_a].box.IntersectRay(ray.origin, inv_dir, max_t, t_a);
+            const bool hit_b = nodes_[node.child_b].box.IntersectRay(ray.origin, inv_dir, max_t, t_b);
+            if (hit_a && hit_b)
+            {
+                stack.push_back(t_a <= t_b ? node.child_b : node.child_a);
+                stack.push_back(t_a <= t_b ? node.child_a : node.child_b);
+            }
+            else if (hit_a)
+            {
+                stack.push_back(node.child_a);
+            }
+            else if (hit_b)
+            {
+                stack.push_back(node.child_b);
+            }
+        }
+    }
+
+    /**
+     * @brief Best-first k-nearest search by distance from point to leaf fat boxes.
+     * @param distance_sq float(int32_t proxy) returning the exact squared distance for a leaf.
+     * @param out Receives (proxy, squared distance) pairs sorted by distance; cleared first.
+     */
+    template <typename Fn>
+    void QueryNearest(const MATH::Vec3f& point,
+                      size_t k,
+                      float max_distance,
+                      Fn&& distance_sq,
+                      std::vector<std::pair<int32_t, float>>& out) const
+    {
+        out.clear();
+        if (root_ == kNullNode || k == 0)
+        {
+            return;
+        }
+
+        using Entry = std::pair<float, int32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+        float bound_sq = max_distance * max_distance;
+        open.emplace(nodes_[root_].box.DistanceSquared(point), root_);
+
+        while (!open.empty())
+        {
+            const auto [node_dist_sq, id] = open.top();
+            open.pop();
+            if (node_dist_sq > bound_sq)
+            {
+                break;
+            }
+
+            const Node& node = nodes_[id];
+            if (node.IsLeaf())
+            {
+                const float d = distance_sq(id);
+                if (d > bound_sq)
+                {
+                    continue;
+                }
+                InsertSorted(out, {id, d}, k);
+                if (out.size() == k)
+                {
+                    bound_sq = out.back().second;
+                }
+                continue;
+            }
+
+            for (const int32_t child : {node.child_a, node.child_b})
+            {
+                const float d = nodes_[child].box.DistanceSquared(point);
+                if (d <= bound_sq)
+                {
+                    open.emplace(d, child);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Runs many box queries back to back against the same tree snapshot.
+     * @param fn bool(size_t query_index, int32_t proxy).
+     */
+    template <typename Fn>
+    void QueryOverlapBatch(std::span<const MATH::Aabb> boxes, Fn&& fn) const
+    {
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            QueryOverlap(boxes[i], [&fn, i](int32_t proxy) { return fn(i, proxy); });
+        }
+    }
+
+private:
+    struct Node
+    {
+        MATH::Aabb box {};
+        uint64_t user_data = 0;
+        int32_t parent = kNullNode;  // doubles as the free-list link for unused nodes
+        int32_t child_a = kNullNode;
+        int32_t child_b = kNullNode;
+        int32_t height = -1;  // 0 for leaves, -1 for free nodes
+
+        bool IsLeaf() const { return child_a == kNullNode; }
+    };
+
+    struct ViewEntry
+    {
+        int32_t id = kNullNode;
+        uint32_t testing = 0;  // views that still intersect this subtree's boundary
+        uint32_t inside = 0;   // views that fully contain this subtree
+    };
+
+    // Fixed inline storage that spills to the heap only for degenerate trees.
+    template <typename T = int32_t>
+    class TraversalStack
+    {
+    public:
+        void push_back(const T& value)
+        {
+            if (size_ < kInlineCapacity)
+            {
+                inline_[size_++] = value;
+                return;
+            }
+            overflow_.push_back(value);
+            ++size_;
+        }
+        const T& back() const { return size_ > kInlineCapacity ? overflow_.back() : inline_[size_ - 1]; }
+        void pop_back()
+        {
+            if (size_ > kInlineCapacity)
+            {
+                overflow_.pop_back();
+            }
+            --size_;
+        }
+        bool empty() const { return size_ == 0; }
+
+    private:
+        static constexpr size_t kInlineCapacity = 128;
+        T inline_[kInlineCapacity];
+        size_t size_ = 0;
+        std::vector<T> overflow_;
+    };
+
+    std::vector<Node> nodes_;
+    int32_t root_ = kNullNode;
+    int32_t free_list_ = kNullNode;
+    int32_t proxy_count_ = 0;
+    float fat_margin_ = 0.1F;
+    float displacement_multiplier_ = 2.0F;
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t id);
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+    int32_t Balance(int32_t a);
+    void RefitUpwards(int32_t id);
+
+    static void InsertSorted(std::vector<std::pair<int32_t, float>>& out,
+                             std::pair<int32_t, float> entry,
+                             size_t k);
+
+    template <typename Test, typename Fn>
+    void Traverse(const Test& test, Fn& fn) const
+    {
+        if (root_ == kNullNode)
+        {
+            return;
+        }
+
+        TraversalStack<> stack;
+        stack.push_back(root_);
+        while (!stack.empty())
+        {
+            const int32_t id = stack.back();
+            stack.pop_back();
+            const Node& node = nodes_[id];
+            if (!test(node.box))
+            {
+                continue;
+            }
+            if (node.IsLeaf())
+            {
+                if (!fn(id))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                stack.push_back(node.child_a);
+                stack.push_back(node.child_b);
+            }
+        }
+    }
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "ZokataEngine/systems/spatial/DynamicAabbTree.h"
+#include "ZokataMath/Bounds.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class Entity;
+
+struct SpatialViewHit
+{
+    Entity* entity = nullptr;
+    uint32_t view_mask = 0;  // bit i set when the entity is inside frustum i
+    bool has_mesh = false;   // counted by SceneSpatialIndex::MeshCount
+};
+
+struct SpatialRaycastHit
+{
+    Entity* entity = nullptr;
+    float distance = 0.0F;  // in units of the ray direction length
+    MATH::Vec3f point {0.0F, 0.0F, 0.0F};
+};
+
+/**
+ * @brief Keeps a DynamicAabbTree in sync with a scene's runtime entities.
+ *
+ * Entities are registered by the owning Scene; world bounds come from the entity's
+ * MeshComponent (or a point at its world position) and are refreshed whenever the scene's
+ * transform pass reports the entity's world transform changed.
+ */
+class SceneSpatialIndex
+{
+public:
+    SceneSpatialIndex() = default;
+
+    void Register(Entity& entity);
+    void Unregister(Entity& entity);
+    /**
+     * @brief Recomputes world bounds for entities whose transforms changed this frame.
+     */
+    void OnTransformsChanged(std::span<Entity* const> entities);
+    /**
+     * @brief Recomputes world bounds for one entity (e.g. after its geometry changed).
+     */
+    void Refresh(Entity& entity);
+
+    /**
+     * @brief World bounds last pushed to the tree for an entity (empty if unregistered).
+     */
+    MATH::Aabb WorldBounds(const Entity& entity) const;
+
+    /**
+     * @brief Closest entity whose world bounds the ray hits within max_distance.
+     */
+    std::optional<SpatialRaycastHit> Raycast(const MATH::Ray& ray, float max_distance) const;
+    /**
+     * @brief Every entity hit along the ray, sorted by distance.
+     */
+    void RaycastAll(const MATH::Ray& ray, float max_distance, std::vector<SpatialRaycastHit>& out) const;
+    void OverlapBox(const MATH::Aabb& box, std::vector<Entity*>& out) const;
+    void OverlapSphere(const MATH::Sphere& sphere, std::vector<Entity*>& out) const;
+    /**
+     * @brief Entities whose world bounds intersect the frustum (visibility candidates).
+     */
+    void OverlapFrustum(const MATH::Frustum& frustum, std::vector<Entity*>& out) const;
+    /**
+     * @brief Culls against up to 32 frustums in one tree walk, reporting a view mask per entity.
+     */
+    void OverlapFrustums(std::span<const MATH::Frustum> frustums, std::vector<SpatialViewHit>& out) const;
+    /**
+     * @brief Up to k entities whose world bounds are closest to point, nearest first.
+     */
+    void Nearest(const MATH::Vec3f& point, size_t k, float max_distance, std::vector<Entity*>& out) const;
+
+    /**
+     * @brief Batched closest-hit raycasts; hits[i] answers rays[i].
+     */
+    void RaycastBatch(std::span<const MATH::Ray> rays,
+                      float max_distance,
+                      std::span<std::optional<SpatialRaycastHit>> hits) const;
+    /**
+     * @brief Batched sphere overlaps; results[i] answers spheres[i] (cleared first).
+     */
+    void OverlapSphereBatch(std::span<const MATH::Sphere> spheres,
+                            std::span<std::vector<Entity*>> results) const;
+
+    const DynamicAabbTree& Tree() const;
+    size_t Size() const;
+    /**
+     * @brief Registered entities whose bounds come from a MeshComponent.
+     */
+    size_t MeshCount() const;
+
+private:
+    struct Record
+    {
+        Entity* entity = nullptr;
+        int32_t proxy = DynamicAabbTree::kNullNode;
+        MATH::Aabb world_bounds {};
+        bool has_mesh = false;  // world_bounds came from a MeshComponent
+    };
+
+    DynamicAabbTree tree_;
+    std::vector<Record> records_;
+    std::unordered_map<const Entity*, uint32_t> record_of_;
+    size_t mesh_count_ = 0;
+
+    static MATH::Aabb ComputeWorldBounds(const Entity& entity);
+    static bool HasMeshBounds(const Entity& entity);
+    void UpdateRecord(Record& record);
+};
+}  // namespace ENGINE
+}  // namespace ZKT
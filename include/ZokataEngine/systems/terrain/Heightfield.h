@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Immutable grid of normalized heights in [0, 1], row-major with rows along +Z.
+ *
+ * Shared read-only between the main thread and terrain chunk builders on workers.
+ */
+class Heightfield
+{
+public:
+    Heightfield(uint32_t width, uint32_t depth, std::vector<float> heights);
+
+    /**
+     * @brief Loads a headerless little-endian 16-bit heightmap (the common .r16/.raw export).
+     */
+    static Heightfield LoadRaw16(const std::filesystem::path& path, uint32_t width, uint32_t depth);
+
+    uint32_t Width() const;
+    uint32_t Depth() const;
+
+    /**
+     * @brief Height of a sample; coordinates are clamped to the grid.
+     */
+    float At(int32_t x, int32_t z) const;
+    /**
+     * @brief Bilinearly filtered height at normalized coordinates (u along X, v along Z).
+     */
+    float Sample(float u, float v) const;
+
+private:
+    uint32_t width_ = 0;
+    uint32_t depth_ = 0;
+    std::vector<float> heights_;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
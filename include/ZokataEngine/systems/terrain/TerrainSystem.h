@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ZokataEngine/systems/render/VisibilitySystem.h"
+#include "ZokataEngine/systems/terrain/TerrainTree.h"
+#include "ZokataMath/Vector.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class JobSystem;
+class Scene;
+
+/**
+ * @brief Streams every enabled TerrainComponent of a scene toward the camera.
+ *
+ * Run after the scene update and before visibility; the resulting Draws() are handed to
+ * VisibilitySystem::SetExternalDraws, which culls and batches them with the scene's meshes.
+ */
+class TerrainSystem
+{
+public:
+    explicit TerrainSystem(JobSystem& jobs);
+
+    void Update(Scene& scene, const MATH::Vec3f& camera_position);
+    /**
+     * @brief Drops the draws (e.g. when there is no active camera); resident chunks stay.
+     */
+    void Reset();
+
+    /**
+     * @brief Selected chunks of all terrains in world space, valid until the next Update.
+     */
+    std::span<const ExternalDraw> Draws() const;
+    /**
+     * @brief Summed over all terrains of the last Update.
+     */
+    const TerrainStats& Stats() const;
+
+    /**
+     * @brief ImGui panel with chunk residency, streaming and memory stats.
+     */
+    void DrawDebugGui();
+
+private:
+    JobSystem& jobs_;
+    std::vector<ExternalDraw> draws_;
+    TerrainStats stats_ {};
+    uint32_t terrains_ = 0;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
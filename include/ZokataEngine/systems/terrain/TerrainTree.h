@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "ZokataEngine/systems/mesh/GeometryCache.h"
+#include "ZokataEngine/systems/terrain/Heightfield.h"
+#include "ZokataMath/Bounds.h"
+#include "ZokataMath/Vector.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class JobSystem;
+
+struct TerrainSettings
+{
+    float size = 1024.0F;                   // world extent along X and Z, centered on the entity
+    float height_scale = 100.0F;            // world height of a heightfield value of 1
+    uint32_t chunk_resolution = 33;         // vertices per chunk side, 2^n + 1
+    uint32_t max_depth = 6;                 // quadtree levels below the root chunk
+    float lod_distance = 2.0F;              // split a node closer than its size times this
+    size_t memory_budget = 64ULL << 20;     // bytes of resident chunk geometry
+    uint32_t max_builds_in_flight = 8;
+
+    bool operator==(const TerrainSettings&) const = default;
+};
+
+struct TerrainStats
+{
+    uint32_t resident = 0;  // chunks with geometry
+    uint32_t pending = 0;   // chunks being built on workers
+    uint32_t selected = 0;  // chunks drawn this frame
+    uint32_t evicted = 0;   // chunks dropped this frame to stay within the budget
+    uint64_t triangles = 0;
+    size_t bytes = 0;
+};
+
+/**
+ * @brief One resident quadtree node drawn as a regular renderable.
+ */
+class TerrainChunk final : public Renderable
+{
+public:
+    TerrainChunk(GeometryHandle geometry, const MaterialDescriptor* material, const MATH::Aabb& bounds);
+
+    const MeshGeometry& Geometry() const override;
+    const MaterialDescriptor& Material() const override;
+
+    const GeometryHandle& SharedGeometry() const;
+    void SetGeometry(GeometryHandle geometry);
+    /**
+     * @brief Bounds in terrain space (origin at the terrain center).
+     */
+    const MATH::Aabb& LocalBounds() const;
+
+private:
+    GeometryHandle geometry_;
+    const MaterialDescriptor* material_ = nullptr;
+    MATH::Aabb bounds_ {};
+};
+
+/**
+ * @brief Streaming quadtree of terrain chunks for one heightfield.
+ *
+ * Every node is a chunk_resolution^2 grid covering a quarter of its parent. Each frame the
+ * tree refines toward the camera, but only into children that are already resident, so a
+ * node stays drawn until all four replacements exist. Missing chunks are built on workers,
+ * nearest and coarsest first, and least recently used chunks are evicted to stay within the
+ * memory budget. Ancestors of drawn chunks are never evicted, so zooming out always has
+ * geometry to fall back to.
+ *
+ * Seams: where a neighbour is one level coarser, the chunk uses an index variant that
+ * collapses its odd edge vertices onto the coarse edge, which removes T-junctions. Every
+ * chunk also has skirts as deep as its own simplification error, which hide the gaps left by
+ * larger level differences while children are streaming in.
+ */
+class TerrainTree
+{
+public:
+    using ReleaseCallback = std::function<void(const MeshGeometry&)>;
+
+    TerrainTree() = default;
+    ~TerrainTree();
+
+    TerrainTree(const TerrainTree&) = delete;
+    TerrainTree& operator=(const TerrainTree&) = delete;
+
+    /**
+     * @brief Streams and selects chunks for a camera position given in terrain space.
+     */
+    void Update(
+        const std::shared_ptr<const Heightfield>& heightfield,
+        const TerrainSettings& settings,
+        const MaterialDescriptor& material,
+        const MATH::Vec3f& camera,
+        JobSystem& jobs);
+    /**
+     * @brief Drops every chunk; the next Update rebuilds from the root.
+     */
+    void Reset();
+
+    /**
+     * @brief Chunks selected by the last Update.
+     */
+    const std::vector<const TerrainChunk*>& Selected() const;
+    const TerrainStats& Stats() const;
+
+    /**
+     * @brief Called with geometry about to be destroyed, so renderers that cache uploads by
+     *        geometry address (e.g. GeometryHeap) can release them first.
+     */
+    void SetReleaseCallback(ReleaseCallback callback);
+
+    /**
+     * @brief Index lists for the 16 stitch masks (bit 0: -X, 1: +X, 2: -Z, 3: +Z neighbour
+     *        coarser) of a resolution x resolution chunk with skirts.
+     */
+    using StitchVariants = std::array<std::vector<uint32_t>, 16>;
+    static StitchVariants BuildStitchVariants(uint32_t resolution);
+
+private:
+    struct Node
+    {
+        std::unique_ptr<TerrainChunk> chunk;
+        std::future<std::shared_ptr<MeshGeometry>> build;
+        uint64_t last_used = 0;
+        uint8_t stitch_mask = 0;
+        bool pending = false;
+    };
+
+    struct BuildRequest
+    {
+        uint64_t key = 0;
+        uint32_t level = 0;
+        float distance = 0.0F;
+    };
+
+    std::shared_ptr<const Heightfield> heightfield_;
+    TerrainSettings settings_ {};
+    std::shared_ptr<const StitchVariants> variants_;
+    const MaterialDescriptor* material_ = nullptr;
+    std::unordered_map<uint64_t, Node> nodes_;
+    std::vector<uint64_t> selected_keys_;
+    std::vector<const TerrainChunk*> selected_;
+    std::vector<BuildRequest> requests_;
+    ReleaseCallback release_;
+    TerrainStats stats_ {};
+    size_t chunk_bytes_ = 0;
+    uint64_t frame_ = 0;
+
+    void CollectFinishedBuilds();
+    void Select(uint32_t level, uint32_t x, uint32_t z, const MATH::Vec3f& camera);
+    bool IsResident(uint64_t key) const;
+    void RequestBuild(uint32_t level, uint32_t x, uint32_t z, const MATH::Vec3f& camera);
+    void SubmitRequests(JobSystem& jobs);
+    void ApplyStitching();
+    void Evict();
+    void Release(Node& node);
+    MATH::Aabb NodeBounds(uint32_t level, uint32_t x, uint32_t z) const;
+    std::shared_ptr<MeshGeometry> BuildNow(uint32_t level, uint32_t x, uint32_t z) const;
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ZokataRenderer/graphics/renderer/TextureFormat.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class JobSystem;
+
+/**
+ * @brief Block encoders; each reads one 4x4 block as 64 bytes of row-major RGBA8.
+ *
+ * BC1 and BC7 fit endpoints along the block's principal axis and refine them by least
+ * squares for the chosen indices. BC7 uses mode 6: one subset with RGBA endpoints and 4-bit
+ * indices. Palette searches run on four texels at a time with SSE2 where available.
+ */
+void EncodeBc1Block(const uint8_t* rgba, uint8_t* out);                    // 8 bytes
+void EncodeBc4Block(const uint8_t* rgba, uint32_t channel, uint8_t* out);  // 8 bytes, one channel
+void EncodeBc3Block(const uint8_t* rgba, uint8_t* out);                    // 16 bytes
+void EncodeBc5Block(const uint8_t* rgba, uint8_t* out);                    // 16 bytes, red and green
+void EncodeBc7Block(const uint8_t* rgba, uint8_t* out);                    // 16 bytes
+
+/**
+ * @brief Encodes a row-major RGBA8 image, rows of blocks in parallel on jobs. Edge blocks
+ *        repeat the last column and row. RGBA8 is returned as is.
+ */
+std::vector<uint8_t> CompressImage(
+    std::span<const uint8_t> rgba, uint32_t width, uint32_t height, TextureFormat format, JobSystem& jobs);
+}  // namespace ENGINE
+}  // namespace ZKT
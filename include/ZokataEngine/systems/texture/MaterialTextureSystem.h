@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "ZokataEngine/systems/asset/AssetManager.h"
+#include "ZokataRenderer/graphics/renderer/DrawList.h"
+
+namespace ZKT
+{
+class IRenderer;
+class TextureStreamer;
+class VirtualTextureAtlas;
+
+namespace ENGINE
+{
+class JobSystem;
+class VirtualTextureCache;
+struct TextureAsset;
+
+struct MaterialTextureStats
+{
+    uint32_t textures = 0;          // distinct references drawn so far
+    uint32_t loading = 0;           // asset still loading
+    uint32_t streamed = 0;          // handed to the streamer
+    uint32_t virtual_textures = 0;  // albedo paged through the renderer's atlas instead
+    uint32_t failed = 0;
+};
+
+/**
+ * @brief Hands the TextureAssets that drawn materials name to the renderer's TextureStreamer
+ *        or virtual texture atlas.
+ *
+ * Run after visibility: every texture a batch's material names is requested from the
+ * AssetManager on first sight (SceneLoader usually requested it already, so this is a cache
+ * hit) and created in the streamer once ready, so only textures something draws are streamed.
+ * When the renderer has a virtual texture atlas, albedo textures in the atlas' format with a
+ * full mip chain go to a VirtualTextureCache instead, and the renderer is told which virtual
+ * texture each drawn material key samples; the cache is pumped from every Update. A
+ * hot-reloaded asset replaces its texture. Entries stay until SetRenderer changes the renderer.
+ */
+class MaterialTextureSystem
+{
+public:
+    MaterialTextureSystem(AssetManager& assets, JobSystem& jobs);
+    ~MaterialTextureSystem();
+
+    MaterialTextureSystem(const MaterialTextureSystem&) = delete;
+    MaterialTextureSystem& operator=(const MaterialTextureSystem&) = delete;
+
+    /**
+     * @brief Renderer whose streamer and atlas textures are created in; null (e.g. before the
+     *        renderer exists or after it is gone) forgets every texture without releasing it.
+     */
+    void SetRenderer(IRenderer* renderer);
+    void Update(const DrawList& draws);
+
+    /**
+     * @brief Streamer texture of a material's texture reference, or
+     *        TextureStreamer::kInvalidTexture until it was created.
+     */
+    uint32_t Find(const std::string& reference) const;
+    const MaterialTextureStats& Stats() const;
+    void DrawDebugGui();
+
+private:
+    struct Entry
+    {
+        AssetHandle<TextureAsset> asset;
+        uint32_t texture = UINT32_MAX;          // TextureStreamer::kInvalidTexture
+        uint32_t virtual_texture = UINT32_MAX;  // VirtualPageTable::kInvalidTexture
+        uint32_t version = 0;                   // asset version the texture was created from
+        bool albedo = false;                    // some drawn material samples it as albedo
+        bool failed = false;
+    };
+
+    AssetManager& assets_;
+    JobSystem& jobs_;
+    IRenderer* renderer_ = nullptr;
+    TextureStreamer* streamer_ = nullptr;
+    VirtualTextureAtlas* atlas_ = nullptr;
+    std::unique_ptr<VirtualTextureCache> cache_;  // while the renderer has an atlas
+    std::unordered_map<std::string, Entry> entries_;
+    std::unordered_map<uint64_t, uint32_t> material_virtual_textures_;  // as told to the renderer
+    MaterialTextureStats stats_ {};
+
+    Entry& Request(const std::string& reference);
+    /**
+     * @brief True if the entry's asset should be paged through the atlas rather than streamed.
+     */
+    bool UsesVirtualTexture(const Entry& entry, const TextureAsset& asset) const;
+    void Refresh(const std::string& reference, Entry& entry);
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+#include "ZokataEngine/systems/asset/AssetManager.h"
+#include "ZokataEngine/systems/asset/MappedFile.h"
+#include "ZokataRenderer/graphics/renderer/Ktx2.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief A cooked KTX2 texture, mapped rather than read: texture's levels point into file, so
+ *        they go to TextureStreamer::Create with this asset as the owner and reach the upload
+ *        ring without a copy.
+ */
+struct TextureAsset
+{
+    MappedFile file;
+    Ktx2Texture texture;
+};
+
+/**
+ * @brief Maps and validates the .ktx2 file a reference names; throws std::runtime_error.
+ */
+std::shared_ptr<const TextureAsset> LoadTextureAsset(const std::string& reference);
+/**
+ * @brief Mapped pages are reclaimable, so only the level data counts, against the GPU budget.
+ */
+AssetSize MeasureTexture(const TextureAsset& asset);
+}  // namespace ENGINE
+}  // namespace ZKT
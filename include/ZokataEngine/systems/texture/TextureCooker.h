@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+#include "ZokataRenderer/graphics/renderer/TextureFormat.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class JobSystem;
+
+/**
+ * @brief How a source image becomes a cooked texture.
+ */
+struct TextureCookSettings
+{
+    TextureFormat format = TextureFormat::BC7;
+    bool srgb = true;         // color data: filtered in linear light, stored as sRGB
+    bool normal_map = false;  // xyz stored as 0-1; every level is renormalized
+    bool mipmaps = true;
+    bool wrap = true;  // the filter wraps around the edges, for tiling textures
+};
+
+/**
+ * @brief Settings for a material slot: sRGB BC7 for albedo and emissive, BC5 for normal maps
+ *        and linear BC7 for the rest.
+ */
+TextureCookSettings DefaultCookSettings(TextureSlot slot);
+
+struct TextureCookStats
+{
+    uint32_t levels = 0;
+    size_t cooked_bytes = 0;
+    float mip_ms = 0.0F;
+    float compress_ms = 0.0F;
+};
+
+/**
+ * @brief Builds the mip chain of an RGBA8 image and block-compresses it into a KTX2 file.
+ *
+ * Each level is downsampled from the previous one in float with a Kaiser-windowed sinc, in
+ * linear light for sRGB data and with alpha-weighted color, so transparent texels do not
+ * bleed into their neighbours. Filtering and compression both run on the job system.
+ */
+class TextureCooker
+{
+public:
+    explicit TextureCooker(JobSystem& jobs);
+
+    /**
+     * @brief RGBA8 levels (level 0 first) as they are handed to the block encoder.
+     */
+    std::vector<std::vector<uint8_t>> BuildMips(
+        std::span<const uint8_t> rgba, uint32_t width, uint32_t height, const TextureCookSettings& settings);
+    /**
+     * @brief KTX2 file for a row-major RGBA8 image; throws std::runtime_error when the data does
+     *        not match the size.
+     */
+    std::vector<uint8_t> Cook(
+        std::span<const uint8_t> rgba, uint32_t width, uint32_t height, const TextureCookSettings& settings);
+
+    const TextureCookStats& Stats() const;
+
+private:
+    JobSystem& jobs_;
+    TextureCookStats stats_ {};
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "ZokataEngine/systems/texture/TextureAsset.h"
+#include "ZokataRenderer/graphics/renderer/VirtualTextureAtlas.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+class JobSystem;
+
+struct VirtualTextureCacheStats
+{
+    uint32_t textures = 0;
+    uint32_t resident = 0;   // pages mapped in the atlas
+    uint32_t loading = 0;    // pages being cut on workers or waiting for a slot
+    uint32_t uploading = 0;  // pages queued on the uploader
+    uint32_t requested = 0;  // distinct pages in the last feedback
+    uint32_t evicted = 0;    // pages unmapped by the last Update
+    uint32_t failed = 0;     // pages whose load threw; never requested again
+};
+
+/**
+ * @brief Streams the pages virtual texture feedback asks for into a VirtualTextureAtlas.
+ *
+ * Each Update reads the atlas' feedback, marks every requested page and its ancestors as used
+ * this frame and queues the missing ones, coarsest first, so a page always has a resident
+ * ancestor to fall back to while it streams. Pages are cut out of the mapped KTX2 files on
+ * workers (at most max_loads_in_flight at a time), uploaded into atlas slots and mapped once
+ * their upload completes. Resident pages are kept in LRU order; the least recently used ones
+ * that were not requested this frame are evicted to keep enough slots free for the loads in
+ * flight. Each texture's single-page tail level is loaded as soon as the texture is added and
+ * is never evicted.
+ *
+ *   AddTexture -> [atlas.BeginFrame -> Update] (each frame) -> RemoveTexture
+ */
+class VirtualTextureCache
+{
+public:
+    static constexpr uint32_t kDefaultLoadsInFlight = 32;
+
+    VirtualTextureCache(VirtualTextureAtlas& atlas, JobSystem& jobs, uint32_t max_loads_in_flight = kDefaultLoadsInFlight);
+
+    VirtualTextureCache(const VirtualTextureCache&) = delete;
+    VirtualTextureCache& operator=(const VirtualTextureCache&) = delete;
+
+    /**
+     * @brief Registers a texture in the atlas' page table and returns its virtual texture id.
+     *        The asset must be in the atlas' format with a full mip chain; throws otherwise.
+     *        wrap selects how page borders are filled at the texture's edges.
+     */
+    uint32_t AddTexture(std::shared_ptr<const TextureAsset> asset, bool wrap = true);
+    /**
+     * @brief Frees the texture's pages and table entries.
+     */
+    void RemoveTexture(uint32_t texture);
+
+    /**
+     * @brief Consumes the atlas' feedback and advances loads, uploads and eviction; call after
+     *        the atlas' BeginFrame.
+     */
+    void Update();
+
+    const VirtualTextureCacheStats& Stats() const;
+    void DrawDebugGui() const;
+
+private:
+    enum class PageState : uint8_t
+    {
+        Loading,    // on a worker
+        Loaded,     // bytes ready, waiting for a free slot
+        Uploading,
+        Resident,
+        Failed
+    };
+
+    struct Page
+    {
+        VirtualPage page {};
+        PageState state = PageState::Loading;
+        std::future<std::shared_ptr<std::vector<uint8_t>>> load;
+        std::shared_ptr<std::vector<uint8_t>> data;
+        uint32_t slot = VirtualTextureAtlas::kInvalidSlot;
+        uint64_t ticket = 0;
+        uint64_t last_used = 0;
+        bool pinned = false;                // tail pages, never evicted
+        std::list<uint32_t>::iterator lru;  // valid while resident and not pinned
+    };
+
+    struct Texture
+    {
+        std::shared_ptr<const TextureAsset> asset;
+        bool wrap = true;
+    };
+
+    VirtualTextureAtlas& atlas_;
+    JobSystem& jobs_;
+    uint32_t max_loads_in_flight_ = kDefaultLoadsInFlight;
+    std::vector<Texture> textures_;                // indexed by virtual texture id
+    std::unordered_map<uint32_t, Page> pages_;     // by PackVirtualPage
+    std::list<uint32_t> lru_;                      // resident, unpinned pages; most recent first
+    std::vector<uint32_t> loading_;                // keys of Loading and Loaded pages
+    std::vector<uint32_t> uploading_;
+    uint32_t resident_ = 0;
+    std::vector<uint32_t> requests_;
+    std::vector<VirtualPage> missing_;
+    uint64_t frame_ = 0;
+    VirtualTextureCacheStats stats_ {};
+
+    void CollectFeedback();
+    void StartLoad(const VirtualPage& page, bool pinned);
+    void CollectFinishedLoads();
+    void CollectFinishedUploads();
+    /**
+     * @brief Unmaps the least recently used page unless it was requested this frame.
+     */
+    bool EvictOne();
+};
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ZokataMath/Matrix.h"
+#include "ZokataMath/Vector.h"
+
+namespace ZKT
+{
+namespace MATH
+{
+/**
+ * @brief Ray with an origin and a (not necessarily normalized) direction.
+ */
+struct Ray
+{
+    Vec3f origin {0.0F, 0.0F, 0.0F};
+    Vec3f direction {0.0F, 0.0F, 1.0F};
+
+    /**
+     * @brief Point along the ray at parameter t.
+     */
+    Vec3f At(float t) const { return origin + direction * t; }
+};
+
+/**
+ * @brief Bounding sphere (center + radius).
+ */
+struct Sphere
+{
+    Vec3f center {0.0F, 0.0F, 0.0F};
+    float radius = 0.0F;
+};
+
+/**
+ * @brief Axis-aligned bounding box stored as min/max corners.
+ *
+ * A default-constructed box is empty (inverted) so it can be grown with Expand().
+ */
+struct Aabb
+{
+    Vec3f min {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    Vec3f max {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+    constexpr Aabb() = default;
+    constexpr Aabb(const Vec3f& min_, const Vec3f& max_) : min(min_), max(max_) {}
+
+    /**
+     * @brief Builds a box from a center and half extents.
+     */
+    static Aabb FromCenterExtents(const Vec3f& center, const Vec3f& extents)
+    {
+        return {center - extents, center + extents};
+    }
+
+    bool Valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    Vec3f Center() const { return (min + max) * 0.5F; }
+    Vec3f Extents() const { return (max - min) * 0.5F; }
+
+    /**
+     * @brief Surface area, used as the insertion cost heuristic by BVHs.
+     */
+    float SurfaceArea() const
+    {
+        const Vec3f d = max - min;
+        return 2.0F * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    /**
+     * @brief Grows the box to include a point.
+     */
+    void Expand(const Vec3f& p)
+    {
+        min = {std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z)};
+        max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+    }
+
+    /**
+     * @brief Returns a copy grown by margin on every side.
+     */
+    Aabb Inflated(float margin) const
+    {
+        const Vec3f m {margin, margin, margin};
+        return {min - m, max + m};
+    }
+
+    static Aabb Union(const Aabb& a, const Aabb& b)
+    {
+        return {
+            {std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+            {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)},
+        };
+    }
+
+    bool Contains(const Aabb& other) const
+    {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z
+            && other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+    }
+
+    bool Contains(const Vec3f& p) const
+    {
+        return min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y && min.z <= p.z && p.z <= max.z;
+    }
+
+    bool Overlaps(const Aabb& other) const
+    {
+        return min.x <= other.max.x && other.min.x <= max.x
+            && min.y <= other.max.y && other.min.y <= max.y
+            && min.z <= other.max.z && other.min.z <= max.z;
+    }
+
+    /**
+     * @brief Squared distance from a point to the box (0 when inside).
+     */
+    float DistanceSquared(const Vec3f& p) const
+    {
+        const float dx = std::max({min.x - p.x, 0.0F, p.x - max.x});
+        const float dy = std::max({min.y - p.y, 0.0F, p.y - max.y});
+        const float dz = std::max({min.z - p.z, 0.0F, p.z - max.z});
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    bool Overlaps(const Sphere& sphere) const
+    {
+        return DistanceSquared(sphere.center) <= sphere.radius * sphere.radius;
+    }
+
+    /**
+     * @brief Slab test against a ray given its precomputed reciprocal direction.
+     * @param t_enter Receives the entry parameter (clamped to 0) on hit.
+     * @return True if the ray enters the box within [0, t_max].
+     */
+    bool IntersectRay(const Vec3f& origin, const Vec3f& inv_direction, float t_max, float& t_enter) const
+    {
+        const float tx1 = (min.x - origin.x) * inv_direction.x;
+        const float tx2 = (max.x - origin.x) * inv_direction.x;
+        const float ty1 = (min.y - origin.y) * inv_direction.y;
+        const float ty2 = (max.y - origin.y) * inv_direction.y;
+        const float tz1 = (min.z - origin.z) * inv_direction.z;
+        const float tz2 = (max.z - origin.z) * inv_direction.z;
+
+        const float t_near = std::max({std::min(tx1, tx2), std::min(ty1, ty2), std::min(tz1, tz2), 0.0F});
+        const float t_far = std::min({std::max(tx1, tx2), std::max(ty1, ty2), std::max(tz1, tz2), t_max});
+        t_enter = t_near;
+        return t_near <= t_far;
+    }
+
+    /**
+     * @brief Conservative world-space box of this box transformed by an affine matrix.
+     */
+    Aabb Transformed(const Mat4f& m) const
+    {
+        // Arvo's method: accumulate each matrix column scaled by the box extremes.
+        const glm::mat4& g = m.ToGlm();
+        Aabb out {{g[3][0], g[3][1], g[3][2]}, {g[3][0], g[3][1], g[3][2]}};
+        for (int col = 0; col < 3; ++col)
+        {
+            const float lo = (&min.x)[col];
+            const float hi = (&max.x)[col];
+            for (int row = 0; row < 3; ++row)
+            {
+                const float a = g[col][row] * lo;
+                const float b = g[col][row] * hi;
+                (&out.min.x)[row] += std::min(a, b);
+                (&out.max.x)[row] += std::max(a, b);
+            }
+        }
+        return out;
+    }
+};
+
+/**
+ * @brief Plane in the form dot(normal, p) + d = 0, with the normal pointing inside.
+ */
+struct Plane
+{
+    Vec3f normal {0.0F, 1.0F, 0.0F};
+    float d = 0.0F;
+
+    float SignedDistance(const Vec3f& p) const { return Vec3f::Dot(normal, p) + d; }
+};
+
+enum class Containment
+{
+    Outside,
+    Intersects,
+    Inside
+};
+
+/**
+ * @brief Six inward-facing planes extracted from a view-projection matrix.
+ */
+struct Frustum
+{
+    enum PlaneIndex
+    {
+        kLeft = 0,
+        kRight,
+        kBottom,
+        kTop,
+        kNear,
+        kFar,
+        kPlaneCount
+    };
+
+    Plane planes[kPlaneCount] {};
+
+    /**
+     * @brief Gribb/Hartmann plane extraction (planes are normalized).
+     */
+    static Frustum FromViewProjection(const Mat4f& view_projection)
+    {
+        const glm::mat4& m = view_projection.ToGlm();
+        const auto row = [&m](int r) { return Vec4f{m[0][r], m[1][r], m[2][r], m[3][r]}; };
+        const Vec4f r0 = row(0);
+        const Vec4f r1 = row(1);
+        const Vec4f r2 = row(2);
+        const Vec4f r3 = row(3);
+
+        const Vec4f raw[kPlaneCount] = {r3 + r0, r3 - r0, r3 + r1, r3 - r1, r3 + r2, r3 - r2};
+        Frustum frustum {};
+        for (int i = 0; i < kPlaneCount; ++i)
+        {
+            const Vec3f n {raw[i].x, raw[i].y, raw[i].z};
+            const float len = n.Length();
+            const float inv = len > 0.0F ? 1.0F / len : 0.0F;
+            frustum.planes[i] = Plane{n * inv, raw[i].w * inv};
+        }
+        return frustum;
+    }
+
+    /**
+     * @brief Conservative box test: false only when the box is fully outside one plane.
+     */
+    bool Intersects(const Aabb& box) const
+    {
+        const Vec3f center = box.Center();
+        const Vec3f extents = box.Extents();
+        for (const Plane& plane : planes)
+        {
+            const float radius = extents.x * std::abs(plane.normal.x)
+                + extents.y * std::abs(plane.normal.y)
+                + extents.z * std::abs(plane.normal.z);
+            if (plane.SignedDistance(center) < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Like Intersects, but also reports boxes that are fully inside every plane.
+     */
+    Containment Classify(const Aabb& box) const
+    {
+        const Vec3f center = box.Center();
+        const Vec3f extents = box.Extents();
+        Containment result = Containment::Inside;
+        for (const Plane& plane : planes)
+        {
+            const float radius = extents.x * std::abs(plane.normal.x)
+                + extents.y * std::abs(plane.normal.y)
+                + extents.z * std::abs(plane.normal.z);
+            const float distance = plane.SignedDistance(center);
+            if (distance < -radius)
+            {
+                return Containment::Outside;
+            }
+            if (distance < radius)
+            {
+                result = Containment::Intersects;
+            }
+        }
+        return result;
+    }
+
+    bool Intersects(const Sphere& sphere) const
+    {
+        for (const Plane& plane : planes)
+        {
+            if (plane.SignedDistance(sphere.center) < -sphere.radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Reciprocal of a ray direction with zero components mapped to +/-infinity.
+ */
+inline Vec3f SafeReciprocal(const Vec3f& d)
+{
+    const auto inv = [](float v) {
+        return v != 0.0F ? 1.0F / v : std::copysign(std::numeric_limits<float>::infinity(), v);
+    };
+    return {inv(d.x), inv(d.y), inv(d.z)};
+}
+}  // namespace MATH
+}  // namespace ZKT
@@ -8,11 +8,12 @@
 #include "ZokataRenderer/graphics/Window.h"
 #include "ZokataRenderer/graphics/renderer/DeferredRenderer.h"
 #include "ZokataRenderer/graphics/renderer/Renderer.h"
+#include "ZokataRenderer/graphics/renderer/UploadService.h"
 
 namespace ZKT
 {
 /**
- * @brief Entry point for the render layer: window, Vulkan context, and ImGui.
+ * @brief Entry point for the render layer: window, Vulkan context, uploads and ImGui.
  */
 class Application
 {
@@ -25,20 +26,47 @@ public:
 
     /**
      * @brief Main loop: handles window events, GUI, and renderer frames.
+     *
+     * Per frame: BeginFrame, uploads, renderer BeginFrame, update callback, renderer
+     * RecordFrame, then inside the swapchain pass renderer RecordPass, GUI, EndFrame.
      */
     void Run();
     /**
      * @brief Provides an extra ImGui callback executed each frame.
      */
     void SetGuiCallback(std::function<void()> callback);
+    /**
+     * @brief Provides a per-frame simulation callback executed before the GUI.
+     */
+    void SetUpdateCallback(std::function<void(float)> callback);
+    /**
+     * @brief Points renderers at the draw list produced by the engine each frame.
+     */
+    void SetDrawList(const DrawList* draw_list);
+    /**
+     * @brief Current swapchain extent in pixels.
+     */
+    VkExtent2D FramebufferExtent() const;
+    /**
+     * @brief The one streaming uploader every GPU resource shares; the frame loop runs its
+     *        BeginFrame before the update callback and the renderer record the frame.
+     */
+    UploadService& Uploads();
+    /**
+     * @brief The active renderer, for engine systems that feed its textures.
+     */
+    IRenderer& Renderer();
 
 private:
     GlfwWindow window_;
     VulkanContext context_;
+    UploadService uploads_;
     ImGuiLayer imgui_layer_;
     std::unique_ptr<IRenderer> renderer_;
     uint64_t frame_index_ = 0;
     std::function<void()> extra_gui_;
+    std::function<void(float)> update_;
+    const DrawList* draw_list_ = nullptr;
 
     void SetupImGui();
     void RecreateSwapchainAndUi();
@@ -8,6 +8,7 @@
 
 #include "ZokataRenderer/graphics/vk/Device.h"
 #include "ZokataRenderer/graphics/vk/FrameSync.h"
+#include "ZokataRenderer/graphics/vk/Image.h"
 #include "ZokataRenderer/graphics/vk/Instance.h"
 #include "ZokataRenderer/graphics/vk/Swapchain.h"
 
@@ -19,6 +20,7 @@ struct FrameContext
 {
     VkCommandBuffer command_buffer = VK_NULL_HANDLE;
     uint32_t image_index = 0;
+    uint32_t frame_slot = 0;  // index of the frame-in-flight, for per-frame resources
     VkExtent2D extent {};
 };
 
@@ -31,6 +33,9 @@ enum class FrameStatus
 class VulkanContext
 {
 public:
+    static constexpr uint32_t kMaxFramesInFlight = 2;
+    static constexpr VkFormat kDepthFormat = VK_FORMAT_D32_SFLOAT;
+
     /**
      * @brief Manages swapchain, render pass, command buffers, and per-frame sync.
      */
@@ -40,9 +45,18 @@ public:
     VulkanContext(const VulkanContext&) = delete;
     VulkanContext& operator=(const VulkanContext&) = delete;
 
+    /**
+     * @brief Waits for the frame slot, acquires an image and starts recording outside any render
+     *        pass, so uploads and compute work can be recorded before BeginRenderPass.
+     */
     FrameStatus BeginFrame(FrameContext& frame);
     /**
-     * @brief Ends recording and presents the frame.
+     * @brief Begins the swapchain render pass (color, plus a kDepthFormat depth attachment
+     *        cleared to 1); EndFrame ends it.
+     */
+    void BeginRenderPass(const FrameContext& frame);
+    /**
+     * @brief Ends the render pass and recording, then presents the frame.
      */
     FrameStatus EndFrame(const FrameContext& frame);
 
@@ -60,13 +74,16 @@ public:
      */
     void SubmitImmediate(const std::function<void(VkCommandBuffer)>& record) const;
 
+    const Device& GetDevice() const;
     VkInstance InstanceHandle() const;
     VkPhysicalDevice PhysicalDevice() const;
     VkDevice DeviceHandle() const;
     VkQueue GraphicsQueue() const;
     VkQueue PresentQueue() const;
+    VkQueue TransferQueue() const;
     uint32_t GraphicsQueueFamily() const;
     uint32_t PresentQueueFamily() const;
+    uint32_t TransferQueueFamily() const;
     VkRenderPass RenderPass() const;
     uint32_t SwapchainImageCount() const;
     uint32_t MinImageCount() const;
@@ -84,6 +101,8 @@ private:
 
     VkRenderPass render_pass_ = VK_NULL_HANDLE;
     std::vector<VkFramebuffer> framebuffers_;
+    Image depth_image_;
+    VkImageView depth_view_ = VK_NULL_HANDLE;
 
     VkCommandPool command_pool_ = VK_NULL_HANDLE;
     std::vector<VkCommandBuffer> command_buffers_;
@@ -95,6 +114,7 @@ private:
     void CreateSurface();
     void CreateCommandPool();
     void CreateRenderPass();
+    void CreateDepthBuffer();
     void CreateFramebuffers();
     void AllocateCommandBuffers();
     void CleanupSwapchain();
@@ -1,25 +1,154 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataRenderer/graphics/renderer/GeometryHeap.h"
+#include "ZokataRenderer/graphics/renderer/GpuCulling.h"
+#include "ZokataRenderer/graphics/renderer/GpuSkinning.h"
+#include "ZokataRenderer/graphics/renderer/InstanceBuffer.h"
+#include "ZokataRenderer/graphics/renderer/MeshletCulling.h"
 #include "ZokataRenderer/graphics/renderer/Renderer.h"
+#include "ZokataRenderer/graphics/renderer/TextureStreamer.h"
+#include "ZokataRenderer/graphics/renderer/VirtualTextureAtlas.h"
+#include "ZokataRenderer/graphics/vk/Buffer.h"
+#include "ZokataRenderer/graphics/VulkanContext.h"
 
 namespace ZKT
 {
+class UploadService;
+
 /**
- * @brief Placeholder deferred renderer that provides basic UI and state.
+ * @brief Deferred renderer; for now a single forward opaque pass over the engine's DrawList.
+ *
+ * Batch geometry is streamed into a GeometryHeap of Packed20 vertices on first use and each
+ * batch's transforms go to an InstanceBuffer; a parallel per-instance mesh id selects the
+ * VertexQuantization the vertex shader expands positions with. RecordFrame writes the frame's indirect commands and instances;
+ * RecordPass draws them into the swapchain pass with one multi-draw call, lit by a fixed
+ * directional light. G-Buffer targets and lighting passes are still to come.
+ *
+ * Full-detail batches whose renderable has meshlets skip the heap's commands and are drawn per
+ * cluster instead: MeshletCulling tests every (instance, meshlet) pair against the frustum
+ * and normal cone and draws the survivors with the same pipeline. The GpuInstance records it
+ * reads live in a device-local buffer that only receives the records changed since the last
+ * frame. GpuCulling's two-phase occlusion cull is not run: it needs a stored, sampled depth
+ * target to build its pyramid from, and this pass still draws into the swapchain's.
+ *
+ * Skinned instances registered through Skinning() are skinned at the start of every
+ * RecordFrame, before any pass reads GpuSkinning::OutputBuffer(). Material textures are
+ * created in Textures() by the engine and streamed from the same RecordFrame.
+ *
+ * On devices with fragment stores the pass samples albedo from VirtualTextures(): the engine
+ * pages textures into the atlas and maps material keys to their virtual texture, and each
+ * instance carries its material's id to geometry.frag.vt.spv, which also writes the page
+ * feedback. The feedback is read back at the start of the next frame, outside its render
+ * pass, so the cache sees a frame's requests two frames later.
  */
 class DeferredRenderer final : public IRenderer
 {
 public:
-    DeferredRenderer() = default;
+    DeferredRenderer(const VulkanContext& context, UploadService& uploader);
+    ~DeferredRenderer() override;
+
+    DeferredRenderer(const DeferredRenderer&) = delete;
+    DeferredRenderer& operator=(const DeferredRenderer&) = delete;
 
     const char* Name() const override;
     RendererType Type() const override;
     void RenderGui(const FrameDescriptor& frame) override;
+    void BeginFrame(const FrameDescriptor& frame) override;
+    void RecordFrame(const FrameDescriptor& frame) override;
+    void RecordPass(const FrameDescriptor& frame) override;
     void OnSwapchainUpdated(VkExtent2D extent) override;
+    TextureStreamer* Textures() override;
+    VirtualTextureAtlas* VirtualTextures() override;
+    void SetMaterialVirtualTexture(uint64_t material_key, uint32_t texture) override;
+
+    /**
+     * @brief Skinned meshes and instances; their joint matrices are uploaded and skinned each frame.
+     */
+    GpuSkinning& Skinning();
 
 private:
+    struct MeshletRange
+    {
+        uint32_t first = 0;  // into meshlet_table_
+        uint32_t count = 0;
+    };
+
+    const VulkanContext& context_;
+    VkDevice device_ = VK_NULL_HANDLE;
+    GeometryHeap heap_;
+    InstanceBuffer instances_;
+    // GpuInstance by DrawList index, read by the meshlet cull and draws; device local, written
+    // through the slot's staging buffer. uploaded_instances_ mirrors what it holds.
+    Buffer cluster_instances_;
+    std::array<Buffer, VulkanContext::kMaxFramesInFlight> cluster_staging_;
+    std::vector<GpuInstance> uploaded_instances_;
+    MeshletCulling meshlets_;
+    GpuSkinning skinning_;
+    TextureStreamer textures_;
+    std::unique_ptr<VirtualTextureAtlas> virtual_textures_;  // null without fragment stores
+    std::unordered_map<uint64_t, uint32_t> material_virtual_textures_;  // by material key
+    // Without drawIndirectFirstInstance, batches are drawn one vkCmdDrawIndexed at a time.
+    bool indirect_first_instance_ = false;
+
+    VkDescriptorSetLayout set_layout_ = VK_NULL_HANDLE;
+    VkDescriptorPool descriptor_pool_ = VK_NULL_HANDLE;
+    std::array<VkDescriptorSet, VulkanContext::kMaxFramesInFlight> sets_ {};
+    // Per frame slot, host visible: heap mesh id and virtual texture id per instance, and the
+    // heap's quantizations.
+    std::array<Buffer, VulkanContext::kMaxFramesInFlight> instance_meshes_;
+    std::array<Buffer, VulkanContext::kMaxFramesInFlight> instance_textures_;
+    std::array<Buffer, VulkanContext::kMaxFramesInFlight> quantizations_;
+    std::vector<uint32_t> mesh_ids_;
+    std::vector<uint32_t> texture_ids_;
+    VkPipelineLayout pipeline_layout_ = VK_NULL_HANDLE;
+    VkPipeline pipeline_ = VK_NULL_HANDLE;
+
+    std::unordered_map<uint32_t, MeshletRange> meshlet_ranges_;  // by heap mesh id
+    std::vector<GpuMeshlet> meshlet_table_;
+    bool meshlet_table_dirty_ = false;
+    std::vector<DrawBatch> heap_batches_;
+    std::vector<GpuInstance> gpu_instances_;
+    std::vector<GpuCluster> clusters_;
+    bool meshlet_culling_ = true;
+
     VkExtent2D last_extent_ {0, 0};
     bool recreate_gbuffer_ = false;
     int samples_ = 1;
+    bool show_heap_ = false;
+    bool show_meshlets_ = false;
+    bool show_skinning_ = false;
+    bool show_textures_ = false;
+    bool show_virtual_textures_ = false;
+
+    void CreateDescriptors();
+    void CreatePipeline();
+    void WriteDescriptors(uint32_t frame_slot);
+    /**
+     * @brief Writes the slot's instance mesh and virtual texture ids and quantizations; true if
+     *        a buffer was replaced.
+     */
+    bool UploadMeshData(const DrawList& draws, uint32_t frame_slot);
+    /**
+     * @brief Sorts the list's batches into heap_batches_ and, for meshlet batches, clusters_.
+     */
+    void SplitBatches(const DrawList& draws);
+    /**
+     * @brief Copies the span of gpu_instances_ that differs from uploaded_instances_ into
+     *        cluster_instances_; records nothing when no instance changed.
+     */
+    void RecordClusterInstanceUploads(VkCommandBuffer cmd, uint32_t frame_slot);
+    /**
+     * @brief Meshlets of a batch in meshlet_table_, adding them once its mesh is resident;
+     *        nullptr when the batch is drawn whole.
+     */
+    const MeshletRange* FindMeshlets(const DrawBatch& batch);
 };
 }  // namespace ZKT
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ZokataMath/Matrix.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+/**
+ * @brief One visible renderable with the world transform it should be drawn with.
+ */
+struct DrawItem
+{
+    const Renderable* renderable = nullptr;
+    MATH::Mat4f model {};
+    uint32_t lod = 0;  // detail level to draw, see Renderable::LodGeometry
+};
+
+/**
+ * @brief Visible draws sharing one geometry and material, drawn as a single instanced call.
+ *
+ * The batch's transforms are instances[first_instance, first_instance + instance_count);
+ * renderers pass first_instance as the draw's firstInstance so the vertex shader can index
+ * the per-frame instance buffer with gl_InstanceIndex.
+ */
+struct DrawBatch
+{
+    const Renderable* renderable = nullptr;  // first draw of the batch; source of geometry and material
+    const MeshGeometry* geometry = nullptr;  // renderable->LodGeometry(lod)
+    uint32_t lod = 0;
+    uint32_t first_instance = 0;
+    uint32_t instance_count = 0;
+};
+
+/**
+ * @brief Per-frame list of visible draws plus culling statistics for debug UI.
+ *
+ * Written by the engine's visibility/extraction step and consumed by renderers each frame.
+ * items keeps one entry per visible renderable; batches and instances group the same draws by
+ * (geometry, material) for instanced submission.
+ */
+struct DrawList
+{
+    std::vector<DrawItem> items;
+    std::vector<DrawBatch> batches;
+    std::vector<MATH::Mat4f> instances;  // model matrices, contiguous per batch
+    MATH::Mat4f view_projection {};      // camera the list was culled for (GL clip conventions)
+    MATH::Vec3f camera_position {0.0F, 0.0F, 0.0F};
+
+    uint32_t candidates = 0;        // renderables considered this frame
+    uint32_t frustum_culled = 0;    // rejected by the view frustum
+    uint32_t occlusion_culled = 0;  // rejected by the occlusion buffer
+    uint64_t triangles = 0;         // triangles of the selected detail levels
+
+    void Clear()
+    {
+        items.clear();
+        batches.clear();
+        instances.clear();
+        candidates = 0;
+        frustum_culled = 0;
+        occlusion_culled = 0;
+        triangles = 0;
+    }
+};
+}  // namespace ZKT
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataRenderer/graphics/renderer/DrawList.h"
+#include "ZokataRenderer/graphics/renderer/GpuCulling.h"
+#include "ZokataRenderer/graphics/renderer/PackedMesh.h"
+#include "ZokataRenderer/graphics/renderer/RangeAllocator.h"
+#include "ZokataRenderer/graphics/vk/Buffer.h"
+#include "ZokataRenderer/graphics/VulkanContext.h"
+
+namespace ZKT
+{
+class UploadService;
+
+struct GeometryHeapStats
+{
+    uint32_t meshes = 0;
+    uint32_t vertices_used = 0;
+    uint32_t indices_used = 0;
+    uint32_t vertex_free_blocks = 0;
+    uint32_t index_free_blocks = 0;
+    uint32_t draws = 0;  // indirect commands written by the last WriteDraws
+    uint32_t uploading = 0;  // meshes added but not yet resident
+};
+
+/**
+ * @brief One device-local vertex buffer and one index buffer shared by every mesh.
+ *
+ * Meshes are sub-allocated with RangeAllocator and described by a GpuMeshDraw (first index,
+ * vertex offset) in the mesh table, which GpuCulling and MeshletCulling consume as is. The
+ * whole heap is bound once per pass; DrawList batches are then written to a per-frame
+ * indirect buffer and drawn with a single multi-draw indirect call.
+ *
+ * All meshes share the heap's vertex format and index type. Packed formats quantize per mesh,
+ * so vertex shaders fetch the mesh's VertexQuantization from Quantizations().
+ *
+ * Flush hands meshes to the UploadService, which streams them in over the following frames.
+ * A mesh's table entry stays zero-sized, and WriteDraws skips it, until the upload completes.
+ * UploadService::BeginFrame must run before this heap's BeginFrame so finished uploads are
+ * published the same frame.
+ *
+ *   GetOrAdd / Add -> Flush -> BeginFrame -> WriteDraws -> [pass] Bind -> RecordDraws
+ */
+class GeometryHeap
+{
+public:
+    static constexpr uint32_t kInvalidMesh = UINT32_MAX;
+
+    GeometryHeap(
+        const VulkanContext& context,
+        UploadService& uploader,
+        VertexFormat vertex_format,
+        IndexFormat index_format,
+        uint32_t max_vertices,
+        uint32_t max_indices);
+    ~GeometryHeap();
+
+    GeometryHeap(const GeometryHeap&) = delete;
+    GeometryHeap& operator=(const GeometryHeap&) = delete;
+
+    /**
+     * @brief Allocates ranges for mesh and queues its upload; returns the mesh id.
+     *
+     * Throws when the formats differ from the heap's or the heap is full.
+     */
+    uint32_t Add(const PackedMesh& mesh);
+    /**
+     * @brief Mesh id of geometry, packing and adding it on first use (keyed by address).
+     */
+    uint32_t GetOrAdd(const MeshGeometry& geometry);
+    uint32_t Find(const MeshGeometry& geometry) const;
+    /**
+     * @brief Drops a mesh; its ranges are reused once the frames that may draw it complete.
+     */
+    void Release(uint32_t mesh);
+    void Release(const MeshGeometry& geometry);
+
+    /**
+     * @brief Hands every queued mesh to the uploader.
+     */
+    void Flush();
+    /**
+     * @brief Call once the slot's fence has been waited on; publishes finished uploads and
+     *        recycles ranges released when the slot was last recorded.
+     */
+    void BeginFrame(uint32_t frame_slot);
+    /**
+     * @brief True once the mesh's geometry is on the GPU and its table entry is valid.
+     */
+    bool IsResident(uint32_t mesh) const;
+
+    const GpuMeshDraw& Mesh(uint32_t mesh) const;
+    /**
+     * @brief Mesh table indexed by mesh id (released ids hold zero-sized ranges).
+     */
+    std::span<const GpuMeshDraw> MeshTable() const;
+    std::span<const VertexQuantization> Quantizations() const;
+
+    /**
+     * @brief Builds one indexed indirect command per DrawList batch, adding (and flushing)
+     *        geometry the heap has not seen. Returns the command count.
+     */
+    uint32_t WriteDraws(const DrawList& draws, uint32_t frame_slot);
+    /**
+     * @brief Same, for a subset of a DrawList's batches (their first_instance still index its
+     *        instances).
+     */
+    uint32_t WriteDraws(std::span<const DrawBatch> batches, uint32_t frame_slot);
+    /**
+     * @brief Binds the heap's vertex buffer at binding 0 and its index buffer.
+     */
+    void Bind(VkCommandBuffer cmd) const;
+    /**
+     * @brief Issues the commands written for the slot; caller binds the pipeline and instances.
+     */
+    void RecordDraws(VkCommandBuffer cmd, uint32_t frame_slot) const;
+
+    VkBuffer VertexBuffer() const;
+    VkBuffer IndexBuffer() const;
+    VertexFormat GetVertexFormat() const;
+    VkIndexType IndexType() const;
+
+    const GeometryHeapStats& Stats() const;
+    void DrawDebugGui();
+
+private:
+    struct Allocation
+    {
+        uint32_t vertex_offset = 0;
+        uint32_t vertex_count = 0;
+        uint32_t first_index = 0;
+        uint32_t index_count = 0;
+        const MeshGeometry* source = nullptr;  // key in geometry_ids_, if added by address
+        uint64_t upload_ticket = 0;            // last UploadService ticket writing the ranges
+    };
+
+    struct PendingUpload
+    {
+        uint32_t mesh = 0;
+        std::vector<uint8_t> vertices;
+        std::vector<uint8_t> indices;
+    };
+
+    const VulkanContext& context_;
+    UploadService& uploader_;
+    VkDevice device_ = VK_NULL_HANDLE;
+    VertexFormat vertex_format_ = VertexFormat::Float32;
+    IndexFormat index_format_ = IndexFormat::UInt32;
+    uint32_t vertex_stride_ = 0;
+    uint32_t index_size_ = 0;
+    bool multi_draw_ = false;
+
+    RangeAllocator vertex_ranges_;
+    RangeAllocator index_ranges_;
+    std::vector<Allocation> allocations_;
+    std::vector<GpuMeshDraw> mesh_table_;
+    std::vector<VertexQuantization> quantizations_;
+    std::vector<uint32_t> free_ids_;
+    std::unordered_map<const MeshGeometry*, uint32_t> geometry_ids_;
+    std::vector<PendingUpload> pending_;
+    std::vector<uint32_t> uploading_;  // handed to uploader_, not yet in mesh_table_
+    std::vector<std::vector<uint32_t>> retired_;  // per frame slot
+    uint32_t frame_slot_ = 0;
+
+    Buffer vertex_buffer_;
+    Buffer index_buffer_;
+    std::vector<Buffer> indirect_;
+    std::vector<uint32_t> indirect_capacity_;
+    std::vector<uint32_t> draw_counts_;
+    std::vector<VkDrawIndexedIndirectCommand> commands_;
+    GeometryHeapStats stats_ {};
+
+    void UpdateStats();
+};
+}  // namespace ZKT
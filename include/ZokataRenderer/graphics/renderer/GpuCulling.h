@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataMath/Matrix.h"
+#include "ZokataMath/Vector.h"
+#include "ZokataRenderer/graphics/vk/Buffer.h"
+#include "ZokataRenderer/graphics/VulkanContext.h"
+
+namespace ZKT
+{
+// GPU-side records; layouts mirror the std430 structs in shaders/gpu_cull.comp.
+/**
+ * @brief Per-instance data read by the cull shader and by vertex shaders via gl_InstanceIndex.
+ */
+struct GpuInstance
+{
+    MATH::Mat4f model {};
+    MATH::Vec4f bounds {};  // world-space bounding sphere: xyz center, w radius
+    uint32_t mesh = 0;      // index into the mesh draw table
+    uint32_t pad[3] {};
+};
+static_assert(sizeof(GpuInstance) == 96, "GpuInstance must match the std430 layout");
+
+/**
+ * @brief Index range of one mesh inside the bound vertex/index buffers.
+ */
+struct GpuMeshDraw
+{
+    uint32_t index_count = 0;
+    uint32_t first_index = 0;
+    int32_t vertex_offset = 0;
+    uint32_t pad = 0;
+};
+static_assert(sizeof(GpuMeshDraw) == 16, "GpuMeshDraw must match the std430 layout");
+
+enum class CullPhase : uint32_t
+{
+    Early = 0,  // frustum + last frame's Hi-Z
+    Late = 1    // objects rejected early that pass against the refreshed Hi-Z
+};
+
+struct GpuCullingStats
+{
+    uint32_t instances = 0;
+    uint32_t early_draws = 0;
+    uint32_t late_draws = 0;
+};
+
+/**
+ * @brief GPU-driven two-phase culling that writes indexed indirect draws plus a draw count.
+ *
+ * Instances and mesh ranges live in device-local storage buffers and only dirty ranges are
+ * re-uploaded, so CPU cost per frame is independent of the instance count. Recording order
+ * for a frame, outside of render passes unless noted:
+ *
+ *   RecordUploads -> RecordCull(Early) -> [depth pass] RecordDraws(Early)
+ *   -> RecordDepthPyramid -> RecordCull(Late) -> [depth pass] RecordDraws(Late)
+ *
+ * Draws use vkCmdDrawIndexedIndirectCount when the device supports it; otherwise every
+ * instance owns a command slot (zeroed when culled) and plain multi-draw indirect is used,
+ * which keeps the path working on software drivers such as lavapipe.
+ */
+class GpuCulling
+{
+public:
+    GpuCulling(const VulkanContext& context, uint32_t max_instances, uint32_t max_meshes);
+    ~GpuCulling();
+
+    GpuCulling(const GpuCulling&) = delete;
+    GpuCulling& operator=(const GpuCulling&) = delete;
+
+    /**
+     * @brief Replaces the mesh draw table (uploaded on the next RecordUploads).
+     */
+    void SetMeshes(std::span<const GpuMeshDraw> meshes);
+    /**
+     * @brief Replaces every instance and resets visibility history.
+     */
+    void SetInstances(std::span<const GpuInstance> instances);
+    /**
+     * @brief Updates one instance; only the dirty range is uploaded.
+     */
+    void UpdateInstance(uint32_t index, const GpuInstance& instance);
+    uint32_t InstanceCount() const;
+
+    /**
+     * @brief (Re)creates the Hi-Z pyramid for a depth attachment; call after swapchain changes.
+     *
+     * The depth image must be in a shader-readable layout whenever RecordDepthPyramid runs.
+     */
+    void SetDepthSource(VkImageView depth_view, VkExtent2D extent);
+
+    void RecordUploads(VkCommandBuffer cmd, uint32_t frame_slot);
+    void RecordCull(VkCommandBuffer cmd, CullPhase phase, const MATH::Mat4f& view_projection, uint32_t frame_slot);
+    void RecordDepthPyramid(VkCommandBuffer cmd);
+    /**
+     * @brief Issues the phase's draws; caller binds the graphics pipeline and geometry buffers.
+     */
+    void RecordDraws(VkCommandBuffer cmd, CullPhase phase) const;
+
+    /**
+     * @brief Storage buffer of GpuInstance for vertex shaders (indexed by gl_InstanceIndex).
+     */
+    VkBuffer InstanceBuffer() const;
+
+    void SetOcclusionEnabled(bool enabled);
+    /**
+     * @brief Draw counts read back from the last completed frame in this slot.
+     */
+    const GpuCullingStats& Stats() const;
+    void DrawDebugGui();
+
+private:
+    struct CullUniforms
+    {
+        MATH::Mat4f view_projection {};
+        MATH::Vec4f planes[6] {};
+        float pyramid_size[2] {};
+        uint32_t instance_count = 0;
+        uint32_t occlusion_enabled = 0;
+    };
+
+    struct CullPushConstants
+    {
+        uint32_t phase = 0;
+        uint32_t command_offset = 0;
+        uint32_t compact = 0;
+    };
+
+    struct PyramidPushConstants
+    {
+        int32_t src_size[2] {};
+        int32_t dst_size[2] {};
+    };
+
+    static constexpr uint32_t kMaxPyramidLevels = 16;
+
+    const VulkanContext& context_;
+    VkDevice device_ = VK_NULL_HANDLE;
+    uint32_t max_instances_ = 0;
+    uint32_t max_meshes_ = 0;
+    bool compact_ = false;
+    bool multi_draw_ = false;
+    bool occlusion_enabled_ = true;
+
+    std::vector<GpuInstance> instances_;
+    std::vector<GpuMeshDraw> meshes_;
+    uint32_t dirty_begin_ = 0;
+    uint32_t dirty_end_ = 0;
+    bool meshes_dirty_ = false;
+    bool reset_visibility_ = true;
+
+    Buffer instance_buffer_;
+    Buffer mesh_buffer_;
+    Buffer command_buffer_;
+    Buffer count_buffer_;
+    Buffer visibility_buffer_;
+    Buffer uniform_buffer_;
+    VkDeviceSize uniform_stride_ = 0;
+    std::vector<Buffer> staging_;
+    std::vector<Buffer> readback_;
+    std::vector<bool> readback_pending_;
+    GpuCullingStats stats_ {};
+
+    VkImage pyramid_ = VK_NULL_HANDLE;
+    VkDeviceMemory pyramid_memory_ = VK_NULL_HANDLE;
+    VkImageView pyramid_view_ = VK_NULL_HANDLE;
+    std::vector<VkImageView> pyramid_mips_;
+    VkExtent2D pyramid_extent_ {0, 0};
+    VkImageView depth_view_ = VK_NULL_HANDLE;
+    VkExtent2D depth_extent_ {0, 0};
+    bool pyramid_valid_ = false;
+    VkSampler sampler_ = VK_NULL_HANDLE;
+    // 1x1 stand-in bound to the Hi-Z binding until a depth source exists.
+    VkImage fallback_pyramid_ = VK_NULL_HANDLE;
+    VkDeviceMemory fallback_memory_ = VK_NULL_HANDLE;
+    VkImageView fallback_view_ = VK_NULL_HANDLE;
+
+    VkDescriptorPool descriptor_pool_ = VK_NULL_HANDLE;
+    VkDescriptorSetLayout cull_set_layout_ = VK_NULL_HANDLE;
+    VkDescriptorSetLayout pyramid_set_layout_ = VK_NULL_HANDLE;
+    VkDescriptorSet cull_set_ = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> pyramid_sets_;
+    VkPipelineLayout cull_layout_ = VK_NULL_HANDLE;
+    VkPipelineLayout pyramid_layout_ = VK_NULL_HANDLE;
+    VkPipeline cull_pipeline_ = VK_NULL_HANDLE;
+    VkPipeline pyramid_pipeline_ = VK_NULL_HANDLE;
+
+    void CreateBuffers();
+    void CreateDescriptors();
+    void CreatePipelines();
+    void CreateFallbackPyramid();
+    void CreatePyramid(VkExtent2D extent);
+    void DestroyPyramid();
+    void WriteCullDescriptors();
+    void WritePyramidDescriptors();
+    VkDeviceSize CommandRegionOffset(CullPhase phase) const;
+};
+}  // namespace ZKT
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataMath/Matrix.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+#include "ZokataRenderer/graphics/vk/Buffer.h"
+#include "ZokataRenderer/graphics/VulkanContext.h"
+
+namespace ZKT
+{
+/**
+ * @brief Four joint influences of one vertex; mirrors the uvec4 in shaders/skinning.comp.
+ */
+struct GpuVertexSkin
+{
+    uint16_t joints[4] {};   // indices into the instance's joint palette
+    uint16_t weights[4] {};  // unorm16, summing to 65535
+};
+static_assert(sizeof(GpuVertexSkin) == 16, "GpuVertexSkin must match the std430 layout");
+
+/**
+ * @brief One skinned instance as shaders/skinning.comp reads it from the instance table.
+ */
+struct GpuSkinInstance
+{
+    uint32_t source_vertex = 0;  // first bind-pose vertex of the mesh
+    uint32_t output_vertex = 0;  // first vertex of the instance's output range
+    uint32_t vertex_count = 0;
+    uint32_t first_joint = 0;    // into the joint palette
+};
+static_assert(sizeof(GpuSkinInstance) == 16, "GpuSkinInstance must match the std430 layout");
+
+/**
+ * @brief Quantizes influences to GpuVertexSkin, renormalizing the weights so they sum to one.
+ */
+GpuVertexSkin PackVertexSkin(const std::array<uint32_t, 4>& joints, const std::array<float, 4>& weights);
+
+struct GpuSkinningStats
+{
+    uint32_t meshes = 0;
+    uint32_t instances = 0;
+    uint32_t vertices = 0;  // skinned per frame
+    uint32_t joints = 0;
+};
+
+/**
+ * @brief Compute-shader linear blend skinning into a shared output vertex buffer.
+ *
+ * Bind-pose meshes are uploaded once with AddMesh; every AddInstance reserves its own range
+ * of the output buffer and of the joint palette, and a GpuSkinInstance entry in a table
+ * uploaded alongside the palettes. Output ranges are packed in instance order, so a single
+ * dispatch over every output vertex finds each thread's instance by binary search of the
+ * table and writes skinned MeshVertex data; the depth, shadow and main passes all draw the
+ * same skinned vertices without skinning again.
+ *
+ *   SetJointMatrices -> RecordUploads -> RecordSkinning -> [any pass] draw from OutputBuffer
+ */
+class GpuSkinning
+{
+public:
+    GpuSkinning(const VulkanContext& context, uint32_t max_vertices, uint32_t max_joints);
+    ~GpuSkinning();
+
+    GpuSkinning(const GpuSkinning&) = delete;
+    GpuSkinning& operator=(const GpuSkinning&) = delete;
+
+    /**
+     * @brief Uploads a bind-pose mesh and its influences; returns the mesh index.
+     */
+    uint32_t AddMesh(std::span<const MeshVertex> vertices, std::span<const GpuVertexSkin> skins);
+    /**
+     * @brief Reserves output vertices and a joint palette for one skinned mesh instance.
+     */
+    uint32_t AddInstance(uint32_t mesh, uint32_t joint_count);
+    /**
+     * @brief First vertex of the instance in OutputBuffer(); use as the draw's vertexOffset.
+     */
+    uint32_t OutputVertexOffset(uint32_t instance) const;
+    /**
+     * @brief Copies the instance's skinning matrices (model * inverse bind) for the next upload.
+     */
+    void SetJointMatrices(uint32_t instance, std::span<const MATH::Mat4f> matrices);
+
+    void RecordUploads(VkCommandBuffer cmd, uint32_t frame_slot);
+    void RecordSkinning(VkCommandBuffer cmd);
+
+    /**
+     * @brief Skinned vertices in the MeshVertex layout; usable as a vertex buffer.
+     */
+    VkBuffer OutputBuffer() const;
+    const GpuSkinningStats& Stats() const;
+    void DrawDebugGui();
+
+private:
+    struct Mesh
+    {
+        uint32_t first_vertex = 0;
+        uint32_t vertex_count = 0;
+    };
+
+    struct Instance
+    {
+        uint32_t mesh = 0;
+        uint32_t output_vertex = 0;
+        uint32_t first_joint = 0;
+        uint32_t joint_count = 0;
+    };
+
+    struct SkinPushConstants
+    {
+        uint32_t instance_count = 0;
+        uint32_t vertex_count = 0;  // output vertices over all instances
+    };
+
+    const VulkanContext& context_;
+    VkDevice device_ = VK_NULL_HANDLE;
+    uint32_t max_vertices_ = 0;
+    uint32_t max_joints_ = 0;
+
+    std::vector<Mesh> meshes_;
+    std::vector<Instance> instances_;
+    std::vector<GpuSkinInstance> instance_table_;
+    std::vector<MATH::Mat4f> joints_;
+    uint32_t source_vertex_count_ = 0;
+    uint32_t output_vertex_count_ = 0;
+    bool joints_dirty_ = false;
+    bool table_dirty_ = false;
+    GpuSkinningStats stats_ {};
+
+    Buffer source_buffer_;
+    Buffer skin_buffer_;
+    Buffer joint_buffer_;
+    Buffer instance_buffer_;
+    Buffer output_buffer_;
+    std::vector<Buffer> staging_;  // per frame slot: joint palette, then the instance table
+
+    VkDescriptorPool descriptor_pool_ = VK_NULL_HANDLE;
+    VkDescriptorSetLayout set_layout_ = VK_NULL_HANDLE;
+    VkDescriptorSet set_ = VK_NULL_HANDLE;
+    VkPipelineLayout layout_ = VK_NULL_HANDLE;
+    VkPipeline pipeline_ = VK_NULL_HANDLE;
+
+    void CreateBuffers();
+    void CreateDescriptors();
+    void CreatePipeline();
+    void WriteDescriptors();
+};
+}  // namespace ZKT
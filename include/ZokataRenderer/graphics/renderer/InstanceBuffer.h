@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataRenderer/graphics/renderer/DrawList.h"
+#include "ZokataRenderer/graphics/vk/Buffer.h"
+#include "ZokataRenderer/graphics/VulkanContext.h"
+
+namespace ZKT
+{
+/**
+ * @brief Per-frame storage buffer of the DrawList's batched instance transforms.
+ *
+ * One host-visible buffer per frame in flight, so a frame's transforms are written while
+ * earlier frames still read theirs. Vertex shaders read mat4 instances[gl_InstanceIndex];
+ * RecordBatch issues each DrawBatch as one instanced draw starting at its first_instance.
+ */
+class InstanceBuffer
+{
+public:
+    InstanceBuffer(const VulkanContext& context, uint32_t initial_capacity = 1024);
+
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    /**
+     * @brief Writes draws.instances into the slot's buffer, growing it when needed.
+     *
+     * Call after the slot's fence has been waited on. Growing replaces the slot's VkBuffer,
+     * so descriptors referencing Handle(frame_slot) must be rewritten when this returns true.
+     */
+    bool Upload(const DrawList& draws, uint32_t frame_slot);
+
+    VkBuffer Handle(uint32_t frame_slot) const;
+    uint32_t InstanceCount(uint32_t frame_slot) const;
+
+    /**
+     * @brief Draws every instance of batch; geometry offsets come from the caller's mesh buffers.
+     */
+    static void RecordBatch(
+        VkCommandBuffer cmd, const DrawBatch& batch, uint32_t index_count, uint32_t first_index, int32_t vertex_offset);
+
+private:
+    const VulkanContext& context_;
+    std::vector<Buffer> buffers_;
+    std::vector<uint32_t> capacities_;
+    std::vector<uint32_t> counts_;
+};
+}  // namespace ZKT
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataRenderer/graphics/renderer/TextureFormat.h"
+
+namespace ZKT
+{
+/**
+ * @brief A 2D texture read from a KTX2 file. Its level views point into the parsed bytes,
+ *        typically a memory mapping that has to outlive them.
+ */
+struct Ktx2Texture
+{
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent {};
+    std::vector<std::span<const uint8_t>> levels;  // level 0 is full resolution
+
+    uint32_t LevelCount() const { return static_cast<uint32_t>(levels.size()); }
+    VkDeviceSize ByteSize() const;
+};
+
+/**
+ * @brief Validates bytes as a single-layer 2D KTX2 texture without supercompression, in one of
+ *        the formats of TextureFormat, and returns views of its levels without copying.
+ *        Throws std::runtime_error otherwise.
+ */
+Ktx2Texture ParseKtx2(std::span<const uint8_t> bytes);
+
+/**
+ * @brief Serializes levels (level 0 first, each tightly packed) as a KTX2 file with a basic
+ *        data format descriptor.
+ *
+ * KTX2 stores levels smallest first, so streaming the coarse levels first reads the file
+ * front to back.
+ */
+std::vector<uint8_t> WriteKtx2(
+    TextureFormat format, bool srgb, VkExtent2D extent, std::span<const std::vector<uint8_t>> levels);
+}  // namespace ZKT
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataMath/Matrix.h"
+#include "ZokataMath/Vector.h"
+#include "ZokataRenderer/graphics/vk/Buffer.h"
+#include "ZokataRenderer/graphics/VulkanContext.h"
+
+namespace ZKT
+{
+// GPU-side records; layouts mirror the std430 structs in shaders/meshlet_cull.comp.
+/**
+ * @brief Object-space bounds and index range of one meshlet.
+ */
+struct GpuMeshlet
+{
+    MATH::Vec4f sphere {};  // xyz center, w radius
+    MATH::Vec4f cone {};    // xyz axis, w cutoff (sin of the half angle; 1 never culls)
+    MATH::Vec4f apex {};    // xyz cone apex
+    uint32_t first_index = 0;
+    uint32_t index_count = 0;
+    int32_t vertex_offset = 0;
+    uint32_t pad = 0;
+};
+static_assert(sizeof(GpuMeshlet) == 64, "GpuMeshlet must match the std430 layout");
+
+/**
+ * @brief One meshlet of one instance; the unit the cull shader tests.
+ */
+struct GpuCluster
+{
+    uint32_t instance = 0;  // index into the GpuInstance buffer
+    uint32_t meshlet = 0;   // index into the meshlet table
+};
+static_assert(sizeof(GpuCluster) == 8, "GpuCluster must match the std430 layout");
+
+struct MeshletCullingStats
+{
+    uint32_t clusters = 0;
+    uint32_t draws = 0;
+};
+
+/**
+ * @brief Per-cluster frustum and normal-cone culling that writes indexed indirect draws.
+ *
+ * Runs after the frame's GpuInstance records have been uploaded to the buffer passed to
+ * SetInstanceBuffer(), so each cluster is tested with its instance's current transform. Clusters whose normal cone faces
+ * away from the camera are backfacing as a whole and are skipped before rasterization. Draws
+ * set firstInstance to the owning instance, matching the GpuCulling vertex shader contract.
+ *
+ *   RecordUploads -> RecordCull -> [geometry pass] RecordDraws
+ *
+ * The draw path follows GpuCulling: a compacted draw count where supported, otherwise one
+ * zeroed-when-culled slot per cluster.
+ */
+class MeshletCulling
+{
+public:
+    MeshletCulling(const VulkanContext& context, uint32_t max_clusters, uint32_t max_meshlets);
+    ~MeshletCulling();
+
+    MeshletCulling(const MeshletCulling&) = delete;
+    MeshletCulling& operator=(const MeshletCulling&) = delete;
+
+    /**
+     * @brief Replaces the meshlet table (uploaded on the next RecordUploads).
+     */
+    void SetMeshlets(std::span<const GpuMeshlet> meshlets);
+    /**
+     * @brief Replaces the cluster list (uploaded on the next RecordUploads).
+     */
+    void SetClusters(std::span<const GpuCluster> clusters);
+    uint32_t ClusterCount() const;
+    /**
+     * @brief Storage buffer of GpuInstance, e.g. GpuCulling::InstanceBuffer().
+     */
+    void SetInstanceBuffer(VkBuffer instances);
+
+    void RecordUploads(VkCommandBuffer cmd, uint32_t frame_slot);
+    void RecordCull(
+        VkCommandBuffer cmd, const MATH::Mat4f& view_projection, const MATH::Vec3f& camera_position, uint32_t frame_slot);
+    /**
+     * @brief Issues the surviving clusters; caller binds the graphics pipeline and geometry buffers.
+     */
+    void RecordDraws(VkCommandBuffer cmd) const;
+
+    void SetConeCulling(bool enabled);
+    /**
+     * @brief Draw count read back from the last completed frame in this slot.
+     */
+    const MeshletCullingStats& Stats() const;
+    void DrawDebugGui();
+
+private:
+    struct CullUniforms
+    {
+        MATH::Vec4f planes[6] {};
+        MATH::Vec4f camera_position {};
+        uint32_t cluster_count = 0;
+        uint32_t cone_culling = 0;
+        uint32_t compact = 0;
+        uint32_t pad = 0;
+    };
+
+    const VulkanContext& context_;
+    VkDevice device_ = VK_NULL_HANDLE;
+    uint32_t max_clusters_ = 0;
+    uint32_t max_meshlets_ = 0;
+    bool compact_ = false;
+    bool multi_draw_ = false;
+    bool cone_culling_ = true;
+
+    std::vector<GpuMeshlet> meshlets_;
+    std::vector<GpuCluster> clusters_;
+    bool meshlets_dirty_ = false;
+    bool clusters_dirty_ = false;
+    bool instances_bound_ = false;
+
+    Buffer meshlet_buffer_;
+    Buffer cluster_buffer_;
+    Buffer command_buffer_;
+    Buffer count_buffer_;
+    Buffer uniform_buffer_;
+    VkDeviceSize uniform_stride_ = 0;
+    std::vector<Buffer> staging_;
+    std::vector<Buffer> readback_;
+    std::vector<bool> readback_pending_;
+    MeshletCullingStats stats_ {};
+
+    VkDescriptorPool descriptor_pool_ = VK_NULL_HANDLE;
+    VkDescriptorSetLayout set_layout_ = VK_NULL_HANDLE;
+    VkDescriptorSet set_ = VK_NULL_HANDLE;
+    VkPipelineLayout layout_ = VK_NULL_HANDLE;
+    VkPipeline pipeline_ = VK_NULL_HANDLE;
+
+    void CreateBuffers();
+    void CreateDescriptors();
+    void CreatePipeline();
+    void WriteDescriptors();
+};
+}  // namespace ZKT
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataMath/Vector.h"
+#include "ZokataRenderer/graphics/renderer/Renderable.h"
+
+namespace ZKT
+{
+// GPU vertex layouts; decode helpers for shaders live in shaders/vertex_packing.glsl.
+enum class VertexFormat : uint8_t
+{
+    Float32,   // 44 bytes: MeshVertex as is
+    Packed20,  // 20 bytes: unorm16x4 position, oct snorm16x2 normal and tangent, half2 uv
+    Packed16   // 16 bytes: unorm16x4 position, oct snorm8x2 normal and tangent, half2 uv
+};
+
+enum class IndexFormat : uint8_t
+{
+    UInt16,
+    UInt32
+};
+
+/**
+ * @brief Maps unorm16 positions back to object space: position = offset + unorm * scale.
+ */
+struct VertexQuantization
+{
+    MATH::Vec3f offset {0.0F, 0.0F, 0.0F};
+    MATH::Vec3f scale {1.0F, 1.0F, 1.0F};
+};
+
+/**
+ * @brief Vertex and index bytes in a GPU-ready layout.
+ */
+struct PackedMesh
+{
+    VertexFormat vertex_format = VertexFormat::Float32;
+    IndexFormat index_format = IndexFormat::UInt32;
+    uint32_t vertex_count = 0;
+    uint32_t index_count = 0;
+    VertexQuantization quantization {};
+    std::vector<uint8_t> vertices;
+    std::vector<uint8_t> indices;
+
+    size_t ByteSize() const { return vertices.size() + indices.size(); }
+};
+
+uint32_t VertexStride(VertexFormat format);
+const char* VertexFormatName(VertexFormat format);
+/**
+ * @brief 16-bit indices whenever the vertex count is below 65536 (0xFFFF stays free for restart).
+ */
+IndexFormat SelectIndexFormat(size_t vertex_count);
+VkIndexType ToVkIndexType(IndexFormat format);
+
+/**
+ * @brief Packs geometry into format; non-indexed input gets a sequential index buffer.
+ *
+ * Encoding runs four vertices at a time with SSE2 when available. The scalar path rounds the
+ * same way, so both produce identical bytes.
+ */
+PackedMesh PackMesh(const MeshGeometry& geometry, VertexFormat format);
+/**
+ * @brief Decodes a packed mesh back to MeshGeometry (tools, CPU-side consumers).
+ */
+MeshGeometry UnpackMesh(const PackedMesh& mesh);
+
+/**
+ * @brief Vertex input state for a format: locations 0 position, 1 normal, 2 uv, 3 tangent.
+ *
+ * Packed16 carries normal and tangent in one attribute at location 1 (xy normal, zw tangent).
+ */
+VkVertexInputBindingDescription VertexBinding(VertexFormat format, uint32_t binding);
+std::vector<VkVertexInputAttributeDescription> VertexAttributes(VertexFormat format, uint32_t binding);
+}  // namespace ZKT
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+namespace ZKT
+{
+/**
+ * @brief Best-fit free-list allocator over a range of elements [0, capacity).
+ *
+ * Manages offsets only; the memory lives elsewhere (e.g. GeometryHeap's buffers). Free blocks
+ * are indexed by offset for coalescing and by size for best-fit lookup, so both operations
+ * are O(log n) in the number of free blocks.
+ */
+class RangeAllocator
+{
+public:
+    static constexpr uint32_t kInvalidOffset = UINT32_MAX;
+
+    explicit RangeAllocator(uint32_t capacity = 0);
+
+    /**
+     * @brief Forgets every allocation; the whole range becomes one free block.
+     */
+    void Reset(uint32_t capacity);
+
+    /**
+     * @brief Returns the offset of size free elements, or kInvalidOffset when no block fits.
+     */
+    uint32_t Allocate(uint32_t size);
+    /**
+     * @brief Returns a range obtained from Allocate; neighbouring free blocks are merged.
+     */
+    void Free(uint32_t offset, uint32_t size);
+
+    uint32_t Capacity() const;
+    uint32_t Used() const;
+    uint32_t LargestFreeBlock() const;
+    uint32_t FreeBlockCount() const;
+
+private:
+    using SizeIndex = std::multimap<uint32_t, uint32_t>;  // size -> offset
+
+    uint32_t capacity_ = 0;
+    uint32_t used_ = 0;
+    std::map<uint32_t, SizeIndex::iterator> free_by_offset_;
+    SizeIndex free_by_size_;
+
+    void InsertFree(uint32_t offset, uint32_t size);
+    void EraseFree(std::map<uint32_t, SizeIndex::iterator>::iterator block);
+};
+}  // namespace ZKT
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -8,6 +10,8 @@
 
 namespace ZKT
 {
+struct GpuMeshlet;
+
 // CPU-side mesh data required by the renderer. No API-specific state.
 /**
  * @brief CPU-side mesh vertex, graphics-API agnostic.
@@ -27,14 +31,32 @@ struct MeshGeometry
 
     bool Empty() const { return vertices.empty(); }
     bool Indexed() const { return !indices.empty(); }
+    size_t TriangleCount() const { return (Indexed() ? indices.size() : vertices.size()) / 3; }
+};
+
+// Texture roles of a material; the cooker picks format and color space per slot.
+enum class TextureSlot : uint8_t
+{
+    Albedo,
+    Normal,
+    MetallicRoughness,
+    Occlusion,
+    Emissive,
+    Count
 };
 
 struct MaterialDescriptor
 {
-    std::string shader_id;              // TODO: promote to a strong material/shader handle
-    std::vector<std::string> textures;  // TODO: replace with typed slots (albedo, normal, etc.)
+    std::string shader_id;  // TODO: promote to a strong material/shader handle
+    // Cooked KTX2 texture per TextureSlot; empty when the slot is unused.
+    std::array<std::string, static_cast<size_t>(TextureSlot::Count)> textures;
 };
 
+/**
+ * @brief 64-bit content hash of a material; equal descriptors give equal keys.
+ */
+uint64_t HashMaterial(const MaterialDescriptor& material);
+
 // Minimal interface a renderer needs to draw something. No Vulkan surface leaks here.
 /**
  * @brief Minimal contract a drawable must satisfy for the renderer.
@@ -46,12 +68,34 @@ public:
 
     /**
      * @brief CPU geometry data to draw.
+     *
+     * Renderables may share one geometry object; GPU buffers should be keyed by its address so
+     * shared geometry is uploaded once.
      */
     virtual const MeshGeometry& Geometry() const = 0;
     /**
      * @brief Material/shader metadata for this renderable.
      */
     virtual const MaterialDescriptor& Material() const = 0;
+    /**
+     * @brief Content key of Material(); draws with equal geometry and key are instanced together.
+     */
+    virtual uint64_t MaterialKey() const;
+
+    /**
+     * @brief Number of detail levels; level 0 is Geometry(), higher levels are coarser.
+     */
+    virtual uint32_t LodCount() const;
+    /**
+     * @brief Geometry of one detail level (level 0 by default).
+     */
+    virtual const MeshGeometry& LodGeometry(uint32_t lod) const;
+    /**
+     * @brief Meshlets of Geometry() for cluster culling, or nullptr (the default).
+     *
+     * Geometry().indices must be in meshlet order; index and vertex offsets are relative to it.
+     */
+    virtual const std::vector<GpuMeshlet>* Meshlets() const;
 
     /**
      * @brief Whether the renderable should be considered for rendering.
@@ -4,12 +4,21 @@
 
 #include <vulkan/vulkan.h>
 
+#include "ZokataRenderer/graphics/renderer/DrawList.h"
+
 namespace ZKT
 {
+class TextureStreamer;
+class VirtualTextureAtlas;
+
 struct FrameDescriptor
 {
     float delta_seconds = 0.0F;
     uint64_t frame_index = 0;
+    const DrawList* draw_list = nullptr;  // visible draws extracted by the engine, if any
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    uint32_t frame_slot = 0;  // slot whose fence BeginFrame waited on
+    VkExtent2D extent {0, 0};
 };
 
 enum class RendererType
@@ -30,10 +39,38 @@ public:
      * @brief Renderer kind (e.g. Deferred, PathTracer).
      */
     virtual RendererType Type() const = 0;
+    /**
+     * @brief Runs once the slot's fence was waited on and uploads began, before the update
+     *        callback, so engine systems see this slot's per-frame resources.
+     */
+    virtual void BeginFrame(const FrameDescriptor& frame);
     /**
      * @brief Draws the renderer's control/debug UI.
      */
     virtual void RenderGui(const FrameDescriptor& frame) = 0;
+    /**
+     * @brief Records uploads and compute work; runs before the swapchain render pass begins.
+     */
+    virtual void RecordFrame(const FrameDescriptor& frame);
+    /**
+     * @brief Records draws into the swapchain render pass, before the UI.
+     */
+    virtual void RecordPass(const FrameDescriptor& frame);
     virtual void OnSwapchainUpdated(VkExtent2D extent);
+    /**
+     * @brief Streamer material textures are created in, or nullptr (the default) when the
+     *        renderer samples none.
+     */
+    virtual TextureStreamer* Textures();
+    /**
+     * @brief Atlas material albedo textures can be paged into, or nullptr (the default) when
+     *        the renderer samples no virtual textures.
+     */
+    virtual VirtualTextureAtlas* VirtualTextures();
+    /**
+     * @brief Samples a virtual texture as the albedo of draws with material_key;
+     *        VirtualPageTable::kInvalidTexture removes the mapping.
+     */
+    virtual void SetMaterialVirtualTexture(uint64_t material_key, uint32_t texture);
 };
 }  // namespace ZKT
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include <vulkan/vulkan.h>
+
+namespace ZKT
+{
+// Storage formats the texture cooker writes. Block-compressed ones store 4x4 texel blocks.
+enum class TextureFormat : uint8_t
+{
+    RGBA8,  // uncompressed, 4 bytes per texel
+    BC1,    // RGB, 8 bytes per block (8:1 against RGBA8)
+    BC3,    // RGBA: BC1 color plus interpolated alpha, 16 bytes per block
+    BC5,    // two channels, for tangent-space normal maps, 16 bytes per block
+    BC7     // RGBA at high quality, 16 bytes per block
+};
+
+/**
+ * @brief Texel extent and byte size of a format's smallest addressable unit.
+ */
+struct TexelBlock
+{
+    uint32_t width = 1;
+    uint32_t height = 1;
+    uint32_t bytes = 0;  // 0 for formats the texture path does not handle
+};
+
+/**
+ * @brief VkFormat storing format; BC5 has no sRGB variant, so srgb is ignored for it.
+ */
+VkFormat ToVkFormat(TextureFormat format, bool srgb);
+/**
+ * @brief Block layout of the VkFormats ToVkFormat returns (either color space).
+ */
+TexelBlock FormatBlock(VkFormat format);
+TexelBlock FormatBlock(TextureFormat format);
+bool IsSrgbFormat(VkFormat format);
+const char* TextureFormatName(TextureFormat format);
+/**
+ * @brief Parses "rgba8", "bc1", "bc3", "bc5" or "bc7"; false leaves format untouched.
+ */
+bool ParseTextureFormat(std::string_view name, TextureFormat& format);
+
+/**
+ * @brief Texel extent of a mip level, never below 1x1.
+ */
+VkExtent2D MipExtent(VkExtent2D base, uint32_t level);
+/**
+ * @brief Levels down to 1x1.
+ */
+uint32_t FullMipCount(VkExtent2D base);
+/**
+ * @brief Bytes of one tightly packed level; partial edge blocks count as whole blocks.
+ */
+VkDeviceSize MipByteSize(const TexelBlock& block, VkExtent2D extent);
+}  // namespace ZKT
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataRenderer/graphics/renderer/Ktx2.h"
+#include "ZokataRenderer/graphics/vk/Image.h"
+#include "ZokataRenderer/graphics/VulkanContext.h"
+
+namespace ZKT
+{
+class UploadService;
+
+struct TextureStreamerStats
+{
+    uint32_t textures = 0;
+    uint32_t streaming = 0;          // textures with levels still to arrive
+    uint64_t resident_bytes = 0;     // level bytes the GPU can sample
+    uint64_t pending_bytes = 0;      // levels not yet handed to the uploader
+    uint64_t in_flight_bytes = 0;    // handed to the uploader, not yet complete
+};
+
+/**
+ * @brief Device-local images for KTX2 textures, filled level by level through an UploadService.
+ *
+ * Level bytes go from the caller's memory (typically a mapped file, kept alive by the owner
+ * passed to Create) straight into the upload ring; nothing is copied on the CPU side. Levels
+ * are queued smallest first across all textures, so every texture soon has a complete blurry
+ * tail and sharpens as its larger levels arrive, and only about two frame budgets are handed
+ * to the uploader at a time so new textures do not wait behind a long backlog.
+ *
+ * A texture's view covers its resident levels only (base level = ResidentMip) and is replaced
+ * whenever a finer level completes; replaced views and released images are destroyed once the
+ * frame slot that may still use them comes around again. UploadService::BeginFrame must run
+ * before this streamer's BeginFrame.
+ *
+ *   Create -> BeginFrame (each frame) -> View -> ... -> Release
+ */
+class TextureStreamer
+{
+public:
+    static constexpr uint32_t kInvalidTexture = UINT32_MAX;
+
+    TextureStreamer(const VulkanContext& context, UploadService& uploader);
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    /**
+     * @brief Creates the image and queues its levels; texture's level views must stay valid
+     *        while owner is alive. Throws when the device cannot sample the format.
+     */
+    uint32_t Create(const Ktx2Texture& texture, std::shared_ptr<const void> owner);
+    /**
+     * @brief Drops a texture; its image is destroyed once no frame or upload uses it.
+     */
+    void Release(uint32_t texture);
+
+    /**
+     * @brief Call once the slot's fence has been waited on; publishes finished levels, destroys
+     *        what the slot retired and hands the next levels to the uploader.
+     */
+    void BeginFrame(uint32_t frame_slot);
+
+    /**
+     * @brief View over the resident levels, VK_NULL_HANDLE until the smallest level arrives.
+     *        Valid for the current frame only.
+     */
+    VkImageView View(uint32_t texture) const;
+    /**
+     * @brief Finest resident level; the level count while nothing is resident.
+     */
+    uint32_t ResidentMip(uint32_t texture) const;
+    /**
+     * @brief True once every level is on the GPU.
+     */
+    bool IsResident(uint32_t texture) const;
+
+    const TextureStreamerStats& Stats() const;
+    void DrawDebugGui() const;
+
+private:
+    struct Texture
+    {
+        Image image;
+        VkImageView view = VK_NULL_HANDLE;
+        std::shared_ptr<const void> owner;            // dropped once every level is handed over
+        std::vector<std::span<const uint8_t>> levels;
+        std::vector<uint64_t> tickets;                // per level, 0 until handed over
+        uint32_t resident_mip = 0;
+        uint32_t unsent_levels = 0;
+        bool live = false;
+    };
+
+    struct PendingLevel
+    {
+        uint32_t texture = 0;
+        uint32_t level = 0;
+        VkDeviceSize bytes = 0;
+    };
+
+    struct Retired
+    {
+        Image image;  // invalid when only a view was replaced
+        VkImageView view = VK_NULL_HANDLE;
+        uint64_t ticket = 0;  // last upload writing the image
+    };
+
+    const VulkanContext& context_;
+    UploadService& uploader_;
+    VkDevice device_ = VK_NULL_HANDLE;
+    bool bc_supported_ = false;
+
+    std::vector<Texture> textures_;
+    std::vector<uint32_t> free_ids_;
+    std::vector<uint32_t> streaming_;      // live textures with levels still to arrive
+    std::vector<PendingLevel> pending_;    // sorted by size, smallest first
+    std::vector<std::vector<Retired>> retired_;  // per frame slot
+    uint32_t frame_slot_ = 0;
+    TextureStreamerStats stats_ {};
+
+    void Feed();
+    /**
+     * @brief Replaces the texture's view with one starting at its resident level.
+     */
+    void UpdateView(Texture& texture);
+};
+}  // namespace ZKT
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataRenderer/graphics/renderer/TextureFormat.h"
+#include "ZokataRenderer/graphics/vk/Buffer.h"
+#include "ZokataRenderer/graphics/VulkanContext.h"
+
+namespace ZKT
+{
+struct UploadServiceStats
+{
+    uint64_t queued_bytes = 0;     // accepted but not yet copied into the ring
+    uint64_t ring_bytes = 0;       // ring space held by batches the GPU has not finished
+    uint64_t last_frame_bytes = 0; // bytes submitted by the last BeginFrame
+    uint64_t total_bytes = 0;
+    uint32_t batches_in_flight = 0;
+    uint32_t ring_full_frames = 0; // frames that submitted less than the budget for lack of ring space
+};
+
+/**
+ * @brief Streams buffer uploads to the GPU without blocking the frame.
+ *
+ * Uploads are queued from any thread and copied into a persistently mapped staging ring once
+ * per frame, at most FrameBudget() bytes at a time; larger uploads are split across frames.
+ * Each frame's copies go out as one submission on the device's transfer queue, a DMA-only
+ * family when there is one. Batches retire in order by fence, which frees their ring space;
+ * nothing on the render thread ever waits on them.
+ *
+ * Destination buffers use exclusive sharing, so with a dedicated transfer family every copied
+ * range is released by the transfer queue and acquired on the graphics queue: BeginFrame
+ * records the acquire barriers into the frame's command buffer, and only then do the uploads'
+ * tickets report complete. Destination ranges must not be read or reused by the GPU before
+ * their ticket completes.
+ *
+ * Image uploads fill one mip level, split on whole rows of texel blocks. The level goes from
+ * UNDEFINED to TRANSFER_DST_OPTIMAL before its first copy and ends in SHADER_READ_ONLY_OPTIMAL,
+ * acquired like a buffer range when the transfer family is dedicated. Region uploads write
+ * into images that stay in GENERAL layout and are shared concurrently, such as texture atlases
+ * sampled while other regions are being filled; they need no barriers beyond the batch's.
+ *
+ *   Upload (any thread) ... BeginFrame(cmd) (render thread, outside a render pass) -> IsComplete
+ */
+class UploadService
+{
+public:
+    static constexpr VkDeviceSize kDefaultRingSize = VkDeviceSize {64} << 20;
+    static constexpr VkDeviceSize kDefaultFrameBudget = VkDeviceSize {8} << 20;
+
+    explicit UploadService(
+        const VulkanContext& context,
+        VkDeviceSize ring_size = kDefaultRingSize,
+        VkDeviceSize frame_budget = kDefaultFrameBudget);
+    ~UploadService();
+
+    UploadService(const UploadService&) = delete;
+    UploadService& operator=(const UploadService&) = delete;
+
+    /**
+     * @brief Queues data for dst at offset; returns a ticket that completes in queue order.
+     */
+    uint64_t Upload(VkBuffer dst, VkDeviceSize offset, std::vector<uint8_t> data);
+    /**
+     * @brief Same, without copying: data is read straight into the ring and must stay valid
+     *        while owner is alive; the service drops owner once the last byte is staged.
+     */
+    uint64_t Upload(VkBuffer dst, VkDeviceSize offset, std::span<const uint8_t> data, std::shared_ptr<const void> owner);
+    /**
+     * @brief Queues one mip level of a 2D image created with TRANSFER_DST usage and exclusive
+     *        sharing; data is the tightly packed level, kept alive by owner as above. Throws
+     *        std::runtime_error when its size does not match the format and extent.
+     */
+    uint64_t UploadImage(
+        VkImage dst,
+        VkFormat format,
+        uint32_t mip_level,
+        VkExtent2D extent,
+        std::span<const uint8_t> data,
+        std::shared_ptr<const void> owner);
+    /**
+     * @brief Queues a rectangle of one level of an image kept in VK_IMAGE_LAYOUT_GENERAL with
+     *        concurrent sharing (exclusive is fine without a dedicated transfer family). offset
+     *        must be block-aligned; the rectangle must not be read before the ticket completes.
+     */
+    uint64_t UploadImageRegion(
+        VkImage dst,
+        VkFormat format,
+        uint32_t mip_level,
+        VkOffset2D offset,
+        VkExtent2D extent,
+        std::span<const uint8_t> data,
+        std::shared_ptr<const void> owner);
+    /**
+     * @brief True once the upload is visible to graphics work recorded after the BeginFrame
+     *        that completed it.
+     */
+    bool IsComplete(uint64_t ticket) const;
+
+    /**
+     * @brief Retires finished batches, records their acquire barriers into cmd and submits the
+     *        next batch within the frame budget.
+     */
+    void BeginFrame(VkCommandBuffer cmd);
+
+    void SetFrameBudget(VkDeviceSize bytes);
+    VkDeviceSize FrameBudget() const;
+    bool HasDedicatedQueue() const;
+
+    UploadServiceStats Stats() const;
+    void DrawDebugGui() const;
+
+private:
+    struct Request
+    {
+        VkBuffer dst = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkImage image = VK_NULL_HANDLE;  // set instead of dst for image uploads
+        uint32_t mip_level = 0;
+        VkOffset2D image_offset {};
+        VkExtent2D extent {};
+        bool general_layout = false;  // a region of a GENERAL image: no layout transitions
+        TexelBlock block {};
+        std::shared_ptr<const void> owner;  // keeps bytes alive until fully staged
+        const uint8_t* bytes = nullptr;
+        VkDeviceSize size = 0;
+        VkDeviceSize copied = 0;  // bytes already staged by earlier frames
+        uint64_t ticket = 0;
+    };
+
+    struct Region
+    {
+        VkBuffer dst = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        VkImage image = VK_NULL_HANDLE;  // a finished image level instead of a buffer range
+        uint32_t mip_level = 0;
+    };
+
+    struct Batch
+    {
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        uint64_t ring_end = 0;       // ring head after this batch; the tail moves here on retire
+        uint64_t last_ticket = 0;    // every ticket up to this one is finished with this batch
+        std::vector<Region> regions; // ranges and levels to acquire on the graphics queue
+    };
+
+    const VulkanContext& context_;
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkQueue queue_ = VK_NULL_HANDLE;
+    uint32_t transfer_family_ = 0;
+    uint32_t graphics_family_ = 0;
+    bool dedicated_ = false;
+    VkCommandPool command_pool_ = VK_NULL_HANDLE;
+
+    Buffer ring_;
+    uint8_t* ring_data_ = nullptr;
+    VkDeviceSize frame_budget_ = kDefaultFrameBudget;
+    uint64_t head_ = 0;  // bytes ever allocated from the ring; offset is head_ % size
+    uint64_t tail_ = 0;  // bytes ever released by retired batches
+
+    mutable std::mutex mutex_;  // guards requests_, next_ticket_ and queued_bytes_
+    std::deque<Request> requests_;
+    uint64_t next_ticket_ = 0;
+    uint64_t queued_bytes_ = 0;
+    std::atomic<uint64_t> completed_ticket_ {0};
+
+    std::deque<Batch> in_flight_;
+    std::vector<Batch> free_batches_;
+    uint64_t last_submitted_ticket_ = 0;
+    uint64_t last_frame_bytes_ = 0;
+    uint64_t total_bytes_ = 0;
+    uint32_t ring_full_frames_ = 0;
+
+    uint64_t Enqueue(Request request);
+    void Retire(VkCommandBuffer cmd);
+    void Submit();
+    Batch AcquireBatch();
+    /**
+     * @brief Reserves size bytes at a contiguous ring offset, or returns false when full.
+     */
+    bool AllocateRing(VkDeviceSize size, VkDeviceSize& offset);
+};
+}  // namespace ZKT
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataRenderer/graphics/renderer/Ktx2.h"
+#include "ZokataRenderer/graphics/renderer/RangeAllocator.h"
+
+namespace ZKT
+{
+// Page geometry and encodings; mirrored by shaders/virtual_texture.glsl.
+constexpr uint32_t kVirtualPageTexels = 128;  // texels a page covers in its level
+constexpr uint32_t kVirtualPageBorder = 4;    // texels repeated from the neighbours on each side, for filtering
+constexpr uint32_t kVirtualPagePadded = kVirtualPageTexels + 2 * kVirtualPageBorder;
+constexpr uint32_t kMaxVirtualLevels = 12;
+constexpr uint32_t kMaxVirtualTextures = 4095;     // texture ids use 12 bits; all ones is kNoPageRequest
+constexpr uint32_t kMaxVirtualPagesPerAxis = 256;  // 32768 texels at level 0
+constexpr uint32_t kNoPageRequest = UINT32_MAX;    // feedback texels nothing was drawn to
+
+/**
+ * @brief A page of a virtual texture: level plus page coordinates within that level.
+ */
+struct VirtualPage
+{
+    uint32_t texture = 0;
+    uint32_t level = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+};
+
+/**
+ * @brief Feedback encoding: x in bits 0-7, y in 8-15, level in 16-19, texture in 20-31.
+ */
+uint32_t PackVirtualPage(const VirtualPage& page);
+VirtualPage UnpackVirtualPage(uint32_t packed);
+/**
+ * @brief The page one level coarser that covers page.
+ */
+VirtualPage ParentPage(const VirtualPage& page);
+
+/**
+ * @brief Per-texture record read by shaders to find a page's table entry; std430, 64 bytes.
+ */
+struct GpuVirtualTexture
+{
+    uint32_t table_offset = 0;  // first entry of level 0 in the page table
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t levels = 0;  // virtual levels; the last one fits in a single page
+    uint32_t level_offset[kMaxVirtualLevels] {};  // entry offset of each level from table_offset
+};
+static_assert(sizeof(GpuVirtualTexture) == 64, "GpuVirtualTexture must match the std430 layout");
+
+/**
+ * @brief Levels a virtual texture of extent uses: down to the first that fits in one page.
+ */
+uint32_t VirtualLevelCount(VkExtent2D extent);
+/**
+ * @brief Bytes of one padded page in format, as CopyVirtualPage writes it.
+ */
+VkDeviceSize VirtualPageBytes(VkFormat format);
+/**
+ * @brief Cuts a padded page out of a level of texture, block by block without decoding. The
+ *        border wraps around the level's edges when wrap is set and repeats them otherwise.
+ *        Throws std::runtime_error when the page or out's size does not fit the texture.
+ */
+void CopyVirtualPage(const Ktx2Texture& texture, const VirtualPage& page, bool wrap, std::span<uint8_t> out);
+
+/**
+ * @brief CPU copy of the page table shaders translate virtual addresses through.
+ *
+ * Every texture owns one entry per page of each of its levels. An entry names the atlas slot
+ * and level of the finest resident page covering it (bit 31 set), so a page that is not
+ * resident falls back to its nearest resident ancestor; 0 means nothing is resident yet.
+ * Map and Unmap keep that invariant by rewriting the affected entries of finer levels, and
+ * every change widens a dirty range the renderer copies to the GPU.
+ */
+class VirtualPageTable
+{
+public:
+    static constexpr uint32_t kInvalidTexture = UINT32_MAX;
+
+    /**
+     * @brief Table of capacity entries for an atlas atlas_pages_x slots wide.
+     */
+    VirtualPageTable(uint32_t capacity, uint32_t atlas_pages_x);
+
+    /**
+     * @brief Allocates the entries of a texture of extent; throws when the extent is too
+     *        large or the table is full.
+     */
+    uint32_t AddTexture(VkExtent2D extent);
+    /**
+     * @brief Frees the texture's entries; map no more of its pages afterwards.
+     */
+    void RemoveTexture(uint32_t texture);
+    bool HasTexture(uint32_t texture) const;
+    /**
+     * @brief True when page names an existing texture, level and page.
+     */
+    bool Contains(const VirtualPage& page) const;
+    const GpuVirtualTexture& Texture(uint32_t texture) const;
+    uint32_t PagesX(uint32_t texture, uint32_t level) const;
+    uint32_t PagesY(uint32_t texture, uint32_t level) const;
+    /**
+     * @brief ParentPage clamped to the parent level, whose page count rounds down past
+     *        non-power-of-two edges. page must not be on the texture's last level.
+     */
+    VirtualPage Parent(const VirtualPage& page) const;
+
+    /**
+     * @brief Points page, and the finer entries it now serves best, at atlas slot.
+     */
+    void Map(const VirtualPage& page, uint32_t slot);
+    /**
+     * @brief Reverts the entries served by page (mapped at slot) to its parent's entry.
+     */
+    void Unmap(const VirtualPage& page, uint32_t slot);
+    uint32_t Entry(const VirtualPage& page) const;
+    /**
+     * @brief Encoded entry for a page resident at atlas slot.
+     */
+    uint32_t MakeEntry(uint32_t level, uint32_t slot) const;
+
+    std::span<const uint32_t> Entries() const;
+    std::span<const GpuVirtualTexture> Textures() const;
+    /**
+     * @brief Entry and texture ranges changed since the last ClearDirty ([begin, end)).
+     */
+    void DirtyEntries(uint32_t& begin, uint32_t& end) const;
+    void DirtyTextures(uint32_t& begin, uint32_t& end) const;
+    void ClearDirty();
+
+    uint32_t TextureCount() const;
+    uint32_t UsedEntries() const;
+
+private:
+    RangeAllocator ranges_;
+    uint32_t atlas_pages_x_ = 1;
+    std::vector<uint32_t> entries_;
+    std::vector<GpuVirtualTexture> textures_;
+    std::vector<uint32_t> free_ids_;
+    uint32_t texture_count_ = 0;
+    uint32_t dirty_begin_ = UINT32_MAX;
+    uint32_t dirty_end_ = 0;
+    uint32_t dirty_texture_begin_ = UINT32_MAX;
+    uint32_t dirty_texture_end_ = 0;
+
+    uint32_t EntryIndex(const VirtualPage& page) const;
+    void SetEntry(uint32_t index, uint32_t value);
+    /**
+     * @brief Calls fn(entry index) for page and every page of finer levels inside it.
+     */
+    template <typename Fn>
+    void ForEachCovered(const VirtualPage& page, Fn&& fn);
+};
+}  // namespace ZKT
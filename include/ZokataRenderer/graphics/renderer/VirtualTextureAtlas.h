@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "ZokataRenderer/graphics/renderer/VirtualTexture.h"
+#include "ZokataRenderer/graphics/vk/Buffer.h"
+#include "ZokataRenderer/graphics/vk/Image.h"
+#include "ZokataRenderer/graphics/VulkanContext.h"
+
+namespace ZKT
+{
+class UploadService;
+
+struct VirtualTextureAtlasStats
+{
+    uint32_t textures = 0;
+    uint32_t slots = 0;
+    uint32_t mapped_slots = 0;       // slots holding a page the table points at
+    uint32_t retired_slots = 0;      // unmapped, waiting for frames that may still sample them
+    uint32_t table_entries = 0;      // page table entries owned by textures
+    uint32_t feedback_texels = 0;    // texels read back for the current frame
+    uint64_t atlas_bytes = 0;
+};
+
+/**
+ * @brief Physical page atlas, page table and feedback buffer for virtual texturing.
+ *
+ * The atlas is a single-level image of fixed-size padded pages (VirtualPageTable slots) in one
+ * block format, kept in GENERAL layout and shared between the graphics and transfer families
+ * so pages are written through UploadService::UploadImageRegion while others are sampled. Its
+ * size is chosen from the screen resolution (AtlasPagesPerAxis), not from the texture content.
+ *
+ * Shaders (shaders/virtual_texture.glsl) translate virtual coordinates through the page table
+ * and texture records, which live in host-visible storage buffers per frame slot: BeginFrame
+ * copies the entries changed since that slot's last frame, so mapping and unmapping never
+ * touches memory a frame in flight reads. Unmapped slots are only reused once every frame slot
+ * has published a table without them.
+ *
+ * Shaders also write the page each pixel wants into a feedback buffer at 1/kFeedbackScale of
+ * the screen resolution; RecordFeedbackReadback copies it to the slot's readback buffer and
+ * clears it, and the slot's next BeginFrame exposes the copy through Feedback().
+ *
+ *   BeginFrame -> Feedback() -> AllocateSlot/UploadPage/MapPage/UnmapPage -> [draws]
+ *   -> RecordFeedbackReadback
+ */
+class VirtualTextureAtlas
+{
+public:
+    static constexpr uint32_t kInvalidSlot = UINT32_MAX;
+    static constexpr uint32_t kFeedbackScale = 8;  // screen pixels per feedback texel, per axis
+    static constexpr uint32_t kDefaultTableCapacity = 1U << 20;
+
+    /**
+     * @brief Atlas of pages_per_axis^2 pages of format; throws when the device cannot sample
+     *        the format or the atlas exceeds the maximum image size.
+     */
+    VirtualTextureAtlas(
+        const VulkanContext& context,
+        UploadService& uploader,
+        VkFormat format,
+        uint32_t pages_per_axis,
+        uint32_t table_capacity = kDefaultTableCapacity);
+    ~VirtualTextureAtlas();
+
+    VirtualTextureAtlas(const VirtualTextureAtlas&) = delete;
+    VirtualTextureAtlas& operator=(const VirtualTextureAtlas&) = delete;
+
+    /**
+     * @brief Pages per atlas side for a screen: room for about four screens of unique texels at
+     *        1:1 density, which covers the mip tails and pages straddling the screen edges.
+     */
+    static uint32_t AtlasPagesPerAxis(VkExtent2D screen);
+
+    /**
+     * @brief (Re)creates the feedback buffer for a screen extent; waits for the device.
+     */
+    void SetFeedbackExtent(VkExtent2D screen);
+
+    /**
+     * @brief Call once the slot's fence has been waited on; frees the slots it retired,
+     *        publishes the page table to the slot and exposes its feedback readback.
+     */
+    void BeginFrame(uint32_t frame_slot);
+    /**
+     * @brief Packed page requests read back for this slot (kNoPageRequest where nothing was
+     *        drawn); empty when the slot recorded no readback. Valid until the next BeginFrame.
+     */
+    std::span<const uint32_t> Feedback() const;
+    /**
+     * @brief Copies the feedback buffer to the slot's readback buffer and clears it; record
+     *        after every pass that writes feedback, outside of render passes.
+     */
+    void RecordFeedbackReadback(VkCommandBuffer cmd, uint32_t frame_slot);
+
+    uint32_t AddTexture(VkExtent2D extent);
+    /**
+     * @brief Drops the texture's table entries; release its slots separately.
+     */
+    void RemoveTexture(uint32_t texture);
+    const VirtualPageTable& PageTable() const;
+
+    /**
+     * @brief A free slot, or kInvalidSlot when every slot is mapped or retired.
+     */
+    uint32_t AllocateSlot();
+    uint32_t FreeSlotCount() const;
+    /**
+     * @brief Slots that become free once the frames that may still use them have finished.
+     */
+    uint32_t RetiredSlotCount() const;
+    /**
+     * @brief Queues a padded page (VirtualPageBytes) into slot; data must stay valid while
+     *        owner is alive. Returns the upload ticket.
+     */
+    uint64_t UploadPage(uint32_t slot, std::span<const uint8_t> data, std::shared_ptr<const void> owner);
+    bool IsComplete(uint64_t ticket) const;
+    /**
+     * @brief Points the page table at slot; its upload must have completed.
+     */
+    void MapPage(const VirtualPage& page, uint32_t slot);
+    /**
+     * @brief Reverts the page's entries to its parent and retires the slot.
+     */
+    void UnmapPage(const VirtualPage& page, uint32_t slot);
+    /**
+     * @brief Retires a slot that was never mapped; it is reused once ticket has completed too.
+     */
+    void ReleaseSlot(uint32_t slot, uint64_t ticket = 0);
+
+    VkFormat Format() const;
+    uint32_t PagesPerAxis() const;
+    /**
+     * @brief Layout of the set shaders/virtual_texture.glsl expects, for pipeline layouts.
+     */
+    VkDescriptorSetLayout SetLayout() const;
+    VkDescriptorSet DescriptorSet(uint32_t frame_slot) const;
+
+    VirtualTextureAtlasStats Stats() const;
+    void DrawDebugGui();
+
+private:
+    // Mirrors VtParams in shaders/virtual_texture.glsl (std140).
+    struct Params
+    {
+        uint32_t feedback_size[2] {};
+        uint32_t feedback_jitter[2] {};  // screen pixel within each kFeedbackScale cell that writes
+        float atlas_size = 0.0F;         // texels per side
+        float lod_bias = 0.0F;
+        uint32_t pad[2] {};
+    };
+
+    struct Retired
+    {
+        uint32_t slot = 0;
+        uint64_t ticket = 0;
+    };
+
+    struct SlotTables
+    {
+        Buffer entries;
+        Buffer textures;
+        Buffer params;
+        Buffer readback;
+        uint32_t readback_texels = 0;  // 0 unless a readback was recorded into this slot
+        uint32_t dirty_begin = UINT32_MAX;
+        uint32_t dirty_end = 0;
+        uint32_t dirty_texture_begin = UINT32_MAX;
+        uint32_t dirty_texture_end = 0;
+    };
+
+    const VulkanContext& context_;
+    UploadService& uploader_;
+    VkDevice device_ = VK_NULL_HANDLE;
+    uint32_t pages_per_axis_ = 0;
+    VirtualPageTable table_;
+
+    Image atlas_;
+    VkImageView atlas_view_ = VK_NULL_HANDLE;
+    VkSampler sampler_ = VK_NULL_HANDLE;
+    std::vector<uint32_t> free_slots_;
+    std::vector<std::vector<Retired>> retired_;  // per frame slot
+    uint32_t retired_count_ = 0;
+    uint32_t frame_slot_ = 0;
+    uint64_t frame_index_ = 0;
+    float lod_bias_ = 0.0F;
+
+    Buffer feedback_;
+    VkExtent2D feedback_extent_ {0, 0};
+    std::vector<SlotTables> slots_;
+    std::span<const uint32_t> feedback_view_;
+
+    VkDescriptorPool descriptor_pool_ = VK_NULL_HANDLE;
+    VkDescriptorSetLayout set_layout_ = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> sets_;
+
+    void CreateAtlas(VkFormat format);
+    void CreateDescriptors();
+    void WriteDescriptors();
+    /**
+     * @brief Widens every slot's pending ranges by the table's dirty ranges.
+     */
+    void CollectDirty();
+};
+}  // namespace ZKT
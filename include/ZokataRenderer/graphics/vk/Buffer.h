@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+
+#include <vulkan/vulkan.h>
+
+namespace ZKT
+{
+class Device;
+
+/**
+ * @brief Owning VkBuffer + dedicated VkDeviceMemory; host-visible buffers stay mapped.
+ */
+class Buffer
+{
+public:
+    Buffer() = default;
+    Buffer(const Device& device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+    ~Buffer();
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+    Buffer(Buffer&& other) noexcept;
+    Buffer& operator=(Buffer&& other) noexcept;
+
+    /**
+     * @brief Copies bytes into a host-visible buffer at offset (flushes non-coherent memory).
+     */
+    void Write(const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
+
+    VkBuffer Handle() const;
+    VkDeviceSize Size() const;
+    /**
+     * @brief Persistent mapping for host-visible buffers, nullptr otherwise.
+     */
+    void* Mapped() const;
+    bool Valid() const;
+
+private:
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkBuffer buffer_ = VK_NULL_HANDLE;
+    VkDeviceMemory memory_ = VK_NULL_HANDLE;
+    VkDeviceSize size_ = 0;
+    void* mapped_ = nullptr;
+    bool coherent_ = true;
+
+    void Release();
+};
+}  // namespace ZKT
@@ -7,6 +7,19 @@
 
 namespace ZKT
 {
+/**
+ * @brief Optional device features detected at startup and enabled when present.
+ */
+struct DeviceFeatures
+{
+    bool multi_draw_indirect = false;
+    bool draw_indirect_count = false;
+    bool draw_indirect_first_instance = false;
+    bool shader_draw_parameters = false;
+    bool texture_compression_bc = false;
+    bool fragment_stores_and_atomics = false;
+};
+
 class Device
 {
 public:
@@ -23,21 +36,41 @@ public:
     VkDevice Logical() const;
     VkQueue GraphicsQueue() const;
     VkQueue PresentQueue() const;
+    /**
+     * @brief Queue for streaming copies: a transfer-only (DMA) family when the device has one,
+     *        otherwise the graphics queue.
+     */
+    VkQueue TransferQueue() const;
     uint32_t GraphicsQueueFamily() const;
     uint32_t PresentQueueFamily() const;
+    uint32_t TransferQueueFamily() const;
+    /**
+     * @brief True when TransferQueue() is a separate family, so uploads need ownership transfers.
+     */
+    bool HasDedicatedTransferQueue() const;
+    const DeviceFeatures& Features() const;
+
+    /**
+     * @brief Index of a memory type matching type_bits with all requested properties; throws if none.
+     */
+    uint32_t FindMemoryType(uint32_t type_bits, VkMemoryPropertyFlags properties) const;
 
 private:
     VkPhysicalDevice physical_device_ = VK_NULL_HANDLE;
     VkDevice device_ = VK_NULL_HANDLE;
     VkQueue graphics_queue_ = VK_NULL_HANDLE;
     VkQueue present_queue_ = VK_NULL_HANDLE;
+    VkQueue transfer_queue_ = VK_NULL_HANDLE;
     uint32_t graphics_queue_family_ = 0;
     uint32_t present_queue_family_ = 0;
+    uint32_t transfer_queue_family_ = 0;
+    DeviceFeatures features_ {};
 
     struct QueueFamilyIndices
     {
         std::optional<uint32_t> graphics_family;
         std::optional<uint32_t> present_family;
+        std::optional<uint32_t> transfer_family;  // only set for families without graphics
 
         [[nodiscard]] bool Complete() const;
     };
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include <vulkan/vulkan.h>
+
+namespace ZKT
+{
+class Device;
+
+/**
+ * @brief Owning 2D VkImage + dedicated device-local VkDeviceMemory with optimal tiling. Views
+ *        are left to the owner, which knows which levels are valid.
+ */
+class Image
+{
+public:
+    Image() = default;
+    /**
+     * @brief Exclusive sharing unless queue_families names two or more distinct families, which
+     *        makes the image concurrent between them.
+     */
+    Image(
+        const Device& device,
+        VkFormat format,
+        VkExtent2D extent,
+        uint32_t mip_levels,
+        VkImageUsageFlags usage,
+        std::span<const uint32_t> queue_families = {});
+    ~Image();
+
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
+    Image(Image&& other) noexcept;
+    Image& operator=(Image&& other) noexcept;
+
+    VkImage Handle() const;
+    VkFormat Format() const;
+    VkExtent2D Extent() const;
+    uint32_t MipLevels() const;
+    /**
+     * @brief Bytes of device memory backing the image, including the driver's padding.
+     */
+    VkDeviceSize MemorySize() const;
+    bool Valid() const;
+
+private:
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkImage image_ = VK_NULL_HANDLE;
+    VkDeviceMemory memory_ = VK_NULL_HANDLE;
+    VkFormat format_ = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent_ {};
+    uint32_t mip_levels_ = 0;
+    VkDeviceSize memory_size_ = 0;
+
+    void Release();
+};
+}  // namespace ZKT
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+#include <vulkan/vulkan.h>
+
+namespace ZKT
+{
+/**
+ * @brief Resolves a compiled shader name (e.g. "gpu_cull.comp.spv") against the build's shader directory.
+ */
+std::filesystem::path ShaderPath(std::string_view name);
+
+/**
+ * @brief Loads a SPIR-V file into a shader module; throws if the file is missing or invalid.
+ */
+VkShaderModule LoadShaderModule(VkDevice device, const std::filesystem::path& path);
+}  // namespace ZKT
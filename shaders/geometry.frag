@@ -0,0 +1,45 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+
+// Fixed directional light until the deferred lighting pass exists. The ZKT_VIRTUAL_TEXTURES
+// build takes albedo from the instance's virtual texture and reports the pages it wanted;
+// until the texture's tail page is resident (or without a texture) albedo stays flat.
+
+#ifdef ZKT_VIRTUAL_TEXTURES
+#define ZKT_VT_SET 1
+#include "virtual_texture.glsl"
+#endif
+
+layout(location = 0) in vec3 in_normal;
+layout(location = 1) in vec2 in_uv;
+layout(location = 2) flat in uint in_virtual_texture;
+
+layout(location = 0) out vec4 out_color;
+
+const vec3 kLightDirection = vec3(0.4, 0.8, 0.45);  // towards the light
+const vec3 kAlbedo = vec3(0.7);
+const float kAmbient = 0.15;
+const uint kNoVirtualTexture = 0xFFFFFFFFu;
+
+void main()
+{
+    vec3 albedo = kAlbedo;
+#ifdef ZKT_VIRTUAL_TEXTURES
+    // Derivatives are taken before the branch; the id is flat, so whole quads take it together.
+    vec2 dx = dFdx(in_uv);
+    vec2 dy = dFdy(in_uv);
+    if (in_virtual_texture != kNoVirtualTexture)
+    {
+        VtWriteFeedback(uvec2(gl_FragCoord.xy), VtPageRequest(in_virtual_texture, in_uv, dx, dy));
+        vec4 texel = VtSampleGrad(in_virtual_texture, in_uv, dx, dy);
+        if (texel.a > 0.0)
+        {
+            albedo = texel.rgb;
+        }
+    }
+#endif
+
+    vec3 n = normalize(in_normal);
+    float diffuse = max(dot(n, normalize(kLightDirection)), 0.0);
+    out_color = vec4(albedo * (kAmbient + diffuse), 1.0);
+}
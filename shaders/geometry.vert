@@ -0,0 +1,61 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+
+// Opaque geometry pass, built once per GeometryHeap vertex format (ZKT_VERTEX_FORMAT). Each
+// instance's model matrix comes from InstanceBuffer, indexed by gl_InstanceIndex, which
+// includes the draw's firstInstance; the instance's mesh id selects the VertexQuantization
+// packed positions are expanded with, and its virtual texture id the albedo geometry.frag
+// samples (all ones for none). view_projection uses GL clip conventions; Y is flipped
+// and depth remapped to Vulkan's [0, 1] here.
+
+#include "vertex_packing.glsl"
+
+struct Quantization
+{
+    vec4 offset;  // xyz
+    vec4 scale;   // xyz
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Instances
+{
+    mat4 instances[];
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer InstanceMeshes
+{
+    uint instance_meshes[];
+};
+
+layout(std430, set = 0, binding = 2) readonly buffer Quantizations
+{
+    Quantization quantizations[];
+};
+
+layout(std430, set = 0, binding = 3) readonly buffer InstanceTextures
+{
+    uint instance_textures[];
+};
+
+layout(push_constant) uniform GeometryPushConstants
+{
+    mat4 view_projection;
+} push;
+
+layout(location = 0) out vec3 out_normal;
+layout(location = 1) out vec2 out_uv;
+layout(location = 2) flat out uint out_virtual_texture;
+
+void main()
+{
+    mat4 model = instances[gl_InstanceIndex];
+    Quantization quantization = quantizations[instance_meshes[gl_InstanceIndex]];
+    vec3 position = VertexPosition(quantization.offset.xyz, quantization.scale.xyz);
+
+    vec4 clip = push.view_projection * (model * vec4(position, 1.0));
+    clip.y = -clip.y;
+    clip.z = 0.5 * (clip.z + clip.w);
+    gl_Position = clip;
+    out_normal = mat3(model) * VertexNormal();
+    out_uv = VertexUv();
+    out_virtual_texture = instance_textures[gl_InstanceIndex];
+}
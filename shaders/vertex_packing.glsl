@@ -0,0 +1,60 @@
+// Vertex attribute decode for the layouts in PackedMesh.h. Include from a vertex shader and
+// define ZKT_VERTEX_FORMAT first: 0 = Float32, 1 = Packed20, 2 = Packed16.
+//
+// Packed positions arrive as unorm16 in [0, 1] and are expanded with the mesh's
+// VertexQuantization (position = offset + unorm * scale). Normals and tangents use the
+// octahedral mapping written by OctEncode in PackedMesh.cpp; UVs are half floats and need no
+// decode because the vertex input converts R16G16_SFLOAT to float.
+
+#ifndef ZKT_VERTEX_PACKING_GLSL
+#define ZKT_VERTEX_PACKING_GLSL
+
+#ifndef ZKT_VERTEX_FORMAT
+#define ZKT_VERTEX_FORMAT 0
+#endif
+
+vec3 OctDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+vec3 DecodePosition(vec4 quantized, vec3 offset, vec3 scale)
+{
+    return offset + quantized.xyz * scale;
+}
+
+#if ZKT_VERTEX_FORMAT == 0
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_normal;
+layout(location = 2) in vec2 in_uv;
+layout(location = 3) in vec3 in_tangent;
+
+vec3 VertexPosition(vec3 offset, vec3 scale) { return in_position; }
+vec3 VertexNormal() { return in_normal; }
+vec3 VertexTangent() { return in_tangent; }
+#elif ZKT_VERTEX_FORMAT == 1
+layout(location = 0) in vec4 in_position;
+layout(location = 1) in vec2 in_normal;
+layout(location = 2) in vec2 in_uv;
+layout(location = 3) in vec2 in_tangent;
+
+vec3 VertexPosition(vec3 offset, vec3 scale) { return DecodePosition(in_position, offset, scale); }
+vec3 VertexNormal() { return OctDecode(in_normal); }
+vec3 VertexTangent() { return OctDecode(in_tangent); }
+#else
+layout(location = 0) in vec4 in_position;
+layout(location = 1) in vec4 in_normal_tangent;
+layout(location = 2) in vec2 in_uv;
+
+vec3 VertexPosition(vec3 offset, vec3 scale) { return DecodePosition(in_position, offset, scale); }
+vec3 VertexNormal() { return OctDecode(in_normal_tangent.xy); }
+vec3 VertexTangent() { return OctDecode(in_normal_tangent.zw); }
+#endif
+
+vec2 VertexUv() { return in_uv; }
+
+#endif  // ZKT_VERTEX_PACKING_GLSL
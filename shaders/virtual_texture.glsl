@@ -0,0 +1,127 @@
+// Virtual texture lookup and feedback for VirtualTextureAtlas. Include from a fragment or
+// compute shader and define ZKT_VT_SET first (default 1) to the set the atlas'
+// DescriptorSet is bound to; constants and layouts mirror VirtualTexture.h.
+//
+// A virtual texture is a mip chain of 128x128 pages. Its record (VtTexture) locates one page
+// table entry per page of every level; an entry names the atlas slot and level of the finest
+// resident page covering it, so sampling falls back to a coarser level while the requested
+// page streams in. Atlas slots hold pages with a 4-texel border, which keeps bilinear
+// filtering inside the slot. Shaders report what they wanted through VtWriteFeedback, which
+// writes one screen pixel per 8x8 cell per frame (the cell position rotates each frame) into
+// the low-resolution feedback buffer the CPU reads back.
+//
+//   uint request = VtPageRequest(texture, uv, dFdx(uv), dFdy(uv));
+//   VtWriteFeedback(uvec2(gl_FragCoord.xy), request);
+//   vec4 color = VtSampleGrad(texture, uv, dFdx(uv), dFdy(uv));
+
+#ifndef ZKT_VIRTUAL_TEXTURE_GLSL
+#define ZKT_VIRTUAL_TEXTURE_GLSL
+
+#ifndef ZKT_VT_SET
+#define ZKT_VT_SET 1
+#endif
+
+const uint kVtPageTexels = 128u;
+const uint kVtPageBorder = 4u;
+const uint kVtPagePadded = 136u;
+const uint kVtFeedbackScale = 8u;
+const uint kVtEntryResident = 0x80000000u;
+
+// GpuVirtualTexture
+struct VtTexture
+{
+    uint table_offset;
+    uint width;
+    uint height;
+    uint levels;
+    uint level_offset[12];
+};
+
+layout(set = ZKT_VT_SET, binding = 0) uniform sampler2D vt_atlas;
+layout(std430, set = ZKT_VT_SET, binding = 1) readonly buffer VtPageTable { uint vt_entries[]; };
+layout(std430, set = ZKT_VT_SET, binding = 2) readonly buffer VtTextures { VtTexture vt_textures[]; };
+layout(std430, set = ZKT_VT_SET, binding = 3) writeonly buffer VtFeedback { uint vt_feedback[]; };
+layout(std140, set = ZKT_VT_SET, binding = 4) uniform VtParams
+{
+    uvec2 feedback_size;
+    uvec2 feedback_jitter;
+    float atlas_size;
+    float lod_bias;
+} vt_params;
+
+uvec2 VtLevelExtent(VtTexture t, uint level)
+{
+    return max(uvec2(t.width, t.height) >> level, uvec2(1u));
+}
+
+uvec2 VtPageCount(uvec2 extent)
+{
+    return (extent + kVtPageTexels - 1u) / kVtPageTexels;
+}
+
+// Page of level containing uv (in [0, 1)); the last page of a level also takes the texels
+// past it, as VirtualPageTable::Parent does.
+uvec2 VtPageAt(VtTexture t, uint level, vec2 uv)
+{
+    uvec2 extent = VtLevelExtent(t, level);
+    return min(uvec2(uv * vec2(extent)) / kVtPageTexels, VtPageCount(extent) - 1u);
+}
+
+uint VtLevel(VtTexture t, vec2 dx, vec2 dy)
+{
+    vec2 size = vec2(t.width, t.height);
+    float rho = max(length(dx * size), length(dy * size));
+    float lod = log2(max(rho, 1e-8)) + vt_params.lod_bias;
+    return uint(clamp(floor(lod + 0.5), 0.0, float(t.levels - 1u)));
+}
+
+// Packed as PackVirtualPage: x in bits 0-7, y in 8-15, level in 16-19, texture in 20-31.
+uint VtPageRequest(uint texture, vec2 uv, vec2 dx, vec2 dy)
+{
+    VtTexture t = vt_textures[texture];
+    uint level = VtLevel(t, dx, dy);
+    uvec2 page = VtPageAt(t, level, fract(uv));
+    return page.x | (page.y << 8) | (level << 16) | (texture << 20);
+}
+
+void VtWriteFeedback(uvec2 pixel, uint request)
+{
+    if (any(notEqual(pixel % kVtFeedbackScale, vt_params.feedback_jitter)))
+    {
+        return;
+    }
+    uvec2 texel = pixel / kVtFeedbackScale;
+    if (all(lessThan(texel, vt_params.feedback_size)))
+    {
+        vt_feedback[texel.y * vt_params.feedback_size.x + texel.x] = request;
+    }
+}
+
+// Repeats uv; edges are filtered according to the wrap flag the texture was added with.
+// Returns vec4(0) until the texture's tail page is resident.
+vec4 VtSampleGrad(uint texture, vec2 uv, vec2 dx, vec2 dy)
+{
+    VtTexture t = vt_textures[texture];
+    uint level = VtLevel(t, dx, dy);
+    uv = fract(uv);
+    uvec2 page = VtPageAt(t, level, uv);
+    uvec2 pages = VtPageCount(VtLevelExtent(t, level));
+    uint entry = vt_entries[t.table_offset + t.level_offset[level] + page.y * pages.x + page.x];
+    if ((entry & kVtEntryResident) == 0u)
+    {
+        return vec4(0.0);
+    }
+
+    // The resident ancestor is found the way the table was filled, by halving the page
+    // coordinates; at non-power-of-two edges uv may land up to a texel outside that page,
+    // which its border covers.
+    uint mapped = (entry >> 20) & 0xFu;
+    uvec2 mapped_extent = VtLevelExtent(t, mapped);
+    uvec2 mapped_page = min(page >> (mapped - level), VtPageCount(mapped_extent) - 1u);
+    vec2 in_page = uv * vec2(mapped_extent) - vec2(mapped_page * kVtPageTexels);
+    uvec2 slot = uvec2(entry & 0x3FFu, (entry >> 10) & 0x3FFu);
+    vec2 atlas_texel = vec2(slot * kVtPagePadded + kVtPageBorder) + in_page;
+    return textureLod(vt_atlas, atlas_texel / vt_params.atlas_size, 0.0);
+}
+
+#endif
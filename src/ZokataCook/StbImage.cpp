@@ -0,0 +1,8 @@
+// stb_image's implementation, compiled once for the cooker. Only the formats it accepts as
+// texture sources are built in.
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_TGA
+#define STBI_ONLY_BMP
+#include <stb_image.h>
@@ -0,0 +1,393 @@
+#include "ZokataEngine/systems/asset/ContentHash.h"
+#include "ZokataEngine/systems/asset/CookCache.h"
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/scene/CookedScene.h"
+#include "ZokataEngine/systems/scene/SceneLoader.h"
+#include "ZokataEngine/systems/scene/SceneManager.h"
+#include "ZokataEngine/systems/texture/TextureCooker.h"
+#include "ZokataLog/Log.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+// Bump when the cooker's output changes without a cooked format version change.
+constexpr uint64_t kCookerRevision = 2;
+constexpr const char* kCacheFolder = ".zkcache";
+
+enum class CookResult
+{
+    UpToDate,
+    Restored,
+    Cooked,
+    Failed
+};
+
+/**
+ * @brief Seed of every cook key: anything besides source content that changes the output.
+ */
+uint64_t CookSeed()
+{
+    ZKT::ENGINE::ContentHasher hasher;
+    hasher.Add("zkscene")
+        .Add(ZKT::ENGINE::COOKED::kVersion)
+        .Add(kCookerRevision)
+        .Add(sizeof(ZKT::MeshVertex));
+    return hasher.Finish();
+}
+
+/**
+ * @brief Seed of a texture's cook key; the settings come from its name, so they are part of it.
+ */
+uint64_t TextureSeed(const ZKT::ENGINE::TextureCookSettings& settings)
+{
+    ZKT::ENGINE::ContentHasher hasher;
+    hasher.Add("ktx2")
+        .Add(kCookerRevision)
+        .Add(static_cast<uint32_t>(settings.format))
+        .Add(settings.srgb)
+        .Add(settings.normal_map)
+        .Add(settings.mipmaps)
+        .Add(settings.wrap);
+    return hasher.Finish();
+}
+
+std::string FormatRatio(float value)
+{
+    char digits[32];
+    const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 3);
+    return std::string(digits, end);
+}
+
+/**
+ * @brief One line per imported mesh: what welding and cache/fetch ordering did to it.
+ */
+void LogMeshReports(std::span<const ZKT::ENGINE::SceneMeshReport> reports)
+{
+    for (const ZKT::ENGINE::SceneMeshReport& report : reports)
+    {
+        const ZKT::ENGINE::MeshOptimizeReport& optimization = report.optimization;
+        ZLOG_INFO(
+            "  " + report.file.filename().string() + " '" + report.mesh + "': " + std::to_string(optimization.triangles) +
+            " triangles, vertices " + std::to_string(optimization.vertices_before) + " -> " +
+            std::to_string(optimization.vertices_after) + ", ACMR " + FormatRatio(optimization.before.acmr) + " -> " +
+            FormatRatio(optimization.after.acmr) + ", ATVR " + FormatRatio(optimization.before.atvr) + " -> " +
+            FormatRatio(optimization.after.atvr));
+    }
+}
+
+bool IsSceneFile(const fs::path& path)
+{
+    const auto extension = path.extension();
+    return extension == ".yaml" || extension == ".yml";
+}
+
+bool IsTextureFile(const fs::path& path)
+{
+    std::string extension = path.extension().string();
+    std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+}
+
+/**
+ * @brief Material slot a texture is cooked for, from its name suffix ("brick_n.png" is a
+ *        normal map); anything unrecognised is albedo.
+ */
+ZKT::TextureSlot TextureSlotFromName(const fs::path& path)
+{
+    struct Suffix
+    {
+        std::string_view suffix;
+        ZKT::TextureSlot slot;
+    };
+    static constexpr Suffix kSuffixes[] = {
+        {"_n", ZKT::TextureSlot::Normal},
+        {"_nrm", ZKT::TextureSlot::Normal},
+        {"_normal", ZKT::TextureSlot::Normal},
+        {"_orm", ZKT::TextureSlot::MetallicRoughness},
+        {"_mr", ZKT::TextureSlot::MetallicRoughness},
+        {"_metal", ZKT::TextureSlot::MetallicRoughness},
+        {"_metallic", ZKT::TextureSlot::MetallicRoughness},
+        {"_rough", ZKT::TextureSlot::MetallicRoughness},
+        {"_roughness", ZKT::TextureSlot::MetallicRoughness},
+        {"_ao", ZKT::TextureSlot::Occlusion},
+        {"_occlusion", ZKT::TextureSlot::Occlusion},
+        {"_e", ZKT::TextureSlot::Emissive},
+        {"_emissive", ZKT::TextureSlot::Emissive},
+    };
+    std::string stem = path.stem().string();
+    std::ranges::transform(stem, stem.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (const Suffix& entry : kSuffixes)
+    {
+        if (stem.ends_with(entry.suffix))
+        {
+            return entry.slot;
+        }
+    }
+    return ZKT::TextureSlot::Albedo;
+}
+
+void CollectInputs(const fs::path& path, std::vector<fs::path>& scenes, std::vector<fs::path>& textures)
+{
+    if (fs::is_directory(path))
+    {
+        for (const auto& entry : fs::recursive_directory_iterator(path))
+        {
+            if (entry.is_regular_file() && IsSceneFile(entry.path()))
+            {
+                scenes.push_back(entry.path());
+            }
+            else if (entry.is_regular_file() && IsTextureFile(entry.path()))
+            {
+                textures.push_back(entry.path());
+            }
+        }
+    }
+    else if (IsSceneFile(path))
+    {
+        scenes.push_back(path);
+    }
+    else if (IsTextureFile(path))
+    {
+        textures.push_back(path);
+    }
+    else
+    {
+        ZLOG_WARN("Skipping '" + path.string() + "': not a scene, texture or directory.");
+    }
+}
+
+/**
+ * @brief Brings one cooked scene up to date: nothing to do, a cache hit, or a full cook.
+ */
+CookResult CookSceneFile(const fs::path& scene_path, ZKT::ENGINE::CookCache& cache, uint64_t seed)
+{
+    const fs::path cooked_path = ZKT::ENGINE::CookedScenePath(scene_path);
+    try
+    {
+        // The sources of the previous cook predict the key. Editing the scene changes its own
+        // hash, so a scene that starts referencing new meshes never matches a stale entry.
+        if (const auto sources = cache.RecordedSources(cooked_path))
+        {
+            try
+            {
+                const uint64_t key = cache.ComputeKey(seed, *sources);
+                if (cache.RecordedKey(cooked_path) == key && fs::exists(cooked_path))
+                {
+                    return CookResult::UpToDate;
+                }
+                if (cache.Restore(key, cooked_path, *sources))
+                {
+                    return CookResult::Restored;
+                }
+            }
+            catch (const std::exception&)
+            {
+                // A recorded source disappeared; cook from scratch to find the current ones.
+            }
+        }
+
+        ZKT::ENGINE::SceneLoader loader;
+        auto scene = loader.LoadFromFile(scene_path);
+        ZKT::ENGINE::CookScene(*scene, loader.Dependencies(), cooked_path);
+        cache.Store(cache.ComputeKey(seed, loader.Dependencies()), cooked_path, loader.Dependencies());
+        ZLOG_INFO(
+            "Cooked " + cooked_path.filename().string() + ": " + std::to_string(scene->Entities().size()) +
+            " entities, " + std::to_string(fs::file_size(cooked_path)) + " bytes");
+        LogMeshReports(loader.MeshReports());
+        return CookResult::Cooked;
+    }
+    catch (const std::exception& e)
+    {
+        ZLOG_ERROR("Failed to cook '" + scene_path.string() + "': " + e.what());
+        return CookResult::Failed;
+    }
+}
+
+/**
+ * @brief Same for a texture: decodes the image and writes mip-mapped, block-compressed KTX2
+ *        beside it ("wall.png" -> "wall.ktx2").
+ */
+CookResult CookTextureFile(
+    const fs::path& image_path, ZKT::ENGINE::CookCache& cache, const ZKT::ENGINE::TextureCookSettings& settings)
+{
+    const fs::path cooked_path = fs::path(image_path).replace_extension(".ktx2");
+    try
+    {
+        const std::vector<fs::path> sources {image_path};
+        const uint64_t key = cache.ComputeKey(TextureSeed(settings), sources);
+        if (cache.RecordedKey(cooked_path) == key && fs::exists(cooked_path))
+        {
+            return CookResult::UpToDate;
+        }
+        if (cache.Restore(key, cooked_path, sources))
+        {
+            return CookResult::Restored;
+        }
+
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        const std::unique_ptr<stbi_uc, void (*)(void*)> pixels(
+            stbi_load(image_path.string().c_str(), &width, &height, &channels, 4), stbi_image_free);
+        if (pixels == nullptr)
+        {
+            throw std::runtime_error(std::string("cannot decode image: ") + stbi_failure_reason());
+        }
+
+        ZKT::ENGINE::TextureCooker cooker(ZKT::ENGINE::JobSystem::Default());
+        const std::vector<uint8_t> cooked = cooker.Cook(
+            std::span<const uint8_t>(pixels.get(), static_cast<size_t>(width) * static_cast<size_t>(height) * 4),
+            static_cast<uint32_t>(width),
+            static_cast<uint32_t>(height),
+            settings);
+
+        // Readers never see a partially written file: write beside it, then swap it in.
+        fs::path temp_path = cooked_path;
+        temp_path += ".tmp";
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(cooked.data()), static_cast<std::streamsize>(cooked.size()));
+            if (!out)
+            {
+                throw std::runtime_error("Failed to write " + temp_path.string());
+            }
+        }
+        fs::rename(temp_path, cooked_path);
+        cache.Store(key, cooked_path, sources);
+
+        const ZKT::ENGINE::TextureCookStats& stats = cooker.Stats();
+        ZLOG_INFO(
+            "Cooked " + cooked_path.filename().string() + ": " + std::to_string(width) + "x" + std::to_string(height) +
+            " " + ZKT::TextureFormatName(settings.format) + ", " + std::to_string(stats.levels) + " levels, " +
+            std::to_string(cooked.size()) + " bytes (mips " + std::to_string(static_cast<int>(stats.mip_ms)) +
+            " ms, compression " + std::to_string(static_cast<int>(stats.compress_ms)) + " ms)");
+        return CookResult::Cooked;
+    }
+    catch (const std::exception& e)
+    {
+        ZLOG_ERROR("Failed to cook '" + image_path.string() + "': " + e.what());
+        return CookResult::Failed;
+    }
+}
+}  // namespace
+
+/**
+ * Usage: zokata-cook [--cache <dir>] [--texture-format rgba8|bc1|bc3|bc5|bc7]
+ *                    [scene.yaml | image | directory]...
+ * Without arguments, cooks every scene under the project's scenes folder. Images (.png, .jpg,
+ * .tga, .bmp) cook to .ktx2 with settings chosen by name suffix; --texture-format overrides the
+ * format of everything but normal maps. Stale outputs cook in parallel; results are cached by
+ * content hash in <project>/.zkcache by default.
+ */
+int main(int argc, char** argv)
+{
+    using Clock = std::chrono::steady_clock;
+    try
+    {
+        const auto start = Clock::now();
+        std::vector<fs::path> scenes;
+        std::vector<fs::path> textures;
+        fs::path cache_dir;
+        std::optional<ZKT::TextureFormat> texture_format;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::string_view(argv[i]) == "--cache" && i + 1 < argc)
+            {
+                cache_dir = argv[++i];
+                continue;
+            }
+            if (std::string_view(argv[i]) == "--texture-format" && i + 1 < argc)
+            {
+                ZKT::TextureFormat format {};
+                if (!ZKT::ParseTextureFormat(argv[++i], format))
+                {
+                    ZLOG_ERROR(std::string("Unknown texture format '") + argv[i] + "'.");
+                    return EXIT_FAILURE;
+                }
+                texture_format = format;
+                continue;
+            }
+            CollectInputs(fs::path(argv[i]), scenes, textures);
+        }
+        if (scenes.empty() && textures.empty())
+        {
+            const fs::path scenes_root = ZKT::ENGINE::SceneManager::FindScenesRoot(fs::current_path());
+            if (scenes_root.empty())
+            {
+                ZLOG_ERROR("No scenes given and no scenes folder found.");
+                return EXIT_FAILURE;
+            }
+            CollectInputs(scenes_root, scenes, textures);
+            if (cache_dir.empty())
+            {
+                cache_dir = scenes_root.parent_path() / kCacheFolder;
+            }
+        }
+        if (cache_dir.empty())
+        {
+            cache_dir = fs::current_path() / kCacheFolder;
+        }
+
+        ZKT::ENGINE::CookCache cache(cache_dir);
+        const uint64_t seed = CookSeed();
+        std::vector<ZKT::ENGINE::TextureCookSettings> texture_settings;
+        texture_settings.reserve(textures.size());
+        for (const fs::path& texture : textures)
+        {
+            ZKT::ENGINE::TextureCookSettings settings = ZKT::ENGINE::DefaultCookSettings(TextureSlotFromName(texture));
+            if (texture_format && !settings.normal_map)
+            {
+                settings.format = *texture_format;
+            }
+            texture_settings.push_back(settings);
+        }
+
+        // Textures first: they take longest, and each one also spreads its blocks over the pool.
+        std::vector<CookResult> results(textures.size() + scenes.size(), CookResult::Failed);
+        ZKT::ENGINE::JobSystem::Default().ParallelFor(results.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                results[i] = i < textures.size() ? CookTextureFile(textures[i], cache, texture_settings[i])
+                                                 : CookSceneFile(scenes[i - textures.size()], cache, seed);
+            }
+        });
+        cache.Save();
+
+        size_t counts[4] = {};
+        for (const CookResult result : results)
+        {
+            ++counts[static_cast<size_t>(result)];
+        }
+        const auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        ZLOG_INFO(
+            std::to_string(scenes.size()) + " scene(s), " + std::to_string(textures.size()) + " texture(s): " + std::to_string(counts[0]) + " up to date, " +
+            std::to_string(counts[1]) + " restored from cache, " + std::to_string(counts[2]) + " cooked, " +
+            std::to_string(counts[3]) + " failed in " + std::to_string(static_cast<int>(elapsed)) + " ms");
+        return counts[3] == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        ZLOG_ERROR(std::string("Unhandled exception: ") + e.what());
+        return EXIT_FAILURE;
+    }
+}
@@ -9,8 +9,11 @@
 
 #include "ZokataLog/Log.h"
 #include "ZokataRenderer/Application.h"
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/scene/Entity.h"
 #include "ZokataEngine/systems/scene/SceneManager.h"
 #include "ZokataEngine/systems/scene/Scene.h"
+#include "ZokataEngine/systems/scene/components/CameraComponent.h"
 #include "ZokataEngine/systems/scene/components/TransformComponent.h"
 
 namespace fs = std::filesystem;
@@ -43,27 +46,93 @@ std::filesystem::path FindScenesRoot()
     return {};
 }
 
+const CameraComponent* FindMainCamera(Scene& scene)
+{
+    for (auto& root : scene.RuntimeRoots())
+    {
+        if (auto* camera = root->GetComponentInChildren<CameraComponent>(true))
+        {
+            if (camera->Enabled())
+            {
+                return camera;
+            }
+        }
+    }
+    return nullptr;
+}
 }  // namespace
 
 Engine::Engine()
     : scenes_root_(FindScenesRoot())
+    , assets_(JobSystem::Default())
+    , animation_(JobSystem::Default())
+    , visibility_(JobSystem::Default())
+    , terrain_(JobSystem::Default())
+    , material_textures_(assets_, JobSystem::Default())
 {
 }
 
 void Engine::Run()
 {
-    // Let SceneManager discover YAML scenes and load them.
+    // Let SceneManager discover YAML scenes and load them; meshes stream in afterwards.
+    scene_manager_.SetAssetManager(&assets_);
     scene_manager_.DiscoverAndLoadScenes(scenes_root_);
+    scene_manager_.EnableHotReload();
 
     // Provide a GUI callback to render scene hierarchy.
     ZKT::Application app;
-    app.SetGuiCallback([this]() { DrawSceneHierarchyGui(); });
+    material_textures_.SetRenderer(&app.Renderer());
+    app.SetGuiCallback([this, &app]() {
+        DrawSceneHierarchyGui();
+        animation_.DrawDebugGui();
+        visibility_.DrawDebugGui();
+        terrain_.DrawDebugGui();
+        material_textures_.DrawDebugGui();
+        assets_.DrawDebugGui();
+        app.Uploads().DrawDebugGui();
+    });
+    app.SetUpdateCallback([this, &app](float delta_seconds) {
+        const VkExtent2D extent = app.FramebufferExtent();
+        if (extent.height > 0)
+        {
+            visibility_.Lod().Settings().viewport_height = static_cast<float>(extent.height);
+        }
+        Update(delta_seconds);
+    });
+    app.SetDrawList(&visibility_.Draws());
 
     // Kick lifecycle for active scene before entering the main app loop.
     scene_manager_.OnEnableActive();
     scene_manager_.StartActive();
 
     app.Run();
+    // The streamer and atlas go with the application.
+    material_textures_.SetRenderer(nullptr);
+}
+
+void Engine::Update(float delta_seconds)
+{
+    scene_manager_.PollHotReload();
+    assets_.Update();
+    scene_manager_.UpdateActive(delta_seconds);
+    visibility_.Lod().UpdateBudget(delta_seconds);
+
+    Scene* scene = scene_manager_.ActiveScene();
+    if (scene != nullptr)
+    {
+        animation_.Update(*scene);
+    }
+    const CameraComponent* camera = scene != nullptr ? FindMainCamera(*scene) : nullptr;
+    if (camera == nullptr)
+    {
+        terrain_.Reset();
+        visibility_.Reset();
+        return;
+    }
+    terrain_.Update(*scene, camera->Owner()->Transform().WorldPosition());
+    visibility_.SetExternalDraws(terrain_.Draws());
+    visibility_.Run(*scene, *camera);
+    material_textures_.Update(visibility_.Draws());
 }
 
 void Engine::DrawSceneHierarchyGui()
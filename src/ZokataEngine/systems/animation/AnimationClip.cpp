@@ -0,0 +1,434 @@
+#include "ZokataEngine/systems/animation/AnimationClip.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint32_t kMaxFrames = 0xFFFF;
+constexpr uint32_t kMaxKeySpan = 256;  // bounds the reduction cost; longer holds just add a key
+constexpr float kUnorm16Max = 65535.0F;
+constexpr float kSmallestThreeMax = 32767.0F;
+constexpr float kInverseSqrt2 = 0.70710678F;
+
+using Value = std::array<float, 4>;  // xyz for vectors, xyzw for rotations
+
+Value FromVec3(const MATH::Vec3f& v)
+{
+    return Value{v.x, v.y, v.z, 0.0F};
+}
+
+Value FromQuaternion(const MATH::Quaternion& q)
+{
+    const glm::quat& value = q.ToGlm();
+    return Value{value.x, value.y, value.z, value.w};
+}
+
+float Dot4(const Value& a, const Value& b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+}
+
+Value Normalize4(const Value& q)
+{
+    const float length = std::sqrt(Dot4(q, q));
+    if (length <= 0.0F)
+    {
+        return Value{0.0F, 0.0F, 0.0F, 1.0F};
+    }
+    return Value{q[0] / length, q[1] / length, q[2] / length, q[3] / length};
+}
+
+Value Lerp(const Value& a, const Value& b, float t)
+{
+    return Value{a[0] + (b[0] - a[0]) * t, a[1] + (b[1] - a[1]) * t, a[2] + (b[2] - a[2]) * t, a[3] + (b[3] - a[3]) * t};
+}
+
+// Matches the runtime rotation interpolation in BlendPoses.
+Value Nlerp(const Value& a, Value b, float t)
+{
+    if (Dot4(a, b) < 0.0F)
+    {
+        b = Value{-b[0], -b[1], -b[2], -b[3]};
+    }
+    return Normalize4(Lerp(a, b, t));
+}
+
+Value Slerp(const Value& a, Value b, float t)
+{
+    float cosine = Dot4(a, b);
+    if (cosine < 0.0F)
+    {
+        b = Value{-b[0], -b[1], -b[2], -b[3]};
+        cosine = -cosine;
+    }
+    if (cosine > 0.9995F)
+    {
+        return Normalize4(Lerp(a, b, t));
+    }
+    const float angle = std::acos(cosine);
+    const float inverse_sine = 1.0F / std::sin(angle);
+    const float wa = std::sin((1.0F - t) * angle) * inverse_sine;
+    const float wb = std::sin(t * angle) * inverse_sine;
+    return Value{a[0] * wa + b[0] * wb, a[1] * wa + b[1] * wb, a[2] * wa + b[2] * wb, a[3] * wa + b[3] * wb};
+}
+
+// Raw keys are sorted by time; sampling outside the keyed range holds the end keys.
+template <typename Key, typename Convert, typename Interpolate>
+Value SampleRaw(const std::vector<Key>& keys, float time, Convert convert, Interpolate interpolate)
+{
+    const auto next = std::upper_bound(
+        keys.begin(), keys.end(), time, [](float t, const Key& key) { return t < key.time; });
+    if (next == keys.begin())
+    {
+        return convert(keys.front().value);
+    }
+    if (next == keys.end())
+    {
+        return convert(keys.back().value);
+    }
+    const Key& previous = *(next - 1);
+    const float span = next->time - previous.time;
+    const float t = span > 0.0F ? (time - previous.time) / span : 0.0F;
+    return interpolate(convert(previous.value), convert(next->value), t);
+}
+
+std::array<uint16_t, 3> EncodeRotation(Value q)
+{
+    uint32_t largest = 0;
+    for (uint32_t c = 1; c < 4; ++c)
+    {
+        if (std::abs(q[c]) > std::abs(q[largest]))
+        {
+            largest = c;
+        }
+    }
+    if (q[largest] < 0.0F)
+    {
+        q = Value{-q[0], -q[1], -q[2], -q[3]};
+    }
+
+    std::array<uint16_t, 3> encoded {};
+    uint32_t slot = 0;
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        if (c == largest)
+        {
+            continue;
+        }
+        const float unit = std::clamp(q[c] / kInverseSqrt2 * 0.5F + 0.5F, 0.0F, 1.0F);
+        encoded[slot++] = static_cast<uint16_t>(std::lrint(unit * kSmallestThreeMax) << 1);
+    }
+    encoded[0] |= static_cast<uint16_t>(largest & 1U);
+    encoded[1] |= static_cast<uint16_t>((largest >> 1) & 1U);
+    return encoded;
+}
+
+Value DecodeRotation(const uint16_t* encoded)
+{
+    const uint32_t largest = (encoded[0] & 1U) | ((encoded[1] & 1U) << 1);
+    Value q {};
+    float sum = 0.0F;
+    uint32_t slot = 0;
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        if (c == largest)
+        {
+            continue;
+        }
+        const float unit = static_cast<float>(encoded[slot++] >> 1) / kSmallestThreeMax;
+        q[c] = (unit * 2.0F - 1.0F) * kInverseSqrt2;
+        sum += q[c] * q[c];
+    }
+    q[largest] = std::sqrt(std::max(0.0F, 1.0F - sum));
+    return q;
+}
+
+float DequantizeUnorm16(uint16_t value, float offset, float extent)
+{
+    return offset + static_cast<float>(value) / kUnorm16Max * extent;
+}
+
+// Greedy key reduction: from each kept key, extend to the farthest frame whose interpolation
+// reproduces every frame in between within tolerance.
+template <typename Interpolate, typename Fits>
+std::vector<uint32_t> ReduceKeys(
+    const std::vector<Value>& original, const std::vector<Value>& decoded, Interpolate interpolate, Fits fits)
+{
+    const auto frame_count = static_cast<uint32_t>(decoded.size());
+    std::vector<uint32_t> kept {0};
+
+    bool constant = true;
+    for (uint32_t f = 1; f < frame_count && constant; ++f)
+    {
+        constant = fits(decoded[0], original[f]);
+    }
+    if (constant)
+    {
+        return kept;
+    }
+
+    uint32_t start = 0;
+    while (start + 1 < frame_count)
+    {
+        uint32_t end = start + 1;
+        while (end + 1 < frame_count && end + 1 - start <= kMaxKeySpan)
+        {
+            const uint32_t candidate = end + 1;
+            bool ok = true;
+            for (uint32_t f = start + 1; f < candidate && ok; ++f)
+            {
+                const float t = static_cast<float>(f - start) / static_cast<float>(candidate - start);
+                ok = fits(interpolate(decoded[start], decoded[candidate], t), original[f]);
+            }
+            if (!ok)
+            {
+                break;
+            }
+            end = candidate;
+        }
+        kept.push_back(end);
+        start = end;
+    }
+    return kept;
+}
+}  // namespace
+
+AnimationClip AnimationClip::Compress(
+    const RawAnimationClip& raw, const Skeleton& skeleton, const ClipCompressionSettings& settings)
+{
+    AnimationClip clip {};
+    clip.name_ = raw.name;
+    clip.duration_ = std::max(raw.duration, 0.0F);
+    clip.sample_rate_ = std::max(settings.sample_rate, 1.0F);
+    clip.frame_count_ = std::min<uint32_t>(
+        kMaxFrames, static_cast<uint32_t>(std::ceil(clip.duration_ * clip.sample_rate_)) + 1);
+    clip.joint_count_ = skeleton.JointCount();
+    clip.tracks_.resize(static_cast<size_t>(clip.joint_count_) * kTrackKinds);
+
+    const uint32_t frames = clip.frame_count_;
+    // Two unit quaternions differ by a rotation of at most tolerance when their 4D chord on the
+    // shared hemisphere is at most 2 sin(tolerance / 4); unlike a dot product against
+    // cos(tolerance / 2) this stays well-conditioned in float for small tolerances.
+    const float rotation_chord = 2.0F * std::sin(settings.rotation_tolerance * 0.25F);
+    std::vector<Value> original(frames);
+    std::vector<Value> decoded(frames);
+    std::vector<std::array<uint16_t, 3>> quantized(frames);
+
+    const auto frame_time = [&](uint32_t f) { return std::min(static_cast<float>(f) / clip.sample_rate_, clip.duration_); };
+
+    for (uint32_t joint = 0; joint < clip.joint_count_; ++joint)
+    {
+        const JointTransform& bind = skeleton.GetJoint(joint).bind;
+        const JointTrack* source = joint < raw.tracks.size() ? &raw.tracks[joint] : nullptr;
+
+        for (uint32_t kind = 0; kind < kTrackKinds; ++kind)
+        {
+            Track& track = clip.tracks_[static_cast<size_t>(joint) * kTrackKinds + kind];
+
+            // Resample the source channel on the fixed frame grid.
+            for (uint32_t f = 0; f < frames; ++f)
+            {
+                const float time = frame_time(f);
+                if (kind == kTranslation)
+                {
+                    original[f] = source != nullptr && !source->translations.empty()
+                        ? SampleRaw(source->translations, time, FromVec3, Lerp)
+                        : FromVec3(bind.translation);
+                }
+                else if (kind == kRotation)
+                {
+                    original[f] = source != nullptr && !source->rotations.empty()
+                        ? SampleRaw(source->rotations, time, FromQuaternion, Slerp)
+                        : FromQuaternion(bind.rotation);
+                    original[f] = Normalize4(original[f]);
+                }
+                else
+                {
+                    original[f] = source != nullptr && !source->scales.empty()
+                        ? SampleRaw(source->scales, time, FromVec3, Lerp)
+                        : FromVec3(bind.scale);
+                }
+            }
+
+            // Quantize every frame, then reduce against the dequantized values so the
+            // tolerance covers quantization error as well.
+            if (kind == kRotation)
+            {
+                for (uint32_t f = 0; f < frames; ++f)
+                {
+                    quantized[f] = EncodeRotation(original[f]);
+                    decoded[f] = DecodeRotation(quantized[f].data());
+                }
+            }
+            else
+            {
+                Value low = original[0];
+                Value high = original[0];
+                for (const Value& value : original)
+                {
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        low[c] = std::min(low[c], value[c]);
+                        high[c] = std::max(high[c], value[c]);
+                    }
+                }
+                track.offset = MATH::Vec3f{low[0], low[1], low[2]};
+                track.extent = MATH::Vec3f{high[0] - low[0], high[1] - low[1], high[2] - low[2]};
+                const float extent[3] = {track.extent.x, track.extent.y, track.extent.z};
+                for (uint32_t f = 0; f < frames; ++f)
+                {
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        const float unit = extent[c] > 0.0F ? (original[f][c] - low[c]) / extent[c] : 0.0F;
+                        quantized[f][c] = static_cast<uint16_t>(std::lrint(std::clamp(unit, 0.0F, 1.0F) * kUnorm16Max));
+                        decoded[f][c] = DequantizeUnorm16(quantized[f][c], low[c], extent[c]);
+                    }
+                    decoded[f][3] = 0.0F;
+                }
+            }
+
+            std::vector<uint32_t> kept;
+            if (kind == kRotation)
+            {
+                kept = ReduceKeys(original, decoded, Nlerp, [rotation_chord](const Value& a, const Value& b) {
+                    const float sign = Dot4(a, b) < 0.0F ? -1.0F : 1.0F;
+                    float chord = 0.0F;
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        const float d = a[c] - sign * b[c];
+                        chord += d * d;
+                    }
+                    return std::sqrt(chord) <= rotation_chord;
+                });
+            }
+            else
+            {
+                const float tolerance = kind == kTranslation ? settings.translation_tolerance : settings.scale_tolerance;
+                kept = ReduceKeys(original, decoded, Lerp, [tolerance](const Value& a, const Value& b) {
+                    return std::abs(a[0] - b[0]) <= tolerance && std::abs(a[1] - b[1]) <= tolerance
+                        && std::abs(a[2] - b[2]) <= tolerance;
+                });
+            }
+
+            track.first_key = static_cast<uint32_t>(clip.frames_.size());
+            track.key_count = static_cast<uint32_t>(kept.size());
+            for (const uint32_t frame : kept)
+            {
+                clip.frames_.push_back(static_cast<uint16_t>(frame));
+                clip.values_.insert(clip.values_.end(), quantized[frame].begin(), quantized[frame].end());
+            }
+        }
+    }
+    return clip;
+}
+
+const std::string& AnimationClip::Name() const
+{
+    return name_;
+}
+
+float AnimationClip::Duration() const
+{
+    return duration_;
+}
+
+uint32_t AnimationClip::JointCount() const
+{
+    return joint_count_;
+}
+
+size_t AnimationClip::KeyCount() const
+{
+    return frames_.size();
+}
+
+size_t AnimationClip::ByteSize() const
+{
+    return frames_.size() * sizeof(uint16_t) + values_.size() * sizeof(uint16_t) + tracks_.size() * sizeof(Track);
+}
+
+size_t AnimationClip::UncompressedByteSize() const
+{
+    return static_cast<size_t>(frame_count_) * joint_count_ * static_cast<size_t>(PoseChannel::Count) * sizeof(float);
+}
+
+void AnimationClip::DecodeKey(TrackKind kind, const Track& track, uint32_t key, float* out) const
+{
+    const uint16_t* encoded = values_.data() + static_cast<size_t>(track.first_key + key) * 3;
+    if (kind == kRotation)
+    {
+        const Value q = DecodeRotation(encoded);
+        std::copy(q.begin(), q.end(), out);
+        return;
+    }
+    out[0] = DequantizeUnorm16(encoded[0], track.offset.x, track.extent.x);
+    out[1] = DequantizeUnorm16(encoded[1], track.offset.y, track.extent.y);
+    out[2] = DequantizeUnorm16(encoded[2], track.offset.z, track.extent.z);
+}
+
+void AnimationClip::Sample(float time, LocalPose& pose, ClipSampleScratch& scratch) const
+{
+    if (pose.JointCount() != joint_count_)
+    {
+        pose.Resize(joint_count_);
+    }
+    if (scratch.next.JointCount() != joint_count_)
+    {
+        scratch.next.Resize(joint_count_);
+    }
+    const uint32_t padded = pose.PaddedCount();
+    scratch.weights.assign(static_cast<size_t>(padded) * kTrackKinds, 0.0F);
+
+    const float frame = std::clamp(time, 0.0F, duration_) * sample_rate_;
+    constexpr PoseChannel kFirstChannel[kTrackKinds] = {
+        PoseChannel::TranslationX, PoseChannel::RotationX, PoseChannel::ScaleX};
+    constexpr uint32_t kComponents[kTrackKinds] = {3, 4, 3};
+
+    for (uint32_t joint = 0; joint < joint_count_; ++joint)
+    {
+        for (uint32_t kind = 0; kind < kTrackKinds; ++kind)
+        {
+            const Track& track = tracks_[static_cast<size_t>(joint) * kTrackKinds + kind];
+            const uint16_t* first = frames_.data() + track.first_key;
+            const uint16_t* last = first + track.key_count;
+            const auto next = static_cast<uint32_t>(
+                std::upper_bound(first, last, frame, [](float f, uint16_t key) { return f < static_cast<float>(key); })
+                - first);
+            const uint32_t a = next == 0 ? 0 : next - 1;
+            const uint32_t b = std::min(next, track.key_count - 1);
+
+            float from[4];
+            float to[4];
+            DecodeKey(static_cast<TrackKind>(kind), track, a, from);
+            DecodeKey(static_cast<TrackKind>(kind), track, b, to);
+            const auto base = static_cast<uint32_t>(kFirstChannel[kind]);
+            for (uint32_t c = 0; c < kComponents[kind]; ++c)
+            {
+                pose.Channel(static_cast<PoseChannel>(base + c))[joint] = from[c];
+                scratch.next.Channel(static_cast<PoseChannel>(base + c))[joint] = to[c];
+            }
+            if (a != b)
+            {
+                const float span = static_cast<float>(first[b] - first[a]);
+                scratch.weights[static_cast<size_t>(kind) * padded + joint] = (frame - static_cast<float>(first[a])) / span;
+            }
+        }
+    }
+
+    const std::span<const float> weights(scratch.weights);
+    InterpolatePoses(
+        pose,
+        scratch.next,
+        weights.subspan(static_cast<size_t>(kTranslation) * padded, padded),
+        weights.subspan(static_cast<size_t>(kRotation) * padded, padded),
+        weights.subspan(static_cast<size_t>(kScale) * padded, padded),
+        pose);
+}
+}  // namespace ENGINE
+}  // namespace ZKT
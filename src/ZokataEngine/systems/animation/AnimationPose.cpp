@@ -0,0 +1,425 @@
+#include "ZokataEngine/systems/animation/AnimationPose.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ZKT_ANIMATION_SSE2 1
+#endif
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr auto kChannelCount = static_cast<size_t>(PoseChannel::Count);
+constexpr float kIdentity[kChannelCount] = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 1.0F, 1.0F};
+
+void CheckSameShape(const LocalPose& a, const LocalPose& b)
+{
+    if (a.JointCount() != b.JointCount())
+    {
+        throw std::runtime_error("Poses must have the same joint count.");
+    }
+}
+
+// Shared blend kernel: translation and scale lerp, rotation nlerp with the sign of b flipped
+// onto a's hemisphere. Weight pointers advance per joint unless stride is 0 (uniform weight).
+void BlendRange(
+    const LocalPose& a,
+    const LocalPose& b,
+    const float* wt,
+    const float* wr,
+    const float* ws,
+    size_t stride,
+    LocalPose& out)
+{
+    const uint32_t count = a.PaddedCount();
+    const auto ch = [](const LocalPose& pose, PoseChannel c) { return pose.Channel(c); };
+    const float* atx = ch(a, PoseChannel::TranslationX);
+    const float* aty = ch(a, PoseChannel::TranslationY);
+    const float* atz = ch(a, PoseChannel::TranslationZ);
+    const float* arx = ch(a, PoseChannel::RotationX);
+    const float* ary = ch(a, PoseChannel::RotationY);
+    const float* arz = ch(a, PoseChannel::RotationZ);
+    const float* arw = ch(a, PoseChannel::RotationW);
+    const float* asx = ch(a, PoseChannel::ScaleX);
+    const float* asy = ch(a, PoseChannel::ScaleY);
+    const float* asz = ch(a, PoseChannel::ScaleZ);
+    const float* btx = ch(b, PoseChannel::TranslationX);
+    const float* bty = ch(b, PoseChannel::TranslationY);
+    const float* btz = ch(b, PoseChannel::TranslationZ);
+    const float* brx = ch(b, PoseChannel::RotationX);
+    const float* bry = ch(b, PoseChannel::RotationY);
+    const float* brz = ch(b, PoseChannel::RotationZ);
+    const float* brw = ch(b, PoseChannel::RotationW);
+    const float* bsx = ch(b, PoseChannel::ScaleX);
+    const float* bsy = ch(b, PoseChannel::ScaleY);
+    const float* bsz = ch(b, PoseChannel::ScaleZ);
+    float* otx = out.Channel(PoseChannel::TranslationX);
+    float* oty = out.Channel(PoseChannel::TranslationY);
+    float* otz = out.Channel(PoseChannel::TranslationZ);
+    float* orx = out.Channel(PoseChannel::RotationX);
+    float* ory = out.Channel(PoseChannel::RotationY);
+    float* orz = out.Channel(PoseChannel::RotationZ);
+    float* orw = out.Channel(PoseChannel::RotationW);
+    float* osx = out.Channel(PoseChannel::ScaleX);
+    float* osy = out.Channel(PoseChannel::ScaleY);
+    float* osz = out.Channel(PoseChannel::ScaleZ);
+
+#ifdef ZKT_ANIMATION_SSE2
+    const auto lerp = [](__m128 x, __m128 y, __m128 t) { return _mm_add_ps(x, _mm_mul_ps(_mm_sub_ps(y, x), t)); };
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign_mask = _mm_set1_ps(-0.0F);
+    for (uint32_t i = 0; i < count; i += LocalPose::kLaneWidth)
+    {
+        const size_t w = i * stride;
+        const __m128 t_t = stride != 0 ? _mm_loadu_ps(wt + w) : _mm_set1_ps(*wt);
+        const __m128 t_r = stride != 0 ? _mm_loadu_ps(wr + w) : _mm_set1_ps(*wr);
+        const __m128 t_s = stride != 0 ? _mm_loadu_ps(ws + w) : _mm_set1_ps(*ws);
+
+        _mm_storeu_ps(otx + i, lerp(_mm_loadu_ps(atx + i), _mm_loadu_ps(btx + i), t_t));
+        _mm_storeu_ps(oty + i, lerp(_mm_loadu_ps(aty + i), _mm_loadu_ps(bty + i), t_t));
+        _mm_storeu_ps(otz + i, lerp(_mm_loadu_ps(atz + i), _mm_loadu_ps(btz + i), t_t));
+        _mm_storeu_ps(osx + i, lerp(_mm_loadu_ps(asx + i), _mm_loadu_ps(bsx + i), t_s));
+        _mm_storeu_ps(osy + i, lerp(_mm_loadu_ps(asy + i), _mm_loadu_ps(bsy + i), t_s));
+        _mm_storeu_ps(osz + i, lerp(_mm_loadu_ps(asz + i), _mm_loadu_ps(bsz + i), t_s));
+
+        const __m128 ax = _mm_loadu_ps(arx + i);
+        const __m128 ay = _mm_loadu_ps(ary + i);
+        const __m128 az = _mm_loadu_ps(arz + i);
+        const __m128 aw = _mm_loadu_ps(arw + i);
+        __m128 bx = _mm_loadu_ps(brx + i);
+        __m128 by = _mm_loadu_ps(bry + i);
+        __m128 bz = _mm_loadu_ps(brz + i);
+        __m128 bw = _mm_loadu_ps(brw + i);
+        const __m128 dot = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), sign_mask);
+        bx = _mm_xor_ps(bx, flip);
+        by = _mm_xor_ps(by, flip);
+        bz = _mm_xor_ps(bz, flip);
+        bw = _mm_xor_ps(bw, flip);
+
+        const __m128 rx = lerp(ax, bx, t_r);
+        const __m128 ry = lerp(ay, by, t_r);
+        const __m128 rz = lerp(az, bz, t_r);
+        const __m128 rw = lerp(aw, bw, t_r);
+        const __m128 length_sq = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+        // Exact sqrt and divide rather than _mm_rsqrt_ps, so rotations stay unit length.
+        const __m128 inverse_length = _mm_div_ps(_mm_set1_ps(1.0F), _mm_sqrt_ps(_mm_max_ps(length_sq, _mm_set1_ps(1e-30F))));
+        _mm_storeu_ps(orx + i, _mm_mul_ps(rx, inverse_length));
+        _mm_storeu_ps(ory + i, _mm_mul_ps(ry, inverse_length));
+        _mm_storeu_ps(orz + i, _mm_mul_ps(rz, inverse_length));
+        _mm_storeu_ps(orw + i, _mm_mul_ps(rw, inverse_length));
+    }
+#else
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const size_t w = i * stride;
+        const float t_t = wt[w];
+        const float t_r = wr[w];
+        const float t_s = ws[w];
+        otx[i] = atx[i] + (btx[i] - atx[i]) * t_t;
+        oty[i] = aty[i] + (bty[i] - aty[i]) * t_t;
+        otz[i] = atz[i] + (btz[i] - atz[i]) * t_t;
+        osx[i] = asx[i] + (bsx[i] - asx[i]) * t_s;
+        osy[i] = asy[i] + (bsy[i] - asy[i]) * t_s;
+        osz[i] = asz[i] + (bsz[i] - asz[i]) * t_s;
+
+        const float dot = arx[i] * brx[i] + ary[i] * bry[i] + arz[i] * brz[i] + arw[i] * brw[i];
+        const float sign = dot < 0.0F ? -1.0F : 1.0F;
+        const float rx = arx[i] + (brx[i] * sign - arx[i]) * t_r;
+        const float ry = ary[i] + (bry[i] * sign - ary[i]) * t_r;
+        const float rz = arz[i] + (brz[i] * sign - arz[i]) * t_r;
+        const float rw = arw[i] + (brw[i] * sign - arw[i]) * t_r;
+        const float inverse_length = 1.0F / std::sqrt(std::max(rx * rx + ry * ry + rz * rz + rw * rw, 1e-30F));
+        orx[i] = rx * inverse_length;
+        ory[i] = ry * inverse_length;
+        orz[i] = rz * inverse_length;
+        orw[i] = rw * inverse_length;
+    }
+#endif
+}
+
+// Column-major 4x4 product out = a * b; out may alias b (each column of b is read before its
+// result column is written).
+void MultiplyMatrix(const float* a, const float* b, float* out)
+{
+#ifdef ZKT_ANIMATION_SSE2
+    const __m128 a0 = _mm_loadu_ps(a);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+    for (int column = 0; column < 4; ++column)
+    {
+        const float* bc = b + column * 4;
+        const __m128 result = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(bc[0])), _mm_mul_ps(a1, _mm_set1_ps(bc[1]))),
+            _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(bc[2])), _mm_mul_ps(a3, _mm_set1_ps(bc[3]))));
+        _mm_storeu_ps(out + column * 4, result);
+    }
+#else
+    for (int column = 0; column < 4; ++column)
+    {
+        const float b0 = b[column * 4];
+        const float b1 = b[column * 4 + 1];
+        const float b2 = b[column * 4 + 2];
+        const float b3 = b[column * 4 + 3];
+        for (int row = 0; row < 4; ++row)
+        {
+            out[column * 4 + row] = a[row] * b0 + a[4 + row] * b1 + a[8 + row] * b2 + a[12 + row] * b3;
+        }
+    }
+#endif
+}
+}  // namespace
+
+void LocalPose::Resize(uint32_t joint_count)
+{
+    joint_count_ = joint_count;
+    padded_count_ = (joint_count + kLaneWidth - 1) / kLaneWidth * kLaneWidth;
+    data_.resize(kChannelCount * padded_count_);
+    for (size_t c = 0; c < kChannelCount; ++c)
+    {
+        std::fill_n(data_.begin() + static_cast<ptrdiff_t>(c * padded_count_), padded_count_, kIdentity[c]);
+    }
+}
+
+void LocalPose::SetBindPose(const Skeleton& skeleton)
+{
+    Resize(skeleton.JointCount());
+    for (uint32_t i = 0; i < joint_count_; ++i)
+    {
+        SetJoint(i, skeleton.GetJoint(i).bind);
+    }
+}
+
+uint32_t LocalPose::JointCount() const
+{
+    return joint_count_;
+}
+
+uint32_t LocalPose::PaddedCount() const
+{
+    return padded_count_;
+}
+
+float* LocalPose::Channel(PoseChannel channel)
+{
+    return data_.data() + static_cast<size_t>(channel) * padded_count_;
+}
+
+const float* LocalPose::Channel(PoseChannel channel) const
+{
+    return data_.data() + static_cast<size_t>(channel) * padded_count_;
+}
+
+void LocalPose::SetJoint(uint32_t joint, const JointTransform& transform)
+{
+    const glm::quat& rotation = transform.rotation.ToGlm();
+    Channel(PoseChannel::TranslationX)[joint] = transform.translation.x;
+    Channel(PoseChannel::TranslationY)[joint] = transform.translation.y;
+    Channel(PoseChannel::TranslationZ)[joint] = transform.translation.z;
+    Channel(PoseChannel::RotationX)[joint] = rotation.x;
+    Channel(PoseChannel::RotationY)[joint] = rotation.y;
+    Channel(PoseChannel::RotationZ)[joint] = rotation.z;
+    Channel(PoseChannel::RotationW)[joint] = rotation.w;
+    Channel(PoseChannel::ScaleX)[joint] = transform.scale.x;
+    Channel(PoseChannel::ScaleY)[joint] = transform.scale.y;
+    Channel(PoseChannel::ScaleZ)[joint] = transform.scale.z;
+}
+
+JointTransform LocalPose::GetJoint(uint32_t joint) const
+{
+    JointTransform transform {};
+    transform.translation = MATH::Vec3f{
+        Channel(PoseChannel::TranslationX)[joint],
+        Channel(PoseChannel::TranslationY)[joint],
+        Channel(PoseChannel::TranslationZ)[joint],
+    };
+    transform.rotation = MATH::Quaternion(
+        Channel(PoseChannel::RotationW)[joint],
+        Channel(PoseChannel::RotationX)[joint],
+        Channel(PoseChannel::RotationY)[joint],
+        Channel(PoseChannel::RotationZ)[joint]);
+    transform.scale = MATH::Vec3f{
+        Channel(PoseChannel::ScaleX)[joint],
+        Channel(PoseChannel::ScaleY)[joint],
+        Channel(PoseChannel::ScaleZ)[joint],
+    };
+    return transform;
+}
+
+void BlendPoses(const LocalPose& a, const LocalPose& b, float weight, LocalPose& out)
+{
+    CheckSameShape(a, b);
+    if (out.JointCount() != a.JointCount())
+    {
+        out.Resize(a.JointCount());
+    }
+    BlendRange(a, b, &weight, &weight, &weight, 0, out);
+}
+
+void InterpolatePoses(
+    const LocalPose& a,
+    const LocalPose& b,
+    std::span<const float> translation_weights,
+    std::span<const float> rotation_weights,
+    std::span<const float> scale_weights,
+    LocalPose& out)
+{
+    CheckSameShape(a, b);
+    const size_t padded = a.PaddedCount();
+    if (translation_weights.size() < padded || rotation_weights.size() < padded || scale_weights.size() < padded)
+    {
+        throw std::runtime_error("Pose interpolation weights must cover every padded joint.");
+    }
+    if (out.JointCount() != a.JointCount())
+    {
+        out.Resize(a.JointCount());
+    }
+    BlendRange(a, b, translation_weights.data(), rotation_weights.data(), scale_weights.data(), 1, out);
+}
+
+void ComputeModelMatrices(const Skeleton& skeleton, const LocalPose& pose, std::span<MATH::Mat4f> model)
+{
+    const uint32_t joint_count = skeleton.JointCount();
+    if (pose.JointCount() != joint_count || model.size() < joint_count)
+    {
+        throw std::runtime_error("Pose and matrix span must match the skeleton.");
+    }
+
+    const float* tx = pose.Channel(PoseChannel::TranslationX);
+    const float* ty = pose.Channel(PoseChannel::TranslationY);
+    const float* tz = pose.Channel(PoseChannel::TranslationZ);
+    const float* qx = pose.Channel(PoseChannel::RotationX);
+    const float* qy = pose.Channel(PoseChannel::RotationY);
+    const float* qz = pose.Channel(PoseChannel::RotationZ);
+    const float* qw = pose.Channel(PoseChannel::RotationW);
+    const float* sx = pose.Channel(PoseChannel::ScaleX);
+    const float* sy = pose.Channel(PoseChannel::ScaleY);
+    const float* sz = pose.Channel(PoseChannel::ScaleZ);
+
+    // Local TRS matrices, four joints per iteration; the 3x3 basis lands in lane-major order.
+    alignas(16) float basis[9][LocalPose::kLaneWidth];
+    for (uint32_t i = 0; i < joint_count; i += LocalPose::kLaneWidth)
+    {
+#ifdef ZKT_ANIMATION_SSE2
+        const __m128 x = _mm_loadu_ps(qx + i);
+        const __m128 y = _mm_loadu_ps(qy + i);
+        const __m128 z = _mm_loadu_ps(qz + i);
+        const __m128 w = _mm_loadu_ps(qw + i);
+        const __m128 two = _mm_set1_ps(2.0F);
+        const __m128 one = _mm_set1_ps(1.0F);
+        const __m128 x2 = _mm_mul_ps(x, two);
+        const __m128 y2 = _mm_mul_ps(y, two);
+        const __m128 z2 = _mm_mul_ps(z, two);
+        const __m128 xx = _mm_mul_ps(x, x2);
+        const __m128 yy = _mm_mul_ps(y, y2);
+        const __m128 zz = _mm_mul_ps(z, z2);
+        const __m128 xy = _mm_mul_ps(x, y2);
+        const __m128 xz = _mm_mul_ps(x, z2);
+        const __m128 yz = _mm_mul_ps(y, z2);
+        const __m128 wx = _mm_mul_ps(w, x2);
+        const __m128 wy = _mm_mul_ps(w, y2);
+        const __m128 wz = _mm_mul_ps(w, z2);
+        const __m128 scale_x = _mm_loadu_ps(sx + i);
+        const __m128 scale_y = _mm_loadu_ps(sy + i);
+        const __m128 scale_z = _mm_loadu_ps(sz + i);
+        _mm_store_ps(basis[0], _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), scale_x));
+        _mm_store_ps(basis[1], _mm_mul_ps(_mm_add_ps(xy, wz), scale_x));
+        _mm_store_ps(basis[2], _mm_mul_ps(_mm_sub_ps(xz, wy), scale_x));
+        _mm_store_ps(basis[3], _mm_mul_ps(_mm_sub_ps(xy, wz), scale_y));
+        _mm_store_ps(basis[4], _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), scale_y));
+        _mm_store_ps(basis[5], _mm_mul_ps(_mm_add_ps(yz, wx), scale_y));
+        _mm_store_ps(basis[6], _mm_mul_ps(_mm_add_ps(xz, wy), scale_z));
+        _mm_store_ps(basis[7], _mm_mul_ps(_mm_sub_ps(yz, wx), scale_z));
+        _mm_store_ps(basis[8], _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), scale_z));
+#else
+        for (uint32_t lane = 0; lane < LocalPose::kLaneWidth; ++lane)
+        {
+            const uint32_t j = i + lane;
+            const float x2 = qx[j] * 2.0F;
+            const float y2 = qy[j] * 2.0F;
+            const float z2 = qz[j] * 2.0F;
+            const float xx = qx[j] * x2;
+            const float yy = qy[j] * y2;
+            const float zz = qz[j] * z2;
+            const float xy = qx[j] * y2;
+            const float xz = qx[j] * z2;
+            const float yz = qy[j] * z2;
+            const float wx = qw[j] * x2;
+            const float wy = qw[j] * y2;
+            const float wz = qw[j] * z2;
+            basis[0][lane] = (1.0F - (yy + zz)) * sx[j];
+            basis[1][lane] = (xy + wz) * sx[j];
+            basis[2][lane] = (xz - wy) * sx[j];
+            basis[3][lane] = (xy - wz) * sy[j];
+            basis[4][lane] = (1.0F - (xx + zz)) * sy[j];
+            basis[5][lane] = (yz + wx) * sy[j];
+            basis[6][lane] = (xz + wy) * sz[j];
+            basis[7][lane] = (yz - wx) * sz[j];
+            basis[8][lane] = (1.0F - (xx + yy)) * sz[j];
+        }
+#endif
+        const uint32_t lanes = std::min(LocalPose::kLaneWidth, joint_count - i);
+        for (uint32_t lane = 0; lane < lanes; ++lane)
+        {
+            const uint32_t j = i + lane;
+            float* m = glm::value_ptr(model[j].ToGlm());
+            m[0] = basis[0][lane];
+            m[1] = basis[1][lane];
+            m[2] = basis[2][lane];
+            m[3] = 0.0F;
+            m[4] = basis[3][lane];
+            m[5] = basis[4][lane];
+            m[6] = basis[5][lane];
+            m[7] = 0.0F;
+            m[8] = basis[6][lane];
+            m[9] = basis[7][lane];
+            m[10] = basis[8][lane];
+            m[11] = 0.0F;
+            m[12] = tx[j];
+            m[13] = ty[j];
+            m[14] = tz[j];
+            m[15] = 1.0F;
+        }
+    }
+
+    // Parents precede children, so a single forward pass turns local into model space.
+    const std::vector<int32_t>& parents = skeleton.Parents();
+    for (uint32_t j = 0; j < joint_count; ++j)
+    {
+        if (parents[j] >= 0)
+        {
+            float* m = glm::value_ptr(model[j].ToGlm());
+            MultiplyMatrix(glm::value_ptr(model[static_cast<size_t>(parents[j])].ToGlm()), m, m);
+        }
+    }
+}
+
+void ComputeSkinningMatrices(
+    const Skeleton& skeleton, std::span<const MATH::Mat4f> model, std::span<MATH::Mat4f> skinning)
+{
+    const uint32_t joint_count = skeleton.JointCount();
+    if (model.size() < joint_count || skinning.size() < joint_count)
+    {
+        throw std::runtime_error("Matrix spans must cover every skeleton joint.");
+    }
+    for (uint32_t j = 0; j < joint_count; ++j)
+    {
+        MultiplyMatrix(
+            glm::value_ptr(model[j].ToGlm()),
+            glm::value_ptr(skeleton.GetJoint(j).inverse_bind.ToGlm()),
+            glm::value_ptr(skinning[j].ToGlm()));
+    }
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,71 @@
+#include "ZokataEngine/systems/animation/AnimationSystem.h"
+
+#include <chrono>
+
+#include <imgui.h>
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/scene/Entity.h"
+#include "ZokataEngine/systems/scene/Scene.h"
+#include "ZokataEngine/systems/scene/components/AnimatorComponent.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr size_t kAnimatorGrain = 4;
+}  // namespace
+
+AnimationSystem::AnimationSystem(JobSystem& jobs)
+    : jobs_(jobs)
+{
+}
+
+void AnimationSystem::Update(Scene& scene)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    animators_.clear();
+    stats_ = AnimationStats {};
+    for (Entity* entity : scene.AllRuntimeEntities())
+    {
+        AnimatorComponent* animator = entity->GetComponent<AnimatorComponent>();
+        if (animator != nullptr && animator->Enabled() && animator->GetSkeleton())
+        {
+            animators_.push_back(animator);
+            stats_.joints += animator->GetSkeleton()->JointCount();
+        }
+    }
+    stats_.animators = static_cast<uint32_t>(animators_.size());
+
+    jobs_.ParallelFor(animators_.size(), kAnimatorGrain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            animators_[i]->Evaluate();
+        }
+    });
+
+    stats_.cpu_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+const AnimationStats& AnimationSystem::Stats() const
+{
+    return stats_;
+}
+
+void AnimationSystem::DrawDebugGui()
+{
+    if (!ImGui::Begin("Animation"))
+    {
+        ImGui::End();
+        return;
+    }
+    ImGui::Text("Animators: %u", stats_.animators);
+    ImGui::Text("Joints: %u", stats_.joints);
+    ImGui::Text("Evaluation: %.3f ms", static_cast<double>(stats_.cpu_ms));
+    ImGui::End();
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,65 @@
+#include "ZokataEngine/systems/animation/Skeleton.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+Skeleton::Skeleton(std::vector<Joint> joints)
+    : joints_(std::move(joints))
+{
+    if (joints_.empty())
+    {
+        throw std::runtime_error("Skeleton needs at least one joint.");
+    }
+    if (joints_.size() > 0xFFFF)
+    {
+        throw std::runtime_error("Skeleton exceeds 65535 joints.");
+    }
+    parents_.reserve(joints_.size());
+    for (size_t i = 0; i < joints_.size(); ++i)
+    {
+        const int32_t parent = joints_[i].parent;
+        if (parent >= static_cast<int32_t>(i) || parent < -1)
+        {
+            throw std::runtime_error("Skeleton joint '" + joints_[i].name + "' must come after its parent.");
+        }
+        parents_.push_back(parent);
+    }
+}
+
+uint32_t Skeleton::JointCount() const
+{
+    return static_cast<uint32_t>(joints_.size());
+}
+
+const Joint& Skeleton::GetJoint(uint32_t index) const
+{
+    return joints_.at(index);
+}
+
+const std::vector<Joint>& Skeleton::Joints() const
+{
+    return joints_;
+}
+
+const std::vector<int32_t>& Skeleton::Parents() const
+{
+    return parents_;
+}
+
+int32_t Skeleton::FindJoint(std::string_view name) const
+{
+    for (size_t i = 0; i < joints_.size(); ++i)
+    {
+        if (joints_[i].name == name)
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
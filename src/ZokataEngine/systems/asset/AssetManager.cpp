@@ -0,0 +1,615 @@
+#include "ZokataEngine/systems/asset/AssetManager.h"
+
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include <imgui.h>
+
+#include "ZokataEngine/systems/asset/AssetReference.h"
+#include "ZokataEngine/systems/asset/GltfImporter.h"
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/mesh/MeshAsset.h"
+#include "ZokataEngine/systems/mesh/MeshletBuilder.h"
+#include "ZokataEngine/systems/mesh/MeshSimplifier.h"
+#include "ZokataEngine/systems/texture/TextureAsset.h"
+#include "ZokataLog/Log.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+/**
+ * @brief Shared state behind every handle to one asset; owned by AssetManager.
+ *
+ * data, size and error are written once by the loading worker before state leaves Loading,
+ * and stay unchanged until the record is evicted, which requires refs == 0.
+ */
+struct AssetRecord
+{
+    std::string key;
+    std::string reference;
+    std::type_index type {typeid(void)};
+    std::atomic<AssetState> state {AssetState::Loading};
+    std::atomic<uint32_t> version {0};
+    std::shared_ptr<const void> data;
+    AssetSize size;
+    std::string error;
+    uint32_t refs = 0;                              // guarded by the manager's mutex
+    std::vector<std::function<void()>> callbacks;  // waiting for the load to finish
+    std::list<AssetRecord*>::iterator unused_slot;
+    bool unused = false;
+    // Hot reload, guarded by the manager's mutex.
+    bool reloading = false;
+    bool reload_again = false;  // the file changed again while reloading
+    std::shared_ptr<const void> reloaded_data;
+    AssetSize reloaded_size;
+};
+
+namespace
+{
+// Smaller meshes are cheaper to draw whole than to cull per cluster.
+constexpr size_t kMeshletMinTriangles = 4096;
+
+std::string RecordKey(std::type_index type, std::string_view reference)
+{
+    std::string key = type.name();
+    key += '|';
+    key += reference;
+    return key;
+}
+
+std::shared_ptr<const MeshAsset> LoadMesh(const std::string& reference, JobSystem& jobs)
+{
+    const AssetReference asset = ParseAssetReference(reference);
+    const GltfImporter importer(asset.path);
+    const int32_t mesh = importer.FindMesh(asset.sub_asset);
+    if (mesh < 0)
+    {
+        throw std::runtime_error("Mesh '" + asset.sub_asset + "' not found in " + asset.path.string());
+    }
+    const auto index = static_cast<uint32_t>(mesh);
+    const std::vector<ImportedMesh> meshes = importer.ImportMeshes({&index, 1}, jobs);
+    auto loaded = std::make_shared<MeshAsset>();
+    MeshGeometry geometry = MergePrimitives(meshes.front());
+    if (geometry.TriangleCount() >= kMeshletMinTriangles)
+    {
+        const MeshletMesh meshlets = BuildMeshlets(geometry);
+        geometry.indices = meshlets.DrawIndices();
+        loaded->meshlets = std::make_shared<const std::vector<GpuMeshlet>>(meshlets.GpuMeshlets(0, 0));
+    }
+    loaded->geometry = std::make_shared<const MeshGeometry>(std::move(geometry));
+    loaded->lods = BuildLodChain(*loaded->geometry, LodChainSettings {});
+    return loaded;
+}
+
+// Normalized absolute form, so paths from the watcher and from references compare equal.
+std::string ComparablePath(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    const std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+    return (ec ? path : absolute).lexically_normal().generic_string();
+}
+
+size_t GeometryBytes(const MeshGeometry& geometry)
+{
+    return geometry.vertices.size() * sizeof(MeshVertex) + geometry.indices.size() * sizeof(uint32_t);
+}
+
+AssetSize MeasureMesh(const MeshAsset& asset)
+{
+    size_t bytes = GeometryBytes(*asset.geometry);
+    for (const MeshLod& lod : asset.lods)
+    {
+        bytes += GeometryBytes(*lod.geometry);
+    }
+    if (asset.meshlets)
+    {
+        bytes += asset.meshlets->size() * sizeof(GpuMeshlet);
+    }
+    return AssetSize{bytes, bytes};
+}
+}  // namespace
+
+AssetHandleBase::AssetHandleBase(AssetManager* manager, AssetRecord* record)
+    : manager_(manager)
+    , record_(record)
+{
+    // Adopts the reference AssetManager::Acquire took on the caller's behalf.
+}
+
+AssetHandleBase::~AssetHandleBase()
+{
+    Reset();
+}
+
+AssetHandleBase::AssetHandleBase(const AssetHandleBase& other)
+    : manager_(other.manager_)
+    , record_(other.record_)
+{
+    if (record_ != nullptr)
+    {
+        manager_->Retain(record_);
+    }
+}
+
+AssetHandleBase& AssetHandleBase::operator=(const AssetHandleBase& other)
+{
+    if (this != &other)
+    {
+        if (other.record_ != nullptr)
+        {
+            other.manager_->Retain(other.record_);
+        }
+        Reset();
+        manager_ = other.manager_;
+        record_ = other.record_;
+    }
+    return *this;
+}
+
+AssetHandleBase::AssetHandleBase(AssetHandleBase&& other) noexcept
+    : manager_(std::exchange(other.manager_, nullptr))
+    , record_(std::exchange(other.record_, nullptr))
+{
+}
+
+AssetHandleBase& AssetHandleBase::operator=(AssetHandleBase&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        manager_ = std::exchange(other.manager_, nullptr);
+        record_ = std::exchange(other.record_, nullptr);
+    }
+    return *this;
+}
+
+bool AssetHandleBase::Valid() const
+{
+    return record_ != nullptr;
+}
+
+AssetState AssetHandleBase::State() const
+{
+    return record_ != nullptr ? record_->state.load(std::memory_order_acquire) : AssetState::Failed;
+}
+
+bool AssetHandleBase::IsReady() const
+{
+    return State() == AssetState::Ready;
+}
+
+bool AssetHandleBase::IsFailed() const
+{
+    return State() == AssetState::Failed;
+}
+
+const std::string& AssetHandleBase::Reference() const
+{
+    static const std::string empty;
+    return record_ != nullptr ? record_->reference : empty;
+}
+
+const std::string& AssetHandleBase::Error() const
+{
+    static const std::string empty;
+    return IsFailed() && record_ != nullptr ? record_->error : empty;
+}
+
+uint32_t AssetHandleBase::Version() const
+{
+    return record_ != nullptr ? record_->version.load(std::memory_order_acquire) : 0;
+}
+
+void AssetHandleBase::Wait() const
+{
+    if (record_ != nullptr)
+    {
+        manager_->Wait(record_);
+    }
+}
+
+void AssetHandleBase::OnLoaded(std::function<void()> callback) const
+{
+    if (record_ != nullptr)
+    {
+        manager_->AddCallback(record_, std::move(callback));
+    }
+}
+
+void AssetHandleBase::Reset()
+{
+    if (record_ != nullptr)
+    {
+        manager_->Release(record_);
+        record_ = nullptr;
+        manager_ = nullptr;
+    }
+}
+
+std::shared_ptr<const void> AssetHandleBase::Data() const
+{
+    return IsReady() ? record_->data : nullptr;
+}
+
+AssetManager::AssetManager(JobSystem& jobs, AssetBudget budget)
+    : jobs_(jobs)
+    , budget_(budget)
+{
+    RegisterLoader<MeshAsset>(
+        [&jobs](const std::string& reference) { return LoadMesh(reference, jobs); }, MeasureMesh);
+    RegisterLoader<TextureAsset>(LoadTextureAsset, MeasureTexture);
+}
+
+AssetManager::~AssetManager()
+{
+    // Workers write into records; let every load land before the records go away.
+    std::unique_lock lock(mutex_);
+    loaded_.wait(lock, [this]() { return in_flight_ == 0; });
+    for (const auto& [key, record] : records_)
+    {
+        if (record->refs > 0)
+        {
+            ZLOG_WARN("Asset '" + record->reference + "' is still referenced at shutdown.");
+        }
+    }
+}
+
+void AssetManager::RegisterErasedLoader(std::type_index type, ErasedLoader loader)
+{
+    std::lock_guard lock(mutex_);
+    loaders_[type] = std::move(loader);
+}
+
+AssetRecord* AssetManager::Acquire(std::type_index type, std::string_view reference)
+{
+    std::string key = RecordKey(type, reference);
+    std::lock_guard lock(mutex_);
+    if (const auto it = records_.find(key); it != records_.end())
+    {
+        AssetRecord* record = it->second.get();
+        ++hits_;
+        RetainLocked(record);
+        return record;
+    }
+
+    ++misses_;
+    auto owned = std::make_unique<AssetRecord>();
+    AssetRecord* record = owned.get();
+    record->key = key;
+    record->reference = std::string(reference);
+    record->type = type;
+    record->refs = 1;
+    records_.emplace(std::move(key), std::move(owned));
+
+    const auto loader = loaders_.find(type);
+    if (loader == loaders_.end())
+    {
+        record->error = std::string("No loader registered for ") + type.name();
+        record->state.store(AssetState::Failed, std::memory_order_release);
+        return record;
+    }
+
+    ++in_flight_;
+    jobs_.Submit([this, record, load = loader->second]() { RunLoad(record, load); });
+    return record;
+}
+
+void AssetManager::RunLoad(AssetRecord* record, const ErasedLoader& loader)
+{
+    AssetState state = AssetState::Ready;
+    try
+    {
+        LoadedAsset loaded = loader(record->reference);
+        record->data = std::move(loaded.data);
+        record->size = loaded.size;
+    }
+    catch (const std::exception& e)
+    {
+        record->error = e.what();
+        state = AssetState::Failed;
+    }
+
+    std::lock_guard lock(mutex_);
+    record->state.store(state, std::memory_order_release);
+    if (state == AssetState::Failed)
+    {
+        ZLOG_ERROR("Failed to load asset '" + record->reference + "': " + record->error);
+    }
+    cpu_bytes_ += record->size.cpu_bytes;
+    gpu_bytes_ += record->size.gpu_bytes;
+    for (auto& callback : record->callbacks)
+    {
+        callbacks_.push_back(std::move(callback));
+    }
+    record->callbacks.clear();
+
+    const bool stale = std::exchange(record->reload_again, false);
+    if (stale && record->refs > 0)
+    {
+        // The file changed while it loaded; read it once more, serving this data meanwhile.
+        record->reloading = true;
+        jobs_.Submit([this, record, load = loader]() { RunReload(record, load); });
+        return;  // still in flight
+    }
+
+    if (record->refs == 0)
+    {
+        // Every handle went away while loading: cache a success, forget a failure.
+        if (state == AssetState::Ready && !stale)
+        {
+            record->unused_slot = unused_.insert(unused_.end(), record);
+            record->unused = true;
+        }
+        else
+        {
+            // Counted above, so the budget does not keep data nothing holds.
+            cpu_bytes_ -= record->size.cpu_bytes;
+            gpu_bytes_ -= record->size.gpu_bytes;
+            records_.erase(records_.find(record->key));
+        }
+    }
+    --in_flight_;
+    loaded_.notify_all();
+}
+
+size_t AssetManager::Reload(const std::filesystem::path& file)
+{
+    const std::string target = ComparablePath(file);
+    std::lock_guard lock(mutex_);
+    std::vector<AssetRecord*> dropped;
+    size_t matched = 0;
+    for (const auto& [key, owned] : records_)
+    {
+        AssetRecord* record = owned.get();
+        if (ComparablePath(ParseAssetReference(record->reference).path) != target)
+        {
+            continue;
+        }
+        ++matched;
+        if (record->state.load(std::memory_order_acquire) == AssetState::Loading || record->reloading)
+        {
+            // The running load may have read the old contents.
+            record->reload_again = true;
+            continue;
+        }
+        if (record->unused)
+        {
+            dropped.push_back(record);
+            continue;
+        }
+        const auto loader = loaders_.find(record->type);
+        if (loader == loaders_.end())
+        {
+            continue;
+        }
+        record->reloading = true;
+        ++in_flight_;
+        jobs_.Submit([this, record, load = loader->second]() { RunReload(record, load); });
+    }
+    for (AssetRecord* record : dropped)
+    {
+        unused_.erase(record->unused_slot);
+        cpu_bytes_ -= record->size.cpu_bytes;
+        gpu_bytes_ -= record->size.gpu_bytes;
+        records_.erase(records_.find(record->key));
+    }
+    return matched;
+}
+
+void AssetManager::RunReload(AssetRecord* record, const ErasedLoader& loader)
+{
+    std::shared_ptr<const void> data;
+    AssetSize size {};
+    std::string error;
+    try
+    {
+        LoadedAsset loaded = loader(record->reference);
+        data = std::move(loaded.data);
+        size = loaded.size;
+    }
+    catch (const std::exception& e)
+    {
+        error = e.what();
+    }
+
+    std::lock_guard lock(mutex_);
+    if (record->reload_again)
+    {
+        // The file changed again while it was read; this result is already stale.
+        record->reload_again = false;
+        jobs_.Submit([this, record, load = loader]() { RunReload(record, load); });
+        return;  // still in flight
+    }
+    if (data)
+    {
+        // reloading stays set until Update swaps the data in, which keeps the record alive.
+        record->reloaded_data = std::move(data);
+        record->reloaded_size = size;
+        reloaded_.push_back(record);
+    }
+    else
+    {
+        // Keep serving the last good data; a broken file on disk is usually mid-edit.
+        ZLOG_ERROR("Failed to reload asset '" + record->reference + "': " + error);
+        record->reloading = false;
+        if (record->refs == 0 && record->state.load(std::memory_order_acquire) == AssetState::Failed)
+        {
+            records_.erase(records_.find(record->key));
+        }
+    }
+    --in_flight_;
+    loaded_.notify_all();
+}
+
+void AssetManager::ApplyReloads()
+{
+    for (AssetRecord* record : reloaded_)
+    {
+        const bool was_failed = record->state.load(std::memory_order_acquire) == AssetState::Failed;
+        cpu_bytes_ += record->reloaded_size.cpu_bytes - record->size.cpu_bytes;
+        gpu_bytes_ += record->reloaded_size.gpu_bytes - record->size.gpu_bytes;
+        record->data = std::move(record->reloaded_data);
+        record->size = record->reloaded_size;
+        record->reloaded_data.reset();
+        record->reloading = false;
+        record->state.store(AssetState::Ready, std::memory_order_release);
+        record->version.fetch_add(1, std::memory_order_release);
+        if (was_failed && record->refs == 0)
+        {
+            record->unused_slot = unused_.insert(unused_.end(), record);
+            record->unused = true;
+        }
+        ++reloads_;
+        ZLOG_INFO("Reloaded asset '" + record->reference + "'");
+    }
+    reloaded_.clear();
+}
+
+void AssetManager::Retain(AssetRecord* record)
+{
+    std::lock_guard lock(mutex_);
+    RetainLocked(record);
+}
+
+void AssetManager::RetainLocked(AssetRecord* record)
+{
+    if (record->refs++ == 0 && record->unused)
+    {
+        unused_.erase(record->unused_slot);
+        record->unused = false;
+    }
+}
+
+void AssetManager::Release(AssetRecord* record)
+{
+    std::lock_guard lock(mutex_);
+    if (--record->refs > 0)
+    {
+        return;
+    }
+    switch (record->state.load(std::memory_order_acquire))
+    {
+    case AssetState::Ready:
+        record->unused_slot = unused_.insert(unused_.end(), record);
+        record->unused = true;
+        break;
+    case AssetState::Failed:
+        // Drop failures so the next Load retries, unless a reload still writes into it.
+        if (!record->reloading)
+        {
+            records_.erase(records_.find(record->key));
+        }
+        break;
+    case AssetState::Loading:
+        break;
+    }
+}
+
+void AssetManager::AddCallback(AssetRecord* record, std::function<void()> callback)
+{
+    std::lock_guard lock(mutex_);
+    if (record->state.load(std::memory_order_acquire) == AssetState::Loading)
+    {
+        record->callbacks.push_back(std::move(callback));
+    }
+    else
+    {
+        callbacks_.push_back(std::move(callback));
+    }
+}
+
+void AssetManager::Wait(const AssetRecord* record)
+{
+    std::unique_lock lock(mutex_);
+    loaded_.wait(lock, [record]() { return record->state.load(std::memory_order_acquire) != AssetState::Loading; });
+}
+
+void AssetManager::Update()
+{
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard lock(mutex_);
+        callbacks.swap(callbacks_);
+        ApplyReloads();
+        EvictToBudget();
+    }
+    // Outside the lock: callbacks may load or release assets.
+    for (const auto& callback : callbacks)
+    {
+        callback();
+    }
+}
+
+void AssetManager::SetBudget(const AssetBudget& budget)
+{
+    std::lock_guard lock(mutex_);
+    budget_ = budget;
+    EvictToBudget();
+}
+
+const AssetBudget& AssetManager::Budget() const
+{
+    return budget_;
+}
+
+AssetManagerStats AssetManager::Stats() const
+{
+    std::lock_guard lock(mutex_);
+    AssetManagerStats stats {};
+    stats.assets = records_.size();
+    stats.loading = in_flight_;
+    stats.unused = unused_.size();
+    stats.cpu_bytes = cpu_bytes_;
+    stats.gpu_bytes = gpu_bytes_;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.reloads = reloads_;
+    return stats;
+}
+
+void AssetManager::EvictToBudget()
+{
+    for (auto it = unused_.begin(); it != unused_.end() && (cpu_bytes_ > budget_.cpu_bytes || gpu_bytes_ > budget_.gpu_bytes);)
+    {
+        AssetRecord* record = *it;
+        if (record->reloading)
+        {
+            ++it;  // a worker still writes into it
+            continue;
+        }
+        it = unused_.erase(it);
+        cpu_bytes_ -= record->size.cpu_bytes;
+        gpu_bytes_ -= record->size.gpu_bytes;
+        ++evictions_;
+        records_.erase(records_.find(record->key));
+    }
+}
+
+void AssetManager::DrawDebugGui() const
+{
+    const AssetManagerStats stats = Stats();
+    if (!ImGui::Begin("Assets"))
+    {
+        ImGui::End();
+        return;
+    }
+    constexpr double kMiB = 1024.0 * 1024.0;
+    ImGui::Text("Assets: %zu (%zu loading, %zu unused)", stats.assets, stats.loading, stats.unused);
+    ImGui::Text(
+        "CPU: %.1f / %.1f MiB",
+        static_cast<double>(stats.cpu_bytes) / kMiB,
+        static_cast<double>(budget_.cpu_bytes) / kMiB);
+    ImGui::Text(
+        "GPU: %.1f / %.1f MiB",
+        static_cast<double>(stats.gpu_bytes) / kMiB,
+        static_cast<double>(budget_.gpu_bytes) / kMiB);
+    ImGui::Text("Hits: %zu  Misses: %zu  Evictions: %zu", stats.hits, stats.misses, stats.evictions);
+    ImGui::Text("Reloads: %zu", stats.reloads);
+    ImGui::End();
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,18 @@
+#include "ZokataEngine/systems/asset/AssetReference.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+AssetReference ParseAssetReference(std::string_view reference)
+{
+    const size_t hash = reference.rfind('#');
+    if (hash == std::string_view::npos)
+    {
+        return AssetReference{std::filesystem::path(reference), {}};
+    }
+    return AssetReference{
+        std::filesystem::path(reference.substr(0, hash)), std::string(reference.substr(hash + 1))};
+}
+}  // namespace ENGINE
+}  // namespace ZKT
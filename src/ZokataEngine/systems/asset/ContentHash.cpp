@@ -0,0 +1,144 @@
+#include "ZokataEngine/systems/asset/ContentHash.h"
+
+#include <charconv>
+#include <cstring>
+
+#include "ZokataEngine/systems/asset/MappedFile.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t RotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Unaligned little-endian loads; memcpy compiles to a single mov.
+uint64_t Read64(const uint8_t* p)
+{
+    uint64_t value = 0;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Read32(const uint8_t* p)
+{
+    uint32_t value = 0;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t Round(uint64_t accumulator, uint64_t input)
+{
+    accumulator += input * kPrime2;
+    accumulator = RotateLeft(accumulator, 31);
+    return accumulator * kPrime1;
+}
+
+uint64_t MergeRound(uint64_t accumulator, uint64_t value)
+{
+    accumulator ^= Round(0, value);
+    return accumulator * kPrime1 + kPrime4;
+}
+}  // namespace
+
+uint64_t HashBytes(std::span<const uint8_t> bytes, uint64_t seed)
+{
+    const uint8_t* p = bytes.data();
+    const uint8_t* const end = p + bytes.size();
+    uint64_t hash = 0;
+
+    // Four independent lanes keep the multipliers busy; 32 bytes per iteration.
+    if (bytes.size() >= 32)
+    {
+        uint64_t v1 = seed + kPrime1 + kPrime2;
+        uint64_t v2 = seed + kPrime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - kPrime1;
+        for (const uint8_t* const limit = end - 32; p <= limit; p += 32)
+        {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+        }
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + kPrime5;
+    }
+    hash += bytes.size();
+
+    for (; p + 8 <= end; p += 8)
+    {
+        hash ^= Round(0, Read64(p));
+        hash = RotateLeft(hash, 27) * kPrime1 + kPrime4;
+    }
+    if (p + 4 <= end)
+    {
+        hash ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+        hash = RotateLeft(hash, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p)
+    {
+        hash ^= *p * kPrime5;
+        hash = RotateLeft(hash, 11) * kPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t HashFileContents(const std::filesystem::path& path)
+{
+    const MappedFile file(path);
+    return HashBytes(file.Bytes());
+}
+
+ContentHasher& ContentHasher::Add(std::string_view text)
+{
+    Add(static_cast<uint64_t>(text.size()));
+    buffer_.append(text);
+    return *this;
+}
+
+ContentHasher& ContentHasher::Add(uint64_t value)
+{
+    char bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    buffer_.append(bytes, sizeof(bytes));
+    return *this;
+}
+
+uint64_t ContentHasher::Finish() const
+{
+    return HashBytes({reinterpret_cast<const uint8_t*>(buffer_.data()), buffer_.size()});
+}
+
+std::string HashToHex(uint64_t hash)
+{
+    char digits[16];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), hash, 16);
+    return std::string(digits, result.ptr);
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,258 @@
+#include "ZokataEngine/systems/asset/CookCache.h"
+
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "ZokataEngine/systems/asset/ContentHash.h"
+#include "ZokataLog/Log.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr const char* kManifestName = "manifest.txt";
+constexpr std::string_view kManifestHeader = "zkcache 1";
+
+std::string SourceKey(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    return std::filesystem::absolute(path, ec).lexically_normal().generic_string();
+}
+
+/**
+ * @brief Splits the next space-separated field off line; false when none is left.
+ */
+bool NextField(std::string_view& line, std::string_view& field)
+{
+    const size_t end = line.find(' ');
+    if (end == std::string_view::npos || end == 0)
+    {
+        return false;
+    }
+    field = line.substr(0, end);
+    line.remove_prefix(end + 1);
+    return true;
+}
+
+template <typename T>
+bool ParseField(std::string_view& line, T& value, int base = 10)
+{
+    std::string_view field;
+    if (!NextField(line, field))
+    {
+        return false;
+    }
+    return std::from_chars(field.data(), field.data() + field.size(), value, base).ec == std::errc {};
+}
+
+/**
+ * @brief Copies from to to through a temporary file, so readers never see a partial copy.
+ */
+void CopyAtomically(const std::filesystem::path& from, const std::filesystem::path& to)
+{
+    std::filesystem::path temp_path = to;
+    temp_path += ".tmp";
+    std::filesystem::copy_file(from, temp_path, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::rename(temp_path, to);
+}
+}  // namespace
+
+CookCache::CookCache(std::filesystem::path directory)
+    : directory_(std::move(directory))
+{
+    std::filesystem::create_directories(directory_);
+    Load();
+}
+
+const std::filesystem::path& CookCache::Directory() const
+{
+    return directory_;
+}
+
+uint64_t CookCache::SourceHash(const std::filesystem::path& source)
+{
+    const std::string key = SourceKey(source);
+    std::error_code ec;
+    const uint64_t size = std::filesystem::file_size(key, ec);
+    const int64_t write_time = ec ? 0 : std::filesystem::last_write_time(key, ec).time_since_epoch().count();
+    if (ec)
+    {
+        throw std::runtime_error("Failed to stat cook source " + key + ": " + ec.message());
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        const auto it = sources_.find(key);
+        if (it != sources_.end() && it->second.size == size && it->second.write_time == write_time)
+        {
+            return it->second.hash;
+        }
+    }
+
+    // Hash outside the lock; two threads racing on one file store the same value.
+    const uint64_t hash = HashFileContents(key);
+    std::lock_guard lock(mutex_);
+    sources_[key] = SourceEntry{size, write_time, hash};
+    return hash;
+}
+
+uint64_t CookCache::ComputeKey(uint64_t seed, std::span<const std::filesystem::path> sources)
+{
+    ContentHasher hasher;
+    hasher.Add(seed);
+    for (const std::filesystem::path& source : sources)
+    {
+        hasher.Add(SourceKey(source)).Add(SourceHash(source));
+    }
+    return hasher.Finish();
+}
+
+std::optional<std::vector<std::filesystem::path>> CookCache::RecordedSources(const std::filesystem::path& output) const
+{
+    std::lock_guard lock(mutex_);
+    const auto it = outputs_.find(SourceKey(output));
+    if (it == outputs_.end())
+    {
+        return std::nullopt;
+    }
+    return it->second.sources;
+}
+
+std::optional<uint64_t> CookCache::RecordedKey(const std::filesystem::path& output) const
+{
+    std::lock_guard lock(mutex_);
+    const auto it = outputs_.find(SourceKey(output));
+    if (it == outputs_.end())
+    {
+        return std::nullopt;
+    }
+    return it->second.key;
+}
+
+bool CookCache::Restore(uint64_t key, const std::filesystem::path& output, std::span<const std::filesystem::path> sources)
+{
+    const std::filesystem::path entry = EntryPath(key);
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(entry, ec))
+    {
+        return false;
+    }
+    CopyAtomically(entry, output);
+    std::lock_guard lock(mutex_);
+    outputs_[SourceKey(output)] = OutputEntry{key, {sources.begin(), sources.end()}};
+    return true;
+}
+
+void CookCache::Store(uint64_t key, const std::filesystem::path& output, std::span<const std::filesystem::path> sources)
+{
+    CopyAtomically(output, EntryPath(key));
+    std::lock_guard lock(mutex_);
+    outputs_[SourceKey(output)] = OutputEntry{key, {sources.begin(), sources.end()}};
+}
+
+void CookCache::Save() const
+{
+    std::ostringstream manifest;
+    {
+        std::lock_guard lock(mutex_);
+        manifest << kManifestHeader << '\n';
+        for (const auto& [path, source] : sources_)
+        {
+            manifest << "S " << HashToHex(source.hash) << ' ' << source.size << ' ' << source.write_time << ' ' << path
+                     << '\n';
+        }
+        for (const auto& [path, output] : outputs_)
+        {
+            manifest << "O " << HashToHex(output.key) << ' ' << output.sources.size() << ' ' << path << '\n';
+            for (const std::filesystem::path& source : output.sources)
+            {
+                manifest << "D " << source.generic_string() << '\n';
+            }
+        }
+    }
+
+    const std::filesystem::path path = directory_ / kManifestName;
+    std::filesystem::path temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::trunc);
+        out << manifest.str();
+        if (!out)
+        {
+            throw std::runtime_error("Failed to write " + temp_path.string());
+        }
+    }
+    std::filesystem::rename(temp_path, path);
+}
+
+std::filesystem::path CookCache::EntryPath(uint64_t key) const
+{
+    return directory_ / (HashToHex(key) + ".bin");
+}
+
+void CookCache::Load()
+{
+    std::ifstream in(directory_ / kManifestName);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kManifestHeader)
+    {
+        return;
+    }
+
+    // A damaged manifest only costs rehashing and recooking, so stop at the first bad line.
+    OutputEntry* output = nullptr;
+    size_t pending_sources = 0;
+    while (std::getline(in, line))
+    {
+        std::string_view rest = line;
+        std::string_view tag;
+        if (!NextField(rest, tag))
+        {
+            break;
+        }
+        if (tag == "S")
+        {
+            SourceEntry source {};
+            if (!ParseField(rest, source.hash, 16) || !ParseField(rest, source.size) || !ParseField(rest, source.write_time)
+                || rest.empty())
+            {
+                break;
+            }
+            sources_[std::string(rest)] = source;
+        }
+        else if (tag == "O")
+        {
+            uint64_t key = 0;
+            if (!ParseField(rest, key, 16) || !ParseField(rest, pending_sources) || rest.empty())
+            {
+                break;
+            }
+            output = &outputs_[std::string(rest)];
+            output->key = key;
+            output->sources.reserve(pending_sources);
+        }
+        else if (tag == "D" && output != nullptr && pending_sources > 0 && !rest.empty())
+        {
+            output->sources.emplace_back(rest);
+            --pending_sources;
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (pending_sources > 0)
+    {
+        ZLOG_WARN("Cook cache manifest in " + directory_.string() + " is truncated; affected outputs will recook.");
+        outputs_.clear();
+    }
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,106 @@
+#include "ZokataEngine/systems/asset/FileWatcher.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "ZokataLog/Log.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace ZKT
+{
+namespace ENGINE
+{
+FileWatcher::FileWatcher()
+{
+#ifdef __linux__
+    fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd_ < 0)
+    {
+        ZLOG_WARN(std::string("File watching unavailable: ") + std::strerror(errno));
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    if (fd_ >= 0)
+    {
+        close(fd_);
+    }
+#endif
+}
+
+bool FileWatcher::Valid() const
+{
+    return fd_ >= 0;
+}
+
+void FileWatcher::WatchDirectory(const std::filesystem::path& directory)
+{
+#ifdef __linux__
+    if (fd_ < 0)
+    {
+        return;
+    }
+    // inotify hands back the same descriptor for a directory it already watches.
+    const int wd = inotify_add_watch(fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR);
+    if (wd < 0)
+    {
+        ZLOG_WARN("Cannot watch " + directory.string() + ": " + std::strerror(errno));
+        return;
+    }
+    directories_.emplace(wd, directory);
+#else
+    (void)directory;
+#endif
+}
+
+std::vector<std::filesystem::path> FileWatcher::Poll()
+{
+    std::vector<std::filesystem::path> changed;
+#ifdef __linux__
+    if (fd_ < 0)
+    {
+        return changed;
+    }
+    alignas(inotify_event) char buffer[16 * 1024];
+    for (;;)
+    {
+        const ssize_t length = read(fd_, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            break;  // EAGAIN: drained
+        }
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            if ((event->mask & IN_Q_OVERFLOW) != 0)
+            {
+                ZLOG_WARN("File watcher queue overflowed; some changes were missed.");
+                continue;
+            }
+            const auto directory = directories_.find(event->wd);
+            if (directory == directories_.end() || event->len == 0 || (event->mask & IN_ISDIR) != 0)
+            {
+                continue;
+            }
+            std::filesystem::path path = directory->second / event->name;
+            if (std::find(changed.begin(), changed.end(), path) == changed.end())
+            {
+                changed.push_back(std::move(path));
+            }
+        }
+    }
+#endif
+    return changed;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
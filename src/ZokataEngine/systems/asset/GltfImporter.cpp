@@ -0,0 +1,622 @@
+#include "ZokataEngine/systems/asset/GltfImporter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint32_t kGlbMagic = 0x46546C67;      // "glTF"
+constexpr uint32_t kChunkJson = 0x4E4F534A;     // "JSON"
+constexpr uint32_t kChunkBinary = 0x004E4942;   // "BIN\0"
+
+constexpr uint32_t kByte = 5120;
+constexpr uint32_t kUnsignedByte = 5121;
+constexpr uint32_t kShort = 5122;
+constexpr uint32_t kUnsignedShort = 5123;
+constexpr uint32_t kUnsignedInt = 5125;
+constexpr uint32_t kFloat = 5126;
+
+constexpr int64_t kModeTriangles = 4;
+constexpr int64_t kModeTriangleStrip = 5;
+constexpr int64_t kModeTriangleFan = 6;
+
+uint32_t ReadU32(std::span<const uint8_t> bytes, size_t offset)
+{
+    uint32_t value = 0;
+    std::memcpy(&value, bytes.data() + offset, sizeof(value));
+    return value;
+}
+
+uint32_t ComponentSize(uint32_t component_type)
+{
+    switch (component_type)
+    {
+    case kByte:
+    case kUnsignedByte:
+        return 1;
+    case kShort:
+    case kUnsignedShort:
+        return 2;
+    case kUnsignedInt:
+    case kFloat:
+        return 4;
+    default:
+        throw std::runtime_error("glTF accessor has unknown component type " + std::to_string(component_type));
+    }
+}
+
+uint32_t ComponentCount(const std::string& type)
+{
+    if (type == "SCALAR")
+    {
+        return 1;
+    }
+    if (type == "VEC2")
+    {
+        return 2;
+    }
+    if (type == "VEC3")
+    {
+        return 3;
+    }
+    if (type == "VEC4")
+    {
+        return 4;
+    }
+    throw std::runtime_error("glTF accessor type '" + type + "' is not supported for meshes");
+}
+
+float ReadComponent(const uint8_t* p, uint32_t component_type, bool normalized)
+{
+    switch (component_type)
+    {
+    case kFloat:
+    {
+        float value = 0.0F;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    case kUnsignedByte:
+        return normalized ? static_cast<float>(*p) / 255.0F : static_cast<float>(*p);
+    case kByte:
+    {
+        const auto value = static_cast<float>(static_cast<int8_t>(*p));
+        return normalized ? std::max(value / 127.0F, -1.0F) : value;
+    }
+    case kUnsignedShort:
+    {
+        uint16_t value = 0;
+        std::memcpy(&value, p, sizeof(value));
+        return normalized ? static_cast<float>(value) / 65535.0F : static_cast<float>(value);
+    }
+    case kShort:
+    {
+        int16_t value = 0;
+        std::memcpy(&value, p, sizeof(value));
+        return normalized ? std::max(static_cast<float>(value) / 32767.0F, -1.0F) : static_cast<float>(value);
+    }
+    default:
+    {
+        uint32_t value = 0;
+        std::memcpy(&value, p, sizeof(value));
+        return static_cast<float>(value);
+    }
+    }
+}
+
+std::string DecodeUri(std::string_view uri)
+{
+    std::string out;
+    out.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); ++i)
+    {
+        unsigned int code = 0;
+        if (uri[i] == '%' && i + 2 < uri.size()
+            && std::from_chars(uri.data() + i + 1, uri.data() + i + 3, code, 16).ptr == uri.data() + i + 3)
+        {
+            out.push_back(static_cast<char>(code));
+            i += 2;
+        }
+        else
+        {
+            out.push_back(uri[i]);
+        }
+    }
+    return out;
+}
+
+// glTF requires flat normals when none are given, so every triangle gets its own vertices.
+void GenerateFlatNormals(MeshGeometry& geometry)
+{
+    std::vector<MeshVertex> flat;
+    flat.reserve(geometry.indices.size());
+    for (size_t i = 0; i + 2 < geometry.indices.size(); i += 3)
+    {
+        MeshVertex a = geometry.vertices[geometry.indices[i]];
+        MeshVertex b = geometry.vertices[geometry.indices[i + 1]];
+        MeshVertex c = geometry.vertices[geometry.indices[i + 2]];
+        const MATH::Vec3f ab {b.position.x - a.position.x, b.position.y - a.position.y, b.position.z - a.position.z};
+        const MATH::Vec3f ac {c.position.x - a.position.x, c.position.y - a.position.y, c.position.z - a.position.z};
+        MATH::Vec3f normal {ab.y * ac.z - ab.z * ac.y, ab.z * ac.x - ab.x * ac.z, ab.x * ac.y - ab.y * ac.x};
+        normal = normal.Length() > 0.0F ? normal.Normalized() : MATH::Vec3f {0.0F, 1.0F, 0.0F};
+        a.normal = normal;
+        b.normal = normal;
+        c.normal = normal;
+        flat.insert(flat.end(), {a, b, c});
+    }
+    geometry.vertices = std::move(flat);
+    geometry.indices.resize(geometry.vertices.size());
+    for (uint32_t i = 0; i < geometry.indices.size(); ++i)
+    {
+        geometry.indices[i] = i;
+    }
+}
+}  // namespace
+
+GltfImporter::GltfImporter(const std::filesystem::path& path)
+    : file_(path)
+{
+    const std::span<const uint8_t> bytes = file_.Bytes();
+    if (bytes.size() >= 4 && ReadU32(bytes, 0) == kGlbMagic)
+    {
+        ParseGlb();
+    }
+    else
+    {
+        json_ = JsonValue::Parse(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+        ResolveBuffers({});
+    }
+
+    if (!json_["asset"]["version"].AsString().starts_with("2."))
+    {
+        throw std::runtime_error(path.string() + " is not a glTF 2.0 asset");
+    }
+}
+
+const std::filesystem::path& GltfImporter::Path() const
+{
+    return file_.Path();
+}
+
+std::vector<std::filesystem::path> GltfImporter::SourceFiles() const
+{
+    std::vector<std::filesystem::path> files;
+    files.reserve(1 + external_buffers_.size());
+    files.push_back(Path());
+    for (const MappedFile& buffer : external_buffers_)
+    {
+        files.push_back(buffer.Path());
+    }
+    return files;
+}
+
+uint32_t GltfImporter::MeshCount() const
+{
+    return static_cast<uint32_t>(json_["meshes"].Size());
+}
+
+const std::string& GltfImporter::MeshName(uint32_t mesh) const
+{
+    return json_["meshes"][mesh]["name"].AsString();
+}
+
+uint32_t GltfImporter::PrimitiveCount(uint32_t mesh) const
+{
+    return static_cast<uint32_t>(json_["meshes"][mesh]["primitives"].Size());
+}
+
+int32_t GltfImporter::FindMesh(std::string_view sub_asset) const
+{
+    const uint32_t count = MeshCount();
+    if (sub_asset.empty())
+    {
+        return count > 0 ? 0 : -1;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (MeshName(i) == sub_asset)
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+    // Fall back to an index, so unnamed meshes stay addressable as "file.glb#2".
+    uint32_t index = 0;
+    const auto [ptr, ec] = std::from_chars(sub_asset.data(), sub_asset.data() + sub_asset.size(), index);
+    if (ec == std::errc {} && ptr == sub_asset.data() + sub_asset.size() && index < count)
+    {
+        return static_cast<int32_t>(index);
+    }
+    return -1;
+}
+
+ImportedPrimitive GltfImporter::DecodePrimitive(uint32_t mesh, uint32_t primitive, const GltfImportSettings& settings) const
+{
+    const JsonValue& node = json_["meshes"][mesh]["primitives"][primitive];
+    if (!node)
+    {
+        throw std::runtime_error(
+            "glTF mesh " + std::to_string(mesh) + " has no primitive " + std::to_string(primitive));
+    }
+
+    ImportedPrimitive result {};
+    result.material = static_cast<int32_t>(node["material"].AsInt(-1));
+    const int64_t mode = node["mode"].AsInt(kModeTriangles);
+    if (mode != kModeTriangles && mode != kModeTriangleStrip && mode != kModeTriangleFan)
+    {
+        return result;
+    }
+
+    const JsonValue& attributes = node["attributes"];
+    if (!attributes["POSITION"])
+    {
+        throw std::runtime_error("glTF primitive has no POSITION attribute");
+    }
+    const AccessorView positions = Accessor(attributes["POSITION"].AsInt(-1));
+    if (positions.component_type != kFloat || positions.components != 3)
+    {
+        throw std::runtime_error("glTF POSITION must be a float VEC3 accessor");
+    }
+
+    MeshGeometry& geometry = result.geometry;
+    std::vector<MeshVertex>& vertices = geometry.vertices;
+    vertices.resize(positions.count);
+    for (size_t i = 0; i < positions.count; ++i)
+    {
+        std::memcpy(&vertices[i].position, positions.data + i * positions.stride, sizeof(float) * 3);
+    }
+
+    // Reads up to max_components of an optional attribute into each vertex through write.
+    const auto decode = [&](const char* name, uint32_t max_components, auto write) {
+        const JsonValue& index = attributes[name];
+        if (!index)
+        {
+            return false;
+        }
+        const AccessorView view = Accessor(index.AsInt(-1));
+        if (view.count != vertices.size())
+        {
+            throw std::runtime_error(std::string("glTF attribute ") + name + " does not match the vertex count");
+        }
+        const uint32_t components = std::min(view.components, max_components);
+        const uint32_t component_size = ComponentSize(view.component_type);
+        float values[4] = {0.0F, 0.0F, 0.0F, 0.0F};
+        for (size_t i = 0; i < view.count; ++i)
+        {
+            const uint8_t* element = view.data + i * view.stride;
+            if (view.component_type == kFloat)
+            {
+                std::memcpy(values, element, sizeof(float) * components);
+            }
+            else
+            {
+                for (uint32_t c = 0; c < components; ++c)
+                {
+                    values[c] = ReadComponent(element + c * component_size, view.component_type, view.normalized);
+                }
+            }
+            write(vertices[i], values);
+        }
+        return true;
+    };
+    const bool has_normals = decode("NORMAL", 3, [](MeshVertex& v, const float* f) {
+        v.normal = MATH::Vec3f{f[0], f[1], f[2]};
+    });
+    decode("TEXCOORD_0", 2, [](MeshVertex& v, const float* f) { v.uv = MATH::Vec2f{f[0], f[1]}; });
+    decode("TANGENT", 3, [](MeshVertex& v, const float* f) { v.tangent = MATH::Vec3f{f[0], f[1], f[2]}; });
+
+    std::vector<uint32_t> source;
+    if (const JsonValue& index = node["indices"])
+    {
+        const AccessorView view = Accessor(index.AsInt(-1));
+        if (view.components != 1
+            || (view.component_type != kUnsignedByte && view.component_type != kUnsignedShort
+                && view.component_type != kUnsignedInt))
+        {
+            throw std::runtime_error("glTF indices must be an unsigned integer SCALAR accessor");
+        }
+        source.resize(view.count);
+        for (size_t i = 0; i < view.count; ++i)
+        {
+            const uint8_t* element = view.data + i * view.stride;
+            uint32_t value = 0;
+            if (view.component_type == kUnsignedByte)
+            {
+                value = *element;
+            }
+            else if (view.component_type == kUnsignedShort)
+            {
+                uint16_t value16 = 0;
+                std::memcpy(&value16, element, sizeof(value16));
+                value = value16;
+            }
+            else
+            {
+                std::memcpy(&value, element, sizeof(value));
+            }
+            if (value >= vertices.size())
+            {
+                throw std::runtime_error("glTF index out of range");
+            }
+            source[i] = value;
+        }
+    }
+    else
+    {
+        source.resize(vertices.size());
+        for (uint32_t i = 0; i < source.size(); ++i)
+        {
+            source[i] = i;
+        }
+    }
+
+    if (mode == kModeTriangles)
+    {
+        source.resize(source.size() - source.size() % 3);
+        geometry.indices = std::move(source);
+    }
+    else
+    {
+        geometry.indices.reserve(source.size() >= 3 ? (source.size() - 2) * 3 : 0);
+        for (size_t i = 0; i + 2 < source.size(); ++i)
+        {
+            uint32_t a = 0;
+            uint32_t b = 0;
+            uint32_t c = 0;
+            if (mode == kModeTriangleStrip)
+            {
+                // Odd triangles swap their first two corners to keep the winding.
+                a = source[i + (i & 1U)];
+                b = source[i + 1 - (i & 1U)];
+                c = source[i + 2];
+            }
+            else
+            {
+                a = source[i + 1];
+                b = source[i + 2];
+                c = source[0];
+            }
+            if (a != b && b != c && a != c)
+            {
+                geometry.indices.insert(geometry.indices.end(), {a, b, c});
+            }
+        }
+    }
+
+    if (!has_normals)
+    {
+        GenerateFlatNormals(geometry);
+    }
+    if (settings.optimize && !geometry.Empty())
+    {
+        result.optimization = OptimizeMesh(geometry, settings.optimization);
+    }
+    if (settings.pack && !geometry.Empty())
+    {
+        result.packed = PackMesh(geometry, settings.packed_format);
+    }
+    return result;
+}
+
+std::vector<ImportedMesh> GltfImporter::ImportMeshes(
+    std::span<const uint32_t> meshes, JobSystem& jobs, const GltfImportSettings& settings) const
+{
+    struct Task
+    {
+        uint32_t slot = 0;
+        uint32_t primitive = 0;
+    };
+
+    std::vector<ImportedMesh> result(meshes.size());
+    std::vector<Task> tasks;
+    for (uint32_t slot = 0; slot < meshes.size(); ++slot)
+    {
+        const uint32_t mesh = meshes[slot];
+        if (mesh >= MeshCount())
+        {
+            throw std::runtime_error(Path().string() + " has no mesh " + std::to_string(mesh));
+        }
+        result[slot].name = MeshName(mesh);
+        result[slot].primitives.resize(PrimitiveCount(mesh));
+        for (uint32_t p = 0; p < PrimitiveCount(mesh); ++p)
+        {
+            tasks.push_back(Task{slot, p});
+        }
+    }
+
+    // ParallelFor must not unwind through its workers; keep the first failure and rethrow.
+    std::vector<std::exception_ptr> errors(tasks.size());
+    jobs.ParallelFor(tasks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const Task& task = tasks[i];
+            try
+            {
+                result[task.slot].primitives[task.primitive] =
+                    DecodePrimitive(meshes[task.slot], task.primitive, settings);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    });
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::vector<MeshOptimizeReport> reports;
+    for (ImportedMesh& mesh : result)
+    {
+        std::erase_if(mesh.primitives, [](const ImportedPrimitive& p) { return p.geometry.Empty(); });
+        reports.clear();
+        for (const ImportedPrimitive& primitive : mesh.primitives)
+        {
+            reports.push_back(primitive.optimization);
+        }
+        mesh.optimization = CombineReports(reports);
+    }
+    return result;
+}
+
+void GltfImporter::ParseGlb()
+{
+    const std::span<const uint8_t> bytes = file_.Bytes();
+    if (bytes.size() < 20 || ReadU32(bytes, 4) != 2 || ReadU32(bytes, 8) > bytes.size())
+    {
+        throw std::runtime_error(Path().string() + " has an invalid GLB header");
+    }
+
+    const size_t length = ReadU32(bytes, 8);
+    std::span<const uint8_t> json_chunk;
+    std::span<const uint8_t> binary_chunk;
+    for (size_t offset = 12; offset + 8 <= length;)
+    {
+        const size_t chunk_length = ReadU32(bytes, offset);
+        const uint32_t chunk_type = ReadU32(bytes, offset + 4);
+        if (offset + 8 + chunk_length > length)
+        {
+            throw std::runtime_error(Path().string() + " has a truncated GLB chunk");
+        }
+        const std::span<const uint8_t> chunk = bytes.subspan(offset + 8, chunk_length);
+        if (chunk_type == kChunkJson && json_chunk.empty())
+        {
+            json_chunk = chunk;
+        }
+        else if (chunk_type == kChunkBinary && binary_chunk.empty())
+        {
+            binary_chunk = chunk;
+        }
+        offset += 8 + chunk_length;
+    }
+    if (json_chunk.empty())
+    {
+        throw std::runtime_error(Path().string() + " has no JSON chunk");
+    }
+
+    json_ = JsonValue::Parse(std::string_view(reinterpret_cast<const char*>(json_chunk.data()), json_chunk.size()));
+    ResolveBuffers(binary_chunk);
+}
+
+void GltfImporter::ResolveBuffers(std::span<const uint8_t> glb_binary)
+{
+    const JsonValue& buffers = json_["buffers"];
+    for (size_t i = 0; i < buffers.Size(); ++i)
+    {
+        const JsonValue& buffer = buffers[i];
+        const auto byte_length = static_cast<size_t>(std::max<int64_t>(buffer["byteLength"].AsInt(0), 0));
+        const std::string& uri = buffer["uri"].AsString();
+
+        std::span<const uint8_t> data;
+        if (uri.empty())
+        {
+            if (i != 0 || glb_binary.empty())
+            {
+                throw std::runtime_error(Path().string() + ": buffer " + std::to_string(i) + " has no data");
+            }
+            data = glb_binary;
+        }
+        else if (uri.starts_with("data:"))
+        {
+            throw std::runtime_error(Path().string() + ": embedded data URIs are not supported, export as .glb");
+        }
+        else
+        {
+            // The mapping address survives moves, so spans into it stay valid as the vector grows.
+            const std::string relative = DecodeUri(uri);
+            external_buffers_.emplace_back(Path().parent_path() / std::u8string(relative.begin(), relative.end()));
+            data = external_buffers_.back().Bytes();
+        }
+
+        if (data.size() < byte_length)
+        {
+            throw std::runtime_error(Path().string() + ": buffer " + std::to_string(i) + " is truncated");
+        }
+        buffers_.push_back(data.first(byte_length));
+    }
+}
+
+GltfImporter::AccessorView GltfImporter::Accessor(int64_t index) const
+{
+    const JsonValue& accessor = json_["accessors"][static_cast<size_t>(std::max<int64_t>(index, 0))];
+    if (index < 0 || !accessor)
+    {
+        throw std::runtime_error("glTF accessor " + std::to_string(index) + " does not exist");
+    }
+    if (accessor["sparse"])
+    {
+        throw std::runtime_error("glTF sparse accessors are not supported");
+    }
+    const JsonValue& view = json_["bufferViews"][static_cast<size_t>(std::max<int64_t>(accessor["bufferView"].AsInt(-1), 0))];
+    if (!accessor["bufferView"] || !view)
+    {
+        throw std::runtime_error("glTF accessor " + std::to_string(index) + " has no buffer view");
+    }
+
+    AccessorView result {};
+    result.component_type = static_cast<uint32_t>(accessor["componentType"].AsInt(0));
+    result.components = ComponentCount(accessor["type"].AsString());
+    result.normalized = accessor["normalized"].AsBool(false);
+    result.count = static_cast<size_t>(std::max<int64_t>(accessor["count"].AsInt(0), 0));
+
+    const auto buffer = static_cast<size_t>(std::max<int64_t>(view["buffer"].AsInt(-1), -1));
+    if (buffer >= buffers_.size())
+    {
+        throw std::runtime_error("glTF buffer view references a missing buffer");
+    }
+    const auto view_offset = static_cast<uint64_t>(std::max<int64_t>(view["byteOffset"].AsInt(0), 0));
+    const auto view_length = static_cast<uint64_t>(std::max<int64_t>(view["byteLength"].AsInt(0), 0));
+    const auto accessor_offset = static_cast<uint64_t>(std::max<int64_t>(accessor["byteOffset"].AsInt(0), 0));
+    const uint64_t element_size = static_cast<uint64_t>(ComponentSize(result.component_type)) * result.components;
+    const auto byte_stride = static_cast<uint64_t>(std::max<int64_t>(view["byteStride"].AsInt(0), 0));
+    result.stride = static_cast<size_t>(byte_stride != 0 ? byte_stride : element_size);
+
+    const uint64_t needed = result.count == 0 ? 0 : accessor_offset + result.stride * (result.count - 1) + element_size;
+    if (view_offset + view_length > buffers_[buffer].size() || needed > view_length)
+    {
+        throw std::runtime_error("glTF accessor " + std::to_string(index) + " reads past its buffer");
+    }
+    result.data = buffers_[buffer].data() + view_offset + accessor_offset;
+    return result;
+}
+
+MeshGeometry MergePrimitives(const ImportedMesh& mesh)
+{
+    MeshGeometry merged;
+    size_t vertex_count = 0;
+    size_t index_count = 0;
+    for (const ImportedPrimitive& primitive : mesh.primitives)
+    {
+        vertex_count += primitive.geometry.vertices.size();
+        index_count += primitive.geometry.indices.size();
+    }
+    merged.vertices.reserve(vertex_count);
+    merged.indices.reserve(index_count);
+    for (const ImportedPrimitive& primitive : mesh.primitives)
+    {
+        const auto base = static_cast<uint32_t>(merged.vertices.size());
+        merged.vertices.insert(merged.vertices.end(), primitive.geometry.vertices.begin(), primitive.geometry.vertices.end());
+        for (const uint32_t index : primitive.geometry.indices)
+        {
+            merged.indices.push_back(base + index);
+        }
+    }
+    return merged;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
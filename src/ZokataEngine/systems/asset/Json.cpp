@@ -0,0 +1,376 @@
+#include "ZokataEngine/systems/asset/Json.h"
+
+#include <charconv>
+#include <stdexcept>
+#include <system_error>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint32_t kMaxDepth = 256;
+
+const JsonValue& NullValue()
+{
+    static const JsonValue null_value {};
+    return null_value;
+}
+
+const std::string& EmptyString()
+{
+    static const std::string empty {};
+    return empty;
+}
+
+void AppendUtf8(std::string& out, uint32_t code_point)
+{
+    if (code_point < 0x80)
+    {
+        out.push_back(static_cast<char>(code_point));
+    }
+    else if (code_point < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else if (code_point < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+}  // namespace
+
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string_view text)
+        : text_(text)
+    {
+    }
+
+    JsonValue ParseDocument()
+    {
+        JsonValue value = ParseValue(0);
+        SkipWhitespace();
+        if (pos_ != text_.size())
+        {
+            Fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    std::string_view text_;
+    size_t pos_ = 0;
+
+    [[noreturn]] void Fail(const char* what) const
+    {
+        throw std::runtime_error(std::string("JSON parse error at byte ") + std::to_string(pos_) + ": " + what);
+    }
+
+    void SkipWhitespace()
+    {
+        while (pos_ < text_.size()
+               && (text_[pos_] == ' ' || text_[pos_] == '\n' || text_[pos_] == '\r' || text_[pos_] == '\t'))
+        {
+            ++pos_;
+        }
+    }
+
+    bool Consume(char c)
+    {
+        SkipWhitespace();
+        if (pos_ < text_.size() && text_[pos_] == c)
+        {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void Expect(char c)
+    {
+        if (!Consume(c))
+        {
+            Fail("unexpected character");
+        }
+    }
+
+    bool ConsumeLiteral(std::string_view literal)
+    {
+        if (text_.substr(pos_, literal.size()) == literal)
+        {
+            pos_ += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    JsonValue ParseValue(uint32_t depth)
+    {
+        if (depth > kMaxDepth)
+        {
+            Fail("nesting too deep");
+        }
+        SkipWhitespace();
+        if (pos_ >= text_.size())
+        {
+            Fail("unexpected end of input");
+        }
+
+        JsonValue value;
+        const char c = text_[pos_];
+        if (c == '{')
+        {
+            ++pos_;
+            value.type_ = JsonValue::Type::Object;
+            if (Consume('}'))
+            {
+                return value;
+            }
+            do
+            {
+                SkipWhitespace();
+                std::string key = ParseString();
+                Expect(':');
+                value.members_.emplace_back(std::move(key), ParseValue(depth + 1));
+            } while (Consume(','));
+            Expect('}');
+        }
+        else if (c == '[')
+        {
+            ++pos_;
+            value.type_ = JsonValue::Type::Array;
+            if (Consume(']'))
+            {
+                return value;
+            }
+            do
+            {
+                value.items_.push_back(ParseValue(depth + 1));
+            } while (Consume(','));
+            Expect(']');
+        }
+        else if (c == '"')
+        {
+            value.type_ = JsonValue::Type::String;
+            value.string_ = ParseString();
+        }
+        else if (ConsumeLiteral("true") || ConsumeLiteral("false"))
+        {
+            value.type_ = JsonValue::Type::Bool;
+            value.bool_ = c == 't';
+        }
+        else if (ConsumeLiteral("null"))
+        {
+            value.type_ = JsonValue::Type::Null;
+        }
+        else
+        {
+            value.type_ = JsonValue::Type::Number;
+            const char* begin = text_.data() + pos_;
+            const char* end = text_.data() + text_.size();
+            const auto [ptr, ec] = std::from_chars(begin, end, value.number_);
+            if (ec != std::errc {} || ptr == begin)
+            {
+                Fail("invalid value");
+            }
+            pos_ += static_cast<size_t>(ptr - begin);
+        }
+        return value;
+    }
+
+    uint32_t ParseHex4()
+    {
+        if (pos_ + 4 > text_.size())
+        {
+            Fail("truncated escape");
+        }
+        uint32_t code = 0;
+        const auto [ptr, ec] = std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, code, 16);
+        if (ec != std::errc {} || ptr != text_.data() + pos_ + 4)
+        {
+            Fail("invalid escape");
+        }
+        pos_ += 4;
+        return code;
+    }
+
+    std::string ParseString()
+    {
+        if (pos_ >= text_.size() || text_[pos_] != '"')
+        {
+            Fail("expected string");
+        }
+        ++pos_;
+        std::string out;
+        while (true)
+        {
+            // Copy unescaped runs in one go; most glTF strings have no escapes at all.
+            const size_t run_end = text_.find_first_of("\"\\", pos_);
+            if (run_end == std::string_view::npos)
+            {
+                Fail("unterminated string");
+            }
+            out.append(text_.substr(pos_, run_end - pos_));
+            pos_ = run_end + 1;
+            if (text_[run_end] == '"')
+            {
+                return out;
+            }
+            if (pos_ >= text_.size())
+            {
+                Fail("unterminated string");
+            }
+            const char escape = text_[pos_++];
+            switch (escape)
+            {
+            case '"':
+                out.push_back('"');
+                break;
+            case '\\':
+                out.push_back('\\');
+                break;
+            case '/':
+                out.push_back('/');
+                break;
+            case 'b':
+                out.push_back('\b');
+                break;
+            case 'f':
+                out.push_back('\f');
+                break;
+            case 'n':
+                out.push_back('\n');
+                break;
+            case 'r':
+                out.push_back('\r');
+                break;
+            case 't':
+                out.push_back('\t');
+                break;
+            case 'u':
+            {
+                uint32_t code = ParseHex4();
+                if (code >= 0xD800 && code < 0xDC00 && ConsumeLiteral("\\u"))
+                {
+                    const uint32_t low = ParseHex4();
+                    if (low >= 0xDC00 && low < 0xE000)
+                    {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                }
+                AppendUtf8(out, code);
+                break;
+            }
+            default:
+                Fail("invalid escape");
+            }
+        }
+    }
+};
+
+JsonValue JsonValue::Parse(std::string_view text)
+{
+    return JsonParser(text).ParseDocument();
+}
+
+JsonValue::Type JsonValue::GetType() const
+{
+    return type_;
+}
+
+bool JsonValue::IsNull() const
+{
+    return type_ == Type::Null;
+}
+
+bool JsonValue::IsNumber() const
+{
+    return type_ == Type::Number;
+}
+
+bool JsonValue::IsString() const
+{
+    return type_ == Type::String;
+}
+
+bool JsonValue::IsArray() const
+{
+    return type_ == Type::Array;
+}
+
+bool JsonValue::IsObject() const
+{
+    return type_ == Type::Object;
+}
+
+JsonValue::operator bool() const
+{
+    return type_ != Type::Null;
+}
+
+bool JsonValue::AsBool(bool fallback) const
+{
+    return type_ == Type::Bool ? bool_ : fallback;
+}
+
+double JsonValue::AsNumber(double fallback) const
+{
+    return type_ == Type::Number ? number_ : fallback;
+}
+
+int64_t JsonValue::AsInt(int64_t fallback) const
+{
+    return type_ == Type::Number ? static_cast<int64_t>(number_) : fallback;
+}
+
+const std::string& JsonValue::AsString() const
+{
+    return type_ == Type::String ? string_ : EmptyString();
+}
+
+size_t JsonValue::Size() const
+{
+    return type_ == Type::Array ? items_.size() : members_.size();
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const
+{
+    return index < items_.size() ? items_[index] : NullValue();
+}
+
+const JsonValue& JsonValue::operator[](std::string_view key) const
+{
+    for (const auto& [name, value] : members_)
+    {
+        if (name == key)
+        {
+            return value;
+        }
+    }
+    return NullValue();
+}
+
+const std::vector<JsonValue>& JsonValue::Items() const
+{
+    return items_;
+}
+
+const std::vector<std::pair<std::string, JsonValue>>& JsonValue::Members() const
+{
+    return members_;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
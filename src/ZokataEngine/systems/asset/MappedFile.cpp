@@ -0,0 +1,160 @@
+#include "ZokataEngine/systems/asset/MappedFile.h"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ZKT
+{
+namespace ENGINE
+{
+MappedFile::MappedFile(const std::filesystem::path& path)
+    : path_(path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileW(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+    LARGE_INTEGER size {};
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Failed to query the size of " + path.string());
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ > 0)
+    {
+        mapping_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ != nullptr)
+        {
+            data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+    CloseHandle(file);
+    if (size_ > 0 && data_ == nullptr)
+    {
+        Unmap();
+        throw std::runtime_error("Failed to map " + path.string());
+    }
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("Failed to query the size of " + path.string());
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ > 0)
+    {
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            data_ = static_cast<const uint8_t*>(data);
+            // Importers walk buffers front to back; let the kernel read ahead aggressively.
+            madvise(data, size_, MADV_WILLNEED);
+        }
+    }
+    close(fd);
+    if (size_ > 0 && data_ == nullptr)
+    {
+        size_ = 0;
+        throw std::runtime_error("Failed to map " + path.string());
+    }
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    Unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : path_(std::move(other.path_))
+    , data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+#ifdef _WIN32
+    , mapping_(std::exchange(other.mapping_, nullptr))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Unmap();
+        path_ = std::move(other.path_);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+const std::filesystem::path& MappedFile::Path() const
+{
+    return path_;
+}
+
+std::span<const uint8_t> MappedFile::Bytes() const
+{
+    return {data_, size_};
+}
+
+size_t MappedFile::Size() const
+{
+    return size_;
+}
+
+bool MappedFile::Empty() const
+{
+    return size_ == 0;
+}
+
+void MappedFile::Unmap()
+{
+#ifdef _WIN32
+    if (data_ != nullptr)
+    {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr)
+    {
+        CloseHandle(mapping_);
+    }
+    mapping_ = nullptr;
+#else
+    if (data_ != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,807 @@
+#include "ZokataEngine/systems/asset/YamlReader.h"
+
+#include <charconv>
+#include <limits>
+#include <string>
+#include <system_error>
+
+#include <yaml-cpp/yaml.h>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint32_t kMaxDepth = 256;
+
+// Thrown inside the reader when the text leaves the supported subset; ReadYaml returns false.
+struct Unsupported
+{
+};
+
+bool IsBreak(char c)
+{
+    return c == '\n' || c == '\r';
+}
+
+bool IsFlowIndicator(char c)
+{
+    return c == ',' || c == '[' || c == ']' || c == '{' || c == '}';
+}
+
+int HexDigit(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void AppendUtf8(std::string& out, uint32_t code_point)
+{
+    if (code_point < 0x80)
+    {
+        out.push_back(static_cast<char>(code_point));
+    }
+    else if (code_point < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else if (code_point < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+/**
+ * Indentation-driven recursive descent. Block readers start at a node's first character and
+ * return positioned at the first character of the next content line (or at the end), with
+ * line_indent_ holding that line's indentation.
+ */
+class FastYamlReader
+{
+public:
+    FastYamlReader(std::string_view text, YamlHandler& handler)
+        : text_(text)
+        , handler_(handler)
+    {
+    }
+
+    void ReadDocument()
+    {
+        if (text_.starts_with("\xEF\xBB\xBF"))
+        {
+            pos_ = line_start_ = 3;
+        }
+        NextContentLine(true);
+        if (at_end_)
+        {
+            return;
+        }
+        ReadBlockNode(0);
+        if (!at_end_)
+        {
+            Fail();
+        }
+    }
+
+private:
+    std::string_view text_;
+    YamlHandler& handler_;
+    size_t pos_ = 0;
+    size_t line_start_ = 0;
+    size_t line_indent_ = 0;
+    bool at_end_ = false;
+    std::string buffer_;  // decoded quoted scalars with escapes
+
+    [[noreturn]] static void Fail()
+    {
+        throw Unsupported {};
+    }
+
+    char Peek() const
+    {
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    // Blank: space, tab, line break or the end of the text.
+    bool IsBlankAt(size_t index) const
+    {
+        return index >= text_.size() || text_[index] == ' ' || text_[index] == '\t' || IsBreak(text_[index]);
+    }
+
+    bool IsIndicatorFollowedByBlank(char indicator) const
+    {
+        return Peek() == indicator && IsBlankAt(pos_ + 1);
+    }
+
+    size_t Column() const
+    {
+        return pos_ - line_start_;
+    }
+
+    void SkipInlineSpaces()
+    {
+        while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t'))
+        {
+            ++pos_;
+        }
+    }
+
+    bool AtLineEnd() const
+    {
+        return pos_ >= text_.size() || IsBreak(text_[pos_]) || text_[pos_] == '#';
+    }
+
+    // Requires the rest of the line to be blank or a comment and moves past its line break.
+    void FinishLine()
+    {
+        SkipInlineSpaces();
+        if (Peek() == '#')
+        {
+            while (pos_ < text_.size() && text_[pos_] != '\n')
+            {
+                ++pos_;
+            }
+        }
+        if (Peek() == '\r')
+        {
+            ++pos_;
+        }
+        if (pos_ < text_.size())
+        {
+            if (text_[pos_] != '\n')
+            {
+                Fail();
+            }
+            ++pos_;
+        }
+        line_start_ = pos_;
+    }
+
+    // From the start of a line, skips blank and comment lines up to the next content.
+    void NextContentLine(bool document_start = false)
+    {
+        for (;;)
+        {
+            if (pos_ >= text_.size())
+            {
+                at_end_ = true;
+                line_indent_ = 0;
+                return;
+            }
+            size_t content = pos_;
+            while (content < text_.size() && text_[content] == ' ')
+            {
+                ++content;
+            }
+            size_t rest = content;
+            while (rest < text_.size() && text_[rest] == '\t')
+            {
+                ++rest;
+            }
+            if (rest >= text_.size() || IsBreak(text_[rest]) || text_[rest] == '#')
+            {
+                pos_ = rest;
+                FinishLine();
+                continue;
+            }
+            if (rest != content)
+            {
+                Fail();  // tabs are not allowed as indentation
+            }
+            if (content == line_start_ && (text_.substr(content, 3) == "---" || text_.substr(content, 3) == "...")
+                && IsBlankAt(content + 3))
+            {
+                // Only a leading document start marker on its own line is understood.
+                if (!document_start || text_[content] != '-')
+                {
+                    Fail();
+                }
+                pos_ = content + 3;
+                FinishLine();
+                document_start = false;
+                continue;
+            }
+            pos_ = content;
+            line_indent_ = content - line_start_;
+            return;
+        }
+    }
+
+    void CheckNodeStart() const
+    {
+        switch (Peek())
+        {
+        case '&':   // anchor
+        case '*':   // alias
+        case '!':   // tag
+        case '|':   // literal block scalar
+        case '>':   // folded block scalar
+        case '%':   // directive
+        case '@':
+        case '`':
+        case ',':
+        case ']':
+        case '}':
+            Fail();
+        case '?':
+        case ':':
+            if (IsBlankAt(pos_ + 1))
+            {
+                Fail();  // complex or empty keys
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void ReadBlockNode(uint32_t depth)
+    {
+        if (depth > kMaxDepth)
+        {
+            Fail();
+        }
+        if (IsIndicatorFollowedByBlank('-'))
+        {
+            ReadBlockSequence(Column(), depth);
+            return;
+        }
+        if (Peek() == '[' || Peek() == '{')
+        {
+            ReadFlowNode(depth);
+            FinishLine();
+            NextContentLine();
+            return;
+        }
+        const size_t column = Column();
+        CheckNodeStart();
+        const std::string_view scalar = ReadScalar(false);
+        if (IsIndicatorFollowedByBlank(':'))
+        {
+            ReadBlockMapping(column, scalar, depth);
+            return;
+        }
+        handler_.OnScalar(scalar);
+        FinishLine();
+        NextContentLine();
+    }
+
+    void ReadBlockMapping(size_t indent, std::string_view key, uint32_t depth)
+    {
+        handler_.OnMapStart();
+        for (;;)
+        {
+            handler_.OnScalar(key);
+            ++pos_;  // ':'
+            ReadBlockValue(indent, depth + 1);
+            if (at_end_ || line_indent_ < indent)
+            {
+                break;
+            }
+            if (line_indent_ > indent)
+            {
+                Fail();  // a multi-line scalar or inconsistent indentation
+            }
+            CheckNodeStart();
+            if (Peek() == '-' || Peek() == '[' || Peek() == '{')
+            {
+                Fail();
+            }
+            key = ReadScalar(false);
+            if (!IsIndicatorFollowedByBlank(':'))
+            {
+                Fail();
+            }
+        }
+        handler_.OnMapEnd();
+    }
+
+    // The value after "key:" of a block map whose keys sit at indent.
+    void ReadBlockValue(size_t indent, uint32_t depth)
+    {
+        SkipInlineSpaces();
+        if (AtLineEnd())
+        {
+            FinishLine();
+            NextContentLine();
+            if (!at_end_ && line_indent_ > indent)
+            {
+                ReadBlockNode(depth);
+            }
+            else if (!at_end_ && line_indent_ == indent && IsIndicatorFollowedByBlank('-'))
+            {
+                // A sequence may sit at its key's indentation.
+                ReadBlockSequence(indent, depth);
+            }
+            else
+            {
+                handler_.OnScalar({});
+            }
+            return;
+        }
+        if (Peek() == '[' || Peek() == '{')
+        {
+            ReadFlowNode(depth);
+            FinishLine();
+            NextContentLine();
+            return;
+        }
+        CheckNodeStart();
+        if (Peek() == '-' && IsBlankAt(pos_ + 1))
+        {
+            Fail();
+        }
+        const std::string_view scalar = ReadScalar(false);
+        if (IsIndicatorFollowedByBlank(':'))
+        {
+            Fail();  // "a: b: c"
+        }
+        handler_.OnScalar(scalar);
+        FinishLine();
+        NextContentLine();
+    }
+
+    void ReadBlockSequence(size_t indent, uint32_t depth)
+    {
+        handler_.OnSequenceStart();
+        for (;;)
+        {
+            ++pos_;  // '-'
+            SkipInlineSpaces();
+            if (AtLineEnd())
+            {
+                FinishLine();
+                NextContentLine();
+                if (!at_end_ && line_indent_ > indent)
+                {
+                    ReadBlockNode(depth + 1);
+                }
+                else
+                {
+                    handler_.OnScalar({});
+                }
+            }
+            else
+            {
+                ReadBlockNode(depth + 1);
+            }
+            if (at_end_ || line_indent_ < indent)
+            {
+                break;
+            }
+            if (line_indent_ > indent)
+            {
+                Fail();
+            }
+            if (!IsIndicatorFollowedByBlank('-'))
+            {
+                break;  // the next key of a map this sequence is the value of
+            }
+        }
+        handler_.OnSequenceEnd();
+    }
+
+    void SkipFlowSpace()
+    {
+        while (pos_ < text_.size())
+        {
+            const char c = text_[pos_];
+            if (c == ' ' || c == '\t' || c == '\r')
+            {
+                ++pos_;
+            }
+            else if (c == '\n')
+            {
+                line_start_ = ++pos_;
+            }
+            else if (c == '#')
+            {
+                while (pos_ < text_.size() && text_[pos_] != '\n')
+                {
+                    ++pos_;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    void ReadFlowNode(uint32_t depth)
+    {
+        if (depth > kMaxDepth)
+        {
+            Fail();
+        }
+        const bool is_map = text_[pos_++] == '{';
+        const char close = is_map ? '}' : ']';
+        if (is_map)
+        {
+            handler_.OnMapStart();
+        }
+        else
+        {
+            handler_.OnSequenceStart();
+        }
+
+        SkipFlowSpace();
+        while (Peek() != close)
+        {
+            if (is_map)
+            {
+                CheckNodeStart();
+                if (Peek() == '[' || Peek() == '{')
+                {
+                    Fail();
+                }
+                const std::string_view key = ReadScalar(true);
+                SkipFlowSpace();
+                if (Peek() != ':')
+                {
+                    Fail();  // implicit null values ("{a, b}")
+                }
+                handler_.OnScalar(key);
+                ++pos_;
+                SkipFlowSpace();
+                if (Peek() == ',' || Peek() == close)
+                {
+                    handler_.OnScalar({});
+                }
+                else
+                {
+                    ReadFlowValue(depth + 1);
+                }
+            }
+            else
+            {
+                ReadFlowValue(depth + 1);
+                SkipFlowSpace();
+                if (Peek() == ':')
+                {
+                    Fail();  // single-pair maps ("[a: b]")
+                }
+            }
+
+            SkipFlowSpace();
+            if (Peek() == ',')
+            {
+                ++pos_;
+                SkipFlowSpace();
+            }
+            else if (Peek() != close)
+            {
+                Fail();
+            }
+        }
+        ++pos_;
+
+        if (is_map)
+        {
+            handler_.OnMapEnd();
+        }
+        else
+        {
+            handler_.OnSequenceEnd();
+        }
+    }
+
+    void ReadFlowValue(uint32_t depth)
+    {
+        if (Peek() == '[' || Peek() == '{')
+        {
+            ReadFlowNode(depth);
+            return;
+        }
+        CheckNodeStart();
+        handler_.OnScalar(ReadScalar(true));
+    }
+
+    std::string_view ReadScalar(bool flow)
+    {
+        if (Peek() == '"')
+        {
+            return ReadDoubleQuoted();
+        }
+        if (Peek() == '\'')
+        {
+            return ReadSingleQuoted();
+        }
+        return ReadPlain(flow);
+    }
+
+    std::string_view ReadPlain(bool flow)
+    {
+        const size_t start = pos_;
+        size_t end = pos_;
+        while (pos_ < text_.size())
+        {
+            const char c = text_[pos_];
+            if (IsBreak(c))
+            {
+                break;
+            }
+            if (c == ':' && (IsBlankAt(pos_ + 1) || (flow && IsFlowIndicator(text_[pos_ + 1]))))
+            {
+                break;
+            }
+            if (c == '#' && pos_ > start && (text_[pos_ - 1] == ' ' || text_[pos_ - 1] == '\t'))
+            {
+                break;
+            }
+            if (flow && IsFlowIndicator(c))
+            {
+                break;
+            }
+            ++pos_;
+            if (c != ' ' && c != '\t')
+            {
+                end = pos_;
+            }
+        }
+        if (end == start)
+        {
+            Fail();
+        }
+        return text_.substr(start, end - start);
+    }
+
+    std::string_view ReadSingleQuoted()
+    {
+        const size_t start = ++pos_;
+        for (;;)
+        {
+            if (pos_ >= text_.size() || IsBreak(text_[pos_]))
+            {
+                Fail();  // unterminated, or continued on the next line
+            }
+            if (text_[pos_] == '\'')
+            {
+                if (pos_ + 1 < text_.size() && text_[pos_ + 1] == '\'')
+                {
+                    break;  // '' escape: decode below
+                }
+                return text_.substr(start, pos_++ - start);
+            }
+            ++pos_;
+        }
+
+        buffer_.assign(text_.substr(start, pos_ - start));
+        for (;;)
+        {
+            if (pos_ >= text_.size() || IsBreak(text_[pos_]))
+            {
+                Fail();
+            }
+            const char c = text_[pos_++];
+            if (c != '\'')
+            {
+                buffer_.push_back(c);
+            }
+            else if (Peek() == '\'')
+            {
+                buffer_.push_back('\'');
+                ++pos_;
+            }
+            else
+            {
+                return buffer_;
+            }
+        }
+    }
+
+    std::string_view ReadDoubleQuoted()
+    {
+        const size_t start = ++pos_;
+        for (;;)
+        {
+            if (pos_ >= text_.size() || IsBreak(text_[pos_]))
+            {
+                Fail();
+            }
+            if (text_[pos_] == '"')
+            {
+                return text_.substr(start, pos_++ - start);
+            }
+            if (text_[pos_] == '\\')
+            {
+                break;
+            }
+            ++pos_;
+        }
+
+        buffer_.assign(text_.substr(start, pos_ - start));
+        for (;;)
+        {
+            if (pos_ >= text_.size() || IsBreak(text_[pos_]))
+            {
+                Fail();
+            }
+            const char c = text_[pos_++];
+            if (c == '"')
+            {
+                return buffer_;
+            }
+            if (c != '\\')
+            {
+                buffer_.push_back(c);
+                continue;
+            }
+            if (pos_ >= text_.size())
+            {
+                Fail();
+            }
+            const char escape = text_[pos_++];
+            switch (escape)
+            {
+            case '0': buffer_.push_back('\0'); break;
+            case 'a': buffer_.push_back('\a'); break;
+            case 'b': buffer_.push_back('\b'); break;
+            case 't':
+            case '\t': buffer_.push_back('\t'); break;
+            case 'n': buffer_.push_back('\n'); break;
+            case 'v': buffer_.push_back('\v'); break;
+            case 'f': buffer_.push_back('\f'); break;
+            case 'r': buffer_.push_back('\r'); break;
+            case 'e': buffer_.push_back('\x1B'); break;
+            case ' ':
+            case '"':
+            case '/':
+            case '\\': buffer_.push_back(escape); break;
+            case 'N': AppendUtf8(buffer_, 0x85); break;
+            case '_': AppendUtf8(buffer_, 0xA0); break;
+            case 'L': AppendUtf8(buffer_, 0x2028); break;
+            case 'P': AppendUtf8(buffer_, 0x2029); break;
+            case 'x': AppendUtf8(buffer_, ReadHex(2)); break;
+            case 'u': AppendUtf8(buffer_, ReadHex(4)); break;
+            case 'U': AppendUtf8(buffer_, ReadHex(8)); break;
+            default: Fail();
+            }
+        }
+    }
+
+    uint32_t ReadHex(size_t digits)
+    {
+        uint32_t value = 0;
+        for (size_t i = 0; i < digits; ++i)
+        {
+            const int digit = HexDigit(Peek());
+            if (digit < 0)
+            {
+                Fail();
+            }
+            value = (value << 4) | static_cast<uint32_t>(digit);
+            ++pos_;
+        }
+        if (value > 0x10FFFF)
+        {
+            Fail();
+        }
+        return value;
+    }
+};
+
+void Replay(const YAML::Node& node, YamlHandler& handler)
+{
+    switch (node.Type())
+    {
+    case YAML::NodeType::Scalar:
+        handler.OnScalar(node.Scalar());
+        break;
+    case YAML::NodeType::Sequence:
+        handler.OnSequenceStart();
+        for (const auto& item : node)
+        {
+            Replay(item, handler);
+        }
+        handler.OnSequenceEnd();
+        break;
+    case YAML::NodeType::Map:
+        handler.OnMapStart();
+        for (const auto& kv : node)
+        {
+            if (kv.first.IsScalar())
+            {
+                handler.OnScalar(kv.first.Scalar());
+                Replay(kv.second, handler);
+            }
+        }
+        handler.OnMapEnd();
+        break;
+    default:
+        handler.OnScalar({});
+        break;
+    }
+}
+}  // namespace
+
+bool ReadYaml(std::string_view text, YamlHandler& handler)
+{
+    try
+    {
+        FastYamlReader(text, handler).ReadDocument();
+        return true;
+    }
+    catch (const Unsupported&)
+    {
+        return false;
+    }
+}
+
+void ReadYamlWithYamlCpp(std::string_view text, YamlHandler& handler)
+{
+    Replay(YAML::Load(std::string(text)), handler);
+}
+
+bool ParseYamlFloat(std::string_view text, float& value)
+{
+    if (text.starts_with('+'))
+    {
+        text.remove_prefix(1);
+    }
+    if (text.empty())
+    {
+        return false;
+    }
+    float parsed = 0.0F;
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+    if (ec == std::errc {} && ptr == text.data() + text.size())
+    {
+        value = parsed;
+        return true;
+    }
+
+    const bool negative = text.front() == '-';
+    const std::string_view word = negative ? text.substr(1) : text;
+    if (word == ".inf" || word == ".Inf" || word == ".INF")
+    {
+        value = negative ? -std::numeric_limits<float>::infinity() : std::numeric_limits<float>::infinity();
+        return true;
+    }
+    if (!negative && (word == ".nan" || word == ".NaN" || word == ".NAN"))
+    {
+        value = std::numeric_limits<float>::quiet_NaN();
+        return true;
+    }
+    return false;
+}
+
+bool ParseYamlInt(std::string_view text, int64_t& value)
+{
+    if (text.starts_with('+'))
+    {
+        text.remove_prefix(1);
+    }
+    int64_t parsed = 0;
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+    if (text.empty() || ec != std::errc {} || ptr != text.data() + text.size())
+    {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
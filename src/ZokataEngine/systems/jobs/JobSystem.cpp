@@ -0,0 +1,152 @@
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+JobSystem::JobSystem(uint32_t worker_count)
+{
+    if (worker_count == 0)
+    {
+        const uint32_t hw = std::thread::hardware_concurrency();
+        worker_count = std::max(1U, hw > 1 ? hw - 1 : 1U);
+    }
+
+    workers_.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+JobSystem& JobSystem::Default()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+uint32_t JobSystem::WorkerCount() const
+{
+    return static_cast<uint32_t>(workers_.size());
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    grain = std::max<size_t>(1, grain);
+    const size_t chunk_count = (count + grain - 1) / grain;
+    if (chunk_count == 1)
+    {
+        fn(0, count);
+        return;
+    }
+
+    struct Shared
+    {
+        std::atomic<size_t> next_chunk {0};
+        std::atomic<size_t> done_chunks {0};
+        std::atomic<bool> failed {false};
+        std::exception_ptr error;  // written once, by whoever set failed first
+    };
+    auto shared = std::make_shared<Shared>();
+
+    const auto run_chunks = [shared, count, grain, chunk_count, &fn]() {
+        for (size_t chunk = shared->next_chunk.fetch_add(1); chunk < chunk_count;
+             chunk = shared->next_chunk.fetch_add(1))
+        {
+            // After a failure the remaining chunks are only counted, so the caller can rethrow.
+            if (!shared->failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    const size_t begin = chunk * grain;
+                    fn(begin, std::min(count, begin + grain));
+                }
+                catch (...)
+                {
+                    if (!shared->failed.exchange(true))
+                    {
+                        shared->error = std::current_exception();
+                    }
+                }
+            }
+            if (shared->done_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == chunk_count)
+            {
+                shared->done_chunks.notify_all();
+            }
+        }
+    };
+
+    // Helpers that start after the loop finished find no chunks left and exit without touching fn.
+    const size_t helpers = std::min<size_t>(workers_.size(), chunk_count - 1);
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        Enqueue(run_chunks);
+    }
+
+    run_chunks();
+
+    // Every chunk is claimed by now; wait for the ones still running elsewhere without picking
+    // up unrelated queued work, which could hold this thread far longer than the loop itself.
+    for (size_t done = shared->done_chunks.load(std::memory_order_acquire); done < chunk_count;
+         done = shared->done_chunks.load(std::memory_order_acquire))
+    {
+        shared->done_chunks.wait(done, std::memory_order_acquire);
+    }
+
+    if (shared->error)
+    {
+        std::rethrow_exception(shared->error);
+    }
+}
+
+void JobSystem::Enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard lock(mutex_);
+        queue_.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void JobSystem::WorkerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex_);
+            wake_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (stopping_ && queue_.empty())
+            {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        task();
+    }
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,131 @@
+#include "ZokataEngine/systems/mesh/GeometryCache.h"
+
+#include <charconv>
+#include <utility>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+// Shortest round-trip formatting, so distinct parameters never share a key.
+template <typename T>
+void AppendKeyPart(std::string& key, T value)
+{
+    char buffer[32];
+    const auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    key.push_back(',');
+    key.append(buffer, error == std::errc{} ? end : buffer);
+}
+}  // namespace
+
+GeometryCache& GeometryCache::Default()
+{
+    static GeometryCache cache;
+    return cache;
+}
+
+GeometryHandle GeometryCache::Find(std::string_view key)
+{
+    const std::scoped_lock lock(mutex_);
+    const auto it = entries_.find(key);
+    if (it == entries_.end())
+    {
+        return nullptr;
+    }
+    return it->second.lock();
+}
+
+GeometryHandle GeometryCache::GetOrCreate(std::string_view key, const std::function<MeshGeometry()>& build)
+{
+    {
+        const std::scoped_lock lock(mutex_);
+        const auto it = entries_.find(key);
+        if (it != entries_.end())
+        {
+            if (GeometryHandle live = it->second.lock())
+            {
+                ++hits_;
+                return live;
+            }
+        }
+        ++misses_;
+    }
+
+    // Build without holding the lock so unrelated meshes can be created concurrently.
+    auto built = std::make_shared<const MeshGeometry>(build());
+
+    const std::scoped_lock lock(mutex_);
+    auto [it, inserted] = entries_.try_emplace(std::string(key), built);
+    if (!inserted)
+    {
+        if (GeometryHandle winner = it->second.lock())
+        {
+            return winner;
+        }
+        it->second = built;
+    }
+    return built;
+}
+
+GeometryHandle GeometryCache::Insert(std::string_view key, MeshGeometry geometry)
+{
+    auto shared = std::make_shared<const MeshGeometry>(std::move(geometry));
+    const std::scoped_lock lock(mutex_);
+    entries_.insert_or_assign(std::string(key), shared);
+    return shared;
+}
+
+GeometryHandle GeometryCache::Cube(const CubeParams& params)
+{
+    return GetOrCreate(CubeKey(params), [&params]() { return MakeCube(params); });
+}
+
+GeometryHandle GeometryCache::Sphere(const SphereParams& params)
+{
+    return GetOrCreate(SphereKey(params), [&params]() { return MakeSphere(params); });
+}
+
+std::string GeometryCache::CubeKey(const CubeParams& params)
+{
+    std::string key = "primitive:cube";
+    AppendKeyPart(key, params.size.x);
+    AppendKeyPart(key, params.size.y);
+    AppendKeyPart(key, params.size.z);
+    return key;
+}
+
+std::string GeometryCache::SphereKey(const SphereParams& params)
+{
+    std::string key = "primitive:sphere";
+    AppendKeyPart(key, params.radius);
+    AppendKeyPart(key, params.longitude_segments);
+    AppendKeyPart(key, params.latitude_segments);
+    return key;
+}
+
+size_t GeometryCache::Prune()
+{
+    const std::scoped_lock lock(mutex_);
+    return std::erase_if(entries_, [](const auto& entry) { return entry.second.expired(); });
+}
+
+GeometryCacheStats GeometryCache::Stats()
+{
+    const std::scoped_lock lock(mutex_);
+    GeometryCacheStats stats {};
+    stats.hits = hits_;
+    stats.misses = misses_;
+    for (const auto& [key, weak] : entries_)
+    {
+        if (const GeometryHandle geometry = weak.lock())
+        {
+            ++stats.entries;
+            stats.bytes += geometry->vertices.size() * sizeof(MeshVertex) + geometry->indices.size() * sizeof(uint32_t);
+        }
+    }
+    return stats;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,356 @@
+#include "ZokataEngine/systems/mesh/MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint32_t kNone = ~0U;
+constexpr float kMinWeldCell = 1e-6F;
+
+void MakeIndexed(MeshGeometry& geometry)
+{
+    if (geometry.Indexed() || geometry.vertices.empty())
+    {
+        return;
+    }
+    geometry.indices.resize(geometry.vertices.size() - geometry.vertices.size() % 3);
+    std::iota(geometry.indices.begin(), geometry.indices.end(), 0U);
+}
+
+bool Near(const MATH::Vec3f& a, const MATH::Vec3f& b, float tolerance)
+{
+    return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance && std::abs(a.z - b.z) <= tolerance;
+}
+
+bool Near(const MATH::Vec2f& a, const MATH::Vec2f& b, float tolerance)
+{
+    return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance;
+}
+
+bool Matches(const MeshVertex& a, const MeshVertex& b, const WeldSettings& tolerance)
+{
+    return Near(a.position, b.position, tolerance.position) && Near(a.normal, b.normal, tolerance.normal)
+        && Near(a.uv, b.uv, tolerance.uv) && Near(a.tangent, b.tangent, tolerance.tangent);
+}
+
+uint64_t CellKey(int64_t x, int64_t y, int64_t z)
+{
+    constexpr uint64_t kMask = (1ULL << 21) - 1;
+    return (static_cast<uint64_t>(x) & kMask) | ((static_cast<uint64_t>(y) & kMask) << 21)
+        | ((static_cast<uint64_t>(z) & kMask) << 42);
+}
+
+// Tipsify helpers; see OptimizeVertexCache.
+struct TipsifyState
+{
+    std::vector<uint32_t> offsets;    // vertex -> first adjacent triangle
+    std::vector<uint32_t> triangles;  // adjacency lists
+    std::vector<uint32_t> live;       // non-emitted triangles per vertex
+    std::vector<uint32_t> stamp;      // cache time of each vertex's last miss
+    std::vector<uint32_t> dead_ends;
+    uint32_t time = 0;
+    uint32_t cursor = 0;
+};
+
+uint32_t SkipDeadEnd(TipsifyState& state)
+{
+    while (!state.dead_ends.empty())
+    {
+        const uint32_t vertex = state.dead_ends.back();
+        state.dead_ends.pop_back();
+        if (state.live[vertex] > 0)
+        {
+            return vertex;
+        }
+    }
+    while (state.cursor < state.live.size())
+    {
+        const uint32_t vertex = state.cursor++;
+        if (state.live[vertex] > 0)
+        {
+            return vertex;
+        }
+    }
+    return kNone;
+}
+
+uint32_t NextVertex(TipsifyState& state, std::span<const uint32_t> candidates, uint32_t cache_size)
+{
+    uint32_t best = kNone;
+    int64_t best_priority = -1;
+    for (const uint32_t vertex : candidates)
+    {
+        if (state.live[vertex] == 0)
+        {
+            continue;
+        }
+        // Prefer the oldest vertex still guaranteed to be in cache after emitting its fan.
+        int64_t priority = 0;
+        const uint32_t age = state.time - state.stamp[vertex];
+        if (age + 2 * state.live[vertex] <= cache_size)
+        {
+            priority = age;
+        }
+        if (priority > best_priority)
+        {
+            best_priority = priority;
+            best = vertex;
+        }
+    }
+    return best != kNone ? best : SkipDeadEnd(state);
+}
+}  // namespace
+
+VertexCacheStats AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertex_count, uint32_t cache_size)
+{
+    VertexCacheStats stats {};
+    const size_t triangle_count = indices.size() / 3;
+    if (triangle_count == 0 || vertex_count == 0)
+    {
+        return stats;
+    }
+
+    // A vertex hits while fewer than cache_size misses happened since its own last miss.
+    std::vector<uint32_t> entered(vertex_count, 0);
+    std::vector<uint8_t> referenced(vertex_count, 0);
+    uint32_t misses = 0;
+    size_t unique = 0;
+    for (size_t i = 0; i < triangle_count * 3; ++i)
+    {
+        const uint32_t vertex = indices[i];
+        if (referenced[vertex] == 0)
+        {
+            referenced[vertex] = 1;
+            ++unique;
+        }
+        else if (misses - entered[vertex] < cache_size)
+        {
+            continue;
+        }
+        ++misses;
+        entered[vertex] = misses;
+    }
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(triangle_count);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(unique);
+    return stats;
+}
+
+size_t WeldVertices(MeshGeometry& geometry, const WeldSettings& tolerance)
+{
+    MakeIndexed(geometry);
+    const size_t vertex_count = geometry.vertices.size();
+    if (vertex_count == 0)
+    {
+        return 0;
+    }
+
+    // Cells at least as large as the tolerance, so every match sits in one of 27 neighbour cells.
+    const float cell = std::max(tolerance.position, kMinWeldCell);
+    const float inverse_cell = 1.0F / cell;
+    std::unordered_map<uint64_t, uint32_t> heads;
+    heads.reserve(vertex_count);
+    std::vector<uint32_t> next;  // per kept vertex: next kept vertex in the same cell
+    next.reserve(vertex_count);
+
+    std::vector<MeshVertex> kept;
+    kept.reserve(vertex_count);
+    std::vector<uint32_t> remap(vertex_count, kNone);
+
+    for (size_t v = 0; v < vertex_count; ++v)
+    {
+        const MeshVertex& vertex = geometry.vertices[v];
+        const auto cx = static_cast<int64_t>(std::floor(vertex.position.x * inverse_cell));
+        const auto cy = static_cast<int64_t>(std::floor(vertex.position.y * inverse_cell));
+        const auto cz = static_cast<int64_t>(std::floor(vertex.position.z * inverse_cell));
+
+        uint32_t match = kNone;
+        for (int64_t dz = -1; dz <= 1 && match == kNone; ++dz)
+        {
+            for (int64_t dy = -1; dy <= 1 && match == kNone; ++dy)
+            {
+                for (int64_t dx = -1; dx <= 1 && match == kNone; ++dx)
+                {
+                    const auto head = heads.find(CellKey(cx + dx, cy + dy, cz + dz));
+                    for (uint32_t k = head != heads.end() ? head->second : kNone; k != kNone; k = next[k])
+                    {
+                        if (Matches(kept[k], vertex, tolerance))
+                        {
+                            match = k;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (match == kNone)
+        {
+            match = static_cast<uint32_t>(kept.size());
+            kept.push_back(vertex);
+            const auto [head, inserted] = heads.try_emplace(CellKey(cx, cy, cz), match);
+            next.push_back(inserted ? kNone : head->second);
+            head->second = match;
+        }
+        remap[v] = match;
+    }
+
+    for (uint32_t& index : geometry.indices)
+    {
+        index = remap[index];
+    }
+    const size_t removed = vertex_count - kept.size();
+    geometry.vertices = std::move(kept);
+    return removed;
+}
+
+void OptimizeVertexCache(std::span<uint32_t> indices, size_t vertex_count, uint32_t cache_size)
+{
+    const size_t triangle_count = indices.size() / 3;
+    if (triangle_count == 0 || vertex_count == 0)
+    {
+        return;
+    }
+    cache_size = std::max(cache_size, 3U);
+
+    TipsifyState state {};
+    state.offsets.assign(vertex_count + 1, 0);
+    for (size_t i = 0; i < triangle_count * 3; ++i)
+    {
+        ++state.offsets[indices[i] + 1];
+    }
+    std::partial_sum(state.offsets.begin(), state.offsets.end(), state.offsets.begin());
+    state.triangles.resize(triangle_count * 3);
+    std::vector<uint32_t> fill(state.offsets.begin(), state.offsets.end() - 1);
+    for (size_t i = 0; i < triangle_count * 3; ++i)
+    {
+        state.triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+    state.live.resize(vertex_count);
+    for (size_t v = 0; v < vertex_count; ++v)
+    {
+        state.live[v] = state.offsets[v + 1] - state.offsets[v];
+    }
+    state.stamp.assign(vertex_count, 0);
+    state.time = cache_size + 1;
+    state.dead_ends.reserve(triangle_count * 3);
+
+    std::vector<uint8_t> emitted(triangle_count, 0);
+    std::vector<uint32_t> output;
+    output.reserve(triangle_count * 3);
+    std::vector<uint32_t> candidates;
+
+    uint32_t fan = SkipDeadEnd(state);
+    while (fan != kNone)
+    {
+        candidates.clear();
+        for (uint32_t k = state.offsets[fan]; k < state.offsets[fan + 1]; ++k)
+        {
+            const uint32_t triangle = state.triangles[k];
+            if (emitted[triangle] != 0)
+            {
+                continue;
+            }
+            emitted[triangle] = 1;
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t vertex = indices[triangle * 3 + corner];
+                output.push_back(vertex);
+                state.dead_ends.push_back(vertex);
+                candidates.push_back(vertex);
+                --state.live[vertex];
+                if (state.time - state.stamp[vertex] > cache_size)
+                {
+                    state.stamp[vertex] = state.time++;
+                }
+            }
+        }
+        fan = NextVertex(state, candidates, cache_size);
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void OptimizeVertexFetch(MeshGeometry& geometry)
+{
+    MakeIndexed(geometry);
+    std::vector<uint32_t> remap(geometry.vertices.size(), kNone);
+    std::vector<MeshVertex> ordered;
+    ordered.reserve(geometry.vertices.size());
+    for (uint32_t& index : geometry.indices)
+    {
+        if (remap[index] == kNone)
+        {
+            remap[index] = static_cast<uint32_t>(ordered.size());
+            ordered.push_back(geometry.vertices[index]);
+        }
+        index = remap[index];
+    }
+    geometry.vertices = std::move(ordered);
+}
+
+MeshOptimizeReport OptimizeMesh(MeshGeometry& geometry, const MeshOptimizeSettings& settings)
+{
+    MeshOptimizeReport report {};
+    MakeIndexed(geometry);
+    report.triangles = geometry.indices.size() / 3;
+    report.vertices_before = geometry.vertices.size();
+    report.before = AnalyzeVertexCache(geometry.indices, geometry.vertices.size(), settings.cache_size);
+
+    if (settings.weld)
+    {
+        WeldVertices(geometry, settings.tolerance);
+    }
+    OptimizeVertexCache(geometry.indices, geometry.vertices.size(), settings.cache_size);
+    OptimizeVertexFetch(geometry);
+
+    report.vertices_after = geometry.vertices.size();
+    report.after = AnalyzeVertexCache(geometry.indices, geometry.vertices.size(), settings.cache_size);
+    return report;
+}
+
+MeshOptimizeReport CombineReports(std::span<const MeshOptimizeReport> reports)
+{
+    // Each report's misses are acmr * triangles and its referenced vertices misses / atvr.
+    MeshOptimizeReport total {};
+    double misses_before = 0.0;
+    double misses_after = 0.0;
+    double referenced_before = 0.0;
+    double referenced_after = 0.0;
+    for (const MeshOptimizeReport& report : reports)
+    {
+        total.triangles += report.triangles;
+        total.vertices_before += report.vertices_before;
+        total.vertices_after += report.vertices_after;
+        const double before = static_cast<double>(report.before.acmr) * static_cast<double>(report.triangles);
+        const double after = static_cast<double>(report.after.acmr) * static_cast<double>(report.triangles);
+        misses_before += before;
+        misses_after += after;
+        referenced_before += report.before.atvr > 0.0F ? before / report.before.atvr : 0.0;
+        referenced_after += report.after.atvr > 0.0F ? after / report.after.atvr : 0.0;
+    }
+    if (total.triangles > 0)
+    {
+        const auto triangles = static_cast<double>(total.triangles);
+        total.before.acmr = static_cast<float>(misses_before / triangles);
+        total.after.acmr = static_cast<float>(misses_after / triangles);
+    }
+    if (referenced_before > 0.0)
+    {
+        total.before.atvr = static_cast<float>(misses_before / referenced_before);
+    }
+    if (referenced_after > 0.0)
+    {
+        total.after.atvr = static_cast<float>(misses_after / referenced_after);
+    }
+    return total;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,697 @@
+#include "ZokataEngine/systems/mesh/MeshSimplifier.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataMath/Bounds.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint32_t kNone = ~0U;
+constexpr uint32_t kMany = ~1U;  // more than one open edge
+constexpr double kBorderWeight = 10.0;
+constexpr int kMaxPasses = 64;
+constexpr float kMeaningfulReduction = 0.9F;  // a LOD step must keep at most this share
+constexpr size_t kNoChain = ~size_t{0};
+
+enum class VertexKind : uint8_t
+{
+    Manifold,  // interior vertex with a single attribute set
+    Border,    // on one open border loop
+    Seam,      // two attribute sets meeting along one seam
+    Locked     // anything more complex; never moves
+};
+
+// kCanCollapse[from][to]
+constexpr bool kCanCollapse[4][4] = {
+    {true, true, true, true},
+    {false, true, false, false},
+    {false, false, true, false},
+    {false, false, false, false},
+};
+
+struct Quadric
+{
+    double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+    double c = 0.0;
+    double area = 0.0;  // total face area, normalizes Error() to a squared distance
+
+    void AddPlane(double nx, double ny, double nz, double d, double weight)
+    {
+        a00 += weight * nx * nx;
+        a11 += weight * ny * ny;
+        a22 += weight * nz * nz;
+        a01 += weight * nx * ny;
+        a02 += weight * nx * nz;
+        a12 += weight * ny * nz;
+        b0 += weight * nx * d;
+        b1 += weight * ny * d;
+        b2 += weight * nz * d;
+        c += weight * d * d;
+    }
+
+    Quadric& operator+=(const Quadric& rhs)
+    {
+        a00 += rhs.a00;
+        a11 += rhs.a11;
+        a22 += rhs.a22;
+        a01 += rhs.a01;
+        a02 += rhs.a02;
+        a12 += rhs.a12;
+        b0 += rhs.b0;
+        b1 += rhs.b1;
+        b2 += rhs.b2;
+        c += rhs.c;
+        area += rhs.area;
+        return *this;
+    }
+
+    float Error(const MATH::Vec3f& p) const
+    {
+        const double x = p.x;
+        const double y = p.y;
+        const double z = p.z;
+        const double e = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+            + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        return static_cast<float>(std::max(e, 0.0) / std::max(area, 1e-12));
+    }
+};
+
+uint32_t Bits(float value)
+{
+    return std::bit_cast<uint32_t>(value + 0.0F);  // folds -0 into +0
+}
+
+struct VertexKey
+{
+    std::array<uint32_t, 11> bits {};
+
+    explicit VertexKey(const MeshVertex& v)
+        : bits {Bits(v.position.x), Bits(v.position.y), Bits(v.position.z), Bits(v.normal.x), Bits(v.normal.y),
+                Bits(v.normal.z),   Bits(v.uv.x),       Bits(v.uv.y),       Bits(v.tangent.x), Bits(v.tangent.y),
+                Bits(v.tangent.z)}
+    {
+    }
+
+    bool operator==(const VertexKey& rhs) const { return bits == rhs.bits; }
+};
+
+struct VertexKeyHash
+{
+    size_t operator()(const VertexKey& key) const
+    {
+        size_t h = 0;
+        for (const uint32_t b : key.bits)
+        {
+            h = h * 0x9E3779B1U + b;
+        }
+        return h;
+    }
+};
+
+struct PositionKey
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t z = 0;
+
+    bool operator==(const PositionKey& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
+};
+
+struct PositionKeyHash
+{
+    size_t operator()(const PositionKey& key) const { return (key.x * 73856093U) ^ (key.y * 19349663U) ^ (key.z * 83492791U); }
+};
+
+uint64_t EdgeKey(uint32_t a, uint32_t b)
+{
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+MATH::Vec3f FaceNormal(const MATH::Vec3f& p0, const MATH::Vec3f& p1, const MATH::Vec3f& p2)
+{
+    return MATH::Vec3f::Cross(p1 - p0, p2 - p0);
+}
+
+struct Collapse
+{
+    uint32_t from = 0;
+    uint32_t to = 0;
+    float cost = 0.0F;
+};
+
+class Simplifier
+{
+public:
+    Simplifier(const MeshGeometry& geometry, const SimplifyOptions& options)
+        : options_(options)
+    {
+        Weld(geometry);
+        BuildPositionRemap();
+        RemoveDegenerateTriangles();
+        ClassifyVertices();
+        BuildQuadrics();
+    }
+
+    SimplifyResult Run()
+    {
+        const size_t target = options_.target_triangles;
+        const float limit = options_.max_error * Radius();
+        const float limit_sq = limit * limit;
+
+        for (int pass = 0; pass < kMaxPasses && indices_.size() / 3 > target; ++pass)
+        {
+            BuildAdjacency();
+            CollectCollapses();
+            if (ApplyCollapses(indices_.size() / 3 - target, limit_sq) == 0)
+            {
+                break;
+            }
+            RemapIndices();
+            RemapLoops();
+        }
+        return Compact();
+    }
+
+private:
+    SimplifyOptions options_;
+    std::vector<MeshVertex> vertices_;
+    std::vector<uint32_t> indices_;
+    std::vector<uint32_t> remap_;  // first vertex sharing this position
+    std::vector<uint32_t> wedge_;  // next vertex sharing this position (circular list)
+    std::vector<VertexKind> kind_;
+    std::vector<uint32_t> loop_;      // next vertex along this vertex's open edge
+    std::vector<uint32_t> loopback_;  // previous vertex along the open edge
+    std::vector<Quadric> quadrics_;   // per position (indexed by remap_)
+
+    std::vector<uint32_t> adjacency_offsets_;
+    std::vector<uint32_t> adjacency_;  // triangles around each position
+    std::vector<Collapse> collapses_;
+    std::vector<uint32_t> collapse_remap_;
+    std::vector<uint8_t> locked_;
+    float error_sq_ = 0.0F;
+
+    void Weld(const MeshGeometry& geometry)
+    {
+        // Exact duplicates (e.g. non-indexed input) would otherwise look like attribute seams.
+        std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+        unique.reserve(geometry.vertices.size());
+        std::vector<uint32_t> vertex_map(geometry.vertices.size());
+        for (size_t i = 0; i < geometry.vertices.size(); ++i)
+        {
+            const auto [it, inserted] =
+                unique.emplace(VertexKey(geometry.vertices[i]), static_cast<uint32_t>(vertices_.size()));
+            if (inserted)
+            {
+                vertices_.push_back(geometry.vertices[i]);
+            }
+            vertex_map[i] = it->second;
+        }
+
+        const size_t index_count = geometry.Indexed() ? geometry.indices.size() : geometry.vertices.size();
+        indices_.reserve(index_count - index_count % 3);
+        for (size_t i = 0; i + 2 < index_count; i += 3)
+        {
+            uint32_t tri[3];
+            for (size_t k = 0; k < 3; ++k)
+            {
+                tri[k] = vertex_map[geometry.Indexed() ? geometry.indices[i + k] : static_cast<uint32_t>(i + k)];
+            }
+            if (tri[0] != tri[1] && tri[1] != tri[2] && tri[0] != tri[2])
+            {
+                indices_.insert(indices_.end(), tri, tri + 3);
+            }
+        }
+    }
+
+    void BuildPositionRemap()
+    {
+        const auto count = static_cast<uint32_t>(vertices_.size());
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> firsts;
+        firsts.reserve(count);
+        remap_.resize(count);
+        wedge_.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const MATH::Vec3f& p = vertices_[i].position;
+            const uint32_t first = firsts.emplace(PositionKey{Bits(p.x), Bits(p.y), Bits(p.z)}, i).first->second;
+            remap_[i] = first;
+            if (first == i)
+            {
+                wedge_[i] = i;
+            }
+            else
+            {
+                wedge_[i] = wedge_[first];
+                wedge_[first] = i;
+            }
+        }
+    }
+
+    void RemoveDegenerateTriangles()
+    {
+        // Triangles whose corners share a position (e.g. UV sphere poles) have no area to preserve.
+        collapse_remap_.resize(vertices_.size());
+        std::iota(collapse_remap_.begin(), collapse_remap_.end(), 0U);
+        RemapIndices();
+    }
+
+    void ClassifyVertices()
+    {
+        const auto count = static_cast<uint32_t>(vertices_.size());
+        std::unordered_map<uint64_t, uint32_t> half_edges;
+        half_edges.reserve(indices_.size());
+        for (size_t t = 0; t < indices_.size(); t += 3)
+        {
+            for (size_t e = 0; e < 3; ++e)
+            {
+                ++half_edges[EdgeKey(indices_[t + e], indices_[t + (e + 1) % 3])];
+            }
+        }
+
+        std::vector<uint32_t> open_out(count, kNone);
+        std::vector<uint32_t> open_in(count, kNone);
+        std::vector<uint8_t> complex(count, 0);
+        for (size_t t = 0; t < indices_.size(); t += 3)
+        {
+            for (size_t e = 0; e < 3; ++e)
+            {
+                const uint32_t a = indices_[t + e];
+                const uint32_t b = indices_[t + (e + 1) % 3];
+                if (half_edges[EdgeKey(a, b)] > 1)
+                {
+                    complex[remap_[a]] = 1;  // non-manifold edge
+                    complex[remap_[b]] = 1;
+                }
+                if (!half_edges.contains(EdgeKey(b, a)))
+                {
+                    open_out[a] = open_out[a] == kNone ? b : kMany;
+                    open_in[b] = open_in[b] == kNone ? a : kMany;
+                }
+            }
+        }
+
+        kind_.assign(count, VertexKind::Locked);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (remap_[i] != i || complex[i] != 0)
+            {
+                continue;
+            }
+            if (wedge_[i] == i)
+            {
+                if (open_in[i] == kNone && open_out[i] == kNone)
+                {
+                    kind_[i] = VertexKind::Manifold;
+                }
+                else if (open_in[i] < kMany && open_out[i] < kMany)
+                {
+                    kind_[i] = options_.lock_border ? VertexKind::Locked : VertexKind::Border;
+                }
+            }
+            else if (wedge_[wedge_[i]] == i)
+            {
+                // Each wedge has one open edge in and out, and they pair up across the seam.
+                const uint32_t w = wedge_[i];
+                const uint32_t a_in = open_in[i];
+                const uint32_t a_out = open_out[i];
+                const uint32_t b_in = open_in[w];
+                const uint32_t b_out = open_out[w];
+                if (a_in < kMany && a_out < kMany && b_in < kMany && b_out < kMany && remap_[a_in] == remap_[b_out]
+                    && remap_[a_out] == remap_[b_in])
+                {
+                    kind_[i] = VertexKind::Seam;
+                }
+            }
+        }
+
+        loop_.resize(count);
+        loopback_.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            kind_[i] = kind_[remap_[i]];
+            loop_[i] = open_out[i] < kMany ? open_out[i] : kNone;
+            loopback_[i] = open_in[i] < kMany ? open_in[i] : kNone;
+        }
+    }
+
+    void BuildQuadrics()
+    {
+        quadrics_.assign(vertices_.size(), Quadric{});
+        for (size_t t = 0; t < indices_.size(); t += 3)
+        {
+            const MATH::Vec3f& p0 = vertices_[indices_[t]].position;
+            const MATH::Vec3f& p1 = vertices_[indices_[t + 1]].position;
+            const MATH::Vec3f& p2 = vertices_[indices_[t + 2]].position;
+            MATH::Vec3f normal = FaceNormal(p0, p1, p2);
+            const float length = normal.Length();
+            if (length == 0.0F)
+            {
+                continue;
+            }
+            normal /= length;
+            const double area = 0.5 * length;
+            const double d = -MATH::Vec3f::Dot(normal, p0);
+
+            for (size_t k = 0; k < 3; ++k)
+            {
+                Quadric& q = quadrics_[remap_[indices_[t + k]]];
+                q.AddPlane(normal.x, normal.y, normal.z, d, area);
+                q.area += area;
+            }
+
+            // Open edges get a plane perpendicular to the face so borders and seams keep their shape.
+            for (size_t e = 0; e < 3; ++e)
+            {
+                const uint32_t a = indices_[t + e];
+                const uint32_t b = indices_[t + (e + 1) % 3];
+                if (loop_[a] != b)
+                {
+                    continue;
+                }
+                const MATH::Vec3f& pa = vertices_[a].position;
+                const MATH::Vec3f edge = vertices_[b].position - pa;
+                const float edge_length = edge.Length();
+                if (edge_length == 0.0F)
+                {
+                    continue;
+                }
+                const MATH::Vec3f side = MATH::Vec3f::Cross(edge, normal).Normalized();
+                const double side_d = -MATH::Vec3f::Dot(side, pa);
+                const double weight = kBorderWeight * edge_length * edge_length;
+                quadrics_[remap_[a]].AddPlane(side.x, side.y, side.z, side_d, weight);
+                quadrics_[remap_[b]].AddPlane(side.x, side.y, side.z, side_d, weight);
+            }
+        }
+    }
+
+    float Radius() const
+    {
+        MATH::Aabb bounds {};
+        for (const MeshVertex& vertex : vertices_)
+        {
+            bounds.Expand(vertex.position);
+        }
+        return vertices_.empty() ? 0.0F : bounds.Extents().Length();
+    }
+
+    void BuildAdjacency()
+    {
+        adjacency_offsets_.assign(vertices_.size() + 1, 0);
+        for (const uint32_t index : indices_)
+        {
+            ++adjacency_offsets_[remap_[index] + 1];
+        }
+        std::partial_sum(adjacency_offsets_.begin(), adjacency_offsets_.end(), adjacency_offsets_.begin());
+        adjacency_.resize(indices_.size());
+        std::vector<uint32_t> cursor(adjacency_offsets_.begin(), adjacency_offsets_.end() - 1);
+        for (size_t i = 0; i < indices_.size(); ++i)
+        {
+            adjacency_[cursor[remap_[indices_[i]]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    bool CanCollapse(uint32_t from, uint32_t to) const
+    {
+        const VertexKind from_kind = kind_[from];
+        if (!kCanCollapse[static_cast<size_t>(from_kind)][static_cast<size_t>(kind_[to])])
+        {
+            return false;
+        }
+        if (from_kind == VertexKind::Border || from_kind == VertexKind::Seam)
+        {
+            // Only slide along the open edge, never across the surface.
+            if (loop_[from] != to && loopback_[from] != to)
+            {
+                return false;
+            }
+            if (from_kind == VertexKind::Seam)
+            {
+                const uint32_t w_from = wedge_[from];
+                const uint32_t w_to = wedge_[to];
+                return loop_[w_from] == w_to || loopback_[w_from] == w_to;
+            }
+        }
+        return true;
+    }
+
+    void CollectCollapses()
+    {
+        collapses_.clear();
+        const float no_collapse = std::numeric_limits<float>::max();
+        for (size_t t = 0; t < indices_.size(); t += 3)
+        {
+            for (size_t e = 0; e < 3; ++e)
+            {
+                const uint32_t i0 = indices_[t + e];
+                const uint32_t i1 = indices_[t + (e + 1) % 3];
+                const bool forward = CanCollapse(i0, i1);
+                const bool backward = CanCollapse(i1, i0);
+                if (!forward && !backward)
+                {
+                    continue;
+                }
+                const float forward_cost = forward ? quadrics_[remap_[i0]].Error(vertices_[i1].position) : no_collapse;
+                const float backward_cost = backward ? quadrics_[remap_[i1]].Error(vertices_[i0].position) : no_collapse;
+                collapses_.push_back(forward_cost <= backward_cost ? Collapse{i0, i1, forward_cost}
+                                                                   : Collapse{i1, i0, backward_cost});
+            }
+        }
+        std::sort(collapses_.begin(), collapses_.end(), [](const Collapse& a, const Collapse& b) {
+            return a.cost < b.cost;
+        });
+    }
+
+    bool Flips(uint32_t from_position, uint32_t to_position, const MATH::Vec3f& target) const
+    {
+        for (uint32_t k = adjacency_offsets_[from_position]; k < adjacency_offsets_[from_position + 1]; ++k)
+        {
+            const uint32_t t = adjacency_[k] * 3;
+            MATH::Vec3f before[3];
+            MATH::Vec3f after[3];
+            bool touches_target = false;
+            for (size_t v = 0; v < 3; ++v)
+            {
+                const uint32_t position = remap_[indices_[t + v]];
+                touches_target = touches_target || position == to_position;
+                before[v] = vertices_[indices_[t + v]].position;
+                after[v] = position == from_position ? target : before[v];
+            }
+            if (touches_target)
+            {
+                continue;  // becomes degenerate and is removed
+            }
+            const MATH::Vec3f n0 = FaceNormal(before[0], before[1], before[2]);
+            const MATH::Vec3f n1 = FaceNormal(after[0], after[1], after[2]);
+            if (n0.LengthSquared() == 0.0F)
+            {
+                continue;
+            }
+            // Reject flips and rotations beyond ~75 degrees.
+            if (MATH::Vec3f::Dot(n0, n1) <= 0.25F * n0.Length() * n1.Length())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t ApplyCollapses(size_t triangle_goal, float limit_sq)
+    {
+        collapse_remap_.resize(vertices_.size());
+        std::iota(collapse_remap_.begin(), collapse_remap_.end(), 0U);
+        locked_.assign(vertices_.size(), 0);
+
+        size_t applied = 0;
+        size_t removed = 0;
+        for (const Collapse& collapse : collapses_)
+        {
+            if (collapse.cost > limit_sq || removed >= triangle_goal)
+            {
+                break;
+            }
+            const uint32_t r0 = remap_[collapse.from];
+            const uint32_t r1 = remap_[collapse.to];
+            if (locked_[r0] != 0 || locked_[r1] != 0 || Flips(r0, r1, vertices_[collapse.to].position))
+            {
+                continue;
+            }
+
+            collapse_remap_[collapse.from] = collapse.to;
+            if (kind_[collapse.from] == VertexKind::Seam)
+            {
+                collapse_remap_[wedge_[collapse.from]] = wedge_[collapse.to];
+            }
+            quadrics_[r1] += quadrics_[r0];
+            error_sq_ = std::max(error_sq_, collapse.cost);
+
+            // Lock the whole one-ring so later collapses in this pass see unmodified triangles.
+            for (uint32_t k = adjacency_offsets_[r0]; k < adjacency_offsets_[r0 + 1]; ++k)
+            {
+                const uint32_t t = adjacency_[k] * 3;
+                for (size_t v = 0; v < 3; ++v)
+                {
+                    locked_[remap_[indices_[t + v]]] = 1;
+                }
+            }
+            locked_[r1] = 1;
+
+            removed += kind_[collapse.from] == VertexKind::Border ? 1 : 2;
+            ++applied;
+        }
+        return applied;
+    }
+
+    void RemapIndices()
+    {
+        size_t write = 0;
+        for (size_t t = 0; t < indices_.size(); t += 3)
+        {
+            const uint32_t a = collapse_remap_[indices_[t]];
+            const uint32_t b = collapse_remap_[indices_[t + 1]];
+            const uint32_t c = collapse_remap_[indices_[t + 2]];
+            if (remap_[a] == remap_[b] || remap_[b] == remap_[c] || remap_[a] == remap_[c])
+            {
+                continue;
+            }
+            indices_[write++] = a;
+            indices_[write++] = b;
+            indices_[write++] = c;
+        }
+        indices_.resize(write);
+    }
+
+    void RemapLoops()
+    {
+        for (std::vector<uint32_t>* links : {&loop_, &loopback_})
+        {
+            std::vector<uint32_t>& link = *links;
+            for (uint32_t i = 0; i < link.size(); ++i)
+            {
+                const uint32_t next = link[i];
+                if (next == kNone)
+                {
+                    continue;
+                }
+                const uint32_t target = collapse_remap_[next];
+                // When the neighbour collapsed into this vertex, skip over it.
+                link[i] = target != i ? target : (link[next] != kNone ? collapse_remap_[link[next]] : kNone);
+            }
+        }
+    }
+
+    SimplifyResult Compact() const
+    {
+        SimplifyResult result {};
+        std::vector<uint32_t> new_index(vertices_.size(), kNone);
+        result.geometry.indices.reserve(indices_.size());
+        for (const uint32_t index : indices_)
+        {
+            if (new_index[index] == kNone)
+            {
+                new_index[index] = static_cast<uint32_t>(result.geometry.vertices.size());
+                result.geometry.vertices.push_back(vertices_[index]);
+            }
+            result.geometry.indices.push_back(new_index[index]);
+        }
+        result.error = std::sqrt(error_sq_);
+        return result;
+    }
+};
+}  // namespace
+
+SimplifyResult SimplifyMesh(const MeshGeometry& geometry, const SimplifyOptions& options)
+{
+    if (geometry.Empty())
+    {
+        return SimplifyResult{};
+    }
+    Simplifier simplifier(geometry, options);
+    return simplifier.Run();
+}
+
+std::vector<MeshLod> BuildLodChain(const MeshGeometry& geometry, const LodChainSettings& settings)
+{
+    std::vector<MeshLod> lods;
+    const MeshGeometry* source = &geometry;
+    size_t previous = geometry.TriangleCount();
+    float error = 0.0F;
+    for (uint32_t level = 0; level < settings.max_levels; ++level)
+    {
+        const auto target = std::max(settings.min_triangles,
+                                     static_cast<size_t>(static_cast<float>(previous) * settings.triangle_ratio));
+        if (target >= previous)
+        {
+            break;
+        }
+
+        SimplifyOptions options {};
+        options.target_triangles = target;
+        options.max_error = settings.max_error;
+        options.lock_border = settings.lock_border;
+        SimplifyResult result = SimplifyMesh(*source, options);
+
+        const size_t triangles = result.geometry.TriangleCount();
+        if (triangles == 0 || static_cast<float>(triangles) > static_cast<float>(previous) * kMeaningfulReduction)
+        {
+            break;
+        }
+        error += result.error;
+        lods.push_back(MeshLod{std::make_shared<const MeshGeometry>(std::move(result.geometry)), error});
+        source = lods.back().geometry.get();
+        previous = triangles;
+    }
+    return lods;
+}
+
+void BuildLodChains(std::span<MeshComponent* const> meshes, const LodChainSettings& settings, JobSystem& jobs)
+{
+    // Components sharing geometry share one chain, so the work scales with unique meshes.
+    std::unordered_map<const MeshGeometry*, size_t> unique;
+    std::vector<const MeshGeometry*> sources;
+    std::vector<size_t> chain_of(meshes.size(), kNoChain);
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        if (meshes[i] == nullptr)
+        {
+            continue;
+        }
+        const MeshGeometry* geometry = &meshes[i]->Geometry();
+        const auto [it, inserted] = unique.try_emplace(geometry, sources.size());
+        if (inserted)
+        {
+            sources.push_back(geometry);
+        }
+        chain_of[i] = it->second;
+    }
+
+    std::vector<std::vector<MeshLod>> chains(sources.size());
+    jobs.ParallelFor(sources.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            chains[i] = BuildLodChain(*sources[i], settings);
+        }
+    });
+
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        if (chain_of[i] != kNoChain)
+        {
+            meshes[i]->SetLods(chains[chain_of[i]]);
+        }
+    }
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,406 @@
+#include "ZokataEngine/systems/mesh/MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "ZokataMath/Bounds.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint32_t kNone = ~0U;
+constexpr float kMinConeDot = 0.1F;      // wider cones cannot reject anything useful
+constexpr float kSeedReachScale = 2.0F;  // how far a non-adjacent triangle may be, in cluster radii
+
+uint32_t SpreadBits(uint32_t v)
+{
+    v &= 0x3FFU;
+    v = (v | (v << 16)) & 0x030000FFU;
+    v = (v | (v << 8)) & 0x0300F00FU;
+    v = (v | (v << 4)) & 0x030C30C3U;
+    v = (v | (v << 2)) & 0x09249249U;
+    return v;
+}
+
+uint32_t MortonCode(const MATH::Vec3f& p, const MATH::Aabb& bounds)
+{
+    const MATH::Vec3f size = bounds.max - bounds.min;
+    const auto cell = [](float v, float lo, float extent) {
+        return extent > 0.0F ? static_cast<uint32_t>(std::clamp((v - lo) / extent, 0.0F, 1.0F) * 1023.0F) : 0U;
+    };
+    return SpreadBits(cell(p.x, bounds.min.x, size.x)) | (SpreadBits(cell(p.y, bounds.min.y, size.y)) << 1)
+        | (SpreadBits(cell(p.z, bounds.min.z, size.z)) << 2);
+}
+
+// Ritter's bounding sphere: close to minimal and linear time.
+void BoundingSphere(const std::vector<MATH::Vec3f>& points, MATH::Vec3f& center, float& radius)
+{
+    const MATH::Vec3f& start = points.front();
+    MATH::Vec3f a = start;
+    for (const MATH::Vec3f& p : points)
+    {
+        if ((p - start).LengthSquared() > (a - start).LengthSquared())
+        {
+            a = p;
+        }
+    }
+    MATH::Vec3f b = a;
+    for (const MATH::Vec3f& p : points)
+    {
+        if ((p - a).LengthSquared() > (b - a).LengthSquared())
+        {
+            b = p;
+        }
+    }
+    center = (a + b) * 0.5F;
+    radius = (b - a).Length() * 0.5F;
+    for (const MATH::Vec3f& p : points)
+    {
+        const float distance = (p - center).Length();
+        if (distance > radius)
+        {
+            const float grown = (radius + distance) * 0.5F;
+            center += (p - center) * ((grown - radius) / distance);
+            radius = grown;
+        }
+    }
+}
+
+class MeshletBuilder
+{
+public:
+    MeshletBuilder(const MeshGeometry& geometry, const MeshletSettings& settings)
+        : geometry_(geometry)
+        , max_vertices_(std::clamp(settings.max_vertices, 3U, 255U))
+        , max_triangles_(std::clamp(settings.max_triangles, 1U, 512U))
+        , cone_weight_(settings.cone_weight)
+    {
+        const size_t index_count = geometry.Indexed() ? geometry.indices.size() : geometry.vertices.size();
+        triangle_count_ = static_cast<uint32_t>(index_count / 3);
+        indices_.resize(static_cast<size_t>(triangle_count_) * 3);
+        for (size_t i = 0; i < indices_.size(); ++i)
+        {
+            indices_[i] = geometry.Indexed() ? geometry.indices[i] : static_cast<uint32_t>(i);
+        }
+        ComputeTriangleData();
+        BuildAdjacency();
+        BuildSeedOrder();
+    }
+
+    MeshletMesh Build()
+    {
+        emitted_.assign(triangle_count_, 0);
+        local_.assign(geometry_.vertices.size(), kNone);
+
+        for (const uint32_t seed : seed_order_)
+        {
+            if (emitted_[seed] != 0)
+            {
+                continue;
+            }
+            AddTriangle(seed);
+            for (;;)
+            {
+                const bool full = current_.vertex_count == max_vertices_ || current_.triangle_count == max_triangles_;
+                const uint32_t next = full ? kNone : PickNext();
+                if (next == kNone)
+                {
+                    FinishMeshlet();
+                    break;
+                }
+                AddTriangle(next);
+            }
+        }
+        return std::move(result_);
+    }
+
+private:
+    const MeshGeometry& geometry_;
+    uint32_t max_vertices_ = 64;
+    uint32_t max_triangles_ = 124;
+    float cone_weight_ = 0.25F;
+
+    uint32_t triangle_count_ = 0;
+    std::vector<uint32_t> indices_;
+    std::vector<MATH::Vec3f> normals_;    // unit normal per triangle (zero when degenerate)
+    std::vector<MATH::Vec3f> centroids_;
+    std::vector<uint32_t> adjacency_offsets_;
+    std::vector<uint32_t> adjacency_;  // triangles around each vertex
+    std::vector<uint32_t> seed_order_;
+
+    std::vector<uint8_t> emitted_;
+    std::vector<uint32_t> local_;  // meshlet-local index of each global vertex, kNone when absent
+    Meshlet current_ {};
+    MATH::Vec3f normal_sum_ {0.0F, 0.0F, 0.0F};
+    MATH::Vec3f centroid_sum_ {0.0F, 0.0F, 0.0F};
+    float reach_sq_ = 0.0F;  // squared distance from the cluster centroid within which seeds may join
+    MeshletMesh result_ {};
+
+    void ComputeTriangleData()
+    {
+        normals_.resize(triangle_count_);
+        centroids_.resize(triangle_count_);
+        for (uint32_t t = 0; t < triangle_count_; ++t)
+        {
+            const MATH::Vec3f& p0 = geometry_.vertices[indices_[t * 3]].position;
+            const MATH::Vec3f& p1 = geometry_.vertices[indices_[t * 3 + 1]].position;
+            const MATH::Vec3f& p2 = geometry_.vertices[indices_[t * 3 + 2]].position;
+            normals_[t] = MATH::Vec3f::Cross(p1 - p0, p2 - p0).Normalized();
+            centroids_[t] = (p0 + p1 + p2) / 3.0F;
+        }
+    }
+
+    void BuildAdjacency()
+    {
+        adjacency_offsets_.assign(geometry_.vertices.size() + 1, 0);
+        for (const uint32_t index : indices_)
+        {
+            ++adjacency_offsets_[index + 1];
+        }
+        std::partial_sum(adjacency_offsets_.begin(), adjacency_offsets_.end(), adjacency_offsets_.begin());
+        adjacency_.resize(indices_.size());
+        std::vector<uint32_t> cursor(adjacency_offsets_.begin(), adjacency_offsets_.end() - 1);
+        for (size_t i = 0; i < indices_.size(); ++i)
+        {
+            adjacency_[cursor[indices_[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    void BuildSeedOrder()
+    {
+        MATH::Aabb bounds {};
+        for (const MATH::Vec3f& centroid : centroids_)
+        {
+            bounds.Expand(centroid);
+        }
+        std::vector<uint32_t> codes(triangle_count_);
+        for (uint32_t t = 0; t < triangle_count_; ++t)
+        {
+            codes[t] = MortonCode(centroids_[t], bounds);
+        }
+        seed_order_.resize(triangle_count_);
+        std::iota(seed_order_.begin(), seed_order_.end(), 0U);
+        std::stable_sort(seed_order_.begin(), seed_order_.end(), [&](uint32_t a, uint32_t b) {
+            return codes[a] < codes[b];
+        });
+    }
+
+    uint32_t NewVertices(uint32_t triangle) const
+    {
+        uint32_t count = 0;
+        for (size_t k = 0; k < 3; ++k)
+        {
+            count += local_[indices_[triangle * 3 + k]] == kNone ? 1U : 0U;
+        }
+        return count;
+    }
+
+    uint32_t PickNext()
+    {
+        const MATH::Vec3f axis = normal_sum_.Normalized();
+        uint32_t best = kNone;
+        float best_score = 0.0F;
+
+        // Triangles touching the cluster: fewest new vertices first, then normal agreement.
+        const uint32_t first_vertex = current_.vertex_offset;
+        for (uint32_t i = 0; i < current_.vertex_count; ++i)
+        {
+            const uint32_t vertex = result_.vertices[first_vertex + i];
+            for (uint32_t k = adjacency_offsets_[vertex]; k < adjacency_offsets_[vertex + 1]; ++k)
+            {
+                const uint32_t triangle = adjacency_[k];
+                if (emitted_[triangle] != 0)
+                {
+                    continue;
+                }
+                const uint32_t extra = NewVertices(triangle);
+                if (current_.vertex_count + extra > max_vertices_)
+                {
+                    continue;
+                }
+                const float spread = 1.0F - MATH::Vec3f::Dot(normals_[triangle], axis);
+                const float score = static_cast<float>(extra) + spread * cone_weight_;
+                if (best == kNone || score < best_score)
+                {
+                    best = triangle;
+                    best_score = score;
+                }
+            }
+        }
+        if (best != kNone)
+        {
+            return best;
+        }
+
+        // Disconnected pieces (foliage cards, split parts) may join while they stay close.
+        const MATH::Vec3f centroid = centroid_sum_ / static_cast<float>(current_.triangle_count);
+        for (const uint32_t seed : seed_order_)
+        {
+            if (emitted_[seed] != 0)
+            {
+                continue;
+            }
+            if (current_.vertex_count + NewVertices(seed) <= max_vertices_
+                && (centroids_[seed] - centroid).LengthSquared() <= reach_sq_)
+            {
+                return seed;
+            }
+            break;  // only the next seed in Morton order is considered
+        }
+        return kNone;
+    }
+
+    void AddTriangle(uint32_t triangle)
+    {
+        if (current_.triangle_count == 0)
+        {
+            current_.vertex_offset = static_cast<uint32_t>(result_.vertices.size());
+            current_.triangle_offset = static_cast<uint32_t>(result_.triangles.size() / 3);
+        }
+        for (size_t k = 0; k < 3; ++k)
+        {
+            const uint32_t vertex = indices_[triangle * 3 + k];
+            if (local_[vertex] == kNone)
+            {
+                local_[vertex] = current_.vertex_count++;
+                result_.vertices.push_back(vertex);
+            }
+            result_.triangles.push_back(static_cast<uint8_t>(local_[vertex]));
+        }
+        ++current_.triangle_count;
+        emitted_[triangle] = 1;
+        normal_sum_ += normals_[triangle];
+        centroid_sum_ += centroids_[triangle];
+
+        const MATH::Vec3f centroid = centroid_sum_ / static_cast<float>(current_.triangle_count);
+        const float distance = (centroids_[triangle] - centroid).Length() * kSeedReachScale;
+        reach_sq_ = std::max(reach_sq_, distance * distance);
+    }
+
+    void FinishMeshlet()
+    {
+        ComputeBounds(current_);
+        result_.meshlets.push_back(current_);
+        for (uint32_t i = 0; i < current_.vertex_count; ++i)
+        {
+            local_[result_.vertices[current_.vertex_offset + i]] = kNone;
+        }
+        current_ = Meshlet{};
+        normal_sum_ = MATH::Vec3f{};
+        centroid_sum_ = MATH::Vec3f{};
+        reach_sq_ = 0.0F;
+    }
+
+    void ComputeBounds(Meshlet& meshlet) const
+    {
+        std::vector<MATH::Vec3f> points(meshlet.vertex_count);
+        for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+        {
+            points[i] = geometry_.vertices[result_.vertices[meshlet.vertex_offset + i]].position;
+        }
+        BoundingSphere(points, meshlet.center, meshlet.radius);
+
+        // Normal cone: average axis, half angle from the least aligned triangle.
+        MATH::Vec3f axis {};
+        for (uint32_t t = 0; t < meshlet.triangle_count; ++t)
+        {
+            axis += TriangleNormal(meshlet, t);
+        }
+        axis = axis.Normalized();
+        float min_dot = 1.0F;
+        for (uint32_t t = 0; t < meshlet.triangle_count; ++t)
+        {
+            const MATH::Vec3f normal = TriangleNormal(meshlet, t);
+            if (normal.LengthSquared() > 0.0F)
+            {
+                min_dot = std::min(min_dot, MATH::Vec3f::Dot(normal, axis));
+            }
+        }
+
+        meshlet.cone_axis = axis;
+        meshlet.cone_apex = meshlet.center;
+        if (axis.LengthSquared() == 0.0F || min_dot < kMinConeDot)
+        {
+            meshlet.cone_cutoff = 1.0F;
+            return;
+        }
+        meshlet.cone_cutoff = std::sqrt(1.0F - min_dot * min_dot);
+
+        // Apex: the point on the axis behind every triangle plane, so the test holds for any eye.
+        float max_t = 0.0F;
+        for (uint32_t t = 0; t < meshlet.triangle_count; ++t)
+        {
+            const MATH::Vec3f normal = TriangleNormal(meshlet, t);
+            const float along = MATH::Vec3f::Dot(axis, normal);
+            if (normal.LengthSquared() == 0.0F || along <= 0.0F)
+            {
+                continue;
+            }
+            const MATH::Vec3f& p0 =
+                geometry_.vertices[result_.vertices[meshlet.vertex_offset
+                                                    + result_.triangles[(meshlet.triangle_offset + t) * 3]]]
+                    .position;
+            max_t = std::max(max_t, MATH::Vec3f::Dot(meshlet.center - p0, normal) / along);
+        }
+        meshlet.cone_apex = meshlet.center - axis * max_t;
+    }
+
+    MATH::Vec3f TriangleNormal(const Meshlet& meshlet, uint32_t triangle) const
+    {
+        const size_t base = static_cast<size_t>(meshlet.triangle_offset + triangle) * 3;
+        const auto position = [&](size_t k) -> const MATH::Vec3f& {
+            return geometry_.vertices[result_.vertices[meshlet.vertex_offset + result_.triangles[base + k]]].position;
+        };
+        return MATH::Vec3f::Cross(position(1) - position(0), position(2) - position(0)).Normalized();
+    }
+};
+}  // namespace
+
+std::vector<uint32_t> MeshletMesh::DrawIndices() const
+{
+    std::vector<uint32_t> indices;
+    indices.reserve(triangles.size());
+    for (const Meshlet& meshlet : meshlets)
+    {
+        const size_t base = static_cast<size_t>(meshlet.triangle_offset) * 3;
+        for (size_t i = 0; i < static_cast<size_t>(meshlet.triangle_count) * 3; ++i)
+        {
+            indices.push_back(vertices[meshlet.vertex_offset + triangles[base + i]]);
+        }
+    }
+    return indices;
+}
+
+std::vector<GpuMeshlet> MeshletMesh::GpuMeshlets(uint32_t first_index, int32_t vertex_offset) const
+{
+    std::vector<GpuMeshlet> records;
+    records.reserve(meshlets.size());
+    for (const Meshlet& meshlet : meshlets)
+    {
+        GpuMeshlet record {};
+        record.sphere = MATH::Vec4f{meshlet.center.x, meshlet.center.y, meshlet.center.z, meshlet.radius};
+        record.cone = MATH::Vec4f{meshlet.cone_axis.x, meshlet.cone_axis.y, meshlet.cone_axis.z, meshlet.cone_cutoff};
+        record.apex = MATH::Vec4f{meshlet.cone_apex.x, meshlet.cone_apex.y, meshlet.cone_apex.z, 0.0F};
+        record.first_index = first_index + meshlet.triangle_offset * 3;
+        record.index_count = meshlet.triangle_count * 3;
+        record.vertex_offset = vertex_offset;
+        records.push_back(record);
+    }
+    return records;
+}
+
+MeshletMesh BuildMeshlets(const MeshGeometry& geometry, const MeshletSettings& settings)
+{
+    if (geometry.Empty())
+    {
+        return MeshletMesh{};
+    }
+    MeshletBuilder builder(geometry, settings);
+    return builder.Build();
+}
+}  // namespace ENGINE
+}  // namespace ZKT
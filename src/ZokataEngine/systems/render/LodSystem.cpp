@@ -0,0 +1,167 @@
+#include "ZokataEngine/systems/render/LodSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/glm.hpp>
+#include <imgui.h>
+
+#include "ZokataEngine/systems/render/RenderView.h"
+#include "ZokataEngine/systems/scene/components/MeshComponent.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr float kMinDistance = 0.001F;
+constexpr float kFrameTimeSmoothing = 0.1F;
+
+float MaxAxisScale(const MATH::Mat4f& model)
+{
+    const glm::mat4& m = model.ToGlm();
+    const float sx = glm::dot(glm::vec3(m[0]), glm::vec3(m[0]));
+    const float sy = glm::dot(glm::vec3(m[1]), glm::vec3(m[1]));
+    const float sz = glm::dot(glm::vec3(m[2]), glm::vec3(m[2]));
+    return std::sqrt(std::max({sx, sy, sz}));
+}
+
+// Coarsest level whose projected error is within limit; levels are ordered by increasing error.
+uint32_t CoarsestWithin(const MeshComponent& mesh, float pixels_per_unit, float limit)
+{
+    uint32_t level = 0;
+    for (uint32_t lod = 1; lod < mesh.LodCount(); ++lod)
+    {
+        if (mesh.LodError(lod) * pixels_per_unit > limit)
+        {
+            break;
+        }
+        level = lod;
+    }
+    return level;
+}
+}  // namespace
+
+void LodSystem::Begin(const RenderView& view)
+{
+    stats_ = LodStats{};
+    view_origin_ = view.origin;
+    const glm::mat4& projection = view.projection.ToGlm();
+    // glm::perspective leaves w = -z (m[3][3] == 0); glm::ortho keeps w = 1.
+    perspective_ = projection[3][3] == 0.0F;
+    projection_scale_ = std::abs(projection[1][1]);
+    threshold_ = std::max(0.0001F, settings_.error_threshold_pixels) * std::exp2(EffectiveBias());
+}
+
+uint32_t LodSystem::Select(MeshComponent& mesh, const MATH::Aabb& world_bounds, const MATH::Mat4f& model)
+{
+    uint32_t level = 0;
+    if (settings_.enabled && mesh.LodCount() > 1)
+    {
+        // Pixels covered by one world unit at the nearest point of the bounding sphere.
+        float pixels_per_unit = settings_.viewport_height * projection_scale_ * 0.5F;
+        if (perspective_)
+        {
+            const float radius = world_bounds.Extents().Length();
+            const float distance = (world_bounds.Center() - view_origin_).Length() - radius;
+            pixels_per_unit /= std::max(distance, kMinDistance);
+        }
+        pixels_per_unit *= MaxAxisScale(model);
+
+        const float hysteresis = std::clamp(settings_.hysteresis, 0.0F, 0.95F);
+        const uint32_t coarse = CoarsestWithin(mesh, pixels_per_unit, threshold_ * (1.0F - hysteresis));
+        const uint32_t fine = CoarsestWithin(mesh, pixels_per_unit, threshold_ * (1.0F + hysteresis));
+        level = std::min(mesh.SelectedLod(), mesh.LodCount() - 1);
+        if (level < coarse)
+        {
+            level = coarse;
+        }
+        else if (level > fine)
+        {
+            level = fine;
+        }
+    }
+
+    if (level != mesh.SelectedLod())
+    {
+        ++stats_.switches;
+        mesh.SetSelectedLod(level);
+    }
+    ++stats_.objects;
+    ++stats_.per_level[std::min(level, LodStats::kMaxTrackedLevels - 1)];
+    stats_.full_triangles += mesh.Geometry().TriangleCount();
+    stats_.selected_triangles += mesh.LodGeometry(level).TriangleCount();
+    return level;
+}
+
+void LodSystem::UpdateBudget(float delta_seconds)
+{
+    const float frame_ms = delta_seconds * 1000.0F;
+    smoothed_frame_ms_ = smoothed_frame_ms_ == 0.0F
+        ? frame_ms
+        : smoothed_frame_ms_ + (frame_ms - smoothed_frame_ms_) * kFrameTimeSmoothing;
+
+    if (!settings_.adaptive_bias)
+    {
+        adaptive_bias_ = 0.0F;
+        return;
+    }
+    // Back off quickly when over budget, recover only with clear headroom.
+    if (smoothed_frame_ms_ > settings_.frame_budget_ms)
+    {
+        adaptive_bias_ += settings_.bias_rate * delta_seconds;
+    }
+    else if (smoothed_frame_ms_ < settings_.frame_budget_ms * 0.85F)
+    {
+        adaptive_bias_ -= settings_.bias_rate * 0.5F * delta_seconds;
+    }
+    adaptive_bias_ = std::clamp(adaptive_bias_, 0.0F, std::max(0.0F, settings_.max_bias));
+}
+
+float LodSystem::EffectiveBias() const
+{
+    return settings_.bias + adaptive_bias_;
+}
+
+LodSettings& LodSystem::Settings()
+{
+    return settings_;
+}
+
+const LodStats& LodSystem::Stats() const
+{
+    return stats_;
+}
+
+void LodSystem::DrawDebugGui()
+{
+    ImGui::Checkbox("LOD selection", &settings_.enabled);
+    ImGui::SliderFloat("LOD error (px)", &settings_.error_threshold_pixels, 0.25F, 16.0F);
+    ImGui::SliderFloat("LOD hysteresis", &settings_.hysteresis, 0.0F, 0.9F);
+    ImGui::SliderFloat("LOD bias", &settings_.bias, -2.0F, 4.0F);
+    ImGui::Checkbox("Adaptive LOD bias", &settings_.adaptive_bias);
+    if (settings_.adaptive_bias)
+    {
+        ImGui::SliderFloat("Frame budget (ms)", &settings_.frame_budget_ms, 4.0F, 50.0F);
+    }
+    ImGui::Text("Frame: %.2f ms, effective bias: %.2f", smoothed_frame_ms_, EffectiveBias());
+
+    ImGui::Text("LOD objects: %u, switches: %u", stats_.objects, stats_.switches);
+    for (uint32_t level = 0; level < LodStats::kMaxTrackedLevels; ++level)
+    {
+        if (stats_.per_level[level] != 0)
+        {
+            ImGui::Text("  LOD %u: %u", level, stats_.per_level[level]);
+        }
+    }
+    const double ratio = stats_.full_triangles == 0
+        ? 1.0
+        : static_cast<double>(stats_.selected_triangles) / static_cast<double>(stats_.full_triangles);
+    ImGui::Text("Triangles: %llu of %llu (%.1f%%)",
+                static_cast<unsigned long long>(stats_.selected_triangles),
+                static_cast<unsigned long long>(stats_.full_triangles),
+                ratio * 100.0);
+}
+}  // namespace ENGINE
+}  // namespace ZKT
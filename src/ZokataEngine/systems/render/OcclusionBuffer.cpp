@@ -0,0 +1,361 @@
+#include "ZokataEngine/systems/render/OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ZKT_OCCLUSION_SSE2 1
+#endif
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr float kClearDepth = std::numeric_limits<float>::max();
+constexpr float kNearW = 1e-4F;
+
+MATH::Vec4f ToClip(const glm::mat4& m, const MATH::Vec3f& p)
+{
+    const glm::vec4 c = m * glm::vec4(p.x, p.y, p.z, 1.0F);
+    return {c.x, c.y, c.z, c.w};
+}
+
+MATH::Vec4f LerpClip(const MATH::Vec4f& a, const MATH::Vec4f& b, float t)
+{
+    return a + (b - a) * t;
+}
+}  // namespace
+
+OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height)
+{
+    Resize(width, height);
+}
+
+void OcclusionBuffer::Resize(uint32_t width, uint32_t height)
+{
+    tiles_x_ = std::max(1U, (width + kTileWidth - 1) / kTileWidth);
+    tiles_y_ = std::max(1U, (height + kTileHeight - 1) / kTileHeight);
+    width_ = tiles_x_ * kTileWidth;
+    height_ = tiles_y_ * kTileHeight;
+    depth_.assign(static_cast<size_t>(width_) * height_, kClearDepth);
+    tile_max_.assign(static_cast<size_t>(tiles_x_) * tiles_y_, kClearDepth);
+}
+
+void OcclusionBuffer::Begin(const MATH::Mat4f& view_projection)
+{
+    view_projection_ = view_projection;
+    triangles_.clear();
+    std::fill(depth_.begin(), depth_.end(), kClearDepth);
+    std::fill(tile_max_.begin(), tile_max_.end(), kClearDepth);
+}
+
+void OcclusionBuffer::AddOccluder(const MeshGeometry& geometry, const MATH::Mat4f& model)
+{
+    const glm::mat4 mvp = view_projection_.ToGlm() * model.ToGlm();
+    const auto vertex = [&](uint32_t index) { return ToClip(mvp, geometry.vertices[index].position); };
+
+    const size_t index_count = geometry.Indexed() ? geometry.indices.size() : geometry.vertices.size();
+    for (size_t i = 0; i + 2 < index_count; i += 3)
+    {
+        const uint32_t i0 = geometry.Indexed() ? geometry.indices[i + 0] : static_cast<uint32_t>(i + 0);
+        const uint32_t i1 = geometry.Indexed() ? geometry.indices[i + 1] : static_cast<uint32_t>(i + 1);
+        const uint32_t i2 = geometry.Indexed() ? geometry.indices[i + 2] : static_cast<uint32_t>(i + 2);
+        const MATH::Vec4f clip[3] = {vertex(i0), vertex(i1), vertex(i2)};
+
+        // Clip against w = kNearW; a triangle yields 0, 1 or 2 triangles.
+        MATH::Vec4f poly[4];
+        int count = 0;
+        for (int e = 0; e < 3; ++e)
+        {
+            const MATH::Vec4f& cur = clip[e];
+            const MATH::Vec4f& nxt = clip[(e + 1) % 3];
+            const bool cur_in = cur.w >= kNearW;
+            const bool nxt_in = nxt.w >= kNearW;
+            if (cur_in)
+            {
+                poly[count++] = cur;
+            }
+            if (cur_in != nxt_in)
+            {
+                poly[count++] = LerpClip(cur, nxt, (kNearW - cur.w) / (nxt.w - cur.w));
+            }
+        }
+
+        for (int t = 1; t + 1 < count; ++t)
+        {
+            EmitTriangle(poly[0], poly[t], poly[t + 1]);
+        }
+    }
+}
+
+void OcclusionBuffer::EmitTriangle(const MATH::Vec4f& a, const MATH::Vec4f& b, const MATH::Vec4f& c)
+{
+    ScreenTriangle tri {};
+    const MATH::Vec4f* v[3] = {&a, &b, &c};
+    for (int i = 0; i < 3; ++i)
+    {
+        const float inv_w = 1.0F / v[i]->w;
+        tri.x[i] = (v[i]->x * inv_w * 0.5F + 0.5F) * static_cast<float>(width_);
+        tri.y[i] = (v[i]->y * inv_w * 0.5F + 0.5F) * static_cast<float>(height_);
+        tri.z[i] = v[i]->z * inv_w;
+    }
+
+    const float area = (tri.x[1] - tri.x[0]) * (tri.y[2] - tri.y[0]) - (tri.x[2] - tri.x[0]) * (tri.y[1] - tri.y[0]);
+    if (area == 0.0F || (cull_backfaces_ && area < 0.0F))
+    {
+        return;
+    }
+    if (area < 0.0F)
+    {
+        std::swap(tri.x[1], tri.x[2]);
+        std::swap(tri.y[1], tri.y[2]);
+        std::swap(tri.z[1], tri.z[2]);
+    }
+
+    // Reject triangles entirely off-screen before they reach the rasterizer.
+    const float min_x = std::min({tri.x[0], tri.x[1], tri.x[2]});
+    const float max_x = std::max({tri.x[0], tri.x[1], tri.x[2]});
+    const float min_y = std::min({tri.y[0], tri.y[1], tri.y[2]});
+    const float max_y = std::max({tri.y[0], tri.y[1], tri.y[2]});
+    if (max_x < 0.0F || max_y < 0.0F || min_x >= static_cast<float>(width_) || min_y >= static_cast<float>(height_))
+    {
+        return;
+    }
+
+    triangles_.push_back(tri);
+}
+
+void OcclusionBuffer::Rasterize(JobSystem& jobs)
+{
+    if (triangles_.empty())
+    {
+        return;
+    }
+
+    // One band of tile rows per chunk; bands never share pixels so no synchronization is needed.
+    const size_t band_rows = std::max<size_t>(1, tiles_y_ / std::max<size_t>(1, jobs.WorkerCount() + 1));
+    jobs.ParallelFor(tiles_y_, band_rows, [this](size_t begin, size_t end) {
+        RasterizeBand(static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+        BuildTileMax(static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+    });
+}
+
+void OcclusionBuffer::RasterizeBand(uint32_t tile_row_begin, uint32_t tile_row_end)
+{
+    const uint32_t y_begin = tile_row_begin * kTileHeight;
+    const uint32_t y_end = tile_row_end * kTileHeight;
+    for (const ScreenTriangle& tri : triangles_)
+    {
+        RasterizeTriangle(tri, y_begin, y_end);
+    }
+}
+
+void OcclusionBuffer::RasterizeTriangle(const ScreenTriangle& tri, uint32_t y_begin, uint32_t y_end)
+{
+    const float min_yf = std::min({tri.y[0], tri.y[1], tri.y[2]});
+    const float max_yf = std::max({tri.y[0], tri.y[1], tri.y[2]});
+    const int64_t row_lo = std::max<int64_t>(y_begin, static_cast<int64_t>(std::floor(min_yf)));
+    const int64_t row_hi = std::min<int64_t>(y_end, static_cast<int64_t>(std::ceil(max_yf)));
+    if (row_lo >= row_hi)
+    {
+        return;
+    }
+
+    const float min_xf = std::min({tri.x[0], tri.x[1], tri.x[2]});
+    const float max_xf = std::max({tri.x[0], tri.x[1], tri.x[2]});
+    const int64_t col_lo = std::max<int64_t>(0, static_cast<int64_t>(std::floor(min_xf))) & ~int64_t {3};
+    const int64_t col_hi = std::min<int64_t>(width_, static_cast<int64_t>(std::ceil(max_xf)));
+    if (col_lo >= col_hi)
+    {
+        return;
+    }
+
+    // Edge functions E(x, y) = a*x + b*y + c, positive inside (triangle is counter-clockwise).
+    float ea[3];
+    float eb[3];
+    float ec[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        const int j = (i + 1) % 3;
+        ea[i] = tri.y[i] - tri.y[j];
+        eb[i] = tri.x[j] - tri.x[i];
+        ec[i] = tri.x[i] * tri.y[j] - tri.x[j] * tri.y[i];
+    }
+
+    // Depth plane z(x, y) = zx*x + zy*y + zc from barycentrics.
+    const float area = ec[0] + ec[1] + ec[2];
+    const float inv_area = 1.0F / area;
+    // Edge i is opposite vertex (i + 2) % 3.
+    const float zx = (ea[1] * tri.z[0] + ea[2] * tri.z[1] + ea[0] * tri.z[2]) * inv_area;
+    const float zy = (eb[1] * tri.z[0] + eb[2] * tri.z[1] + eb[0] * tri.z[2]) * inv_area;
+    const float zc = (ec[1] * tri.z[0] + ec[2] * tri.z[1] + ec[0] * tri.z[2]) * inv_area;
+
+#ifdef ZKT_OCCLUSION_SSE2
+    const __m128 lane_offsets = _mm_setr_ps(0.5F, 1.5F, 2.5F, 3.5F);
+    const __m128 zero = _mm_setzero_ps();
+    for (int64_t y = row_lo; y < row_hi; ++y)
+    {
+        const float py = static_cast<float>(y) + 0.5F;
+        float* row = depth_.data() + static_cast<size_t>(y) * width_;
+        const __m128 e0_row = _mm_set1_ps(eb[0] * py + ec[0]);
+        const __m128 e1_row = _mm_set1_ps(eb[1] * py + ec[1]);
+        const __m128 e2_row = _mm_set1_ps(eb[2] * py + ec[2]);
+        const __m128 z_row = _mm_set1_ps(zy * py + zc);
+
+        for (int64_t x = col_lo; x < col_hi; x += 4)
+        {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane_offsets);
+            const __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ea[0]), px), e0_row);
+            const __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ea[1]), px), e1_row);
+            const __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ea[2]), px), e2_row);
+            const __m128 inside = _mm_and_ps(
+                _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+            if (_mm_movemask_ps(inside) == 0)
+            {
+                continue;
+            }
+
+            const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(zx), px), z_row);
+            const __m128 old_depth = _mm_loadu_ps(row + x);
+            const __m128 closer = _mm_min_ps(old_depth, z);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, closer), _mm_andnot_ps(inside, old_depth)));
+        }
+    }
+#else
+    for (int64_t y = row_lo; y < row_hi; ++y)
+    {
+        const float py = static_cast<float>(y) + 0.5F;
+        float* row = depth_.data() + static_cast<size_t>(y) * width_;
+        for (int64_t x = col_lo; x < col_hi; ++x)
+        {
+            const float px = static_cast<float>(x) + 0.5F;
+            if (ea[0] * px + eb[0] * py + ec[0] < 0.0F
+                || ea[1] * px + eb[1] * py + ec[1] < 0.0F
+                || ea[2] * px + eb[2] * py + ec[2] < 0.0F)
+            {
+                continue;
+            }
+            row[x] = std::min(row[x], zx * px + zy * py + zc);
+        }
+    }
+#endif
+}
+
+void OcclusionBuffer::BuildTileMax(uint32_t tile_row_begin, uint32_t tile_row_end)
+{
+    for (uint32_t ty = tile_row_begin; ty < tile_row_end; ++ty)
+    {
+        for (uint32_t tx = 0; tx < tiles_x_; ++tx)
+        {
+            float tile_max = std::numeric_limits<float>::lowest();
+            for (uint32_t py = 0; py < kTileHeight; ++py)
+            {
+                const float* row = depth_.data() + static_cast<size_t>(ty * kTileHeight + py) * width_ + tx * kTileWidth;
+                for (uint32_t px = 0; px < kTileWidth; ++px)
+                {
+                    tile_max = std::max(tile_max, row[px]);
+                }
+            }
+            tile_max_[static_cast<size_t>(ty) * tiles_x_ + tx] = tile_max;
+        }
+    }
+}
+
+bool OcclusionBuffer::IsVisible(const MATH::Aabb& world_bounds) const
+{
+    const glm::mat4& vp = view_projection_.ToGlm();
+
+    float min_x = std::numeric_limits<float>::max();
+    float min_y = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    float max_y = std::numeric_limits<float>::lowest();
+    float min_z = std::numeric_limits<float>::max();
+
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        const MATH::Vec3f p {
+            (corner & 1) ? world_bounds.max.x : world_bounds.min.x,
+            (corner & 2) ? world_bounds.max.y : world_bounds.min.y,
+            (corner & 4) ? world_bounds.max.z : world_bounds.min.z,
+        };
+        const MATH::Vec4f c = ToClip(vp, p);
+        if (c.w < kNearW)
+        {
+            return true;  // straddles the camera plane; never cull
+        }
+        const float inv_w = 1.0F / c.w;
+        const float sx = (c.x * inv_w * 0.5F + 0.5F) * static_cast<float>(width_);
+        const float sy = (c.y * inv_w * 0.5F + 0.5F) * static_cast<float>(height_);
+        min_x = std::min(min_x, sx);
+        max_x = std::max(max_x, sx);
+        min_y = std::min(min_y, sy);
+        max_y = std::max(max_y, sy);
+        min_z = std::min(min_z, c.z * inv_w);
+    }
+
+    const int64_t tx0 = std::clamp<int64_t>(static_cast<int64_t>(std::floor(min_x)) / kTileWidth, 0, tiles_x_ - 1);
+    const int64_t tx1 = std::clamp<int64_t>(static_cast<int64_t>(std::ceil(max_x)) / kTileWidth, 0, tiles_x_ - 1);
+    const int64_t ty0 = std::clamp<int64_t>(static_cast<int64_t>(std::floor(min_y)) / kTileHeight, 0, tiles_y_ - 1);
+    const int64_t ty1 = std::clamp<int64_t>(static_cast<int64_t>(std::ceil(max_y)) / kTileHeight, 0, tiles_y_ - 1);
+
+    for (int64_t ty = ty0; ty <= ty1; ++ty)
+    {
+        const float* row = tile_max_.data() + static_cast<size_t>(ty) * tiles_x_;
+        for (int64_t tx = tx0; tx <= tx1; ++tx)
+        {
+            if (min_z <= row[tx])
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void OcclusionBuffer::SetBackfaceCulling(bool enabled)
+{
+    cull_backfaces_ = enabled;
+}
+
+uint32_t OcclusionBuffer::Width() const
+{
+    return width_;
+}
+
+uint32_t OcclusionBuffer::Height() const
+{
+    return height_;
+}
+
+uint32_t OcclusionBuffer::TilesX() const
+{
+    return tiles_x_;
+}
+
+uint32_t OcclusionBuffer::TilesY() const
+{
+    return tiles_y_;
+}
+
+uint32_t OcclusionBuffer::TriangleCount() const
+{
+    return static_cast<uint32_t>(triangles_.size());
+}
+
+std::span<const float> OcclusionBuffer::Depth() const
+{
+    return depth_;
+}
+
+std::span<const float> OcclusionBuffer::TileMaxDepth() const
+{
+    return tile_max_;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
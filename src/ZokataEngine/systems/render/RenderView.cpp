@@ -0,0 +1,166 @@
+#include "ZokataEngine/systems/render/RenderView.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "ZokataEngine/systems/scene/components/CameraComponent.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+// Picks an up vector that is not parallel to the view direction.
+glm::vec3 StableUp(const MATH::Vec3f& direction)
+{
+    return std::abs(direction.y) > 0.99F ? glm::vec3(0.0F, 0.0F, 1.0F) : glm::vec3(0.0F, 1.0F, 0.0F);
+}
+
+// World-space corners of the camera frustum slice between two view distances.
+std::array<MATH::Vec3f, 8> SliceCorners(const CameraComponent& camera, float near_distance, float far_distance)
+{
+    const glm::mat4 camera_to_world = glm::inverse(camera.GetViewMatrix().ToGlm());
+    const bool perspective = camera.Projection() == ProjectionType::Perspective;
+    const float aspect = std::max(0.0001F, camera.AspectRatio());
+    const float tan_half_fov = std::tan(glm::radians(camera.VerticalFovDegrees()) * 0.5F);
+
+    std::array<MATH::Vec3f, 8> corners {};
+    const float distances[2] = {near_distance, far_distance};
+    for (int slice = 0; slice < 2; ++slice)
+    {
+        const float d = distances[slice];
+        const float half_h = perspective ? d * tan_half_fov : camera.OrthoHeight() * 0.5F;
+        const float half_w = half_h * aspect;
+        for (int i = 0; i < 4; ++i)
+        {
+            const float x = (i & 1) != 0 ? half_w : -half_w;
+            const float y = (i & 2) != 0 ? half_h : -half_h;
+            const glm::vec4 world = camera_to_world * glm::vec4(x, y, -d, 1.0F);
+            corners[slice * 4 + i] = MATH::Vec3f{world.x, world.y, world.z};
+        }
+    }
+    return corners;
+}
+}  // namespace
+
+RenderView RenderView::FromMatrices(RenderViewKind kind,
+                                    const MATH::Mat4f& view,
+                                    const MATH::Mat4f& projection,
+                                    const MATH::Vec3f& origin,
+                                    uint32_t index)
+{
+    RenderView result {};
+    result.kind = kind;
+    result.index = index;
+    result.origin = origin;
+    result.view = view;
+    result.projection = projection;
+    result.view_projection = MATH::Mat4f(projection.ToGlm() * view.ToGlm());
+    result.frustum = MATH::Frustum::FromViewProjection(result.view_projection);
+    return result;
+}
+
+RenderView RenderView::FromCamera(const CameraComponent& camera)
+{
+    const glm::mat4 camera_to_world = glm::inverse(camera.GetViewMatrix().ToGlm());
+    const MATH::Vec3f origin {camera_to_world[3].x, camera_to_world[3].y, camera_to_world[3].z};
+    return FromMatrices(RenderViewKind::Camera, camera.GetViewMatrix(), camera.GetProjectionMatrix(), origin);
+}
+
+const char* RenderViewKindName(RenderViewKind kind)
+{
+    switch (kind)
+    {
+    case RenderViewKind::Camera:
+        return "Camera";
+    case RenderViewKind::ShadowCascade:
+        return "Shadow cascade";
+    case RenderViewKind::ReflectionProbe:
+        return "Reflection probe";
+    }
+    return "Unknown";
+}
+
+void AppendShadowCascadeViews(const CameraComponent& camera,
+                              const MATH::Vec3f& light_direction,
+                              const ShadowCascadeSettings& settings,
+                              std::vector<RenderView>& views)
+{
+    if (settings.cascade_count == 0 || light_direction.Length() <= 0.0001F)
+    {
+        return;
+    }
+    const MATH::Vec3f direction = light_direction.Normalized();
+
+    const float near_plane = std::max(0.0001F, camera.NearPlane());
+    const float far_plane = std::max(near_plane + 0.0001F, std::min(camera.FarPlane(), settings.max_distance));
+    const auto count = static_cast<float>(settings.cascade_count);
+
+    float split_near = near_plane;
+    for (uint32_t cascade = 0; cascade < settings.cascade_count; ++cascade)
+    {
+        // Practical split scheme: blend of logarithmic and uniform distribution.
+        const float t = static_cast<float>(cascade + 1) / count;
+        const float log_split = near_plane * std::pow(far_plane / near_plane, t);
+        const float uniform_split = near_plane + (far_plane - near_plane) * t;
+        const float split_far = settings.split_lambda * log_split + (1.0F - settings.split_lambda) * uniform_split;
+
+        const std::array<MATH::Vec3f, 8> corners = SliceCorners(camera, split_near, split_far);
+        MATH::Vec3f center {};
+        for (const MATH::Vec3f& corner : corners)
+        {
+            center += corner;
+        }
+        center /= 8.0F;
+        float radius = 0.0F;
+        for (const MATH::Vec3f& corner : corners)
+        {
+            radius = std::max(radius, (corner - center).Length());
+        }
+
+        const float depth = 2.0F * radius + settings.caster_margin;
+        const MATH::Vec3f eye = center - direction * (radius + settings.caster_margin);
+        const glm::mat4 view = glm::lookAt(eye.ToGlm(), center.ToGlm(), StableUp(direction));
+        const glm::mat4 projection = glm::ortho(-radius, radius, -radius, radius, 0.0F, depth);
+        views.push_back(RenderView::FromMatrices(
+            RenderViewKind::ShadowCascade, MATH::Mat4f(view), MATH::Mat4f(projection), eye, cascade));
+
+        split_near = split_far;
+    }
+}
+
+void AppendReflectionProbeViews(const MATH::Vec3f& position,
+                                float near_plane,
+                                float far_plane,
+                                std::vector<RenderView>& views)
+{
+    // Standard cube map face order: +X, -X, +Y, -Y, +Z, -Z.
+    static const std::array<glm::vec3, 6> kForward = {
+        glm::vec3(1.0F, 0.0F, 0.0F), glm::vec3(-1.0F, 0.0F, 0.0F),
+        glm::vec3(0.0F, 1.0F, 0.0F), glm::vec3(0.0F, -1.0F, 0.0F),
+        glm::vec3(0.0F, 0.0F, 1.0F), glm::vec3(0.0F, 0.0F, -1.0F),
+    };
+    static const std::array<glm::vec3, 6> kUp = {
+        glm::vec3(0.0F, -1.0F, 0.0F), glm::vec3(0.0F, -1.0F, 0.0F),
+        glm::vec3(0.0F, 0.0F, 1.0F), glm::vec3(0.0F, 0.0F, -1.0F),
+        glm::vec3(0.0F, -1.0F, 0.0F), glm::vec3(0.0F, -1.0F, 0.0F),
+    };
+
+    const float safe_near = std::max(0.0001F, near_plane);
+    const glm::mat4 projection =
+        glm::perspective(glm::radians(90.0F), 1.0F, safe_near, std::max(safe_near + 0.0001F, far_plane));
+    const glm::vec3 eye = position.ToGlm();
+    for (uint32_t face = 0; face < kForward.size(); ++face)
+    {
+        const glm::mat4 view = glm::lookAt(eye, eye + kForward[face], kUp[face]);
+        views.push_back(RenderView::FromMatrices(
+            RenderViewKind::ReflectionProbe, MATH::Mat4f(view), MATH::Mat4f(projection), position, face));
+    }
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,393 @@
+#include "ZokataEngine/systems/render/VisibilitySystem.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+
+#include <imgui.h>
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/scene/Entity.h"
+#include "ZokataEngine/systems/scene/Scene.h"
+#include "ZokataEngine/systems/scene/components/CameraComponent.h"
+#include "ZokataEngine/systems/scene/components/MeshComponent.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr size_t kOcclusionTestGrain = 256;
+
+ImU32 DepthColor(float depth)
+{
+    if (depth == std::numeric_limits<float>::max())
+    {
+        return IM_COL32(0, 0, 0, 255);
+    }
+    // NDC depth is heavily compressed towards 1; stretch the far end so occluders are readable.
+    const float t = std::clamp(depth, 0.0F, 1.0F);
+    const auto shade = static_cast<int>(255.0F * (1.0F - t * t * t * t));
+    return IM_COL32(shade, shade, shade, 255);
+}
+}  // namespace
+
+VisibilitySystem::VisibilitySystem(JobSystem& jobs)
+    : jobs_(jobs)
+    , occlusion_(settings_.occlusion_width, settings_.occlusion_height)
+{
+    // Callers keep pointers to Draws(0); reserving up front stops resizes from moving it.
+    draws_.reserve(RenderView::kMaxViews);
+    draws_.resize(1);
+}
+
+void VisibilitySystem::Run(Scene& scene, const CameraComponent& camera)
+{
+    camera_views_.clear();
+    camera_views_.push_back(RenderView::FromCamera(camera));
+    if (settings_.shadow_views)
+    {
+        AppendShadowCascadeViews(camera, settings_.sun_direction, settings_.cascades, camera_views_);
+    }
+    Run(scene, camera_views_);
+}
+
+void VisibilitySystem::Run(Scene& scene, std::span<const RenderView> views)
+{
+    const size_t view_count = std::min<size_t>(views.size(), RenderView::kMaxViews);
+    views_.assign(views.begin(), views.begin() + static_cast<std::ptrdiff_t>(view_count));
+    draws_.resize(std::max<size_t>(view_count, 1));
+    for (size_t v = 0; v < draws_.size(); ++v)
+    {
+        draws_[v].Clear();
+        if (v < view_count)
+        {
+            draws_[v].view_projection = views_[v].view_projection;
+            draws_[v].camera_position = views_[v].origin;
+        }
+    }
+    if (view_count == 0)
+    {
+        return;
+    }
+
+    CollectCandidates(scene);
+    CullOccluded(views_.front().view_projection);
+    lod_.Begin(views_.front());
+    ExtractDraws();
+}
+
+void VisibilitySystem::Reset()
+{
+    views_.clear();
+    draws_.resize(1);
+    draws_.front().Clear();
+}
+
+void VisibilitySystem::SetExternalDraws(std::span<const ExternalDraw> draws)
+{
+    external_draws_ = draws;
+}
+
+const DrawList& VisibilitySystem::Draws(size_t view) const
+{
+    return draws_.at(view);
+}
+
+size_t VisibilitySystem::ViewCount() const
+{
+    return views_.size();
+}
+
+const RenderView& VisibilitySystem::View(size_t view) const
+{
+    return views_.at(view);
+}
+
+VisibilitySettings& VisibilitySystem::Settings()
+{
+    return settings_;
+}
+
+const OcclusionBuffer& VisibilitySystem::Occlusion() const
+{
+    return occlusion_;
+}
+
+LodSystem& VisibilitySystem::Lod()
+{
+    return lod_;
+}
+
+void VisibilitySystem::CollectCandidates(Scene& scene)
+{
+    const SceneSpatialIndex& spatial = scene.Spatial();
+    const auto view_count = static_cast<uint32_t>(views_.size());
+    const uint32_t all_views = view_count == 32 ? ~0U : (1U << view_count) - 1U;
+
+    frustum_hits_.clear();
+    if (settings_.frustum_culling)
+    {
+        frustums_.clear();
+        for (const RenderView& view : views_)
+        {
+            frustums_.push_back(view.frustum);
+        }
+        spatial.OverlapFrustums(frustums_, frustum_hits_);
+    }
+    else
+    {
+        for (Entity* entity : scene.AllRuntimeEntities())
+        {
+            frustum_hits_.push_back(SpatialViewHit{entity, all_views});
+        }
+    }
+
+    // Only entities with mesh bounds could have drawn, so those are what the frustum culled.
+    candidates_.clear();
+    for (uint32_t v = 0; v < view_count && settings_.frustum_culling; ++v)
+    {
+        draws_[v].frustum_culled = static_cast<uint32_t>(spatial.MeshCount());
+    }
+    for (const SpatialViewHit& hit : frustum_hits_)
+    {
+        for (uint32_t mask = settings_.frustum_culling && hit.has_mesh ? hit.view_mask : 0U; mask != 0; mask &= mask - 1)
+        {
+            --draws_[std::countr_zero(mask)].frustum_culled;
+        }
+
+        auto* mesh = hit.entity->GetComponent<MeshComponent>();
+        if (mesh == nullptr || !mesh->Enabled() || !mesh->IsVisible() || mesh->Geometry().Empty())
+        {
+            continue;
+        }
+        candidates_.push_back(Candidate{hit.entity, mesh, spatial.WorldBounds(*hit.entity), hit.view_mask, false});
+        for (uint32_t mask = hit.view_mask; mask != 0; mask &= mask - 1)
+        {
+            ++draws_[std::countr_zero(mask)].candidates;
+        }
+    }
+}
+
+void VisibilitySystem::CullOccluded(const MATH::Mat4f& view_projection)
+{
+    if (!settings_.occlusion_culling)
+    {
+        return;
+    }
+
+    if (occlusion_.Width() != settings_.occlusion_width || occlusion_.Height() != settings_.occlusion_height)
+    {
+        occlusion_.Resize(settings_.occlusion_width, settings_.occlusion_height);
+    }
+    occlusion_.SetBackfaceCulling(settings_.occluder_backface_culling);
+    occlusion_.Begin(view_projection);
+
+    // The software depth buffer is rendered from the main view, so only its bit is culled;
+    // shadow and probe views keep their frustum result.
+    bool any_occluder = false;
+    for (const Candidate& candidate : candidates_)
+    {
+        if ((candidate.view_mask & 1U) != 0 && candidate.mesh->IsOccluder())
+        {
+            occlusion_.AddOccluder(candidate.mesh->Geometry(), candidate.entity->Transform().GetModelMatrix());
+            any_occluder = true;
+        }
+    }
+    if (!any_occluder)
+    {
+        return;
+    }
+
+    occlusion_.Rasterize(jobs_);
+
+    jobs_.ParallelFor(candidates_.size(), kOcclusionTestGrain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            // Occluders are never tested: they would be hidden by their own depth.
+            Candidate& candidate = candidates_[i];
+            if ((candidate.view_mask & 1U) != 0 && !candidate.mesh->IsOccluder()
+                && !occlusion_.IsVisible(candidate.world_bounds))
+            {
+                candidate.view_mask &= ~1U;
+                candidate.occluded = true;
+            }
+        }
+    });
+}
+
+void VisibilitySystem::ExtractDraws()
+{
+    batch_keys_.resize(draws_.size());
+    for (size_t v = 0; v < draws_.size(); ++v)
+    {
+        draws_[v].items.reserve(draws_[v].candidates);
+        batch_keys_[v].clear();
+    }
+    for (const Candidate& candidate : candidates_)
+    {
+        if (candidate.occluded)
+        {
+            ++draws_.front().occlusion_culled;
+        }
+        if (candidate.view_mask == 0)
+        {
+            continue;
+        }
+        const MATH::Mat4f& model = candidate.entity->Transform().GetModelMatrix();
+        const uint32_t lod = lod_.Select(*candidate.mesh, candidate.world_bounds, model);
+        const MeshGeometry& geometry = candidate.mesh->LodGeometry(lod);
+        const uint64_t material = candidate.mesh->MaterialKey();
+        const size_t triangles = geometry.TriangleCount();
+        for (uint32_t mask = candidate.view_mask; mask != 0; mask &= mask - 1)
+        {
+            const auto v = static_cast<size_t>(std::countr_zero(mask));
+            DrawList& draws = draws_[v];
+            batch_keys_[v].push_back(BatchKey{&geometry, material, static_cast<uint32_t>(draws.items.size())});
+            draws.items.push_back(DrawItem{candidate.mesh, model, lod});
+            draws.triangles += triangles;
+        }
+    }
+    ExtractExternalDraws();
+
+    for (size_t v = 0; v < draws_.size(); ++v)
+    {
+        BuildBatches(draws_[v], batch_keys_[v]);
+    }
+}
+
+void VisibilitySystem::ExtractExternalDraws()
+{
+    for (const ExternalDraw& external : external_draws_)
+    {
+        const MeshGeometry& geometry = external.renderable->Geometry();
+        const uint64_t material = external.renderable->MaterialKey();
+        for (size_t v = 0; v < views_.size(); ++v)
+        {
+            DrawList& draws = draws_[v];
+            if (settings_.frustum_culling && !views_[v].frustum.Intersects(external.world_bounds))
+            {
+                ++draws.frustum_culled;
+                continue;
+            }
+            ++draws.candidates;
+            batch_keys_[v].push_back(BatchKey{&geometry, material, static_cast<uint32_t>(draws.items.size())});
+            draws.items.push_back(DrawItem{external.renderable, external.model, 0});
+            draws.triangles += geometry.TriangleCount();
+        }
+    }
+}
+
+void VisibilitySystem::BuildBatches(DrawList& draws, std::vector<BatchKey>& keys) const
+{
+    // Shared geometry has one address (GeometryCache, shared LOD chains), so the pointer plus
+    // the material's content hash identifies draws that can be instanced together.
+    if (settings_.instancing)
+    {
+        std::sort(keys.begin(), keys.end(), [](const BatchKey& a, const BatchKey& b) {
+            if (a.geometry != b.geometry)
+            {
+                return std::less<const MeshGeometry*>{}(a.geometry, b.geometry);
+            }
+            if (a.material != b.material)
+            {
+                return a.material < b.material;
+            }
+            return a.item < b.item;
+        });
+    }
+
+    draws.instances.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        const BatchKey& key = keys[i];
+        const DrawItem& item = draws.items[key.item];
+        const bool same_batch = settings_.instancing && i > 0 && keys[i - 1].geometry == key.geometry
+            && keys[i - 1].material == key.material;
+        if (!same_batch)
+        {
+            draws.batches.push_back(DrawBatch{
+                item.renderable, key.geometry, item.lod, static_cast<uint32_t>(draws.instances.size()), 0});
+        }
+        draws.instances.push_back(item.model);
+        ++draws.batches.back().instance_count;
+    }
+}
+
+void VisibilitySystem::DrawDebugGui()
+{
+    if (!ImGui::Begin("Visibility"))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Checkbox("Frustum culling", &settings_.frustum_culling);
+    ImGui::Checkbox("Occlusion culling", &settings_.occlusion_culling);
+    ImGui::Checkbox("Cull occluder backfaces", &settings_.occluder_backface_culling);
+    ImGui::Checkbox("Automatic instancing", &settings_.instancing);
+
+    ImGui::Checkbox("Shadow cascade views", &settings_.shadow_views);
+    if (settings_.shadow_views)
+    {
+        int cascade_count = static_cast<int>(settings_.cascades.cascade_count);
+        if (ImGui::SliderInt("Cascades", &cascade_count, 1, 8))
+        {
+            settings_.cascades.cascade_count = static_cast<uint32_t>(cascade_count);
+        }
+        ImGui::DragFloat("Shadow distance", &settings_.cascades.max_distance, 1.0F, 1.0F, 10000.0F);
+    }
+
+    ImGui::Separator();
+    for (size_t v = 0; v < views_.size(); ++v)
+    {
+        const DrawList& draws = draws_[v];
+        ImGui::Text("%zu %s %u: %u candidates, %u frustum culled, %u occlusion culled, %zu draws, %zu batches, %llu tris",
+                    v,
+                    RenderViewKindName(views_[v].kind),
+                    views_[v].index,
+                    draws.candidates,
+                    draws.frustum_culled,
+                    draws.occlusion_culled,
+                    draws.items.size(),
+                    draws.batches.size(),
+                    static_cast<unsigned long long>(draws.triangles));
+    }
+    ImGui::Text("Occluder triangles: %u", occlusion_.TriangleCount());
+
+    ImGui::Separator();
+    lod_.DrawDebugGui();
+
+    ImGui::Separator();
+    ImGui::Checkbox("Show tile max depth", &show_tile_max_);
+
+    // Drawn as filled rects (2x2 pixel blocks or whole tiles) to avoid a texture upload path.
+    const uint32_t block_w = show_tile_max_ ? OcclusionBuffer::kTileWidth : 2;
+    const uint32_t block_h = show_tile_max_ ? OcclusionBuffer::kTileHeight : 2;
+    const float scale = 2.0F;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const uint32_t width = occlusion_.Width();
+    const uint32_t height = occlusion_.Height();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+    for (uint32_t y = 0; y < height; y += block_h)
+    {
+        for (uint32_t x = 0; x < width; x += block_w)
+        {
+            const float depth = show_tile_max_
+                ? occlusion_.TileMaxDepth()[(y / block_h) * occlusion_.TilesX() + x / block_w]
+                : occlusion_.Depth()[static_cast<size_t>(y) * width + x];
+            const float top = origin.y + static_cast<float>(y) * scale;
+            const ImVec2 p0(origin.x + static_cast<float>(x) * scale, top);
+            const ImVec2 p1(p0.x + static_cast<float>(block_w) * scale, top + static_cast<float>(block_h) * scale);
+            draw_list->AddRectFilled(p0, p1, DepthColor(depth));
+        }
+    }
+    ImGui::Dummy(ImVec2(static_cast<float>(width) * scale, static_cast<float>(height) * scale));
+
+    ImGui::End();
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,585 @@
+#include "ZokataEngine/systems/scene/CookedScene.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "ZokataEngine/systems/asset/ContentHash.h"
+#include "ZokataEngine/systems/asset/MappedFile.h"
+#include "ZokataEngine/systems/scene/SceneComponentRegistry.h"
+#include "ZokataEngine/systems/scene/components/CameraComponent.h"
+#include "ZokataEngine/systems/scene/components/MeshComponent.h"
+#include "ZokataEngine/systems/scene/components/TransformComponent.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+static_assert(std::is_trivially_copyable_v<MeshVertex>, "cooked vertices are bulk-copied");
+
+constexpr size_t kSectionCount = static_cast<size_t>(COOKED::SectionType::Count);
+
+// Registered components the format rebuilds; a scene using any other registered one is not cooked.
+constexpr std::array<std::string_view, 3> kCookedComponents {"Transform", "MeshRenderer", "Camera"};
+
+COOKED::CameraRecord MakeCameraRecord(const CameraComponent& camera)
+{
+    COOKED::CameraRecord record {};
+    record.projection = static_cast<uint32_t>(camera.Projection());
+    record.vertical_fov_degrees = camera.VerticalFovDegrees();
+    record.aspect_ratio = camera.AspectRatio();
+    record.near_plane = camera.NearPlane();
+    record.far_plane = camera.FarPlane();
+    record.ortho_height = camera.OrthoHeight();
+    record.exposure = camera.Exposure();
+    const MATH::Vec4f& color = camera.ClearColor();
+    record.clear_color[0] = color.x;
+    record.clear_color[1] = color.y;
+    record.clear_color[2] = color.z;
+    record.clear_color[3] = color.w;
+    return record;
+}
+
+void ApplyCameraRecord(const COOKED::CameraRecord& record, CameraComponent& camera)
+{
+    camera.SetProjection(static_cast<ProjectionType>(record.projection));
+    camera.SetVerticalFovDegrees(record.vertical_fov_degrees);
+    camera.SetAspectRatio(record.aspect_ratio);
+    camera.SetNearPlane(record.near_plane);
+    camera.SetFarPlane(record.far_plane);
+    camera.SetOrthoHeight(record.ortho_height);
+    camera.SetExposure(record.exposure);
+    camera.SetClearColor(
+        MATH::Vec4f{record.clear_color[0], record.clear_color[1], record.clear_color[2], record.clear_color[3]});
+}
+
+uint64_t AlignUp(uint64_t value)
+{
+    return (value + COOKED::kAlignment - 1) & ~(COOKED::kAlignment - 1);
+}
+
+class Writer
+{
+public:
+    COOKED::String AddString(std::string_view text)
+    {
+        const auto [it, inserted] = string_offsets_.try_emplace(std::string(text), static_cast<uint32_t>(strings_.size()));
+        if (inserted)
+        {
+            strings_.insert(strings_.end(), text.begin(), text.end());
+        }
+        return COOKED::String{it->second, static_cast<uint32_t>(text.size())};
+    }
+
+    template <typename T>
+    void SetSection(COOKED::SectionType type, const std::vector<T>& records)
+    {
+        Section& section = sections_[static_cast<size_t>(type)];
+        section.element_size = sizeof(T);
+        section.count = records.size();
+        section.bytes.resize(records.size() * sizeof(T));
+        if (!records.empty())
+        {
+            std::memcpy(section.bytes.data(), records.data(), section.bytes.size());
+        }
+    }
+
+    void Write(const std::filesystem::path& out_path, COOKED::String scene_name)
+    {
+        SetSection(COOKED::SectionType::Strings, strings_);
+
+        COOKED::Header header {};
+        std::memcpy(header.magic, COOKED::kMagic, sizeof(header.magic));
+        header.version = COOKED::kVersion;
+        header.section_count = static_cast<uint32_t>(kSectionCount);
+        header.scene_name = scene_name;
+
+        std::vector<COOKED::Section> table(kSectionCount);
+        uint64_t offset = AlignUp(sizeof(COOKED::Header) + kSectionCount * sizeof(COOKED::Section));
+        for (size_t i = 0; i < kSectionCount; ++i)
+        {
+            table[i].type = static_cast<COOKED::SectionType>(i);
+            table[i].element_size = sections_[i].element_size;
+            table[i].count = sections_[i].count;
+            table[i].offset = offset;
+            offset = AlignUp(offset + sections_[i].bytes.size());
+        }
+        header.file_size = offset;
+
+        std::vector<char> blob(offset, 0);
+        std::memcpy(blob.data(), &header, sizeof(header));
+        std::memcpy(blob.data() + sizeof(header), table.data(), table.size() * sizeof(COOKED::Section));
+        for (size_t i = 0; i < kSectionCount; ++i)
+        {
+            if (!sections_[i].bytes.empty())
+            {
+                std::memcpy(blob.data() + table[i].offset, sections_[i].bytes.data(), sections_[i].bytes.size());
+            }
+        }
+
+        // Readers never see a partially written file: write beside it, then swap it in.
+        std::filesystem::path temp_path = out_path;
+        temp_path += ".tmp";
+        {
+            std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+            out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+            if (!out)
+            {
+                throw std::runtime_error("Failed to write " + temp_path.string());
+            }
+        }
+        std::filesystem::rename(temp_path, out_path);
+    }
+
+private:
+    struct Section
+    {
+        uint32_t element_size = 0;
+        uint64_t count = 0;
+        std::vector<char> bytes;
+    };
+
+    std::vector<char> strings_;
+    std::unordered_map<std::string, uint32_t> string_offsets_;
+    Section sections_[kSectionCount];
+};
+
+class Reader
+{
+public:
+    explicit Reader(const std::filesystem::path& path)
+        : file_(path)
+    {
+        const std::span<const uint8_t> bytes = file_.Bytes();
+        if (bytes.size() < sizeof(COOKED::Header))
+        {
+            Fail("truncated header");
+        }
+        std::memcpy(&header_, bytes.data(), sizeof(header_));
+        if (std::memcmp(header_.magic, COOKED::kMagic, sizeof(header_.magic)) != 0)
+        {
+            Fail("not a cooked scene");
+        }
+        if (header_.version != COOKED::kVersion)
+        {
+            Fail("version " + std::to_string(header_.version) + ", expected " + std::to_string(COOKED::kVersion));
+        }
+        if (header_.file_size != bytes.size() || header_.section_count < kSectionCount
+            || sizeof(COOKED::Header) + header_.section_count * sizeof(COOKED::Section) > bytes.size())
+        {
+            Fail("corrupt section table");
+        }
+        for (size_t i = 0; i < kSectionCount; ++i)
+        {
+            std::memcpy(&sections_[i], bytes.data() + sizeof(COOKED::Header) + i * sizeof(COOKED::Section), sizeof(COOKED::Section));
+            const COOKED::Section& section = sections_[i];
+            if (section.type != static_cast<COOKED::SectionType>(i) || section.offset % COOKED::kAlignment != 0
+                || section.offset > bytes.size()
+                || (section.element_size != 0 && section.count > (bytes.size() - section.offset) / section.element_size))
+            {
+                Fail("corrupt section " + std::to_string(i));
+            }
+        }
+    }
+
+    const COOKED::Header& Header() const
+    {
+        return header_;
+    }
+
+    /**
+     * @brief Typed view of a section; sections are 16-byte aligned, so records are read in place.
+     */
+    template <typename T>
+    std::span<const T> Records(COOKED::SectionType type) const
+    {
+        const COOKED::Section& section = sections_[static_cast<size_t>(type)];
+        if (section.count == 0)
+        {
+            return {};
+        }
+        if (section.element_size != sizeof(T))
+        {
+            Fail("unexpected record size in section " + std::to_string(static_cast<uint32_t>(type)));
+        }
+        return {reinterpret_cast<const T*>(file_.Bytes().data() + section.offset), static_cast<size_t>(section.count)};
+    }
+
+    std::string_view Text(COOKED::String text) const
+    {
+        const std::span<const char> strings = Records<char>(COOKED::SectionType::Strings);
+        if (static_cast<uint64_t>(text.offset) + text.length > strings.size())
+        {
+            Fail("string out of range");
+        }
+        return {strings.data() + text.offset, text.length};
+    }
+
+    [[noreturn]] void Fail(const std::string& what) const
+    {
+        throw std::runtime_error(file_.Path().string() + ": " + what);
+    }
+
+private:
+    MappedFile file_;
+    COOKED::Header header_ {};
+    COOKED::Section sections_[kSectionCount] {};
+};
+
+int64_t WriteTime(const std::filesystem::path& path, std::error_code& ec)
+{
+    return std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+}
+}  // namespace
+
+std::filesystem::path CookedScenePath(const std::filesystem::path& scene_path)
+{
+    std::filesystem::path path = scene_path;
+    return path.replace_extension(".zkscene");
+}
+
+void CookScene(const Scene& scene, std::span<const std::filesystem::path> sources, const std::filesystem::path& out_path)
+{
+    Writer writer;
+    std::vector<COOKED::EntityRecord> entities;
+    std::vector<COOKED::String> component_names;
+    std::vector<COOKED::MeshRecord> meshes;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<COOKED::LodRecord> lods;
+    std::vector<COOKED::MaterialRecord> materials;
+    std::vector<COOKED::CameraRecord> cameras;
+    std::unordered_map<const MeshGeometry*, int32_t> mesh_slots;
+    std::unordered_map<uint64_t, int32_t> material_slots;  // by MaterialKey
+    const uint64_t default_material = HashMaterial(MaterialDescriptor {});
+
+    const auto add_geometry = [&](const MeshGeometry& geometry) {
+        const auto slot = static_cast<uint32_t>(meshes.size());
+        COOKED::MeshRecord record {};
+        record.first_vertex = vertices.size();
+        record.vertex_count = geometry.vertices.size();
+        record.first_index = indices.size();
+        record.index_count = geometry.indices.size();
+        meshes.push_back(record);
+        vertices.insert(vertices.end(), geometry.vertices.begin(), geometry.vertices.end());
+        indices.insert(indices.end(), geometry.indices.begin(), geometry.indices.end());
+        return slot;
+    };
+
+    // The loader records one SceneEntity per runtime entity, in the same preorder.
+    const std::vector<SceneEntity>& summaries = scene.Entities();
+    const std::function<void(const Entity&, int32_t)> visit = [&](const Entity& entity, int32_t parent) {
+        const auto index = static_cast<int32_t>(entities.size());
+        COOKED::EntityRecord record {};
+        record.id = entity.Id();
+        record.name = writer.AddString(entity.Name());
+        record.parent = parent;
+
+        if (static_cast<size_t>(index) < summaries.size() && summaries[index].id == entity.Id())
+        {
+            record.first_component = static_cast<uint32_t>(component_names.size());
+            const SceneComponentRegistry& registry = SceneComponentRegistry::Default();
+            for (const SceneComponentSummary& component : summaries[index].components)
+            {
+                // Unregistered names are skipped by the loader as well; registered ones must survive.
+                if (registry.Find(component.name) != SceneComponentRegistry::kUnknown
+                    && std::find(kCookedComponents.begin(), kCookedComponents.end(), component.name)
+                        == kCookedComponents.end())
+                {
+                    throw std::runtime_error(
+                        "Component '" + component.name + "' of entity " + std::to_string(entity.Id())
+                        + " has no cooked form.");
+                }
+                component_names.push_back(writer.AddString(component.name));
+            }
+            record.component_count = static_cast<uint32_t>(component_names.size()) - record.first_component;
+        }
+
+        const TransformComponent& transform = entity.Transform();
+        const glm::quat& rotation = transform.GetQuaternion().ToGlm();
+        const MATH::Vec3f& position = transform.GetPosition();
+        const MATH::Vec3f& scale = transform.GetScale();
+        record.position[0] = position.x;
+        record.position[1] = position.y;
+        record.position[2] = position.z;
+        record.scale[0] = scale.x;
+        record.scale[1] = scale.y;
+        record.scale[2] = scale.z;
+        record.rotation[0] = rotation.w;
+        record.rotation[1] = rotation.x;
+        record.rotation[2] = rotation.y;
+        record.rotation[3] = rotation.z;
+
+        if (const auto* mesh = entity.GetComponent<MeshComponent>(); mesh != nullptr && !mesh->Geometry().Empty())
+        {
+            const MeshGeometry& geometry = mesh->Geometry();
+            const auto [slot, inserted] = mesh_slots.try_emplace(&geometry, static_cast<int32_t>(meshes.size()));
+            if (inserted)
+            {
+                add_geometry(geometry);
+                // The first component seen with this geometry provides the chain; the loaders
+                // give every component sharing geometry the same one.
+                const auto first_lod = static_cast<uint32_t>(lods.size());
+                for (uint32_t level = 1; level < mesh->LodCount(); ++level)
+                {
+                    lods.push_back(COOKED::LodRecord{add_geometry(mesh->LodGeometry(level)), mesh->LodError(level)});
+                }
+                COOKED::MeshRecord& base = meshes[static_cast<size_t>(slot->second)];
+                base.first_lod = first_lod;
+                base.lod_count = static_cast<uint32_t>(lods.size()) - first_lod;
+            }
+            record.mesh = slot->second;
+            record.mesh_asset = writer.AddString(mesh->MeshAssetId());
+            record.material_asset = writer.AddString(mesh->MaterialAssetId());
+
+            if (mesh->MaterialKey() != default_material)
+            {
+                const MaterialDescriptor& material = mesh->Material();
+                const auto [material_slot, added] =
+                    material_slots.try_emplace(mesh->MaterialKey(), static_cast<int32_t>(materials.size()));
+                if (added)
+                {
+                    COOKED::MaterialRecord material_record {};
+                    material_record.shader = writer.AddString(material.shader_id);
+                    for (size_t t = 0; t < material.textures.size(); ++t)
+                    {
+                        material_record.textures[t] = writer.AddString(material.textures[t]);
+                    }
+                    materials.push_back(material_record);
+                }
+                record.material = material_slot->second;
+            }
+        }
+        if (const auto* camera = entity.GetComponent<CameraComponent>())
+        {
+            record.camera = static_cast<int32_t>(cameras.size());
+            cameras.push_back(MakeCameraRecord(*camera));
+        }
+        entities.push_back(record);
+
+        for (const auto& child : entity.Children())
+        {
+            visit(*child, index);
+        }
+    };
+    for (const auto& root : scene.RuntimeRoots())
+    {
+        visit(*root, -1);
+    }
+
+    std::vector<COOKED::SourceRecord> source_records;
+    for (const std::filesystem::path& source : sources)
+    {
+        std::error_code ec;
+        const std::filesystem::path absolute = std::filesystem::absolute(source, ec);
+        COOKED::SourceRecord record {};
+        record.path = writer.AddString(absolute.generic_string());
+        record.size = std::filesystem::file_size(absolute, ec);
+        record.write_time = WriteTime(absolute, ec);
+        if (ec)
+        {
+            throw std::runtime_error("Failed to stat cook source " + source.string() + ": " + ec.message());
+        }
+        record.content_hash = HashFileContents(absolute);
+        source_records.push_back(record);
+    }
+
+    writer.SetSection(COOKED::SectionType::Entities, entities);
+    writer.SetSection(COOKED::SectionType::ComponentNames, component_names);
+    writer.SetSection(COOKED::SectionType::Meshes, meshes);
+    writer.SetSection(COOKED::SectionType::Vertices, vertices);
+    writer.SetSection(COOKED::SectionType::Indices, indices);
+    writer.SetSection(COOKED::SectionType::Sources, source_records);
+    writer.SetSection(COOKED::SectionType::Lods, lods);
+    writer.SetSection(COOKED::SectionType::Materials, materials);
+    writer.SetSection(COOKED::SectionType::Cameras, cameras);
+    const COOKED::String scene_name = writer.AddString(scene.Name());
+    writer.Write(out_path, scene_name);
+}
+
+bool IsCookedSceneCurrent(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec))
+    {
+        return false;
+    }
+    try
+    {
+        const Reader reader(path);
+        const auto sources = reader.Records<COOKED::SourceRecord>(COOKED::SectionType::Sources);
+        if (sources.empty())
+        {
+            return false;
+        }
+        for (const COOKED::SourceRecord& source : sources)
+        {
+            const std::filesystem::path source_path(reader.Text(source.path));
+            if (std::filesystem::file_size(source_path, ec) != source.size || ec)
+            {
+                return false;
+            }
+            if ((WriteTime(source_path, ec) != source.write_time || ec) && HashFileContents(source_path) != source.content_hash)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+std::vector<std::filesystem::path> CookedSceneSources(const std::filesystem::path& path)
+{
+    std::vector<std::filesystem::path> sources;
+    try
+    {
+        const Reader reader(path);
+        for (const COOKED::SourceRecord& source : reader.Records<COOKED::SourceRecord>(COOKED::SectionType::Sources))
+        {
+            sources.emplace_back(reader.Text(source.path));
+        }
+    }
+    catch (const std::exception&)
+    {
+        sources.clear();
+    }
+    return sources;
+}
+
+std::unique_ptr<Scene> LoadCookedScene(const std::filesystem::path& path)
+{
+    const Reader reader(path);
+    const auto entities = reader.Records<COOKED::EntityRecord>(COOKED::SectionType::Entities);
+    const auto component_names = reader.Records<COOKED::String>(COOKED::SectionType::ComponentNames);
+    const auto meshes = reader.Records<COOKED::MeshRecord>(COOKED::SectionType::Meshes);
+    const auto vertices = reader.Records<MeshVertex>(COOKED::SectionType::Vertices);
+    const auto indices = reader.Records<uint32_t>(COOKED::SectionType::Indices);
+    const auto lods = reader.Records<COOKED::LodRecord>(COOKED::SectionType::Lods);
+    const auto material_records = reader.Records<COOKED::MaterialRecord>(COOKED::SectionType::Materials);
+    const auto cameras = reader.Records<COOKED::CameraRecord>(COOKED::SectionType::Cameras);
+
+    std::vector<GeometryHandle> geometry;
+    geometry.reserve(meshes.size());
+    for (const COOKED::MeshRecord& mesh : meshes)
+    {
+        if (mesh.first_vertex + mesh.vertex_count > vertices.size() || mesh.first_index + mesh.index_count > indices.size())
+        {
+            reader.Fail("mesh range out of bounds");
+        }
+        auto built = std::make_shared<MeshGeometry>();
+        const auto* first_vertex = vertices.data() + mesh.first_vertex;
+        const auto* first_index = indices.data() + mesh.first_index;
+        built->vertices.assign(first_vertex, first_vertex + mesh.vertex_count);
+        built->indices.assign(first_index, first_index + mesh.index_count);
+        geometry.push_back(std::move(built));
+    }
+
+    // Chains are shared by every entity drawing the mesh, as when the scene was loaded.
+    std::vector<std::vector<MeshLod>> chains(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        const COOKED::MeshRecord& mesh = meshes[i];
+        if (static_cast<uint64_t>(mesh.first_lod) + mesh.lod_count > lods.size())
+        {
+            reader.Fail("LOD range out of bounds");
+        }
+        for (uint32_t level = 0; level < mesh.lod_count; ++level)
+        {
+            const COOKED::LodRecord& lod = lods[mesh.first_lod + level];
+            if (lod.mesh >= geometry.size())
+            {
+                reader.Fail("corrupt LOD " + std::to_string(mesh.first_lod + level));
+            }
+            chains[i].push_back(MeshLod{geometry[lod.mesh], lod.error});
+        }
+    }
+
+    std::vector<MaterialDescriptor> materials;
+    materials.reserve(material_records.size());
+    for (const COOKED::MaterialRecord& record : material_records)
+    {
+        MaterialDescriptor& material = materials.emplace_back();
+        material.shader_id = std::string(reader.Text(record.shader));
+        for (size_t t = 0; t < material.textures.size(); ++t)
+        {
+            material.textures[t] = std::string(reader.Text(record.textures[t]));
+        }
+    }
+
+    auto scene = std::make_unique<Scene>(std::string(reader.Text(reader.Header().scene_name)));
+    std::vector<Entity*> created(entities.size(), nullptr);
+    for (size_t i = 0; i < entities.size(); ++i)
+    {
+        const COOKED::EntityRecord& record = entities[i];
+        if (record.parent >= static_cast<int32_t>(i) || record.mesh >= static_cast<int32_t>(geometry.size())
+            || record.material >= static_cast<int32_t>(materials.size())
+            || record.camera >= static_cast<int32_t>(cameras.size())
+            || static_cast<uint64_t>(record.first_component) + record.component_count > component_names.size())
+        {
+            reader.Fail("corrupt entity " + std::to_string(i));
+        }
+
+        SceneEntity summary {};
+        summary.id = record.id;
+        summary.name = std::string(reader.Text(record.name));
+        summary.parent_id = record.parent >= 0 ? entities[static_cast<size_t>(record.parent)].id : -1;
+        summary.components.reserve(record.component_count);
+        for (uint32_t c = 0; c < record.component_count; ++c)
+        {
+            summary.components.push_back(
+                SceneComponentSummary{std::string(reader.Text(component_names[record.first_component + c]))});
+        }
+
+        Entity* parent = record.parent >= 0 ? created[static_cast<size_t>(record.parent)] : nullptr;
+        Entity& entity = scene->CreateRuntimeEntity(record.id, summary.name, parent);
+        created[i] = &entity;
+
+        TransformComponent& transform = entity.Transform();
+        transform.SetPosition(MATH::Vec3f{record.position[0], record.position[1], record.position[2]});
+        transform.SetQuaternion(record.rotation[0], record.rotation[1], record.rotation[2], record.rotation[3]);
+        transform.SetScale(MATH::Vec3f{record.scale[0], record.scale[1], record.scale[2]});
+
+        if (record.mesh >= 0)
+        {
+            auto& mesh = entity.AddComponent<MeshComponent>(geometry[static_cast<size_t>(record.mesh)]);
+            mesh.SetLods(chains[static_cast<size_t>(record.mesh)]);
+            mesh.SetMeshAssetId(std::string(reader.Text(record.mesh_asset)));
+            mesh.SetMaterialAssetId(std::string(reader.Text(record.material_asset)));
+            if (record.material >= 0)
+            {
+                mesh.SetMaterial(materials[static_cast<size_t>(record.material)]);
+            }
+            scene->Spatial().Refresh(entity);
+        }
+        if (record.camera >= 0)
+        {
+            const COOKED::CameraRecord& camera = cameras[static_cast<size_t>(record.camera)];
+            if (camera.projection > static_cast<uint32_t>(ProjectionType::Orthographic))
+            {
+                reader.Fail("corrupt camera " + std::to_string(record.camera));
+            }
+            ApplyCameraRecord(camera, entity.AddComponent<CameraComponent>());
+        }
+        scene->AddEntity(std::move(summary));
+    }
+    return scene;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
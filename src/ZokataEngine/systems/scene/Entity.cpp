@@ -1,5 +1,6 @@
 #include "ZokataEngine/systems/scene/Entity.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace ZKT
@@ -25,6 +26,11 @@ const std::string& Entity::Name() const
     return name_;
 }
 
+void Entity::SetName(std::string name)
+{
+    name_ = std::move(name);
+}
+
 Entity* Entity::Parent() const
 {
     return parent_;
@@ -69,6 +75,24 @@ void Entity::AddComponent(std::unique_ptr<Component> comp)
     }
 }
 
+std::unique_ptr<Component> Entity::RemoveComponent(Component& comp)
+{
+    if (&comp == transform_)
+    {
+        return nullptr;
+    }
+    const auto it = std::find_if(
+        components_.begin(), components_.end(), [&comp](const auto& owned) { return owned.get() == &comp; });
+    if (it == components_.end())
+    {
+        return nullptr;
+    }
+    std::unique_ptr<Component> removed = std::move(*it);
+    components_.erase(it);
+    removed->SetOwner(nullptr);
+    return removed;
+}
+
 Entity* Entity::AddChild(std::unique_ptr<Entity> child)
 {
     child->SetParent(this);
@@ -77,6 +101,20 @@ Entity* Entity::AddChild(std::unique_ptr<Entity> child)
     return raw_ptr;
 }
 
+std::unique_ptr<Entity> Entity::RemoveChild(Entity& child)
+{
+    const auto it = std::find_if(
+        children_.begin(), children_.end(), [&child](const auto& owned) { return owned.get() == &child; });
+    if (it == children_.end())
+    {
+        return nullptr;
+    }
+    std::unique_ptr<Entity> removed = std::move(*it);
+    children_.erase(it);
+    removed->SetParent(nullptr);
+    return removed;
+}
+
 void Entity::EnsureTransform()
 {
     if (transform_ == nullptr)
@@ -133,6 +171,17 @@ void Entity::OnEnableSelf()
     }
 }
 
+void Entity::OnDisableSelf()
+{
+    for (auto& comp : components_)
+    {
+        if (comp->Enabled())
+        {
+            comp->OnDisable();
+        }
+    }
+}
+
 void Entity::StartSelf()
 {
     StartEntity();
@@ -1,6 +1,9 @@
 #include "ZokataEngine/systems/scene/Scene.h"
 
+#include <algorithm>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace ZKT
 {
@@ -26,6 +29,11 @@ void Scene::AddEntity(SceneEntity entity)
     entities_.push_back(std::move(entity));
 }
 
+void Scene::SetEntities(std::vector<SceneEntity> entities)
+{
+    entities_ = std::move(entities);
+}
+
 const std::vector<std::unique_ptr<Entity>>& Scene::RuntimeRoots() const
 {
     return roots_;
@@ -52,11 +60,67 @@ Entity& Scene::CreateRuntimeEntity(int64_t id, const std::string& name, Entity*
     return ref;
 }
 
+void Scene::ReparentEntity(Entity& entity, Entity* parent)
+{
+    if (entity.Parent() == parent)
+    {
+        return;
+    }
+    std::unique_ptr<Entity> owned = DetachEntity(entity);
+    if (!owned)
+    {
+        return;
+    }
+    if (parent != nullptr)
+    {
+        parent->AddChild(std::move(owned));
+    }
+    else
+    {
+        roots_.push_back(std::move(owned));
+    }
+    // The local transform is now relative to another parent.
+    entity.Transform().MarkDirty();
+}
+
+void Scene::DestroyEntities(std::span<Entity* const> entities)
+{
+    std::unordered_set<Entity*> doomed;
+    for (Entity* entity : entities)
+    {
+        TraversePreorder(*entity, [&doomed](Entity& e) { doomed.insert(&e); });
+    }
+    if (doomed.empty())
+    {
+        return;
+    }
+    // Descendants of another listed entity go away with it. Roots are picked while every
+    // entity is still alive: detaching one frees its subtree, which may be listed later.
+    std::vector<Entity*> detach_roots;
+    for (Entity* entity : entities)
+    {
+        const bool root = entity->Parent() == nullptr || !doomed.contains(entity->Parent());
+        if (root && std::find(detach_roots.begin(), detach_roots.end(), entity) == detach_roots.end())
+        {
+            detach_roots.push_back(entity);
+        }
+    }
+    for (Entity* entity : doomed)
+    {
+        spatial_.Unregister(*entity);
+    }
+    std::erase_if(all_entities_, [&doomed](Entity* entity) { return doomed.contains(entity); });
+    for (Entity* entity : detach_roots)
+    {
+        DetachEntity(*entity);
+    }
+}
+
 void Scene::AddRoot(std::unique_ptr<Entity> entity)
 {
     if (entity)
     {
-        RegisterEntity(*entity);
+        TraversePreorder(*entity, [this](Entity& e) { RegisterEntity(e); });
         roots_.push_back(std::move(entity));
     }
 }
@@ -68,12 +132,14 @@ void Scene::OnEnable()
 
 void Scene::Start()
 {
+    UpdateTransforms();
     ForEachEntityPreorder([](Entity& entity) { entity.StartSelf(); });
 }
 
 void Scene::Update(float delta_seconds)
 {
     ForEachEntityPreorder([delta_seconds](Entity& entity) { entity.UpdateSelf(delta_seconds); });
+    UpdateTransforms();
 }
 
 void Scene::FixedUpdate(float fixed_seconds)
@@ -81,9 +147,64 @@ void Scene::FixedUpdate(float fixed_seconds)
     ForEachEntityPreorder([fixed_seconds](Entity& entity) { entity.FixedUpdateSelf(fixed_seconds); });
 }
 
+void Scene::UpdateTransforms()
+{
+    changed_transforms_.clear();
+    for (auto& root : roots_)
+    {
+        PropagateTransform(*root, nullptr, false);
+    }
+    if (!changed_transforms_.empty())
+    {
+        spatial_.OnTransformsChanged(changed_transforms_);
+    }
+}
+
+SceneSpatialIndex& Scene::Spatial()
+{
+    return spatial_;
+}
+
+const SceneSpatialIndex& Scene::Spatial() const
+{
+    return spatial_;
+}
+
+std::unique_ptr<Entity> Scene::DetachEntity(Entity& entity)
+{
+    if (Entity* parent = entity.Parent())
+    {
+        return parent->RemoveChild(entity);
+    }
+    const auto it = std::find_if(roots_.begin(), roots_.end(), [&entity](const auto& root) { return root.get() == &entity; });
+    if (it == roots_.end())
+    {
+        return nullptr;
+    }
+    std::unique_ptr<Entity> detached = std::move(*it);
+    roots_.erase(it);
+    return detached;
+}
+
 void Scene::RegisterEntity(Entity& entity)
 {
     all_entities_.push_back(&entity);
+    spatial_.Register(entity);
+}
+
+void Scene::PropagateTransform(Entity& entity, const TransformComponent* parent, bool parent_changed)
+{
+    TransformComponent& transform = entity.Transform();
+    const bool changed = parent_changed || transform.IsDirty();
+    if (changed)
+    {
+        transform.UpdateWorld(parent);
+        changed_transforms_.push_back(&entity);
+    }
+    for (auto& child : entity.Children())
+    {
+        PropagateTransform(*child, &transform, changed);
+    }
 }
 
 void Scene::ForEachEntityPreorder(const std::function<void(Entity&)>& fn)
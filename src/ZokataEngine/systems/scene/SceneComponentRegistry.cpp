@@ -0,0 +1,259 @@
+#include "ZokataEngine/systems/scene/SceneComponentRegistry.h"
+
+#include <utility>
+
+#include "ZokataEngine/systems/asset/YamlReader.h"
+#include "ZokataEngine/systems/scene/Entity.h"
+#include "ZokataEngine/systems/scene/components/CameraComponent.h"
+#include "ZokataEngine/systems/scene/components/MeshComponent.h"
+#include "ZokataEngine/systems/scene/components/TransformComponent.h"
+#include "ZokataMath/Vector.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+MATH::Vec3f ReadVec3(const SceneFields& fields, const MATH::Vec3f& fallback)
+{
+    if (!fields.IsMap())
+    {
+        return fallback;
+    }
+    return MATH::Vec3f{
+        fields["x"].AsFloat(fallback.x),
+        fields["y"].AsFloat(fallback.y),
+        fields["z"].AsFloat(fallback.z),
+    };
+}
+
+void DeserializeTransform(Entity& entity, const SceneFields& fields, SceneLoadContext& /*context*/)
+{
+    TransformComponent& transform = entity.Transform();
+    transform.SetPosition(ReadVec3(fields["position"], {0.0F, 0.0F, 0.0F}));
+    transform.SetEulerDegrees(ReadVec3(fields["rotation"], {0.0F, 0.0F, 0.0F}));
+    transform.SetScale(ReadVec3(fields["scale"], {1.0F, 1.0F, 1.0F}));
+}
+
+void ApplyTransform(Entity& live, Entity* fresh, bool /*running*/)
+{
+    TransformComponent& transform = live.Transform();
+    if (fresh == nullptr)
+    {
+        transform.SetPosition(MATH::Vec3f{0.0F, 0.0F, 0.0F});
+        transform.SetQuaternion(1.0F, 0.0F, 0.0F, 0.0F);
+        transform.SetScale(MATH::Vec3f{1.0F, 1.0F, 1.0F});
+        return;
+    }
+    const TransformComponent& source = fresh->Transform();
+    const glm::quat& rotation = source.GetQuaternion().ToGlm();
+    transform.SetPosition(source.GetPosition());
+    transform.SetQuaternion(rotation.w, rotation.x, rotation.y, rotation.z);
+    transform.SetScale(source.GetScale());
+}
+
+void DeserializeCamera(Entity& entity, const SceneFields& fields, SceneLoadContext& /*context*/)
+{
+    CameraComponent* camera = entity.GetComponent<CameraComponent>();
+    if (camera == nullptr)
+    {
+        camera = &entity.AddComponent<CameraComponent>();
+    }
+
+    const std::string_view projection = fields["projection"].Scalar();
+    if (projection == "Orthographic")
+    {
+        camera->SetProjection(ProjectionType::Orthographic);
+    }
+    else if (projection == "Perspective")
+    {
+        camera->SetProjection(ProjectionType::Perspective);
+    }
+    camera->SetVerticalFovDegrees(fields["vertical_fov_degrees"].AsFloat(camera->VerticalFovDegrees()));
+    camera->SetAspectRatio(fields["aspect_ratio"].AsFloat(camera->AspectRatio()));
+    camera->SetNearPlane(fields["near"].AsFloat(camera->NearPlane()));
+    camera->SetFarPlane(fields["far"].AsFloat(camera->FarPlane()));
+    camera->SetOrthoHeight(fields["ortho_height"].AsFloat(camera->OrthoHeight()));
+    camera->SetExposure(fields["exposure"].AsFloat(camera->Exposure()));
+    if (const SceneFields color = fields["clear_color_rgba"]; color.IsMap())
+    {
+        const MATH::Vec4f& current = camera->ClearColor();
+        camera->SetClearColor(MATH::Vec4f{
+            color["r"].AsFloat(current.x),
+            color["g"].AsFloat(current.y),
+            color["b"].AsFloat(current.z),
+            color["a"].AsFloat(current.w),
+        });
+    }
+}
+
+void DeserializeMeshRenderer(Entity& entity, const SceneFields& fields, SceneLoadContext& context)
+{
+    context.meshes.push_back(SceneMeshRequest{&entity, fields["mesh"].AsString(), fields["material"].AsString()});
+}
+
+// Swaps live's component for the one fresh loaded, which already holds the new settings (and,
+// for meshes, the new geometry or a handle that is loading it).
+template <typename T>
+void ApplyByReplacing(Entity& live, Entity* fresh, bool running)
+{
+    if (T* old = live.GetComponent<T>())
+    {
+        if (running && old->Enabled())
+        {
+            old->OnDisable();
+        }
+        live.RemoveComponent(*old);
+    }
+    T* replacement = fresh != nullptr ? fresh->GetComponent<T>() : nullptr;
+    if (replacement == nullptr)
+    {
+        return;
+    }
+    live.AddComponent(fresh->RemoveComponent(*replacement));
+    if (running && replacement->Enabled())
+    {
+        replacement->OnEnable();
+        replacement->Start();
+    }
+}
+}  // namespace
+
+SceneFields::SceneFields(const SceneFieldNode* nodes, const char* strings, uint32_t index)
+    : nodes_(nodes)
+    , strings_(strings)
+    , index_(index)
+{
+}
+
+SceneFields::operator bool() const
+{
+    return nodes_ != nullptr;
+}
+
+bool SceneFields::IsScalar() const
+{
+    return nodes_ != nullptr && nodes_[index_].kind == SceneFieldNode::Kind::Scalar;
+}
+
+bool SceneFields::IsMap() const
+{
+    return nodes_ != nullptr && nodes_[index_].kind == SceneFieldNode::Kind::Map;
+}
+
+bool SceneFields::IsSequence() const
+{
+    return nodes_ != nullptr && nodes_[index_].kind == SceneFieldNode::Kind::Sequence;
+}
+
+SceneFields SceneFields::operator[](std::string_view key) const
+{
+    if (!IsMap())
+    {
+        return {};
+    }
+    for (uint32_t child = index_ + 1; child < nodes_[index_].end; child = nodes_[child].end)
+    {
+        const SceneFieldNode& node = nodes_[child];
+        if (std::string_view(strings_ + node.key_offset, node.key_size) == key)
+        {
+            return SceneFields(nodes_, strings_, child);
+        }
+    }
+    return {};
+}
+
+size_t SceneFields::Size() const
+{
+    if (IsScalar() || nodes_ == nullptr)
+    {
+        return 0;
+    }
+    size_t count = 0;
+    for (uint32_t child = index_ + 1; child < nodes_[index_].end; child = nodes_[child].end)
+    {
+        ++count;
+    }
+    return count;
+}
+
+void SceneFields::ForEach(const std::function<void(std::string_view, const SceneFields&)>& fn) const
+{
+    if (IsScalar() || nodes_ == nullptr)
+    {
+        return;
+    }
+    for (uint32_t child = index_ + 1; child < nodes_[index_].end; child = nodes_[child].end)
+    {
+        const SceneFieldNode& node = nodes_[child];
+        fn(std::string_view(strings_ + node.key_offset, node.key_size), SceneFields(nodes_, strings_, child));
+    }
+}
+
+std::string_view SceneFields::Scalar() const
+{
+    if (!IsScalar())
+    {
+        return {};
+    }
+    const SceneFieldNode& node = nodes_[index_];
+    return std::string_view(strings_ + node.value_offset, node.value_size);
+}
+
+float SceneFields::AsFloat(float fallback) const
+{
+    float value = fallback;
+    ParseYamlFloat(Scalar(), value);
+    return value;
+}
+
+int64_t SceneFields::AsInt(int64_t fallback) const
+{
+    int64_t value = fallback;
+    ParseYamlInt(Scalar(), value);
+    return value;
+}
+
+std::string SceneFields::AsString(std::string_view fallback) const
+{
+    return std::string(IsScalar() ? Scalar() : fallback);
+}
+
+SceneComponentRegistry& SceneComponentRegistry::Default()
+{
+    static SceneComponentRegistry registry = [] {
+        SceneComponentRegistry defaults;
+        defaults.Register({"Transform", DeserializeTransform, ApplyTransform});
+        defaults.Register({"Camera", DeserializeCamera, ApplyByReplacing<CameraComponent>});
+        defaults.Register({"MeshRenderer", DeserializeMeshRenderer, ApplyByReplacing<MeshComponent>});
+        return defaults;
+    }();
+    return registry;
+}
+
+uint32_t SceneComponentRegistry::Register(SceneComponentType type)
+{
+    if (const auto it = ids_.find(type.name); it != ids_.end())
+    {
+        types_[it->second] = std::move(type);
+        return it->second;
+    }
+    const auto id = static_cast<uint32_t>(types_.size());
+    ids_.emplace(type.name, id);
+    types_.push_back(std::move(type));
+    return id;
+}
+
+uint32_t SceneComponentRegistry::Find(std::string_view name) const
+{
+    const auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : kUnknown;
+}
+
+const SceneComponentType& SceneComponentRegistry::Type(uint32_t id) const
+{
+    return types_[id];
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,176 @@
+#include "ZokataEngine/systems/scene/SceneDiff.h"
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ZokataEngine/systems/scene/SceneComponentRegistry.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+const SceneComponentSummary* FindComponent(const SceneEntity& entity, std::string_view name)
+{
+    for (const SceneComponentSummary& component : entity.components)
+    {
+        if (component.name == name)
+        {
+            return &component;
+        }
+    }
+    return nullptr;
+}
+
+bool IndexById(const std::vector<SceneEntity>& entities, std::unordered_map<int64_t, const SceneEntity*>& index)
+{
+    index.reserve(entities.size());
+    for (const SceneEntity& entity : entities)
+    {
+        if (entity.id < 0 || !index.emplace(entity.id, &entity).second)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+std::optional<SceneDiffStats> ApplySceneDiff(Scene& live, Scene& fresh, const SceneDiffOptions& options)
+{
+    std::unordered_map<int64_t, const SceneEntity*> previous;
+    std::unordered_map<int64_t, const SceneEntity*> next;
+    if (!IndexById(live.Entities(), previous) || !IndexById(fresh.Entities(), next))
+    {
+        return std::nullopt;
+    }
+
+    // Only entities the file created take part; ones spawned at runtime are left alone.
+    std::unordered_map<int64_t, Entity*> live_entities;
+    live_entities.reserve(previous.size());
+    for (Entity* entity : live.AllRuntimeEntities())
+    {
+        if (previous.contains(entity->Id()))
+        {
+            live_entities.emplace(entity->Id(), entity);
+        }
+    }
+    std::unordered_map<int64_t, Entity*> fresh_entities;
+    fresh_entities.reserve(next.size());
+    for (Entity* entity : fresh.AllRuntimeEntities())
+    {
+        fresh_entities.emplace(entity->Id(), entity);
+    }
+
+    SceneDiffStats stats {};
+    const SceneComponentRegistry& registry = SceneComponentRegistry::Default();
+    const auto apply = [&stats, &registry](std::string_view component, Entity& target, Entity* source, bool running) {
+        const uint32_t type = registry.Find(component);
+        if (type != SceneComponentRegistry::kUnknown && registry.Type(type).apply)
+        {
+            registry.Type(type).apply(target, source, running);
+            ++stats.components;
+        }
+    };
+
+    // Parsed views are in preorder, so a parent is in place before its children.
+    for (const SceneEntity& entity : fresh.Entities())
+    {
+        const auto source_it = fresh_entities.find(entity.id);
+        if (source_it == fresh_entities.end())
+        {
+            continue;
+        }
+        Entity* source = source_it->second;
+        Entity* parent = nullptr;
+        if (const auto parent_it = live_entities.find(entity.parent_id); parent_it != live_entities.end())
+        {
+            parent = parent_it->second;
+        }
+
+        const auto before = previous.find(entity.id);
+        const auto target_it = live_entities.find(entity.id);
+        if (before == previous.end() || target_it == live_entities.end())
+        {
+            Entity& created = live.CreateRuntimeEntity(entity.id, entity.name, parent);
+            live_entities[entity.id] = &created;
+            for (const SceneComponentSummary& component : entity.components)
+            {
+                apply(component.name, created, source, false);
+            }
+            live.Spatial().Refresh(created);
+            if (options.running)
+            {
+                created.OnEnableSelf();
+                created.StartSelf();
+            }
+            ++stats.added;
+            continue;
+        }
+
+        Entity& target = *target_it->second;
+        const SceneEntity& old = *before->second;
+        bool changed = false;
+        if (old.name != entity.name)
+        {
+            target.SetName(entity.name);
+            changed = true;
+        }
+        if (old.parent_id != entity.parent_id)
+        {
+            live.ReparentEntity(target, parent);
+            changed = true;
+        }
+        for (const SceneComponentSummary& component : entity.components)
+        {
+            const SceneComponentSummary* was = FindComponent(old, component.name);
+            // A zero hash (cooked scenes) cannot prove the component unchanged.
+            if (options.reapply_components || was == nullptr || was->source_hash == 0
+                || was->source_hash != component.source_hash)
+            {
+                apply(component.name, target, source, options.running);
+                changed = true;
+            }
+        }
+        for (const SceneComponentSummary& component : old.components)
+        {
+            if (FindComponent(entity, component.name) == nullptr)
+            {
+                apply(component.name, target, nullptr, options.running);
+                changed = true;
+            }
+        }
+        if (changed)
+        {
+            live.Spatial().Refresh(target);
+            ++stats.changed;
+        }
+    }
+
+    std::vector<Entity*> removed;
+    for (const SceneEntity& entity : live.Entities())
+    {
+        if (next.contains(entity.id))
+        {
+            continue;
+        }
+        if (const auto it = live_entities.find(entity.id); it != live_entities.end())
+        {
+            removed.push_back(it->second);
+            if (options.running)
+            {
+                it->second->OnDisableSelf();
+            }
+        }
+    }
+    live.DestroyEntities(removed);
+    stats.removed = static_cast<uint32_t>(removed.size());
+
+    live.SetEntities(fresh.Entities());
+    return stats;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -1,11 +1,29 @@
 #include "ZokataEngine/systems/scene/SceneLoader.h"
 
-#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iterator>
+#include <map>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
 
-#include "ZokataEngine/systems/scene/components/TransformComponent.h"
-#include "ZokataMath/Vector.h"
+#include "ZokataEngine/systems/asset/AssetManager.h"
+#include "ZokataEngine/systems/asset/AssetReference.h"
+#include "ZokataEngine/systems/asset/ContentHash.h"
+#include "ZokataEngine/systems/asset/GltfImporter.h"
+#include "ZokataEngine/systems/asset/MappedFile.h"
+#include "ZokataEngine/systems/asset/YamlReader.h"
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/mesh/MeshAsset.h"
+#include "ZokataEngine/systems/mesh/MeshSimplifier.h"
+#include "ZokataEngine/systems/scene/components/MeshComponent.h"
+#include "ZokataEngine/systems/texture/TextureAsset.h"
+#include "ZokataLog/Log.h"
 
 namespace ZKT
 {
@@ -13,109 +31,843 @@ namespace ENGINE
 {
 namespace
 {
-float SafeFloat(const YAML::Node& node, float fallback = 0.0F)
+// A batch is closed at the first root boundary after this many entities.
+constexpr size_t kBatchEntities = 512;
+
+using AssetTable = std::unordered_map<std::string, std::string>;
+
+/**
+ * Consecutive root subtrees, parsed but not built. Self-contained so that batches can be built
+ * on different threads; strings are offsets into one pool per batch.
+ */
+struct ParsedBatch
+{
+    struct EntityRecord
+    {
+        int64_t id = -1;
+        int32_t parent = -1;  // index into entities; -1 for a root
+        bool named = false;
+        uint32_t name_offset = 0;
+        uint32_t name_size = 0;
+    };
+    struct ComponentRecord
+    {
+        uint32_t entity = 0;
+        uint32_t type = SceneComponentRegistry::kUnknown;
+        uint32_t name_offset = 0;  // only stored for unknown types
+        uint32_t name_size = 0;
+        uint32_t field = 0;        // root node of the component's fields
+    };
+
+    std::vector<EntityRecord> entities;  // preorder
+    std::vector<ComponentRecord> components;
+    std::vector<SceneFieldNode> fields;
+    std::string strings;
+    uint32_t roots = 0;
+
+    uint32_t AddString(std::string_view text)
+    {
+        const auto offset = static_cast<uint32_t>(strings.size());
+        strings.append(text);
+        return offset;
+    }
+
+    std::string_view String(uint32_t offset, uint32_t size) const
+    {
+        return std::string_view(strings).substr(offset, size);
+    }
+};
+
+struct BuiltBatch
+{
+    std::vector<std::unique_ptr<Entity>> roots;
+    std::vector<SceneEntity> entities;  // parallel to ParsedBatch::entities
+    SceneLoadContext context;
+    std::exception_ptr error;
+};
+
+enum class Key : uint8_t
 {
-    return node ? node.as<float>(fallback) : fallback;
+    Other,
+    Version,
+    Scene,
+    Name,
+    Assets,
+    Meshes,
+    Materials,
+    Entities,
+    Id,
+    Components,
+    Children
+};
+
+Key ClassifyKey(std::string_view key)
+{
+    static const std::unordered_map<std::string_view, Key> keys {
+        {"version", Key::Version},   {"scene", Key::Scene},       {"name", Key::Name},
+        {"assets", Key::Assets},     {"meshes", Key::Meshes},     {"materials", Key::Materials},
+        {"entities", Key::Entities}, {"id", Key::Id},             {"components", Key::Components},
+        {"children", Key::Children},
+    };
+    const auto it = keys.find(key);
+    return it != keys.end() ? it->second : Key::Other;
 }
 
-std::string SafeString(const YAML::Node& node, const std::string& fallback = {})
+// Fields of an inline material; unknown keys are ignored like the rest of the schema.
+void SetMaterialField(MaterialDescriptor& material, std::string_view key, std::string_view value)
 {
-    return node ? node.as<std::string>(fallback) : fallback;
+    static const std::unordered_map<std::string_view, TextureSlot> slots {
+        {"albedo", TextureSlot::Albedo},
+        {"normal", TextureSlot::Normal},
+        {"metallic_roughness", TextureSlot::MetallicRoughness},
+        {"occlusion", TextureSlot::Occlusion},
+        {"emissive", TextureSlot::Emissive},
+    };
+    if (key == "shader")
+    {
+        material.shader_id.assign(value);
+        return;
+    }
+    const auto it = slots.find(key);
+    if (it != slots.end())
+    {
+        material.textures[static_cast<size_t>(it->second)].assign(value);
+    }
 }
 
-MATH::Vec3f ReadVec3(const YAML::Node& node, const MATH::Vec3f& fallback)
+/**
+ * Turns YAML events into batch records. Tracks where it is in the scene schema with a frame per
+ * open collection; anything outside the schema is skipped without being stored.
+ */
+class SceneParser final : public YamlHandler
 {
-    if (!(node && node.IsMap()))
+public:
+    explicit SceneParser(const SceneComponentRegistry& registry)
+        : registry_(registry)
+    {
+    }
+
+    int64_t version = 1;
+    bool has_scene = false;
+    std::string name;  // empty when the file names no scene
+    AssetTable mesh_table;
+    AssetTable material_table;
+    std::unordered_map<std::string, MaterialDescriptor> material_definitions;
+
+    void OnScalar(std::string_view value) override
+    {
+        if (frames_.empty() || frames_.back().context == Context::Skip)
+        {
+            return;
+        }
+        Frame& frame = frames_.back();
+        if (frame.is_map && frame.expect_key)
+        {
+            OnKey(frame, value);
+            return;
+        }
+        frame.expect_key = true;
+
+        switch (frame.context)
+        {
+        case Context::Root:
+            if (frame.key == Key::Version)
+            {
+                ParseYamlInt(value, version);
+            }
+            break;
+        case Context::Scene:
+            if (frame.key == Key::Name)
+            {
+                name.assign(value);
+            }
+            break;
+        case Context::AssetMap:
+            (frame.index == 0 ? mesh_table : material_table).insert_or_assign(asset_key_, std::string(value));
+            break;
+        case Context::Material:
+            SetMaterialField(material_definitions[asset_key_], material_field_, value);
+            break;
+        case Context::Entity:
+        {
+            ParsedBatch::EntityRecord& entity = batch_.entities[frame.index];
+            if (frame.key == Key::Id)
+            {
+                ParseYamlInt(value, entity.id);
+            }
+            else if (frame.key == Key::Name && !value.empty())
+            {
+                entity.named = true;
+                entity.name_offset = batch_.AddString(value);
+                entity.name_size = static_cast<uint32_t>(value.size());
+            }
+            break;
+        }
+        case Context::Components:
+            AddComponent(frame, SceneFieldNode::Kind::Scalar, value);
+            break;
+        case Context::Field:
+            AddField(frame, SceneFieldNode::Kind::Scalar, value);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void OnMapStart() override
     {
-        return fallback;
+        Open(true);
     }
-    return MATH::Vec3f{
-        SafeFloat(node["x"], fallback.x),
-        SafeFloat(node["y"], fallback.y),
-        SafeFloat(node["z"], fallback.z),
+
+    void OnMapEnd() override
+    {
+        Close();
+    }
+
+    void OnSequenceStart() override
+    {
+        Open(false);
+    }
+
+    void OnSequenceEnd() override
+    {
+        Close();
+    }
+
+    /**
+     * Hands over every batch, including the one still open; call once the reader finished.
+     */
+    std::vector<ParsedBatch> TakeBatches()
+    {
+        if (!batch_.entities.empty())
+        {
+            FlushBatch();
+        }
+        return std::move(batches_);
+    }
+
+private:
+    enum class Context : uint8_t
+    {
+        Root,
+        Scene,
+        Assets,
+        AssetMap,
+        Material,    // an inline material in scene.assets.materials
+        Entities,    // scene.entities: items are roots
+        Children,    // an entity's children
+        Entity,
+        Components,
+        Field,       // inside a component's value
+        Skip
     };
+
+    struct Frame
+    {
+        Context context = Context::Skip;
+        bool is_map = false;
+        bool expect_key = true;
+        Key key = Key::Other;
+        uint32_t index = 0;  // entity record, field node, or 0/1 for the mesh/material table
+        uint32_t type = SceneComponentRegistry::kUnknown;  // Components: type of the pending key
+        uint32_t key_offset = 0;  // Components and Field: pending key in the batch's pool
+        uint32_t key_size = 0;
+    };
+
+    const SceneComponentRegistry& registry_;
+    std::vector<Frame> frames_;
+    std::string asset_key_;
+    std::string material_field_;
+    ParsedBatch batch_;
+    std::vector<ParsedBatch> batches_;
+
+    void OnKey(Frame& frame, std::string_view key)
+    {
+        frame.expect_key = false;
+        switch (frame.context)
+        {
+        case Context::Components:
+            // Interned once here; only unknown names are kept as text.
+            frame.type = registry_.Find(key);
+            if (frame.type == SceneComponentRegistry::kUnknown)
+            {
+                frame.key_offset = batch_.AddString(key);
+                frame.key_size = static_cast<uint32_t>(key.size());
+            }
+            break;
+        case Context::Field:
+            frame.key_offset = batch_.AddString(key);
+            frame.key_size = static_cast<uint32_t>(key.size());
+            break;
+        case Context::AssetMap:
+            asset_key_.assign(key);
+            break;
+        case Context::Material:
+            material_field_.assign(key);
+            break;
+        default:
+            frame.key = ClassifyKey(key);
+            break;
+        }
+    }
+
+    void Open(bool is_map)
+    {
+        Frame child {};
+        child.is_map = is_map;
+        if (frames_.empty())
+        {
+            child.context = is_map ? Context::Root : Context::Skip;
+            frames_.push_back(child);
+            return;
+        }
+
+        Frame& parent = frames_.back();
+        const bool is_key = parent.is_map && parent.expect_key;
+        parent.expect_key = true;
+        const auto kind = is_map ? SceneFieldNode::Kind::Map : SceneFieldNode::Kind::Sequence;
+        switch (is_key ? Context::Skip : parent.context)
+        {
+        case Context::Root:
+            if (is_map && parent.key == Key::Scene)
+            {
+                child.context = Context::Scene;
+                has_scene = true;
+            }
+            break;
+        case Context::Scene:
+            if (is_map && parent.key == Key::Assets)
+            {
+                child.context = Context::Assets;
+            }
+            else if (!is_map && parent.key == Key::Entities)
+            {
+                child.context = Context::Entities;
+            }
+            break;
+        case Context::Assets:
+            if (is_map && (parent.key == Key::Meshes || parent.key == Key::Materials))
+            {
+                child.context = Context::AssetMap;
+                child.index = parent.key == Key::Meshes ? 0 : 1;
+            }
+            break;
+        case Context::AssetMap:
+            if (is_map && parent.index == 1)
+            {
+                child.context = Context::Material;
+                material_definitions.try_emplace(asset_key_);
+            }
+            break;
+        case Context::Entities:
+        case Context::Children:
+            if (is_map)
+            {
+                child.context = Context::Entity;
+                child.index = BeginEntity(parent.context == Context::Children ? static_cast<int32_t>(parent.index) : -1);
+            }
+            break;
+        case Context::Entity:
+            if (is_map && parent.key == Key::Components)
+            {
+                child.context = Context::Components;
+                child.index = parent.index;
+            }
+            else if (!is_map && parent.key == Key::Children)
+            {
+                child.context = Context::Children;
+                child.index = parent.index;
+            }
+            break;
+        case Context::Components:
+            child.context = Context::Field;
+            child.index = AddComponent(parent, kind, {});
+            break;
+        case Context::Field:
+            child.context = Context::Field;
+            child.index = AddField(parent, kind, {});
+            break;
+        default:
+            break;
+        }
+        frames_.push_back(child);
+    }
+
+    void Close()
+    {
+        if (frames_.empty())
+        {
+            return;
+        }
+        const Frame frame = frames_.back();
+        frames_.pop_back();
+        if (frame.context == Context::Field)
+        {
+            batch_.fields[frame.index].end = static_cast<uint32_t>(batch_.fields.size());
+        }
+    }
+
+    uint32_t BeginEntity(int32_t parent)
+    {
+        if (parent < 0)
+        {
+            // Only between roots, so no open frame refers into the batch being closed.
+            if (batch_.entities.size() >= kBatchEntities)
+            {
+                FlushBatch();
+            }
+            ++batch_.roots;
+        }
+        const auto index = static_cast<uint32_t>(batch_.entities.size());
+        ParsedBatch::EntityRecord& entity = batch_.entities.emplace_back();
+        entity.parent = parent;
+        return index;
+    }
+
+    uint32_t AddComponent(const Frame& components, SceneFieldNode::Kind kind, std::string_view value)
+    {
+        ParsedBatch::ComponentRecord& component = batch_.components.emplace_back();
+        component.entity = components.index;
+        component.type = components.type;
+        component.name_offset = components.key_offset;
+        component.name_size = components.key_size;
+        component.field = static_cast<uint32_t>(batch_.fields.size());
+        return PushField(kind, 0, 0, value);
+    }
+
+    uint32_t AddField(const Frame& parent, SceneFieldNode::Kind kind, std::string_view value)
+    {
+        return parent.is_map ? PushField(kind, parent.key_offset, parent.key_size, value) : PushField(kind, 0, 0, value);
+    }
+
+    uint32_t PushField(SceneFieldNode::Kind kind, uint32_t key_offset, uint32_t key_size, std::string_view value)
+    {
+        const auto index = static_cast<uint32_t>(batch_.fields.size());
+        SceneFieldNode& node = batch_.fields.emplace_back();
+        node.kind = kind;
+        node.key_offset = key_offset;
+        node.key_size = key_size;
+        node.value_offset = batch_.AddString(value);
+        node.value_size = static_cast<uint32_t>(value.size());
+        node.end = index + 1;  // collections are closed in Close()
+        return index;
+    }
+
+    void FlushBatch()
+    {
+        batches_.push_back(std::move(batch_));
+        batch_ = ParsedBatch {};
+    }
+};
+
+// Structural hash of a component's fields: formatting and comments do not change it.
+uint64_t HashFields(const ParsedBatch& batch, uint32_t root)
+{
+    ContentHasher hasher;
+    for (uint32_t i = root; i < batch.fields[root].end; ++i)
+    {
+        const SceneFieldNode& node = batch.fields[i];
+        hasher.Add(static_cast<uint64_t>(node.kind))
+            .Add(static_cast<uint64_t>(node.end - i))
+            .Add(batch.String(node.key_offset, node.key_size))
+            .Add(batch.String(node.value_offset, node.value_size));
+    }
+    const uint64_t hash = hasher.Finish();
+    return hash != 0 ? hash : 1;  // 0 means "unknown" in SceneComponentSummary
+}
+
+void BuildBatch(const ParsedBatch& parsed, const SceneComponentRegistry& registry, BuiltBatch& built)
+{
+    std::vector<Entity*> runtime(parsed.entities.size(), nullptr);
+    built.entities.resize(parsed.entities.size());
+    built.roots.reserve(parsed.roots);
+    for (size_t i = 0; i < parsed.entities.size(); ++i)
+    {
+        const ParsedBatch::EntityRecord& record = parsed.entities[i];
+        std::string name = record.named ? std::string(parsed.String(record.name_offset, record.name_size)) : "Entity";
+        auto entity = std::make_unique<Entity>(record.id, name);
+        runtime[i] = entity.get();
+
+        SceneEntity& summary = built.entities[i];
+        summary.id = record.id;
+        summary.parent_id = record.parent >= 0 ? parsed.entities[record.parent].id : -1;
+        summary.name = std::move(name);
+
+        if (record.parent >= 0)
+        {
+            runtime[record.parent]->AddChild(std::move(entity));
+        }
+        else
+        {
+            built.roots.push_back(std::move(entity));
+        }
+    }
+
+    for (const ParsedBatch::ComponentRecord& component : parsed.components)
+    {
+        const bool known = component.type != SceneComponentRegistry::kUnknown;
+        const SceneComponentType* type = known ? &registry.Type(component.type) : nullptr;
+
+        SceneComponentSummary summary {};
+        summary.name = known ? type->name : std::string(parsed.String(component.name_offset, component.name_size));
+        summary.source_hash = HashFields(parsed, component.field);
+        built.entities[component.entity].components.push_back(std::move(summary));
+
+        if (known && type->deserialize)
+        {
+            const SceneFields fields(parsed.fields.data(), parsed.strings.data(), component.field);
+            type->deserialize(*runtime[component.entity], fields, built.context);
+        }
+    }
+}
+
+float Milliseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+// Asset paths in scene files are relative to the project root, which is some ancestor of the
+// scene's directory, so probe upwards from there.
+std::filesystem::path ResolveAssetPath(const std::filesystem::path& scene_path, const std::filesystem::path& asset)
+{
+    std::error_code ec;
+    if (asset.is_absolute())
+    {
+        return std::filesystem::exists(asset, ec) ? asset : std::filesystem::path {};
+    }
+    for (std::filesystem::path dir = scene_path.parent_path(); !dir.empty(); dir = dir.parent_path())
+    {
+        const std::filesystem::path candidate = dir / asset;
+        if (std::filesystem::exists(candidate, ec))
+        {
+            return candidate;
+        }
+        if (dir == dir.parent_path())
+        {
+            break;
+        }
+    }
+    return {};
+}
+
+// Looks name up in an assets table, treating unknown names as direct references.
+std::string LookupAsset(const AssetTable& table, const std::string& name)
+{
+    const auto it = table.find(name);
+    return it != table.end() ? it->second : name;
 }
 }  // namespace
 
 std::unique_ptr<Scene> SceneLoader::LoadFromFile(const std::filesystem::path& path)
 {
-    YAML::Node root = YAML::LoadFile(path.string());
+    using Clock = std::chrono::steady_clock;
+    stats_ = {};
+    mesh_reports_.clear();
+    auto phase_start = Clock::now();
 
-    const auto version = root["version"].as<int>(1);
-    if (version != 1)
+    const MappedFile file(path);
+    const std::string_view text(reinterpret_cast<const char*>(file.Bytes().data()), file.Size());
+    const SceneComponentRegistry& registry = SceneComponentRegistry::Default();
+    auto parser = std::make_unique<SceneParser>(registry);
+    stats_.streamed = ReadYaml(text, *parser);
+    if (!stats_.streamed)
     {
-        throw std::runtime_error("Unsupported scene version: " + std::to_string(version));
+        // Anchors, tags, block scalars and the like; yaml-cpp also reports malformed files.
+        parser = std::make_unique<SceneParser>(registry);
+        ReadYamlWithYamlCpp(text, *parser);
     }
 
-    const YAML::Node scene_node = root["scene"];
-    if (!scene_node)
+    if (parser->version != 1)
+    {
+        throw std::runtime_error("Unsupported scene version: " + std::to_string(parser->version));
+    }
+    if (!parser->has_scene)
     {
         throw std::runtime_error("Missing 'scene' node");
     }
+    std::vector<ParsedBatch> batches = parser->TakeBatches();
+    stats_.parse_ms = Milliseconds(Clock::now() - phase_start);
+    phase_start = Clock::now();
 
-    const std::string scene_name = SafeString(scene_node["name"], path.stem().string());
-    auto scene = std::make_unique<Scene>(scene_name);
+    auto scene = std::make_unique<Scene>(parser->name.empty() ? path.stem().string() : parser->name);
+    pending_meshes_.clear();
+    dependencies_.assign(1, path);
 
-    ParseEntities(scene_node["entities"], *scene);
+    std::vector<BuiltBatch> built(batches.size());
+    JobSystem::Default().ParallelFor(batches.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            try
+            {
+                BuildBatch(batches[i], registry, built[i]);
+            }
+            catch (...)
+            {
+                built[i].error = std::current_exception();
+            }
+            batches[i] = ParsedBatch {};
+        }
+    });
+    stats_.build_ms = Milliseconds(Clock::now() - phase_start);
+    phase_start = Clock::now();
 
-    // TODO: Parse assets (meshes, materials, etc.) and register them in the asset system.
-    // TODO: Push parsed scene to renderer/engine state.
+    // In file order, so the parsed view and registration match the preorder of the hierarchy.
+    for (BuiltBatch& batch : built)
+    {
+        if (batch.error)
+        {
+            std::rethrow_exception(batch.error);
+        }
+        stats_.roots += static_cast<uint32_t>(batch.roots.size());
+        stats_.entities += static_cast<uint32_t>(batch.entities.size());
+        for (std::unique_ptr<Entity>& root : batch.roots)
+        {
+            scene->AddRoot(std::move(root));
+        }
+        for (SceneEntity& entity : batch.entities)
+        {
+            scene->AddEntity(std::move(entity));
+        }
+        pending_meshes_.insert(pending_meshes_.end(), std::make_move_iterator(batch.context.meshes.begin()),
+                               std::make_move_iterator(batch.context.meshes.end()));
+    }
+    stats_.batches = static_cast<uint32_t>(built.size());
+    built.clear();
+    stats_.attach_ms = Milliseconds(Clock::now() - phase_start);
+
+    AssetTables tables {};
+    tables.meshes = std::move(parser->mesh_table);
+    tables.materials = std::move(parser->material_table);
+    for (auto& [name, material] : parser->material_definitions)
+    {
+        tables.definitions[name].descriptor = std::move(material);
+    }
+    ResolveMaterials(tables, path);
+    LoadMeshes(tables, path, *scene);
 
     return scene;
 }
 
-void SceneLoader::ParseEntities(const YAML::Node& entities_node, Scene& scene, Entity* parent)
+SceneLoader::SceneLoader(AssetManager* assets)
+    : assets_(assets)
+{
+}
+
+const std::vector<std::filesystem::path>& SceneLoader::Dependencies() const
+{
+    return dependencies_;
+}
+
+const SceneLoaderStats& SceneLoader::Stats() const
+{
+    return stats_;
+}
+
+const std::vector<SceneMeshReport>& SceneLoader::MeshReports() const
+{
+    return mesh_reports_;
+}
+
+void SceneLoader::LoadMeshes(const AssetTables& tables, const std::filesystem::path& scene_path, Scene& scene)
 {
-    if (!(entities_node && entities_node.IsSequence()))
+    if (assets_ != nullptr)
     {
+        RequestMeshes(tables, scene_path);
         return;
     }
 
-    for (const auto& entity_node : entities_node)
+    struct FileImport
     {
-        SceneEntity entity {};
-        entity.id = entity_node["id"].as<int64_t>(-1);
-        entity.name = SafeString(entity_node["name"], "Entity");
+        std::unique_ptr<GltfImporter> importer;
+        std::vector<uint32_t> meshes;           // unique mesh indices to decode
+        std::vector<GeometryHandle> geometry;   // parallel to meshes
+    };
+    struct Binding
+    {
+        const SceneMeshRequest* pending = nullptr;
+        FileImport* file = nullptr;
+        uint32_t mesh = 0;
+        std::string reference;
+    };
 
-        const auto components = entity_node["components"];
-        if (components && components.IsMap())
+    // Open each file once and collect the meshes it has to provide.
+    std::map<std::filesystem::path, FileImport> files;
+    std::vector<Binding> bindings;
+    for (const SceneMeshRequest& pending : pending_meshes_)
+    {
+        const std::string reference = LookupAsset(tables.meshes, pending.mesh);
+        const AssetReference asset = ParseAssetReference(reference);
+        const std::filesystem::path path = ResolveAssetPath(scene_path, asset.path);
+        if (path.empty())
         {
-            for (const auto& kv : components)
+            ZLOG_WARN("Mesh asset not found: " + reference);
+            continue;
+        }
+
+        FileImport& file = files[path];
+        if (!file.importer)
+        {
+            try
+            {
+                file.importer = std::make_unique<GltfImporter>(path);
+                const std::vector<std::filesystem::path> sources = file.importer->SourceFiles();
+                dependencies_.insert(dependencies_.end(), sources.begin(), sources.end());
+            }
+            catch (const std::exception& e)
             {
-                SceneComponentSummary comp {};
-                comp.name = kv.first.as<std::string>();
-                entity.components.push_back(std::move(comp));
+                ZLOG_ERROR("Failed to open mesh asset " + path.string() + ": " + e.what());
+                files.erase(path);
+                continue;
             }
         }
+        const int32_t mesh = file.importer->FindMesh(asset.sub_asset);
+        if (mesh < 0)
+        {
+            ZLOG_WARN("Mesh '" + asset.sub_asset + "' not found in " + path.string());
+            continue;
+        }
+        if (std::find(file.meshes.begin(), file.meshes.end(), static_cast<uint32_t>(mesh)) == file.meshes.end())
+        {
+            file.meshes.push_back(static_cast<uint32_t>(mesh));
+        }
+        bindings.push_back(Binding{&pending, &file, static_cast<uint32_t>(mesh), reference});
+    }
 
-        Entity& runtime = scene.CreateRuntimeEntity(entity.id, entity.name, parent);
-
-        if (components && components.IsMap())
+    for (auto& [path, file] : files)
+    {
+        try
         {
-            if (const auto transform = components["Transform"])
+            const std::vector<ImportedMesh> meshes = file.importer->ImportMeshes(file.meshes, JobSystem::Default());
+            for (const ImportedMesh& mesh : meshes)
             {
-                const MATH::Vec3f position = ReadVec3(transform["position"], {0.0F, 0.0F, 0.0F});
-                const MATH::Vec3f rotation = ReadVec3(transform["rotation"], {0.0F, 0.0F, 0.0F});
-                const MATH::Vec3f scale = ReadVec3(transform["scale"], {1.0F, 1.0F, 1.0F});
-
-                TransformComponent* tc = runtime.GetComponent<TransformComponent>();
-                if (tc == nullptr)
-                {
-                    tc = &runtime.AddComponent<TransformComponent>();
-                }
-                tc->SetPosition(position);
-                tc->SetEulerDegrees(rotation);
-                tc->SetScale(scale);
+                file.geometry.push_back(std::make_shared<const MeshGeometry>(MergePrimitives(mesh)));
+                mesh_reports_.push_back(SceneMeshReport{path, mesh.name, mesh.optimization});
             }
         }
+        catch (const std::exception& e)
+        {
+            ZLOG_ERROR("Failed to import " + path.string() + ": " + e.what());
+        }
+    }
 
-        scene.AddEntity(std::move(entity));
+    // Entities referencing the same mesh share one geometry, and so one LOD chain.
+    std::vector<MeshComponent*> bound;
+    for (const Binding& binding : bindings)
+    {
+        FileImport& file = *binding.file;
+        if (file.geometry.size() != file.meshes.size())
+        {
+            continue;
+        }
+        const auto slot = static_cast<size_t>(
+            std::find(file.meshes.begin(), file.meshes.end(), binding.mesh) - file.meshes.begin());
+        Entity& entity = *binding.pending->entity;
+        MeshComponent* mesh = entity.GetComponent<MeshComponent>();
+        if (mesh == nullptr)
+        {
+            mesh = &entity.AddComponent<MeshComponent>();
+        }
+        mesh->SetGeometry(file.geometry[slot]);
+        mesh->SetMeshAssetId(binding.reference);
+        BindMaterial(*mesh, tables, binding.pending->material);
+        scene.Spatial().Refresh(entity);
+        bound.push_back(mesh);
+    }
+    BuildLodChains(bound, LodChainSettings {}, JobSystem::Default());
+    pending_meshes_.clear();
+}
 
-        // Recurse into children if any.
-        if (const auto children = entity_node["children"]; children && children.IsSequence())
+void SceneLoader::RequestMeshes(const AssetTables& tables, const std::filesystem::path& scene_path)
+{
+    for (const SceneMeshRequest& pending : pending_meshes_)
+    {
+        const std::string reference = LookupAsset(tables.meshes, pending.mesh);
+        const AssetReference asset = ParseAssetReference(reference);
+        const std::filesystem::path path = ResolveAssetPath(scene_path, asset.path);
+        if (path.empty())
         {
-            ParseEntities(children, scene, &runtime);
+            ZLOG_WARN("Mesh asset not found: " + reference);
+            continue;
         }
+        if (std::find(dependencies_.begin(), dependencies_.end(), path) == dependencies_.end())
+        {
+            dependencies_.push_back(path);
+        }
+
+        // The resolved path keeps the key unique when scenes in different folders share names.
+        std::string resolved = path.lexically_normal().generic_string();
+        if (!asset.sub_asset.empty())
+        {
+            resolved += '#' + asset.sub_asset;
+        }
+
+        Entity& entity = *pending.entity;
+        MeshComponent* mesh = entity.GetComponent<MeshComponent>();
+        if (mesh == nullptr)
+        {
+            mesh = &entity.AddComponent<MeshComponent>();
+        }
+        mesh->SetMeshAsset(assets_->Load<MeshAsset>(resolved));
+        mesh->SetMeshAssetId(reference);
+        BindMaterial(*mesh, tables, pending.material);
+    }
+    pending_meshes_.clear();
+}
+
+void SceneLoader::ResolveMaterials(AssetTables& tables, const std::filesystem::path& scene_path)
+{
+    // There is no material file format; say so rather than draw them with the default silently.
+    for (const auto& [name, reference] : tables.materials)
+    {
+        if (!tables.definitions.contains(name))
+        {
+            ZLOG_WARN(
+                "Material files are not supported: '" + name + "' (" + reference
+                + ") draws with the default material; define it inline under assets.materials.");
+        }
+    }
+    for (auto& [name, definition] : tables.definitions)
+    {
+        for (std::string& texture : definition.descriptor.textures)
+        {
+            if (texture.empty())
+            {
+                continue;
+            }
+            const std::filesystem::path path = ResolveAssetPath(scene_path, texture);
+            if (path.empty())
+            {
+                ZLOG_WARN("Texture asset not found: " + texture + " (material '" + name + "')");
+                texture.clear();
+                continue;
+            }
+            if (std::find(dependencies_.begin(), dependencies_.end(), path) == dependencies_.end())
+            {
+                dependencies_.push_back(path);
+            }
+
+            // Keyed by the resolved path, as meshes are, so scenes sharing a texture share its asset.
+            texture = path.lexically_normal().generic_string();
+            if (assets_ != nullptr)
+            {
+                definition.textures.push_back(assets_->Load<TextureAsset>(texture));
+            }
+        }
+    }
+}
+
+void SceneLoader::BindMaterial(MeshComponent& mesh, const AssetTables& tables, const std::string& name)
+{
+    if (name.empty())
+    {
+        return;
+    }
+    mesh.SetMaterialAssetId(LookupAsset(tables.materials, name));
+    const auto it = tables.definitions.find(name);
+    if (it != tables.definitions.end())
+    {
+        mesh.SetMaterial(it->second.descriptor);
+        mesh.SetTextureAssets(it->second.textures);
     }
 }
 }  // namespace ENGINE
@@ -1,10 +1,17 @@
 #include "ZokataEngine/systems/scene/SceneManager.h"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <sstream>
 #include <string>
 #include <utility>
 
+#include "ZokataEngine/systems/asset/AssetManager.h"
+#include "ZokataEngine/systems/asset/FileWatcher.h"
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/scene/CookedScene.h"
+#include "ZokataEngine/systems/scene/SceneDiff.h"
 #include "ZokataEngine/systems/scene/SceneLoader.h"
 #include "ZokataLog/Log.h"
 
@@ -17,7 +24,45 @@ namespace ENGINE
 namespace
 {
 constexpr const char* kScenesFolder = "scenes";
+
+bool IsSceneFile(const fs::path& path)
+{
+    return path.extension() == ".yaml" || path.extension() == ".yml";
+}
+
+// Absolute and normalized, so watcher paths and recorded dependencies compare equal.
+fs::path NormalizedPath(const fs::path& path)
+{
+    std::error_code ec;
+    const fs::path absolute = fs::absolute(path, ec);
+    return (ec ? path : absolute).lexically_normal();
+}
+
+std::vector<fs::path> NormalizedPaths(const std::vector<fs::path>& paths)
+{
+    std::vector<fs::path> normalized;
+    normalized.reserve(paths.size());
+    for (const fs::path& path : paths)
+    {
+        normalized.push_back(NormalizedPath(path));
+    }
+    return normalized;
 }
+}  // namespace
+
+// Outcome of reading one scene file, produced on any thread and registered on the caller's.
+struct SceneManager::LoadedSceneFile
+{
+    std::unique_ptr<Scene> scene;  // null when loading failed
+    fs::path source_path;          // the cooked scene when it was used, else the YAML file
+    std::vector<fs::path> dependencies;
+    std::string warning;  // cooked scene that was rejected in favour of the YAML file
+    std::string error;
+};
+
+SceneManager::SceneManager() = default;
+
+SceneManager::~SceneManager() = default;
 
 Scene& SceneManager::CreateScene(const std::string& name)
 {
@@ -109,51 +154,118 @@ void SceneManager::DiscoverAndLoadScenes(const fs::path& scenes_root)
         return;
     }
 
+    // Sorted, so registration order (and with it the initially active scene) does not depend
+    // on the directory's listing order.
+    std::vector<fs::path> paths;
     for (const auto& entry : fs::directory_iterator(scenes_root_))
     {
-        if (!entry.is_regular_file())
+        if (entry.is_regular_file() && IsSceneFile(entry.path()))
         {
-            continue;
+            paths.push_back(entry.path());
         }
-        const auto& path = entry.path();
-        if (path.extension() == ".yaml" || path.extension() == ".yml")
+    }
+    std::sort(paths.begin(), paths.end());
+
+    for (const fs::path& path : paths)
+    {
+        scenes_metadata_.push_back(SceneMetadata{
+            .name = path.stem().string(),
+            .file_path = path,
+            .scene = nullptr,
+            .dependencies = {},
+        });
+        ZLOG_INFO("Found scene file: " + path.filename().string());
+    }
+
+    // One scene per task: startup takes as long as the largest scene rather than all of them.
+    // Each SceneLoader splits its own entities across the same pool.
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<LoadedSceneFile> loaded(paths.size());
+    JobSystem::Default().ParallelFor(paths.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
         {
-            scenes_metadata_.push_back(SceneMetadata{
-                .name = path.stem().string(),
-                .file_path = path,
-            });
-            ZLOG_INFO("Found scene file: " + path.filename().string());
-            LoadSceneFromFile(path);
+            loaded[i] = LoadSceneFile(paths[i], assets_);
         }
+    });
+    for (size_t i = 0; i < loaded.size(); ++i)
+    {
+        RegisterLoadedScene(scenes_metadata_[i], std::move(loaded[i]));
     }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
 
     ZKT::LOG::LogMessage msg {
         .tag = "SCENE",
-        .text = "Loaded " + std::to_string(scenes_.size()) + " scene(s) from " + scenes_root_.string(),
+        .text = "Loaded " + std::to_string(scenes_.size()) + " scene(s) from " + scenes_root_.string() + " in " +
+                std::to_string(static_cast<int>(elapsed.count())) + " ms",
         .color_code = "\033[35m",  // magenta tag for scene discovery
     };
     ZLOG_CUSTOM(msg);
 }
 
-void SceneManager::LoadSceneFromFile(const fs::path& scene_path)
+void SceneManager::SetAssetManager(AssetManager* assets)
 {
-    try
+    assets_ = assets;
+}
+
+SceneManager::LoadedSceneFile SceneManager::LoadSceneFile(const fs::path& scene_path, AssetManager* assets)
+{
+    LoadedSceneFile loaded;
+    loaded.source_path = scene_path;
+
+    // A cooked scene that is newer than all of its sources skips YAML parsing and mesh import.
+    const fs::path cooked_path = CookedScenePath(scene_path);
+    if (IsCookedSceneCurrent(cooked_path))
     {
-        SceneLoader loader;
-        auto loaded_scene = loader.LoadFromFile(scene_path);
-        if (loaded_scene)
+        try
         {
-            Scene& scene_ref = AddScene(std::move(loaded_scene));
-            if (active_scene_ == nullptr)
-            {
-                active_scene_ = &scene_ref;
-            }
-            ZLOG_INFO("Loaded scene '" + scene_ref.Name() + "' from " + scene_path.filename().string());
+            loaded.scene = LoadCookedScene(cooked_path);
+            loaded.source_path = cooked_path;
+            loaded.dependencies = NormalizedPaths(CookedSceneSources(cooked_path));
+            return loaded;
+        }
+        catch (const std::exception& e)
+        {
+            loaded.scene.reset();
+            loaded.warning = "Ignoring cooked scene '" + cooked_path.string() + "': " + e.what();
         }
     }
+
+    try
+    {
+        SceneLoader loader(assets);
+        loaded.scene = loader.LoadFromFile(scene_path);
+        loaded.dependencies = NormalizedPaths(loader.Dependencies());
+    }
     catch (const std::exception& e)
     {
-        ZLOG_ERROR("Failed to load scene '" + scene_path.string() + "': " + e.what());
+        loaded.scene.reset();
+        loaded.error = e.what();
+    }
+    return loaded;
+}
+
+void SceneManager::LoadSceneFromFile(SceneMetadata& metadata)
+{
+    RegisterLoadedScene(metadata, LoadSceneFile(metadata.file_path, assets_));
+}
+
+void SceneManager::RegisterLoadedScene(SceneMetadata& metadata, LoadedSceneFile loaded)
+{
+    if (!loaded.warning.empty())
+    {
+        ZLOG_WARN(loaded.warning);
+    }
+    if (!loaded.error.empty())
+    {
+        ZLOG_ERROR("Failed to load scene '" + metadata.file_path.string() + "': " + loaded.error);
+        return;
+    }
+    metadata.dependencies = std::move(loaded.dependencies);
+    if (loaded.scene)
+    {
+        Scene& scene_ref = AddScene(std::move(loaded.scene));
+        metadata.scene = &scene_ref;
+        ZLOG_INFO("Loaded scene '" + scene_ref.Name() + "' from " + loaded.source_path.filename().string());
     }
 }
 
@@ -175,5 +287,209 @@ fs::path SceneManager::FindScenesRoot(const fs::path& hint)
     }
     return {};
 }
+
+void SceneManager::EnableHotReload()
+{
+    if (watcher_)
+    {
+        return;
+    }
+    watcher_ = std::make_unique<FileWatcher>();
+    if (!watcher_->Valid())
+    {
+        ZLOG_WARN("Hot reload is not available on this platform.");
+        watcher_.reset();
+        return;
+    }
+    if (!scenes_root_.empty())
+    {
+        watcher_->WatchDirectory(NormalizedPath(scenes_root_));
+    }
+    for (const SceneMetadata& metadata : scenes_metadata_)
+    {
+        WatchDependencies(metadata);
+    }
+    ZLOG_INFO("Hot reload enabled for " + std::to_string(scenes_metadata_.size()) + " scene file(s).");
+}
+
+void SceneManager::PollHotReload()
+{
+    if (!watcher_)
+    {
+        return;
+    }
+    const std::vector<fs::path> changed = watcher_->Poll();
+    if (changed.empty())
+    {
+        return;
+    }
+
+    // Indices, since discovering a new scene file grows scenes_metadata_.
+    std::vector<size_t> edited;
+    std::vector<size_t> reapply;
+    const auto add_unique = [](std::vector<size_t>& list, size_t index) {
+        if (std::find(list.begin(), list.end(), index) == list.end())
+        {
+            list.push_back(index);
+        }
+    };
+    for (const fs::path& path : changed)
+    {
+        const fs::path file = NormalizedPath(path);
+        bool is_scene = false;
+        for (size_t i = 0; i < scenes_metadata_.size(); ++i)
+        {
+            if (NormalizedPath(scenes_metadata_[i].file_path) == file)
+            {
+                add_unique(edited, i);
+                is_scene = true;
+            }
+        }
+        if (is_scene)
+        {
+            continue;
+        }
+        if (IsSceneFile(file) && !scenes_root_.empty() && file.parent_path() == NormalizedPath(scenes_root_))
+        {
+            ZLOG_INFO("Found new scene file: " + file.filename().string());
+            scenes_metadata_.push_back(SceneMetadata{
+                .name = file.stem().string(),
+                .file_path = file,
+                .scene = nullptr,
+                .dependencies = {},
+            });
+            LoadSceneFromFile(scenes_metadata_.back());
+            WatchDependencies(scenes_metadata_.back());
+            if (scenes_metadata_.back().scene != nullptr && scenes_metadata_.back().scene == active_scene_)
+            {
+                OnEnableActive();
+                StartActive();
+            }
+            continue;
+        }
+
+        const size_t reloaded = assets_ != nullptr ? assets_->Reload(file) : 0;
+        if (reloaded > 0)
+        {
+            continue;
+        }
+        for (size_t i = 0; i < scenes_metadata_.size(); ++i)
+        {
+            const std::vector<fs::path>& dependencies = scenes_metadata_[i].dependencies;
+            if (std::find(dependencies.begin(), dependencies.end(), file) != dependencies.end())
+            {
+                add_unique(reapply, i);
+            }
+        }
+    }
+
+    for (const size_t index : edited)
+    {
+        ReloadScene(scenes_metadata_[index], false);
+    }
+    for (const size_t index : reapply)
+    {
+        if (std::find(edited.begin(), edited.end(), index) == edited.end())
+        {
+            ReloadScene(scenes_metadata_[index], true);
+        }
+    }
+}
+
+void SceneManager::ReloadScene(const fs::path& scene_path)
+{
+    const fs::path file = NormalizedPath(scene_path);
+    for (SceneMetadata& metadata : scenes_metadata_)
+    {
+        if (NormalizedPath(metadata.file_path) == file)
+        {
+            ReloadScene(metadata, false);
+            return;
+        }
+    }
+    ZLOG_WARN("Cannot reload '" + scene_path.string() + "': not a loaded scene file.");
+}
+
+void SceneManager::ReloadScene(SceneMetadata& metadata, bool reapply_components)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    std::unique_ptr<Scene> fresh;
+    SceneLoader loader(assets_);
+    try
+    {
+        fresh = loader.LoadFromFile(metadata.file_path);
+    }
+    catch (const std::exception& e)
+    {
+        // Usually a half-finished edit; the next save tries again.
+        ZLOG_ERROR("Hot reload of '" + metadata.file_path.filename().string() + "' failed: " + e.what());
+        return;
+    }
+    metadata.dependencies = NormalizedPaths(loader.Dependencies());
+    WatchDependencies(metadata);
+
+    if (metadata.scene == nullptr)
+    {
+        // It failed to load before; this is its first successful load.
+        metadata.scene = &AddScene(std::move(fresh));
+        ZLOG_INFO("Loaded scene '" + metadata.scene->Name() + "' from " + metadata.file_path.filename().string());
+        if (metadata.scene == active_scene_)
+        {
+            OnEnableActive();
+            StartActive();
+        }
+        return;
+    }
+
+    const SceneDiffOptions options {
+        .running = metadata.scene == active_scene_,
+        .reapply_components = reapply_components,
+    };
+    const std::optional<SceneDiffStats> stats = ApplySceneDiff(*metadata.scene, *fresh, options);
+    if (!stats)
+    {
+        ZLOG_WARN("Scene '" + metadata.scene->Name() + "' lacks unique entity ids; replacing it as a whole.");
+        ReplaceScene(metadata, std::move(fresh));
+        return;
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    ZLOG_INFO(
+        "Hot-reloaded '" + metadata.scene->Name() + "': " + std::to_string(stats->added) + " added, " +
+        std::to_string(stats->removed) + " removed, " + std::to_string(stats->changed) + " changed (" +
+        std::to_string(stats->components) + " components) in " + std::to_string(static_cast<int>(elapsed)) + " ms");
+}
+
+void SceneManager::ReplaceScene(SceneMetadata& metadata, std::unique_ptr<Scene> scene)
+{
+    const auto slot = std::find_if(
+        scenes_.begin(), scenes_.end(), [&metadata](const auto& owned) { return owned.get() == metadata.scene; });
+    if (slot == scenes_.end())
+    {
+        return;
+    }
+    const bool was_active = active_scene_ == metadata.scene;
+    *slot = std::move(scene);
+    metadata.scene = slot->get();
+    if (was_active)
+    {
+        active_scene_ = metadata.scene;
+        active_scene_->OnEnable();
+        active_scene_->Start();
+    }
+}
+
+void SceneManager::WatchDependencies(const SceneMetadata& metadata)
+{
+    if (!watcher_)
+    {
+        return;
+    }
+    for (const fs::path& dependency : metadata.dependencies)
+    {
+        watcher_->WatchDirectory(dependency.parent_path());
+    }
+}
 }  // namespace ENGINE
 }  // namespace ZKT
@@ -0,0 +1,165 @@
+#include "ZokataEngine/systems/scene/components/AnimatorComponent.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+void AnimatorComponent::OnEnable() {}
+
+void AnimatorComponent::OnDisable() {}
+
+void AnimatorComponent::Start()
+{
+    ResizeBuffers();
+}
+
+void AnimatorComponent::Update(float delta_seconds)
+{
+    const float step = delta_seconds * speed_;
+    Advance(current_, step);
+    if (previous_.clip)
+    {
+        Advance(previous_, step);
+        fade_elapsed_ += delta_seconds;
+        if (fade_elapsed_ >= fade_duration_)
+        {
+            previous_ = Layer {};
+        }
+    }
+}
+
+void AnimatorComponent::FixedUpdate(float /*fixed_seconds*/) {}
+
+void AnimatorComponent::SetSkeleton(std::shared_ptr<const Skeleton> skeleton)
+{
+    skeleton_ = std::move(skeleton);
+    ResizeBuffers();
+}
+
+const std::shared_ptr<const Skeleton>& AnimatorComponent::GetSkeleton() const
+{
+    return skeleton_;
+}
+
+void AnimatorComponent::Play(std::shared_ptr<const AnimationClip> clip, float fade_seconds, bool loop)
+{
+    if (current_.clip && fade_seconds > 0.0F)
+    {
+        previous_ = std::move(current_);
+        fade_duration_ = fade_seconds;
+        fade_elapsed_ = 0.0F;
+    }
+    else
+    {
+        previous_ = Layer {};
+    }
+    current_ = Layer {std::move(clip), 0.0F, loop};
+}
+
+void AnimatorComponent::Stop()
+{
+    current_ = Layer {};
+    previous_ = Layer {};
+}
+
+bool AnimatorComponent::IsPlaying() const
+{
+    return current_.clip != nullptr;
+}
+
+float AnimatorComponent::Speed() const
+{
+    return speed_;
+}
+
+void AnimatorComponent::SetSpeed(float speed)
+{
+    speed_ = speed;
+}
+
+void AnimatorComponent::Evaluate()
+{
+    if (!skeleton_)
+    {
+        return;
+    }
+    if (model_.size() != skeleton_->JointCount())
+    {
+        ResizeBuffers();
+    }
+
+    if (current_.clip && current_.clip->JointCount() == skeleton_->JointCount())
+    {
+        current_.clip->Sample(current_.time, pose_, scratch_);
+    }
+    else
+    {
+        pose_.SetBindPose(*skeleton_);
+    }
+
+    if (previous_.clip && previous_.clip->JointCount() == skeleton_->JointCount() && fade_duration_ > 0.0F)
+    {
+        previous_.clip->Sample(previous_.time, fade_pose_, scratch_);
+        const float weight = std::clamp(fade_elapsed_ / fade_duration_, 0.0F, 1.0F);
+        BlendPoses(fade_pose_, pose_, weight, pose_);
+    }
+
+    ComputeModelMatrices(*skeleton_, pose_, model_);
+    ComputeSkinningMatrices(*skeleton_, model_, skinning_);
+}
+
+const LocalPose& AnimatorComponent::Pose() const
+{
+    return pose_;
+}
+
+std::span<const MATH::Mat4f> AnimatorComponent::ModelMatrices() const
+{
+    return model_;
+}
+
+std::span<const MATH::Mat4f> AnimatorComponent::SkinningMatrices() const
+{
+    return skinning_;
+}
+
+void AnimatorComponent::Advance(Layer& layer, float delta_seconds) const
+{
+    if (!layer.clip)
+    {
+        return;
+    }
+    const float duration = layer.clip->Duration();
+    layer.time += delta_seconds;
+    if (layer.loop && duration > 0.0F)
+    {
+        layer.time = std::fmod(layer.time, duration);
+        if (layer.time < 0.0F)
+        {
+            layer.time += duration;
+        }
+    }
+    else
+    {
+        layer.time = std::clamp(layer.time, 0.0F, duration);
+    }
+}
+
+void AnimatorComponent::ResizeBuffers()
+{
+    const uint32_t joint_count = skeleton_ ? skeleton_->JointCount() : 0;
+    pose_.Resize(joint_count);
+    fade_pose_.Resize(joint_count);
+    model_.resize(joint_count);
+    skinning_.resize(joint_count);
+    if (skeleton_)
+    {
+        pose_.SetBindPose(*skeleton_);
+    }
+}
+}  // namespace ENGINE
+}  // namespace ZKT
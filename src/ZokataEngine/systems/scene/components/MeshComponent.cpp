@@ -1,18 +1,39 @@
 #include "ZokataEngine/systems/scene/components/MeshComponent.h"
 
+#include <algorithm>
+#include <stdexcept>
 #include <utility>
 
+#include "ZokataEngine/systems/scene/Entity.h"
+#include "ZokataEngine/systems/scene/components/TransformComponent.h"
+
 namespace ZKT
 {
 namespace ENGINE
 {
+namespace
+{
+const MeshGeometry& EmptyGeometry()
+{
+    static const MeshGeometry empty {};
+    return empty;
+}
+}  // namespace
+
 MeshComponent::MeshComponent(MeshGeometry geometry)
+    : geometry_(std::make_shared<MeshGeometry>(std::move(geometry)))
+    , owns_geometry_(true)
+{
+}
+
+MeshComponent::MeshComponent(GeometryHandle geometry)
     : geometry_(std::move(geometry))
 {
 }
 
 MeshComponent::MeshComponent(MeshGeometry geometry, MaterialDescriptor material)
-    : geometry_(std::move(geometry))
+    : geometry_(std::make_shared<MeshGeometry>(std::move(geometry)))
+    , owns_geometry_(true)
     , material_(std::move(material))
 {
 }
@@ -23,11 +44,23 @@ void MeshComponent::OnDisable() {}
 
 void MeshComponent::Start() {}
 
-void MeshComponent::Update(float /*delta_seconds*/) {}
+void MeshComponent::Update(float /*delta_seconds*/)
+{
+    // A hot reload bumps the asset's version; take the new geometry like a first load.
+    if (mesh_asset_pending_ || (mesh_asset_.Valid() && mesh_asset_.Version() != mesh_asset_version_))
+    {
+        ResolveMeshAsset();
+    }
+}
 
 void MeshComponent::FixedUpdate(float /*fixed_seconds*/) {}
 
 const MeshGeometry& MeshComponent::Geometry() const
+{
+    return geometry_ ? *geometry_ : EmptyGeometry();
+}
+
+const GeometryHandle& MeshComponent::SharedGeometry() const
 {
     return geometry_;
 }
@@ -37,6 +70,35 @@ const MaterialDescriptor& MeshComponent::Material() const
     return material_;
 }
 
+uint64_t MeshComponent::MaterialKey() const
+{
+    if (material_key_dirty_)
+    {
+        material_key_ = HashMaterial(material_);
+        material_key_dirty_ = false;
+    }
+    return material_key_;
+}
+
+uint32_t MeshComponent::LodCount() const
+{
+    return static_cast<uint32_t>(lods_.size()) + 1;
+}
+
+const MeshGeometry& MeshComponent::LodGeometry(uint32_t lod) const
+{
+    if (lod == 0 || lods_.empty())
+    {
+        return Geometry();
+    }
+    return *lods_[std::min<size_t>(lod, lods_.size()) - 1].geometry;
+}
+
+const std::vector<GpuMeshlet>* MeshComponent::Meshlets() const
+{
+    return meshlets_.get();
+}
+
 bool MeshComponent::IsVisible() const
 {
     return visible_;
@@ -53,26 +115,48 @@ void MeshComponent::MarkUploaded()
 }
 
 void MeshComponent::SetGeometry(MeshGeometry geometry)
+{
+    SetGeometry(std::make_shared<MeshGeometry>(std::move(geometry)));
+    owns_geometry_ = true;
+}
+
+void MeshComponent::SetGeometry(GeometryHandle geometry)
 {
     geometry_ = std::move(geometry);
+    owns_geometry_ = false;
+    lods_.clear();
+    meshlets_.reset();
+    selected_lod_ = 0;
     dirty_ = true;
+    bounds_dirty_ = true;
 }
 
 void MeshComponent::SetMaterial(MaterialDescriptor material)
 {
     material_ = std::move(material);
     dirty_ = true;
+    material_key_dirty_ = true;
 }
 
 MeshGeometry& MeshComponent::GeometryMutable()
 {
+    // Copy on write: cached or shared geometry must stay untouched for its other users.
+    if (!owns_geometry_ || geometry_.use_count() > 1)
+    {
+        geometry_ = std::make_shared<MeshGeometry>(Geometry());
+        owns_geometry_ = true;
+    }
+    meshlets_.reset();
     dirty_ = true;
-    return geometry_;
+    bounds_dirty_ = true;
+    // Owned geometry is allocated non-const and referenced only by this component.
+    return const_cast<MeshGeometry&>(*geometry_);
 }
 
 MaterialDescriptor& MeshComponent::MaterialMutable()
 {
     dirty_ = true;
+    material_key_dirty_ = true;
     return material_;
 }
 
@@ -81,6 +165,101 @@ void MeshComponent::SetVisible(bool visible)
     visible_ = visible;
 }
 
+void MeshComponent::SetOccluder(bool occluder)
+{
+    occluder_ = occluder;
+}
+
+bool MeshComponent::IsOccluder() const
+{
+    return occluder_;
+}
+
+void MeshComponent::AddLod(MeshGeometry geometry, float error)
+{
+    AddLod(std::make_shared<const MeshGeometry>(std::move(geometry)), error);
+}
+
+void MeshComponent::AddLod(GeometryHandle geometry, float error)
+{
+    if (geometry == nullptr)
+    {
+        throw std::runtime_error("LOD geometry must not be null");
+    }
+    if (error < LodError(LodCount() - 1))
+    {
+        throw std::runtime_error("LOD errors must not decrease along the chain");
+    }
+    lods_.push_back(MeshLod{std::move(geometry), error});
+    dirty_ = true;
+}
+
+void MeshComponent::SetLods(std::vector<MeshLod> lods)
+{
+    float previous = 0.0F;
+    for (const MeshLod& lod : lods)
+    {
+        if (lod.geometry == nullptr)
+        {
+            throw std::runtime_error("LOD geometry must not be null");
+        }
+        if (lod.error < previous)
+        {
+            throw std::runtime_error("LOD errors must not decrease along the chain");
+        }
+        previous = lod.error;
+    }
+    lods_ = std::move(lods);
+    selected_lod_ = std::min(selected_lod_, LodCount() - 1);
+    dirty_ = true;
+}
+
+void MeshComponent::SetMeshlets(MeshletsHandle meshlets)
+{
+    meshlets_ = std::move(meshlets);
+    dirty_ = true;
+}
+
+void MeshComponent::ClearLods()
+{
+    lods_.clear();
+    selected_lod_ = 0;
+    dirty_ = true;
+}
+
+float MeshComponent::LodError(uint32_t lod) const
+{
+    if (lod == 0 || lods_.empty())
+    {
+        return 0.0F;
+    }
+    return lods_[std::min<size_t>(lod, lods_.size()) - 1].error;
+}
+
+uint32_t MeshComponent::SelectedLod() const
+{
+    return selected_lod_;
+}
+
+void MeshComponent::SetSelectedLod(uint32_t lod)
+{
+    selected_lod_ = std::min(lod, LodCount() - 1);
+}
+
+const MATH::Aabb& MeshComponent::LocalBounds() const
+{
+    if (bounds_dirty_)
+    {
+        local_bounds_ = MATH::Aabb{};
+        for (const MeshVertex& vertex : Geometry().vertices)
+        {
+            local_bounds_.Expand(vertex.position);
+        }
+        bounds_dirty_ = false;
+    }
+    return local_bounds_;
+}
+
 const std::string& MeshComponent::MeshAssetId() const
 {
     return mesh_asset_id_;
@@ -89,7 +268,53 @@ const std::string& MeshComponent::MeshAssetId() const
 void MeshComponent::SetMeshAssetId(std::string id)
 {
     mesh_asset_id_ = std::move(id);
-    // TODO: Resolve asset -> geometry once asset system is wired.
+}
+
+void MeshComponent::SetMeshAsset(AssetHandle<ENGINE::MeshAsset> asset)
+{
+    mesh_asset_ = std::move(asset);
+    mesh_asset_pending_ = mesh_asset_.Valid();
+    if (mesh_asset_pending_)
+    {
+        ResolveMeshAsset();
+    }
+}
+
+const AssetHandle<ENGINE::MeshAsset>& MeshComponent::MeshAsset() const
+{
+    return mesh_asset_;
+}
+
+bool MeshComponent::IsMeshAssetPending() const
+{
+    return mesh_asset_pending_;
+}
+
+void MeshComponent::ResolveMeshAsset()
+{
+    switch (mesh_asset_.State())
+    {
+    case AssetState::Loading:
+        return;
+    case AssetState::Ready:
+    {
+        mesh_asset_version_ = mesh_asset_.Version();
+        const std::shared_ptr<const ENGINE::MeshAsset> asset = mesh_asset_.Get();
+        SetGeometry(asset->geometry);
+        SetLods(asset->lods);
+        SetMeshlets(asset->meshlets);
+        // Bounds changed: have the scene's transform pass refresh the spatial index.
+        if (Entity* owner = Owner())
+        {
+            owner->Transform().MarkDirty();
+        }
+        break;
+    }
+    case AssetState::Failed:
+        mesh_asset_version_ = mesh_asset_.Version();
+        break;
+    }
+    mesh_asset_pending_ = false;
 }
 
 const std::string& MeshComponent::MaterialAssetId() const
@@ -100,17 +325,26 @@ const std::string& MeshComponent::MaterialAssetId() const
 void MeshComponent::SetMaterialAssetId(std::string id)
 {
     material_asset_id_ = std::move(id);
-    // TODO: Resolve asset -> material/shader/textures once material system exists.
+}
+
+void MeshComponent::SetTextureAssets(std::vector<AssetHandle<TextureAsset>> textures)
+{
+    texture_assets_ = std::move(textures);
+}
+
+const std::vector<AssetHandle<TextureAsset>>& MeshComponent::TextureAssets() const
+{
+    return texture_assets_;
 }
 
 void MeshComponent::SetPrimitiveCube(const CubeParams& params)
 {
-    SetGeometry(MakeCube(params));
+    SetGeometry(GeometryCache::Default().Cube(params));
 }
 
 void MeshComponent::SetPrimitiveSphere(const SphereParams& params)
 {
-    SetGeometry(MakeSphere(params));
+    SetGeometry(GeometryCache::Default().Sphere(params));
 }
 }  // namespace ENGINE
 }  // namespace ZKT
@@ -1,10 +1,14 @@
 #include "ZokataEngine/systems/scene/components/Primitives/MeshPrimitives.h"
 
 #include <algorithm>
+#include <functional>
+#include <stdexcept>
 
 #include <glm/gtc/constants.hpp>
 #include <glm/trigonometric.hpp>
 
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+
 namespace ZKT
 {
 namespace ENGINE
@@ -30,13 +34,118 @@ MeshVertex MakeVertex(const MATH::Vec3f& position,
     vertex.tangent = tangent;
     return vertex;
 }
+
+constexpr size_t kVerticesPerBand = 4096;  // parallel work unit for row-banded generators
+
+struct SphereLayout
+{
+    float radius = 0.0F;
+    uint32_t longitude = 0;
+    uint32_t latitude = 0;
+};
+
+SphereLayout ResolveSphere(const SphereParams& params)
+{
+    return SphereLayout{
+        std::max(0.0F, params.radius),
+        std::max<uint32_t>(3, params.longitude_segments),
+        std::max<uint32_t>(2, params.latitude_segments),
+    };
+}
+
+GridParams ResolveGrid(const GridParams& params)
+{
+    GridParams resolved = params;
+    resolved.x_segments = std::max<uint32_t>(1, params.x_segments);
+    resolved.z_segments = std::max<uint32_t>(1, params.z_segments);
+    return resolved;
+}
+
+void CheckCapacity(const MeshSize& size, std::span<MeshVertex> vertices, std::span<uint32_t> indices)
+{
+    if (vertices.size() < size.vertices || indices.size() < size.indices)
+    {
+        throw std::runtime_error("Primitive output spans are smaller than the reported mesh size.");
+    }
+}
+
+// Quad columns per index strip: the row a strip just finished (kStripColumns + 1 vertices) is
+// still in a 16-entry post-transform cache when the next row reuses it, where a full-width row
+// would already have been evicted.
+constexpr uint32_t kStripColumns = 7;
+
+// Writes the two triangles of every quad in rows [first_row, last_row) of a (columns + 1)-wide
+// vertex lattice with `rows` quad rows. Quads are ordered in kStripColumns-wide strips, each
+// strip top to bottom, so any band of rows knows where its quads go without the others.
+void WriteQuadStrips(std::span<uint32_t> indices, uint32_t columns, uint32_t rows, uint32_t first_row, uint32_t last_row)
+{
+    for (uint32_t strip_begin = 0; strip_begin < columns; strip_begin += kStripColumns)
+    {
+        const uint32_t strip_end = std::min(columns, strip_begin + kStripColumns);
+        const uint32_t width = strip_end - strip_begin;
+        size_t cursor = (static_cast<size_t>(rows) * strip_begin + static_cast<size_t>(first_row) * width) * 6;
+        for (uint32_t row = first_row; row < last_row; ++row)
+        {
+            const uint32_t row_a = row * (columns + 1);
+            const uint32_t row_b = (row + 1) * (columns + 1);
+            for (uint32_t column = strip_begin; column < strip_end; ++column)
+            {
+                const uint32_t a = row_a + column;
+                const uint32_t b = row_a + column + 1;
+                const uint32_t c = row_b + column + 1;
+                const uint32_t d = row_b + column;
+
+                indices[cursor++] = a;
+                indices[cursor++] = b;
+                indices[cursor++] = c;
+
+                indices[cursor++] = a;
+                indices[cursor++] = c;
+                indices[cursor++] = d;
+            }
+        }
+    }
+}
+
+// Runs fn over vertex rows [0, rows) in bands, on the job system when one is given.
+void ForEachRowBand(uint32_t rows, uint32_t row_vertices, JobSystem* jobs, const std::function<void(size_t, size_t)>& fn)
+{
+    const size_t grain = std::max<size_t>(1, kVerticesPerBand / std::max<uint32_t>(row_vertices, 1));
+    if (jobs == nullptr || rows <= grain)
+    {
+        fn(0, rows);
+        return;
+    }
+    jobs->ParallelFor(rows, grain, fn);
+}
 }  // namespace
 
-MeshGeometry MakeCube(const CubeParams& params)
+MeshSize CubeSize(const CubeParams& /*params*/)
 {
-    MeshGeometry mesh {};
-    mesh.vertices.reserve(24);
-    mesh.indices.reserve(36);
+    return MeshSize{24, 36};
+}
+
+MeshSize SphereSize(const SphereParams& params)
+{
+    const SphereLayout layout = ResolveSphere(params);
+    return MeshSize{
+        static_cast<size_t>(layout.latitude + 1) * (layout.longitude + 1),
+        static_cast<size_t>(layout.latitude) * layout.longitude * 6,
+    };
+}
+
+MeshSize GridSize(const GridParams& params)
+{
+    const GridParams grid = ResolveGrid(params);
+    return MeshSize{
+        static_cast<size_t>(grid.z_segments + 1) * (grid.x_segments + 1),
+        static_cast<size_t>(grid.z_segments) * grid.x_segments * 6,
+    };
+}
+
+void WriteCube(const CubeParams& params, std::span<MeshVertex> vertices, std::span<uint32_t> indices)
+{
+    CheckCapacity(CubeSize(params), vertices, indices);
 
     const MATH::Vec3f half {
         params.size.x * 0.5F,
@@ -53,6 +162,8 @@ MeshGeometry MakeCube(const CubeParams& params)
         {{0.0F, 0.0F, -1.0F}, {-1.0F, 0.0F, 0.0F}, {0.0F, 1.0F, 0.0F}},  // -Z
     };
 
+    uint32_t base_index = 0;
+    size_t index_cursor = 0;
     for (const CubeFace& face : faces)
     {
         const MATH::Vec3f center {
@@ -72,93 +183,126 @@ MeshGeometry MakeCube(const CubeParams& params)
             face.bitangent.z * half.z,
         };
 
-        const uint32_t base_index = static_cast<uint32_t>(mesh.vertices.size());
+        vertices[base_index + 0] = MakeVertex(center - u - v, face.normal, {0.0F, 0.0F}, face.tangent);
+        vertices[base_index + 1] = MakeVertex(center + u - v, face.normal, {1.0F, 0.0F}, face.tangent);
+        vertices[base_index + 2] = MakeVertex(center + u + v, face.normal, {1.0F, 1.0F}, face.tangent);
+        vertices[base_index + 3] = MakeVertex(center - u + v, face.normal, {0.0F, 1.0F}, face.tangent);
 
-        mesh.vertices.push_back(MakeVertex(center - u - v, face.normal, {0.0F, 0.0F}, face.tangent));
-        mesh.vertices.push_back(MakeVertex(center + u - v, face.normal, {1.0F, 0.0F}, face.tangent));
-        mesh.vertices.push_back(MakeVertex(center + u + v, face.normal, {1.0F, 1.0F}, face.tangent));
-        mesh.vertices.push_back(MakeVertex(center - u + v, face.normal, {0.0F, 1.0F}, face.tangent));
+        indices[index_cursor++] = base_index + 0;
+        indices[index_cursor++] = base_index + 1;
+        indices[index_cursor++] = base_index + 2;
 
-        mesh.indices.push_back(base_index + 0);
-        mesh.indices.push_back(base_index + 1);
-        mesh.indices.push_back(base_index + 2);
+        indices[index_cursor++] = base_index + 0;
+        indices[index_cursor++] = base_index + 2;
+        indices[index_cursor++] = base_index + 3;
 
-        mesh.indices.push_back(base_index + 0);
-        mesh.indices.push_back(base_index + 2);
-        mesh.indices.push_back(base_index + 3);
+        base_index += 4;
     }
-
-    return mesh;
 }
 
-MeshGeometry MakeSphere(const SphereParams& params)
+void WriteSphere(const SphereParams& params, std::span<MeshVertex> vertices, std::span<uint32_t> indices, JobSystem* jobs)
 {
-    MeshGeometry mesh {};
-
-    const float radius = std::max(0.0F, params.radius);
-    const uint32_t longitude = std::max<uint32_t>(3, params.longitude_segments);
-    const uint32_t latitude = std::max<uint32_t>(2, params.latitude_segments);
-
-    const uint32_t rings = latitude + 1;
-    const uint32_t segments = longitude + 1;
-    mesh.vertices.reserve(static_cast<size_t>(rings) * static_cast<size_t>(segments));
-    mesh.indices.reserve(static_cast<size_t>(latitude) * static_cast<size_t>(longitude) * 6);
+    CheckCapacity(SphereSize(params), vertices, indices);
 
+    const SphereLayout layout = ResolveSphere(params);
+    const uint32_t longitude = layout.longitude;
+    const uint32_t latitude = layout.latitude;
     const float two_pi = glm::two_pi<float>();
     const float pi = glm::pi<float>();
 
-    for (uint32_t lat = 0; lat <= latitude; ++lat)
-    {
-        const float v = static_cast<float>(lat) / static_cast<float>(latitude);
-        const float theta = v * pi;
-        const float sin_theta = glm::sin(theta);
-        const float cos_theta = glm::cos(theta);
-
-        for (uint32_t lon = 0; lon <= longitude; ++lon)
+    ForEachRowBand(latitude + 1, longitude + 1, jobs, [&](size_t begin, size_t end) {
+        for (auto lat = static_cast<uint32_t>(begin); lat < end; ++lat)
         {
-            const float u = static_cast<float>(lon) / static_cast<float>(longitude);
-            const float phi = u * two_pi;
-            const float sin_phi = glm::sin(phi);
-            const float cos_phi = glm::cos(phi);
-
-            const MATH::Vec3f normal {
-                sin_theta * cos_phi,
-                cos_theta,
-                sin_theta * sin_phi,
-            };
-            const MATH::Vec3f position {
-                normal.x * radius,
-                normal.y * radius,
-                normal.z * radius,
-            };
-            const MATH::Vec3f tangent {-sin_phi, 0.0F, cos_phi};
-
-            mesh.vertices.push_back(MakeVertex(position, normal, {u, 1.0F - v}, tangent));
+            const float v = static_cast<float>(lat) / static_cast<float>(latitude);
+            const float theta = v * pi;
+            const float sin_theta = glm::sin(theta);
+            const float cos_theta = glm::cos(theta);
+
+            MeshVertex* row = vertices.data() + static_cast<size_t>(lat) * (longitude + 1);
+            for (uint32_t lon = 0; lon <= longitude; ++lon)
+            {
+                const float u = static_cast<float>(lon) / static_cast<float>(longitude);
+                const float phi = u * two_pi;
+                const float sin_phi = glm::sin(phi);
+                const float cos_phi = glm::cos(phi);
+
+                const MATH::Vec3f normal {
+                    sin_theta * cos_phi,
+                    cos_theta,
+                    sin_theta * sin_phi,
+                };
+                const MATH::Vec3f position {
+                    normal.x * layout.radius,
+                    normal.y * layout.radius,
+                    normal.z * layout.radius,
+                };
+                const MATH::Vec3f tangent {-sin_phi, 0.0F, cos_phi};
+
+                row[lon] = MakeVertex(position, normal, {u, 1.0F - v}, tangent);
+            }
         }
-    }
+        WriteQuadStrips(
+            indices, longitude, latitude, static_cast<uint32_t>(begin), std::min<uint32_t>(static_cast<uint32_t>(end), latitude));
+    });
+}
 
-    for (uint32_t lat = 0; lat < latitude; ++lat)
-    {
-        const uint32_t row_a = lat * (longitude + 1);
-        const uint32_t row_b = (lat + 1) * (longitude + 1);
+void WriteGrid(const GridParams& params, std::span<MeshVertex> vertices, std::span<uint32_t> indices, JobSystem* jobs)
+{
+    CheckCapacity(GridSize(params), vertices, indices);
+
+    const GridParams grid = ResolveGrid(params);
+    const MATH::Vec3f normal {0.0F, 1.0F, 0.0F};
+    const MATH::Vec3f tangent {1.0F, 0.0F, 0.0F};
 
-        for (uint32_t lon = 0; lon < longitude; ++lon)
+    ForEachRowBand(grid.z_segments + 1, grid.x_segments + 1, jobs, [&](size_t begin, size_t end) {
+        for (auto z = static_cast<uint32_t>(begin); z < end; ++z)
         {
-            const uint32_t a = row_a + lon;
-            const uint32_t b = row_a + lon + 1;
-            const uint32_t c = row_b + lon + 1;
-            const uint32_t d = row_b + lon;
-
-            mesh.indices.push_back(a);
-            mesh.indices.push_back(b);
-            mesh.indices.push_back(c);
-
-            mesh.indices.push_back(a);
-            mesh.indices.push_back(c);
-            mesh.indices.push_back(d);
+            const float v = static_cast<float>(z) / static_cast<float>(grid.z_segments);
+            MeshVertex* row = vertices.data() + static_cast<size_t>(z) * (grid.x_segments + 1);
+            for (uint32_t x = 0; x <= grid.x_segments; ++x)
+            {
+                const float u = static_cast<float>(x) / static_cast<float>(grid.x_segments);
+                const MATH::Vec3f position {(u - 0.5F) * grid.size.x, 0.0F, (0.5F - v) * grid.size.y};
+                row[x] = MakeVertex(position, normal, {u, 1.0F - v}, tangent);
+            }
         }
-    }
+        // Rows run toward -Z so the shared quad winding is counter-clockwise seen from +Y.
+        WriteQuadStrips(
+            indices,
+            grid.x_segments,
+            grid.z_segments,
+            static_cast<uint32_t>(begin),
+            std::min<uint32_t>(static_cast<uint32_t>(end), grid.z_segments));
+    });
+}
 
+MeshGeometry MakeCube(const CubeParams& params)
+{
+    const MeshSize size = CubeSize(params);
+    MeshGeometry mesh {};
+    mesh.vertices.resize(size.vertices);
+    mesh.indices.resize(size.indices);
+    WriteCube(params, mesh.vertices, mesh.indices);
+    return mesh;
+}
+
+MeshGeometry MakeSphere(const SphereParams& params)
+{
+    const MeshSize size = SphereSize(params);
+    MeshGeometry mesh {};
+    mesh.vertices.resize(size.vertices);
+    mesh.indices.resize(size.indices);
+    WriteSphere(params, mesh.vertices, mesh.indices);
+    return mesh;
+}
+
+MeshGeometry MakeGrid(const GridParams& params)
+{
+    const MeshSize size = GridSize(params);
+    MeshGeometry mesh {};
+    mesh.vertices.resize(size.vertices);
+    mesh.indices.resize(size.indices);
+    WriteGrid(params, mesh.vertices, mesh.indices);
     return mesh;
 }
 }  // namespace ENGINE
@@ -0,0 +1,65 @@
+#include "ZokataEngine/systems/scene/components/TerrainComponent.h"
+
+#include <utility>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+TerrainComponent::TerrainComponent(std::shared_ptr<const Heightfield> heightfield, TerrainSettings settings)
+    : heightfield_(std::move(heightfield))
+    , settings_(settings)
+{
+}
+
+void TerrainComponent::OnEnable() {}
+
+void TerrainComponent::OnDisable() {}
+
+void TerrainComponent::Start() {}
+
+void TerrainComponent::Update(float /*delta_seconds*/) {}
+
+void TerrainComponent::FixedUpdate(float /*fixed_seconds*/) {}
+
+void TerrainComponent::SetHeightfield(std::shared_ptr<const Heightfield> heightfield)
+{
+    heightfield_ = std::move(heightfield);
+}
+
+const std::shared_ptr<const Heightfield>& TerrainComponent::GetHeightfield() const
+{
+    return heightfield_;
+}
+
+const TerrainSettings& TerrainComponent::Settings() const
+{
+    return settings_;
+}
+
+TerrainSettings& TerrainComponent::SettingsMutable()
+{
+    return settings_;
+}
+
+const MaterialDescriptor& TerrainComponent::Material() const
+{
+    return material_;
+}
+
+void TerrainComponent::SetMaterial(MaterialDescriptor material)
+{
+    material_ = std::move(material);
+}
+
+TerrainTree& TerrainComponent::Tree()
+{
+    return tree_;
+}
+
+const TerrainTree& TerrainComponent::Tree() const
+{
+    return tree_;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -82,6 +82,11 @@ const MATH::Mat4f& TransformComponent::GetModelMatrix() const
     return model_matrix_;
 }
 
+bool TransformComponent::IsDirty() const
+{
+    return dirty_;
+}
+
 void TransformComponent::MarkDirty()
 {
     dirty_ = true;
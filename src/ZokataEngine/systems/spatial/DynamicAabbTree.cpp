@@ -0,0 +1,308 @@
+#include "ZokataEngine/systems/spatial/DynamicAabbTree.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+DynamicAabbTree::DynamicAabbTree(float fat_margin, float displacement_multiplier)
+    : fat_margin_(fat_margin)
+    , displacement_multiplier_(displacement_multiplier)
+{
+}
+
+int32_t DynamicAabbTree::CreateProxy(const MATH::Aabb& box, uint64_t user_data)
+{
+    const int32_t leaf = AllocateNode();
+    Node& node = nodes_[leaf];
+    node.box = box.Inflated(fat_margin_);
+    node.user_data = user_data;
+    node.height = 0;
+
+    InsertLeaf(leaf);
+    ++proxy_count_;
+    return leaf;
+}
+
+void DynamicAabbTree::DestroyProxy(int32_t proxy)
+{
+    assert(proxy >= 0 && proxy < static_cast<int32_t>(nodes_.size()) && nodes_[proxy].IsLeaf());
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --proxy_count_;
+}
+
+bool DynamicAabbTree::MoveProxy(int32_t proxy, const MATH::Aabb& box, const MATH::Vec3f& displacement)
+{
+    assert(proxy >= 0 && proxy < static_cast<int32_t>(nodes_.size()) && nodes_[proxy].IsLeaf());
+
+    Node& node = nodes_[proxy];
+    if (node.box.Contains(box))
+    {
+        // Still inside the fat box; but shrink it if it has become far too loose, otherwise
+        // a fast mover that stopped would keep an oversized box forever.
+        const MATH::Aabb huge = box.Inflated(4.0F * fat_margin_ + displacement.Length() * displacement_multiplier_);
+        if (huge.Contains(node.box))
+        {
+            return false;
+        }
+    }
+
+    RemoveLeaf(proxy);
+
+    MATH::Aabb fat = box.Inflated(fat_margin_);
+    const MATH::Vec3f d = displacement * displacement_multiplier_;
+    (d.x < 0.0F ? fat.min.x : fat.max.x) += d.x;
+    (d.y < 0.0F ? fat.min.y : fat.max.y) += d.y;
+    (d.z < 0.0F ? fat.min.z : fat.max.z) += d.z;
+    nodes_[proxy].box = fat;
+
+    InsertLeaf(proxy);
+    return true;
+}
+
+uint64_t DynamicAabbTree::UserData(int32_t proxy) const
+{
+    return nodes_[proxy].user_data;
+}
+
+void DynamicAabbTree::SetUserData(int32_t proxy, uint64_t user_data)
+{
+    nodes_[proxy].user_data = user_data;
+}
+
+const MATH::Aabb& DynamicAabbTree::FatAabb(int32_t proxy) const
+{
+    return nodes_[proxy].box;
+}
+
+void DynamicAabbTree::Clear()
+{
+    nodes_.clear();
+    root_ = kNullNode;
+    free_list_ = kNullNode;
+    proxy_count_ = 0;
+}
+
+int32_t DynamicAabbTree::ProxyCount() const
+{
+    return proxy_count_;
+}
+
+int32_t DynamicAabbTree::Height() const
+{
+    return root_ == kNullNode ? 0 : nodes_[root_].height;
+}
+
+MATH::Aabb DynamicAabbTree::Bounds() const
+{
+    return root_ == kNullNode ? MATH::Aabb{} : nodes_[root_].box;
+}
+
+int32_t DynamicAabbTree::AllocateNode()
+{
+    if (free_list_ == kNullNode)
+    {
+        nodes_.emplace_back();
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+
+    const int32_t id = free_list_;
+    free_list_ = nodes_[id].parent;
+    nodes_[id] = Node{};
+    return id;
+}
+
+void DynamicAabbTree::FreeNode(int32_t id)
+{
+    nodes_[id].parent = free_list_;
+    nodes_[id].child_a = kNullNode;
+    nodes_[id].child_b = kNullNode;
+    nodes_[id].height = -1;
+    free_list_ = id;
+}
+
+void DynamicAabbTree::InsertLeaf(int32_t leaf)
+{
+    if (root_ == kNullNode)
+    {
+        root_ = leaf;
+        nodes_[root_].parent = kNullNode;
+        return;
+    }
+
+    // Descend choosing the child with the lowest surface-area cost increase.
+    const MATH::Aabb leaf_box = nodes_[leaf].box;
+    int32_t index = root_;
+    while (!nodes_[index].IsLeaf())
+    {
+        const Node& node = nodes_[index];
+        const float area = node.box.SurfaceArea();
+        const float combined_area = MATH::Aabb::Union(node.box, leaf_box).SurfaceArea();
+
+        // Cost of making a new parent for this node and the leaf.
+        const float cost = 2.0F * combined_area;
+        // Minimum cost of pushing the leaf further down the tree.
+        const float inheritance_cost = 2.0F * (combined_area - area);
+
+        const auto child_cost = [&](int32_t child) {
+            const Node& c = nodes_[child];
+            const float new_area = MATH::Aabb::Union(leaf_box, c.box).SurfaceArea();
+            return c.IsLeaf() ? new_area + inheritance_cost
+                              : (new_area - c.box.SurfaceArea()) + inheritance_cost;
+        };
+
+        const float cost_a = child_cost(node.child_a);
+        const float cost_b = child_cost(node.child_b);
+        if (cost < cost_a && cost < cost_b)
+        {
+            break;
+        }
+        index = cost_a < cost_b ? node.child_a : node.child_b;
+    }
+
+    const int32_t sibling = index;
+    const int32_t old_parent = nodes_[sibling].parent;
+    const int32_t new_parent = AllocateNode();
+    Node& parent = nodes_[new_parent];
+    parent.parent = old_parent;
+    parent.box = MATH::Aabb::Union(leaf_box, nodes_[sibling].box);
+    parent.height = nodes_[sibling].height + 1;
+    parent.child_a = sibling;
+    parent.child_b = leaf;
+    nodes_[sibling].parent = new_parent;
+    nodes_[leaf].parent = new_parent;
+
+    if (old_parent != kNullNode)
+    {
+        Node& grand = nodes_[old_parent];
+        (grand.child_a == sibling ? grand.child_a : grand.child_b) = new_parent;
+    }
+    else
+    {
+        root_ = new_parent;
+    }
+
+    RefitUpwards(nodes_[leaf].parent);
+}
+
+void DynamicAabbTree::RemoveLeaf(int32_t leaf)
+{
+    if (leaf == root_)
+    {
+        root_ = kNullNode;
+        return;
+    }
+
+    const int32_t parent = nodes_[leaf].parent;
+    const int32_t grand_parent = nodes_[parent].parent;
+    const int32_t sibling = nodes_[parent].child_a == leaf ? nodes_[parent].child_b : nodes_[parent].child_a;
+
+    if (grand_parent != kNullNode)
+    {
+        Node& grand = nodes_[grand_parent];
+        (grand.child_a == parent ? grand.child_a : grand.child_b) = sibling;
+        nodes_[sibling].parent = grand_parent;
+        FreeNode(parent);
+        RefitUpwards(grand_parent);
+    }
+    else
+    {
+        root_ = sibling;
+        nodes_[sibling].parent = kNullNode;
+        FreeNode(parent);
+    }
+}
+
+void DynamicAabbTree::RefitUpwards(int32_t id)
+{
+    while (id != kNullNode)
+    {
+        id = Balance(id);
+
+        Node& node = nodes_[id];
+        const Node& a = nodes_[node.child_a];
+        const Node& b = nodes_[node.child_b];
+        node.height = 1 + std::max(a.height, b.height);
+        node.box = MATH::Aabb::Union(a.box, b.box);
+
+        id = node.parent;
+    }
+}
+
+int32_t DynamicAabbTree::Balance(int32_t ia)
+{
+    // Rotates the taller grandchild up when A's children differ in height by more than one.
+    Node& a = nodes_[ia];
+    if (a.IsLeaf() || a.height < 2)
+    {
+        return ia;
+    }
+
+    const int32_t ib = a.child_a;
+    const int32_t ic = a.child_b;
+    const int32_t balance = nodes_[ic].height - nodes_[ib].height;
+
+    const auto rotate_up = [&](int32_t i_up, int32_t i_other) {
+        Node& up = nodes_[i_up];
+        const int32_t i_f = up.child_a;
+        const int32_t i_g = up.child_b;
+
+        // Swap A and the promoted child.
+        up.child_a = ia;
+        up.parent = a.parent;
+        a.parent = i_up;
+
+        if (up.parent != kNullNode)
+        {
+            Node& p = nodes_[up.parent];
+            (p.child_a == ia ? p.child_a : p.child_b) = i_up;
+        }
+        else
+        {
+            root_ = i_up;
+        }
+
+        // Keep the taller grandchild under the promoted node, hand the shorter one to A.
+        const bool f_taller = nodes_[i_f].height > nodes_[i_g].height;
+        const int32_t keep = f_taller ? i_f : i_g;
+        const int32_t give = f_taller ? i_g : i_f;
+        up.child_b = keep;
+        (a.child_a == i_up ? a.child_a : a.child_b) = give;
+        nodes_[give].parent = ia;
+
+        a.box = MATH::Aabb::Union(nodes_[i_other].box, nodes_[give].box);
+        a.height = 1 + std::max(nodes_[i_other].height, nodes_[give].height);
+        up.box = MATH::Aabb::Union(a.box, nodes_[keep].box);
+        up.height = 1 + std::max(a.height, nodes_[keep].height);
+        return i_up;
+    };
+
+    if (balance > 1)
+    {
+        return rotate_up(ic, ib);
+    }
+    if (balance < -1)
+    {
+        return rotate_up(ib, ic);
+    }
+    return ia;
+}
+
+void DynamicAabbTree::InsertSorted(std::vector<std::pair<int32_t, float>>& out,
+                                   std::pair<int32_t, float> entry,
+                                   size_t k)
+{
+    const auto it = std::upper_bound(out.begin(), out.end(), entry, [](const auto& lhs, const auto& rhs) {
+        return lhs.second < rhs.second;
+    });
+    out.insert(it, entry);
+    if (out.size() > k)
+    {
+        out.pop_back();
+    }
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,268 @@
+#include "ZokataEngine/systems/spatial/SceneSpatialIndex.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "ZokataEngine/systems/scene/Entity.h"
+#include "ZokataEngine/systems/scene/components/MeshComponent.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+void SceneSpatialIndex::Register(Entity& entity)
+{
+    if (record_of_.contains(&entity))
+    {
+        return;
+    }
+
+    Record record {};
+    record.entity = &entity;
+    record.world_bounds = ComputeWorldBounds(entity);
+    record.has_mesh = HasMeshBounds(entity);
+    mesh_count_ += record.has_mesh ? 1U : 0U;
+    const auto index = static_cast<uint32_t>(records_.size());
+    record.proxy = tree_.CreateProxy(record.world_bounds, index);
+    records_.push_back(record);
+    record_of_.emplace(&entity, index);
+}
+
+void SceneSpatialIndex::Unregister(Entity& entity)
+{
+    const auto it = record_of_.find(&entity);
+    if (it == record_of_.end())
+    {
+        return;
+    }
+
+    const uint32_t index = it->second;
+    mesh_count_ -= records_[index].has_mesh ? 1U : 0U;
+    tree_.DestroyProxy(records_[index].proxy);
+    record_of_.erase(it);
+
+    // Swap-remove to keep records dense; retarget the moved record's proxy.
+    const auto last = static_cast<uint32_t>(records_.size() - 1);
+    if (index != last)
+    {
+        records_[index] = records_[last];
+        record_of_[records_[index].entity] = index;
+        tree_.SetUserData(records_[index].proxy, index);
+    }
+    records_.pop_back();
+}
+
+void SceneSpatialIndex::OnTransformsChanged(std::span<Entity* const> entities)
+{
+    for (Entity* entity : entities)
+    {
+        if (const auto it = record_of_.find(entity); it != record_of_.end())
+        {
+            UpdateRecord(records_[it->second]);
+        }
+    }
+}
+
+void SceneSpatialIndex::Refresh(Entity& entity)
+{
+    if (const auto it = record_of_.find(&entity); it != record_of_.end())
+    {
+        UpdateRecord(records_[it->second]);
+    }
+}
+
+MATH::Aabb SceneSpatialIndex::WorldBounds(const Entity& entity) const
+{
+    const auto it = record_of_.find(&entity);
+    return it == record_of_.end() ? MATH::Aabb{} : records_[it->second].world_bounds;
+}
+
+std::optional<SpatialRaycastHit> SceneSpatialIndex::Raycast(const MATH::Ray& ray, float max_distance) const
+{
+    std::optional<SpatialRaycastHit> best;
+    const MATH::Vec3f inv_dir = MATH::SafeReciprocal(ray.direction);
+
+    tree_.Raycast(ray, max_distance, [&](int32_t proxy, const MATH::Ray& r, float max_t) {
+        const Record& record = records_[tree_.UserData(proxy)];
+        float t = 0.0F;
+        if (!record.world_bounds.IntersectRay(r.origin, inv_dir, max_t, t))
+        {
+            return max_t;
+        }
+        best = SpatialRaycastHit{record.entity, t, r.At(t)};
+        return t;
+    });
+    return best;
+}
+
+void SceneSpatialIndex::RaycastAll(const MATH::Ray& ray, float max_distance, std::vector<SpatialRaycastHit>& out) const
+{
+    out.clear();
+    const MATH::Vec3f inv_dir = MATH::SafeReciprocal(ray.direction);
+
+    tree_.Raycast(ray, max_distance, [&](int32_t proxy, const MATH::Ray& r, float max_t) {
+        const Record& record = records_[tree_.UserData(proxy)];
+        float t = 0.0F;
+        if (record.world_bounds.IntersectRay(r.origin, inv_dir, max_t, t))
+        {
+            out.push_back(SpatialRaycastHit{record.entity, t, r.At(t)});
+        }
+        return max_t;
+    });
+
+    std::sort(out.begin(), out.end(), [](const SpatialRaycastHit& a, const SpatialRaycastHit& b) {
+        return a.distance < b.distance;
+    });
+}
+
+void SceneSpatialIndex::OverlapBox(const MATH::Aabb& box, std::vector<Entity*>& out) const
+{
+    out.clear();
+    tree_.QueryOverlap(box, [&](int32_t proxy) {
+        const Record& record = records_[tree_.UserData(proxy)];
+        if (record.world_bounds.Overlaps(box))
+        {
+            out.push_back(record.entity);
+        }
+        return true;
+    });
+}
+
+void SceneSpatialIndex::OverlapSphere(const MATH::Sphere& sphere, std::vector<Entity*>& out) const
+{
+    out.clear();
+    tree_.QueryOverlap(sphere, [&](int32_t proxy) {
+        const Record& record = records_[tree_.UserData(proxy)];
+        if (record.world_bounds.Overlaps(sphere))
+        {
+            out.push_back(record.entity);
+        }
+        return true;
+    });
+}
+
+void SceneSpatialIndex::OverlapFrustum(const MATH::Frustum& frustum, std::vector<Entity*>& out) const
+{
+    out.clear();
+    tree_.QueryOverlap(frustum, [&](int32_t proxy) {
+        const Record& record = records_[tree_.UserData(proxy)];
+        if (frustum.Intersects(record.world_bounds))
+        {
+            out.push_back(record.entity);
+        }
+        return true;
+    });
+}
+
+void SceneSpatialIndex::OverlapFrustums(
+    std::span<const MATH::Frustum> frustums, std::vector<SpatialViewHit>& out) const
+{
+    out.clear();
+    tree_.QueryFrustums(frustums, ~0U, [&](int32_t proxy, uint32_t view_mask) {
+        // The tree tested fat boxes; refine each surviving view against the tight bounds.
+        const Record& record = records_[tree_.UserData(proxy)];
+        uint32_t mask = 0;
+        for (uint32_t pending = view_mask; pending != 0; pending &= pending - 1)
+        {
+            const auto view = static_cast<uint32_t>(std::countr_zero(pending));
+            if (frustums[view].Intersects(record.world_bounds))
+            {
+                mask |= 1U << view;
+            }
+        }
+        if (mask != 0)
+        {
+            out.push_back(SpatialViewHit{record.entity, mask, record.has_mesh});
+        }
+        return true;
+    });
+}
+
+void SceneSpatialIndex::Nearest(const MATH::Vec3f& point, size_t k, float max_distance, std::vector<Entity*>& out) const
+{
+    out.clear();
+    std::vector<std::pair<int32_t, float>> found;
+    tree_.QueryNearest(
+        point,
+        k,
+        max_distance,
+        [&](int32_t proxy) { return records_[tree_.UserData(proxy)].world_bounds.DistanceSquared(point); },
+        found);
+
+    out.reserve(found.size());
+    for (const auto& [proxy, distance_sq] : found)
+    {
+        out.push_back(records_[tree_.UserData(proxy)].entity);
+    }
+}
+
+void SceneSpatialIndex::RaycastBatch(std::span<const MATH::Ray> rays,
+                                     float max_distance,
+                                     std::span<std::optional<SpatialRaycastHit>> hits) const
+{
+    const size_t count = std::min(rays.size(), hits.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        hits[i] = Raycast(rays[i], max_distance);
+    }
+}
+
+void SceneSpatialIndex::OverlapSphereBatch(std::span<const MATH::Sphere> spheres,
+                                           std::span<std::vector<Entity*>> results) const
+{
+    const size_t count = std::min(spheres.size(), results.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        OverlapSphere(spheres[i], results[i]);
+    }
+}
+
+const DynamicAabbTree& SceneSpatialIndex::Tree() const
+{
+    return tree_;
+}
+
+size_t SceneSpatialIndex::Size() const
+{
+    return records_.size();
+}
+
+size_t SceneSpatialIndex::MeshCount() const
+{
+    return mesh_count_;
+}
+
+bool SceneSpatialIndex::HasMeshBounds(const Entity& entity)
+{
+    const auto* mesh = entity.GetComponent<MeshComponent>();
+    return mesh != nullptr && mesh->LocalBounds().Valid();
+}
+
+MATH::Aabb SceneSpatialIndex::ComputeWorldBounds(const Entity& entity)
+{
+    const TransformComponent& transform = entity.Transform();
+    if (const auto* mesh = entity.GetComponent<MeshComponent>())
+    {
+        const MATH::Aabb& local = mesh->LocalBounds();
+        if (local.Valid())
+        {
+            return local.Transformed(transform.GetModelMatrix());
+        }
+    }
+
+    const MATH::Vec3f& p = transform.WorldPosition();
+    return {p, p};
+}
+
+void SceneSpatialIndex::UpdateRecord(Record& record)
+{
+    const MATH::Aabb bounds = ComputeWorldBounds(*record.entity);
+    const MATH::Vec3f displacement = bounds.Center() - record.world_bounds.Center();
+    record.world_bounds = bounds;
+    const bool has_mesh = HasMeshBounds(*record.entity);
+    mesh_count_ = mesh_count_ - (record.has_mesh ? 1U : 0U) + (has_mesh ? 1U : 0U);
+    record.has_mesh = has_mesh;
+    tree_.MoveProxy(record.proxy, bounds, displacement);
+}
+}  // namespace ENGINE
+}  // namespace ZKT
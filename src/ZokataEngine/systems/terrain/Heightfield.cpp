@@ -0,0 +1,86 @@
+#include "ZokataEngine/systems/terrain/Heightfield.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ZKT
+{
+namespace ENGINE
+{
+Heightfield::Heightfield(uint32_t width, uint32_t depth, std::vector<float> heights)
+    : width_(width)
+    , depth_(depth)
+    , heights_(std::move(heights))
+{
+    if (width_ < 2 || depth_ < 2)
+    {
+        throw std::runtime_error("Heightfield needs at least 2x2 samples.");
+    }
+    if (heights_.size() != static_cast<size_t>(width_) * depth_)
+    {
+        throw std::runtime_error("Heightfield sample count does not match its dimensions.");
+    }
+}
+
+Heightfield Heightfield::LoadRaw16(const std::filesystem::path& path, uint32_t width, uint32_t depth)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open heightmap: " + path.string());
+    }
+    const size_t count = static_cast<size_t>(width) * depth;
+    std::vector<uint8_t> bytes(count * 2);
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+    {
+        throw std::runtime_error("Heightmap is smaller than " + std::to_string(width) + "x" + std::to_string(depth)
+                                 + " 16-bit samples: " + path.string());
+    }
+
+    std::vector<float> heights(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto value = static_cast<uint16_t>(bytes[i * 2] | (bytes[i * 2 + 1] << 8));
+        heights[i] = static_cast<float>(value) / 65535.0F;
+    }
+    return Heightfield(width, depth, std::move(heights));
+}
+
+uint32_t Heightfield::Width() const
+{
+    return width_;
+}
+
+uint32_t Heightfield::Depth() const
+{
+    return depth_;
+}
+
+float Heightfield::At(int32_t x, int32_t z) const
+{
+    const auto cx = static_cast<size_t>(std::clamp<int32_t>(x, 0, static_cast<int32_t>(width_) - 1));
+    const auto cz = static_cast<size_t>(std::clamp<int32_t>(z, 0, static_cast<int32_t>(depth_) - 1));
+    return heights_[cz * width_ + cx];
+}
+
+float Heightfield::Sample(float u, float v) const
+{
+    const float x = std::clamp(u, 0.0F, 1.0F) * static_cast<float>(width_ - 1);
+    const float z = std::clamp(v, 0.0F, 1.0F) * static_cast<float>(depth_ - 1);
+    const float x0 = std::floor(x);
+    const float z0 = std::floor(z);
+    const float fx = x - x0;
+    const float fz = z - z0;
+    const auto ix = static_cast<int32_t>(x0);
+    const auto iz = static_cast<int32_t>(z0);
+
+    const float top = At(ix, iz) + (At(ix + 1, iz) - At(ix, iz)) * fx;
+    const float bottom = At(ix, iz + 1) + (At(ix + 1, iz + 1) - At(ix, iz + 1)) * fx;
+    return top + (bottom - top) * fz;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,90 @@
+#include "ZokataEngine/systems/terrain/TerrainSystem.h"
+
+#include <imgui.h>
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/scene/Entity.h"
+#include "ZokataEngine/systems/scene/Scene.h"
+#include "ZokataEngine/systems/scene/components/TerrainComponent.h"
+#include "ZokataEngine/systems/scene/components/TransformComponent.h"
+#include "ZokataMath/Quaternion.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+TerrainSystem::TerrainSystem(JobSystem& jobs)
+    : jobs_(jobs)
+{
+}
+
+void TerrainSystem::Update(Scene& scene, const MATH::Vec3f& camera_position)
+{
+    draws_.clear();
+    stats_ = TerrainStats {};
+    terrains_ = 0;
+    for (Entity* entity : scene.AllRuntimeEntities())
+    {
+        auto* terrain = entity->GetComponent<TerrainComponent>();
+        if (terrain == nullptr || !terrain->Enabled() || !terrain->GetHeightfield())
+        {
+            continue;
+        }
+
+        // Only the position is applied; see TerrainComponent.
+        const MATH::Vec3f origin = entity->Transform().WorldPosition();
+        const MATH::Vec3f camera {
+            camera_position.x - origin.x, camera_position.y - origin.y, camera_position.z - origin.z};
+        TerrainTree& tree = terrain->Tree();
+        tree.Update(terrain->GetHeightfield(), terrain->Settings(), terrain->Material(), camera, jobs_);
+        ++terrains_;
+
+        const MATH::Mat4f model = MATH::Mat4f::FromTRS(origin, MATH::Quaternion {}, MATH::Vec3f {1.0F, 1.0F, 1.0F});
+        for (const TerrainChunk* chunk : tree.Selected())
+        {
+            draws_.push_back(ExternalDraw{chunk, model, chunk->LocalBounds().Transformed(model)});
+        }
+
+        const TerrainStats& stats = tree.Stats();
+        stats_.resident += stats.resident;
+        stats_.pending += stats.pending;
+        stats_.selected += stats.selected;
+        stats_.evicted += stats.evicted;
+        stats_.triangles += stats.triangles;
+        stats_.bytes += stats.bytes;
+    }
+}
+
+void TerrainSystem::Reset()
+{
+    draws_.clear();
+}
+
+std::span<const ExternalDraw> TerrainSystem::Draws() const
+{
+    return draws_;
+}
+
+const TerrainStats& TerrainSystem::Stats() const
+{
+    return stats_;
+}
+
+void TerrainSystem::DrawDebugGui()
+{
+    if (!ImGui::Begin("Terrain"))
+    {
+        ImGui::End();
+        return;
+    }
+    ImGui::Text("Terrains: %u", terrains_);
+    ImGui::Text("Chunks drawn: %u", stats_.selected);
+    ImGui::Text("Chunks resident: %u", stats_.resident);
+    ImGui::Text("Chunks building: %u", stats_.pending);
+    ImGui::Text("Evicted this frame: %u", stats_.evicted);
+    ImGui::Text("Triangles: %llu", static_cast<unsigned long long>(stats_.triangles));
+    ImGui::Text("Geometry: %.1f MiB", static_cast<double>(stats_.bytes) / (1024.0 * 1024.0));
+    ImGui::End();
+}
+}  // namespace ENGINE
+}  // namespace ZKT
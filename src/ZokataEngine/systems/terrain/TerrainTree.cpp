@@ -0,0 +1,599 @@
+#include "ZokataEngine/systems/terrain/TerrainTree.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint32_t kMaxDepth = 20;
+constexpr uint64_t kRootKey = 0;
+
+uint64_t NodeKey(uint32_t level, uint32_t x, uint32_t z)
+{
+    return (static_cast<uint64_t>(level) << 58) | (static_cast<uint64_t>(x) << 29) | z;
+}
+
+uint32_t KeyLevel(uint64_t key)
+{
+    return static_cast<uint32_t>(key >> 58);
+}
+
+uint32_t KeyX(uint64_t key)
+{
+    return static_cast<uint32_t>((key >> 29) & ((1ULL << 29) - 1));
+}
+
+uint32_t KeyZ(uint64_t key)
+{
+    return static_cast<uint32_t>(key & ((1ULL << 29) - 1));
+}
+
+size_t GeometryBytes(const MeshGeometry& geometry)
+{
+    return geometry.vertices.size() * sizeof(MeshVertex) + geometry.indices.size() * sizeof(uint32_t);
+}
+
+float DistanceToBox(const MATH::Vec3f& p, const MATH::Aabb& box)
+{
+    const float dx = std::max({box.min.x - p.x, 0.0F, p.x - box.max.x});
+    const float dy = std::max({box.min.y - p.y, 0.0F, p.y - box.max.y});
+    const float dz = std::max({box.min.z - p.z, 0.0F, p.z - box.max.z});
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+MATH::Aabb ComputeBounds(const MeshGeometry& geometry)
+{
+    MATH::Aabb bounds {};
+    for (const MeshVertex& vertex : geometry.vertices)
+    {
+        bounds.Expand(vertex.position);
+    }
+    return bounds;
+}
+
+// Runs on workers: samples the node's grid, then appends one skirt vertex per edge vertex,
+// lowered by the chunk's simplification error so seams against coarser chunks stay closed.
+std::shared_ptr<MeshGeometry> BuildChunkGeometry(
+    const Heightfield& heightfield,
+    const TerrainSettings& settings,
+    const std::vector<uint32_t>& indices,
+    uint32_t level,
+    uint32_t x,
+    uint32_t z)
+{
+    const uint32_t n = settings.chunk_resolution;
+    const float half = settings.size * 0.5F;
+    const float node_size = settings.size / static_cast<float>(1U << level);
+    const float step = node_size / static_cast<float>(n - 1);
+    const float x0 = -half + static_cast<float>(x) * node_size;
+    const float z0 = -half + static_cast<float>(z) * node_size;
+    const auto height = [&](float lx, float lz) {
+        return heightfield.Sample((lx + half) / settings.size, (lz + half) / settings.size) * settings.height_scale;
+    };
+
+    auto geometry = std::make_shared<MeshGeometry>();
+    std::vector<MeshVertex>& vertices = geometry->vertices;
+    vertices.resize(static_cast<size_t>(n) * n + 4ULL * n);
+    for (uint32_t j = 0; j < n; ++j)
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const float lx = x0 + static_cast<float>(i) * step;
+            const float lz = z0 + static_cast<float>(j) * step;
+            // Central differences through the heightfield, so normals agree across chunk edges.
+            const float slope_x = (height(lx + step, lz) - height(lx - step, lz)) / (2.0F * step);
+            const float slope_z = (height(lx, lz + step) - height(lx, lz - step)) / (2.0F * step);
+
+            MeshVertex& vertex = vertices[static_cast<size_t>(j) * n + i];
+            vertex.position = MATH::Vec3f{lx, height(lx, lz), lz};
+            vertex.normal = MATH::Vec3f{-slope_x, 1.0F, -slope_z}.Normalized();
+            vertex.uv = MATH::Vec2f{(lx + half) / settings.size, (lz + half) / settings.size};
+            vertex.tangent = MATH::Vec3f{1.0F, slope_x, 0.0F}.Normalized();
+        }
+    }
+
+    // Largest height change from dropping every other vertex, i.e. the error against the
+    // parent level; coarse triangles split along the same diagonal as fine ones.
+    const auto h = [&](uint32_t i, uint32_t j) { return vertices[static_cast<size_t>(j) * n + i].position.y; };
+    float error = 0.0F;
+    for (uint32_t j = 0; j < n; ++j)
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const bool odd_i = (i & 1U) != 0;
+            const bool odd_j = (j & 1U) != 0;
+            float coarse = h(i, j);
+            if (odd_i && odd_j)
+            {
+                coarse = 0.5F * (h(i - 1, j + 1) + h(i + 1, j - 1));
+            }
+            else if (odd_i)
+            {
+                coarse = 0.5F * (h(i - 1, j) + h(i + 1, j));
+            }
+            else if (odd_j)
+            {
+                coarse = 0.5F * (h(i, j - 1) + h(i, j + 1));
+            }
+            error = std::max(error, std::abs(h(i, j) - coarse));
+        }
+    }
+    const float skirt_depth = 2.0F * error + 0.25F * step;
+
+    for (uint32_t edge = 0; edge < 4; ++edge)
+    {
+        for (uint32_t k = 0; k < n; ++k)
+        {
+            const uint32_t i = edge == 0 ? 0 : (edge == 1 ? n - 1 : k);
+            const uint32_t j = edge == 2 ? 0 : (edge == 3 ? n - 1 : k);
+            MeshVertex skirt = vertices[static_cast<size_t>(j) * n + i];
+            skirt.position.y -= skirt_depth;
+            vertices[static_cast<size_t>(n) * n + edge * n + k] = skirt;
+        }
+    }
+
+    geometry->indices = indices;
+    return geometry;
+}
+}  // namespace
+
+TerrainChunk::TerrainChunk(GeometryHandle geometry, const MaterialDescriptor* material, const MATH::Aabb& bounds)
+    : geometry_(std::move(geometry))
+    , material_(material)
+    , bounds_(bounds)
+{
+}
+
+const MeshGeometry& TerrainChunk::Geometry() const
+{
+    return *geometry_;
+}
+
+const MaterialDescriptor& TerrainChunk::Material() const
+{
+    return *material_;
+}
+
+const GeometryHandle& TerrainChunk::SharedGeometry() const
+{
+    return geometry_;
+}
+
+void TerrainChunk::SetGeometry(GeometryHandle geometry)
+{
+    geometry_ = std::move(geometry);
+}
+
+const MATH::Aabb& TerrainChunk::LocalBounds() const
+{
+    return bounds_;
+}
+
+TerrainTree::~TerrainTree()
+{
+    Reset();
+}
+
+TerrainTree::StitchVariants TerrainTree::BuildStitchVariants(uint32_t resolution)
+{
+    const uint32_t n = resolution;
+    const auto grid = [n](uint32_t i, uint32_t j) { return j * n + i; };
+
+    StitchVariants variants;
+    for (uint32_t mask = 0; mask < 16; ++mask)
+    {
+        // Odd vertices on a stitched edge collapse onto their lower even neighbour, so that
+        // edge matches the coarser chunk's vertices exactly.
+        const auto remap = [n, mask, &grid](uint32_t i, uint32_t j) {
+            if ((mask & 1U) != 0 && i == 0 && (j & 1U) != 0)
+            {
+                --j;
+            }
+            if ((mask & 2U) != 0 && i == n - 1 && (j & 1U) != 0)
+            {
+                --j;
+            }
+            if ((mask & 4U) != 0 && j == 0 && (i & 1U) != 0)
+            {
+                --i;
+            }
+            if ((mask & 8U) != 0 && j == n - 1 && (i & 1U) != 0)
+            {
+                --i;
+            }
+            return grid(i, j);
+        };
+
+        std::vector<uint32_t>& indices = variants[mask];
+        indices.reserve(static_cast<size_t>(n - 1) * (n - 1) * 6 + 4ULL * (n - 1) * 6);
+        const auto emit = [&indices](uint32_t a, uint32_t b, uint32_t c) {
+            if (a != b && b != c && a != c)
+            {
+                indices.insert(indices.end(), {a, b, c});
+            }
+        };
+
+        for (uint32_t j = 0; j + 1 < n; ++j)
+        {
+            for (uint32_t i = 0; i + 1 < n; ++i)
+            {
+                const uint32_t a = remap(i, j);
+                const uint32_t b = remap(i, j + 1);
+                const uint32_t c = remap(i + 1, j);
+                const uint32_t d = remap(i + 1, j + 1);
+                // With both +X and +Z stitched, the usual diagonal would leave a T-junction
+                // at the last interior vertex, so that cell is split along the other one.
+                if (i + 2 == n && j + 2 == n && (mask & 2U) != 0 && (mask & 8U) != 0)
+                {
+                    emit(a, b, d);
+                    emit(a, d, c);
+                }
+                else
+                {
+                    emit(a, b, c);
+                    emit(c, b, d);
+                }
+            }
+        }
+
+        constexpr int32_t kOutward[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        for (uint32_t edge = 0; edge < 4; ++edge)
+        {
+            const bool stitched = (mask & (1U << edge)) != 0;
+            const auto position = [n, edge](uint32_t k) {
+                const uint32_t i = edge == 0 ? 0 : (edge == 1 ? n - 1 : k);
+                const uint32_t j = edge == 2 ? 0 : (edge == 3 ? n - 1 : k);
+                return std::pair<uint32_t, uint32_t>{i, j};
+            };
+            for (uint32_t k = 0; k + 1 < n; ++k)
+            {
+                const uint32_t ka = stitched && (k & 1U) != 0 ? k - 1 : k;
+                const uint32_t kb = stitched && ((k + 1) & 1U) != 0 ? k : k + 1;
+                if (ka == kb)
+                {
+                    continue;
+                }
+                const auto [ia, ja] = position(ka);
+                const auto [ib, jb] = position(kb);
+                const uint32_t a = grid(ia, ja);
+                const uint32_t b = grid(ib, jb);
+                const uint32_t a_skirt = n * n + edge * n + ka;
+                const uint32_t b_skirt = n * n + edge * n + kb;
+
+                // (a, a_skirt, b) faces (-dz, 0, dx) for the edge direction d = b - a.
+                const int32_t dx = static_cast<int32_t>(ib) - static_cast<int32_t>(ia);
+                const int32_t dz = static_cast<int32_t>(jb) - static_cast<int32_t>(ja);
+                if (-dz * kOutward[edge][0] + dx * kOutward[edge][1] > 0)
+                {
+                    emit(a, a_skirt, b);
+                    emit(b, a_skirt, b_skirt);
+                }
+                else
+                {
+                    emit(a, b, a_skirt);
+                    emit(b, b_skirt, a_skirt);
+                }
+            }
+        }
+    }
+    return variants;
+}
+
+void TerrainTree::Update(
+    const std::shared_ptr<const Heightfield>& heightfield,
+    const TerrainSettings& settings,
+    const MaterialDescriptor& material,
+    const MATH::Vec3f& camera,
+    JobSystem& jobs)
+{
+    if (heightfield != heightfield_ || !(settings == settings_) || variants_ == nullptr)
+    {
+        Reset();
+        const uint32_t resolution = settings.chunk_resolution;
+        if (resolution < 3 || ((resolution - 1) & (resolution - 2)) != 0)
+        {
+            throw std::runtime_error("Terrain chunk_resolution must be 2^n + 1.");
+        }
+        heightfield_ = heightfield;
+        settings_ = settings;
+        settings_.max_depth = std::min(settings_.max_depth, kMaxDepth);
+        variants_ = std::make_shared<const StitchVariants>(BuildStitchVariants(resolution));
+        chunk_bytes_ = (static_cast<size_t>(resolution) * resolution + 4ULL * resolution) * sizeof(MeshVertex)
+            + variants_->front().size() * sizeof(uint32_t);
+    }
+    material_ = &material;
+    ++frame_;
+    stats_.evicted = 0;
+    if (heightfield_ == nullptr)
+    {
+        selected_.clear();
+        return;
+    }
+
+    // The root is built synchronously once, so there is always something to draw.
+    if (!IsResident(kRootKey))
+    {
+        Node& root = nodes_[kRootKey];
+        auto geometry = BuildNow(0, 0, 0);
+        const MATH::Aabb bounds = ComputeBounds(*geometry);
+        stats_.bytes += GeometryBytes(*geometry);
+        root.chunk = std::make_unique<TerrainChunk>(std::move(geometry), material_, bounds);
+        root.pending = false;
+    }
+
+    CollectFinishedBuilds();
+
+    selected_keys_.clear();
+    requests_.clear();
+    Select(0, 0, 0, camera);
+    ApplyStitching();
+    Evict();
+    SubmitRequests(jobs);
+
+    selected_.clear();
+    stats_.triangles = 0;
+    for (const uint64_t key : selected_keys_)
+    {
+        const TerrainChunk* chunk = nodes_.at(key).chunk.get();
+        selected_.push_back(chunk);
+        stats_.triangles += chunk->Geometry().TriangleCount();
+    }
+    stats_.selected = static_cast<uint32_t>(selected_.size());
+    stats_.resident = 0;
+    stats_.pending = 0;
+    for (const auto& [key, node] : nodes_)
+    {
+        stats_.resident += node.chunk != nullptr ? 1U : 0U;
+        stats_.pending += node.pending ? 1U : 0U;
+    }
+}
+
+void TerrainTree::Reset()
+{
+    for (auto& [key, node] : nodes_)
+    {
+        if (node.chunk && release_)
+        {
+            release_(node.chunk->Geometry());
+        }
+    }
+    // Pending builds finish on their worker and are discarded with their futures.
+    nodes_.clear();
+    selected_keys_.clear();
+    selected_.clear();
+    variants_.reset();
+    heightfield_.reset();
+    stats_ = TerrainStats {};
+}
+
+const std::vector<const TerrainChunk*>& TerrainTree::Selected() const
+{
+    return selected_;
+}
+
+const TerrainStats& TerrainTree::Stats() const
+{
+    return stats_;
+}
+
+void TerrainTree::SetReleaseCallback(ReleaseCallback callback)
+{
+    release_ = std::move(callback);
+}
+
+void TerrainTree::CollectFinishedBuilds()
+{
+    for (auto& [key, node] : nodes_)
+    {
+        if (!node.pending || node.build.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            continue;
+        }
+        std::shared_ptr<MeshGeometry> geometry = node.build.get();
+        const MATH::Aabb bounds = ComputeBounds(*geometry);
+        stats_.bytes += GeometryBytes(*geometry);
+        node.chunk = std::make_unique<TerrainChunk>(std::move(geometry), material_, bounds);
+        node.stitch_mask = 0;
+        node.pending = false;
+    }
+}
+
+void TerrainTree::Select(uint32_t level, uint32_t x, uint32_t z, const MATH::Vec3f& camera)
+{
+    const uint64_t key = NodeKey(level, x, z);
+    nodes_.at(key).last_used = frame_;
+
+    const float node_size = settings_.size / static_cast<float>(1U << level);
+    if (level < settings_.max_depth && DistanceToBox(camera, NodeBounds(level, x, z)) < node_size * settings_.lod_distance)
+    {
+        bool children_ready = true;
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            const uint32_t cx = x * 2 + (c & 1U);
+            const uint32_t cz = z * 2 + (c >> 1);
+            if (!IsResident(NodeKey(level + 1, cx, cz)))
+            {
+                children_ready = false;
+                RequestBuild(level + 1, cx, cz, camera);
+            }
+        }
+        if (children_ready)
+        {
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                Select(level + 1, x * 2 + (c & 1U), z * 2 + (c >> 1), camera);
+            }
+            return;
+        }
+    }
+    selected_keys_.push_back(key);
+}
+
+bool TerrainTree::IsResident(uint64_t key) const
+{
+    const auto it = nodes_.find(key);
+    return it != nodes_.end() && it->second.chunk != nullptr;
+}
+
+void TerrainTree::RequestBuild(uint32_t level, uint32_t x, uint32_t z, const MATH::Vec3f& camera)
+{
+    const uint64_t key = NodeKey(level, x, z);
+    const auto it = nodes_.find(key);
+    if (it != nodes_.end())
+    {
+        it->second.last_used = frame_;  // keep in-flight builds from being treated as stale
+        if (it->second.pending)
+        {
+            return;
+        }
+    }
+    requests_.push_back(BuildRequest{key, level, DistanceToBox(camera, NodeBounds(level, x, z))});
+}
+
+void TerrainTree::SubmitRequests(JobSystem& jobs)
+{
+    std::sort(requests_.begin(), requests_.end(), [](const auto& a, const auto& b) {
+        return a.level != b.level ? a.level < b.level : a.distance < b.distance;
+    });
+
+    uint32_t in_flight = 0;
+    for (const auto& [key, node] : nodes_)
+    {
+        in_flight += node.pending ? 1U : 0U;
+    }
+    for (const auto& request : requests_)
+    {
+        if (in_flight >= settings_.max_builds_in_flight
+            || stats_.bytes + static_cast<size_t>(in_flight + 1) * chunk_bytes_ > settings_.memory_budget)
+        {
+            break;
+        }
+        Node& node = nodes_[request.key];
+        node.pending = true;
+        node.last_used = frame_;
+        node.build = jobs.Submit([heightfield = heightfield_,
+                                  settings = settings_,
+                                  variants = variants_,
+                                  level = request.level,
+                                  x = KeyX(request.key),
+                                  z = KeyZ(request.key)]() {
+            return BuildChunkGeometry(*heightfield, settings, variants->front(), level, x, z);
+        });
+        ++in_flight;
+    }
+}
+
+void TerrainTree::ApplyStitching()
+{
+    const std::unordered_set<uint64_t> selected(selected_keys_.begin(), selected_keys_.end());
+    for (const uint64_t key : selected_keys_)
+    {
+        const uint32_t level = KeyLevel(key);
+        const uint32_t x = KeyX(key);
+        const uint32_t z = KeyZ(key);
+        const uint32_t last = (1U << level) - 1;
+
+        uint8_t mask = 0;
+        if (level > 0)
+        {
+            // A neighbour one level coarser is drawn by the parent of the same-level cell.
+            const auto coarser = [&](uint32_t nx, uint32_t nz) {
+                return selected.contains(NodeKey(level - 1, nx >> 1, nz >> 1));
+            };
+            mask |= (x > 0 && coarser(x - 1, z)) ? 1U : 0U;
+            mask |= (x < last && coarser(x + 1, z)) ? 2U : 0U;
+            mask |= (z > 0 && coarser(x, z - 1)) ? 4U : 0U;
+            mask |= (z < last && coarser(x, z + 1)) ? 8U : 0U;
+        }
+
+        Node& node = nodes_.at(key);
+        if (mask == node.stitch_mask)
+        {
+            continue;
+        }
+        const MeshGeometry& current = node.chunk->Geometry();
+        auto stitched = std::make_shared<MeshGeometry>();
+        stitched->vertices = current.vertices;
+        stitched->indices = (*variants_)[mask];
+        stats_.bytes = stats_.bytes - GeometryBytes(current) + GeometryBytes(*stitched);
+        if (release_)
+        {
+            release_(current);
+        }
+        node.chunk->SetGeometry(std::move(stitched));
+        node.stitch_mask = mask;
+    }
+}
+
+void TerrainTree::Evict()
+{
+    if (stats_.bytes <= settings_.memory_budget)
+    {
+        return;
+    }
+    // Anything touched this frame is drawn, an ancestor of a drawn chunk, or being built.
+    std::vector<std::pair<uint64_t, uint64_t>> candidates;  // last_used, key
+    for (const auto& [key, node] : nodes_)
+    {
+        if (node.chunk != nullptr && !node.pending && node.last_used != frame_ && key != kRootKey)
+        {
+            candidates.emplace_back(node.last_used, key);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& [last_used, key] : candidates)
+    {
+        if (stats_.bytes <= settings_.memory_budget)
+        {
+            break;
+        }
+        Release(nodes_.at(key));
+        nodes_.erase(key);
+        ++stats_.evicted;
+    }
+}
+
+void TerrainTree::Release(Node& node)
+{
+    if (node.chunk == nullptr)
+    {
+        return;
+    }
+    stats_.bytes -= GeometryBytes(node.chunk->Geometry());
+    if (release_)
+    {
+        release_(node.chunk->Geometry());
+    }
+    node.chunk.reset();
+}
+
+MATH::Aabb TerrainTree::NodeBounds(uint32_t level, uint32_t x, uint32_t z) const
+{
+    const auto it = nodes_.find(NodeKey(level, x, z));
+    if (it != nodes_.end() && it->second.chunk != nullptr)
+    {
+        return it->second.chunk->LocalBounds();
+    }
+    const float half = settings_.size * 0.5F;
+    const float node_size = settings_.size / static_cast<float>(1U << level);
+    const float x0 = -half + static_cast<float>(x) * node_size;
+    const float z0 = -half + static_cast<float>(z) * node_size;
+    return MATH::Aabb{{x0, 0.0F, z0}, {x0 + node_size, settings_.height_scale, z0 + node_size}};
+}
+
+std::shared_ptr<MeshGeometry> TerrainTree::BuildNow(uint32_t level, uint32_t x, uint32_t z) const
+{
+    return BuildChunkGeometry(*heightfield_, settings_, variants_->front(), level, x, z);
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,710 @@
+#include "ZokataEngine/systems/texture/BlockCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ZKT_TEXTURE_SSE2 1
+#endif
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+constexpr uint32_t kTexels = 16;
+constexpr float kMaxError = std::numeric_limits<float>::max();
+
+// Texels of one block by channel, so palette searches load four texels per register.
+struct BlockTexels
+{
+    alignas(16) float channel[4][kTexels];
+};
+
+// Decoded colors an index can select, in the texels' 0-255 scale.
+struct Palette
+{
+    float color[16][4] {};
+    uint32_t size = 0;
+};
+
+void LoadBlock(const uint8_t* rgba, BlockTexels& block)
+{
+    for (uint32_t texel = 0; texel < kTexels; ++texel)
+    {
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            block.channel[c][texel] = static_cast<float>(rgba[texel * 4 + c]);
+        }
+    }
+}
+
+bool IsSolid(const uint8_t* rgba, uint32_t channels)
+{
+    for (uint32_t texel = 1; texel < kTexels; ++texel)
+    {
+        if (std::memcmp(rgba, rgba + texel * 4, channels) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Stores the nearest palette entry over channels [first, first + count) for every texel
+ *        and returns the summed squared error.
+ */
+float SelectIndices(const BlockTexels& block, const Palette& palette, uint32_t first, uint32_t count, uint8_t* indices)
+{
+    float total = 0.0F;
+#ifdef ZKT_TEXTURE_SSE2
+    for (uint32_t group = 0; group < kTexels; group += 4)
+    {
+        __m128 texels[4];
+        for (uint32_t c = 0; c < count; ++c)
+        {
+            texels[c] = _mm_load_ps(block.channel[first + c] + group);
+        }
+        __m128 best = _mm_set1_ps(kMaxError);
+        __m128i best_index = _mm_setzero_si128();
+        for (uint32_t entry = 0; entry < palette.size; ++entry)
+        {
+            __m128 distance = _mm_setzero_ps();
+            for (uint32_t c = 0; c < count; ++c)
+            {
+                const __m128 diff = _mm_sub_ps(texels[c], _mm_set1_ps(palette.color[entry][first + c]));
+                distance = _mm_add_ps(distance, _mm_mul_ps(diff, diff));
+            }
+            const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(distance, best));
+            best = _mm_min_ps(distance, best);
+            best_index = _mm_or_si128(
+                _mm_and_si128(closer, _mm_set1_epi32(static_cast<int32_t>(entry))),
+                _mm_andnot_si128(closer, best_index));
+        }
+        alignas(16) int32_t lanes[4];
+        alignas(16) float errors[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), best_index);
+        _mm_store_ps(errors, best);
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            indices[group + lane] = static_cast<uint8_t>(lanes[lane]);
+            total += errors[lane];
+        }
+    }
+#else
+    for (uint32_t texel = 0; texel < kTexels; ++texel)
+    {
+        float best = kMaxError;
+        uint8_t best_index = 0;
+        for (uint32_t entry = 0; entry < palette.size; ++entry)
+        {
+            float distance = 0.0F;
+            for (uint32_t c = first; c < first + count; ++c)
+            {
+                const float diff = block.channel[c][texel] - palette.color[entry][c];
+                distance += diff * diff;
+            }
+            if (distance < best)
+            {
+                best = distance;
+                best_index = static_cast<uint8_t>(entry);
+            }
+        }
+        indices[texel] = best_index;
+        total += best;
+    }
+#endif
+    return total;
+}
+
+/**
+ * @brief Endpoints of the segment through the texels along their principal axis, clamped to
+ *        0-255; lo and hi coincide for a flat block.
+ */
+void FitPrincipalAxis(const BlockTexels& block, uint32_t channels, float lo[4], float hi[4])
+{
+    float mean[4] = {};
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        for (uint32_t texel = 0; texel < kTexels; ++texel)
+        {
+            mean[c] += block.channel[c][texel];
+        }
+        mean[c] /= static_cast<float>(kTexels);
+    }
+
+    float covariance[4][4] = {};
+    for (uint32_t texel = 0; texel < kTexels; ++texel)
+    {
+        for (uint32_t i = 0; i < channels; ++i)
+        {
+            const float di = block.channel[i][texel] - mean[i];
+            for (uint32_t j = i; j < channels; ++j)
+            {
+                covariance[i][j] += di * (block.channel[j][texel] - mean[j]);
+            }
+        }
+    }
+    uint32_t widest = 0;
+    for (uint32_t i = 0; i < channels; ++i)
+    {
+        for (uint32_t j = 0; j < i; ++j)
+        {
+            covariance[i][j] = covariance[j][i];
+        }
+        widest = covariance[i][i] > covariance[widest][widest] ? i : widest;
+    }
+
+    // Power iteration from the row of the widest channel, which is rarely orthogonal to the axis.
+    float axis[4] = {};
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        axis[c] = covariance[widest][c];
+    }
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        float next[4] = {};
+        float largest = 0.0F;
+        for (uint32_t i = 0; i < channels; ++i)
+        {
+            for (uint32_t j = 0; j < channels; ++j)
+            {
+                next[i] += covariance[i][j] * axis[j];
+            }
+            largest = std::max(largest, std::abs(next[i]));
+        }
+        if (largest < 1e-6F)
+        {
+            break;
+        }
+        for (uint32_t c = 0; c < channels; ++c)
+        {
+            axis[c] = next[c] / largest;
+        }
+    }
+    float length = 0.0F;
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        length += axis[c] * axis[c];
+    }
+    length = std::sqrt(length);
+
+    float t_min = 0.0F;
+    float t_max = 0.0F;
+    if (length > 1e-6F)
+    {
+        for (uint32_t c = 0; c < channels; ++c)
+        {
+            axis[c] /= length;
+        }
+        t_min = kMaxError;
+        t_max = -kMaxError;
+        for (uint32_t texel = 0; texel < kTexels; ++texel)
+        {
+            float t = 0.0F;
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                t += (block.channel[c][texel] - mean[c]) * axis[c];
+            }
+            t_min = std::min(t_min, t);
+            t_max = std::max(t_max, t);
+        }
+    }
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        lo[c] = std::clamp(mean[c] + axis[c] * t_min, 0.0F, 255.0F);
+        hi[c] = std::clamp(mean[c] + axis[c] * t_max, 0.0F, 255.0F);
+    }
+}
+
+/**
+ * @brief Least-squares endpoints for fixed weights (0 selects lo, 1 selects hi); false when
+ *        the weights do not determine both endpoints.
+ */
+bool FitEndpoints(const BlockTexels& block, const float* weights, uint32_t channels, float lo[4], float hi[4])
+{
+    float aa = 0.0F;
+    float ab = 0.0F;
+    float bb = 0.0F;
+    float ax[4] = {};
+    float bx[4] = {};
+    for (uint32_t texel = 0; texel < kTexels; ++texel)
+    {
+        const float b = weights[texel];
+        const float a = 1.0F - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (uint32_t c = 0; c < channels; ++c)
+        {
+            ax[c] += a * block.channel[c][texel];
+            bx[c] += b * block.channel[c][texel];
+        }
+    }
+    const float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6F)
+    {
+        return false;
+    }
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        lo[c] = std::clamp((bb * ax[c] - ab * bx[c]) / determinant, 0.0F, 255.0F);
+        hi[c] = std::clamp((aa * bx[c] - ab * ax[c]) / determinant, 0.0F, 255.0F);
+    }
+    return true;
+}
+
+// --- BC1 -----------------------------------------------------------------------------------
+
+// Weight of the second endpoint for each BC1 index in four-color mode.
+constexpr float kBc1Weights[4] = {0.0F, 1.0F, 1.0F / 3.0F, 2.0F / 3.0F};
+
+uint32_t Expand5(uint32_t v)
+{
+    return (v << 3) | (v >> 2);
+}
+
+uint32_t Expand6(uint32_t v)
+{
+    return (v << 2) | (v >> 4);
+}
+
+uint16_t To565(const float color[4])
+{
+    const auto r = static_cast<uint32_t>(std::lrint(color[0] * (31.0F / 255.0F)));
+    const auto g = static_cast<uint32_t>(std::lrint(color[1] * (63.0F / 255.0F)));
+    const auto b = static_cast<uint32_t>(std::lrint(color[2] * (31.0F / 255.0F)));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void From565(uint16_t packed, float color[4])
+{
+    color[0] = static_cast<float>(Expand5(packed >> 11));
+    color[1] = static_cast<float>(Expand6((packed >> 5) & 0x3F));
+    color[2] = static_cast<float>(Expand5(packed & 0x1F));
+    color[3] = 255.0F;
+}
+
+Palette Bc1Palette(uint16_t c0, uint16_t c1)
+{
+    Palette palette;
+    palette.size = 4;
+    From565(c0, palette.color[0]);
+    From565(c1, palette.color[1]);
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+        palette.color[2][c] = (2.0F * palette.color[0][c] + palette.color[1][c]) / 3.0F;
+        palette.color[3][c] = (palette.color[0][c] + 2.0F * palette.color[1][c]) / 3.0F;
+    }
+    return palette;
+}
+
+/**
+ * @brief For every 8-bit value, the 5- or 6-bit endpoint pair whose 2:1 mix (index 2) comes
+ *        closest, so flat blocks are not limited to 565 precision.
+ */
+struct SolidColorTable
+{
+    uint8_t hi[256];
+    uint8_t lo[256];
+
+    explicit SolidColorTable(uint32_t bits)
+    {
+        const uint32_t levels = 1U << bits;
+        for (uint32_t value = 0; value < 256; ++value)
+        {
+            int best = 1 << 30;
+            for (uint32_t a = 0; a < levels; ++a)
+            {
+                for (uint32_t b = 0; b < levels; ++b)
+                {
+                    const int ea = static_cast<int>(bits == 5 ? Expand5(a) : Expand6(a));
+                    const int eb = static_cast<int>(bits == 5 ? Expand5(b) : Expand6(b));
+                    const int error = std::abs((2 * ea + eb) / 3 - static_cast<int>(value)) * 256 + std::abs(ea - eb);
+                    if (error < best)
+                    {
+                        best = error;
+                        hi[value] = static_cast<uint8_t>(a);
+                        lo[value] = static_cast<uint8_t>(b);
+                    }
+                }
+            }
+        }
+    }
+};
+
+void PackBc1(uint16_t c0, uint16_t c1, const uint8_t* indices, uint8_t* out)
+{
+    // c0 > c1 selects four-color mode; swapping the endpoints swaps indices 0<->1 and 2<->3.
+    const uint8_t flip = c0 < c1 ? 1 : 0;
+    if (flip != 0)
+    {
+        std::swap(c0, c1);
+    }
+    uint32_t bits = 0;
+    if (c0 != c1)
+    {
+        for (uint32_t texel = 0; texel < kTexels; ++texel)
+        {
+            bits |= static_cast<uint32_t>(indices[texel] ^ flip) << (2 * texel);
+        }
+    }
+    std::memcpy(out, &c0, 2);
+    std::memcpy(out + 2, &c1, 2);
+    std::memcpy(out + 4, &bits, 4);
+}
+
+void EncodeBc1Color(const uint8_t* rgba, const BlockTexels& block, uint8_t* out)
+{
+    uint8_t indices[kTexels];
+    if (IsSolid(rgba, 3))
+    {
+        static const SolidColorTable table5(5);
+        static const SolidColorTable table6(6);
+        const uint16_t c0 = static_cast<uint16_t>((table5.hi[rgba[0]] << 11) | (table6.hi[rgba[1]] << 5) | table5.hi[rgba[2]]);
+        const uint16_t c1 = static_cast<uint16_t>((table5.lo[rgba[0]] << 11) | (table6.lo[rgba[1]] << 5) | table5.lo[rgba[2]]);
+        std::fill(std::begin(indices), std::end(indices), uint8_t {2});
+        PackBc1(c0, c1, indices, out);
+        return;
+    }
+
+    float lo[4];
+    float hi[4];
+    FitPrincipalAxis(block, 3, lo, hi);
+    float best_error = kMaxError;
+    uint16_t best_c0 = 0;
+    uint16_t best_c1 = 0;
+    uint8_t best_indices[kTexels] = {};
+    for (int iteration = 0; iteration < 2; ++iteration)
+    {
+        const uint16_t c0 = To565(hi);
+        const uint16_t c1 = To565(lo);
+        const float error = SelectIndices(block, Bc1Palette(c0, c1), 0, 3, indices);
+        if (error < best_error)
+        {
+            best_error = error;
+            best_c0 = c0;
+            best_c1 = c1;
+            std::copy(std::begin(indices), std::end(indices), std::begin(best_indices));
+        }
+        // Palette entry 0 is hi: weight 1 towards hi is weight 0 towards lo.
+        float weights[kTexels];
+        for (uint32_t texel = 0; texel < kTexels; ++texel)
+        {
+            weights[texel] = 1.0F - kBc1Weights[indices[texel]];
+        }
+        if (!FitEndpoints(block, weights, 3, lo, hi))
+        {
+            break;
+        }
+    }
+    PackBc1(best_c0, best_c1, best_indices, out);
+}
+
+// --- BC4 -----------------------------------------------------------------------------------
+
+void EncodeBc4Channel(const BlockTexels& block, uint32_t channel, uint8_t* out)
+{
+    const float* values = block.channel[channel];
+    float low = 255.0F;
+    float high = 0.0F;
+    float inner_low = 255.0F;
+    float inner_high = 0.0F;
+    for (uint32_t texel = 0; texel < kTexels; ++texel)
+    {
+        low = std::min(low, values[texel]);
+        high = std::max(high, values[texel]);
+        if (values[texel] > 0.0F && values[texel] < 255.0F)
+        {
+            inner_low = std::min(inner_low, values[texel]);
+            inner_high = std::max(inner_high, values[texel]);
+        }
+    }
+
+    // Eight-value mode: a0 > a1 and six interpolated values.
+    uint8_t a0 = static_cast<uint8_t>(high);
+    uint8_t a1 = static_cast<uint8_t>(low);
+    uint8_t indices[kTexels] = {};
+    if (a0 != a1)
+    {
+        Palette palette;
+        palette.size = 8;
+        palette.color[0][channel] = high;
+        palette.color[1][channel] = low;
+        for (uint32_t i = 2; i < 8; ++i)
+        {
+            palette.color[i][channel] = (static_cast<float>(8 - i) * high + static_cast<float>(i - 1) * low) / 7.0F;
+        }
+        const float error = SelectIndices(block, palette, channel, 1, indices);
+
+        // Six-value mode: a0 <= a1, four interpolated values and exact 0 and 255; wins when
+        // the block mixes extremes with a narrow range of other values.
+        if (inner_low <= inner_high && (low == 0.0F || high == 255.0F))
+        {
+            Palette six;
+            six.size = 8;
+            six.color[0][channel] = inner_low;
+            six.color[1][channel] = inner_high;
+            for (uint32_t i = 2; i < 6; ++i)
+            {
+                six.color[i][channel] =
+                    (static_cast<float>(6 - i) * inner_low + static_cast<float>(i - 1) * inner_high) / 5.0F;
+            }
+            six.color[6][channel] = 0.0F;
+            six.color[7][channel] = 255.0F;
+            uint8_t six_indices[kTexels];
+            if (SelectIndices(block, six, channel, 1, six_indices) < error)
+            {
+                a0 = static_cast<uint8_t>(inner_low);
+                a1 = static_cast<uint8_t>(inner_high);
+                std::copy(std::begin(six_indices), std::end(six_indices), std::begin(indices));
+            }
+        }
+    }
+
+    uint64_t bits = 0;
+    for (uint32_t texel = 0; texel < kTexels; ++texel)
+    {
+        bits |= static_cast<uint64_t>(indices[texel]) << (3 * texel);
+    }
+    out[0] = a0;
+    out[1] = a1;
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        out[2 + i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
+
+// --- BC7 -----------------------------------------------------------------------------------
+
+constexpr uint32_t kBc7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+struct Bc7Endpoint
+{
+    uint8_t q[4] = {};  // 7-bit channels
+    uint8_t p = 0;      // shared least significant bit
+
+    uint32_t Value(uint32_t c) const { return (static_cast<uint32_t>(q[c]) << 1) | p; }
+};
+
+Bc7Endpoint QuantizeBc7(const float color[4])
+{
+    Bc7Endpoint best;
+    float best_error = kMaxError;
+    for (uint8_t p = 0; p < 2; ++p)
+    {
+        Bc7Endpoint candidate;
+        candidate.p = p;
+        float error = 0.0F;
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            const long q = std::clamp(std::lrint((color[c] - static_cast<float>(p)) * 0.5F), 0L, 127L);
+            candidate.q[c] = static_cast<uint8_t>(q);
+            const float diff = color[c] - static_cast<float>(candidate.Value(c));
+            error += diff * diff;
+        }
+        if (error < best_error)
+        {
+            best_error = error;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+Palette Bc7Palette(const Bc7Endpoint& e0, const Bc7Endpoint& e1)
+{
+    Palette palette;
+    palette.size = 16;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            const uint32_t w = kBc7Weights[i];
+            palette.color[i][c] = static_cast<float>(((64 - w) * e0.Value(c) + w * e1.Value(c) + 32) >> 6);
+        }
+    }
+    return palette;
+}
+
+class BitWriter
+{
+public:
+    void Write(uint32_t value, uint32_t bits)
+    {
+        for (uint32_t i = 0; i < bits; ++i, ++position_)
+        {
+            words_[position_ / 64] |= static_cast<uint64_t>((value >> i) & 1U) << (position_ % 64);
+        }
+    }
+
+    void Store(uint8_t* out) const { std::memcpy(out, words_, sizeof(words_)); }
+
+private:
+    uint64_t words_[2] = {};
+    uint32_t position_ = 0;
+};
+
+void PackBc7Mode6(Bc7Endpoint e0, Bc7Endpoint e1, const uint8_t* indices, uint8_t* out)
+{
+    // The first texel's index drops its top bit, so it must select from the e0 half.
+    uint8_t flip = 0;
+    if (indices[0] >= 8)
+    {
+        std::swap(e0, e1);
+        flip = 15;
+    }
+    BitWriter writer;
+    writer.Write(1U << 6, 7);  // mode 6
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        writer.Write(e0.q[c], 7);
+        writer.Write(e1.q[c], 7);
+    }
+    writer.Write(e0.p, 1);
+    writer.Write(e1.p, 1);
+    writer.Write(indices[0] ^ flip, 3);
+    for (uint32_t texel = 1; texel < kTexels; ++texel)
+    {
+        writer.Write(indices[texel] ^ flip, 4);
+    }
+    writer.Store(out);
+}
+}  // namespace
+
+void EncodeBc1Block(const uint8_t* rgba, uint8_t* out)
+{
+    BlockTexels block;
+    LoadBlock(rgba, block);
+    EncodeBc1Color(rgba, block, out);
+}
+
+void EncodeBc4Block(const uint8_t* rgba, uint32_t channel, uint8_t* out)
+{
+    BlockTexels block;
+    LoadBlock(rgba, block);
+    EncodeBc4Channel(block, channel, out);
+}
+
+void EncodeBc3Block(const uint8_t* rgba, uint8_t* out)
+{
+    BlockTexels block;
+    LoadBlock(rgba, block);
+    EncodeBc4Channel(block, 3, out);
+    EncodeBc1Color(rgba, block, out + 8);
+}
+
+void EncodeBc5Block(const uint8_t* rgba, uint8_t* out)
+{
+    BlockTexels block;
+    LoadBlock(rgba, block);
+    EncodeBc4Channel(block, 0, out);
+    EncodeBc4Channel(block, 1, out + 8);
+}
+
+void EncodeBc7Block(const uint8_t* rgba, uint8_t* out)
+{
+    BlockTexels block;
+    LoadBlock(rgba, block);
+
+    float lo[4];
+    float hi[4];
+    FitPrincipalAxis(block, 4, lo, hi);
+    float best_error = kMaxError;
+    Bc7Endpoint best_e0;
+    Bc7Endpoint best_e1;
+    uint8_t best_indices[kTexels] = {};
+    uint8_t indices[kTexels];
+    for (int iteration = 0; iteration < 3 && best_error > 0.0F; ++iteration)
+    {
+        const Bc7Endpoint e0 = QuantizeBc7(lo);
+        const Bc7Endpoint e1 = QuantizeBc7(hi);
+        const float error = SelectIndices(block, Bc7Palette(e0, e1), 0, 4, indices);
+        if (error < best_error)
+        {
+            best_error = error;
+            best_e0 = e0;
+            best_e1 = e1;
+            std::copy(std::begin(indices), std::end(indices), std::begin(best_indices));
+        }
+        float weights[kTexels];
+        for (uint32_t texel = 0; texel < kTexels; ++texel)
+        {
+            weights[texel] = static_cast<float>(kBc7Weights[indices[texel]]) / 64.0F;
+        }
+        if (!FitEndpoints(block, weights, 4, lo, hi))
+        {
+            break;
+        }
+    }
+    PackBc7Mode6(best_e0, best_e1, best_indices, out);
+}
+
+std::vector<uint8_t> CompressImage(
+    std::span<const uint8_t> rgba, uint32_t width, uint32_t height, TextureFormat format, JobSystem& jobs)
+{
+    const size_t texel_bytes = static_cast<size_t>(width) * height * 4;
+    if (width == 0 || height == 0 || rgba.size() < texel_bytes)
+    {
+        throw std::runtime_error("CompressImage: image data does not match its size.");
+    }
+    if (format == TextureFormat::RGBA8)
+    {
+        return std::vector<uint8_t>(rgba.begin(), rgba.begin() + static_cast<std::ptrdiff_t>(texel_bytes));
+    }
+
+    void (*encode)(const uint8_t*, uint8_t*) = nullptr;
+    switch (format)
+    {
+    case TextureFormat::BC1:
+        encode = EncodeBc1Block;
+        break;
+    case TextureFormat::BC3:
+        encode = EncodeBc3Block;
+        break;
+    case TextureFormat::BC5:
+        encode = EncodeBc5Block;
+        break;
+    case TextureFormat::BC7:
+    default:
+        encode = EncodeBc7Block;
+        break;
+    }
+
+    const TexelBlock block = FormatBlock(format);
+    const uint32_t blocks_x = (width + 3) / 4;
+    const uint32_t blocks_y = (height + 3) / 4;
+    std::vector<uint8_t> out(static_cast<size_t>(blocks_x) * blocks_y * block.bytes);
+    jobs.ParallelFor(blocks_y, std::max(1U, 256 / blocks_x), [&](size_t begin, size_t end) {
+        uint8_t texels[kTexels * 4];
+        for (size_t by = begin; by < end; ++by)
+        {
+            for (uint32_t bx = 0; bx < blocks_x; ++bx)
+            {
+                for (uint32_t y = 0; y < 4; ++y)
+                {
+                    const size_t row = std::min<size_t>(by * 4 + y, height - 1);
+                    for (uint32_t x = 0; x < 4; ++x)
+                    {
+                        const size_t column = std::min<size_t>(bx * 4 + x, width - 1);
+                        std::memcpy(texels + (y * 4 + x) * 4, rgba.data() + (row * width + column) * 4, 4);
+                    }
+                }
+                encode(texels, out.data() + (by * blocks_x + bx) * block.bytes);
+            }
+        }
+    });
+    return out;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,199 @@
+#include "ZokataEngine/systems/texture/MaterialTextureSystem.h"
+
+#include <exception>
+#include <memory>
+
+#include <imgui.h>
+
+#include "ZokataEngine/systems/texture/TextureAsset.h"
+#include "ZokataEngine/systems/texture/VirtualTextureCache.h"
+#include "ZokataLog/Log.h"
+#include "ZokataRenderer/graphics/renderer/Renderer.h"
+#include "ZokataRenderer/graphics/renderer/TextureStreamer.h"
+#include "ZokataRenderer/graphics/renderer/VirtualTextureAtlas.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+MaterialTextureSystem::MaterialTextureSystem(AssetManager& assets, JobSystem& jobs)
+    : assets_(assets)
+    , jobs_(jobs)
+{
+}
+
+MaterialTextureSystem::~MaterialTextureSystem() = default;
+
+void MaterialTextureSystem::SetRenderer(IRenderer* renderer)
+{
+    // The cache's pages live in the old renderer's atlas.
+    cache_.reset();
+    renderer_ = renderer;
+    streamer_ = renderer != nullptr ? renderer->Textures() : nullptr;
+    atlas_ = renderer != nullptr ? renderer->VirtualTextures() : nullptr;
+    if (atlas_ != nullptr)
+    {
+        cache_ = std::make_unique<VirtualTextureCache>(*atlas_, jobs_);
+    }
+    material_virtual_textures_.clear();
+    for (auto& [reference, entry] : entries_)
+    {
+        entry.texture = TextureStreamer::kInvalidTexture;
+        entry.virtual_texture = VirtualPageTable::kInvalidTexture;
+        entry.failed = false;
+    }
+}
+
+void MaterialTextureSystem::Update(const DrawList& draws)
+{
+    for (const DrawBatch& batch : draws.batches)
+    {
+        const auto& textures = batch.renderable->Material().textures;
+        for (size_t slot = 0; slot < textures.size(); ++slot)
+        {
+            if (!textures[slot].empty())
+            {
+                Entry& entry = Request(textures[slot]);
+                entry.albedo |= slot == static_cast<size_t>(TextureSlot::Albedo);
+            }
+        }
+    }
+
+    stats_ = {};
+    stats_.textures = static_cast<uint32_t>(entries_.size());
+    for (auto& [reference, entry] : entries_)
+    {
+        Refresh(reference, entry);
+        stats_.loading += entry.asset.State() == AssetState::Loading ? 1 : 0;
+        stats_.streamed += entry.texture != TextureStreamer::kInvalidTexture ? 1 : 0;
+        stats_.virtual_textures += entry.virtual_texture != VirtualPageTable::kInvalidTexture ? 1 : 0;
+        stats_.failed += entry.failed || entry.asset.IsFailed() ? 1 : 0;
+    }
+    if (cache_ == nullptr)
+    {
+        return;
+    }
+
+    // Only changes go to the renderer; a reload may have given the albedo a new id.
+    const size_t albedo_slot = static_cast<size_t>(TextureSlot::Albedo);
+    for (const DrawBatch& batch : draws.batches)
+    {
+        const std::string& albedo = batch.renderable->Material().textures[albedo_slot];
+        if (albedo.empty())
+        {
+            continue;
+        }
+        const uint32_t texture = entries_.at(albedo).virtual_texture;
+        const auto [mapped, inserted] = material_virtual_textures_.try_emplace(batch.renderable->MaterialKey(), texture);
+        if (inserted || mapped->second != texture)
+        {
+            mapped->second = texture;
+            renderer_->SetMaterialVirtualTexture(mapped->first, texture);
+        }
+    }
+    cache_->Update();
+}
+
+uint32_t MaterialTextureSystem::Find(const std::string& reference) const
+{
+    const auto it = entries_.find(reference);
+    return it != entries_.end() ? it->second.texture : TextureStreamer::kInvalidTexture;
+}
+
+const MaterialTextureStats& MaterialTextureSystem::Stats() const
+{
+    return stats_;
+}
+
+void MaterialTextureSystem::DrawDebugGui()
+{
+    if (cache_ != nullptr)
+    {
+        cache_->DrawDebugGui();
+    }
+    if (!ImGui::Begin("Material Textures"))
+    {
+        ImGui::End();
+        return;
+    }
+    ImGui::Text("Textures: %u", stats_.textures);
+    ImGui::Text("Loading: %u", stats_.loading);
+    ImGui::Text("Streamed: %u", stats_.streamed);
+    ImGui::Text("Virtual: %u", stats_.virtual_textures);
+    ImGui::Text("Failed: %u", stats_.failed);
+    if (streamer_ == nullptr)
+    {
+        ImGui::TextUnformatted("The renderer streams no textures.");
+    }
+    if (atlas_ == nullptr)
+    {
+        ImGui::TextUnformatted("The renderer samples no virtual textures.");
+    }
+    ImGui::End();
+}
+
+MaterialTextureSystem::Entry& MaterialTextureSystem::Request(const std::string& reference)
+{
+    const auto found = entries_.find(reference);
+    if (found != entries_.end())
+    {
+        return found->second;
+    }
+    return entries_.emplace(reference, Entry{assets_.Load<TextureAsset>(reference)}).first->second;
+}
+
+bool MaterialTextureSystem::UsesVirtualTexture(const Entry& entry, const TextureAsset& asset) const
+{
+    // Anything else would make VirtualTextureCache::AddTexture throw.
+    return cache_ != nullptr && entry.albedo && asset.texture.format == atlas_->Format()
+        && asset.texture.LevelCount() >= VirtualLevelCount(asset.texture.extent);
+}
+
+void MaterialTextureSystem::Refresh(const std::string& reference, Entry& entry)
+{
+    if ((streamer_ == nullptr && cache_ == nullptr) || !entry.asset.IsReady())
+    {
+        return;
+    }
+    // Created, or rejected, from this version already.
+    const uint32_t version = entry.asset.Version();
+    const bool created = entry.texture != TextureStreamer::kInvalidTexture
+        || entry.virtual_texture != VirtualPageTable::kInvalidTexture;
+    if ((created || entry.failed) && entry.version == version)
+    {
+        return;
+    }
+
+    // A reload replaces the texture; the old image and pages go once no frame uses them.
+    if (entry.texture != TextureStreamer::kInvalidTexture)
+    {
+        streamer_->Release(entry.texture);
+        entry.texture = TextureStreamer::kInvalidTexture;
+    }
+    if (entry.virtual_texture != VirtualPageTable::kInvalidTexture)
+    {
+        cache_->RemoveTexture(entry.virtual_texture);
+        entry.virtual_texture = VirtualPageTable::kInvalidTexture;
+    }
+    const std::shared_ptr<const TextureAsset> asset = entry.asset.Get();
+    entry.version = version;
+    entry.failed = false;
+    try
+    {
+        if (UsesVirtualTexture(entry, *asset))
+        {
+            entry.virtual_texture = cache_->AddTexture(asset);
+        }
+        else if (streamer_ != nullptr)
+        {
+            entry.texture = streamer_->Create(asset->texture, asset);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        ZLOG_ERROR("Failed to stream texture '" + reference + "': " + e.what());
+        entry.failed = true;
+    }
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,33 @@
+#include "ZokataEngine/systems/texture/TextureAsset.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include "ZokataEngine/systems/asset/AssetReference.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+std::shared_ptr<const TextureAsset> LoadTextureAsset(const std::string& reference)
+{
+    const AssetReference asset = ParseAssetReference(reference);
+    auto texture = std::make_shared<TextureAsset>();
+    texture->file = MappedFile(asset.path);
+    try
+    {
+        texture->texture = ParseKtx2(texture->file.Bytes());
+    }
+    catch (const std::runtime_error& error)
+    {
+        throw std::runtime_error(asset.path.string() + ": " + error.what());
+    }
+    return texture;
+}
+
+AssetSize MeasureTexture(const TextureAsset& asset)
+{
+    return AssetSize{0, static_cast<size_t>(asset.texture.ByteSize())};
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,354 @@
+#include "ZokataEngine/systems/texture/TextureCooker.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/texture/BlockCompression.h"
+#include "ZokataRenderer/graphics/renderer/Ktx2.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr float kKaiserRadius = 3.0F;  // in destination texels
+constexpr float kKaiserAlpha = 4.0F;
+constexpr size_t kSrgbEncodeSize = 16384;
+// Color is weighted by alpha plus this floor, so fully transparent areas keep their color.
+constexpr float kAlphaWeightFloor = 1.0F / 256.0F;
+constexpr size_t kTexelsPerTask = 16384;
+
+struct FloatImage
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float> texels;  // RGBA
+};
+
+float SrgbToLinear(float c)
+{
+    return c <= 0.04045F ? c / 12.92F : std::pow((c + 0.055F) / 1.055F, 2.4F);
+}
+
+float LinearToSrgb(float c)
+{
+    return c <= 0.0031308F ? c * 12.92F : 1.055F * std::pow(c, 1.0F / 2.4F) - 0.055F;
+}
+
+const std::array<float, 256>& SrgbDecodeTable()
+{
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> values {};
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = SrgbToLinear(static_cast<float>(i) / 255.0F);
+        }
+        return values;
+    }();
+    return table;
+}
+
+// Fine enough that the steep segment near black still rounds to the right byte.
+const std::vector<uint8_t>& SrgbEncodeTable()
+{
+    static const std::vector<uint8_t> table = [] {
+        std::vector<uint8_t> values(kSrgbEncodeSize);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const float linear = static_cast<float>(i) / static_cast<float>(kSrgbEncodeSize - 1);
+            values[i] = static_cast<uint8_t>(std::lrint(LinearToSrgb(linear) * 255.0F));
+        }
+        return values;
+    }();
+    return table;
+}
+
+float AlphaWeight(float alpha)
+{
+    return std::max(alpha + kAlphaWeightFloor * (1.0F - alpha), 1e-4F);
+}
+
+float BesselI0(float x)
+{
+    float sum = 1.0F;
+    float term = 1.0F;
+    const float half_squared = x * x * 0.25F;
+    for (int k = 1; k < 32 && term > sum * 1e-8F; ++k)
+    {
+        term *= half_squared / static_cast<float>(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+float Kaiser(float x)
+{
+    if (std::abs(x) >= kKaiserRadius)
+    {
+        return 0.0F;
+    }
+    constexpr float kPi = 3.14159265358979F;
+    const float sinc = x == 0.0F ? 1.0F : std::sin(kPi * x) / (kPi * x);
+    const float t = x / kKaiserRadius;
+    return sinc * BesselI0(kKaiserAlpha * std::sqrt(1.0F - t * t)) / BesselI0(kKaiserAlpha);
+}
+
+// Source texels and normalized weights behind each destination texel along one axis.
+struct FilterTaps
+{
+    uint32_t count = 0;  // taps per destination texel
+    std::vector<uint32_t> indices;
+    std::vector<float> weights;
+};
+
+FilterTaps BuildTaps(uint32_t source, uint32_t destination, bool wrap)
+{
+    FilterTaps taps;
+    if (source == destination)
+    {
+        taps.count = 1;
+        for (uint32_t i = 0; i < destination; ++i)
+        {
+            taps.indices.push_back(i);
+            taps.weights.push_back(1.0F);
+        }
+        return taps;
+    }
+
+    const float scale = static_cast<float>(source) / static_cast<float>(destination);
+    const float radius = kKaiserRadius * scale;
+    taps.count = static_cast<uint32_t>(std::ceil(2.0F * radius)) + 1;
+    taps.indices.resize(static_cast<size_t>(destination) * taps.count);
+    taps.weights.resize(taps.indices.size());
+    const auto size = static_cast<int64_t>(source);
+    for (uint32_t d = 0; d < destination; ++d)
+    {
+        const float center = (static_cast<float>(d) + 0.5F) * scale;
+        const auto first = static_cast<int64_t>(std::floor(center - radius));
+        float sum = 0.0F;
+        for (uint32_t k = 0; k < taps.count; ++k)
+        {
+            const int64_t s = first + k;
+            const float weight = Kaiser((static_cast<float>(s) + 0.5F - center) / scale);
+            const int64_t index = wrap ? ((s % size) + size) % size : std::clamp<int64_t>(s, 0, size - 1);
+            taps.indices[d * taps.count + k] = static_cast<uint32_t>(index);
+            taps.weights[d * taps.count + k] = weight;
+            sum += weight;
+        }
+        for (uint32_t k = 0; k < taps.count; ++k)
+        {
+            taps.weights[d * taps.count + k] /= sum;
+        }
+    }
+    return taps;
+}
+
+size_t RowsPerTask(uint32_t width)
+{
+    return std::max<size_t>(1, kTexelsPerTask / std::max(1U, width));
+}
+
+FloatImage Downsample(const FloatImage& source, bool wrap, JobSystem& jobs)
+{
+    const uint32_t width = std::max(1U, source.width / 2);
+    const uint32_t height = std::max(1U, source.height / 2);
+    const FilterTaps horizontal = BuildTaps(source.width, width, wrap);
+    const FilterTaps vertical = BuildTaps(source.height, height, wrap);
+
+    FloatImage rows {width, source.height, std::vector<float>(static_cast<size_t>(width) * source.height * 4)};
+    jobs.ParallelFor(source.height, RowsPerTask(source.width), [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y)
+        {
+            const float* in = source.texels.data() + y * source.width * 4;
+            float* out = rows.texels.data() + y * width * 4;
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                float sum[4] = {};
+                for (uint32_t k = 0; k < horizontal.count; ++k)
+                {
+                    const float* texel = in + static_cast<size_t>(horizontal.indices[x * horizontal.count + k]) * 4;
+                    const float weight = horizontal.weights[x * horizontal.count + k];
+                    for (uint32_t c = 0; c < 4; ++c)
+                    {
+                        sum[c] += texel[c] * weight;
+                    }
+                }
+                std::copy(std::begin(sum), std::end(sum), out + x * 4);
+            }
+        }
+    });
+
+    FloatImage result {width, height, std::vector<float>(static_cast<size_t>(width) * height * 4, 0.0F)};
+    const size_t row_floats = static_cast<size_t>(width) * 4;
+    jobs.ParallelFor(height, RowsPerTask(width), [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y)
+        {
+            float* out = result.texels.data() + y * row_floats;
+            for (uint32_t k = 0; k < vertical.count; ++k)
+            {
+                const float* in = rows.texels.data() + vertical.indices[y * vertical.count + k] * row_floats;
+                const float weight = vertical.weights[y * vertical.count + k];
+                for (size_t i = 0; i < row_floats; ++i)
+                {
+                    out[i] += in[i] * weight;
+                }
+            }
+        }
+    });
+    return result;
+}
+
+FloatImage ToFloat(std::span<const uint8_t> rgba, uint32_t width, uint32_t height, const TextureCookSettings& settings)
+{
+    FloatImage image {width, height, std::vector<float>(static_cast<size_t>(width) * height * 4)};
+    const std::array<float, 256>& decode = SrgbDecodeTable();
+    for (size_t i = 0; i < image.texels.size(); i += 4)
+    {
+        const float alpha = static_cast<float>(rgba[i + 3]) / 255.0F;
+        image.texels[i + 3] = alpha;
+        for (size_t c = 0; c < 3; ++c)
+        {
+            const float value = static_cast<float>(rgba[i + c]) / 255.0F;
+            if (settings.normal_map)
+            {
+                image.texels[i + c] = value * 2.0F - 1.0F;
+            }
+            else
+            {
+                image.texels[i + c] = (settings.srgb ? decode[rgba[i + c]] : value) * AlphaWeight(alpha);
+            }
+        }
+    }
+    return image;
+}
+
+std::vector<uint8_t> ToBytes(const FloatImage& image, const TextureCookSettings& settings, JobSystem& jobs)
+{
+    std::vector<uint8_t> bytes(image.texels.size());
+    const std::vector<uint8_t>& encode = SrgbEncodeTable();
+    const auto to_byte = [](float value) {
+        return static_cast<uint8_t>(std::lrint(std::clamp(value, 0.0F, 1.0F) * 255.0F));
+    };
+    jobs.ParallelFor(image.height, RowsPerTask(image.width), [&](size_t begin, size_t end) {
+        for (size_t i = begin * image.width * 4; i < end * image.width * 4; i += 4)
+        {
+            const float* texel = image.texels.data() + i;
+            const float alpha = std::clamp(texel[3], 0.0F, 1.0F);
+            bytes[i + 3] = to_byte(alpha);
+            if (settings.normal_map)
+            {
+                const float length = std::sqrt(texel[0] * texel[0] + texel[1] * texel[1] + texel[2] * texel[2]);
+                const float n[3] = {
+                    length > 1e-6F ? texel[0] / length : 0.0F,
+                    length > 1e-6F ? texel[1] / length : 0.0F,
+                    length > 1e-6F ? texel[2] / length : 1.0F,
+                };
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    bytes[i + c] = to_byte(n[c] * 0.5F + 0.5F);
+                }
+                continue;
+            }
+            const float weight = AlphaWeight(alpha);
+            for (size_t c = 0; c < 3; ++c)
+            {
+                const float value = std::clamp(texel[c] / weight, 0.0F, 1.0F);
+                bytes[i + c] = settings.srgb
+                                   ? encode[static_cast<size_t>(std::lrint(value * static_cast<float>(kSrgbEncodeSize - 1)))]
+                                   : to_byte(value);
+            }
+        }
+    });
+    return bytes;
+}
+
+float MillisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+}  // namespace
+
+TextureCookSettings DefaultCookSettings(TextureSlot slot)
+{
+    TextureCookSettings settings;
+    switch (slot)
+    {
+    case TextureSlot::Albedo:
+    case TextureSlot::Emissive:
+        break;
+    case TextureSlot::Normal:
+        settings.format = TextureFormat::BC5;
+        settings.srgb = false;
+        settings.normal_map = true;
+        break;
+    default:
+        settings.srgb = false;
+        break;
+    }
+    return settings;
+}
+
+TextureCooker::TextureCooker(JobSystem& jobs)
+    : jobs_(jobs)
+{
+}
+
+std::vector<std::vector<uint8_t>> TextureCooker::BuildMips(
+    std::span<const uint8_t> rgba, uint32_t width, uint32_t height, const TextureCookSettings& settings)
+{
+    if (width == 0 || height == 0 || rgba.size() != static_cast<size_t>(width) * height * 4)
+    {
+        throw std::runtime_error(
+            "Texture data of " + std::to_string(rgba.size()) + " bytes does not match " + std::to_string(width) + "x"
+            + std::to_string(height) + " RGBA8.");
+    }
+    const auto start = Clock::now();
+    std::vector<std::vector<uint8_t>> levels;
+    levels.emplace_back(rgba.begin(), rgba.end());
+    if (settings.mipmaps && (width > 1 || height > 1))
+    {
+        // Each level filters the previous one in float, so rounding does not accumulate.
+        FloatImage level = ToFloat(rgba, width, height, settings);
+        while (level.width > 1 || level.height > 1)
+        {
+            level = Downsample(level, settings.wrap, jobs_);
+            levels.push_back(ToBytes(level, settings, jobs_));
+        }
+    }
+    stats_.levels = static_cast<uint32_t>(levels.size());
+    stats_.mip_ms = MillisecondsSince(start);
+    return levels;
+}
+
+std::vector<uint8_t> TextureCooker::Cook(
+    std::span<const uint8_t> rgba, uint32_t width, uint32_t height, const TextureCookSettings& settings)
+{
+    std::vector<std::vector<uint8_t>> levels = BuildMips(rgba, width, height, settings);
+
+    const auto start = Clock::now();
+    for (uint32_t level = 0; level < levels.size(); ++level)
+    {
+        const VkExtent2D extent = MipExtent(VkExtent2D{width, height}, level);
+        levels[level] = CompressImage(levels[level], extent.width, extent.height, settings.format, jobs_);
+    }
+    std::vector<uint8_t> file = WriteKtx2(settings.format, settings.srgb, VkExtent2D{width, height}, levels);
+    stats_.compress_ms = MillisecondsSince(start);
+    stats_.cooked_bytes = file.size();
+    return file;
+}
+
+const TextureCookStats& TextureCooker::Stats() const
+{
+    return stats_;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -0,0 +1,305 @@
+#include "ZokataEngine/systems/texture/VirtualTextureCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <imgui.h>
+
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataLog/Log.h"
+
+namespace ZKT
+{
+namespace ENGINE
+{
+namespace
+{
+bool IsReady(const std::future<std::shared_ptr<std::vector<uint8_t>>>& future)
+{
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+}  // namespace
+
+VirtualTextureCache::VirtualTextureCache(VirtualTextureAtlas& atlas, JobSystem& jobs, uint32_t max_loads_in_flight)
+    : atlas_(atlas)
+    , jobs_(jobs)
+    , max_loads_in_flight_(std::max(max_loads_in_flight, 1U))
+{
+}
+
+uint32_t VirtualTextureCache::AddTexture(std::shared_ptr<const TextureAsset> asset, bool wrap)
+{
+    const Ktx2Texture& texture = asset->texture;
+    if (texture.format != atlas_.Format())
+    {
+        throw std::runtime_error(
+            "Virtual texture format " + std::to_string(texture.format) + " does not match the atlas format "
+            + std::to_string(atlas_.Format()) + ".");
+    }
+    const uint32_t levels = VirtualLevelCount(texture.extent);
+    if (texture.LevelCount() < levels)
+    {
+        throw std::runtime_error(
+            "Virtual textures need " + std::to_string(levels) + " mip levels; the texture has "
+            + std::to_string(texture.LevelCount()) + ".");
+    }
+
+    const uint32_t id = atlas_.AddTexture(texture.extent);
+    if (id >= textures_.size())
+    {
+        textures_.resize(id + 1);
+    }
+    textures_[id] = Texture{std::move(asset), wrap};
+    ++stats_.textures;
+    StartLoad(VirtualPage{id, levels - 1, 0, 0}, true);
+    return id;
+}
+
+void VirtualTextureCache::RemoveTexture(uint32_t texture)
+{
+    if (texture >= textures_.size() || !textures_[texture].asset)
+    {
+        return;
+    }
+    const auto of_texture = [texture](uint32_t key) {
+        return UnpackVirtualPage(key).texture == texture;
+    };
+    std::erase_if(loading_, of_texture);
+    std::erase_if(uploading_, of_texture);
+    std::erase_if(pages_, [this, texture](const auto& entry) {
+        const Page& page = entry.second;
+        if (page.page.texture != texture)
+        {
+            return false;
+        }
+        // Loads still on a worker finish into their discarded futures.
+        if (page.state == PageState::Resident)
+        {
+            atlas_.ReleaseSlot(page.slot);
+            --resident_;
+            if (!page.pinned)
+            {
+                lru_.erase(page.lru);
+            }
+        }
+        else if (page.state == PageState::Uploading)
+        {
+            atlas_.ReleaseSlot(page.slot, page.ticket);
+        }
+        return true;
+    });
+    atlas_.RemoveTexture(texture);
+    textures_[texture] = Texture {};
+    --stats_.textures;
+}
+
+void VirtualTextureCache::Update()
+{
+    ++frame_;
+    stats_.evicted = 0;
+
+    CollectFinishedUploads();
+    CollectFeedback();
+
+    // Coarsest first: a page only ever waits behind pages it can fall back to.
+    std::ranges::sort(missing_, [](const VirtualPage& a, const VirtualPage& b) {
+        return a.level != b.level ? a.level > b.level : PackVirtualPage(a) < PackVirtualPage(b);
+    });
+    const auto duplicates = std::ranges::unique(missing_, [](const VirtualPage& a, const VirtualPage& b) {
+        return PackVirtualPage(a) == PackVirtualPage(b);
+    });
+    missing_.erase(duplicates.begin(), duplicates.end());
+    for (const VirtualPage& page : missing_)
+    {
+        if (loading_.size() >= max_loads_in_flight_)
+        {
+            break;  // the rest is requested again by the next feedback
+        }
+        StartLoad(page, false);
+    }
+
+    CollectFinishedLoads();
+
+    // Keep a slot for every load that may finish, counting slots on their way back.
+    while (atlas_.FreeSlotCount() + atlas_.RetiredSlotCount() < max_loads_in_flight_ && EvictOne())
+    {
+    }
+
+    stats_.resident = resident_;
+    stats_.loading = static_cast<uint32_t>(loading_.size());
+    stats_.uploading = static_cast<uint32_t>(uploading_.size());
+}
+
+const VirtualTextureCacheStats& VirtualTextureCache::Stats() const
+{
+    return stats_;
+}
+
+void VirtualTextureCache::DrawDebugGui() const
+{
+    if (!ImGui::Begin("Virtual Texture Cache"))
+    {
+        ImGui::End();
+        return;
+    }
+    ImGui::Text("Textures: %u", stats_.textures);
+    ImGui::Text("Requested pages: %u", stats_.requested);
+    ImGui::Text("Resident: %u (%zu evictable)", stats_.resident, lru_.size());
+    ImGui::Text("Loading: %u / %u, uploading: %u", stats_.loading, max_loads_in_flight_, stats_.uploading);
+    ImGui::Text("Evicted this frame: %u", stats_.evicted);
+    ImGui::Text("Failed pages: %u", stats_.failed);
+    ImGui::End();
+}
+
+void VirtualTextureCache::CollectFeedback()
+{
+    missing_.clear();
+    const std::span<const uint32_t> feedback = atlas_.Feedback();
+    requests_.assign(feedback.begin(), feedback.end());
+    std::ranges::sort(requests_);
+    requests_.erase(std::ranges::unique(requests_).begin(), requests_.end());
+    if (!requests_.empty() && requests_.back() == kNoPageRequest)
+    {
+        requests_.pop_back();
+    }
+    stats_.requested = static_cast<uint32_t>(requests_.size());
+
+    const VirtualPageTable& table = atlas_.PageTable();
+    for (const uint32_t request : requests_)
+    {
+        VirtualPage page = UnpackVirtualPage(request);
+        // Feedback is a frame or two old; its texture may have been removed or replaced since.
+        if (!table.Contains(page))
+        {
+            continue;
+        }
+        const uint32_t levels = table.Texture(page.texture).levels;
+        while (true)
+        {
+            const auto found = pages_.find(PackVirtualPage(page));
+            if (found == pages_.end())
+            {
+                missing_.push_back(page);
+            }
+            else
+            {
+                Page& entry = found->second;
+                if (entry.last_used == frame_)
+                {
+                    break;  // reached through another request; its ancestors are marked too
+                }
+                entry.last_used = frame_;
+                if (entry.state == PageState::Resident && !entry.pinned)
+                {
+                    lru_.splice(lru_.begin(), lru_, entry.lru);
+                }
+            }
+            if (page.level + 1 >= levels)
+            {
+                break;
+            }
+            page = table.Parent(page);
+        }
+    }
+}
+
+void VirtualTextureCache::StartLoad(const VirtualPage& page, bool pinned)
+{
+    const uint32_t key = PackVirtualPage(page);
+    const Texture& texture = textures_[page.texture];
+    Page& entry = pages_[key];
+    entry.page = page;
+    entry.pinned = pinned;
+    entry.last_used = frame_;
+    entry.load = jobs_.Submit(
+        [asset = texture.asset, wrap = texture.wrap, page, bytes = VirtualPageBytes(atlas_.Format())]() {
+            auto data = std::make_shared<std::vector<uint8_t>>(bytes);
+            CopyVirtualPage(asset->texture, page, wrap, *data);
+            return data;
+        });
+    loading_.push_back(key);
+}
+
+void VirtualTextureCache::CollectFinishedLoads()
+{
+    // In submission order, so coarse pages claim slots first.
+    std::erase_if(loading_, [this](uint32_t key) {
+        Page& page = pages_.at(key);
+        if (page.state == PageState::Loading)
+        {
+            if (!IsReady(page.load))
+            {
+                return false;
+            }
+            try
+            {
+                page.data = page.load.get();
+                page.state = PageState::Loaded;
+            }
+            catch (const std::exception& error)
+            {
+                ZLOG_ERROR(std::string("Virtual texture page load failed: ") + error.what());
+                page.state = PageState::Failed;
+                ++stats_.failed;
+                return true;
+            }
+        }
+
+        page.slot = atlas_.AllocateSlot();
+        if (page.slot == VirtualTextureAtlas::kInvalidSlot)
+        {
+            return false;
+        }
+        page.ticket = atlas_.UploadPage(page.slot, *page.data, page.data);
+        page.data.reset();
+        page.state = PageState::Uploading;
+        uploading_.push_back(key);
+        return true;
+    });
+}
+
+void VirtualTextureCache::CollectFinishedUploads()
+{
+    std::erase_if(uploading_, [this](uint32_t key) {
+        Page& page = pages_.at(key);
+        if (!atlas_.IsComplete(page.ticket))
+        {
+            return false;
+        }
+        atlas_.MapPage(page.page, page.slot);
+        page.state = PageState::Resident;
+        ++resident_;
+        if (!page.pinned)
+        {
+            lru_.push_front(key);
+            page.lru = lru_.begin();
+        }
+        return true;
+    });
+}
+
+bool VirtualTextureCache::EvictOne()
+{
+    if (lru_.empty())
+    {
+        return false;
+    }
+    const uint32_t key = lru_.back();
+    const auto found = pages_.find(key);
+    if (found->second.last_used == frame_)
+    {
+        return false;  // everything left was requested this frame
+    }
+    atlas_.UnmapPage(found->second.page, found->second.slot);
+    lru_.pop_back();
+    pages_.erase(found);
+    --resident_;
+    ++stats_.evicted;
+    return true;
+}
+}  // namespace ENGINE
+}  // namespace ZKT
@@ -30,8 +30,9 @@ ImGuiInitInfo MakeImGuiInit(const GlfwWindow& window, const VulkanContext& conte
 Application::Application()
     : window_(WindowConfig{1280, 720, "ZOKATA"})
     , context_(window_)
+    , uploads_(context_)
 {
-    renderer_ = std::make_unique<DeferredRenderer>();
+    renderer_ = std::make_unique<DeferredRenderer>(context_, uploads_);
     SetupImGui();
     ActiveRenderer().OnSwapchainUpdated(context_.SwapchainExtent());
 }
@@ -52,6 +53,31 @@ void Application::SetGuiCallback(std::function<void()> callback)
     extra_gui_ = std::move(callback);
 }
 
+void Application::SetUpdateCallback(std::function<void(float)> callback)
+{
+    update_ = std::move(callback);
+}
+
+void Application::SetDrawList(const DrawList* draw_list)
+{
+    draw_list_ = draw_list;
+}
+
+VkExtent2D Application::FramebufferExtent() const
+{
+    return context_.SwapchainExtent();
+}
+
+UploadService& Application::Uploads()
+{
+    return uploads_;
+}
+
+IRenderer& Application::Renderer()
+{
+    return ActiveRenderer();
+}
+
 void Application::RecreateSwapchainAndUi()
 {
     context_.RecreateSwapchain();
@@ -82,23 +108,41 @@ void Application::Run()
             continue;
         }
 
+        // Outside the render pass: submits this frame's copies and acquires finished ones.
+        uploads_.BeginFrame(frame.command_buffer);
+
         const auto now = clock::now();
         const float delta_seconds = std::chrono::duration<float>(now - last_frame).count();
         last_frame = now;
 
-        imgui_layer_.NewFrame();
-
-        FrameDescriptor gui_frame {
+        // draw_list_ is filled by the update callback; the pointer itself does not change.
+        const FrameDescriptor render_frame {
             .delta_seconds = delta_seconds,
             .frame_index = frame_index_++,
+            .draw_list = draw_list_,
+            .command_buffer = frame.command_buffer,
+            .frame_slot = frame.frame_slot,
+            .extent = frame.extent,
         };
+        ActiveRenderer().BeginFrame(render_frame);
+
+        if (update_)
+        {
+            update_(delta_seconds);
+        }
+
+        ActiveRenderer().RecordFrame(render_frame);
+
+        context_.BeginRenderPass(frame);
+        ActiveRenderer().RecordPass(render_frame);
+        imgui_layer_.NewFrame();
 
         if (extra_gui_)
         {
             extra_gui_();
         }
 
-        ActiveRenderer().RenderGui(gui_frame);
+        ActiveRenderer().RenderGui(render_frame);
 
         imgui_layer_.Render(frame.command_buffer);
 
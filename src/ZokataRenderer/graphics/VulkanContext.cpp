@@ -3,6 +3,7 @@
 #include "ZokataRenderer/graphics/Window.h"
 
 #include <algorithm>
+#include <array>
 #include <stdexcept>
 #include <vector>
 
@@ -10,11 +11,6 @@
 
 namespace ZKT
 {
-namespace
-{
-constexpr uint32_t kMaxFramesInFlight = 2;
-}  // namespace
-
 VulkanContext::VulkanContext(const IWindow& window)
     : window_(window)
 {
@@ -24,6 +20,7 @@ VulkanContext::VulkanContext(const IWindow& window)
     swapchain_ = std::make_unique<Swapchain>(*device_, surface_, window_);
     CreateCommandPool();
     CreateRenderPass();
+    CreateDepthBuffer();
     CreateFramebuffers();
     AllocateCommandBuffers();
     sync_pool_ = std::make_unique<FrameSyncPool>(device_->Logical(), kMaxFramesInFlight);
@@ -47,6 +44,11 @@ VulkanContext::~VulkanContext()
     }
 }
 
+const Device& VulkanContext::GetDevice() const
+{
+    return *device_;
+}
+
 VkInstance VulkanContext::InstanceHandle() const
 {
     return instance_->Get();
@@ -72,6 +74,11 @@ VkQueue VulkanContext::PresentQueue() const
     return device_->PresentQueue();
 }
 
+VkQueue VulkanContext::TransferQueue() const
+{
+    return device_->TransferQueue();
+}
+
 uint32_t VulkanContext::GraphicsQueueFamily() const
 {
     return device_->GraphicsQueueFamily();
@@ -82,6 +89,11 @@ uint32_t VulkanContext::PresentQueueFamily() const
     return device_->PresentQueueFamily();
 }
 
+uint32_t VulkanContext::TransferQueueFamily() const
+{
+    return device_->TransferQueueFamily();
+}
+
 VkRenderPass VulkanContext::RenderPass() const
 {
     return render_pass_;
@@ -158,27 +170,47 @@ void VulkanContext::CreateRenderPass()
     color_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
     color_attachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
+    VkAttachmentDescription depth_attachment {};
+    depth_attachment.format = kDepthFormat;
+    depth_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depth_attachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depth_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    depth_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depth_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    depth_attachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
     VkAttachmentReference color_attachment_ref {};
     color_attachment_ref.attachment = 0;
     color_attachment_ref.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
+    VkAttachmentReference depth_attachment_ref {};
+    depth_attachment_ref.attachment = 1;
+    depth_attachment_ref.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
     VkSubpassDescription subpass {};
     subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
     subpass.colorAttachmentCount = 1;
     subpass.pColorAttachments = &color_attachment_ref;
+    subpass.pDepthStencilAttachment = &depth_attachment_ref;
 
+    // The depth image is shared by every frame in flight; the previous frame's depth tests must
+    // finish before this one clears it.
     VkSubpassDependency dependency {};
     dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
     dependency.dstSubpass = 0;
-    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependency.srcAccessMask = 0;
-    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
+    dependency.srcStageMask =
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependency.dstStageMask =
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    const std::array<VkAttachmentDescription, 2> attachments {color_attachment, depth_attachment};
     VkRenderPassCreateInfo render_pass_info {};
     render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    render_pass_info.attachmentCount = 1;
-    render_pass_info.pAttachments = &color_attachment;
+    render_pass_info.attachmentCount = static_cast<uint32_t>(attachments.size());
+    render_pass_info.pAttachments = attachments.data();
     render_pass_info.subpassCount = 1;
     render_pass_info.pSubpasses = &subpass;
     render_pass_info.dependencyCount = 1;
@@ -190,18 +222,34 @@ void VulkanContext::CreateRenderPass()
     }
 }
 
+void VulkanContext::CreateDepthBuffer()
+{
+    depth_image_ = Image(*device_, kDepthFormat, swapchain_->Extent(), 1, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+
+    VkImageViewCreateInfo view_info {};
+    view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_info.image = depth_image_.Handle();
+    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format = kDepthFormat;
+    view_info.subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1};
+    if (vkCreateImageView(device_->Logical(), &view_info, nullptr, &depth_view_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the depth buffer view.");
+    }
+}
+
 void VulkanContext::CreateFramebuffers()
 {
     const auto& image_views = swapchain_->ImageViews();
     framebuffers_.resize(image_views.size());
     for (size_t i = 0; i < image_views.size(); ++i)
     {
-        VkImageView attachments[] = {image_views[i]};
+        VkImageView attachments[] = {image_views[i], depth_view_};
 
         VkFramebufferCreateInfo framebuffer_info {};
         framebuffer_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         framebuffer_info.renderPass = render_pass_;
-        framebuffer_info.attachmentCount = 1;
+        framebuffer_info.attachmentCount = 2;
         framebuffer_info.pAttachments = attachments;
         framebuffer_info.width = swapchain_->Extent().width;
         framebuffer_info.height = swapchain_->Extent().height;
@@ -256,6 +304,13 @@ void VulkanContext::CleanupSwapchain()
     }
     framebuffers_.clear();
 
+    if (depth_view_ != VK_NULL_HANDLE)
+    {
+        vkDestroyImageView(device_->Logical(), depth_view_, nullptr);
+        depth_view_ = VK_NULL_HANDLE;
+    }
+    depth_image_ = Image {};
+
     if (render_pass_ != VK_NULL_HANDLE)
     {
         vkDestroyRenderPass(device_->Logical(), render_pass_, nullptr);
@@ -282,6 +337,7 @@ void VulkanContext::RecreateSwapchain()
     swapchain_->Recreate(*device_, surface_, window_);
     sync_pool_->ImagesInFlight().assign(swapchain_->Images().size(), VK_NULL_HANDLE);
     CreateRenderPass();
+    CreateDepthBuffer();
     CreateFramebuffers();
     AllocateCommandBuffers();
     swapchain_dirty_ = false;
@@ -344,24 +400,30 @@ FrameStatus VulkanContext::BeginFrame(FrameContext& frame)
         throw std::runtime_error("Failed to begin recording a command buffer.");
     }
 
-    VkClearValue clear_color = {{0.02F, 0.02F, 0.025F, 1.0F}};
+    frame.command_buffer = command_buffer;
+    frame.image_index = image_index;
+    frame.frame_slot = current_frame_;
+    frame.extent = swapchain_->Extent();
+
+    return swapchain_dirty_ ? FrameStatus::SwapchainOutOfDate : FrameStatus::Ready;
+}
+
+void VulkanContext::BeginRenderPass(const FrameContext& frame)
+{
+    std::array<VkClearValue, 2> clear_values {};
+    clear_values[0].color = {{0.02F, 0.02F, 0.025F, 1.0F}};
+    clear_values[1].depthStencil = {1.0F, 0};
 
     VkRenderPassBeginInfo render_pass_info {};
     render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     render_pass_info.renderPass = render_pass_;
-    render_pass_info.framebuffer = framebuffers_[image_index];
+    render_pass_info.framebuffer = framebuffers_[frame.image_index];
     render_pass_info.renderArea.offset = {0, 0};
-    render_pass_info.renderArea.extent = swapchain_->Extent();
-    render_pass_info.clearValueCount = 1;
-    render_pass_info.pClearValues = &clear_color;
+    render_pass_info.renderArea.extent = frame.extent;
+    render_pass_info.clearValueCount = static_cast<uint32_t>(clear_values.size());
+    render_pass_info.pClearValues = clear_values.data();
 
-    vkCmdBeginRenderPass(command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
-
-    frame.command_buffer = command_buffer;
-    frame.image_index = image_index;
-    frame.extent = swapchain_->Extent();
-
-    return swapchain_dirty_ ? FrameStatus::SwapchainOutOfDate : FrameStatus::Ready;
+    vkCmdBeginRenderPass(frame.command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
 }
 
 FrameStatus VulkanContext::EndFrame(const FrameContext& frame)
@@ -1,11 +1,115 @@
 #include "ZokataRenderer/graphics/renderer/DeferredRenderer.h"
 
 #include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <imgui.h>
 
+#include "ZokataRenderer/graphics/renderer/TextureFormat.h"
+#include "ZokataRenderer/graphics/vk/Device.h"
+#include "ZokataRenderer/graphics/vk/Shader.h"
+
 namespace ZKT
 {
+namespace
+{
+constexpr uint32_t kMaxVertices = 1U << 20;
+constexpr uint32_t kMaxIndices = 1U << 22;
+constexpr uint32_t kMaxClusterInstances = 1U << 14;  // instances drawn per meshlet, by index
+constexpr uint32_t kMaxClusters = 1U << 18;
+constexpr uint32_t kMaxMeshlets = 1U << 16;
+constexpr uint32_t kMaxSkinnedVertices = 1U << 16;
+constexpr uint32_t kMaxSkinJoints = 1U << 12;
+
+constexpr VkMemoryPropertyFlags kHostVisible =
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+struct GeometryPushConstants
+{
+    MATH::Mat4f view_projection {};
+};
+
+// std430 layout of VertexQuantization in geometry.vert.
+struct GpuQuantization
+{
+    MATH::Vec4f offset {};
+    MATH::Vec4f scale {};
+};
+static_assert(sizeof(GpuQuantization) == 32, "GpuQuantization must match the std430 layout");
+
+/**
+ * @brief Replaces buffer with a larger host-visible storage buffer if it holds fewer than bytes.
+ */
+bool ReserveStorage(const Device& device, Buffer& buffer, VkDeviceSize bytes)
+{
+    if (buffer.Valid() && buffer.Size() >= bytes)
+    {
+        return false;
+    }
+    buffer = Buffer(device, std::bit_ceil(std::max<VkDeviceSize>(bytes, 256)), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, kHostVisible);
+    return true;
+}
+
+VkPipelineShaderStageCreateInfo ShaderStage(VkShaderStageFlagBits stage, VkShaderModule module)
+{
+    VkPipelineShaderStageCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    info.stage = stage;
+    info.module = module;
+    info.pName = "main";
+    return info;
+}
+}  // namespace
+
+DeferredRenderer::DeferredRenderer(const VulkanContext& context, UploadService& uploader)
+    : context_(context)
+    , device_(context.DeviceHandle())
+    , heap_(context, uploader, VertexFormat::Packed20, IndexFormat::UInt32, kMaxVertices, kMaxIndices)
+    , instances_(context)
+    , cluster_instances_(context.GetDevice(),
+                         kMaxClusterInstances * sizeof(GpuInstance),
+                         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+    , meshlets_(context, kMaxClusters, kMaxMeshlets)
+    , skinning_(context, kMaxSkinnedVertices, kMaxSkinJoints)
+    , textures_(context, uploader)
+    , indirect_first_instance_(context.GetDevice().Features().draw_indirect_first_instance)
+{
+    meshlets_.SetInstanceBuffer(cluster_instances_.Handle());
+    // Feedback is written from the fragment shader; albedo pages use BC7 where it exists.
+    const DeviceFeatures& features = context.GetDevice().Features();
+    if (features.fragment_stores_and_atomics)
+    {
+        const TextureFormat format = features.texture_compression_bc ? TextureFormat::BC7 : TextureFormat::RGBA8;
+        const VkExtent2D screen = context.SwapchainExtent();
+        virtual_textures_ = std::make_unique<VirtualTextureAtlas>(
+            context, uploader, ToVkFormat(format, true), VirtualTextureAtlas::AtlasPagesPerAxis(screen));
+        virtual_textures_->SetFeedbackExtent(screen);
+    }
+    for (uint32_t slot = 0; slot < VulkanContext::kMaxFramesInFlight; ++slot)
+    {
+        ReserveStorage(context_.GetDevice(), instance_meshes_[slot], sizeof(uint32_t));
+        ReserveStorage(context_.GetDevice(), instance_textures_[slot], sizeof(uint32_t));
+        ReserveStorage(context_.GetDevice(), quantizations_[slot], sizeof(GpuQuantization));
+        cluster_staging_[slot] = Buffer(
+            context_.GetDevice(), cluster_instances_.Size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kHostVisible);
+    }
+    CreateDescriptors();
+    CreatePipeline();
+}
+
+DeferredRenderer::~DeferredRenderer()
+{
+    vkDestroyPipeline(device_, pipeline_, nullptr);
+    vkDestroyPipelineLayout(device_, pipeline_layout_, nullptr);
+    vkDestroyDescriptorPool(device_, descriptor_pool_, nullptr);
+    vkDestroyDescriptorSetLayout(device_, set_layout_, nullptr);
+}
+
 const char* DeferredRenderer::Name() const
 {
     return "Deferred Renderer";
@@ -16,6 +120,31 @@ RendererType DeferredRenderer::Type() const
     return RendererType::Deferred;
 }
 
+GpuSkinning& DeferredRenderer::Skinning()
+{
+    return skinning_;
+}
+
+TextureStreamer* DeferredRenderer::Textures()
+{
+    return &textures_;
+}
+
+VirtualTextureAtlas* DeferredRenderer::VirtualTextures()
+{
+    return virtual_textures_.get();
+}
+
+void DeferredRenderer::SetMaterialVirtualTexture(uint64_t material_key, uint32_t texture)
+{
+    if (texture == VirtualPageTable::kInvalidTexture)
+    {
+        material_virtual_textures_.erase(material_key);
+        return;
+    }
+    material_virtual_textures_[material_key] = texture;
+}
+
 void DeferredRenderer::RenderGui(const FrameDescriptor& frame)
 {
     ImGui::Begin("ZOKATA Renderer");
@@ -28,13 +157,54 @@ void DeferredRenderer::RenderGui(const FrameDescriptor& frame)
 
     ImGui::SliderInt("MSAA samples", &samples_, 1, 8);
     ImGui::Checkbox("Recreate G-Buffer", &recreate_gbuffer_);
+    ImGui::Checkbox("Geometry heap", &show_heap_);
+    // Meshlet draws are indirect and index instances through firstInstance.
+    if (indirect_first_instance_)
+    {
+        ImGui::Checkbox("Meshlet culling", &meshlet_culling_);
+        ImGui::SameLine();
+        ImGui::Checkbox("Stats##meshlets", &show_meshlets_);
+    }
+    ImGui::Checkbox("Skinning", &show_skinning_);
+    ImGui::SameLine();
+    ImGui::Checkbox("Textures", &show_textures_);
+    if (virtual_textures_)
+    {
+        ImGui::SameLine();
+        ImGui::Checkbox("Virtual textures", &show_virtual_textures_);
+    }
 
     ImGui::Spacing();
+    ImGui::Text("Geometry pass: %u draws (%s), %u clusters",
+                heap_.Stats().draws,
+                indirect_first_instance_ ? "indirect" : "direct, no indirect firstInstance",
+                meshlets_.ClusterCount());
     ImGui::TextWrapped(
-        "Deferred path placeholder: G-Buffer targets (albedo/normal/depth) "
-        "and lighting/composition passes should be wired here.");
+        "Opaque geometry is drawn forward with a fixed light; G-Buffer targets "
+        "(albedo/normal/depth) and lighting/composition passes should be wired here.");
     ImGui::End();
 
+    if (show_heap_)
+    {
+        heap_.DrawDebugGui();
+    }
+    if (show_meshlets_)
+    {
+        meshlets_.DrawDebugGui();
+    }
+    if (show_skinning_)
+    {
+        skinning_.DrawDebugGui();
+    }
+    if (show_textures_)
+    {
+        textures_.DrawDebugGui();
+    }
+    if (show_virtual_textures_ && virtual_textures_)
+    {
+        virtual_textures_->DrawDebugGui();
+    }
+
     const ImGuiWindowFlags overlay_flags = ImGuiWindowFlags_NoDecoration
         | ImGuiWindowFlags_AlwaysAutoResize
         | ImGuiWindowFlags_NoSavedSettings
@@ -55,14 +225,446 @@ void DeferredRenderer::RenderGui(const FrameDescriptor& frame)
     {
         ImGui::Text("FPS: %.1f", 1.0F / (std::max)(frame.delta_seconds, 0.0001F));
         ImGui::Text("MSAA: x%d", samples_);
+        if (frame.draw_list != nullptr)
+        {
+            ImGui::Text("Draws: %zu (%zu batches)", frame.draw_list->items.size(), frame.draw_list->batches.size());
+        }
         ImGui::Text("Swapchain: %ux%u", last_extent_.width, last_extent_.height);
     }
     ImGui::End();
 }
 
+void DeferredRenderer::BeginFrame(const FrameDescriptor& frame)
+{
+    if (!virtual_textures_)
+    {
+        return;
+    }
+    // Exposes the slot's last readback to the engine's cache, then records the copy of what the
+    // previous frame's pass requested; it only runs once this frame is submitted, after the
+    // cache has read the old copy.
+    virtual_textures_->BeginFrame(frame.frame_slot);
+    virtual_textures_->RecordFeedbackReadback(frame.command_buffer, frame.frame_slot);
+}
+
+void DeferredRenderer::RecordFrame(const FrameDescriptor& frame)
+{
+    // BeginFrame waited on the slot's fence and UploadService::BeginFrame has already run.
+    heap_.BeginFrame(frame.frame_slot);
+    textures_.BeginFrame(frame.frame_slot);
+    skinning_.RecordUploads(frame.command_buffer, frame.frame_slot);
+    skinning_.RecordSkinning(frame.command_buffer);
+    if (frame.draw_list == nullptr)
+    {
+        return;
+    }
+    const DrawList& draws = *frame.draw_list;
+    bool replaced = instances_.Upload(draws, frame.frame_slot);
+
+    SplitBatches(draws);
+    heap_.WriteDraws(heap_batches_, frame.frame_slot);
+    replaced |= UploadMeshData(draws, frame.frame_slot);
+    if (replaced)
+    {
+        WriteDescriptors(frame.frame_slot);
+    }
+
+    if (meshlet_table_dirty_)
+    {
+        meshlets_.SetMeshlets(meshlet_table_);
+        meshlet_table_dirty_ = false;
+    }
+    meshlets_.SetClusters(clusters_);
+    if (clusters_.empty())
+    {
+        return;
+    }
+    RecordClusterInstanceUploads(frame.command_buffer, frame.frame_slot);
+    meshlets_.RecordUploads(frame.command_buffer, frame.frame_slot);
+    meshlets_.RecordCull(frame.command_buffer, draws.view_projection, draws.camera_position, frame.frame_slot);
+}
+
+void DeferredRenderer::RecordPass(const FrameDescriptor& frame)
+{
+    if (frame.draw_list == nullptr || frame.draw_list->batches.empty())
+    {
+        return;
+    }
+    const VkCommandBuffer cmd = frame.command_buffer;
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_);
+    vkCmdBindDescriptorSets(
+        cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout_, 0, 1, &sets_[frame.frame_slot], 0, nullptr);
+    if (virtual_textures_)
+    {
+        const VkDescriptorSet atlas_set = virtual_textures_->DescriptorSet(frame.frame_slot);
+        vkCmdBindDescriptorSets(
+            cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout_, 1, 1, &atlas_set, 0, nullptr);
+    }
+    const GeometryPushConstants push {frame.draw_list->view_projection};
+    vkCmdPushConstants(cmd, pipeline_layout_, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push), &push);
+
+    const VkViewport viewport {
+        0.0F, 0.0F, static_cast<float>(frame.extent.width), static_cast<float>(frame.extent.height), 0.0F, 1.0F};
+    const VkRect2D scissor {{0, 0}, frame.extent};
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+    heap_.Bind(cmd);
+    if (indirect_first_instance_)
+    {
+        heap_.RecordDraws(cmd, frame.frame_slot);
+        meshlets_.RecordDraws(cmd);
+        return;
+    }
+    for (const DrawBatch& batch : frame.draw_list->batches)
+    {
+        const uint32_t mesh = heap_.Find(*batch.geometry);
+        if (mesh == GeometryHeap::kInvalidMesh || !heap_.IsResident(mesh))
+        {
+            continue;
+        }
+        const GpuMeshDraw& draw = heap_.Mesh(mesh);
+        InstanceBuffer::RecordBatch(cmd, batch, draw.index_count, draw.first_index, draw.vertex_offset);
+    }
+}
+
+bool DeferredRenderer::UploadMeshData(const DrawList& draws, uint32_t frame_slot)
+{
+    // Batches are added to the heap by now; ones that are not are never drawn.
+    mesh_ids_.assign(draws.instances.size(), 0);
+    texture_ids_.assign(draws.instances.size(), VirtualPageTable::kInvalidTexture);
+    for (const DrawBatch& batch : draws.batches)
+    {
+        const uint32_t mesh = batch.geometry != nullptr ? heap_.Find(*batch.geometry) : GeometryHeap::kInvalidMesh;
+        if (mesh != GeometryHeap::kInvalidMesh)
+        {
+            std::fill_n(mesh_ids_.begin() + batch.first_instance, batch.instance_count, mesh);
+        }
+        if (material_virtual_textures_.empty() || batch.renderable == nullptr)
+        {
+            continue;
+        }
+        const auto texture = material_virtual_textures_.find(batch.renderable->MaterialKey());
+        if (texture != material_virtual_textures_.end())
+        {
+            std::fill_n(texture_ids_.begin() + batch.first_instance, batch.instance_count, texture->second);
+        }
+    }
+
+    const std::span<const VertexQuantization> quantizations = heap_.Quantizations();
+    const Device& device = context_.GetDevice();
+    bool replaced = ReserveStorage(device, instance_meshes_[frame_slot], mesh_ids_.size() * sizeof(uint32_t));
+    replaced |= ReserveStorage(device, instance_textures_[frame_slot], texture_ids_.size() * sizeof(uint32_t));
+    replaced |= ReserveStorage(device, quantizations_[frame_slot], quantizations.size() * sizeof(GpuQuantization));
+
+    if (!mesh_ids_.empty())
+    {
+        instance_meshes_[frame_slot].Write(mesh_ids_.data(), mesh_ids_.size() * sizeof(uint32_t), 0);
+        instance_textures_[frame_slot].Write(texture_ids_.data(), texture_ids_.size() * sizeof(uint32_t), 0);
+    }
+    auto* gpu = static_cast<GpuQuantization*>(quantizations_[frame_slot].Mapped());
+    for (size_t i = 0; i < quantizations.size(); ++i)
+    {
+        const VertexQuantization& q = quantizations[i];
+        gpu[i] = GpuQuantization{
+            MATH::Vec4f{q.offset.x, q.offset.y, q.offset.z, 0.0F}, MATH::Vec4f{q.scale.x, q.scale.y, q.scale.z, 0.0F}};
+    }
+    return replaced;
+}
+
+void DeferredRenderer::SplitBatches(const DrawList& draws)
+{
+    heap_batches_.clear();
+    clusters_.clear();
+    gpu_instances_.clear();
+    const bool use_meshlets = meshlet_culling_ && indirect_first_instance_;
+
+    for (const DrawBatch& batch : draws.batches)
+    {
+        const MeshletRange* range = use_meshlets ? FindMeshlets(batch) : nullptr;
+        const uint32_t end_instance = batch.first_instance + batch.instance_count;
+        const size_t cluster_count = range == nullptr ? 0 : static_cast<size_t>(batch.instance_count) * range->count;
+        if (range == nullptr || end_instance > kMaxClusterInstances || clusters_.size() + cluster_count > kMaxClusters)
+        {
+            heap_batches_.push_back(batch);
+            continue;
+        }
+
+        // Cluster draws use the instance index as firstInstance, so records keep DrawList indices.
+        if (gpu_instances_.size() < end_instance)
+        {
+            gpu_instances_.resize(end_instance);
+        }
+        for (uint32_t instance = batch.first_instance; instance < end_instance; ++instance)
+        {
+            gpu_instances_[instance].model = draws.instances[instance];
+            for (uint32_t meshlet = 0; meshlet < range->count; ++meshlet)
+            {
+                clusters_.push_back(GpuCluster{instance, range->first + meshlet});
+            }
+        }
+    }
+}
+
+void DeferredRenderer::RecordClusterInstanceUploads(VkCommandBuffer cmd, uint32_t frame_slot)
+{
+    // Records past the new count are never indexed, so a shrinking list uploads nothing extra.
+    const size_t count = gpu_instances_.size();
+    const size_t uploaded = uploaded_instances_.size();
+    const auto unchanged = [this](size_t index)
+    { return std::memcmp(&gpu_instances_[index], &uploaded_instances_[index], sizeof(GpuInstance)) == 0; };
+    size_t begin = 0;
+    while (begin < std::min(count, uploaded) && unchanged(begin))
+    {
+        ++begin;
+    }
+    size_t end = count;
+    while (end > begin && end <= uploaded && unchanged(end - 1))
+    {
+        --end;
+    }
+    uploaded_instances_.resize(count);
+    if (end == begin)
+    {
+        return;
+    }
+    std::copy(gpu_instances_.begin() + begin, gpu_instances_.begin() + end, uploaded_instances_.begin() + begin);
+
+    // The previous frame's cull and draws may still read the buffer.
+    VkMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    const VkDeviceSize offset = static_cast<VkDeviceSize>(begin) * sizeof(GpuInstance);
+    const VkDeviceSize size = static_cast<VkDeviceSize>(end - begin) * sizeof(GpuInstance);
+    cluster_staging_[frame_slot].Write(gpu_instances_.data() + begin, size, offset);
+    const VkBufferCopy copy {offset, offset, size};
+    vkCmdCopyBuffer(cmd, cluster_staging_[frame_slot].Handle(), cluster_instances_.Handle(), 1, &copy);
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                         0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+const DeferredRenderer::MeshletRange* DeferredRenderer::FindMeshlets(const DrawBatch& batch)
+{
+    // Meshlets describe level 0 only; coarser levels are small enough to draw whole.
+    if (batch.lod != 0 || batch.renderable == nullptr || batch.geometry == nullptr || batch.geometry->Empty())
+    {
+        return nullptr;
+    }
+    const std::vector<GpuMeshlet>* meshlets = batch.renderable->Meshlets();
+    if (meshlets == nullptr || meshlets->empty())
+    {
+        return nullptr;
+    }
+    const uint32_t mesh = heap_.GetOrAdd(*batch.geometry);
+    if (const auto found = meshlet_ranges_.find(mesh); found != meshlet_ranges_.end())
+    {
+        return &found->second;
+    }
+    if (!heap_.IsResident(mesh) || meshlet_table_.size() + meshlets->size() > kMaxMeshlets)
+    {
+        return nullptr;  // drawn by the heap (or skipped while streaming in)
+    }
+
+    // Rebase onto the mesh's place in the heap.
+    const GpuMeshDraw& draw = heap_.Mesh(mesh);
+    const MeshletRange range {static_cast<uint32_t>(meshlet_table_.size()), static_cast<uint32_t>(meshlets->size())};
+    for (GpuMeshlet meshlet : *meshlets)
+    {
+        meshlet.first_index += draw.first_index;
+        meshlet.vertex_offset += draw.vertex_offset;
+        meshlet_table_.push_back(meshlet);
+    }
+    meshlet_table_dirty_ = true;
+    return &meshlet_ranges_.emplace(mesh, range).first->second;
+}
+
 void DeferredRenderer::OnSwapchainUpdated(VkExtent2D extent)
 {
+    // The swapchain pass is recreated with the same formats, so the pipeline stays compatible.
     last_extent_ = extent;
     recreate_gbuffer_ = true;
+    if (virtual_textures_)
+    {
+        virtual_textures_->SetFeedbackExtent(extent);
+    }
+}
+
+void DeferredRenderer::CreateDescriptors()
+{
+    const std::array<VkDescriptorSetLayoutBinding, 4> bindings {{
+        {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr},
+        {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr},
+        {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr},
+    }};
+    VkDescriptorSetLayoutCreateInfo layout_info {};
+    layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.bindingCount = static_cast<uint32_t>(bindings.size());
+    layout_info.pBindings = bindings.data();
+    if (vkCreateDescriptorSetLayout(device_, &layout_info, nullptr, &set_layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create geometry pass descriptor set layout.");
+    }
+
+    const VkDescriptorPoolSize pool_size {
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<uint32_t>(bindings.size()) * VulkanContext::kMaxFramesInFlight};
+    VkDescriptorPoolCreateInfo pool_info {};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.maxSets = VulkanContext::kMaxFramesInFlight;
+    pool_info.poolSizeCount = 1;
+    pool_info.pPoolSizes = &pool_size;
+    if (vkCreateDescriptorPool(device_, &pool_info, nullptr, &descriptor_pool_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create geometry pass descriptor pool.");
+    }
+
+    std::array<VkDescriptorSetLayout, VulkanContext::kMaxFramesInFlight> layouts {};
+    layouts.fill(set_layout_);
+    VkDescriptorSetAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool = descriptor_pool_;
+    alloc_info.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+    alloc_info.pSetLayouts = layouts.data();
+    if (vkAllocateDescriptorSets(device_, &alloc_info, sets_.data()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate geometry pass descriptor sets.");
+    }
+    for (uint32_t slot = 0; slot < VulkanContext::kMaxFramesInFlight; ++slot)
+    {
+        WriteDescriptors(slot);
+    }
+}
+
+void DeferredRenderer::CreatePipeline()
+{
+    // Set 1 is the atlas' (ZKT_VT_SET in virtual_texture.glsl).
+    const std::array<VkDescriptorSetLayout, 2> set_layouts {
+        set_layout_, virtual_textures_ ? virtual_textures_->SetLayout() : VK_NULL_HANDLE};
+    const VkPushConstantRange push_range {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GeometryPushConstants)};
+    VkPipelineLayoutCreateInfo layout_info {};
+    layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_info.setLayoutCount = virtual_textures_ ? 2 : 1;
+    layout_info.pSetLayouts = set_layouts.data();
+    layout_info.pushConstantRangeCount = 1;
+    layout_info.pPushConstantRanges = &push_range;
+    if (vkCreatePipelineLayout(device_, &layout_info, nullptr, &pipeline_layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create geometry pass pipeline layout.");
+    }
+
+    const VkVertexInputBindingDescription vertex_binding = VertexBinding(heap_.GetVertexFormat(), 0);
+    const std::vector<VkVertexInputAttributeDescription> vertex_attributes = VertexAttributes(heap_.GetVertexFormat(), 0);
+    VkPipelineVertexInputStateCreateInfo vertex_input {};
+    vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertex_input.vertexBindingDescriptionCount = 1;
+    vertex_input.pVertexBindingDescriptions = &vertex_binding;
+    vertex_input.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertex_attributes.size());
+    vertex_input.pVertexAttributeDescriptions = vertex_attributes.data();
+
+    VkPipelineInputAssemblyStateCreateInfo input_assembly {};
+    input_assembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    input_assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewport_state {};
+    viewport_state.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport_state.viewportCount = 1;
+    viewport_state.scissorCount = 1;
+
+    // geometry.vert flips Y, which keeps counter-clockwise triangles front facing.
+    VkPipelineRasterizationStateCreateInfo rasterizer {};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+    rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterizer.lineWidth = 1.0F;
+
+    VkPipelineMultisampleStateCreateInfo multisample {};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depth_stencil {};
+    depth_stencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depth_stencil.depthTestEnable = VK_TRUE;
+    depth_stencil.depthWriteEnable = VK_TRUE;
+    depth_stencil.depthCompareOp = VK_COMPARE_OP_LESS;
+
+    VkPipelineColorBlendAttachmentState blend_attachment {};
+    blend_attachment.colorWriteMask =
+        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    VkPipelineColorBlendStateCreateInfo color_blend {};
+    color_blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    color_blend.attachmentCount = 1;
+    color_blend.pAttachments = &blend_attachment;
+
+    const std::array<VkDynamicState, 2> dynamic_states {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamic_state {};
+    dynamic_state.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic_state.dynamicStateCount = static_cast<uint32_t>(dynamic_states.size());
+    dynamic_state.pDynamicStates = dynamic_states.data();
+
+    // One build per vertex format, named after ZKT_VERTEX_FORMAT.
+    const std::string vertex_shader =
+        "geometry.vert." + std::to_string(static_cast<uint32_t>(heap_.GetVertexFormat())) + ".spv";
+    VkShaderModule vertex_module = LoadShaderModule(device_, ShaderPath(vertex_shader));
+    // The .vt build samples virtual textures and writes their feedback.
+    VkShaderModule fragment_module =
+        LoadShaderModule(device_, ShaderPath(virtual_textures_ ? "geometry.frag.vt.spv" : "geometry.frag.spv"));
+    const std::array<VkPipelineShaderStageCreateInfo, 2> stages {
+        ShaderStage(VK_SHADER_STAGE_VERTEX_BIT, vertex_module),
+        ShaderStage(VK_SHADER_STAGE_FRAGMENT_BIT, fragment_module),
+    };
+
+    VkGraphicsPipelineCreateInfo pipeline_info {};
+    pipeline_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipeline_info.stageCount = static_cast<uint32_t>(stages.size());
+    pipeline_info.pStages = stages.data();
+    pipeline_info.pVertexInputState = &vertex_input;
+    pipeline_info.pInputAssemblyState = &input_assembly;
+    pipeline_info.pViewportState = &viewport_state;
+    pipeline_info.pRasterizationState = &rasterizer;
+    pipeline_info.pMultisampleState = &multisample;
+    pipeline_info.pDepthStencilState = &depth_stencil;
+    pipeline_info.pColorBlendState = &color_blend;
+    pipeline_info.pDynamicState = &dynamic_state;
+    pipeline_info.layout = pipeline_layout_;
+    pipeline_info.renderPass = context_.RenderPass();
+    pipeline_info.subpass = 0;
+
+    const VkResult result = vkCreateGraphicsPipelines(device_, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &pipeline_);
+    vkDestroyShaderModule(device_, vertex_module, nullptr);
+    vkDestroyShaderModule(device_, fragment_module, nullptr);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create geometry pass pipeline.");
+    }
+}
+
+void DeferredRenderer::WriteDescriptors(uint32_t frame_slot)
+{
+    const std::array<VkDescriptorBufferInfo, 4> buffers {{
+        {instances_.Handle(frame_slot), 0, VK_WHOLE_SIZE},
+        {instance_meshes_[frame_slot].Handle(), 0, VK_WHOLE_SIZE},
+        {quantizations_[frame_slot].Handle(), 0, VK_WHOLE_SIZE},
+        {instance_textures_[frame_slot].Handle(), 0, VK_WHOLE_SIZE},
+    }};
+    VkWriteDescriptorSet write {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = sets_[frame_slot];
+    write.dstBinding = 0;
+    write.descriptorCount = static_cast<uint32_t>(buffers.size());
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = buffers.data();
+    vkUpdateDescriptorSets(device_, 1, &write, 0, nullptr);
 }
 }  // namespace ZKT
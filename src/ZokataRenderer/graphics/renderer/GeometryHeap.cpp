@@ -0,0 +1,402 @@
+#include "ZokataRenderer/graphics/renderer/GeometryHeap.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <imgui.h>
+
+#include "ZokataRenderer/graphics/renderer/UploadService.h"
+#include "ZokataRenderer/graphics/vk/Device.h"
+
+namespace ZKT
+{
+namespace
+{
+constexpr VkMemoryPropertyFlags kHostVisible =
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+constexpr uint32_t kInitialDrawCapacity = 256;
+
+uint32_t IndexSize(IndexFormat format)
+{
+    return format == IndexFormat::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+// Re-encodes a mesh's indices in the heap's index type.
+std::vector<uint8_t> ConvertIndices(const PackedMesh& mesh, IndexFormat target)
+{
+    if (mesh.index_format == target)
+    {
+        return mesh.indices;
+    }
+    std::vector<uint8_t> converted(static_cast<size_t>(mesh.index_count) * IndexSize(target));
+    for (uint32_t i = 0; i < mesh.index_count; ++i)
+    {
+        if (target == IndexFormat::UInt32)
+        {
+            uint16_t narrow = 0;
+            std::memcpy(&narrow, mesh.indices.data() + static_cast<size_t>(i) * sizeof(uint16_t), sizeof(narrow));
+            const uint32_t wide = narrow;
+            std::memcpy(converted.data() + static_cast<size_t>(i) * sizeof(uint32_t), &wide, sizeof(wide));
+        }
+        else
+        {
+            uint32_t wide = 0;
+            std::memcpy(&wide, mesh.indices.data() + static_cast<size_t>(i) * sizeof(uint32_t), sizeof(wide));
+            if (wide >= 0xFFFF)
+            {
+                throw std::runtime_error("GeometryHeap: mesh has too many vertices for 16-bit indices.");
+            }
+            const auto narrow = static_cast<uint16_t>(wide);
+            std::memcpy(converted.data() + static_cast<size_t>(i) * sizeof(uint16_t), &narrow, sizeof(narrow));
+        }
+    }
+    return converted;
+}
+}  // namespace
+
+GeometryHeap::GeometryHeap(
+    const VulkanContext& context,
+    UploadService& uploader,
+    VertexFormat vertex_format,
+    IndexFormat index_format,
+    uint32_t max_vertices,
+    uint32_t max_indices)
+    : context_(context)
+    , uploader_(uploader)
+    , device_(context.DeviceHandle())
+    , vertex_format_(vertex_format)
+    , index_format_(index_format)
+    , vertex_stride_(VertexStride(vertex_format))
+    , index_size_(IndexSize(index_format))
+    , multi_draw_(context.GetDevice().Features().multi_draw_indirect)
+    , vertex_ranges_(std::max(max_vertices, 1U))
+    , index_ranges_(std::max(max_indices, 1U))
+{
+    const Device& device = context_.GetDevice();
+    vertex_buffer_ = Buffer(
+        device,
+        static_cast<VkDeviceSize>(vertex_ranges_.Capacity()) * vertex_stride_,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    index_buffer_ = Buffer(
+        device,
+        static_cast<VkDeviceSize>(index_ranges_.Capacity()) * index_size_,
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    for (uint32_t i = 0; i < VulkanContext::kMaxFramesInFlight; ++i)
+    {
+        indirect_.emplace_back(
+            device,
+            static_cast<VkDeviceSize>(kInitialDrawCapacity) * sizeof(VkDrawIndexedIndirectCommand),
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            kHostVisible);
+    }
+    indirect_capacity_.assign(VulkanContext::kMaxFramesInFlight, kInitialDrawCapacity);
+    draw_counts_.assign(VulkanContext::kMaxFramesInFlight, 0);
+    retired_.resize(VulkanContext::kMaxFramesInFlight);
+    UpdateStats();
+}
+
+GeometryHeap::~GeometryHeap() = default;
+
+uint32_t GeometryHeap::Add(const PackedMesh& mesh)
+{
+    if (mesh.vertex_format != vertex_format_)
+    {
+        throw std::runtime_error(
+            std::string("GeometryHeap expects ") + VertexFormatName(vertex_format_) + " vertices, got "
+            + VertexFormatName(mesh.vertex_format) + ".");
+    }
+    if (mesh.vertex_count == 0 || mesh.index_count == 0)
+    {
+        throw std::runtime_error("GeometryHeap cannot add an empty mesh.");
+    }
+
+    std::vector<uint8_t> indices = ConvertIndices(mesh, index_format_);
+    const uint32_t vertex_offset = vertex_ranges_.Allocate(mesh.vertex_count);
+    if (vertex_offset == RangeAllocator::kInvalidOffset)
+    {
+        throw std::runtime_error("GeometryHeap vertex buffer is full.");
+    }
+    const uint32_t first_index = index_ranges_.Allocate(mesh.index_count);
+    if (first_index == RangeAllocator::kInvalidOffset)
+    {
+        vertex_ranges_.Free(vertex_offset, mesh.vertex_count);
+        throw std::runtime_error("GeometryHeap index buffer is full.");
+    }
+
+    uint32_t id = 0;
+    if (!free_ids_.empty())
+    {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(allocations_.size());
+        allocations_.emplace_back();
+        mesh_table_.emplace_back();
+        quantizations_.emplace_back();
+    }
+    allocations_[id] = Allocation{vertex_offset, mesh.vertex_count, first_index, mesh.index_count, nullptr, 0};
+    // Published by BeginFrame once the upload completes.
+    mesh_table_[id] = GpuMeshDraw {};
+    quantizations_[id] = mesh.quantization;
+    pending_.push_back(PendingUpload{id, mesh.vertices, std::move(indices)});
+    UpdateStats();
+    return id;
+}
+
+uint32_t GeometryHeap::GetOrAdd(const MeshGeometry& geometry)
+{
+    const uint32_t existing = Find(geometry);
+    if (existing != kInvalidMesh)
+    {
+        return existing;
+    }
+    const uint32_t id = Add(PackMesh(geometry, vertex_format_));
+    allocations_[id].source = &geometry;
+    geometry_ids_.emplace(&geometry, id);
+    return id;
+}
+
+uint32_t GeometryHeap::Find(const MeshGeometry& geometry) const
+{
+    const auto it = geometry_ids_.find(&geometry);
+    return it != geometry_ids_.end() ? it->second : kInvalidMesh;
+}
+
+void GeometryHeap::Release(uint32_t mesh)
+{
+    Allocation& allocation = allocations_.at(mesh);
+    if (allocation.vertex_count == 0)
+    {
+        return;
+    }
+    if (allocation.source != nullptr)
+    {
+        geometry_ids_.erase(allocation.source);
+        allocation.source = nullptr;
+    }
+    std::erase_if(pending_, [mesh](const PendingUpload& upload) { return upload.mesh == mesh; });
+    std::erase(uploading_, mesh);
+    mesh_table_[mesh] = GpuMeshDraw {};
+    retired_[frame_slot_].push_back(mesh);
+}
+
+void GeometryHeap::Release(const MeshGeometry& geometry)
+{
+    const uint32_t mesh = Find(geometry);
+    if (mesh != kInvalidMesh)
+    {
+        Release(mesh);
+    }
+}
+
+void GeometryHeap::Flush()
+{
+    for (PendingUpload& upload : pending_)
+    {
+        Allocation& allocation = allocations_[upload.mesh];
+        uploader_.Upload(
+            vertex_buffer_.Handle(),
+            static_cast<VkDeviceSize>(allocation.vertex_offset) * vertex_stride_,
+            std::move(upload.vertices));
+        // Tickets complete in order, so the index upload's covers both.
+        allocation.upload_ticket = uploader_.Upload(
+            index_buffer_.Handle(),
+            static_cast<VkDeviceSize>(allocation.first_index) * index_size_,
+            std::move(upload.indices));
+        uploading_.push_back(upload.mesh);
+    }
+    pending_.clear();
+    UpdateStats();
+}
+
+void GeometryHeap::BeginFrame(uint32_t frame_slot)
+{
+    frame_slot_ = frame_slot;
+    std::erase_if(uploading_, [this](uint32_t mesh) {
+        const Allocation& allocation = allocations_[mesh];
+        if (!uploader_.IsComplete(allocation.upload_ticket))
+        {
+            return false;
+        }
+        mesh_table_[mesh] = GpuMeshDraw{
+            allocation.index_count, allocation.first_index, static_cast<int32_t>(allocation.vertex_offset), 0};
+        return true;
+    });
+
+    // A released mesh may still have copies in flight; its ranges wait for them too.
+    std::erase_if(retired_[frame_slot], [this](uint32_t mesh) {
+        Allocation& allocation = allocations_[mesh];
+        if (!uploader_.IsComplete(allocation.upload_ticket))
+        {
+            return false;
+        }
+        vertex_ranges_.Free(allocation.vertex_offset, allocation.vertex_count);
+        index_ranges_.Free(allocation.first_index, allocation.index_count);
+        allocation = Allocation {};
+        free_ids_.push_back(mesh);
+        return true;
+    });
+    UpdateStats();
+}
+
+bool GeometryHeap::IsResident(uint32_t mesh) const
+{
+    return mesh_table_.at(mesh).index_count > 0;
+}
+
+const GpuMeshDraw& GeometryHeap::Mesh(uint32_t mesh) const
+{
+    return mesh_table_.at(mesh);
+}
+
+std::span<const GpuMeshDraw> GeometryHeap::MeshTable() const
+{
+    return mesh_table_;
+}
+
+std::span<const VertexQuantization> GeometryHeap::Quantizations() const
+{
+    return quantizations_;
+}
+
+uint32_t GeometryHeap::WriteDraws(const DrawList& draws, uint32_t frame_slot)
+{
+    return WriteDraws(std::span<const DrawBatch>(draws.batches), frame_slot);
+}
+
+uint32_t GeometryHeap::WriteDraws(std::span<const DrawBatch> batches, uint32_t frame_slot)
+{
+    commands_.clear();
+    commands_.reserve(batches.size());
+    for (const DrawBatch& batch : batches)
+    {
+        if (batch.geometry == nullptr || batch.geometry->Empty())
+        {
+            continue;
+        }
+        const GpuMeshDraw& mesh = mesh_table_[GetOrAdd(*batch.geometry)];
+        if (mesh.index_count == 0)
+        {
+            continue;  // still streaming in
+        }
+        commands_.push_back(VkDrawIndexedIndirectCommand{
+            mesh.index_count, batch.instance_count, mesh.first_index, mesh.vertex_offset, batch.first_instance});
+    }
+    Flush();
+
+    const auto count = static_cast<uint32_t>(commands_.size());
+    if (count > indirect_capacity_[frame_slot])
+    {
+        const uint32_t capacity = std::bit_ceil(count);
+        indirect_[frame_slot] = Buffer(
+            context_.GetDevice(),
+            static_cast<VkDeviceSize>(capacity) * sizeof(VkDrawIndexedIndirectCommand),
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            kHostVisible);
+        indirect_capacity_[frame_slot] = capacity;
+    }
+    if (count > 0)
+    {
+        indirect_[frame_slot].Write(commands_.data(), static_cast<VkDeviceSize>(count) * sizeof(VkDrawIndexedIndirectCommand), 0);
+    }
+    draw_counts_[frame_slot] = count;
+    stats_.draws = count;
+    return count;
+}
+
+void GeometryHeap::Bind(VkCommandBuffer cmd) const
+{
+    const VkBuffer vertex_buffer = vertex_buffer_.Handle();
+    const VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(cmd, 0, 1, &vertex_buffer, &offset);
+    vkCmdBindIndexBuffer(cmd, index_buffer_.Handle(), 0, IndexType());
+}
+
+void GeometryHeap::RecordDraws(VkCommandBuffer cmd, uint32_t frame_slot) const
+{
+    const uint32_t count = draw_counts_.at(frame_slot);
+    if (count == 0)
+    {
+        return;
+    }
+    constexpr auto kStride = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+    const VkBuffer commands = indirect_[frame_slot].Handle();
+    if (multi_draw_)
+    {
+        vkCmdDrawIndexedIndirect(cmd, commands, 0, count, kStride);
+        return;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        vkCmdDrawIndexedIndirect(cmd, commands, static_cast<VkDeviceSize>(i) * kStride, 1, kStride);
+    }
+}
+
+VkBuffer GeometryHeap::VertexBuffer() const
+{
+    return vertex_buffer_.Handle();
+}
+
+VkBuffer GeometryHeap::IndexBuffer() const
+{
+    return index_buffer_.Handle();
+}
+
+VertexFormat GeometryHeap::GetVertexFormat() const
+{
+    return vertex_format_;
+}
+
+VkIndexType GeometryHeap::IndexType() const
+{
+    return ToVkIndexType(index_format_);
+}
+
+const GeometryHeapStats& GeometryHeap::Stats() const
+{
+    return stats_;
+}
+
+void GeometryHeap::DrawDebugGui()
+{
+    if (!ImGui::Begin("Geometry Heap"))
+    {
+        ImGui::End();
+        return;
+    }
+    ImGui::Text("Format: %s, %s indices", VertexFormatName(vertex_format_), index_format_ == IndexFormat::UInt16 ? "16-bit" : "32-bit");
+    ImGui::Text("Path: %s", multi_draw_ ? "MultiDrawIndirect" : "Indirect loop");
+    ImGui::Separator();
+    ImGui::Text("Meshes: %u (%u uploading)", stats_.meshes, stats_.uploading);
+    ImGui::Text("Vertices: %u / %u (%u free blocks, largest %u)",
+                stats_.vertices_used,
+                vertex_ranges_.Capacity(),
+                stats_.vertex_free_blocks,
+                vertex_ranges_.LargestFreeBlock());
+    ImGui::Text("Indices: %u / %u (%u free blocks, largest %u)",
+                stats_.indices_used,
+                index_ranges_.Capacity(),
+                stats_.index_free_blocks,
+                index_ranges_.LargestFreeBlock());
+    ImGui::Text("Indirect draws: %u", stats_.draws);
+    ImGui::End();
+}
+
+void GeometryHeap::UpdateStats()
+{
+    stats_.meshes = static_cast<uint32_t>(allocations_.size() - free_ids_.size());
+    stats_.vertices_used = vertex_ranges_.Used();
+    stats_.indices_used = index_ranges_.Used();
+    stats_.vertex_free_blocks = vertex_ranges_.FreeBlockCount();
+    stats_.index_free_blocks = index_ranges_.FreeBlockCount();
+    stats_.uploading = static_cast<uint32_t>(uploading_.size() + pending_.size());
+}
+}  // namespace ZKT
@@ -0,0 +1,817 @@
+#include "ZokataRenderer/graphics/renderer/GpuCulling.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+#include <imgui.h>
+
+#include "ZokataMath/Bounds.h"
+#include "ZokataRenderer/graphics/vk/Device.h"
+#include "ZokataRenderer/graphics/vk/Shader.h"
+
+namespace ZKT
+{
+namespace
+{
+constexpr uint32_t kCullGroupSize = 64;
+constexpr uint32_t kPyramidGroupSize = 8;
+constexpr VkDeviceSize kCountBytes = 2 * sizeof(uint32_t);
+
+uint32_t GroupCount(uint32_t items, uint32_t group_size)
+{
+    return (items + group_size - 1) / group_size;
+}
+
+VkPipeline CreateComputePipeline(VkDevice device, VkPipelineLayout layout, const char* shader_name)
+{
+    VkShaderModule module = LoadShaderModule(device, ShaderPath(shader_name));
+
+    VkComputePipelineCreateInfo pipeline_info {};
+    pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipeline_info.stage.module = module;
+    pipeline_info.stage.pName = "main";
+    pipeline_info.layout = layout;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    const VkResult result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &pipeline);
+    vkDestroyShaderModule(device, module, nullptr);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error(std::string("Failed to create compute pipeline: ") + shader_name);
+    }
+    return pipeline;
+}
+
+void BufferBarrier(
+    VkCommandBuffer cmd,
+    VkBuffer buffer,
+    VkAccessFlags src_access,
+    VkAccessFlags dst_access,
+    VkPipelineStageFlags src_stage,
+    VkPipelineStageFlags dst_stage)
+{
+    VkBufferMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = src_access;
+    barrier.dstAccessMask = dst_access;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = buffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(cmd, src_stage, dst_stage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+void PyramidBarrier(VkCommandBuffer cmd, VkImage image, uint32_t base_mip, uint32_t mip_count, VkPipelineStageFlags dst_stage)
+{
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, base_mip, mip_count, 0, 1};
+    vkCmdPipelineBarrier(
+        cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dst_stage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+}  // namespace
+
+GpuCulling::GpuCulling(const VulkanContext& context, uint32_t max_instances, uint32_t max_meshes)
+    : context_(context)
+    , device_(context.DeviceHandle())
+    , max_instances_(std::max(max_instances, 1U))
+    , max_meshes_(std::max(max_meshes, 1U))
+{
+    static_assert(sizeof(CullUniforms) == 176, "CullUniforms must match the std140 layout");
+
+    const DeviceFeatures& features = context_.GetDevice().Features();
+    compact_ = features.draw_indirect_count;
+    multi_draw_ = features.multi_draw_indirect;
+
+    instances_.reserve(max_instances_);
+    CreateBuffers();
+    CreateDescriptors();
+    CreatePipelines();
+    CreateFallbackPyramid();
+    WriteCullDescriptors();
+}
+
+GpuCulling::~GpuCulling()
+{
+    DestroyPyramid();
+    vkDestroyImageView(device_, fallback_view_, nullptr);
+    vkDestroyImage(device_, fallback_pyramid_, nullptr);
+    vkFreeMemory(device_, fallback_memory_, nullptr);
+    vkDestroyPipeline(device_, cull_pipeline_, nullptr);
+    vkDestroyPipeline(device_, pyramid_pipeline_, nullptr);
+    vkDestroyPipelineLayout(device_, cull_layout_, nullptr);
+    vkDestroyPipelineLayout(device_, pyramid_layout_, nullptr);
+    vkDestroyDescriptorPool(device_, descriptor_pool_, nullptr);
+    vkDestroyDescriptorSetLayout(device_, cull_set_layout_, nullptr);
+    vkDestroyDescriptorSetLayout(device_, pyramid_set_layout_, nullptr);
+    vkDestroySampler(device_, sampler_, nullptr);
+}
+
+void GpuCulling::SetMeshes(std::span<const GpuMeshDraw> meshes)
+{
+    if (meshes.size() > max_meshes_)
+    {
+        throw std::runtime_error("GpuCulling mesh table exceeds capacity.");
+    }
+    meshes_.assign(meshes.begin(), meshes.end());
+    meshes_dirty_ = true;
+}
+
+void GpuCulling::SetInstances(std::span<const GpuInstance> instances)
+{
+    if (instances.size() > max_instances_)
+    {
+        throw std::runtime_error("GpuCulling instance count exceeds capacity.");
+    }
+    instances_.assign(instances.begin(), instances.end());
+    dirty_begin_ = 0;
+    dirty_end_ = static_cast<uint32_t>(instances_.size());
+    reset_visibility_ = true;
+}
+
+void GpuCulling::UpdateInstance(uint32_t index, const GpuInstance& instance)
+{
+    if (index >= instances_.size())
+    {
+        throw std::runtime_error("GpuCulling instance index out of range.");
+    }
+    instances_[index] = instance;
+    if (dirty_begin_ == dirty_end_)
+    {
+        dirty_begin_ = index;
+        dirty_end_ = index + 1;
+        return;
+    }
+    dirty_begin_ = std::min(dirty_begin_, index);
+    dirty_end_ = std::max(dirty_end_, index + 1);
+}
+
+uint32_t GpuCulling::InstanceCount() const
+{
+    return static_cast<uint32_t>(instances_.size());
+}
+
+VkBuffer GpuCulling::InstanceBuffer() const
+{
+    return instance_buffer_.Handle();
+}
+
+void GpuCulling::SetOcclusionEnabled(bool enabled)
+{
+    occlusion_enabled_ = enabled;
+}
+
+const GpuCullingStats& GpuCulling::Stats() const
+{
+    return stats_;
+}
+
+void GpuCulling::SetDepthSource(VkImageView depth_view, VkExtent2D extent)
+{
+    depth_view_ = depth_view;
+    depth_extent_ = extent;
+    CreatePyramid(extent);
+    WriteCullDescriptors();
+    WritePyramidDescriptors();
+}
+
+void GpuCulling::RecordUploads(VkCommandBuffer cmd, uint32_t frame_slot)
+{
+    // The slot's fence has been waited on by BeginFrame, so its readback is complete.
+    if (readback_pending_[frame_slot])
+    {
+        const auto* counts = static_cast<const uint32_t*>(readback_[frame_slot].Mapped());
+        stats_.early_draws = counts[0];
+        stats_.late_draws = counts[1];
+        readback_pending_[frame_slot] = false;
+    }
+    stats_.instances = InstanceCount();
+
+    Buffer& staging = staging_[frame_slot];
+    std::array<VkBufferCopy, 1> copy {};
+    bool uploaded = false;
+
+    if (dirty_end_ > dirty_begin_)
+    {
+        const VkDeviceSize offset = static_cast<VkDeviceSize>(dirty_begin_) * sizeof(GpuInstance);
+        const VkDeviceSize size = static_cast<VkDeviceSize>(dirty_end_ - dirty_begin_) * sizeof(GpuInstance);
+        staging.Write(instances_.data() + dirty_begin_, size, offset);
+        copy[0] = VkBufferCopy{offset, offset, size};
+        vkCmdCopyBuffer(cmd, staging.Handle(), instance_buffer_.Handle(), 1, copy.data());
+        dirty_begin_ = dirty_end_ = 0;
+        uploaded = true;
+    }
+
+    if (meshes_dirty_ && !meshes_.empty())
+    {
+        const VkDeviceSize staging_offset = static_cast<VkDeviceSize>(max_instances_) * sizeof(GpuInstance);
+        const VkDeviceSize size = meshes_.size() * sizeof(GpuMeshDraw);
+        staging.Write(meshes_.data(), size, staging_offset);
+        copy[0] = VkBufferCopy{staging_offset, 0, size};
+        vkCmdCopyBuffer(cmd, staging.Handle(), mesh_buffer_.Handle(), 1, copy.data());
+        meshes_dirty_ = false;
+        uploaded = true;
+    }
+
+    if (reset_visibility_)
+    {
+        vkCmdFillBuffer(cmd, visibility_buffer_.Handle(), 0, VK_WHOLE_SIZE, 0);
+        reset_visibility_ = false;
+        uploaded = true;
+    }
+
+    if (uploaded)
+    {
+        VkMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(
+            cmd,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+}
+
+void GpuCulling::RecordCull(
+    VkCommandBuffer cmd, CullPhase phase, const MATH::Mat4f& view_projection, uint32_t frame_slot)
+{
+    const uint32_t instance_count = InstanceCount();
+    const auto phase_index = static_cast<uint32_t>(phase);
+
+    if (phase == CullPhase::Early)
+    {
+        CullUniforms uniforms {};
+        uniforms.view_projection = view_projection;
+        const MATH::Frustum frustum = MATH::Frustum::FromViewProjection(view_projection);
+        for (int i = 0; i < MATH::Frustum::kPlaneCount; ++i)
+        {
+            const MATH::Plane& plane = frustum.planes[i];
+            uniforms.planes[i] = MATH::Vec4f{plane.normal.x, plane.normal.y, plane.normal.z, plane.d};
+        }
+        uniforms.pyramid_size[0] = static_cast<float>(pyramid_extent_.width);
+        uniforms.pyramid_size[1] = static_cast<float>(pyramid_extent_.height);
+        uniforms.instance_count = instance_count;
+        uniforms.occlusion_enabled = occlusion_enabled_ && pyramid_valid_ ? 1U : 0U;
+        uniform_buffer_.Write(&uniforms, sizeof(uniforms), uniform_stride_ * frame_slot);
+
+        // Counts for both phases and (without draw-count support) every command slot start at zero.
+        vkCmdFillBuffer(cmd, count_buffer_.Handle(), 0, kCountBytes, 0);
+        if (!compact_)
+        {
+            vkCmdFillBuffer(cmd, command_buffer_.Handle(), 0, VK_WHOLE_SIZE, 0);
+        }
+        VkMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(
+            cmd,
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+    else
+    {
+        // The late phase reads the early phase's visibility flags and adds to its draw counts.
+        VkMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(
+            cmd,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    if (instance_count > 0)
+    {
+        const CullPushConstants push {
+            .phase = phase_index,
+            .command_offset = phase_index * max_instances_,
+            .compact = compact_ ? 1U : 0U,
+        };
+        const auto dynamic_offset = static_cast<uint32_t>(uniform_stride_ * frame_slot);
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cull_pipeline_);
+        vkCmdBindDescriptorSets(
+            cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cull_layout_, 0, 1, &cull_set_, 1, &dynamic_offset);
+        vkCmdPushConstants(cmd, cull_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+        vkCmdDispatch(cmd, GroupCount(instance_count, kCullGroupSize), 1, 1);
+    }
+
+    BufferBarrier(
+        cmd,
+        command_buffer_.Handle(),
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+    BufferBarrier(
+        cmd,
+        count_buffer_.Handle(),
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    if (phase == CullPhase::Late)
+    {
+        const VkBufferCopy copy {0, 0, kCountBytes};
+        vkCmdCopyBuffer(cmd, count_buffer_.Handle(), readback_[frame_slot].Handle(), 1, &copy);
+        readback_pending_[frame_slot] = true;
+    }
+}
+
+void GpuCulling::RecordDepthPyramid(VkCommandBuffer cmd)
+{
+    if (pyramid_ == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    // The early cull may still be sampling last frame's pyramid.
+    vkCmdPipelineBarrier(
+        cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pyramid_pipeline_);
+
+    VkExtent2D src = depth_extent_;
+    VkExtent2D dst = pyramid_extent_;
+    const auto levels = static_cast<uint32_t>(pyramid_mips_.size());
+    for (uint32_t level = 0; level < levels; ++level)
+    {
+        const PyramidPushConstants push {
+            .src_size = {static_cast<int32_t>(src.width), static_cast<int32_t>(src.height)},
+            .dst_size = {static_cast<int32_t>(dst.width), static_cast<int32_t>(dst.height)},
+        };
+        vkCmdBindDescriptorSets(
+            cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pyramid_layout_, 0, 1, &pyramid_sets_[level], 0, nullptr);
+        vkCmdPushConstants(cmd, pyramid_layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+        vkCmdDispatch(cmd, GroupCount(dst.width, kPyramidGroupSize), GroupCount(dst.height, kPyramidGroupSize), 1);
+
+        PyramidBarrier(cmd, pyramid_, level, 1, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+        src = dst;
+        dst = VkExtent2D{std::max(dst.width / 2, 1U), std::max(dst.height / 2, 1U)};
+    }
+    pyramid_valid_ = true;
+}
+
+void GpuCulling::RecordDraws(VkCommandBuffer cmd, CullPhase phase) const
+{
+    const uint32_t instance_count = InstanceCount();
+    if (instance_count == 0)
+    {
+        return;
+    }
+
+    constexpr auto kStride = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+    const VkDeviceSize offset = CommandRegionOffset(phase);
+    if (compact_)
+    {
+        const VkDeviceSize count_offset = static_cast<VkDeviceSize>(phase) * sizeof(uint32_t);
+        vkCmdDrawIndexedIndirectCount(
+            cmd, command_buffer_.Handle(), offset, count_buffer_.Handle(), count_offset, instance_count, kStride);
+        return;
+    }
+
+    // Culled slots hold zeroed commands (instanceCount == 0) and draw nothing.
+    if (multi_draw_)
+    {
+        vkCmdDrawIndexedIndirect(cmd, command_buffer_.Handle(), offset, instance_count, kStride);
+        return;
+    }
+    for (uint32_t i = 0; i < instance_count; ++i)
+    {
+        vkCmdDrawIndexedIndirect(cmd, command_buffer_.Handle(), offset + static_cast<VkDeviceSize>(i) * kStride, 1, kStride);
+    }
+}
+
+void GpuCulling::DrawDebugGui()
+{
+    if (!ImGui::Begin("GPU Culling"))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Path: %s", compact_ ? "DrawIndexedIndirectCount" : (multi_draw_ ? "MultiDrawIndirect" : "Indirect loop"));
+    ImGui::Checkbox("Hi-Z occlusion", &occlusion_enabled_);
+    ImGui::Separator();
+    ImGui::Text("Instances: %u / %u", stats_.instances, max_instances_);
+    ImGui::Text("Early draws: %u", stats_.early_draws);
+    ImGui::Text("Late draws: %u", stats_.late_draws);
+    ImGui::Text("Culled: %u", stats_.instances - std::min(stats_.instances, stats_.early_draws + stats_.late_draws));
+    ImGui::Text("Hi-Z: %ux%u, %zu levels", pyramid_extent_.width, pyramid_extent_.height, pyramid_mips_.size());
+    ImGui::End();
+}
+
+void GpuCulling::CreateBuffers()
+{
+    const Device& device = context_.GetDevice();
+    constexpr VkMemoryPropertyFlags kDeviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    constexpr VkMemoryPropertyFlags kHostVisible =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    const VkDeviceSize instance_bytes = static_cast<VkDeviceSize>(max_instances_) * sizeof(GpuInstance);
+    const VkDeviceSize mesh_bytes = static_cast<VkDeviceSize>(max_meshes_) * sizeof(GpuMeshDraw);
+
+    instance_buffer_ = Buffer(
+        device, instance_bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, kDeviceLocal);
+    mesh_buffer_ = Buffer(
+        device, mesh_bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, kDeviceLocal);
+    command_buffer_ = Buffer(
+        device,
+        2 * static_cast<VkDeviceSize>(max_instances_) * sizeof(VkDrawIndexedIndirectCommand),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        kDeviceLocal);
+    count_buffer_ = Buffer(
+        device,
+        kCountBytes,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+            | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        kDeviceLocal);
+    visibility_buffer_ = Buffer(
+        device,
+        static_cast<VkDeviceSize>(max_instances_) * sizeof(uint32_t),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        kDeviceLocal);
+
+    VkPhysicalDeviceProperties properties {};
+    vkGetPhysicalDeviceProperties(context_.PhysicalDevice(), &properties);
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 1);
+    uniform_stride_ = (sizeof(CullUniforms) + alignment - 1) / alignment * alignment;
+    uniform_buffer_ = Buffer(
+        device, uniform_stride_ * VulkanContext::kMaxFramesInFlight, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, kHostVisible);
+
+    for (uint32_t i = 0; i < VulkanContext::kMaxFramesInFlight; ++i)
+    {
+        staging_.emplace_back(device, instance_bytes + mesh_bytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kHostVisible);
+        readback_.emplace_back(device, kCountBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT, kHostVisible);
+    }
+    readback_pending_.assign(VulkanContext::kMaxFramesInFlight, false);
+}
+
+void GpuCulling::CreateDescriptors()
+{
+    VkSamplerCreateInfo sampler_info {};
+    sampler_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    sampler_info.magFilter = VK_FILTER_NEAREST;
+    sampler_info.minFilter = VK_FILTER_NEAREST;
+    sampler_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.maxLod = VK_LOD_CLAMP_NONE;
+    if (vkCreateSampler(device_, &sampler_info, nullptr, &sampler_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create Hi-Z sampler.");
+    }
+
+    const std::array<VkDescriptorSetLayoutBinding, 7> cull_bindings {{
+        {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {6, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+    }};
+    const std::array<VkDescriptorSetLayoutBinding, 2> pyramid_bindings {{
+        {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+    }};
+
+    VkDescriptorSetLayoutCreateInfo layout_info {};
+    layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.bindingCount = static_cast<uint32_t>(cull_bindings.size());
+    layout_info.pBindings = cull_bindings.data();
+    if (vkCreateDescriptorSetLayout(device_, &layout_info, nullptr, &cull_set_layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create cull descriptor set layout.");
+    }
+    layout_info.bindingCount = static_cast<uint32_t>(pyramid_bindings.size());
+    layout_info.pBindings = pyramid_bindings.data();
+    if (vkCreateDescriptorSetLayout(device_, &layout_info, nullptr, &pyramid_set_layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create Hi-Z descriptor set layout.");
+    }
+
+    const std::array<VkDescriptorPoolSize, 4> pool_sizes {{
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 + kMaxPyramidLevels},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, kMaxPyramidLevels},
+    }};
+    VkDescriptorPoolCreateInfo pool_info {};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.maxSets = 1 + kMaxPyramidLevels;
+    pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+    pool_info.pPoolSizes = pool_sizes.data();
+    if (vkCreateDescriptorPool(device_, &pool_info, nullptr, &descriptor_pool_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create GPU culling descriptor pool.");
+    }
+
+    std::array<VkDescriptorSetLayout, 1 + kMaxPyramidLevels> layouts {};
+    layouts.fill(pyramid_set_layout_);
+    layouts[0] = cull_set_layout_;
+    std::array<VkDescriptorSet, 1 + kMaxPyramidLevels> sets {};
+
+    VkDescriptorSetAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool = descriptor_pool_;
+    alloc_info.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+    alloc_info.pSetLayouts = layouts.data();
+    if (vkAllocateDescriptorSets(device_, &alloc_info, sets.data()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate GPU culling descriptor sets.");
+    }
+    cull_set_ = sets[0];
+    pyramid_sets_.assign(sets.begin() + 1, sets.end());
+}
+
+void GpuCulling::CreatePipelines()
+{
+    VkPushConstantRange push_range {VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants)};
+    VkPipelineLayoutCreateInfo layout_info {};
+    layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_info.setLayoutCount = 1;
+    layout_info.pSetLayouts = &cull_set_layout_;
+    layout_info.pushConstantRangeCount = 1;
+    layout_info.pPushConstantRanges = &push_range;
+    if (vkCreatePipelineLayout(device_, &layout_info, nullptr, &cull_layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create cull pipeline layout.");
+    }
+
+    push_range.size = sizeof(PyramidPushConstants);
+    layout_info.pSetLayouts = &pyramid_set_layout_;
+    if (vkCreatePipelineLayout(device_, &layout_info, nullptr, &pyramid_layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create Hi-Z pipeline layout.");
+    }
+
+    cull_pipeline_ = CreateComputePipeline(device_, cull_layout_, "gpu_cull.comp.spv");
+    pyramid_pipeline_ = CreateComputePipeline(device_, pyramid_layout_, "depth_pyramid.comp.spv");
+}
+
+void GpuCulling::CreateFallbackPyramid()
+{
+    VkImageCreateInfo image_info {};
+    image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_info.imageType = VK_IMAGE_TYPE_2D;
+    image_info.format = VK_FORMAT_R32_SFLOAT;
+    image_info.extent = {1, 1, 1};
+    image_info.mipLevels = 1;
+    image_info.arrayLayers = 1;
+    image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (vkCreateImage(device_, &image_info, nullptr, &fallback_pyramid_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create fallback Hi-Z image.");
+    }
+
+    VkMemoryRequirements requirements {};
+    vkGetImageMemoryRequirements(device_, fallback_pyramid_, &requirements);
+    VkMemoryAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = requirements.size;
+    alloc_info.memoryTypeIndex = context_.GetDevice().FindMemoryType(
+        requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (vkAllocateMemory(device_, &alloc_info, nullptr, &fallback_memory_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate fallback Hi-Z memory.");
+    }
+    vkBindImageMemory(device_, fallback_pyramid_, fallback_memory_, 0);
+
+    VkImageViewCreateInfo view_info {};
+    view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_info.image = fallback_pyramid_;
+    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format = VK_FORMAT_R32_SFLOAT;
+    view_info.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    if (vkCreateImageView(device_, &view_info, nullptr, &fallback_view_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create fallback Hi-Z view.");
+    }
+
+    // Cleared to the far plane so it would never occlude anything even if sampled.
+    context_.SubmitImmediate([this](VkCommandBuffer cmd) {
+        VkImageMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = fallback_pyramid_;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        vkCmdPipelineBarrier(
+            cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        const VkClearColorValue far_depth {{1.0F, 0.0F, 0.0F, 0.0F}};
+        vkCmdClearColorImage(cmd, fallback_pyramid_, VK_IMAGE_LAYOUT_GENERAL, &far_depth, 1, &barrier.subresourceRange);
+
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+        vkCmdPipelineBarrier(
+            cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    });
+}
+
+void GpuCulling::CreatePyramid(VkExtent2D extent)
+{
+    context_.WaitIdle();
+    DestroyPyramid();
+    if (extent.width == 0 || extent.height == 0)
+    {
+        return;
+    }
+
+    // Power-of-two pyramid so every level above 0 is an exact 2x2 reduction.
+    pyramid_extent_ = VkExtent2D{std::bit_floor(extent.width), std::bit_floor(extent.height)};
+    const uint32_t levels = std::min(
+        static_cast<uint32_t>(std::bit_width(std::max(pyramid_extent_.width, pyramid_extent_.height))),
+        kMaxPyramidLevels);
+
+    VkImageCreateInfo image_info {};
+    image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_info.imageType = VK_IMAGE_TYPE_2D;
+    image_info.format = VK_FORMAT_R32_SFLOAT;
+    image_info.extent = {pyramid_extent_.width, pyramid_extent_.height, 1};
+    image_info.mipLevels = levels;
+    image_info.arrayLayers = 1;
+    image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+    image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (vkCreateImage(device_, &image_info, nullptr, &pyramid_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create Hi-Z pyramid image.");
+    }
+
+    VkMemoryRequirements requirements {};
+    vkGetImageMemoryRequirements(device_, pyramid_, &requirements);
+    VkMemoryAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = requirements.size;
+    alloc_info.memoryTypeIndex = context_.GetDevice().FindMemoryType(
+        requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (vkAllocateMemory(device_, &alloc_info, nullptr, &pyramid_memory_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate Hi-Z pyramid memory.");
+    }
+    vkBindImageMemory(device_, pyramid_, pyramid_memory_, 0);
+
+    VkImageViewCreateInfo view_info {};
+    view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_info.image = pyramid_;
+    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format = VK_FORMAT_R32_SFLOAT;
+    view_info.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levels, 0, 1};
+    if (vkCreateImageView(device_, &view_info, nullptr, &pyramid_view_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create Hi-Z pyramid view.");
+    }
+    pyramid_mips_.resize(levels, VK_NULL_HANDLE);
+    for (uint32_t level = 0; level < levels; ++level)
+    {
+        view_info.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1};
+        if (vkCreateImageView(device_, &view_info, nullptr, &pyramid_mips_[level]) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create Hi-Z mip view.");
+        }
+    }
+
+    context_.SubmitImmediate([this, levels](VkCommandBuffer cmd) {
+        VkImageMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = pyramid_;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levels, 0, 1};
+        vkCmdPipelineBarrier(
+            cmd,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+    });
+}
+
+void GpuCulling::DestroyPyramid()
+{
+    for (VkImageView view : pyramid_mips_)
+    {
+        vkDestroyImageView(device_, view, nullptr);
+    }
+    pyramid_mips_.clear();
+    if (pyramid_view_ != VK_NULL_HANDLE)
+    {
+        vkDestroyImageView(device_, pyramid_view_, nullptr);
+        pyramid_view_ = VK_NULL_HANDLE;
+    }
+    if (pyramid_ != VK_NULL_HANDLE)
+    {
+        vkDestroyImage(device_, pyramid_, nullptr);
+        pyramid_ = VK_NULL_HANDLE;
+    }
+    if (pyramid_memory_ != VK_NULL_HANDLE)
+    {
+        vkFreeMemory(device_, pyramid_memory_, nullptr);
+        pyramid_memory_ = VK_NULL_HANDLE;
+    }
+    pyramid_extent_ = VkExtent2D{0, 0};
+    pyramid_valid_ = false;
+}
+
+void GpuCulling::WriteCullDescriptors()
+{
+    const VkDescriptorBufferInfo uniforms {uniform_buffer_.Handle(), 0, sizeof(CullUniforms)};
+    const std::array<VkDescriptorBufferInfo, 5> storage {{
+        {instance_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {mesh_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {command_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {count_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {visibility_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+    }};
+    // Until a depth source exists the fallback image fills the Hi-Z binding; occlusion is off then.
+    const VkImageView pyramid_view = pyramid_view_ != VK_NULL_HANDLE ? pyramid_view_ : fallback_view_;
+    const VkDescriptorImageInfo pyramid {sampler_, pyramid_view, VK_IMAGE_LAYOUT_GENERAL};
+
+    std::array<VkWriteDescriptorSet, 3> writes {};
+    for (auto& write : writes)
+    {
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = cull_set_;
+    }
+    writes[0].dstBinding = 0;
+    writes[0].descriptorCount = 1;
+    writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    writes[0].pBufferInfo = &uniforms;
+    writes[1].dstBinding = 1;
+    writes[1].descriptorCount = static_cast<uint32_t>(storage.size());
+    writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writes[1].pBufferInfo = storage.data();
+    writes[2].dstBinding = 6;
+    writes[2].descriptorCount = 1;
+    writes[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writes[2].pImageInfo = &pyramid;
+
+    vkUpdateDescriptorSets(device_, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+
+void GpuCulling::WritePyramidDescriptors()
+{
+    const auto levels = static_cast<uint32_t>(pyramid_mips_.size());
+    for (uint32_t level = 0; level < levels; ++level)
+    {
+        const VkDescriptorImageInfo src = level == 0
+            ? VkDescriptorImageInfo{sampler_, depth_view_, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL}
+            : VkDescriptorImageInfo{sampler_, pyramid_mips_[level - 1], VK_IMAGE_LAYOUT_GENERAL};
+        const VkDescriptorImageInfo dst {VK_NULL_HANDLE, pyramid_mips_[level], VK_IMAGE_LAYOUT_GENERAL};
+
+        std::array<VkWriteDescriptorSet, 2> writes {};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = pyramid_sets_[level];
+        writes[0].dstBinding = 0;
+        writes[0].descriptorCount = 1;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo = &src;
+        writes[1] = writes[0];
+        writes[1].dstBinding = 1;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo = &dst;
+        vkUpdateDescriptorSets(device_, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+}
+
+VkDeviceSize GpuCulling::CommandRegionOffset(CullPhase phase) const
+{
+    return static_cast<VkDeviceSize>(phase) * max_instances_ * sizeof(VkDrawIndexedIndirectCommand);
+}
+}  // namespace ZKT
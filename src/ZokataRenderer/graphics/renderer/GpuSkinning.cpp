@@ -0,0 +1,389 @@
+#include "ZokataRenderer/graphics/renderer/GpuSkinning.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <imgui.h>
+
+#include "ZokataRenderer/graphics/vk/Device.h"
+#include "ZokataRenderer/graphics/vk/Shader.h"
+
+namespace ZKT
+{
+namespace
+{
+constexpr uint32_t kSkinGroupSize = 64;
+constexpr uint32_t kUnorm16Max = 0xFFFF;
+
+uint32_t GroupCount(uint32_t items, uint32_t group_size)
+{
+    return (items + group_size - 1) / group_size;
+}
+
+VkPipeline CreateComputePipeline(VkDevice device, VkPipelineLayout layout, const char* shader_name)
+{
+    VkShaderModule module = LoadShaderModule(device, ShaderPath(shader_name));
+
+    VkComputePipelineCreateInfo pipeline_info {};
+    pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipeline_info.stage.module = module;
+    pipeline_info.stage.pName = "main";
+    pipeline_info.layout = layout;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    const VkResult result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &pipeline);
+    vkDestroyShaderModule(device, module, nullptr);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error(std::string("Failed to create compute pipeline: ") + shader_name);
+    }
+    return pipeline;
+}
+
+void GlobalBarrier(
+    VkCommandBuffer cmd,
+    VkAccessFlags src_access,
+    VkAccessFlags dst_access,
+    VkPipelineStageFlags src_stage,
+    VkPipelineStageFlags dst_stage)
+{
+    VkMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = src_access;
+    barrier.dstAccessMask = dst_access;
+    vkCmdPipelineBarrier(cmd, src_stage, dst_stage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+}  // namespace
+
+GpuVertexSkin PackVertexSkin(const std::array<uint32_t, 4>& joints, const std::array<float, 4>& weights)
+{
+    GpuVertexSkin skin {};
+    float sum = 0.0F;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        if (joints[i] > kUnorm16Max)
+        {
+            throw std::runtime_error("Skinning joint index exceeds 65535.");
+        }
+        skin.joints[i] = static_cast<uint16_t>(joints[i]);
+        sum += std::max(weights[i], 0.0F);
+    }
+    if (sum <= 0.0F)
+    {
+        skin.weights[0] = static_cast<uint16_t>(kUnorm16Max);
+        return skin;
+    }
+
+    // Round each weight, then give the rounding residual to the largest so they sum exactly.
+    int32_t total = 0;
+    size_t largest = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const float unit = std::max(weights[i], 0.0F) / sum;
+        skin.weights[i] = static_cast<uint16_t>(std::lrint(unit * static_cast<float>(kUnorm16Max)));
+        total += skin.weights[i];
+        if (skin.weights[i] > skin.weights[largest])
+        {
+            largest = i;
+        }
+    }
+    skin.weights[largest] = static_cast<uint16_t>(skin.weights[largest] + (static_cast<int32_t>(kUnorm16Max) - total));
+    return skin;
+}
+
+GpuSkinning::GpuSkinning(const VulkanContext& context, uint32_t max_vertices, uint32_t max_joints)
+    : context_(context)
+    , device_(context.DeviceHandle())
+    , max_vertices_(std::max(max_vertices, 1U))
+    , max_joints_(std::max(max_joints, 1U))
+{
+    static_assert(sizeof(MeshVertex) == 11 * sizeof(float), "skinning.comp reads MeshVertex as 11 floats");
+    static_assert(sizeof(MATH::Mat4f) == 16 * sizeof(float), "skinning.comp reads joints as mat4");
+
+    CreateBuffers();
+    CreateDescriptors();
+    CreatePipeline();
+    WriteDescriptors();
+}
+
+GpuSkinning::~GpuSkinning()
+{
+    vkDestroyPipeline(device_, pipeline_, nullptr);
+    vkDestroyPipelineLayout(device_, layout_, nullptr);
+    vkDestroyDescriptorPool(device_, descriptor_pool_, nullptr);
+    vkDestroyDescriptorSetLayout(device_, set_layout_, nullptr);
+}
+
+uint32_t GpuSkinning::AddMesh(std::span<const MeshVertex> vertices, std::span<const GpuVertexSkin> skins)
+{
+    if (vertices.empty() || vertices.size() != skins.size())
+    {
+        throw std::runtime_error("GpuSkinning mesh needs one skin entry per vertex.");
+    }
+    if (vertices.size() > max_vertices_ - source_vertex_count_)
+    {
+        throw std::runtime_error("GpuSkinning source vertices exceed capacity.");
+    }
+
+    const Mesh mesh {source_vertex_count_, static_cast<uint32_t>(vertices.size())};
+    const VkDeviceSize vertex_bytes = vertices.size_bytes();
+    const VkDeviceSize skin_bytes = skins.size_bytes();
+    Buffer staging(
+        context_.GetDevice(),
+        vertex_bytes + skin_bytes,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    staging.Write(vertices.data(), vertex_bytes, 0);
+    staging.Write(skins.data(), skin_bytes, vertex_bytes);
+
+    context_.SubmitImmediate([&](VkCommandBuffer cmd) {
+        const VkBufferCopy vertex_copy {0, static_cast<VkDeviceSize>(mesh.first_vertex) * sizeof(MeshVertex), vertex_bytes};
+        const VkBufferCopy skin_copy {vertex_bytes, static_cast<VkDeviceSize>(mesh.first_vertex) * sizeof(GpuVertexSkin), skin_bytes};
+        vkCmdCopyBuffer(cmd, staging.Handle(), source_buffer_.Handle(), 1, &vertex_copy);
+        vkCmdCopyBuffer(cmd, staging.Handle(), skin_buffer_.Handle(), 1, &skin_copy);
+        GlobalBarrier(
+            cmd,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_SHADER_READ_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    });
+
+    source_vertex_count_ += mesh.vertex_count;
+    meshes_.push_back(mesh);
+    stats_.meshes = static_cast<uint32_t>(meshes_.size());
+    return stats_.meshes - 1;
+}
+
+uint32_t GpuSkinning::AddInstance(uint32_t mesh, uint32_t joint_count)
+{
+    const Mesh& source = meshes_.at(mesh);
+    if (source.vertex_count > max_vertices_ - output_vertex_count_)
+    {
+        throw std::runtime_error("GpuSkinning output vertices exceed capacity.");
+    }
+    if (joint_count == 0 || joint_count > max_joints_ - static_cast<uint32_t>(joints_.size()))
+    {
+        throw std::runtime_error("GpuSkinning joint palette exceeds capacity.");
+    }
+
+    // Every instance has at least one joint, so the palette capacity also bounds the table.
+    const Instance instance {mesh, output_vertex_count_, static_cast<uint32_t>(joints_.size()), joint_count};
+    instance_table_.push_back({source.first_vertex, instance.output_vertex, source.vertex_count, instance.first_joint});
+    output_vertex_count_ += source.vertex_count;
+    joints_.resize(joints_.size() + joint_count);
+    joints_dirty_ = true;
+    table_dirty_ = true;
+    instances_.push_back(instance);
+
+    stats_.instances = static_cast<uint32_t>(instances_.size());
+    stats_.vertices = output_vertex_count_;
+    stats_.joints = static_cast<uint32_t>(joints_.size());
+    return stats_.instances - 1;
+}
+
+uint32_t GpuSkinning::OutputVertexOffset(uint32_t instance) const
+{
+    return instances_.at(instance).output_vertex;
+}
+
+void GpuSkinning::SetJointMatrices(uint32_t instance, std::span<const MATH::Mat4f> matrices)
+{
+    const Instance& target = instances_.at(instance);
+    const size_t count = std::min<size_t>(matrices.size(), target.joint_count);
+    std::copy_n(matrices.begin(), count, joints_.begin() + target.first_joint);
+    joints_dirty_ = true;
+}
+
+void GpuSkinning::RecordUploads(VkCommandBuffer cmd, uint32_t frame_slot)
+{
+    if ((!joints_dirty_ && !table_dirty_) || joints_.empty())
+    {
+        return;
+    }
+    Buffer& staging = staging_[frame_slot];
+    const VkDeviceSize table_offset = static_cast<VkDeviceSize>(max_joints_) * sizeof(MATH::Mat4f);
+
+    // The previous frame's dispatch may still read the palette and table.
+    GlobalBarrier(
+        cmd, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+    if (joints_dirty_)
+    {
+        const VkDeviceSize size = joints_.size() * sizeof(MATH::Mat4f);
+        staging.Write(joints_.data(), size, 0);
+        const VkBufferCopy copy {0, 0, size};
+        vkCmdCopyBuffer(cmd, staging.Handle(), joint_buffer_.Handle(), 1, &copy);
+    }
+    if (table_dirty_)
+    {
+        const VkDeviceSize size = instance_table_.size() * sizeof(GpuSkinInstance);
+        staging.Write(instance_table_.data(), size, table_offset);
+        const VkBufferCopy copy {table_offset, 0, size};
+        vkCmdCopyBuffer(cmd, staging.Handle(), instance_buffer_.Handle(), 1, &copy);
+    }
+    GlobalBarrier(
+        cmd,
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    joints_dirty_ = false;
+    table_dirty_ = false;
+}
+
+void GpuSkinning::RecordSkinning(VkCommandBuffer cmd)
+{
+    if (instances_.empty())
+    {
+        return;
+    }
+
+    // Earlier frames may still be drawing from the output buffer.
+    GlobalBarrier(
+        cmd, 0, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, layout_, 0, 1, &set_, 0, nullptr);
+    const SkinPushConstants push {static_cast<uint32_t>(instances_.size()), output_vertex_count_};
+    vkCmdPushConstants(cmd, layout_, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+    vkCmdDispatch(cmd, GroupCount(output_vertex_count_, kSkinGroupSize), 1, 1);
+
+    GlobalBarrier(
+        cmd,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+}
+
+VkBuffer GpuSkinning::OutputBuffer() const
+{
+    return output_buffer_.Handle();
+}
+
+const GpuSkinningStats& GpuSkinning::Stats() const
+{
+    return stats_;
+}
+
+void GpuSkinning::DrawDebugGui()
+{
+    if (!ImGui::Begin("GPU Skinning"))
+    {
+        ImGui::End();
+        return;
+    }
+    ImGui::Text("Meshes: %u", stats_.meshes);
+    ImGui::Text("Instances: %u", stats_.instances);
+    ImGui::Text("Skinned vertices: %u / %u", stats_.vertices, max_vertices_);
+    ImGui::Text("Source vertices: %u / %u", source_vertex_count_, max_vertices_);
+    ImGui::Text("Joints: %u / %u", stats_.joints, max_joints_);
+    ImGui::End();
+}
+
+void GpuSkinning::CreateBuffers()
+{
+    const Device& device = context_.GetDevice();
+    constexpr VkMemoryPropertyFlags kDeviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    constexpr VkMemoryPropertyFlags kHostVisible =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    constexpr VkBufferUsageFlags kStorageDst = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    const VkDeviceSize vertex_bytes = static_cast<VkDeviceSize>(max_vertices_) * sizeof(MeshVertex);
+    const VkDeviceSize joint_bytes = static_cast<VkDeviceSize>(max_joints_) * sizeof(MATH::Mat4f);
+
+    source_buffer_ = Buffer(device, vertex_bytes, kStorageDst, kDeviceLocal);
+    skin_buffer_ = Buffer(device, static_cast<VkDeviceSize>(max_vertices_) * sizeof(GpuVertexSkin), kStorageDst, kDeviceLocal);
+    joint_buffer_ = Buffer(device, joint_bytes, kStorageDst, kDeviceLocal);
+    const VkDeviceSize table_bytes = static_cast<VkDeviceSize>(max_joints_) * sizeof(GpuSkinInstance);
+    instance_buffer_ = Buffer(device, table_bytes, kStorageDst, kDeviceLocal);
+    output_buffer_ = Buffer(
+        device, vertex_bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, kDeviceLocal);
+
+    for (uint32_t i = 0; i < VulkanContext::kMaxFramesInFlight; ++i)
+    {
+        staging_.emplace_back(device, joint_bytes + table_bytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kHostVisible);
+    }
+}
+
+void GpuSkinning::CreateDescriptors()
+{
+    const std::array<VkDescriptorSetLayoutBinding, 5> bindings {{
+        {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+    }};
+
+    VkDescriptorSetLayoutCreateInfo layout_info {};
+    layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.bindingCount = static_cast<uint32_t>(bindings.size());
+    layout_info.pBindings = bindings.data();
+    if (vkCreateDescriptorSetLayout(device_, &layout_info, nullptr, &set_layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create skinning descriptor set layout.");
+    }
+
+    const VkDescriptorPoolSize pool_size {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5};
+    VkDescriptorPoolCreateInfo pool_info {};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.maxSets = 1;
+    pool_info.poolSizeCount = 1;
+    pool_info.pPoolSizes = &pool_size;
+    if (vkCreateDescriptorPool(device_, &pool_info, nullptr, &descriptor_pool_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create skinning descriptor pool.");
+    }
+
+    VkDescriptorSetAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool = descriptor_pool_;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts = &set_layout_;
+    if (vkAllocateDescriptorSets(device_, &alloc_info, &set_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate skinning descriptor set.");
+    }
+}
+
+void GpuSkinning::CreatePipeline()
+{
+    const VkPushConstantRange push_range {VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(SkinPushConstants)};
+    VkPipelineLayoutCreateInfo layout_info {};
+    layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_info.setLayoutCount = 1;
+    layout_info.pSetLayouts = &set_layout_;
+    layout_info.pushConstantRangeCount = 1;
+    layout_info.pPushConstantRanges = &push_range;
+    if (vkCreatePipelineLayout(device_, &layout_info, nullptr, &layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create skinning pipeline layout.");
+    }
+    pipeline_ = CreateComputePipeline(device_, layout_, "skinning.comp.spv");
+}
+
+void GpuSkinning::WriteDescriptors()
+{
+    const std::array<VkDescriptorBufferInfo, 5> storage {{
+        {source_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {skin_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {joint_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {output_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {instance_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+    }};
+
+    VkWriteDescriptorSet write {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set_;
+    write.dstBinding = 0;
+    write.descriptorCount = static_cast<uint32_t>(storage.size());
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = storage.data();
+    vkUpdateDescriptorSets(device_, 1, &write, 0, nullptr);
+}
+}  // namespace ZKT
@@ -0,0 +1,69 @@
+#include "ZokataRenderer/graphics/renderer/InstanceBuffer.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "ZokataRenderer/graphics/vk/Device.h"
+
+namespace ZKT
+{
+namespace
+{
+constexpr VkBufferUsageFlags kInstanceUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+constexpr VkMemoryPropertyFlags kHostVisible =
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+}  // namespace
+
+InstanceBuffer::InstanceBuffer(const VulkanContext& context, uint32_t initial_capacity)
+    : context_(context)
+{
+    const uint32_t capacity = std::max(initial_capacity, 1U);
+    for (uint32_t i = 0; i < VulkanContext::kMaxFramesInFlight; ++i)
+    {
+        buffers_.emplace_back(
+            context_.GetDevice(), static_cast<VkDeviceSize>(capacity) * sizeof(MATH::Mat4f), kInstanceUsage, kHostVisible);
+    }
+    capacities_.assign(VulkanContext::kMaxFramesInFlight, capacity);
+    counts_.assign(VulkanContext::kMaxFramesInFlight, 0);
+}
+
+bool InstanceBuffer::Upload(const DrawList& draws, uint32_t frame_slot)
+{
+    const auto count = static_cast<uint32_t>(draws.instances.size());
+    bool grown = false;
+    if (count > capacities_[frame_slot])
+    {
+        const uint32_t capacity = std::bit_ceil(count);
+        buffers_[frame_slot] = Buffer(
+            context_.GetDevice(), static_cast<VkDeviceSize>(capacity) * sizeof(MATH::Mat4f), kInstanceUsage, kHostVisible);
+        capacities_[frame_slot] = capacity;
+        grown = true;
+    }
+    if (count > 0)
+    {
+        buffers_[frame_slot].Write(draws.instances.data(), static_cast<VkDeviceSize>(count) * sizeof(MATH::Mat4f), 0);
+    }
+    counts_[frame_slot] = count;
+    return grown;
+}
+
+VkBuffer InstanceBuffer::Handle(uint32_t frame_slot) const
+{
+    return buffers_.at(frame_slot).Handle();
+}
+
+uint32_t InstanceBuffer::InstanceCount(uint32_t frame_slot) const
+{
+    return counts_.at(frame_slot);
+}
+
+void InstanceBuffer::RecordBatch(
+    VkCommandBuffer cmd, const DrawBatch& batch, uint32_t index_count, uint32_t first_index, int32_t vertex_offset)
+{
+    if (batch.instance_count == 0 || index_count == 0)
+    {
+        return;
+    }
+    vkCmdDrawIndexed(cmd, index_count, batch.instance_count, first_index, vertex_offset, batch.first_instance);
+}
+}  // namespace ZKT
@@ -0,0 +1,265 @@
+#include "ZokataRenderer/graphics/renderer/Ktx2.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace ZKT
+{
+namespace
+{
+constexpr uint8_t kIdentifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+struct Header
+{
+    uint32_t vk_format;
+    uint32_t type_size;
+    uint32_t pixel_width;
+    uint32_t pixel_height;
+    uint32_t pixel_depth;
+    uint32_t layer_count;
+    uint32_t face_count;
+    uint32_t level_count;
+    uint32_t supercompression_scheme;
+    uint32_t dfd_byte_offset;
+    uint32_t dfd_byte_length;
+    uint32_t kvd_byte_offset;
+    uint32_t kvd_byte_length;
+};
+static_assert(sizeof(Header) == 52, "KTX2 header fields are packed");
+
+struct LevelIndex
+{
+    uint64_t byte_offset;
+    uint64_t byte_length;
+    uint64_t uncompressed_byte_length;
+};
+
+// The supercompression global data offset and length (two uint64) follow the header.
+constexpr size_t kLevelIndexOffset = sizeof(kIdentifier) + sizeof(Header) + 2 * sizeof(uint64_t);
+
+// Khronos Data Format constants used by the basic descriptor block.
+constexpr uint8_t kModelRgbsda = 1;
+constexpr uint8_t kModelBc1a = 128;
+constexpr uint8_t kModelBc3 = 130;
+constexpr uint8_t kModelBc5 = 132;
+constexpr uint8_t kModelBc7 = 134;
+constexpr uint8_t kPrimariesBt709 = 1;
+constexpr uint8_t kTransferLinear = 1;
+constexpr uint8_t kTransferSrgb = 2;
+constexpr uint8_t kQualifierLinear = 0x10;
+constexpr uint8_t kChannelAlpha = 15;
+
+struct Sample
+{
+    uint16_t bit_offset;
+    uint8_t bit_length;  // minus one
+    uint8_t channel;
+    uint32_t upper;
+};
+
+void Fail(const std::string& message)
+{
+    throw std::runtime_error("Invalid KTX2 file: " + message);
+}
+
+template <typename T>
+void Append(std::vector<uint8_t>& out, const T& value)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+std::vector<uint8_t> BuildDataFormatDescriptor(TextureFormat format, bool srgb)
+{
+    uint8_t model = kModelRgbsda;
+    std::vector<Sample> samples;
+    // Alpha stays linear in sRGB formats.
+    const uint8_t alpha = kChannelAlpha | (srgb ? kQualifierLinear : 0);
+    switch (format)
+    {
+    case TextureFormat::RGBA8:
+        samples = {{0, 7, 0, 255}, {8, 7, 1, 255}, {16, 7, 2, 255}, {24, 7, alpha, 255}};
+        break;
+    case TextureFormat::BC1:
+        model = kModelBc1a;
+        samples = {{0, 63, 0, UINT32_MAX}};
+        break;
+    case TextureFormat::BC3:
+        model = kModelBc3;
+        samples = {{0, 63, alpha, UINT32_MAX}, {64, 63, 0, UINT32_MAX}};
+        break;
+    case TextureFormat::BC5:
+        model = kModelBc5;
+        samples = {{0, 63, 0, UINT32_MAX}, {64, 63, 1, UINT32_MAX}};
+        break;
+    case TextureFormat::BC7:
+        model = kModelBc7;
+        samples = {{0, 127, 0, UINT32_MAX}};
+        break;
+    }
+
+    const TexelBlock block = FormatBlock(format);
+    const auto block_size = static_cast<uint16_t>(24 + 16 * samples.size());
+    std::vector<uint8_t> dfd;
+    Append(dfd, static_cast<uint32_t>(4 + block_size));  // total size, including this field
+    Append(dfd, uint32_t {0});                           // vendor 0 (Khronos), basic descriptor
+    Append(dfd, uint16_t {2});                           // version 1.3 of the basic block
+    Append(dfd, block_size);
+    dfd.push_back(model);
+    dfd.push_back(kPrimariesBt709);
+    dfd.push_back(srgb && format != TextureFormat::BC5 ? kTransferSrgb : kTransferLinear);
+    dfd.push_back(0);  // straight alpha
+    dfd.push_back(static_cast<uint8_t>(block.width - 1));
+    dfd.push_back(static_cast<uint8_t>(block.height - 1));
+    dfd.push_back(0);
+    dfd.push_back(0);
+    dfd.push_back(static_cast<uint8_t>(block.bytes));
+    dfd.insert(dfd.end(), 7, 0);  // bytesPlane1-7
+    for (const Sample& sample : samples)
+    {
+        Append(dfd, sample.bit_offset);
+        dfd.push_back(sample.bit_length);
+        dfd.push_back(sample.channel);
+        dfd.insert(dfd.end(), 4, 0);  // sample position
+        Append(dfd, uint32_t {0});
+        Append(dfd, sample.upper);
+    }
+    return dfd;
+}
+}  // namespace
+
+VkDeviceSize Ktx2Texture::ByteSize() const
+{
+    VkDeviceSize size = 0;
+    for (const std::span<const uint8_t>& level : levels)
+    {
+        size += level.size();
+    }
+    return size;
+}
+
+Ktx2Texture ParseKtx2(std::span<const uint8_t> bytes)
+{
+    if (bytes.size() < kLevelIndexOffset || std::memcmp(bytes.data(), kIdentifier, sizeof(kIdentifier)) != 0)
+    {
+        Fail("missing KTX2 identifier");
+    }
+    Header header {};
+    std::memcpy(&header, bytes.data() + sizeof(kIdentifier), sizeof(Header));
+
+    const TexelBlock block = FormatBlock(static_cast<VkFormat>(header.vk_format));
+    if (block.bytes == 0)
+    {
+        Fail("unsupported VkFormat " + std::to_string(header.vk_format));
+    }
+    if (header.pixel_width == 0 || header.pixel_height == 0 || header.pixel_depth != 0)
+    {
+        Fail("not a 2D texture");
+    }
+    if (header.layer_count > 1 || header.face_count != 1)
+    {
+        Fail("arrays and cube maps are not supported");
+    }
+    if (header.supercompression_scheme != 0)
+    {
+        Fail("supercompression is not supported");
+    }
+
+    Ktx2Texture texture;
+    texture.format = static_cast<VkFormat>(header.vk_format);
+    texture.extent = VkExtent2D{header.pixel_width, header.pixel_height};
+    // 0 asks the loader to generate mips; the level index then holds only the base level.
+    const uint32_t level_count = std::max(header.level_count, 1U);
+    if (level_count > FullMipCount(texture.extent))
+    {
+        Fail("more levels than the extent allows");
+    }
+    if (bytes.size() < kLevelIndexOffset + level_count * sizeof(LevelIndex))
+    {
+        Fail("truncated level index");
+    }
+
+    texture.levels.reserve(level_count);
+    for (uint32_t level = 0; level < level_count; ++level)
+    {
+        LevelIndex index {};
+        std::memcpy(&index, bytes.data() + kLevelIndexOffset + level * sizeof(LevelIndex), sizeof(LevelIndex));
+        const VkDeviceSize expected = MipByteSize(block, MipExtent(texture.extent, level));
+        if (index.byte_length != expected)
+        {
+            Fail("level " + std::to_string(level) + " holds " + std::to_string(index.byte_length) + " bytes, expected "
+                 + std::to_string(expected));
+        }
+        if (index.byte_offset > bytes.size() || index.byte_length > bytes.size() - index.byte_offset)
+        {
+            Fail("level " + std::to_string(level) + " lies outside the file");
+        }
+        texture.levels.push_back(bytes.subspan(index.byte_offset, index.byte_length));
+    }
+    return texture;
+}
+
+std::vector<uint8_t> WriteKtx2(
+    TextureFormat format, bool srgb, VkExtent2D extent, std::span<const std::vector<uint8_t>> levels)
+{
+    const TexelBlock block = FormatBlock(format);
+    if (levels.empty() || levels.size() > FullMipCount(extent))
+    {
+        throw std::runtime_error("WriteKtx2 needs between 1 and " + std::to_string(FullMipCount(extent)) + " levels.");
+    }
+    for (size_t level = 0; level < levels.size(); ++level)
+    {
+        if (levels[level].size() != MipByteSize(block, MipExtent(extent, static_cast<uint32_t>(level))))
+        {
+            throw std::runtime_error("WriteKtx2: level " + std::to_string(level) + " has the wrong size.");
+        }
+    }
+
+    const std::vector<uint8_t> dfd = BuildDataFormatDescriptor(format, srgb);
+    const auto level_count = static_cast<uint32_t>(levels.size());
+    const size_t dfd_offset = kLevelIndexOffset + level_count * sizeof(LevelIndex);
+    const size_t alignment = std::lcm<size_t>(block.bytes, 4);
+
+    // Levels go smallest first; each starts at a multiple of the block size.
+    std::vector<LevelIndex> index(level_count);
+    size_t offset = dfd_offset + dfd.size();
+    for (uint32_t level = level_count; level-- > 0;)
+    {
+        offset = (offset + alignment - 1) / alignment * alignment;
+        index[level] = LevelIndex{offset, levels[level].size(), levels[level].size()};
+        offset += levels[level].size();
+    }
+
+    Header header {};
+    header.vk_format = static_cast<uint32_t>(ToVkFormat(format, srgb));
+    header.type_size = 1;
+    header.pixel_width = extent.width;
+    header.pixel_height = extent.height;
+    header.face_count = 1;
+    header.level_count = level_count;
+    header.dfd_byte_offset = static_cast<uint32_t>(dfd_offset);
+    header.dfd_byte_length = static_cast<uint32_t>(dfd.size());
+
+    std::vector<uint8_t> out;
+    out.reserve(offset);
+    out.insert(out.end(), std::begin(kIdentifier), std::end(kIdentifier));
+    Append(out, header);
+    Append(out, uint64_t {0});
+    Append(out, uint64_t {0});
+    for (const LevelIndex& entry : index)
+    {
+        Append(out, entry);
+    }
+    out.insert(out.end(), dfd.begin(), dfd.end());
+    for (uint32_t level = level_count; level-- > 0;)
+    {
+        out.resize(index[level].byte_offset, 0);
+        out.insert(out.end(), levels[level].begin(), levels[level].end());
+    }
+    return out;
+}
+}  // namespace ZKT
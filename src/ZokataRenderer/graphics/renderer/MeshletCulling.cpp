@@ -0,0 +1,422 @@
+#include "ZokataRenderer/graphics/renderer/MeshletCulling.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+
+#include <imgui.h>
+
+#include "ZokataMath/Bounds.h"
+#include "ZokataRenderer/graphics/vk/Device.h"
+#include "ZokataRenderer/graphics/vk/Shader.h"
+
+namespace ZKT
+{
+namespace
+{
+constexpr uint32_t kCullGroupSize = 64;
+constexpr VkDeviceSize kCountBytes = sizeof(uint32_t);
+
+uint32_t GroupCount(uint32_t items, uint32_t group_size)
+{
+    return (items + group_size - 1) / group_size;
+}
+
+VkPipeline CreateComputePipeline(VkDevice device, VkPipelineLayout layout, const char* shader_name)
+{
+    VkShaderModule module = LoadShaderModule(device, ShaderPath(shader_name));
+
+    VkComputePipelineCreateInfo pipeline_info {};
+    pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipeline_info.stage.module = module;
+    pipeline_info.stage.pName = "main";
+    pipeline_info.layout = layout;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    const VkResult result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &pipeline);
+    vkDestroyShaderModule(device, module, nullptr);
+    if (result != VK_SUCCESS)
+    {
+        throw std::runtime_error(std::string("Failed to create compute pipeline: ") + shader_name);
+    }
+    return pipeline;
+}
+
+void BufferBarrier(
+    VkCommandBuffer cmd,
+    VkBuffer buffer,
+    VkAccessFlags src_access,
+    VkAccessFlags dst_access,
+    VkPipelineStageFlags src_stage,
+    VkPipelineStageFlags dst_stage)
+{
+    VkBufferMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = src_access;
+    barrier.dstAccessMask = dst_access;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = buffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(cmd, src_stage, dst_stage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+}  // namespace
+
+MeshletCulling::MeshletCulling(const VulkanContext& context, uint32_t max_clusters, uint32_t max_meshlets)
+    : context_(context)
+    , device_(context.DeviceHandle())
+    , max_clusters_(std::max(max_clusters, 1U))
+    , max_meshlets_(std::max(max_meshlets, 1U))
+{
+    static_assert(sizeof(CullUniforms) == 128, "CullUniforms must match the std140 layout");
+
+    const DeviceFeatures& features = context_.GetDevice().Features();
+    compact_ = features.draw_indirect_count;
+    multi_draw_ = features.multi_draw_indirect;
+
+    CreateBuffers();
+    CreateDescriptors();
+    CreatePipeline();
+    WriteDescriptors();
+}
+
+MeshletCulling::~MeshletCulling()
+{
+    vkDestroyPipeline(device_, pipeline_, nullptr);
+    vkDestroyPipelineLayout(device_, layout_, nullptr);
+    vkDestroyDescriptorPool(device_, descriptor_pool_, nullptr);
+    vkDestroyDescriptorSetLayout(device_, set_layout_, nullptr);
+}
+
+void MeshletCulling::SetMeshlets(std::span<const GpuMeshlet> meshlets)
+{
+    if (meshlets.size() > max_meshlets_)
+    {
+        throw std::runtime_error("MeshletCulling meshlet table exceeds capacity.");
+    }
+    meshlets_.assign(meshlets.begin(), meshlets.end());
+    meshlets_dirty_ = true;
+}
+
+void MeshletCulling::SetClusters(std::span<const GpuCluster> clusters)
+{
+    if (clusters.size() > max_clusters_)
+    {
+        throw std::runtime_error("MeshletCulling cluster count exceeds capacity.");
+    }
+    clusters_.assign(clusters.begin(), clusters.end());
+    clusters_dirty_ = true;
+}
+
+uint32_t MeshletCulling::ClusterCount() const
+{
+    return static_cast<uint32_t>(clusters_.size());
+}
+
+void MeshletCulling::SetInstanceBuffer(VkBuffer instances)
+{
+    const VkDescriptorBufferInfo info {instances, 0, VK_WHOLE_SIZE};
+    VkWriteDescriptorSet write {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set_;
+    write.dstBinding = 1;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &info;
+    vkUpdateDescriptorSets(device_, 1, &write, 0, nullptr);
+    instances_bound_ = instances != VK_NULL_HANDLE;
+}
+
+void MeshletCulling::SetConeCulling(bool enabled)
+{
+    cone_culling_ = enabled;
+}
+
+const MeshletCullingStats& MeshletCulling::Stats() const
+{
+    return stats_;
+}
+
+void MeshletCulling::RecordUploads(VkCommandBuffer cmd, uint32_t frame_slot)
+{
+    // The slot's fence has been waited on by BeginFrame, so its readback is complete.
+    if (readback_pending_[frame_slot])
+    {
+        stats_.draws = *static_cast<const uint32_t*>(readback_[frame_slot].Mapped());
+        readback_pending_[frame_slot] = false;
+    }
+    stats_.clusters = ClusterCount();
+
+    Buffer& staging = staging_[frame_slot];
+    bool uploaded = false;
+
+    if (clusters_dirty_ && !clusters_.empty())
+    {
+        const VkDeviceSize size = clusters_.size() * sizeof(GpuCluster);
+        staging.Write(clusters_.data(), size, 0);
+        const VkBufferCopy copy {0, 0, size};
+        vkCmdCopyBuffer(cmd, staging.Handle(), cluster_buffer_.Handle(), 1, &copy);
+        uploaded = true;
+    }
+    clusters_dirty_ = false;
+
+    if (meshlets_dirty_ && !meshlets_.empty())
+    {
+        const VkDeviceSize staging_offset = static_cast<VkDeviceSize>(max_clusters_) * sizeof(GpuCluster);
+        const VkDeviceSize size = meshlets_.size() * sizeof(GpuMeshlet);
+        staging.Write(meshlets_.data(), size, staging_offset);
+        const VkBufferCopy copy {staging_offset, 0, size};
+        vkCmdCopyBuffer(cmd, staging.Handle(), meshlet_buffer_.Handle(), 1, &copy);
+        uploaded = true;
+    }
+    meshlets_dirty_ = false;
+
+    if (uploaded)
+    {
+        VkMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(
+            cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+}
+
+void MeshletCulling::RecordCull(
+    VkCommandBuffer cmd, const MATH::Mat4f& view_projection, const MATH::Vec3f& camera_position, uint32_t frame_slot)
+{
+    const uint32_t cluster_count = instances_bound_ ? ClusterCount() : 0;
+
+    CullUniforms uniforms {};
+    const MATH::Frustum frustum = MATH::Frustum::FromViewProjection(view_projection);
+    for (int i = 0; i < MATH::Frustum::kPlaneCount; ++i)
+    {
+        const MATH::Plane& plane = frustum.planes[i];
+        uniforms.planes[i] = MATH::Vec4f{plane.normal.x, plane.normal.y, plane.normal.z, plane.d};
+    }
+    uniforms.camera_position = MATH::Vec4f{camera_position.x, camera_position.y, camera_position.z, 1.0F};
+    uniforms.cluster_count = cluster_count;
+    uniforms.cone_culling = cone_culling_ ? 1U : 0U;
+    uniforms.compact = compact_ ? 1U : 0U;
+    uniform_buffer_.Write(&uniforms, sizeof(uniforms), uniform_stride_ * frame_slot);
+
+    vkCmdFillBuffer(cmd, count_buffer_.Handle(), 0, kCountBytes, 0);
+    if (!compact_)
+    {
+        vkCmdFillBuffer(cmd, command_buffer_.Handle(), 0, VK_WHOLE_SIZE, 0);
+    }
+    VkMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(
+        cmd,
+        VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    if (cluster_count > 0)
+    {
+        const auto dynamic_offset = static_cast<uint32_t>(uniform_stride_ * frame_slot);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, layout_, 0, 1, &set_, 1, &dynamic_offset);
+        vkCmdDispatch(cmd, GroupCount(cluster_count, kCullGroupSize), 1, 1);
+    }
+
+    BufferBarrier(
+        cmd,
+        command_buffer_.Handle(),
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+    BufferBarrier(
+        cmd,
+        count_buffer_.Handle(),
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    const VkBufferCopy copy {0, 0, kCountBytes};
+    vkCmdCopyBuffer(cmd, count_buffer_.Handle(), readback_[frame_slot].Handle(), 1, &copy);
+    readback_pending_[frame_slot] = true;
+}
+
+void MeshletCulling::RecordDraws(VkCommandBuffer cmd) const
+{
+    const uint32_t cluster_count = instances_bound_ ? ClusterCount() : 0;
+    if (cluster_count == 0)
+    {
+        return;
+    }
+
+    constexpr auto kStride = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+    if (compact_)
+    {
+        vkCmdDrawIndexedIndirectCount(
+            cmd, command_buffer_.Handle(), 0, count_buffer_.Handle(), 0, cluster_count, kStride);
+        return;
+    }
+
+    // Culled slots hold zeroed commands (instanceCount == 0) and draw nothing.
+    if (multi_draw_)
+    {
+        vkCmdDrawIndexedIndirect(cmd, command_buffer_.Handle(), 0, cluster_count, kStride);
+        return;
+    }
+    for (uint32_t i = 0; i < cluster_count; ++i)
+    {
+        vkCmdDrawIndexedIndirect(cmd, command_buffer_.Handle(), static_cast<VkDeviceSize>(i) * kStride, 1, kStride);
+    }
+}
+
+void MeshletCulling::DrawDebugGui()
+{
+    if (!ImGui::Begin("Meshlet Culling"))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Path: %s", compact_ ? "DrawIndexedIndirectCount" : (multi_draw_ ? "MultiDrawIndirect" : "Indirect loop"));
+    ImGui::Checkbox("Normal cone culling", &cone_culling_);
+    ImGui::Separator();
+    ImGui::Text("Clusters: %u / %u", stats_.clusters, max_clusters_);
+    ImGui::Text("Meshlets: %zu / %u", meshlets_.size(), max_meshlets_);
+    ImGui::Text("Draws: %u", stats_.draws);
+    ImGui::Text("Culled: %u", stats_.clusters - std::min(stats_.clusters, stats_.draws));
+    ImGui::End();
+}
+
+void MeshletCulling::CreateBuffers()
+{
+    const Device& device = context_.GetDevice();
+    constexpr VkMemoryPropertyFlags kDeviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    constexpr VkMemoryPropertyFlags kHostVisible =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    const VkDeviceSize cluster_bytes = static_cast<VkDeviceSize>(max_clusters_) * sizeof(GpuCluster);
+    const VkDeviceSize meshlet_bytes = static_cast<VkDeviceSize>(max_meshlets_) * sizeof(GpuMeshlet);
+
+    cluster_buffer_ = Buffer(
+        device, cluster_bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, kDeviceLocal);
+    meshlet_buffer_ = Buffer(
+        device, meshlet_bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, kDeviceLocal);
+    command_buffer_ = Buffer(
+        device,
+        static_cast<VkDeviceSize>(max_clusters_) * sizeof(VkDrawIndexedIndirectCommand),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        kDeviceLocal);
+    count_buffer_ = Buffer(
+        device,
+        kCountBytes,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+            | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        kDeviceLocal);
+
+    VkPhysicalDeviceProperties properties {};
+    vkGetPhysicalDeviceProperties(context_.PhysicalDevice(), &properties);
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 1);
+    uniform_stride_ = (sizeof(CullUniforms) + alignment - 1) / alignment * alignment;
+    uniform_buffer_ = Buffer(
+        device, uniform_stride_ * VulkanContext::kMaxFramesInFlight, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, kHostVisible);
+
+    for (uint32_t i = 0; i < VulkanContext::kMaxFramesInFlight; ++i)
+    {
+        staging_.emplace_back(device, cluster_bytes + meshlet_bytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, kHostVisible);
+        readback_.emplace_back(device, kCountBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT, kHostVisible);
+    }
+    readback_pending_.assign(VulkanContext::kMaxFramesInFlight, false);
+}
+
+void MeshletCulling::CreateDescriptors()
+{
+    const std::array<VkDescriptorSetLayoutBinding, 6> bindings {{
+        {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+    }};
+
+    VkDescriptorSetLayoutCreateInfo layout_info {};
+    layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.bindingCount = static_cast<uint32_t>(bindings.size());
+    layout_info.pBindings = bindings.data();
+    if (vkCreateDescriptorSetLayout(device_, &layout_info, nullptr, &set_layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create meshlet cull descriptor set layout.");
+    }
+
+    const std::array<VkDescriptorPoolSize, 2> pool_sizes {{
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5},
+    }};
+    VkDescriptorPoolCreateInfo pool_info {};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.maxSets = 1;
+    pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+    pool_info.pPoolSizes = pool_sizes.data();
+    if (vkCreateDescriptorPool(device_, &pool_info, nullptr, &descriptor_pool_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create meshlet culling descriptor pool.");
+    }
+
+    VkDescriptorSetAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool = descriptor_pool_;
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts = &set_layout_;
+    if (vkAllocateDescriptorSets(device_, &alloc_info, &set_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate meshlet culling descriptor set.");
+    }
+}
+
+void MeshletCulling::CreatePipeline()
+{
+    VkPipelineLayoutCreateInfo layout_info {};
+    layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_info.setLayoutCount = 1;
+    layout_info.pSetLayouts = &set_layout_;
+    if (vkCreatePipelineLayout(device_, &layout_info, nullptr, &layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create meshlet cull pipeline layout.");
+    }
+    pipeline_ = CreateComputePipeline(device_, layout_, "meshlet_cull.comp.spv");
+}
+
+void MeshletCulling::WriteDescriptors()
+{
+    const VkDescriptorBufferInfo uniforms {uniform_buffer_.Handle(), 0, sizeof(CullUniforms)};
+    // Binding 1 (instances) is written by SetInstanceBuffer.
+    const std::array<VkDescriptorBufferInfo, 4> storage {{
+        {cluster_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {meshlet_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {command_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+        {count_buffer_.Handle(), 0, VK_WHOLE_SIZE},
+    }};
+
+    std::array<VkWriteDescriptorSet, 2> writes {};
+    for (auto& write : writes)
+    {
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set_;
+    }
+    writes[0].dstBinding = 0;
+    writes[0].descriptorCount = 1;
+    writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    writes[0].pBufferInfo = &uniforms;
+    writes[1].dstBinding = 2;
+    writes[1].descriptorCount = static_cast<uint32_t>(storage.size());
+    writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writes[1].pBufferInfo = storage.data();
+    vkUpdateDescriptorSets(device_, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+}
+}  // namespace ZKT
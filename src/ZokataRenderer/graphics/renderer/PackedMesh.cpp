@@ -0,0 +1,482 @@
+#include "ZokataRenderer/graphics/renderer/PackedMesh.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ZKT_PACKING_SSE2 1
+#endif
+
+namespace ZKT
+{
+namespace
+{
+constexpr float kUnorm16Max = 65535.0F;
+constexpr float kSnorm16Max = 32767.0F;
+constexpr float kSnorm8Max = 127.0F;
+constexpr float kMinExtent = 1e-20F;
+
+// Every field a packed vertex may need; WriteVertex picks the ones its format stores.
+struct EncodedVertex
+{
+    uint16_t position[3] {};
+    int16_t normal16[2] {};
+    int16_t tangent16[2] {};
+    int8_t normal8[2] {};
+    int8_t tangent8[2] {};
+    uint16_t uv[2] {};
+};
+
+// Round-half-up float -> half with denormals flushed to zero; the SSE2 path mirrors it bit for bit.
+uint16_t FloatToHalf(float value)
+{
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    const uint32_t sign = (bits >> 16) & 0x8000U;
+    const auto magnitude = static_cast<int32_t>(bits & 0x7FFFFFFFU);
+    int32_t half = (magnitude - (112 << 23) + (1 << 12)) >> 13;  // rebias exponent 127 -> 15
+    half = magnitude < (113 << 23) ? 0 : half;                   // underflow
+    half = magnitude >= (143 << 23) ? 0x7C00 : half;             // overflow to infinity
+    half = magnitude > (255 << 23) ? 0x7E00 : half;              // NaN
+    return static_cast<uint16_t>(sign | static_cast<uint32_t>(half));
+}
+
+float HalfToFloat(uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000U) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1FU;
+    const uint32_t mantissa = half & 0x3FFU;
+    if (exponent == 0)
+    {
+        const float denormal = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0 ? -denormal : denormal;
+    }
+    if (exponent == 31)
+    {
+        return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+// Octahedral mapping of a unit vector onto [-1, 1]^2; must match OctDecode in vertex_packing.glsl.
+void OctEncode(const MATH::Vec3f& v, float& out_x, float& out_y)
+{
+    const float l1 = std::max(std::abs(v.x) + std::abs(v.y) + std::abs(v.z), kMinExtent);
+    float x = v.x / l1;
+    float y = v.y / l1;
+    if (v.z < 0.0F)
+    {
+        const float wrapped_x = (1.0F - std::abs(y)) * (x >= 0.0F ? 1.0F : -1.0F);
+        const float wrapped_y = (1.0F - std::abs(x)) * (y >= 0.0F ? 1.0F : -1.0F);
+        x = wrapped_x;
+        y = wrapped_y;
+    }
+    out_x = x;
+    out_y = y;
+}
+
+MATH::Vec3f OctDecode(float x, float y)
+{
+    MATH::Vec3f n {x, y, 1.0F - std::abs(x) - std::abs(y)};
+    const float t = std::max(-n.z, 0.0F);
+    n.x += n.x >= 0.0F ? -t : t;
+    n.y += n.y >= 0.0F ? -t : t;
+    return n.Normalized();
+}
+
+// Round to nearest even, like cvtps2dq under the default MXCSR rounding mode.
+int32_t Quantize(float value, float lo, float hi, float scale)
+{
+    return static_cast<int32_t>(std::lrint(std::clamp(value, lo, hi) * scale));
+}
+
+void EncodeScalar(const MeshVertex& vertex, const MATH::Vec3f& offset, const MATH::Vec3f& inv_scale, EncodedVertex& out)
+{
+    const float p[3] = {(vertex.position.x - offset.x) * inv_scale.x,
+                        (vertex.position.y - offset.y) * inv_scale.y,
+                        (vertex.position.z - offset.z) * inv_scale.z};
+    for (int i = 0; i < 3; ++i)
+    {
+        out.position[i] = static_cast<uint16_t>(Quantize(p[i], 0.0F, 1.0F, kUnorm16Max));
+    }
+
+    float n[2];
+    float t[2];
+    OctEncode(vertex.normal, n[0], n[1]);
+    OctEncode(vertex.tangent, t[0], t[1]);
+    for (int i = 0; i < 2; ++i)
+    {
+        out.normal16[i] = static_cast<int16_t>(Quantize(n[i], -1.0F, 1.0F, kSnorm16Max));
+        out.tangent16[i] = static_cast<int16_t>(Quantize(t[i], -1.0F, 1.0F, kSnorm16Max));
+        out.normal8[i] = static_cast<int8_t>(Quantize(n[i], -1.0F, 1.0F, kSnorm8Max));
+        out.tangent8[i] = static_cast<int8_t>(Quantize(t[i], -1.0F, 1.0F, kSnorm8Max));
+    }
+    out.uv[0] = FloatToHalf(vertex.uv.x);
+    out.uv[1] = FloatToHalf(vertex.uv.y);
+}
+
+#ifdef ZKT_PACKING_SSE2
+__m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+__m128i Select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+__m128 Abs(__m128 v)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0F), v);
+}
+
+__m128i QuantizeSse(__m128 v, float lo, float hi, float scale)
+{
+    const __m128 clamped = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(lo)), _mm_set1_ps(hi));
+    return _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(scale)));
+}
+
+__m128i FloatToHalfSse(__m128 value)
+{
+    const __m128i bits = _mm_castps_si128(value);
+    const __m128i sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+    const __m128i magnitude = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+    __m128i half =
+        _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(magnitude, _mm_set1_epi32(112 << 23)), _mm_set1_epi32(1 << 12)), 13);
+    half = _mm_andnot_si128(_mm_cmplt_epi32(magnitude, _mm_set1_epi32(113 << 23)), half);
+    half = Select(_mm_cmpgt_epi32(magnitude, _mm_set1_epi32((143 << 23) - 1)), _mm_set1_epi32(0x7C00), half);
+    half = Select(_mm_cmpgt_epi32(magnitude, _mm_set1_epi32(255 << 23)), _mm_set1_epi32(0x7E00), half);
+    return _mm_or_si128(sign, half);
+}
+
+void OctEncodeSse(__m128 x, __m128 y, __m128 z, __m128& out_x, __m128& out_y)
+{
+    const __m128 l1 = _mm_max_ps(_mm_add_ps(_mm_add_ps(Abs(x), Abs(y)), Abs(z)), _mm_set1_ps(kMinExtent));
+    const __m128 ox = _mm_div_ps(x, l1);
+    const __m128 oy = _mm_div_ps(y, l1);
+    const __m128 one = _mm_set1_ps(1.0F);
+    const __m128 minus_one = _mm_set1_ps(-1.0F);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 sign_x = Select(_mm_cmpge_ps(ox, zero), one, minus_one);
+    const __m128 sign_y = Select(_mm_cmpge_ps(oy, zero), one, minus_one);
+    const __m128 wrapped_x = _mm_mul_ps(_mm_sub_ps(one, Abs(oy)), sign_x);
+    const __m128 wrapped_y = _mm_mul_ps(_mm_sub_ps(one, Abs(ox)), sign_y);
+    const __m128 lower = _mm_cmplt_ps(z, zero);
+    out_x = Select(lower, wrapped_x, ox);
+    out_y = Select(lower, wrapped_y, oy);
+}
+
+// Encodes four vertices in SoA form; results match EncodeScalar exactly.
+void EncodeBlock(const MeshVertex* vertices, const MATH::Vec3f& offset, const MATH::Vec3f& inv_scale, EncodedVertex* out)
+{
+    const MeshVertex& v0 = vertices[0];
+    const MeshVertex& v1 = vertices[1];
+    const MeshVertex& v2 = vertices[2];
+    const MeshVertex& v3 = vertices[3];
+
+    alignas(16) int32_t lanes[4];
+    const auto store = [&](__m128i value, auto assign) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), value);
+        for (int i = 0; i < 4; ++i)
+        {
+            assign(out[i], lanes[i]);
+        }
+    };
+
+    const __m128 px = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(v0.position.x, v1.position.x, v2.position.x, v3.position.x),
+                                            _mm_set1_ps(offset.x)),
+                                 _mm_set1_ps(inv_scale.x));
+    const __m128 py = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(v0.position.y, v1.position.y, v2.position.y, v3.position.y),
+                                            _mm_set1_ps(offset.y)),
+                                 _mm_set1_ps(inv_scale.y));
+    const __m128 pz = _mm_mul_ps(_mm_sub_ps(_mm_setr_ps(v0.position.z, v1.position.z, v2.position.z, v3.position.z),
+                                            _mm_set1_ps(offset.z)),
+                                 _mm_set1_ps(inv_scale.z));
+    store(QuantizeSse(px, 0.0F, 1.0F, kUnorm16Max), [](EncodedVertex& e, int32_t q) { e.position[0] = static_cast<uint16_t>(q); });
+    store(QuantizeSse(py, 0.0F, 1.0F, kUnorm16Max), [](EncodedVertex& e, int32_t q) { e.position[1] = static_cast<uint16_t>(q); });
+    store(QuantizeSse(pz, 0.0F, 1.0F, kUnorm16Max), [](EncodedVertex& e, int32_t q) { e.position[2] = static_cast<uint16_t>(q); });
+
+    __m128 nx;
+    __m128 ny;
+    OctEncodeSse(_mm_setr_ps(v0.normal.x, v1.normal.x, v2.normal.x, v3.normal.x),
+                 _mm_setr_ps(v0.normal.y, v1.normal.y, v2.normal.y, v3.normal.y),
+                 _mm_setr_ps(v0.normal.z, v1.normal.z, v2.normal.z, v3.normal.z),
+                 nx,
+                 ny);
+    __m128 tx;
+    __m128 ty;
+    OctEncodeSse(_mm_setr_ps(v0.tangent.x, v1.tangent.x, v2.tangent.x, v3.tangent.x),
+                 _mm_setr_ps(v0.tangent.y, v1.tangent.y, v2.tangent.y, v3.tangent.y),
+                 _mm_setr_ps(v0.tangent.z, v1.tangent.z, v2.tangent.z, v3.tangent.z),
+                 tx,
+                 ty);
+    store(QuantizeSse(nx, -1.0F, 1.0F, kSnorm16Max), [](EncodedVertex& e, int32_t q) { e.normal16[0] = static_cast<int16_t>(q); });
+    store(QuantizeSse(ny, -1.0F, 1.0F, kSnorm16Max), [](EncodedVertex& e, int32_t q) { e.normal16[1] = static_cast<int16_t>(q); });
+    store(QuantizeSse(tx, -1.0F, 1.0F, kSnorm16Max), [](EncodedVertex& e, int32_t q) { e.tangent16[0] = static_cast<int16_t>(q); });
+    store(QuantizeSse(ty, -1.0F, 1.0F, kSnorm16Max), [](EncodedVertex& e, int32_t q) { e.tangent16[1] = static_cast<int16_t>(q); });
+    store(QuantizeSse(nx, -1.0F, 1.0F, kSnorm8Max), [](EncodedVertex& e, int32_t q) { e.normal8[0] = static_cast<int8_t>(q); });
+    store(QuantizeSse(ny, -1.0F, 1.0F, kSnorm8Max), [](EncodedVertex& e, int32_t q) { e.normal8[1] = static_cast<int8_t>(q); });
+    store(QuantizeSse(tx, -1.0F, 1.0F, kSnorm8Max), [](EncodedVertex& e, int32_t q) { e.tangent8[0] = static_cast<int8_t>(q); });
+    store(QuantizeSse(ty, -1.0F, 1.0F, kSnorm8Max), [](EncodedVertex& e, int32_t q) { e.tangent8[1] = static_cast<int8_t>(q); });
+
+    store(FloatToHalfSse(_mm_setr_ps(v0.uv.x, v1.uv.x, v2.uv.x, v3.uv.x)),
+          [](EncodedVertex& e, int32_t h) { e.uv[0] = static_cast<uint16_t>(h); });
+    store(FloatToHalfSse(_mm_setr_ps(v0.uv.y, v1.uv.y, v2.uv.y, v3.uv.y)),
+          [](EncodedVertex& e, int32_t h) { e.uv[1] = static_cast<uint16_t>(h); });
+}
+#endif
+
+void WriteVertex(VertexFormat format, const EncodedVertex& e, uint8_t* dst)
+{
+    const uint16_t position[4] = {e.position[0], e.position[1], e.position[2], 0};
+    std::memcpy(dst, position, sizeof(position));
+    if (format == VertexFormat::Packed20)
+    {
+        std::memcpy(dst + 8, e.normal16, sizeof(e.normal16));
+        std::memcpy(dst + 12, e.tangent16, sizeof(e.tangent16));
+        std::memcpy(dst + 16, e.uv, sizeof(e.uv));
+    }
+    else
+    {
+        std::memcpy(dst + 8, e.normal8, sizeof(e.normal8));
+        std::memcpy(dst + 10, e.tangent8, sizeof(e.tangent8));
+        std::memcpy(dst + 12, e.uv, sizeof(e.uv));
+    }
+}
+
+void PackVertices(const MeshGeometry& geometry, VertexFormat format, PackedMesh& mesh)
+{
+    const size_t count = geometry.vertices.size();
+    const uint32_t stride = VertexStride(format);
+    mesh.vertices.resize(count * stride);
+    if (format == VertexFormat::Float32)
+    {
+        static_assert(sizeof(MeshVertex) == 44, "Float32 layout expects a tightly packed MeshVertex");
+        std::memcpy(mesh.vertices.data(), geometry.vertices.data(), mesh.vertices.size());
+        return;
+    }
+
+    MATH::Vec3f lo = count > 0 ? geometry.vertices.front().position : MATH::Vec3f{};
+    MATH::Vec3f hi = lo;
+    for (const MeshVertex& vertex : geometry.vertices)
+    {
+        lo = {std::min(lo.x, vertex.position.x), std::min(lo.y, vertex.position.y), std::min(lo.z, vertex.position.z)};
+        hi = {std::max(hi.x, vertex.position.x), std::max(hi.y, vertex.position.y), std::max(hi.z, vertex.position.z)};
+    }
+    const MATH::Vec3f extent {std::max(hi.x - lo.x, kMinExtent),
+                              std::max(hi.y - lo.y, kMinExtent),
+                              std::max(hi.z - lo.z, kMinExtent)};
+    mesh.quantization = VertexQuantization{lo, extent};
+    const MATH::Vec3f inv_scale {1.0F / extent.x, 1.0F / extent.y, 1.0F / extent.z};
+
+    uint8_t* dst = mesh.vertices.data();
+    size_t i = 0;
+#ifdef ZKT_PACKING_SSE2
+    for (; i + 4 <= count; i += 4)
+    {
+        EncodedVertex block[4];
+        EncodeBlock(&geometry.vertices[i], lo, inv_scale, block);
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            WriteVertex(format, block[lane], dst + (i + lane) * stride);
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        EncodedVertex encoded {};
+        EncodeScalar(geometry.vertices[i], lo, inv_scale, encoded);
+        WriteVertex(format, encoded, dst + i * stride);
+    }
+}
+
+void PackIndices(const MeshGeometry& geometry, PackedMesh& mesh)
+{
+    const size_t count = geometry.Indexed() ? geometry.indices.size() : geometry.vertices.size();
+    mesh.index_count = static_cast<uint32_t>(count);
+    mesh.index_format = SelectIndexFormat(geometry.vertices.size());
+
+    const auto index_at = [&](size_t i) {
+        return geometry.Indexed() ? geometry.indices[i] : static_cast<uint32_t>(i);
+    };
+    if (mesh.index_format == IndexFormat::UInt16)
+    {
+        mesh.indices.resize(count * sizeof(uint16_t));
+        auto* dst = reinterpret_cast<uint16_t*>(mesh.indices.data());
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[i] = static_cast<uint16_t>(index_at(i));
+        }
+    }
+    else
+    {
+        mesh.indices.resize(count * sizeof(uint32_t));
+        auto* dst = reinterpret_cast<uint32_t*>(mesh.indices.data());
+        for (size_t i = 0; i < count; ++i)
+        {
+            dst[i] = index_at(i);
+        }
+    }
+}
+}  // namespace
+
+uint32_t VertexStride(VertexFormat format)
+{
+    switch (format)
+    {
+    case VertexFormat::Float32:
+        return 44;
+    case VertexFormat::Packed20:
+        return 20;
+    case VertexFormat::Packed16:
+        return 16;
+    }
+    return 0;
+}
+
+const char* VertexFormatName(VertexFormat format)
+{
+    switch (format)
+    {
+    case VertexFormat::Float32:
+        return "Float32";
+    case VertexFormat::Packed20:
+        return "Packed20";
+    case VertexFormat::Packed16:
+        return "Packed16";
+    }
+    return "Unknown";
+}
+
+IndexFormat SelectIndexFormat(size_t vertex_count)
+{
+    return vertex_count < 0x10000 ? IndexFormat::UInt16 : IndexFormat::UInt32;
+}
+
+VkIndexType ToVkIndexType(IndexFormat format)
+{
+    return format == IndexFormat::UInt16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
+
+PackedMesh PackMesh(const MeshGeometry& geometry, VertexFormat format)
+{
+    if (geometry.vertices.size() > UINT32_MAX)
+    {
+        throw std::runtime_error("Mesh has too many vertices to pack");
+    }
+    PackedMesh mesh {};
+    mesh.vertex_format = format;
+    mesh.vertex_count = static_cast<uint32_t>(geometry.vertices.size());
+    PackVertices(geometry, format, mesh);
+    PackIndices(geometry, mesh);
+    return mesh;
+}
+
+MeshGeometry UnpackMesh(const PackedMesh& mesh)
+{
+    MeshGeometry geometry {};
+    geometry.vertices.resize(mesh.vertex_count);
+    const uint32_t stride = VertexStride(mesh.vertex_format);
+    if (mesh.vertices.size() < static_cast<size_t>(mesh.vertex_count) * stride)
+    {
+        throw std::runtime_error("Packed vertex data is truncated");
+    }
+
+    if (mesh.vertex_format == VertexFormat::Float32)
+    {
+        std::memcpy(geometry.vertices.data(), mesh.vertices.data(), static_cast<size_t>(mesh.vertex_count) * stride);
+    }
+    else
+    {
+        const VertexQuantization& q = mesh.quantization;
+        for (uint32_t i = 0; i < mesh.vertex_count; ++i)
+        {
+            const uint8_t* src = mesh.vertices.data() + static_cast<size_t>(i) * stride;
+            MeshVertex& vertex = geometry.vertices[i];
+
+            uint16_t position[4];
+            std::memcpy(position, src, sizeof(position));
+            vertex.position = {q.offset.x + static_cast<float>(position[0]) / kUnorm16Max * q.scale.x,
+                               q.offset.y + static_cast<float>(position[1]) / kUnorm16Max * q.scale.y,
+                               q.offset.z + static_cast<float>(position[2]) / kUnorm16Max * q.scale.z};
+
+            uint16_t uv[2];
+            if (mesh.vertex_format == VertexFormat::Packed20)
+            {
+                int16_t octs[4];
+                std::memcpy(octs, src + 8, sizeof(octs));
+                vertex.normal = OctDecode(std::max(octs[0] / kSnorm16Max, -1.0F), std::max(octs[1] / kSnorm16Max, -1.0F));
+                vertex.tangent = OctDecode(std::max(octs[2] / kSnorm16Max, -1.0F), std::max(octs[3] / kSnorm16Max, -1.0F));
+                std::memcpy(uv, src + 16, sizeof(uv));
+            }
+            else
+            {
+                int8_t octs[4];
+                std::memcpy(octs, src + 8, sizeof(octs));
+                vertex.normal = OctDecode(std::max(octs[0] / kSnorm8Max, -1.0F), std::max(octs[1] / kSnorm8Max, -1.0F));
+                vertex.tangent = OctDecode(std::max(octs[2] / kSnorm8Max, -1.0F), std::max(octs[3] / kSnorm8Max, -1.0F));
+                std::memcpy(uv, src + 12, sizeof(uv));
+            }
+            vertex.uv = {HalfToFloat(uv[0]), HalfToFloat(uv[1])};
+        }
+    }
+
+    geometry.indices.resize(mesh.index_count);
+    const size_t index_size = mesh.index_format == IndexFormat::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    if (mesh.indices.size() < static_cast<size_t>(mesh.index_count) * index_size)
+    {
+        throw std::runtime_error("Packed index data is truncated");
+    }
+    for (uint32_t i = 0; i < mesh.index_count; ++i)
+    {
+        if (mesh.index_format == IndexFormat::UInt16)
+        {
+            uint16_t index = 0;
+            std::memcpy(&index, mesh.indices.data() + i * sizeof(uint16_t), sizeof(index));
+            geometry.indices[i] = index;
+        }
+        else
+        {
+            std::memcpy(&geometry.indices[i], mesh.indices.data() + i * sizeof(uint32_t), sizeof(uint32_t));
+        }
+    }
+    return geometry;
+}
+
+VkVertexInputBindingDescription VertexBinding(VertexFormat format, uint32_t binding)
+{
+    return VkVertexInputBindingDescription{binding, VertexStride(format), VK_VERTEX_INPUT_RATE_VERTEX};
+}
+
+std::vector<VkVertexInputAttributeDescription> VertexAttributes(VertexFormat format, uint32_t binding)
+{
+    switch (format)
+    {
+    case VertexFormat::Float32:
+        return {
+            {0, binding, VK_FORMAT_R32G32B32_SFLOAT, 0},
+            {1, binding, VK_FORMAT_R32G32B32_SFLOAT, 12},
+            {2, binding, VK_FORMAT_R32G32_SFLOAT, 24},
+            {3, binding, VK_FORMAT_R32G32B32_SFLOAT, 32},
+        };
+    case VertexFormat::Packed20:
+        return {
+            {0, binding, VK_FORMAT_R16G16B16A16_UNORM, 0},
+            {1, binding, VK_FORMAT_R16G16_SNORM, 8},
+            {2, binding, VK_FORMAT_R16G16_SFLOAT, 16},
+            {3, binding, VK_FORMAT_R16G16_SNORM, 12},
+        };
+    case VertexFormat::Packed16:
+        return {
+            {0, binding, VK_FORMAT_R16G16B16A16_UNORM, 0},
+            {1, binding, VK_FORMAT_R8G8B8A8_SNORM, 8},
+            {2, binding, VK_FORMAT_R16G16_SFLOAT, 12},
+        };
+    }
+    return {};
+}
+}  // namespace ZKT
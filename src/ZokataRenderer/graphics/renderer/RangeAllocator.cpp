@@ -0,0 +1,111 @@
+#include "ZokataRenderer/graphics/renderer/RangeAllocator.h"
+
+#include <iterator>
+#include <stdexcept>
+
+namespace ZKT
+{
+RangeAllocator::RangeAllocator(uint32_t capacity)
+{
+    Reset(capacity);
+}
+
+void RangeAllocator::Reset(uint32_t capacity)
+{
+    capacity_ = capacity;
+    used_ = 0;
+    free_by_offset_.clear();
+    free_by_size_.clear();
+    if (capacity > 0)
+    {
+        InsertFree(0, capacity);
+    }
+}
+
+uint32_t RangeAllocator::Allocate(uint32_t size)
+{
+    if (size == 0)
+    {
+        return kInvalidOffset;
+    }
+    const auto fit = free_by_size_.lower_bound(size);
+    if (fit == free_by_size_.end())
+    {
+        return kInvalidOffset;
+    }
+
+    const uint32_t block_size = fit->first;
+    const uint32_t offset = fit->second;
+    EraseFree(free_by_offset_.find(offset));
+    if (block_size > size)
+    {
+        InsertFree(offset + size, block_size - size);
+    }
+    used_ += size;
+    return offset;
+}
+
+void RangeAllocator::Free(uint32_t offset, uint32_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    if (offset > capacity_ || size > capacity_ - offset || size > used_)
+    {
+        throw std::runtime_error("RangeAllocator::Free got a range it never allocated.");
+    }
+    used_ -= size;
+
+    auto next = free_by_offset_.lower_bound(offset);
+    if (next != free_by_offset_.end() && next->first == offset + size)
+    {
+        size += next->second->first;
+        next = std::next(next);
+        EraseFree(std::prev(next));
+    }
+    if (next != free_by_offset_.begin())
+    {
+        const auto previous = std::prev(next);
+        const uint32_t previous_size = previous->second->first;
+        if (previous->first + previous_size == offset)
+        {
+            offset = previous->first;
+            size += previous_size;
+            EraseFree(previous);
+        }
+    }
+    InsertFree(offset, size);
+}
+
+uint32_t RangeAllocator::Capacity() const
+{
+    return capacity_;
+}
+
+uint32_t RangeAllocator::Used() const
+{
+    return used_;
+}
+
+uint32_t RangeAllocator::LargestFreeBlock() const
+{
+    return free_by_size_.empty() ? 0 : std::prev(free_by_size_.end())->first;
+}
+
+uint32_t RangeAllocator::FreeBlockCount() const
+{
+    return static_cast<uint32_t>(free_by_offset_.size());
+}
+
+void RangeAllocator::InsertFree(uint32_t offset, uint32_t size)
+{
+    free_by_offset_.emplace(offset, free_by_size_.emplace(size, offset));
+}
+
+void RangeAllocator::EraseFree(std::map<uint32_t, SizeIndex::iterator>::iterator block)
+{
+    free_by_size_.erase(block->second);
+    free_by_offset_.erase(block);
+}
+}  // namespace ZKT
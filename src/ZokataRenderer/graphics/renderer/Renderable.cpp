@@ -2,6 +2,53 @@
 
 namespace ZKT
 {
+namespace
+{
+constexpr uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+// FNV-1a over the string plus a terminator, so ("ab", "c") and ("a", "bc") differ.
+void HashString(uint64_t& hash, const std::string& value)
+{
+    for (const char c : value)
+    {
+        hash = (hash ^ static_cast<unsigned char>(c)) * kFnvPrime;
+    }
+    hash = (hash ^ 0xFFU) * kFnvPrime;
+}
+}  // namespace
+
+uint64_t HashMaterial(const MaterialDescriptor& material)
+{
+    uint64_t hash = kFnvOffset;
+    HashString(hash, material.shader_id);
+    for (const std::string& texture : material.textures)
+    {
+        HashString(hash, texture);
+    }
+    return hash;
+}
+
+uint64_t Renderable::MaterialKey() const
+{
+    return HashMaterial(Material());
+}
+
+uint32_t Renderable::LodCount() const
+{
+    return 1;
+}
+
+const MeshGeometry& Renderable::LodGeometry(uint32_t /*lod*/) const
+{
+    return Geometry();
+}
+
+const std::vector<GpuMeshlet>* Renderable::Meshlets() const
+{
+    return nullptr;
+}
+
 bool Renderable::IsVisible() const
 {
     return true;
@@ -2,7 +2,33 @@
 
 namespace ZKT
 {
+void IRenderer::BeginFrame(const FrameDescriptor& /*frame*/)
+{
+}
+
+void IRenderer::RecordFrame(const FrameDescriptor& /*frame*/)
+{
+}
+
+void IRenderer::RecordPass(const FrameDescriptor& /*frame*/)
+{
+}
+
 void IRenderer::OnSwapchainUpdated(VkExtent2D /*extent*/)
 {
 }
+
+TextureStreamer* IRenderer::Textures()
+{
+    return nullptr;
+}
+
+VirtualTextureAtlas* IRenderer::VirtualTextures()
+{
+    return nullptr;
+}
+
+void IRenderer::SetMaterialVirtualTexture(uint64_t /*material_key*/, uint32_t /*texture*/)
+{
+}
 }  // namespace ZKT
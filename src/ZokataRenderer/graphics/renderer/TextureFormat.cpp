@@ -0,0 +1,112 @@
+#include "ZokataRenderer/graphics/renderer/TextureFormat.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace ZKT
+{
+VkFormat ToVkFormat(TextureFormat format, bool srgb)
+{
+    switch (format)
+    {
+    case TextureFormat::RGBA8:
+        return srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+    case TextureFormat::BC1:
+        return srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+    case TextureFormat::BC3:
+        return srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+    case TextureFormat::BC5:
+        return VK_FORMAT_BC5_UNORM_BLOCK;
+    case TextureFormat::BC7:
+        return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+TexelBlock FormatBlock(VkFormat format)
+{
+    switch (format)
+    {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+        return TexelBlock{1, 1, 4};
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        return TexelBlock{4, 4, 8};
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+        return TexelBlock{4, 4, 16};
+    default:
+        return TexelBlock{1, 1, 0};
+    }
+}
+
+TexelBlock FormatBlock(TextureFormat format)
+{
+    return FormatBlock(ToVkFormat(format, false));
+}
+
+bool IsSrgbFormat(VkFormat format)
+{
+    return format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_BC1_RGB_SRGB_BLOCK
+           || format == VK_FORMAT_BC3_SRGB_BLOCK || format == VK_FORMAT_BC7_SRGB_BLOCK;
+}
+
+const char* TextureFormatName(TextureFormat format)
+{
+    switch (format)
+    {
+    case TextureFormat::RGBA8:
+        return "RGBA8";
+    case TextureFormat::BC1:
+        return "BC1";
+    case TextureFormat::BC3:
+        return "BC3";
+    case TextureFormat::BC5:
+        return "BC5";
+    case TextureFormat::BC7:
+        return "BC7";
+    }
+    return "Unknown";
+}
+
+bool ParseTextureFormat(std::string_view name, TextureFormat& format)
+{
+    constexpr TextureFormat kFormats[] = {
+        TextureFormat::RGBA8, TextureFormat::BC1, TextureFormat::BC3, TextureFormat::BC5, TextureFormat::BC7};
+    for (const TextureFormat candidate : kFormats)
+    {
+        const std::string_view candidate_name = TextureFormatName(candidate);
+        const bool equal = std::equal(
+            name.begin(), name.end(), candidate_name.begin(), candidate_name.end(), [](char a, char b) {
+                return (a >= 'a' && a <= 'z' ? static_cast<char>(a - 'a' + 'A') : a) == b;
+            });
+        if (equal)
+        {
+            format = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+VkExtent2D MipExtent(VkExtent2D base, uint32_t level)
+{
+    return VkExtent2D{std::max(1U, base.width >> level), std::max(1U, base.height >> level)};
+}
+
+uint32_t FullMipCount(VkExtent2D base)
+{
+    return static_cast<uint32_t>(std::bit_width(std::max({base.width, base.height, 1U})));
+}
+
+VkDeviceSize MipByteSize(const TexelBlock& block, VkExtent2D extent)
+{
+    const VkDeviceSize blocks_x = (extent.width + block.width - 1) / block.width;
+    const VkDeviceSize blocks_y = (extent.height + block.height - 1) / block.height;
+    return blocks_x * blocks_y * block.bytes;
+}
+}  // namespace ZKT
@@ -0,0 +1,288 @@
+#include "ZokataRenderer/graphics/renderer/TextureStreamer.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <imgui.h>
+
+#include "ZokataRenderer/graphics/renderer/UploadService.h"
+#include "ZokataRenderer/graphics/vk/Device.h"
+
+namespace ZKT
+{
+namespace
+{
+// Frame budgets' worth of levels handed to the uploader ahead of time: enough to keep every
+// frame's batch full, few enough that a new texture's small levels go out within a frame or two.
+constexpr VkDeviceSize kFramesAhead = 2;
+
+VkDeviceSize LevelBytes(const Image& image, uint32_t level)
+{
+    return MipByteSize(FormatBlock(image.Format()), MipExtent(image.Extent(), level));
+}
+}  // namespace
+
+TextureStreamer::TextureStreamer(const VulkanContext& context, UploadService& uploader)
+    : context_(context)
+    , uploader_(uploader)
+    , device_(context.DeviceHandle())
+    , bc_supported_(context.GetDevice().Features().texture_compression_bc)
+    , retired_(VulkanContext::kMaxFramesInFlight)
+{
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    for (const Texture& texture : textures_)
+    {
+        if (texture.view != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(device_, texture.view, nullptr);
+        }
+    }
+    for (const std::vector<Retired>& slot : retired_)
+    {
+        for (const Retired& retired : slot)
+        {
+            if (retired.view != VK_NULL_HANDLE)
+            {
+                vkDestroyImageView(device_, retired.view, nullptr);
+            }
+        }
+    }
+}
+
+uint32_t TextureStreamer::Create(const Ktx2Texture& texture, std::shared_ptr<const void> owner)
+{
+    const TexelBlock block = FormatBlock(texture.format);
+    if (block.bytes == 0 || texture.levels.empty())
+    {
+        throw std::runtime_error("TextureStreamer cannot stream VkFormat " + std::to_string(texture.format) + ".");
+    }
+    if (block.width > 1 && !bc_supported_)
+    {
+        throw std::runtime_error("Device does not support BC texture compression.");
+    }
+    VkFormatProperties properties {};
+    vkGetPhysicalDeviceFormatProperties(context_.PhysicalDevice(), texture.format, &properties);
+    if ((properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) == 0)
+    {
+        throw std::runtime_error("Device cannot sample VkFormat " + std::to_string(texture.format) + ".");
+    }
+
+    uint32_t id = 0;
+    if (!free_ids_.empty())
+    {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(textures_.size());
+        textures_.emplace_back();
+    }
+
+    const uint32_t level_count = texture.LevelCount();
+    Texture& entry = textures_[id];
+    entry.image = Image(
+        context_.GetDevice(),
+        texture.format,
+        texture.extent,
+        level_count,
+        VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+    entry.owner = std::move(owner);
+    entry.levels = texture.levels;
+    entry.tickets.assign(level_count, 0);
+    entry.resident_mip = level_count;
+    entry.unsent_levels = level_count;
+    entry.live = true;
+    streaming_.push_back(id);
+
+    // Smallest first; equal sizes (the block-sized tail of a mip chain) go coarsest first, so a
+    // texture's levels always arrive finest-last.
+    const auto smaller = [](const PendingLevel& a, const PendingLevel& b) {
+        return a.bytes != b.bytes ? a.bytes < b.bytes : a.level > b.level;
+    };
+    for (uint32_t level = 0; level < level_count; ++level)
+    {
+        const PendingLevel pending {id, level, texture.levels[level].size()};
+        pending_.insert(std::upper_bound(pending_.begin(), pending_.end(), pending, smaller), pending);
+        stats_.pending_bytes += pending.bytes;
+    }
+    stats_.textures = static_cast<uint32_t>(textures_.size() - free_ids_.size());
+    stats_.streaming = static_cast<uint32_t>(streaming_.size());
+    return id;
+}
+
+void TextureStreamer::Release(uint32_t texture)
+{
+    Texture& entry = textures_.at(texture);
+    if (!entry.live)
+    {
+        return;
+    }
+
+    std::erase_if(pending_, [this, texture](const PendingLevel& pending) {
+        if (pending.texture != texture)
+        {
+            return false;
+        }
+        stats_.pending_bytes -= pending.bytes;
+        return true;
+    });
+    std::erase(streaming_, texture);
+
+    uint64_t last_ticket = 0;
+    const auto level_count = static_cast<uint32_t>(entry.tickets.size());
+    for (uint32_t level = 0; level < level_count; ++level)
+    {
+        const VkDeviceSize bytes = LevelBytes(entry.image, level);
+        if (level >= entry.resident_mip)
+        {
+            stats_.resident_bytes -= bytes;
+        }
+        else if (entry.tickets[level] != 0)
+        {
+            stats_.in_flight_bytes -= bytes;
+        }
+        last_ticket = std::max(last_ticket, entry.tickets[level]);
+    }
+
+    // Frames recorded with this slot may still sample the image, and queued copies write it.
+    retired_[frame_slot_].push_back(Retired{std::move(entry.image), entry.view, last_ticket});
+    entry = Texture {};
+    free_ids_.push_back(texture);
+    stats_.textures = static_cast<uint32_t>(textures_.size() - free_ids_.size());
+    stats_.streaming = static_cast<uint32_t>(streaming_.size());
+}
+
+void TextureStreamer::BeginFrame(uint32_t frame_slot)
+{
+    frame_slot_ = frame_slot;
+    std::erase_if(retired_[frame_slot], [this](const Retired& retired) {
+        if (retired.image.Valid() && !uploader_.IsComplete(retired.ticket))
+        {
+            return false;
+        }
+        if (retired.view != VK_NULL_HANDLE)
+        {
+            vkDestroyImageView(device_, retired.view, nullptr);
+        }
+        return true;
+    });
+
+    // Tickets complete in queue order and a texture's levels are queued coarsest first, so
+    // residency only ever grows one finer level at a time.
+    std::erase_if(streaming_, [this](uint32_t id) {
+        Texture& texture = textures_[id];
+        const uint32_t previous = texture.resident_mip;
+        while (texture.resident_mip > 0)
+        {
+            const uint64_t ticket = texture.tickets[texture.resident_mip - 1];
+            if (ticket == 0 || !uploader_.IsComplete(ticket))
+            {
+                break;
+            }
+            --texture.resident_mip;
+            const VkDeviceSize bytes = LevelBytes(texture.image, texture.resident_mip);
+            stats_.in_flight_bytes -= bytes;
+            stats_.resident_bytes += bytes;
+        }
+        if (texture.resident_mip != previous)
+        {
+            UpdateView(texture);
+        }
+        return texture.resident_mip == 0;
+    });
+
+    Feed();
+    stats_.streaming = static_cast<uint32_t>(streaming_.size());
+}
+
+VkImageView TextureStreamer::View(uint32_t texture) const
+{
+    return textures_.at(texture).view;
+}
+
+uint32_t TextureStreamer::ResidentMip(uint32_t texture) const
+{
+    return textures_.at(texture).resident_mip;
+}
+
+bool TextureStreamer::IsResident(uint32_t texture) const
+{
+    const Texture& entry = textures_.at(texture);
+    return entry.live && entry.resident_mip == 0;
+}
+
+const TextureStreamerStats& TextureStreamer::Stats() const
+{
+    return stats_;
+}
+
+void TextureStreamer::DrawDebugGui() const
+{
+    if (!ImGui::Begin("Texture Streaming"))
+    {
+        ImGui::End();
+        return;
+    }
+    constexpr double kMiB = 1024.0 * 1024.0;
+    ImGui::Text("Textures: %u (%u streaming)", stats_.textures, stats_.streaming);
+    ImGui::Text("BC compression: %s", bc_supported_ ? "supported" : "unsupported");
+    ImGui::Text("Resident: %.1f MiB", static_cast<double>(stats_.resident_bytes) / kMiB);
+    ImGui::Text("Uploading: %.1f MiB", static_cast<double>(stats_.in_flight_bytes) / kMiB);
+    ImGui::Text("Pending: %.1f MiB (%zu levels)", static_cast<double>(stats_.pending_bytes) / kMiB, pending_.size());
+    ImGui::End();
+}
+
+void TextureStreamer::Feed()
+{
+    const VkDeviceSize window = uploader_.FrameBudget() * kFramesAhead;
+    size_t handed = 0;
+    while (handed < pending_.size() && stats_.in_flight_bytes < window)
+    {
+        const PendingLevel& pending = pending_[handed++];
+        Texture& texture = textures_[pending.texture];
+        texture.tickets[pending.level] = uploader_.UploadImage(
+            texture.image.Handle(),
+            texture.image.Format(),
+            pending.level,
+            MipExtent(texture.image.Extent(), pending.level),
+            texture.levels[pending.level],
+            texture.owner);
+        stats_.pending_bytes -= pending.bytes;
+        stats_.in_flight_bytes += pending.bytes;
+        if (--texture.unsent_levels == 0)
+        {
+            // The uploader holds its own reference until the last bytes are staged.
+            texture.owner.reset();
+            texture.levels.clear();
+        }
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(handed));
+}
+
+void TextureStreamer::UpdateView(Texture& texture)
+{
+    if (texture.view != VK_NULL_HANDLE)
+    {
+        retired_[frame_slot_].push_back(Retired{Image {}, texture.view, 0});
+        texture.view = VK_NULL_HANDLE;
+    }
+
+    VkImageViewCreateInfo view_info {};
+    view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_info.image = texture.image.Handle();
+    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format = texture.image.Format();
+    view_info.subresourceRange = {
+        VK_IMAGE_ASPECT_COLOR_BIT, texture.resident_mip, texture.image.MipLevels() - texture.resident_mip, 0, 1};
+    if (vkCreateImageView(device_, &view_info, nullptr, &texture.view) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create texture view.");
+    }
+}
+}  // namespace ZKT
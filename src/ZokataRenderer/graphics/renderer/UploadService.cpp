@@ -0,0 +1,589 @@
+#include "ZokataRenderer/graphics/renderer/UploadService.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <imgui.h>
+
+#include "ZokataRenderer/graphics/vk/Device.h"
+
+namespace ZKT
+{
+namespace
+{
+constexpr VkMemoryPropertyFlags kHostVisible =
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+constexpr VkDeviceSize kRingAlignment = 16;
+
+// Every way the renderer reads uploaded buffers.
+constexpr VkAccessFlags kConsumerAccess = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT
+                                         | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT
+                                         | VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+constexpr VkPipelineStageFlags kConsumerStages =
+    VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT
+    | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+// Uploaded images are only ever sampled.
+constexpr VkAccessFlags kImageConsumerAccess = VK_ACCESS_SHADER_READ_BIT;
+
+VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+VkBufferMemoryBarrier OwnershipBarrier(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size, uint32_t src, uint32_t dst)
+{
+    VkBufferMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = src;
+    barrier.dstQueueFamilyIndex = dst;
+    barrier.buffer = buffer;
+    barrier.offset = offset;
+    barrier.size = size;
+    return barrier;
+}
+
+VkImageMemoryBarrier LayoutBarrier(
+    VkImage image, uint32_t mip_level, VkImageLayout from, VkImageLayout to, uint32_t src, uint32_t dst)
+{
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = from;
+    barrier.newLayout = to;
+    barrier.srcQueueFamilyIndex = src;
+    barrier.dstQueueFamilyIndex = dst;
+    barrier.image = image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, mip_level, 1, 0, 1};
+    return barrier;
+}
+}  // namespace
+
+UploadService::UploadService(const VulkanContext& context, VkDeviceSize ring_size, VkDeviceSize frame_budget)
+    : context_(context)
+    , device_(context.DeviceHandle())
+    , queue_(context.TransferQueue())
+    , transfer_family_(context.TransferQueueFamily())
+    , graphics_family_(context.GraphicsQueueFamily())
+    , dedicated_(context.TransferQueueFamily() != context.GraphicsQueueFamily())
+{
+    ring_ = Buffer(
+        context_.GetDevice(),
+        AlignUp(std::max(ring_size, kRingAlignment), kRingAlignment),
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        kHostVisible);
+    ring_data_ = static_cast<uint8_t*>(ring_.Mapped());
+    SetFrameBudget(frame_budget);
+
+    VkCommandPoolCreateInfo pool_info {};
+    pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.queueFamilyIndex = transfer_family_;
+    pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    if (vkCreateCommandPool(device_, &pool_info, nullptr, &command_pool_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create upload command pool.");
+    }
+}
+
+UploadService::~UploadService()
+{
+    for (const Batch& batch : in_flight_)
+    {
+        vkWaitForFences(device_, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+    }
+    for (const Batch& batch : in_flight_)
+    {
+        vkDestroyFence(device_, batch.fence, nullptr);
+    }
+    for (const Batch& batch : free_batches_)
+    {
+        vkDestroyFence(device_, batch.fence, nullptr);
+    }
+    // Destroying the pool frees every batch's command buffer.
+    vkDestroyCommandPool(device_, command_pool_, nullptr);
+}
+
+uint64_t UploadService::Upload(VkBuffer dst, VkDeviceSize offset, std::vector<uint8_t> data)
+{
+    auto owned = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+    const std::span<const uint8_t> bytes(*owned);
+    return Upload(dst, offset, bytes, std::move(owned));
+}
+
+uint64_t UploadService::Upload(
+    VkBuffer dst, VkDeviceSize offset, std::span<const uint8_t> data, std::shared_ptr<const void> owner)
+{
+    Request request;
+    request.dst = dst;
+    request.offset = offset;
+    request.owner = std::move(owner);
+    request.bytes = data.data();
+    request.size = data.size();
+    return Enqueue(std::move(request));
+}
+
+uint64_t UploadService::UploadImage(
+    VkImage dst,
+    VkFormat format,
+    uint32_t mip_level,
+    VkExtent2D extent,
+    std::span<const uint8_t> data,
+    std::shared_ptr<const void> owner)
+{
+    const TexelBlock block = FormatBlock(format);
+    const VkDeviceSize expected = MipByteSize(block, extent);
+    if (block.bytes == 0 || data.size() != expected)
+    {
+        throw std::runtime_error(
+            "UploadImage: level " + std::to_string(mip_level) + " has " + std::to_string(data.size()) + " bytes, expected "
+            + std::to_string(expected) + ".");
+    }
+    Request request;
+    request.image = dst;
+    request.mip_level = mip_level;
+    request.extent = extent;
+    request.block = block;
+    request.owner = std::move(owner);
+    request.bytes = data.data();
+    request.size = data.size();
+    return Enqueue(std::move(request));
+}
+
+uint64_t UploadService::UploadImageRegion(
+    VkImage dst,
+    VkFormat format,
+    uint32_t mip_level,
+    VkOffset2D offset,
+    VkExtent2D extent,
+    std::span<const uint8_t> data,
+    std::shared_ptr<const void> owner)
+{
+    const TexelBlock block = FormatBlock(format);
+    const VkDeviceSize expected = MipByteSize(block, extent);
+    if (block.bytes == 0 || data.size() != expected || offset.x % block.width != 0 || offset.y % block.height != 0)
+    {
+        throw std::runtime_error(
+            "UploadImageRegion: " + std::to_string(data.size()) + " bytes at (" + std::to_string(offset.x) + ", "
+            + std::to_string(offset.y) + "), expected " + std::to_string(expected) + " at a block-aligned offset.");
+    }
+    Request request;
+    request.image = dst;
+    request.mip_level = mip_level;
+    request.image_offset = offset;
+    request.extent = extent;
+    request.block = block;
+    request.general_layout = true;
+    request.owner = std::move(owner);
+    request.bytes = data.data();
+    request.size = data.size();
+    return Enqueue(std::move(request));
+}
+
+uint64_t UploadService::Enqueue(Request request)
+{
+    std::lock_guard lock(mutex_);
+    request.ticket = ++next_ticket_;
+    queued_bytes_ += request.size;
+    requests_.push_back(std::move(request));
+    return requests_.back().ticket;
+}
+
+bool UploadService::IsComplete(uint64_t ticket) const
+{
+    return ticket <= completed_ticket_.load(std::memory_order_acquire);
+}
+
+void UploadService::BeginFrame(VkCommandBuffer cmd)
+{
+    Retire(cmd);
+    Submit();
+}
+
+void UploadService::SetFrameBudget(VkDeviceSize bytes)
+{
+    // One frame's chunk must fit the ring in one piece.
+    frame_budget_ = std::clamp(AlignUp(bytes, kRingAlignment), kRingAlignment, ring_.Size());
+}
+
+VkDeviceSize UploadService::FrameBudget() const
+{
+    return frame_budget_;
+}
+
+bool UploadService::HasDedicatedQueue() const
+{
+    return dedicated_;
+}
+
+void UploadService::Retire(VkCommandBuffer cmd)
+{
+    std::vector<VkBufferMemoryBarrier> acquires;
+    std::vector<VkImageMemoryBarrier> image_acquires;
+    uint64_t completed = completed_ticket_.load(std::memory_order_relaxed);
+    while (!in_flight_.empty() && vkGetFenceStatus(device_, in_flight_.front().fence) == VK_SUCCESS)
+    {
+        Batch batch = std::move(in_flight_.front());
+        in_flight_.pop_front();
+        tail_ = batch.ring_end;
+        completed = std::max(completed, batch.last_ticket);
+        if (dedicated_)
+        {
+            // Must match the release recorded on the transfer queue range for range.
+            for (const Region& region : batch.regions)
+            {
+                if (region.image != VK_NULL_HANDLE)
+                {
+                    VkImageMemoryBarrier acquire = LayoutBarrier(
+                        region.image,
+                        region.mip_level,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        transfer_family_,
+                        graphics_family_);
+                    acquire.dstAccessMask = kImageConsumerAccess;
+                    image_acquires.push_back(acquire);
+                    continue;
+                }
+                VkBufferMemoryBarrier acquire =
+                    OwnershipBarrier(region.dst, region.offset, region.size, transfer_family_, graphics_family_);
+                acquire.dstAccessMask = kConsumerAccess;
+                acquires.push_back(acquire);
+            }
+        }
+        batch.regions.clear();
+        free_batches_.push_back(std::move(batch));
+    }
+
+    if (!acquires.empty() || !image_acquires.empty())
+    {
+        vkCmdPipelineBarrier(
+            cmd,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            kConsumerStages,
+            0, 0, nullptr,
+            static_cast<uint32_t>(acquires.size()), acquires.data(),
+            static_cast<uint32_t>(image_acquires.size()), image_acquires.data());
+    }
+    completed_ticket_.store(completed, std::memory_order_release);
+}
+
+void UploadService::Submit()
+{
+    Batch batch = AcquireBatch();
+    std::vector<VkBufferCopy> copies;
+    std::vector<VkBuffer> copy_dsts;  // parallel to copies
+    std::vector<VkBufferImageCopy> image_copies;
+    std::vector<VkImage> image_dsts;  // parallel to image_copies
+    std::vector<VkImageLayout> image_layouts;
+    std::vector<VkImageMemoryBarrier> prepares;
+    std::vector<Region> finished_images;
+    VkDeviceSize submitted = 0;
+    bool ring_full = false;
+    {
+        std::lock_guard lock(mutex_);
+        while (!requests_.empty())
+        {
+            Request& request = requests_.front();
+            const VkDeviceSize budget = frame_budget_ - std::min(submitted, frame_budget_);
+            VkDeviceSize chunk = std::min(request.size - request.copied, budget);
+            if (request.image != VK_NULL_HANDLE)
+            {
+                // Whole rows of blocks only; a row larger than the budget goes alone.
+                const VkDeviceSize row_bytes = MipByteSize(request.block, VkExtent2D{request.extent.width, 1});
+                const VkDeviceSize rows = chunk / row_bytes;
+                chunk = rows > 0 ? rows * row_bytes : (submitted == 0 ? row_bytes : 0);
+            }
+            if (chunk > 0)
+            {
+                VkDeviceSize ring_offset = 0;
+                if (!AllocateRing(chunk, ring_offset))
+                {
+                    ring_full = true;
+                    break;
+                }
+                std::memcpy(ring_data_ + ring_offset, request.bytes + request.copied, chunk);
+                if (request.image == VK_NULL_HANDLE)
+                {
+                    batch.regions.push_back(Region{request.dst, request.offset + request.copied, chunk});
+                    copies.push_back(VkBufferCopy{ring_offset, request.offset + request.copied, chunk});
+                    copy_dsts.push_back(request.dst);
+                }
+                else
+                {
+                    const VkDeviceSize row_bytes = MipByteSize(request.block, VkExtent2D{request.extent.width, 1});
+                    const auto first_row = static_cast<uint32_t>(request.copied / row_bytes * request.block.height);
+                    const auto row_count = static_cast<uint32_t>(chunk / row_bytes * request.block.height);
+                    VkBufferImageCopy copy {};
+                    copy.bufferOffset = ring_offset;
+                    copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, request.mip_level, 0, 1};
+                    copy.imageOffset = {
+                        request.image_offset.x, request.image_offset.y + static_cast<int32_t>(first_row), 0};
+                    copy.imageExtent = {
+                        request.extent.width, std::min(row_count, request.extent.height - first_row), 1};
+                    if (request.copied == 0 && !request.general_layout)
+                    {
+                        VkImageMemoryBarrier prepare = LayoutBarrier(
+                            request.image,
+                            request.mip_level,
+                            VK_IMAGE_LAYOUT_UNDEFINED,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                            VK_QUEUE_FAMILY_IGNORED,
+                            VK_QUEUE_FAMILY_IGNORED);
+                        prepare.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                        prepares.push_back(prepare);
+                    }
+                    image_copies.push_back(copy);
+                    image_dsts.push_back(request.image);
+                    image_layouts.push_back(
+                        request.general_layout ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+                }
+                request.copied += chunk;
+                submitted += chunk;
+            }
+            if (request.copied < request.size)
+            {
+                break;  // out of budget; the rest goes next frame
+            }
+            if (request.image != VK_NULL_HANDLE && !request.general_layout)
+            {
+                Region finished {};
+                finished.image = request.image;
+                finished.mip_level = request.mip_level;
+                finished_images.push_back(finished);
+            }
+            batch.last_ticket = request.ticket;
+            queued_bytes_ -= request.size;
+            requests_.pop_front();
+        }
+    }
+    last_frame_bytes_ = submitted;
+    total_bytes_ += submitted;
+    ring_full_frames_ += ring_full ? 1 : 0;
+
+    if (copies.empty() && image_copies.empty())
+    {
+        // Only empty uploads: they finish with whatever is ahead of them.
+        if (batch.last_ticket != 0)
+        {
+            if (in_flight_.empty())
+            {
+                completed_ticket_.store(batch.last_ticket, std::memory_order_release);
+            }
+            else
+            {
+                in_flight_.back().last_ticket = batch.last_ticket;
+            }
+            last_submitted_ticket_ = batch.last_ticket;
+        }
+        batch.regions.clear();
+        free_batches_.push_back(std::move(batch));
+        return;
+    }
+    if (batch.last_ticket == 0)
+    {
+        batch.last_ticket = last_submitted_ticket_;
+    }
+    last_submitted_ticket_ = batch.last_ticket;
+
+    VkCommandBufferBeginInfo begin_info {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(batch.cmd, &begin_info);
+
+    // Consecutive copies into the same buffer or image share one command.
+    size_t first = 0;
+    for (size_t i = 1; i <= copies.size(); ++i)
+    {
+        if (i == copies.size() || copy_dsts[i] != copy_dsts[first])
+        {
+            vkCmdCopyBuffer(
+                batch.cmd, ring_.Handle(), copy_dsts[first], static_cast<uint32_t>(i - first), copies.data() + first);
+            first = i;
+        }
+    }
+    if (!prepares.empty())
+    {
+        vkCmdPipelineBarrier(
+            batch.cmd,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(prepares.size()), prepares.data());
+    }
+    first = 0;
+    for (size_t i = 1; i <= image_copies.size(); ++i)
+    {
+        if (i == image_copies.size() || image_dsts[i] != image_dsts[first] || image_layouts[i] != image_layouts[first])
+        {
+            vkCmdCopyBufferToImage(
+                batch.cmd,
+                ring_.Handle(),
+                image_dsts[first],
+                image_layouts[first],
+                static_cast<uint32_t>(i - first),
+                image_copies.data() + first);
+            first = i;
+        }
+    }
+
+    // Levels still being filled stay in TRANSFER_DST_OPTIMAL on this queue; later copies write
+    // other rows, so only finished levels need a barrier.
+    const uint32_t release_src = dedicated_ ? transfer_family_ : VK_QUEUE_FAMILY_IGNORED;
+    const uint32_t release_dst = dedicated_ ? graphics_family_ : VK_QUEUE_FAMILY_IGNORED;
+    std::vector<VkImageMemoryBarrier> image_releases;
+    image_releases.reserve(finished_images.size());
+    for (const Region& region : finished_images)
+    {
+        VkImageMemoryBarrier release = LayoutBarrier(
+            region.image,
+            region.mip_level,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            release_src,
+            release_dst);
+        release.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        release.dstAccessMask = dedicated_ ? 0 : kImageConsumerAccess;
+        image_releases.push_back(release);
+    }
+
+    if (dedicated_)
+    {
+        std::vector<VkBufferMemoryBarrier> releases;
+        releases.reserve(batch.regions.size());
+        for (const Region& region : batch.regions)
+        {
+            VkBufferMemoryBarrier release =
+                OwnershipBarrier(region.dst, region.offset, region.size, transfer_family_, graphics_family_);
+            release.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            releases.push_back(release);
+        }
+        vkCmdPipelineBarrier(
+            batch.cmd,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0, 0, nullptr,
+            static_cast<uint32_t>(releases.size()), releases.data(),
+            static_cast<uint32_t>(image_releases.size()), image_releases.data());
+    }
+    else
+    {
+        VkMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = kConsumerAccess;
+        vkCmdPipelineBarrier(
+            batch.cmd,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            kConsumerStages,
+            0, 1, &barrier, 0, nullptr,
+            static_cast<uint32_t>(image_releases.size()), image_releases.data());
+    }
+    vkEndCommandBuffer(batch.cmd);
+    // The acquire side in Retire matches these level for level.
+    batch.regions.insert(batch.regions.end(), finished_images.begin(), finished_images.end());
+
+    VkSubmitInfo submit_info {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &batch.cmd;
+    vkResetFences(device_, 1, &batch.fence);
+    if (vkQueueSubmit(queue_, 1, &submit_info, batch.fence) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to submit upload batch.");
+    }
+    if (!dedicated_)
+    {
+        // Same queue as the frame: the barrier above orders the copies before anything the
+        // frame submits afterwards, so the data is usable this frame.
+        completed_ticket_.store(batch.last_ticket, std::memory_order_release);
+    }
+    batch.ring_end = head_;
+    in_flight_.push_back(std::move(batch));
+}
+
+UploadService::Batch UploadService::AcquireBatch()
+{
+    if (!free_batches_.empty())
+    {
+        Batch batch = std::move(free_batches_.back());
+        free_batches_.pop_back();
+        batch.last_ticket = 0;
+        return batch;
+    }
+
+    Batch batch;
+    VkCommandBufferAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    alloc_info.commandPool = command_pool_;
+    alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    alloc_info.commandBufferCount = 1;
+    if (vkAllocateCommandBuffers(device_, &alloc_info, &batch.cmd) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate upload command buffer.");
+    }
+    VkFenceCreateInfo fence_info {};
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    if (vkCreateFence(device_, &fence_info, nullptr, &batch.fence) != VK_SUCCESS)
+    {
+        vkFreeCommandBuffers(device_, command_pool_, 1, &batch.cmd);
+        throw std::runtime_error("Failed to create upload fence.");
+    }
+    return batch;
+}
+
+bool UploadService::AllocateRing(VkDeviceSize size, VkDeviceSize& offset)
+{
+    const VkDeviceSize capacity = ring_.Size();
+    const VkDeviceSize aligned = AlignUp(size, kRingAlignment);
+    const VkDeviceSize position = head_ % capacity;
+    // A chunk never straddles the end of the ring; skip the remainder instead.
+    const VkDeviceSize skip = position + aligned > capacity ? capacity - position : 0;
+    if (head_ + skip + aligned - tail_ > capacity)
+    {
+        return false;
+    }
+    offset = skip > 0 ? 0 : position;
+    head_ += skip + aligned;
+    return true;
+}
+
+UploadServiceStats UploadService::Stats() const
+{
+    UploadServiceStats stats {};
+    {
+        std::lock_guard lock(mutex_);
+        stats.queued_bytes = queued_bytes_;
+    }
+    stats.ring_bytes = head_ - tail_;
+    stats.last_frame_bytes = last_frame_bytes_;
+    stats.total_bytes = total_bytes_;
+    stats.batches_in_flight = static_cast<uint32_t>(in_flight_.size());
+    stats.ring_full_frames = ring_full_frames_;
+    return stats;
+}
+
+void UploadService::DrawDebugGui() const
+{
+    const UploadServiceStats stats = Stats();
+    if (!ImGui::Begin("Uploads"))
+    {
+        ImGui::End();
+        return;
+    }
+    constexpr double kMiB = 1024.0 * 1024.0;
+    ImGui::Text("Queue: %s", dedicated_ ? "dedicated transfer" : "graphics");
+    ImGui::Text(
+        "Ring: %.1f / %.1f MiB (%u batches in flight)",
+        static_cast<double>(stats.ring_bytes) / kMiB,
+        static_cast<double>(ring_.Size()) / kMiB,
+        stats.batches_in_flight);
+    ImGui::Text(
+        "Last frame: %.2f / %.2f MiB",
+        static_cast<double>(stats.last_frame_bytes) / kMiB,
+        static_cast<double>(frame_budget_) / kMiB);
+    ImGui::Text("Queued: %.1f MiB", static_cast<double>(stats.queued_bytes) / kMiB);
+    ImGui::Text("Total: %.1f MiB", static_cast<double>(stats.total_bytes) / kMiB);
+    ImGui::Text("Frames limited by ring space: %u", stats.ring_full_frames);
+    ImGui::End();
+}
+}  // namespace ZKT
@@ -0,0 +1,348 @@
+#include "ZokataRenderer/graphics/renderer/VirtualTexture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace ZKT
+{
+namespace
+{
+constexpr uint32_t kEntryResident = 1U << 31;
+constexpr uint32_t kSlotBits = 10;
+constexpr uint32_t kSlotMask = (1U << kSlotBits) - 1;
+constexpr uint32_t kLevelShift = 2 * kSlotBits;
+
+uint32_t EntryLevel(uint32_t entry)
+{
+    return (entry >> kLevelShift) & 0xF;
+}
+
+uint32_t PageCount(uint32_t texels)
+{
+    return (texels + kVirtualPageTexels - 1) / kVirtualPageTexels;
+}
+
+// Block index v of a level n blocks long, wrapped or clamped to the edge.
+uint32_t Address(int64_t v, uint32_t n, bool wrap)
+{
+    const auto count = static_cast<int64_t>(n);
+    if (wrap)
+    {
+        return static_cast<uint32_t>(((v % count) + count) % count);
+    }
+    return static_cast<uint32_t>(std::clamp<int64_t>(v, 0, count - 1));
+}
+}  // namespace
+
+uint32_t PackVirtualPage(const VirtualPage& page)
+{
+    return (page.x & 0xFF) | ((page.y & 0xFF) << 8) | ((page.level & 0xF) << 16) | (page.texture << 20);
+}
+
+VirtualPage UnpackVirtualPage(uint32_t packed)
+{
+    return VirtualPage{packed >> 20, (packed >> 16) & 0xF, packed & 0xFF, (packed >> 8) & 0xFF};
+}
+
+VirtualPage ParentPage(const VirtualPage& page)
+{
+    return VirtualPage{page.texture, page.level + 1, page.x >> 1, page.y >> 1};
+}
+
+uint32_t VirtualLevelCount(VkExtent2D extent)
+{
+    uint32_t level = 0;
+    while (PageCount(MipExtent(extent, level).width) > 1 || PageCount(MipExtent(extent, level).height) > 1)
+    {
+        ++level;
+    }
+    return level + 1;
+}
+
+VkDeviceSize VirtualPageBytes(VkFormat format)
+{
+    return MipByteSize(FormatBlock(format), VkExtent2D{kVirtualPagePadded, kVirtualPagePadded});
+}
+
+void CopyVirtualPage(const Ktx2Texture& texture, const VirtualPage& page, bool wrap, std::span<uint8_t> out)
+{
+    const TexelBlock block = FormatBlock(texture.format);
+    if (block.bytes == 0 || page.level >= texture.LevelCount())
+    {
+        throw std::runtime_error("CopyVirtualPage: level " + std::to_string(page.level) + " is not in the texture.");
+    }
+    const VkExtent2D extent = MipExtent(texture.extent, page.level);
+    if (page.x >= PageCount(extent.width) || page.y >= PageCount(extent.height))
+    {
+        throw std::runtime_error(
+            "CopyVirtualPage: page (" + std::to_string(page.x) + ", " + std::to_string(page.y) + ") is outside level "
+            + std::to_string(page.level) + ".");
+    }
+    if (out.size() != VirtualPageBytes(texture.format))
+    {
+        throw std::runtime_error("CopyVirtualPage: output does not hold one padded page.");
+    }
+
+    const uint32_t blocks_x = (extent.width + block.width - 1) / block.width;
+    const uint32_t blocks_y = (extent.height + block.height - 1) / block.height;
+    const uint32_t padded_x = kVirtualPagePadded / block.width;
+    const uint32_t padded_y = kVirtualPagePadded / block.height;
+    const size_t row_bytes = static_cast<size_t>(blocks_x) * block.bytes;
+    const size_t out_row_bytes = static_cast<size_t>(padded_x) * block.bytes;
+    const int64_t first_x =
+        static_cast<int64_t>(page.x) * (kVirtualPageTexels / block.width) - kVirtualPageBorder / block.width;
+    const int64_t first_y =
+        static_cast<int64_t>(page.y) * (kVirtualPageTexels / block.height) - kVirtualPageBorder / block.height;
+    const uint8_t* level = texture.levels[page.level].data();
+    // Interior pages read one contiguous run per row; edge pages address block by block.
+    const bool interior_x = first_x >= 0 && first_x + padded_x <= blocks_x;
+
+    for (uint32_t row = 0; row < padded_y; ++row)
+    {
+        const uint8_t* src = level + Address(first_y + row, blocks_y, wrap) * row_bytes;
+        uint8_t* dst = out.data() + row * out_row_bytes;
+        if (interior_x)
+        {
+            std::memcpy(dst, src + first_x * block.bytes, out_row_bytes);
+            continue;
+        }
+        for (uint32_t column = 0; column < padded_x; ++column)
+        {
+            std::memcpy(
+                dst + column * block.bytes,
+                src + static_cast<size_t>(Address(first_x + column, blocks_x, wrap)) * block.bytes,
+                block.bytes);
+        }
+    }
+}
+
+VirtualPageTable::VirtualPageTable(uint32_t capacity, uint32_t atlas_pages_x)
+    : ranges_(std::max(capacity, 1U))
+    , atlas_pages_x_(std::clamp(atlas_pages_x, 1U, kSlotMask + 1))
+    , entries_(std::max(capacity, 1U), 0)
+{
+}
+
+uint32_t VirtualPageTable::AddTexture(VkExtent2D extent)
+{
+    if (extent.width == 0 || extent.height == 0 || PageCount(extent.width) > kMaxVirtualPagesPerAxis
+        || PageCount(extent.height) > kMaxVirtualPagesPerAxis)
+    {
+        throw std::runtime_error(
+            "Virtual textures must be between 1 and " + std::to_string(kMaxVirtualPagesPerAxis * kVirtualPageTexels)
+            + " texels per side.");
+    }
+    if (free_ids_.empty() && textures_.size() >= kMaxVirtualTextures)
+    {
+        throw std::runtime_error("Too many virtual textures.");
+    }
+
+    GpuVirtualTexture texture {};
+    texture.width = extent.width;
+    texture.height = extent.height;
+    texture.levels = VirtualLevelCount(extent);
+    uint32_t entry_count = 0;
+    for (uint32_t level = 0; level < texture.levels; ++level)
+    {
+        const VkExtent2D level_extent = MipExtent(extent, level);
+        texture.level_offset[level] = entry_count;
+        entry_count += PageCount(level_extent.width) * PageCount(level_extent.height);
+    }
+    texture.table_offset = ranges_.Allocate(entry_count);
+    if (texture.table_offset == RangeAllocator::kInvalidOffset)
+    {
+        throw std::runtime_error("Virtual page table is full.");
+    }
+
+    uint32_t id = 0;
+    if (!free_ids_.empty())
+    {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(textures_.size());
+        textures_.emplace_back();
+    }
+    textures_[id] = texture;
+    ++texture_count_;
+    for (uint32_t i = 0; i < entry_count; ++i)
+    {
+        SetEntry(texture.table_offset + i, 0);
+    }
+    dirty_texture_begin_ = std::min(dirty_texture_begin_, id);
+    dirty_texture_end_ = std::max(dirty_texture_end_, id + 1);
+    return id;
+}
+
+void VirtualPageTable::RemoveTexture(uint32_t texture)
+{
+    if (!HasTexture(texture))
+    {
+        return;
+    }
+    GpuVirtualTexture& record = textures_[texture];
+    const uint32_t last = record.levels - 1;
+    const uint32_t entry_count = record.level_offset[last] + PagesX(texture, last) * PagesY(texture, last);
+    ranges_.Free(record.table_offset, entry_count);
+    record = GpuVirtualTexture {};
+    free_ids_.push_back(texture);
+    --texture_count_;
+    dirty_texture_begin_ = std::min(dirty_texture_begin_, texture);
+    dirty_texture_end_ = std::max(dirty_texture_end_, texture + 1);
+}
+
+bool VirtualPageTable::HasTexture(uint32_t texture) const
+{
+    return texture < textures_.size() && textures_[texture].levels > 0;
+}
+
+bool VirtualPageTable::Contains(const VirtualPage& page) const
+{
+    return HasTexture(page.texture) && page.level < textures_[page.texture].levels
+           && page.x < PagesX(page.texture, page.level) && page.y < PagesY(page.texture, page.level);
+}
+
+const GpuVirtualTexture& VirtualPageTable::Texture(uint32_t texture) const
+{
+    return textures_.at(texture);
+}
+
+uint32_t VirtualPageTable::PagesX(uint32_t texture, uint32_t level) const
+{
+    const GpuVirtualTexture& record = textures_[texture];
+    return PageCount(MipExtent(VkExtent2D{record.width, record.height}, level).width);
+}
+
+uint32_t VirtualPageTable::PagesY(uint32_t texture, uint32_t level) const
+{
+    const GpuVirtualTexture& record = textures_[texture];
+    return PageCount(MipExtent(VkExtent2D{record.width, record.height}, level).height);
+}
+
+VirtualPage VirtualPageTable::Parent(const VirtualPage& page) const
+{
+    VirtualPage parent = ParentPage(page);
+    parent.x = std::min(parent.x, PagesX(page.texture, parent.level) - 1);
+    parent.y = std::min(parent.y, PagesY(page.texture, parent.level) - 1);
+    return parent;
+}
+
+void VirtualPageTable::Map(const VirtualPage& page, uint32_t slot)
+{
+    const uint32_t entry = MakeEntry(page.level, slot);
+    ForEachCovered(page, [this, &page, entry](uint32_t index, uint32_t level) {
+        const uint32_t current = entries_[index];
+        if (level == page.level || current == 0 || EntryLevel(current) > page.level)
+        {
+            SetEntry(index, entry);
+        }
+    });
+}
+
+void VirtualPageTable::Unmap(const VirtualPage& page, uint32_t slot)
+{
+    const uint32_t entry = MakeEntry(page.level, slot);
+    uint32_t fallback = 0;
+    if (page.level + 1 < textures_[page.texture].levels)
+    {
+        fallback = entries_[EntryIndex(Parent(page))];
+    }
+    ForEachCovered(page, [this, entry, fallback](uint32_t index, uint32_t) {
+        if (entries_[index] == entry)
+        {
+            SetEntry(index, fallback);
+        }
+    });
+}
+
+uint32_t VirtualPageTable::Entry(const VirtualPage& page) const
+{
+    return entries_[EntryIndex(page)];
+}
+
+uint32_t VirtualPageTable::MakeEntry(uint32_t level, uint32_t slot) const
+{
+    return kEntryResident | (level << kLevelShift) | ((slot / atlas_pages_x_) << kSlotBits) | (slot % atlas_pages_x_);
+}
+
+std::span<const uint32_t> VirtualPageTable::Entries() const
+{
+    return entries_;
+}
+
+std::span<const GpuVirtualTexture> VirtualPageTable::Textures() const
+{
+    return textures_;
+}
+
+void VirtualPageTable::DirtyEntries(uint32_t& begin, uint32_t& end) const
+{
+    begin = std::min(dirty_begin_, dirty_end_);
+    end = dirty_end_;
+}
+
+void VirtualPageTable::DirtyTextures(uint32_t& begin, uint32_t& end) const
+{
+    begin = std::min(dirty_texture_begin_, dirty_texture_end_);
+    end = dirty_texture_end_;
+}
+
+void VirtualPageTable::ClearDirty()
+{
+    dirty_begin_ = dirty_texture_begin_ = UINT32_MAX;
+    dirty_end_ = dirty_texture_end_ = 0;
+}
+
+uint32_t VirtualPageTable::TextureCount() const
+{
+    return texture_count_;
+}
+
+uint32_t VirtualPageTable::UsedEntries() const
+{
+    return ranges_.Used();
+}
+
+uint32_t VirtualPageTable::EntryIndex(const VirtualPage& page) const
+{
+    const GpuVirtualTexture& record = textures_[page.texture];
+    return record.table_offset + record.level_offset[page.level] + page.y * PagesX(page.texture, page.level) + page.x;
+}
+
+void VirtualPageTable::SetEntry(uint32_t index, uint32_t value)
+{
+    entries_[index] = value;
+    dirty_begin_ = std::min(dirty_begin_, index);
+    dirty_end_ = std::max(dirty_end_, index + 1);
+}
+
+template <typename Fn>
+void VirtualPageTable::ForEachCovered(const VirtualPage& page, Fn&& fn)
+{
+    // The last page of a level also covers the finer pages past its doubled range, which
+    // non-power-of-two extents leave over, matching the clamp in Parent.
+    const bool last_x = page.x + 1 == PagesX(page.texture, page.level);
+    const bool last_y = page.y + 1 == PagesY(page.texture, page.level);
+    const GpuVirtualTexture& record = textures_[page.texture];
+    for (uint32_t level = page.level + 1; level-- > 0;)
+    {
+        const uint32_t shift = page.level - level;
+        const uint32_t pages_x = PagesX(page.texture, level);
+        const uint32_t pages_y = PagesY(page.texture, level);
+        const uint32_t x_end = last_x ? pages_x : std::min((page.x + 1) << shift, pages_x);
+        const uint32_t y_end = last_y ? pages_y : std::min((page.y + 1) << shift, pages_y);
+        const uint32_t base = record.table_offset + record.level_offset[level];
+        for (uint32_t y = page.y << shift; y < y_end; ++y)
+        {
+            for (uint32_t x = page.x << shift; x < x_end; ++x)
+            {
+                fn(base + y * pages_x + x, level);
+            }
+        }
+    }
+}
+}  // namespace ZKT
@@ -0,0 +1,553 @@
+#include "ZokataRenderer/graphics/renderer/VirtualTextureAtlas.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <imgui.h>
+
+#include "ZokataRenderer/graphics/renderer/UploadService.h"
+#include "ZokataRenderer/graphics/vk/Device.h"
+
+namespace ZKT
+{
+namespace
+{
+constexpr uint32_t kMaxAtlasPagesPerAxis = 120;  // 16320 texels, inside the common 16384 limit
+constexpr uint32_t kMinAtlasPagesPerAxis = 8;
+constexpr VkPipelineStageFlags kShaderStages =
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+constexpr VkMemoryPropertyFlags kHostVisible =
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+void BufferBarrier(
+    VkCommandBuffer cmd,
+    VkBuffer buffer,
+    VkAccessFlags src_access,
+    VkAccessFlags dst_access,
+    VkPipelineStageFlags src_stage,
+    VkPipelineStageFlags dst_stage)
+{
+    VkBufferMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = src_access;
+    barrier.dstAccessMask = dst_access;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = buffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(cmd, src_stage, dst_stage, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+// Cell of the 8x8 ordered-dither matrix holding value index, so consecutive frames write
+// feedback from pixels spread across each cell and all 64 are visited every 64 frames.
+VkOffset2D FeedbackJitter(uint32_t index)
+{
+    const uint32_t y = ((index >> 4) & 1) | (((index >> 2) & 1) << 1) | ((index & 1) << 2);
+    const uint32_t x_xor_y = ((index >> 5) & 1) | (((index >> 3) & 1) << 1) | (((index >> 1) & 1) << 2);
+    return VkOffset2D{static_cast<int32_t>(x_xor_y ^ y), static_cast<int32_t>(y)};
+}
+}  // namespace
+
+VirtualTextureAtlas::VirtualTextureAtlas(
+    const VulkanContext& context,
+    UploadService& uploader,
+    VkFormat format,
+    uint32_t pages_per_axis,
+    uint32_t table_capacity)
+    : context_(context)
+    , uploader_(uploader)
+    , device_(context.DeviceHandle())
+    , pages_per_axis_(std::max(pages_per_axis, 1U))
+    , table_(table_capacity, pages_per_axis_)
+    , retired_(VulkanContext::kMaxFramesInFlight)
+{
+    static_assert(sizeof(Params) == 32, "Params must match the std140 layout");
+
+    CreateAtlas(format);
+
+    const uint32_t slot_count = pages_per_axis_ * pages_per_axis_;
+    free_slots_.reserve(slot_count);
+    for (uint32_t slot = slot_count; slot-- > 0;)
+    {
+        free_slots_.push_back(slot);
+    }
+
+    const Device& device = context_.GetDevice();
+    const VkDeviceSize entry_bytes = table_.Entries().size_bytes();
+    constexpr VkDeviceSize kTextureBytes = VkDeviceSize {kMaxVirtualTextures} * sizeof(GpuVirtualTexture);
+    for (uint32_t i = 0; i < VulkanContext::kMaxFramesInFlight; ++i)
+    {
+        SlotTables& tables = slots_.emplace_back();
+        tables.entries = Buffer(device, entry_bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, kHostVisible);
+        tables.textures = Buffer(device, kTextureBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, kHostVisible);
+        tables.params = Buffer(device, sizeof(Params), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, kHostVisible);
+        std::memset(tables.entries.Mapped(), 0, entry_bytes);
+        std::memset(tables.textures.Mapped(), 0, kTextureBytes);
+    }
+
+    CreateDescriptors();
+    SetFeedbackExtent(VkExtent2D{0, 0});
+}
+
+VirtualTextureAtlas::~VirtualTextureAtlas()
+{
+    vkDestroyDescriptorPool(device_, descriptor_pool_, nullptr);
+    vkDestroyDescriptorSetLayout(device_, set_layout_, nullptr);
+    vkDestroySampler(device_, sampler_, nullptr);
+    vkDestroyImageView(device_, atlas_view_, nullptr);
+}
+
+uint32_t VirtualTextureAtlas::AtlasPagesPerAxis(VkExtent2D screen)
+{
+    const auto pages_x = static_cast<double>((screen.width + kVirtualPageTexels - 1) / kVirtualPageTexels);
+    const auto pages_y = static_cast<double>((screen.height + kVirtualPageTexels - 1) / kVirtualPageTexels);
+    const auto pages = static_cast<uint32_t>(std::ceil(std::sqrt(4.0 * pages_x * pages_y)));
+    return std::clamp(pages, kMinAtlasPagesPerAxis, kMaxAtlasPagesPerAxis);
+}
+
+void VirtualTextureAtlas::SetFeedbackExtent(VkExtent2D screen)
+{
+    context_.WaitIdle();
+    feedback_extent_ = VkExtent2D{
+        (screen.width + kFeedbackScale - 1) / kFeedbackScale, (screen.height + kFeedbackScale - 1) / kFeedbackScale};
+    // Never zero-sized, so the descriptor stays valid before the first swapchain exists.
+    const VkDeviceSize bytes =
+        std::max<VkDeviceSize>(VkDeviceSize {feedback_extent_.width} * feedback_extent_.height, 1) * sizeof(uint32_t);
+
+    const Device& device = context_.GetDevice();
+    feedback_ = Buffer(
+        device,
+        bytes,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    for (SlotTables& tables : slots_)
+    {
+        tables.readback = Buffer(device, bytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT, kHostVisible);
+        tables.readback_texels = 0;
+    }
+    feedback_view_ = {};
+
+    context_.SubmitImmediate([this](VkCommandBuffer cmd) {
+        vkCmdFillBuffer(cmd, feedback_.Handle(), 0, VK_WHOLE_SIZE, kNoPageRequest);
+        BufferBarrier(
+            cmd,
+            feedback_.Handle(),
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            kShaderStages);
+    });
+    WriteDescriptors();
+}
+
+void VirtualTextureAtlas::BeginFrame(uint32_t frame_slot)
+{
+    frame_slot_ = frame_slot;
+    ++frame_index_;
+    std::erase_if(retired_[frame_slot], [this](const Retired& retired) {
+        if (retired.ticket != 0 && !uploader_.IsComplete(retired.ticket))
+        {
+            return false;
+        }
+        free_slots_.push_back(retired.slot);
+        --retired_count_;
+        return true;
+    });
+
+    CollectDirty();
+    SlotTables& tables = slots_[frame_slot];
+    if (tables.dirty_end > tables.dirty_begin)
+    {
+        tables.entries.Write(
+            table_.Entries().data() + tables.dirty_begin,
+            VkDeviceSize {tables.dirty_end - tables.dirty_begin} * sizeof(uint32_t),
+            VkDeviceSize {tables.dirty_begin} * sizeof(uint32_t));
+    }
+    if (tables.dirty_texture_end > tables.dirty_texture_begin)
+    {
+        tables.textures.Write(
+            table_.Textures().data() + tables.dirty_texture_begin,
+            VkDeviceSize {tables.dirty_texture_end - tables.dirty_texture_begin} * sizeof(GpuVirtualTexture),
+            VkDeviceSize {tables.dirty_texture_begin} * sizeof(GpuVirtualTexture));
+    }
+    tables.dirty_begin = tables.dirty_texture_begin = UINT32_MAX;
+    tables.dirty_end = tables.dirty_texture_end = 0;
+
+    const VkOffset2D jitter = FeedbackJitter(static_cast<uint32_t>(frame_index_ % 64));
+    Params params {};
+    params.feedback_size[0] = feedback_extent_.width;
+    params.feedback_size[1] = feedback_extent_.height;
+    params.feedback_jitter[0] = static_cast<uint32_t>(jitter.x);
+    params.feedback_jitter[1] = static_cast<uint32_t>(jitter.y);
+    params.atlas_size = static_cast<float>(atlas_.Extent().width);
+    params.lod_bias = lod_bias_;
+    tables.params.Write(&params, sizeof(params));
+
+    // The slot's fence has been waited on, so its readback is complete.
+    feedback_view_ = {static_cast<const uint32_t*>(tables.readback.Mapped()), tables.readback_texels};
+    tables.readback_texels = 0;
+}
+
+std::span<const uint32_t> VirtualTextureAtlas::Feedback() const
+{
+    return feedback_view_;
+}
+
+void VirtualTextureAtlas::RecordFeedbackReadback(VkCommandBuffer cmd, uint32_t frame_slot)
+{
+    const uint32_t texels = feedback_extent_.width * feedback_extent_.height;
+    if (texels == 0)
+    {
+        return;
+    }
+    SlotTables& tables = slots_[frame_slot];
+    const VkDeviceSize bytes = VkDeviceSize {texels} * sizeof(uint32_t);
+
+    BufferBarrier(
+        cmd,
+        feedback_.Handle(),
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+        kShaderStages,
+        VK_PIPELINE_STAGE_TRANSFER_BIT);
+    const VkBufferCopy copy {0, 0, bytes};
+    vkCmdCopyBuffer(cmd, feedback_.Handle(), tables.readback.Handle(), 1, &copy);
+    vkCmdFillBuffer(cmd, feedback_.Handle(), 0, bytes, kNoPageRequest);
+    BufferBarrier(
+        cmd,
+        feedback_.Handle(),
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        kShaderStages);
+    BufferBarrier(
+        cmd,
+        tables.readback.Handle(),
+        VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_HOST_READ_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT);
+    tables.readback_texels = texels;
+}
+
+uint32_t VirtualTextureAtlas::AddTexture(VkExtent2D extent)
+{
+    return table_.AddTexture(extent);
+}
+
+void VirtualTextureAtlas::RemoveTexture(uint32_t texture)
+{
+    table_.RemoveTexture(texture);
+}
+
+const VirtualPageTable& VirtualTextureAtlas::PageTable() const
+{
+    return table_;
+}
+
+uint32_t VirtualTextureAtlas::AllocateSlot()
+{
+    if (free_slots_.empty())
+    {
+        return kInvalidSlot;
+    }
+    const uint32_t slot = free_slots_.back();
+    free_slots_.pop_back();
+    return slot;
+}
+
+uint32_t VirtualTextureAtlas::FreeSlotCount() const
+{
+    return static_cast<uint32_t>(free_slots_.size());
+}
+
+uint32_t VirtualTextureAtlas::RetiredSlotCount() const
+{
+    return retired_count_;
+}
+
+uint64_t VirtualTextureAtlas::UploadPage(uint32_t slot, std::span<const uint8_t> data, std::shared_ptr<const void> owner)
+{
+    if (data.size() != VirtualPageBytes(atlas_.Format()))
+    {
+        throw std::runtime_error("VirtualTextureAtlas page upload is not one padded page.");
+    }
+    const VkOffset2D offset {
+        static_cast<int32_t>((slot % pages_per_axis_) * kVirtualPagePadded),
+        static_cast<int32_t>((slot / pages_per_axis_) * kVirtualPagePadded)};
+    return uploader_.UploadImageRegion(
+        atlas_.Handle(),
+        atlas_.Format(),
+        0,
+        offset,
+        VkExtent2D{kVirtualPagePadded, kVirtualPagePadded},
+        data,
+        std::move(owner));
+}
+
+bool VirtualTextureAtlas::IsComplete(uint64_t ticket) const
+{
+    return uploader_.IsComplete(ticket);
+}
+
+void VirtualTextureAtlas::MapPage(const VirtualPage& page, uint32_t slot)
+{
+    table_.Map(page, slot);
+}
+
+void VirtualTextureAtlas::UnmapPage(const VirtualPage& page, uint32_t slot)
+{
+    table_.Unmap(page, slot);
+    ReleaseSlot(slot);
+}
+
+void VirtualTextureAtlas::ReleaseSlot(uint32_t slot, uint64_t ticket)
+{
+    // Frames recorded with this slot's table may still sample the page.
+    retired_[frame_slot_].push_back(Retired{slot, ticket});
+    ++retired_count_;
+}
+
+VkFormat VirtualTextureAtlas::Format() const
+{
+    return atlas_.Format();
+}
+
+uint32_t VirtualTextureAtlas::PagesPerAxis() const
+{
+    return pages_per_axis_;
+}
+
+VkDescriptorSetLayout VirtualTextureAtlas::SetLayout() const
+{
+    return set_layout_;
+}
+
+VkDescriptorSet VirtualTextureAtlas::DescriptorSet(uint32_t frame_slot) const
+{
+    return sets_[frame_slot];
+}
+
+VirtualTextureAtlasStats VirtualTextureAtlas::Stats() const
+{
+    VirtualTextureAtlasStats stats {};
+    stats.textures = table_.TextureCount();
+    stats.slots = pages_per_axis_ * pages_per_axis_;
+    stats.retired_slots = retired_count_;
+    stats.mapped_slots = stats.slots - FreeSlotCount() - retired_count_;
+    stats.table_entries = table_.UsedEntries();
+    stats.feedback_texels = static_cast<uint32_t>(feedback_view_.size());
+    stats.atlas_bytes = atlas_.MemorySize();
+    return stats;
+}
+
+void VirtualTextureAtlas::DrawDebugGui()
+{
+    if (!ImGui::Begin("Virtual Textures"))
+    {
+        ImGui::End();
+        return;
+    }
+    const VirtualTextureAtlasStats stats = Stats();
+    constexpr double kMiB = 1024.0 * 1024.0;
+    ImGui::Text(
+        "Atlas: %ux%u texels, %.1f MiB",
+        atlas_.Extent().width,
+        atlas_.Extent().height,
+        static_cast<double>(stats.atlas_bytes) / kMiB);
+    ImGui::Text("Slots: %u / %u in use (%u retiring)", stats.mapped_slots, stats.slots, stats.retired_slots);
+    ImGui::Text("Textures: %u, table entries: %u", stats.textures, stats.table_entries);
+    ImGui::Text("Feedback: %ux%u (%u read back)", feedback_extent_.width, feedback_extent_.height, stats.feedback_texels);
+    ImGui::SliderFloat("LOD bias", &lod_bias_, -2.0F, 2.0F);
+    ImGui::End();
+}
+
+void VirtualTextureAtlas::CreateAtlas(VkFormat format)
+{
+    const TexelBlock block = FormatBlock(format);
+    if (block.bytes == 0 || kVirtualPageBorder % block.width != 0 || kVirtualPageBorder % block.height != 0)
+    {
+        throw std::runtime_error("VirtualTextureAtlas cannot page VkFormat " + std::to_string(format) + ".");
+    }
+    if (block.width > 1 && !context_.GetDevice().Features().texture_compression_bc)
+    {
+        throw std::runtime_error("Device does not support BC texture compression.");
+    }
+    VkFormatProperties format_properties {};
+    vkGetPhysicalDeviceFormatProperties(context_.PhysicalDevice(), format, &format_properties);
+    if ((format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) == 0)
+    {
+        throw std::runtime_error("Device cannot sample VkFormat " + std::to_string(format) + ".");
+    }
+    VkPhysicalDeviceProperties properties {};
+    vkGetPhysicalDeviceProperties(context_.PhysicalDevice(), &properties);
+    const uint32_t size = pages_per_axis_ * kVirtualPagePadded;
+    if (size > properties.limits.maxImageDimension2D)
+    {
+        throw std::runtime_error("Virtual texture atlas of " + std::to_string(size) + " texels exceeds the device limit.");
+    }
+
+    // Pages are written by the transfer queue while the graphics queue samples other pages.
+    const std::array<uint32_t, 2> families {context_.GraphicsQueueFamily(), context_.TransferQueueFamily()};
+    atlas_ = Image(
+        context_.GetDevice(),
+        format,
+        VkExtent2D{size, size},
+        1,
+        VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+        families);
+
+    VkImageViewCreateInfo view_info {};
+    view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_info.image = atlas_.Handle();
+    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format = format;
+    view_info.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    if (vkCreateImageView(device_, &view_info, nullptr, &atlas_view_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create virtual texture atlas view.");
+    }
+
+    // Filtering never reaches past a page's border, so clamping only matters at the atlas edge.
+    VkSamplerCreateInfo sampler_info {};
+    sampler_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    sampler_info.magFilter = VK_FILTER_LINEAR;
+    sampler_info.minFilter = VK_FILTER_LINEAR;
+    sampler_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_info.maxLod = 0.0F;
+    if (vkCreateSampler(device_, &sampler_info, nullptr, &sampler_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create virtual texture sampler.");
+    }
+
+    context_.SubmitImmediate([this](VkCommandBuffer cmd) {
+        VkImageMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = atlas_.Handle();
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        vkCmdPipelineBarrier(
+            cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, kShaderStages, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    });
+}
+
+void VirtualTextureAtlas::CreateDescriptors()
+{
+    constexpr VkShaderStageFlags kStages = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+    const std::array<VkDescriptorSetLayoutBinding, 5> bindings {{
+        {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, kStages, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, kStages, nullptr},
+        {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, kStages, nullptr},
+        {3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, kStages, nullptr},
+        {4, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, kStages, nullptr},
+    }};
+    VkDescriptorSetLayoutCreateInfo layout_info {};
+    layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_info.bindingCount = static_cast<uint32_t>(bindings.size());
+    layout_info.pBindings = bindings.data();
+    if (vkCreateDescriptorSetLayout(device_, &layout_info, nullptr, &set_layout_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create virtual texture descriptor set layout.");
+    }
+
+    constexpr uint32_t kSets = VulkanContext::kMaxFramesInFlight;
+    const std::array<VkDescriptorPoolSize, 3> pool_sizes {{
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, kSets},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3 * kSets},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, kSets},
+    }};
+    VkDescriptorPoolCreateInfo pool_info {};
+    pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_info.maxSets = kSets;
+    pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+    pool_info.pPoolSizes = pool_sizes.data();
+    if (vkCreateDescriptorPool(device_, &pool_info, nullptr, &descriptor_pool_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create virtual texture descriptor pool.");
+    }
+
+    std::array<VkDescriptorSetLayout, kSets> layouts {};
+    layouts.fill(set_layout_);
+    sets_.resize(kSets, VK_NULL_HANDLE);
+    VkDescriptorSetAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool = descriptor_pool_;
+    alloc_info.descriptorSetCount = kSets;
+    alloc_info.pSetLayouts = layouts.data();
+    if (vkAllocateDescriptorSets(device_, &alloc_info, sets_.data()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate virtual texture descriptor sets.");
+    }
+}
+
+void VirtualTextureAtlas::WriteDescriptors()
+{
+    const VkDescriptorImageInfo atlas {sampler_, atlas_view_, VK_IMAGE_LAYOUT_GENERAL};
+    for (size_t slot = 0; slot < sets_.size(); ++slot)
+    {
+        const SlotTables& tables = slots_[slot];
+        const std::array<VkDescriptorBufferInfo, 3> storage {{
+            {tables.entries.Handle(), 0, VK_WHOLE_SIZE},
+            {tables.textures.Handle(), 0, VK_WHOLE_SIZE},
+            {feedback_.Handle(), 0, VK_WHOLE_SIZE},
+        }};
+        const VkDescriptorBufferInfo params {tables.params.Handle(), 0, sizeof(Params)};
+
+        std::array<VkWriteDescriptorSet, 3> writes {};
+        for (auto& write : writes)
+        {
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = sets_[slot];
+            write.descriptorCount = 1;
+        }
+        writes[0].dstBinding = 0;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo = &atlas;
+        writes[1].dstBinding = 1;
+        writes[1].descriptorCount = static_cast<uint32_t>(storage.size());
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[1].pBufferInfo = storage.data();
+        writes[2].dstBinding = 4;
+        writes[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        writes[2].pBufferInfo = &params;
+        vkUpdateDescriptorSets(device_, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+}
+
+void VirtualTextureAtlas::CollectDirty()
+{
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    uint32_t texture_begin = 0;
+    uint32_t texture_end = 0;
+    table_.DirtyEntries(begin, end);
+    table_.DirtyTextures(texture_begin, texture_end);
+    for (SlotTables& tables : slots_)
+    {
+        if (end > begin)
+        {
+            tables.dirty_begin = std::min(tables.dirty_begin, begin);
+            tables.dirty_end = std::max(tables.dirty_end, end);
+        }
+        if (texture_end > texture_begin)
+        {
+            tables.dirty_texture_begin = std::min(tables.dirty_texture_begin, texture_begin);
+            tables.dirty_texture_end = std::max(tables.dirty_texture_end, texture_end);
+        }
+    }
+    table_.ClearDirty();
+}
+}  // namespace ZKT
@@ -0,0 +1,143 @@
+#include "ZokataRenderer/graphics/vk/Buffer.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "ZokataRenderer/graphics/vk/Device.h"
+
+namespace ZKT
+{
+Buffer::Buffer(const Device& device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
+    : device_(device.Logical())
+    , size_(size)
+{
+    VkBufferCreateInfo buffer_info {};
+    buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_info.size = size;
+    buffer_info.usage = usage;
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device_, &buffer_info, nullptr, &buffer_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create buffer.");
+    }
+
+    VkMemoryRequirements requirements {};
+    vkGetBufferMemoryRequirements(device_, buffer_, &requirements);
+
+    VkMemoryAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = requirements.size;
+    alloc_info.memoryTypeIndex = device.FindMemoryType(requirements.memoryTypeBits, properties);
+
+    if (vkAllocateMemory(device_, &alloc_info, nullptr, &memory_) != VK_SUCCESS)
+    {
+        Release();
+        throw std::runtime_error("Failed to allocate buffer memory.");
+    }
+    vkBindBufferMemory(device_, buffer_, memory_, 0);
+
+    if ((properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0)
+    {
+        coherent_ = (properties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+        if (vkMapMemory(device_, memory_, 0, VK_WHOLE_SIZE, 0, &mapped_) != VK_SUCCESS)
+        {
+            Release();
+            throw std::runtime_error("Failed to map buffer memory.");
+        }
+    }
+}
+
+Buffer::~Buffer()
+{
+    Release();
+}
+
+Buffer::Buffer(Buffer&& other) noexcept
+    : device_(std::exchange(other.device_, VK_NULL_HANDLE))
+    , buffer_(std::exchange(other.buffer_, VK_NULL_HANDLE))
+    , memory_(std::exchange(other.memory_, VK_NULL_HANDLE))
+    , size_(std::exchange(other.size_, 0))
+    , mapped_(std::exchange(other.mapped_, nullptr))
+    , coherent_(other.coherent_)
+{
+}
+
+Buffer& Buffer::operator=(Buffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        device_ = std::exchange(other.device_, VK_NULL_HANDLE);
+        buffer_ = std::exchange(other.buffer_, VK_NULL_HANDLE);
+        memory_ = std::exchange(other.memory_, VK_NULL_HANDLE);
+        size_ = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, nullptr);
+        coherent_ = other.coherent_;
+    }
+    return *this;
+}
+
+void Buffer::Write(const void* data, VkDeviceSize size, VkDeviceSize offset)
+{
+    if (mapped_ == nullptr || offset + size > size_)
+    {
+        throw std::runtime_error("Buffer write out of range or buffer not host-visible.");
+    }
+    std::memcpy(static_cast<std::byte*>(mapped_) + offset, data, static_cast<size_t>(size));
+
+    if (!coherent_)
+    {
+        VkMappedMemoryRange range {};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = memory_;
+        range.offset = 0;
+        range.size = VK_WHOLE_SIZE;
+        vkFlushMappedMemoryRanges(device_, 1, &range);
+    }
+}
+
+VkBuffer Buffer::Handle() const
+{
+    return buffer_;
+}
+
+VkDeviceSize Buffer::Size() const
+{
+    return size_;
+}
+
+void* Buffer::Mapped() const
+{
+    return mapped_;
+}
+
+bool Buffer::Valid() const
+{
+    return buffer_ != VK_NULL_HANDLE;
+}
+
+void Buffer::Release()
+{
+    if (device_ == VK_NULL_HANDLE)
+    {
+        return;
+    }
+    if (mapped_ != nullptr)
+    {
+        vkUnmapMemory(device_, memory_);
+        mapped_ = nullptr;
+    }
+    if (buffer_ != VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(device_, buffer_, nullptr);
+        buffer_ = VK_NULL_HANDLE;
+    }
+    if (memory_ != VK_NULL_HANDLE)
+    {
+        vkFreeMemory(device_, memory_, nullptr);
+        memory_ = VK_NULL_HANDLE;
+    }
+}
+}  // namespace ZKT
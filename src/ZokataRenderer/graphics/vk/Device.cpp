@@ -48,6 +48,11 @@ VkQueue Device::PresentQueue() const
     return present_queue_;
 }
 
+VkQueue Device::TransferQueue() const
+{
+    return transfer_queue_;
+}
+
 uint32_t Device::GraphicsQueueFamily() const
 {
     return graphics_queue_family_;
@@ -58,6 +63,36 @@ uint32_t Device::PresentQueueFamily() const
     return present_queue_family_;
 }
 
+uint32_t Device::TransferQueueFamily() const
+{
+    return transfer_queue_family_;
+}
+
+bool Device::HasDedicatedTransferQueue() const
+{
+    return transfer_queue_family_ != graphics_queue_family_;
+}
+
+const DeviceFeatures& Device::Features() const
+{
+    return features_;
+}
+
+uint32_t Device::FindMemoryType(uint32_t type_bits, VkMemoryPropertyFlags properties) const
+{
+    VkPhysicalDeviceMemoryProperties memory_properties {};
+    vkGetPhysicalDeviceMemoryProperties(physical_device_, &memory_properties);
+    for (uint32_t i = 0; i < memory_properties.memoryTypeCount; ++i)
+    {
+        if ((type_bits & (1U << i)) != 0
+            && (memory_properties.memoryTypes[i].propertyFlags & properties) == properties)
+        {
+            return i;
+        }
+    }
+    throw std::runtime_error("No suitable Vulkan memory type found.");
+}
+
 bool Device::QueueFamilyIndices::Complete() const
 {
     return graphics_family.has_value() && present_family.has_value();
@@ -71,24 +106,30 @@ Device::QueueFamilyIndices Device::FindQueueFamilies(VkPhysicalDevice device, Vk
     std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_count, queue_families.data());
 
+    bool transfer_is_copy_only = false;
     for (uint32_t i = 0; i < queue_family_count; ++i)
     {
         const auto& family = queue_families[i];
-        if (family.queueCount > 0 && (family.queueFlags & VK_QUEUE_GRAPHICS_BIT))
+        if (family.queueCount > 0 && (family.queueFlags & VK_QUEUE_GRAPHICS_BIT) && !indices.graphics_family)
         {
             indices.graphics_family = i;
         }
 
         VkBool32 present_supported = VK_FALSE;
         vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &present_supported);
-        if (family.queueCount > 0 && present_supported)
+        if (family.queueCount > 0 && present_supported && !indices.present_family)
         {
             indices.present_family = i;
         }
 
-        if (indices.Complete())
+        // Prefer a pure copy engine; an async compute family still beats sharing graphics.
+        const bool transfer = family.queueCount > 0 && (family.queueFlags & VK_QUEUE_TRANSFER_BIT)
+                              && !(family.queueFlags & VK_QUEUE_GRAPHICS_BIT);
+        const bool copy_only = !(family.queueFlags & VK_QUEUE_COMPUTE_BIT);
+        if (transfer && (!indices.transfer_family || (copy_only && !transfer_is_copy_only)))
         {
-            break;
+            indices.transfer_family = i;
+            transfer_is_copy_only = copy_only;
         }
     }
 
@@ -168,11 +209,13 @@ void Device::CreateLogicalDevice(VkSurfaceKHR surface)
     QueueFamilyIndices indices = FindQueueFamilies(physical_device_, surface);
     graphics_queue_family_ = indices.graphics_family.value();
     present_queue_family_ = indices.present_family.value();
+    transfer_queue_family_ = indices.transfer_family.value_or(graphics_queue_family_);
 
     std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
     std::set<uint32_t> unique_families = {
         indices.graphics_family.value(),
-        indices.present_family.value()
+        indices.present_family.value(),
+        transfer_queue_family_
     };
 
     float queue_priority = 1.0F;
@@ -186,12 +229,45 @@ void Device::CreateLogicalDevice(VkSurfaceKHR surface)
         queue_create_infos.push_back(queue_create);
     }
 
-    VkPhysicalDeviceFeatures device_features {};
+    // Query optional features through the 1.1/1.2 chains and enable only what is supported,
+    // so GPU-driven paths can fall back on devices (or software drivers) without them.
+    VkPhysicalDeviceVulkan12Features supported_12 {};
+    supported_12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceVulkan11Features supported_11 {};
+    supported_11.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+    supported_11.pNext = &supported_12;
+    VkPhysicalDeviceFeatures2 supported {};
+    supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supported.pNext = &supported_11;
+    vkGetPhysicalDeviceFeatures2(physical_device_, &supported);
+
+    features_.multi_draw_indirect = supported.features.multiDrawIndirect == VK_TRUE;
+    features_.draw_indirect_count = supported_12.drawIndirectCount == VK_TRUE;
+    features_.draw_indirect_first_instance = supported.features.drawIndirectFirstInstance == VK_TRUE;
+    features_.shader_draw_parameters = supported_11.shaderDrawParameters == VK_TRUE;
+    features_.texture_compression_bc = supported.features.textureCompressionBC == VK_TRUE;
+    features_.fragment_stores_and_atomics = supported.features.fragmentStoresAndAtomics == VK_TRUE;
+
+    VkPhysicalDeviceVulkan12Features enabled_12 {};
+    enabled_12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    enabled_12.drawIndirectCount = supported_12.drawIndirectCount;
+    VkPhysicalDeviceVulkan11Features enabled_11 {};
+    enabled_11.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+    enabled_11.pNext = &enabled_12;
+    enabled_11.shaderDrawParameters = supported_11.shaderDrawParameters;
+    VkPhysicalDeviceFeatures2 device_features {};
+    device_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    device_features.pNext = &enabled_11;
+    device_features.features.multiDrawIndirect = supported.features.multiDrawIndirect;
+    device_features.features.drawIndirectFirstInstance = supported.features.drawIndirectFirstInstance;
+    device_features.features.textureCompressionBC = supported.features.textureCompressionBC;
+    device_features.features.fragmentStoresAndAtomics = supported.features.fragmentStoresAndAtomics;
+
     VkDeviceCreateInfo create_info {};
     create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    create_info.pNext = &device_features;
     create_info.queueCreateInfoCount = static_cast<uint32_t>(queue_create_infos.size());
     create_info.pQueueCreateInfos = queue_create_infos.data();
-    create_info.pEnabledFeatures = &device_features;
     create_info.enabledExtensionCount = static_cast<uint32_t>(kRequiredExtensions.size());
     create_info.ppEnabledExtensionNames = kRequiredExtensions.data();
 
@@ -202,5 +278,6 @@ void Device::CreateLogicalDevice(VkSurfaceKHR surface)
 
     vkGetDeviceQueue(device_, indices.graphics_family.value(), 0, &graphics_queue_);
     vkGetDeviceQueue(device_, indices.present_family.value(), 0, &present_queue_);
+    vkGetDeviceQueue(device_, transfer_queue_family_, 0, &transfer_queue_);
 }
 }  // namespace ZKT
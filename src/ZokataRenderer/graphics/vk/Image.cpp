@@ -0,0 +1,148 @@
+#include "ZokataRenderer/graphics/vk/Image.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ZokataRenderer/graphics/vk/Device.h"
+
+namespace ZKT
+{
+Image::Image(
+    const Device& device,
+    VkFormat format,
+    VkExtent2D extent,
+    uint32_t mip_levels,
+    VkImageUsageFlags usage,
+    std::span<const uint32_t> queue_families)
+    : device_(device.Logical())
+    , format_(format)
+    , extent_(extent)
+    , mip_levels_(mip_levels)
+{
+    VkImageCreateInfo image_info {};
+    image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_info.imageType = VK_IMAGE_TYPE_2D;
+    image_info.format = format;
+    image_info.extent = {extent.width, extent.height, 1};
+    image_info.mipLevels = mip_levels;
+    image_info.arrayLayers = 1;
+    image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_info.usage = usage;
+    image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    std::vector<uint32_t> families(queue_families.begin(), queue_families.end());
+    std::ranges::sort(families);
+    families.erase(std::ranges::unique(families).begin(), families.end());
+    if (families.size() > 1)
+    {
+        image_info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        image_info.queueFamilyIndexCount = static_cast<uint32_t>(families.size());
+        image_info.pQueueFamilyIndices = families.data();
+    }
+    image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(device_, &image_info, nullptr, &image_) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create image.");
+    }
+
+    VkMemoryRequirements requirements {};
+    vkGetImageMemoryRequirements(device_, image_, &requirements);
+    memory_size_ = requirements.size;
+
+    VkMemoryAllocateInfo alloc_info {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = requirements.size;
+    alloc_info.memoryTypeIndex =
+        device.FindMemoryType(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    if (vkAllocateMemory(device_, &alloc_info, nullptr, &memory_) != VK_SUCCESS)
+    {
+        Release();
+        throw std::runtime_error("Failed to allocate image memory.");
+    }
+    vkBindImageMemory(device_, image_, memory_, 0);
+}
+
+Image::~Image()
+{
+    Release();
+}
+
+Image::Image(Image&& other) noexcept
+    : device_(std::exchange(other.device_, VK_NULL_HANDLE))
+    , image_(std::exchange(other.image_, VK_NULL_HANDLE))
+    , memory_(std::exchange(other.memory_, VK_NULL_HANDLE))
+    , format_(std::exchange(other.format_, VK_FORMAT_UNDEFINED))
+    , extent_(std::exchange(other.extent_, VkExtent2D {}))
+    , mip_levels_(std::exchange(other.mip_levels_, 0))
+    , memory_size_(std::exchange(other.memory_size_, 0))
+{
+}
+
+Image& Image::operator=(Image&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        device_ = std::exchange(other.device_, VK_NULL_HANDLE);
+        image_ = std::exchange(other.image_, VK_NULL_HANDLE);
+        memory_ = std::exchange(other.memory_, VK_NULL_HANDLE);
+        format_ = std::exchange(other.format_, VK_FORMAT_UNDEFINED);
+        extent_ = std::exchange(other.extent_, VkExtent2D {});
+        mip_levels_ = std::exchange(other.mip_levels_, 0);
+        memory_size_ = std::exchange(other.memory_size_, 0);
+    }
+    return *this;
+}
+
+VkImage Image::Handle() const
+{
+    return image_;
+}
+
+VkFormat Image::Format() const
+{
+    return format_;
+}
+
+VkExtent2D Image::Extent() const
+{
+    return extent_;
+}
+
+uint32_t Image::MipLevels() const
+{
+    return mip_levels_;
+}
+
+VkDeviceSize Image::MemorySize() const
+{
+    return memory_size_;
+}
+
+bool Image::Valid() const
+{
+    return image_ != VK_NULL_HANDLE;
+}
+
+void Image::Release()
+{
+    if (device_ == VK_NULL_HANDLE)
+    {
+        return;
+    }
+    if (image_ != VK_NULL_HANDLE)
+    {
+        vkDestroyImage(device_, image_, nullptr);
+        image_ = VK_NULL_HANDLE;
+    }
+    if (memory_ != VK_NULL_HANDLE)
+    {
+        vkFreeMemory(device_, memory_, nullptr);
+        memory_ = VK_NULL_HANDLE;
+    }
+}
+}  // namespace ZKT
@@ -0,0 +1,50 @@
+#include "ZokataRenderer/graphics/vk/Shader.h"
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef ZKT_SHADER_DIR
+#define ZKT_SHADER_DIR "shaders"
+#endif
+
+namespace ZKT
+{
+std::filesystem::path ShaderPath(std::string_view name)
+{
+    return std::filesystem::path(ZKT_SHADER_DIR) / name;
+}
+
+VkShaderModule LoadShaderModule(VkDevice device, const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        throw std::runtime_error("Failed to open shader: " + path.string());
+    }
+
+    const auto size = static_cast<size_t>(file.tellg());
+    if (size == 0 || size % sizeof(uint32_t) != 0)
+    {
+        throw std::runtime_error("Invalid SPIR-V size: " + path.string());
+    }
+
+    std::vector<uint32_t> code(size / sizeof(uint32_t));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(size));
+
+    VkShaderModuleCreateInfo create_info {};
+    create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    create_info.codeSize = size;
+    create_info.pCode = code.data();
+
+    VkShaderModule module = VK_NULL_HANDLE;
+    if (vkCreateShaderModule(device, &create_info, nullptr, &module) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create shader module: " + path.string());
+    }
+    return module;
+}
+}  // namespace ZKT
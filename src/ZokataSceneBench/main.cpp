@@ -0,0 +1,203 @@
+#include "ZokataEngine/systems/jobs/JobSystem.h"
+#include "ZokataEngine/systems/scene/SceneLoader.h"
+#include "ZokataLog/Log.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+// Every root gets this many children, like props grouped under a parent.
+constexpr uint64_t kChildrenPerRoot = 9;
+
+void AppendNumber(std::string& out, double value)
+{
+    char digits[32];
+    const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, end);
+}
+
+void AppendTransform(std::string& out, std::string_view indent, uint64_t seed)
+{
+    out.append(indent).append("Transform:\n");
+    out.append(indent).append("  position: { x: ");
+    AppendNumber(out, static_cast<double>(seed % 1000) * 0.25);
+    out.append(", y: ");
+    AppendNumber(out, static_cast<double>(seed % 7) * 0.5);
+    out.append(", z: ");
+    AppendNumber(out, -static_cast<double>(seed % 503) * 0.125);
+    out.append(" }\n");
+    out.append(indent).append("  rotation: { x: 0.0, y: ");
+    AppendNumber(out, static_cast<double>(seed % 360));
+    out.append(", z: 0.0 }\n");
+    out.append(indent).append("  scale:    { x: 1.0, y: 1.0, z: 1.0 }\n");
+}
+
+void AppendEntity(std::string& out, std::string_view indent, uint64_t id, bool extra_component)
+{
+    const std::string nested = std::string(indent) + "    ";
+    out.append(indent).append("- id: ").append(std::to_string(id)).append("\n");
+    out.append(indent).append("  name: \"Entity").append(std::to_string(id)).append("\"\n");
+    out.append(indent).append("  components:\n");
+    AppendTransform(out, nested, id);
+    if (extra_component)
+    {
+        // Not known to the loader: only recorded in the parsed view.
+        out.append(nested).append("Light: { type: \"Point\", intensity: 2.5, range: 10.0 }\n");
+    }
+}
+
+/**
+ * @brief Writes a scene of root entities with kChildrenPerRoot children each.
+ */
+void GenerateScene(const fs::path& path, uint64_t entity_count)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot write " + path.string());
+    }
+    std::string out = "version: 1\nscene:\n  name: \"Bench\"\n  entities:\n";
+    uint64_t id = 1;
+    while (id <= entity_count)
+    {
+        AppendEntity(out, "    ", id, id % 10 == 1);
+        ++id;
+        const uint64_t children = std::min(kChildrenPerRoot, entity_count - id + 1);
+        if (children > 0)
+        {
+            out.append("      children:\n");
+        }
+        for (uint64_t child = 0; child < children; ++child, ++id)
+        {
+            AppendEntity(out, "        ", id, false);
+        }
+        if (out.size() > (64u << 20))
+        {
+            file.write(out.data(), static_cast<std::streamsize>(out.size()));
+            out.clear();
+        }
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+/**
+ * Usage: zokata-scene-bench [--dir <dir>] [--yaml-cpp] [--keep] [entity count]...
+ * Generates scenes of the given sizes (default 10k, 100k and 1M entities), loads each with
+ * SceneLoader and prints the phase timings. --yaml-cpp also times building yaml-cpp's document
+ * tree of the same file, the first step of the previous loader.
+ */
+int main(int argc, char** argv)
+{
+    try
+    {
+        fs::path dir = fs::temp_directory_path() / "zokata-scene-bench";
+        bool compare_yaml_cpp = false;
+        bool keep = false;
+        std::vector<uint64_t> counts;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg(argv[i]);
+            if (arg == "--dir" && i + 1 < argc)
+            {
+                dir = argv[++i];
+            }
+            else if (arg == "--yaml-cpp")
+            {
+                compare_yaml_cpp = true;
+            }
+            else if (arg == "--keep")
+            {
+                keep = true;
+            }
+            else
+            {
+                uint64_t count = 0;
+                const auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), count);
+                if (ec != std::errc {} || end != arg.data() + arg.size() || count == 0)
+                {
+                    ZLOG_ERROR("Not an entity count: " + std::string(arg));
+                    return EXIT_FAILURE;
+                }
+                counts.push_back(count);
+            }
+        }
+        if (counts.empty())
+        {
+            counts = {10'000, 100'000, 1'000'000};
+        }
+        fs::create_directories(dir);
+
+        std::printf("%u job system workers\n", ZKT::ENGINE::JobSystem::Default().WorkerCount());
+        std::printf("%10s %9s %9s %9s %9s %9s %12s %12s\n", "entities", "MiB", "parse ms", "build ms", "attach ms",
+                    "total ms", "entities/s", compare_yaml_cpp ? "yaml-cpp ms" : "");
+        for (const uint64_t count : counts)
+        {
+            const fs::path path = dir / ("bench_" + std::to_string(count) + ".yaml");
+            GenerateScene(path, count);
+            const double mebibytes = static_cast<double>(fs::file_size(path)) / (1024.0 * 1024.0);
+
+            ZKT::ENGINE::SceneLoader loader;
+            const auto start = std::chrono::steady_clock::now();
+            auto scene = loader.LoadFromFile(path);
+            const double total = MillisecondsSince(start);
+            const ZKT::ENGINE::SceneLoaderStats& stats = loader.Stats();
+            if (stats.entities != count || !stats.streamed)
+            {
+                ZLOG_WARN("Unexpected load of " + path.filename().string() + ": " + std::to_string(stats.entities) +
+                          " entities, streamed=" + std::to_string(stats.streamed));
+            }
+            scene.reset();
+
+            double yaml_cpp = 0.0;
+            if (compare_yaml_cpp)
+            {
+                const auto dom_start = std::chrono::steady_clock::now();
+                const YAML::Node document = YAML::LoadFile(path.string());
+                yaml_cpp = MillisecondsSince(dom_start);
+            }
+
+            std::printf("%10llu %9.1f %9.1f %9.1f %9.1f %9.1f %12.0f", static_cast<unsigned long long>(count),
+                        mebibytes, stats.parse_ms, stats.build_ms, stats.attach_ms, total,
+                        static_cast<double>(count) / (total / 1000.0));
+            if (compare_yaml_cpp)
+            {
+                std::printf(" %12.1f", yaml_cpp);
+            }
+            std::printf("\n");
+            std::fflush(stdout);
+
+            if (!keep)
+            {
+                fs::remove(path);
+            }
+        }
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        ZLOG_ERROR(std::string("Unhandled exception: ") + e.what());
+        return EXIT_FAILURE;
+    }
+}
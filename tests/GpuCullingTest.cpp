@@ -0,0 +1,192 @@
+// Runs GpuCulling's cull and Hi-Z passes on whatever Vulkan device is available (lavapipe in
+// CI) and checks the draw counts both phases emit against what the scene should produce.
+
+#include "ZokataRenderer/graphics/VulkanContext.h"
+#include "ZokataRenderer/graphics/Window.h"
+#include "ZokataRenderer/graphics/renderer/GpuCulling.h"
+#include "ZokataRenderer/graphics/vk/Image.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+constexpr uint32_t kVisibleInstances = 40;  // in front of the camera
+constexpr uint32_t kCulledInstances = 24;   // behind it
+constexpr VkExtent2D kDepthExtent {256, 256};
+
+using ZKT::CullPhase;
+using ZKT::GpuCulling;
+
+std::vector<ZKT::GpuInstance> MakeInstances()
+{
+    std::vector<ZKT::GpuInstance> instances;
+    for (uint32_t i = 0; i < kVisibleInstances + kCulledInstances; ++i)
+    {
+        const float x = static_cast<float>(i % 8) * 0.5F - 2.0F;
+        const float y = static_cast<float>(i / 8) * 0.5F - 2.0F;
+        const float z = i < kVisibleInstances ? -15.0F : 15.0F;
+
+        ZKT::GpuInstance instance {};
+        instance.model = ZKT::MATH::Mat4f(glm::translate(glm::mat4(1.0F), glm::vec3(x, y, z)));
+        instance.bounds = ZKT::MATH::Vec4f{x, y, z, 0.25F};
+        instances.push_back(instance);
+    }
+    return instances;
+}
+
+/**
+ * @brief Fills the depth image with value and leaves it readable by the Hi-Z pass.
+ */
+void ClearDepth(VkCommandBuffer cmd, VkImage depth, float value, VkImageLayout old_layout)
+{
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = old_layout;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = depth;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(
+        cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    const VkClearDepthStencilValue clear {value, 0};
+    vkCmdClearDepthStencilImage(
+        cmd, depth, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clear, 1, &barrier.subresourceRange);
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    vkCmdPipelineBarrier(
+        cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+class CullingTest
+{
+public:
+    CullingTest(const ZKT::VulkanContext& context, GpuCulling& culling, VkImage depth)
+        : context_(context)
+        , culling_(culling)
+        , depth_(depth)
+    {
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0F), 1.0F, 0.1F, 100.0F);
+        view_projection_ = ZKT::MATH::Mat4f(projection);  // camera at the origin looking down -Z
+    }
+
+    /**
+     * @brief Records one frame in slot 0 the way the renderer orders it; the depth "pass" is a
+     *        clear to depth_value. Returns false if either phase drew an unexpected count.
+     */
+    bool Frame(const char* name, float depth_value, uint32_t expected_early, uint32_t expected_late)
+    {
+        context_.SubmitImmediate([&](VkCommandBuffer cmd) {
+            culling_.RecordUploads(cmd, 0);
+            culling_.RecordCull(cmd, CullPhase::Early, view_projection_, 0);
+            if (depth_ != VK_NULL_HANDLE)
+            {
+                ClearDepth(cmd, depth_, depth_value, depth_layout_);
+                depth_layout_ = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            }
+            culling_.RecordDepthPyramid(cmd);
+            culling_.RecordCull(cmd, CullPhase::Late, view_projection_, 0);
+        });
+        // The readback is collected by the slot's next RecordUploads.
+        context_.SubmitImmediate([&](VkCommandBuffer cmd) { culling_.RecordUploads(cmd, 0); });
+
+        const ZKT::GpuCullingStats& stats = culling_.Stats();
+        const bool passed = stats.early_draws == expected_early && stats.late_draws == expected_late;
+        std::printf("%-28s early %3u (expected %3u), late %3u (expected %3u) %s\n",
+                    name,
+                    stats.early_draws,
+                    expected_early,
+                    stats.late_draws,
+                    expected_late,
+                    passed ? "ok" : "FAILED");
+        return passed;
+    }
+
+    void SetDepth(VkImage depth)
+    {
+        depth_ = depth;
+    }
+
+private:
+    const ZKT::VulkanContext& context_;
+    GpuCulling& culling_;
+    VkImage depth_ = VK_NULL_HANDLE;
+    VkImageLayout depth_layout_ = VK_IMAGE_LAYOUT_UNDEFINED;
+    ZKT::MATH::Mat4f view_projection_ {};
+};
+
+int Run()
+{
+    ZKT::GlfwWindow window(ZKT::WindowConfig{320, 240, "GpuCullingTest"});
+    ZKT::VulkanContext context(window);
+    const VkDevice device = context.DeviceHandle();
+
+    GpuCulling culling(context, 128, 1);
+    const ZKT::GpuMeshDraw mesh {36, 0, 0, 0};
+    culling.SetMeshes({&mesh, 1});
+    culling.SetInstances(MakeInstances());
+
+    bool passed = true;
+    CullingTest test(context, culling, VK_NULL_HANDLE);
+
+    // No depth source yet: the Hi-Z binding holds the fallback image and occlusion is off.
+    passed &= test.Frame("frustum only, no Hi-Z", 1.0F, kVisibleInstances, 0);
+
+    ZKT::Image depth(
+        context.GetDevice(),
+        VK_FORMAT_D32_SFLOAT,
+        kDepthExtent,
+        1,
+        VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    VkImageViewCreateInfo view_info {};
+    view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_info.image = depth.Handle();
+    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format = VK_FORMAT_D32_SFLOAT;
+    view_info.subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1};
+    VkImageView depth_view = VK_NULL_HANDLE;
+    if (vkCreateImageView(device, &view_info, nullptr, &depth_view) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the test depth view.");
+    }
+    culling.SetDepthSource(depth_view, kDepthExtent);
+    test.SetDepth(depth.Handle());
+
+    // Empty depth: no pyramid yet for the early phase, and nothing rejected comes back late.
+    passed &= test.Frame("empty depth", 1.0F, kVisibleInstances, 0);
+    // Early phase tests against the empty pyramid, so everything in view is still drawn early.
+    passed &= test.Frame("depth at the near plane", 0.0F, kVisibleInstances, 0);
+    // Last frame's pyramid occludes everything; the refreshed one lets it all back in late.
+    passed &= test.Frame("occluder removed", 1.0F, 0, kVisibleInstances);
+    passed &= test.Frame("steady state", 1.0F, kVisibleInstances, 0);
+
+    context.WaitIdle();
+    vkDestroyImageView(device, depth_view, nullptr);
+    return passed ? 0 : 1;
+}
+}  // namespace
+
+int main()
+{
+    try
+    {
+        return Run();
+    }
+    catch (const std::exception& error)
+    {
+        std::fprintf(stderr, "GpuCullingTest: %s\n", error.what());
+        return 1;
+    }
+}
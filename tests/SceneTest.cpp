@@ -0,0 +1,132 @@
+// Scene tests that need no device: hierarchy edits hot reload relies on, and what survives a
+// cook -> load round trip. Run under AddressSanitizer to catch entities touched after
+// DestroyEntities freed them.
+
+#include "ZokataEngine/systems/scene/CookedScene.h"
+#include "ZokataEngine/systems/scene/Scene.h"
+#include "ZokataEngine/systems/scene/components/CameraComponent.h"
+
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+using ZKT::ENGINE::CameraComponent;
+using ZKT::ENGINE::Entity;
+using ZKT::ENGINE::Scene;
+
+bool Check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "SceneTest: %s\n", what);
+    }
+    return condition;
+}
+
+/**
+ * @brief parent -> child -> grandchild, plus a sibling of child that survives.
+ */
+struct Hierarchy
+{
+    Scene scene;
+    Entity* parent = nullptr;
+    Entity* child = nullptr;
+    Entity* grandchild = nullptr;
+    Entity* sibling = nullptr;
+
+    Hierarchy()
+    {
+        parent = &scene.CreateRuntimeEntity(1, "parent");
+        child = &scene.CreateRuntimeEntity(2, "child", parent);
+        grandchild = &scene.CreateRuntimeEntity(3, "grandchild", child);
+        sibling = &scene.CreateRuntimeEntity(4, "sibling", parent);
+    }
+};
+
+bool DestroyParentThenChild()
+{
+    // The order ApplySceneDiff lists removals in (preorder).
+    Hierarchy h;
+    const std::vector<Entity*> removed {h.parent, h.child};
+    h.scene.DestroyEntities(removed);
+    bool passed = Check(h.scene.RuntimeRoots().empty(), "parent then child: a root is left");
+    passed &= Check(h.scene.AllRuntimeEntities().empty(), "parent then child: entities are left");
+    return passed;
+}
+
+bool DestroyChildThenParent()
+{
+    Hierarchy h;
+    const std::vector<Entity*> removed {h.grandchild, h.child, h.parent};
+    h.scene.DestroyEntities(removed);
+    bool passed = Check(h.scene.RuntimeRoots().empty(), "child then parent: a root is left");
+    passed &= Check(h.scene.AllRuntimeEntities().empty(), "child then parent: entities are left");
+    return passed;
+}
+
+bool DestroySubtreeKeepsSibling()
+{
+    Hierarchy h;
+    const std::vector<Entity*> removed {h.child, h.grandchild, h.child};
+    h.scene.DestroyEntities(removed);
+    bool passed = Check(h.scene.RuntimeRoots().size() == 1, "subtree: the root is gone");
+    passed &= Check(h.parent->Children().size() == 1, "subtree: parent should keep one child");
+    passed &= Check(h.parent->Children().front().get() == h.sibling, "subtree: the sibling is gone");
+    passed &= Check(h.scene.AllRuntimeEntities().size() == 2, "subtree: expected two entities left");
+    return passed;
+}
+
+bool CookedCameraSurvives()
+{
+    // What the MainCamera entity of a scene file loads as.
+    Scene scene("CookedCamera");
+    Entity& entity = scene.CreateRuntimeEntity(10, "MainCamera");
+    entity.Transform().SetPosition(ZKT::MATH::Vec3f{0.0F, 1.5F, 5.0F});
+    CameraComponent& camera = entity.AddComponent<CameraComponent>();
+    camera.SetVerticalFovDegrees(60.0F);
+    camera.SetNearPlane(0.1F);
+    camera.SetFarPlane(500.0F);
+    camera.SetClearColor(ZKT::MATH::Vec4f{0.06F, 0.07F, 0.09F, 1.0F});
+    scene.AddEntity(ZKT::ENGINE::SceneEntity{10, -1, "MainCamera", {{"Transform"}, {"Camera"}}});
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "zokata-scene-test.zkscene";
+    ZKT::ENGINE::CookScene(scene, {}, path);
+    const std::unique_ptr<Scene> loaded = ZKT::ENGINE::LoadCookedScene(path);
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+
+    const bool one_entity = loaded->AllRuntimeEntities().size() == 1;
+    bool passed = Check(one_entity, "cooked camera: expected one entity");
+    const CameraComponent* cooked = one_entity ? loaded->AllRuntimeEntities().front()->GetComponent<CameraComponent>() : nullptr;
+    passed &= Check(cooked != nullptr, "cooked camera: the camera is gone");
+    if (cooked != nullptr)
+    {
+        passed &= Check(cooked->VerticalFovDegrees() == 60.0F, "cooked camera: wrong field of view");
+        passed &= Check(cooked->NearPlane() == 0.1F && cooked->FarPlane() == 500.0F, "cooked camera: wrong clip planes");
+        passed &= Check(cooked->ClearColor().z == 0.09F, "cooked camera: wrong clear color");
+    }
+    return passed;
+}
+}  // namespace
+
+int main()
+{
+    try
+    {
+        bool passed = DestroyParentThenChild();
+        passed &= DestroyChildThenParent();
+        passed &= DestroySubtreeKeepsSibling();
+        passed &= CookedCameraSurvives();
+        return passed ? 0 : 1;
+    }
+    catch (const std::exception& error)
+    {
+        std::fprintf(stderr, "SceneTest: %s\n", error.what());
+        return 1;
+    }
+}